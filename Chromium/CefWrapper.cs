@@ -38,6 +38,10 @@ internal class CefWrapper : IDisposable
     private readonly ILogger logger;
     private readonly bool compositorCaptureRequested;
     private CompositorCaptureBridge? compositorCaptureBridge;
+    private readonly IReadOnlyList<RenditionOutput> renditionOutputs;
+    private IReadOnlyList<Models.OverlayModel> overlays = Array.Empty<Models.OverlayModel>();
+    private LayerCompositorBridge? layerCompositor;
+    private readonly List<(ChromiumWebBrowser Browser, CompositorCaptureBridge Bridge)> layers = new();
 
     /// <summary>
     /// Initializes a new instance of the <see cref="CefWrapper"/> class.
@@ -49,7 +53,8 @@ internal class CefWrapper : IDisposable
     /// <param name="frameRate">The target frame rate.</param>
     /// <param name="logger">The logger instance.</param>
     /// <param name="windowlessFrameRateOverride">An optional override for the windowless frame rate.</param>
-    public CefWrapper(int width, int height, string initialUrl, NdiVideoPipeline pipeline, FrameRate frameRate, ILogger logger, int? windowlessFrameRateOverride)
+    /// <param name="renditionOutputs">Optional scaled outputs fed from compositor capture. The wrapper takes ownership and disposes them.</param>
+    public CefWrapper(int width, int height, string initialUrl, NdiVideoPipeline pipeline, FrameRate frameRate, ILogger logger, int? windowlessFrameRateOverride, IReadOnlyList<RenditionOutput>? renditionOutputs = null)
     {
         this.Width = width;
         this.Height = height;
@@ -59,6 +64,7 @@ internal class CefWrapper : IDisposable
         this.logger = logger;
         this.windowlessFrameRateOverride = windowlessFrameRateOverride;
         this.compositorCaptureRequested = pipeline.Options.EnableCompositorCapture;
+        this.renditionOutputs = renditionOutputs ?? Array.Empty<RenditionOutput>();
 
         this.browser = new ChromiumWebBrowser(initialUrl)
         {
@@ -86,7 +92,17 @@ internal class CefWrapper : IDisposable
         var pipelineOptions = this.videoPipeline.Options;
 
         var defaultRate = (int)Math.Round(this.frameRate.Value);
-        if (pipelineOptions.PacingMode ==
+        if (this.compositorCaptureRequested && pipelineOptions.SourceFrameRate is { } sourceFrameRate)
+        {
+            // The page animates at the source rate; the native helper converts to the output rate.
+            defaultRate = (int)Math.Round(sourceFrameRate.Value);
+        }
+        else if (this.compositorCaptureRequested && pipelineOptions.Interlaced)
+        {
+            // Each interleaved frame carries two fields rendered at their own instants.
+            defaultRate *= 2;
+        }
+        else if (pipelineOptions.PacingMode ==
             Tractus.HtmlToNdi.Launcher.PacingMode.Smoothness)
         {
             defaultRate = SmoothnessRenderRate;
@@ -105,11 +121,41 @@ internal class CefWrapper : IDisposable
 
         if (this.compositorCaptureRequested && this.TryActivateCompositorCapture(host))
         {
+            var supersampleFactor = pipelineOptions.SupersampleFactor;
+            if (supersampleFactor > 1)
+            {
+                // Keep the CSS viewport at the output size and raise the device scale factor so Chromium
+                // rasterizes the larger surface the native helper downsamples; input coordinates stay in DIPs.
+                await this.browser.ResizeAsync(this.Width, this.Height, supersampleFactor);
+                this.logger.Information("Compositor capture supersampling at {Factor}x ({Filter})", supersampleFactor, pipelineOptions.SupersampleFilter);
+            }
+
+            if (this.layerCompositor is not null)
+            {
+                await this.StartLayersAsync(targetWindowlessRate);
+            }
+
             this.videoPipeline.AttachInvalidationScheduler(null);
             this.videoPipeline.Start();
+            foreach (var output in this.renditionOutputs)
+            {
+                output.Pipeline.AttachInvalidationScheduler(null);
+                output.Pipeline.Start();
+            }
+
             return;
         }
 
+        if (this.renditionOutputs.Count > 0)
+        {
+            this.logger.Warning("{Count} output rendition(s) require compositor capture and will not be published", this.renditionOutputs.Count);
+        }
+
+        if (pipelineOptions.AlphaMode == AlphaMode.Straight)
+        {
+            this.logger.Warning("Straight alpha requires compositor capture; frames are sent premultiplied");
+        }
+
         this.browser.Paint += this.OnBrowserPaint;
 
         var pumpMode = pipelineOptions.EnablePacedInvalidation &&
@@ -196,11 +242,21 @@ internal class CefWrapper : IDisposable
 
         var bridge = new CompositorCaptureBridge(this.logger);
         bridge.FrameArrived += this.OnCompositorFrame;
+        bridge.RenditionFrameArrived += this.OnRenditionFrame;
+
+        var renditions = this.renditionOutputs.Select(output => output.Rendition).ToList();
+        var options = this.videoPipeline.Options;
+        if (options.Layers.HasLayers)
+        {
+            this.TryCreateLayerCompositor(bridge, options.Layers);
+        }
 
-        if (!bridge.TryStart(host, this.Width, this.Height, this.frameRate, out var error))
+        if (!bridge.TryStart(host, this.Width, this.Height, this.frameRate, renditions, options.SupersampleFactor, options.SupersampleFilter, options.SourceFrameRate, options.FrameRateConversion, options.Interlaced, options.InterlaceFlickerFilter, options.AlphaMode, options.ThreadPolicy, options.FrameMemory, options.CaptureFaults, out var error))
         {
             bridge.FrameArrived -= this.OnCompositorFrame;
+            bridge.RenditionFrameArrived -= this.OnRenditionFrame;
             bridge.Dispose();
+            this.DisposeLayerCompositor();
             this.TryRestoreAutoBeginFrame(host);
 
             if (!string.IsNullOrWhiteSpace(error))
@@ -216,6 +272,112 @@ internal class CefWrapper : IDisposable
         return true;
     }
 
+    /// <summary>
+    /// Creates the layer compositor and routes the main page into it as the bottom layer. On failure the main page
+    /// is captured on its own and the extra layers are not loaded.
+    /// </summary>
+    /// <param name="bridge">The main page's capture bridge, not yet started.</param>
+    /// <param name="stack">The configured layer stack.</param>
+    private void TryCreateLayerCompositor(CompositorCaptureBridge bridge, CompositorLayerStack stack)
+    {
+        var compositor = new LayerCompositorBridge(this.logger);
+        if (!compositor.TryCreate(this.Width, this.Height, this.frameRate, this.videoPipeline.Options.AlphaMode, this.videoPipeline.Options.ThreadPolicy, this.videoPipeline.Options.FrameMemory, out var error))
+        {
+            compositor.Dispose();
+            this.logger.Warning("Layer compositing unavailable, publishing the main page only: {Error}", error);
+            return;
+        }
+
+        compositor.FrameArrived += this.OnCompositorFrame;
+        bridge.AttachToLayerCompositor(compositor, 0, stack.BaseDelayFrames);
+        this.layerCompositor = compositor;
+
+        if (this.renditionOutputs.Count > 0)
+        {
+            this.logger.Warning("Renditions and overlays are taken from the main page only and do not include the {Count} extra layer(s)", stack.Layers.Count);
+        }
+    }
+
+    /// <summary>
+    /// Loads each extra layer in its own transparent off-screen browser, attaches its capture session above the
+    /// main page and then starts the compositor.
+    /// </summary>
+    /// <param name="windowlessRate">The windowless frame rate applied to the main page.</param>
+    /// <returns>A task that completes once every layer has been started or skipped.</returns>
+    private async Task StartLayersAsync(int windowlessRate)
+    {
+        var compositor = this.layerCompositor!;
+        var options = this.videoPipeline.Options;
+        var stack = options.Layers;
+
+        for (var index = 0; index < stack.Layers.Count; index++)
+        {
+            var layer = stack.Layers[index];
+            var zOrder = index + 1;
+            var browser = new ChromiumWebBrowser(layer.Url, new BrowserSettings { BackgroundColor = Cef.ColorSetARGB(0, 0, 0, 0) })
+            {
+                AudioHandler = new CustomAudioHandler(),
+            };
+            browser.Size = new System.Drawing.Size(this.Width, this.Height);
+
+            try
+            {
+                await browser.WaitForInitialLoadAsync();
+
+                var host = browser.GetBrowserHost();
+                host.WindowlessFrameRate = windowlessRate;
+                host.SetAudioMuted(true);
+                host.SetAutoBeginFrameEnabled(false);
+
+                var bridge = new CompositorCaptureBridge(this.logger);
+                bridge.AttachToLayerCompositor(compositor, zOrder, layer.DelayFrames);
+                if (!bridge.TryStart(host, this.Width, this.Height, this.frameRate, Array.Empty<OutputRendition>(), options.SupersampleFactor, options.SupersampleFilter, options.SourceFrameRate, options.FrameRateConversion, options.Interlaced, options.InterlaceFlickerFilter, options.AlphaMode, options.ThreadPolicy, options.FrameMemory, CaptureFaultProfile.None, out var error))
+                {
+                    bridge.Dispose();
+                    browser.Dispose();
+                    this.logger.Warning("Skipping layer {ZOrder} ({Url}): {Error}", zOrder, layer.Url, error);
+                    continue;
+                }
+
+                if (options.SupersampleFactor > 1)
+                {
+                    await browser.ResizeAsync(this.Width, this.Height, options.SupersampleFactor);
+                }
+
+                this.layers.Add((browser, bridge));
+                this.logger.Information("Layer {ZOrder} loaded from {Url} with a {DelayFrames}-frame delay", zOrder, layer.Url, layer.DelayFrames);
+            }
+            catch (Exception ex)
+            {
+                browser.Dispose();
+                this.logger.Warning(ex, "Skipping layer {ZOrder} ({Url})", zOrder, layer.Url);
+            }
+        }
+
+        compositor.Start();
+    }
+
+    /// <summary>
+    /// Stops the extra layers and the layer compositor. Sessions are stopped before the compositor they feed.
+    /// </summary>
+    private void DisposeLayerCompositor()
+    {
+        foreach (var (browser, bridge) in this.layers)
+        {
+            bridge.Dispose();
+            browser.Dispose();
+        }
+
+        this.layers.Clear();
+
+        if (this.layerCompositor is { } compositor)
+        {
+            compositor.FrameArrived -= this.OnCompositorFrame;
+            compositor.Dispose();
+            this.layerCompositor = null;
+        }
+    }
+
     /// <summary>
     /// Handles compositor-delivered frames, forwarding them to the pipeline and ensuring native resources are released on error.
     /// </summary>
@@ -240,6 +402,30 @@ internal class CefWrapper : IDisposable
         }
     }
 
+    /// <summary>
+    /// Routes a scaled rendition frame to the pipeline that publishes that rendition.
+    /// </summary>
+    /// <param name="sender">The compositor capture bridge that surfaced the frame.</param>
+    /// <param name="args">The rendition index and frame payload.</param>
+    private void OnRenditionFrame(object? sender, RenditionFrameEventArgs args)
+    {
+        if ((uint)args.Index >= (uint)this.renditionOutputs.Count)
+        {
+            args.Frame.Dispose();
+            return;
+        }
+
+        try
+        {
+            this.renditionOutputs[args.Index].Pipeline.HandleCompositorFrame(args.Frame);
+        }
+        catch (Exception ex)
+        {
+            this.logger.Warning(ex, "Unhandled exception while forwarding rendition frame");
+            args.Frame.Dispose();
+        }
+    }
+
     /// <summary>
     /// Re-enables Chromium's auto begin frame behaviour when the compositor experiment is disabled or disposed.
     /// </summary>
@@ -279,8 +465,10 @@ internal class CefWrapper : IDisposable
                 if (this.compositorCaptureBridge is not null)
                 {
                     this.compositorCaptureBridge.FrameArrived -= this.OnCompositorFrame;
+                    this.compositorCaptureBridge.RenditionFrameArrived -= this.OnRenditionFrame;
                     this.compositorCaptureBridge.Dispose();
                     this.compositorCaptureBridge = null;
+                    this.DisposeLayerCompositor();
 
                     if (host is not null)
                     {
@@ -297,6 +485,11 @@ internal class CefWrapper : IDisposable
                 this.browser = null;
                 this.framePump?.Dispose();
                 this.videoPipeline.Dispose();
+
+                foreach (var output in this.renditionOutputs)
+                {
+                    output.Dispose();
+                }
             }
 
             // TODO: free unmanaged resources (unmanaged objects) and override finalizer
@@ -419,4 +612,50 @@ internal class CefWrapper : IDisposable
 
         this.browser.Reload();
     }
+
+    /// <summary>
+    /// Gets the overlays currently burned into compositor frames.
+    /// </summary>
+    public IReadOnlyList<Models.OverlayModel> Overlays => this.overlays;
+
+    /// <summary>
+    /// Replaces the overlays the native compositor draws into every frame. Overlays need compositor capture.
+    /// </summary>
+    /// <param name="models">The overlays as received from the API, kept for reporting.</param>
+    /// <param name="definitions">The validated overlays passed to the native helper.</param>
+    /// <returns><c>true</c> when the compositor session accepted the overlays.</returns>
+    public bool TrySetOverlays(IReadOnlyList<Models.OverlayModel> models, IReadOnlyList<Models.OverlayDefinition> definitions)
+    {
+        var bridge = this.compositorCaptureBridge;
+        if (bridge is null)
+        {
+            this.logger.Warning("Ignoring overlay request because compositor capture is not active");
+            return false;
+        }
+
+        if (!bridge.TrySetOverlays(definitions))
+        {
+            return false;
+        }
+
+        this.overlays = models;
+        this.logger.Information("Applied {Count} overlay(s)", definitions.Count);
+        return true;
+    }
+
+    /// <summary>
+    /// Gets the overlay blend statistics, or <c>null</c> when compositor capture is not active.
+    /// </summary>
+    public Models.OverlayStatistics? GetOverlayStatistics()
+    {
+        return this.compositorCaptureBridge is { } bridge && bridge.TryGetOverlayStatistics(out var statistics) ? statistics : null;
+    }
+
+    /// <summary>
+    /// Gets the layer compositor statistics, or <c>null</c> when no layers are composited.
+    /// </summary>
+    public Models.LayerCompositorStatistics? GetLayerStatistics()
+    {
+        return this.layerCompositor?.GetStatistics();
+    }
 }
@@ -48,6 +48,7 @@ internal sealed class FramePump : IPacedInvalidationScheduler
     private readonly FramePumpMode mode;
     private readonly bool cadenceAdaptationEnabled;
     private readonly Func<CancellationToken, Task> invalidateBrowserAsync;
+    private readonly IPipelineClock clock;
     private readonly Channel<InvalidationRequest> requestChannel;
     private readonly ConcurrentQueue<long> requestTimestamps = new();
     private readonly CancellationTokenSource cancellation = new();
@@ -60,7 +61,7 @@ internal sealed class FramePump : IPacedInvalidationScheduler
     private volatile bool paused;
     private volatile bool started;
     private double cadenceAlignmentDeltaFrames;
-    private long lastPaintTicks = DateTime.UtcNow.Ticks;
+    private long lastPaintTimestamp;
     private double lastPaintLatencyMs;
     private bool disposed;
     private HighResolutionWaitableTimer? highResolutionTimer;
@@ -72,9 +73,12 @@ internal sealed class FramePump : IPacedInvalidationScheduler
         ILogger logger,
         FramePumpMode mode,
         bool cadenceAdaptationEnabled,
-        Func<ChromiumWebBrowser, ILogger, CancellationToken, Task>? invalidateBrowser = null)
+        Func<ChromiumWebBrowser, ILogger, CancellationToken, Task>? invalidateBrowser = null,
+        IPipelineClock? clock = null)
     {
         this.browser = browser ?? throw new ArgumentNullException(nameof(browser));
+        this.clock = clock ?? SystemPipelineClock.Instance;
+        lastPaintTimestamp = this.clock.GetTimestamp();
         baseInterval = interval;
         this.watchdogInterval = watchdogInterval ?? TimeSpan.FromSeconds(1);
         this.logger = logger;
@@ -128,7 +132,7 @@ internal sealed class FramePump : IPacedInvalidationScheduler
         ThrowIfDisposed();
         cancellationToken.ThrowIfCancellationRequested();
 
-        requestTimestamps.Enqueue(Stopwatch.GetTimestamp());
+        requestTimestamps.Enqueue(clock.GetTimestamp());
 
         var linkedCancellation = CancellationTokenSource.CreateLinkedTokenSource(cancellation.Token, cancellationToken);
         var request = new InvalidationRequest(linkedCancellation.Token);
@@ -183,7 +187,7 @@ internal sealed class FramePump : IPacedInvalidationScheduler
 
         paused = false;
 
-        Interlocked.Exchange(ref lastPaintTicks, DateTime.UtcNow.Ticks);
+        Interlocked.Exchange(ref lastPaintTimestamp, clock.GetTimestamp());
 
         while (pausedQueue.TryDequeue(out var pending))
         {
@@ -202,9 +206,9 @@ internal sealed class FramePump : IPacedInvalidationScheduler
 
     public void NotifyPaint()
     {
-        Interlocked.Exchange(ref lastPaintTicks, DateTime.UtcNow.Ticks);
+        var now = clock.GetTimestamp();
+        Interlocked.Exchange(ref lastPaintTimestamp, now);
 
-        var now = Stopwatch.GetTimestamp();
         if (requestTimestamps.TryDequeue(out var requestTimestamp))
         {
             var latencyTicks = now - requestTimestamp;
@@ -423,46 +427,38 @@ internal sealed class FramePump : IPacedInvalidationScheduler
 
     private async Task RunPeriodicLoopAsync(CancellationToken token)
     {
-        var stopwatch = Stopwatch.StartNew();
-        var nextDeadline = stopwatch.Elapsed;
+        var nextDeadline = clock.Elapsed;
 
-        try
+        while (!token.IsCancellationRequested)
         {
-            while (!token.IsCancellationRequested)
+            var interval = GetAdaptiveInterval();
+            if (interval <= TimeSpan.Zero)
             {
-                var interval = GetAdaptiveInterval();
-                if (interval <= TimeSpan.Zero)
-                {
-                    interval = TimeSpan.FromMilliseconds(1);
-                }
+                interval = TimeSpan.FromMilliseconds(1);
+            }
 
-                nextDeadline += interval;
-                try
-                {
-                    TimingHelpers.WaitUntil(stopwatch, nextDeadline, token, highResolutionTimer);
-                }
-                catch (OperationCanceledException)
-                {
-                    break;
-                }
+            nextDeadline += interval;
+            try
+            {
+                clock.WaitUntil(nextDeadline, token, highResolutionTimer);
+            }
+            catch (OperationCanceledException)
+            {
+                break;
+            }
 
-                try
-                {
-                    await RequestInvalidateAsync(token).ConfigureAwait(false);
-                }
-                catch (OperationCanceledException)
-                {
-                    break;
-                }
-                catch (ObjectDisposedException)
-                {
-                    break;
-                }
+            try
+            {
+                await RequestInvalidateAsync(token).ConfigureAwait(false);
+            }
+            catch (OperationCanceledException)
+            {
+                break;
+            }
+            catch (ObjectDisposedException)
+            {
+                break;
             }
-        }
-        finally
-        {
-            stopwatch.Stop();
         }
     }
 
@@ -481,8 +477,10 @@ internal sealed class FramePump : IPacedInvalidationScheduler
                     return;
                 }
 
-                var lastPaint = new DateTime(Interlocked.Read(ref lastPaintTicks), DateTimeKind.Utc);
-                if (DateTime.UtcNow - lastPaint > watchdogInterval)
+                // The watchdog only polls in real time; whether the page is idle is read from the pump's clock, which
+                // the periodic loop or the on-demand delay may already be waiting on.
+                var idle = Stopwatch.GetElapsedTime(Interlocked.Read(ref lastPaintTimestamp), clock.GetTimestamp());
+                if (idle > watchdogInterval)
                 {
                     if (paused)
                     {
@@ -563,10 +561,9 @@ internal sealed class FramePump : IPacedInvalidationScheduler
         }
 
         var delay = TimeSpan.FromTicks(delayTicks);
-        var sw = Stopwatch.StartNew();
         try
         {
-            TimingHelpers.WaitUntil(sw, delay, token, highResolutionTimer);
+            clock.WaitUntil(clock.Elapsed + delay, token, highResolutionTimer);
         }
         catch (OperationCanceledException)
         {
@@ -41,7 +41,26 @@ public sealed class LaunchParameters
         bool disableBackgroundThrottling,
         bool presetHighPerformance,
         PacingMode pacingMode,
-        bool ndiSendAsync)
+        bool ndiSendAsync,
+        IReadOnlyList<OutputRendition> renditions,
+        int supersampleFactor,
+        SupersampleFilter supersampleFilter,
+        FrameRate? sourceFrameRate,
+        FrameRateConversion frameRateConversion,
+        bool interlaced,
+        bool interlaceFlickerFilter,
+        CompositorLayerStack layers,
+        AlphaMode alphaMode,
+        ThreadPolicy threadPolicy,
+        FrameMemoryOptions frameMemory,
+        long frameMemoryBudgetBytes,
+        string? flightRecorderDirectory,
+        CaptureFaultProfile captureFaults,
+        BufferDepthTuning autoBufferDepth,
+        PacingReference pacingReference,
+        GenlockReference genlock,
+        int ndiSendThreadDepth,
+        IdleOutput idleOutput)
     {
         NdiName = ndiName;
         Port = port;
@@ -71,6 +90,25 @@ public sealed class LaunchParameters
         PresetHighPerformance = presetHighPerformance;
         PacingMode = pacingMode;
         NdiSendAsync = ndiSendAsync;
+        Renditions = renditions;
+        SupersampleFactor = supersampleFactor;
+        SupersampleFilter = supersampleFilter;
+        SourceFrameRate = sourceFrameRate;
+        FrameRateConversion = frameRateConversion;
+        Interlaced = interlaced;
+        InterlaceFlickerFilter = interlaceFlickerFilter;
+        Layers = layers;
+        AlphaMode = alphaMode;
+        ThreadPolicy = threadPolicy;
+        FrameMemory = frameMemory;
+        FrameMemoryBudgetBytes = frameMemoryBudgetBytes;
+        FlightRecorderDirectory = flightRecorderDirectory;
+        CaptureFaults = captureFaults;
+        AutoBufferDepth = autoBufferDepth;
+        PacingReference = pacingReference;
+        Genlock = genlock;
+        NdiSendThreadDepth = ndiSendThreadDepth;
+        IdleOutput = idleOutput;
     }
 
     /// <summary>
@@ -213,6 +251,102 @@ public sealed class LaunchParameters
     /// </summary>
     public bool NdiSendAsync { get; }
 
+    /// <summary>
+    /// Gets the additional scaled NDI outputs derived from the compositor capture.
+    /// </summary>
+    public IReadOnlyList<OutputRendition> Renditions { get; }
+
+    /// <summary>
+    /// Gets the compositor capture supersampling factor (1, 2 or 4).
+    /// </summary>
+    public int SupersampleFactor { get; }
+
+    /// <summary>
+    /// Gets the filter used to resolve supersampled captures to the output size.
+    /// </summary>
+    public SupersampleFilter SupersampleFilter { get; }
+
+    /// <summary>
+    /// Gets the rate at which the page renders under compositor capture, or <c>null</c> to render at the output rate.
+    /// </summary>
+    public FrameRate? SourceFrameRate { get; }
+
+    /// <summary>
+    /// Gets how compositor frames are converted from <see cref="SourceFrameRate"/> to the output rate.
+    /// </summary>
+    public FrameRateConversion FrameRateConversion { get; }
+
+    /// <summary>
+    /// Gets a value indicating whether output is interlaced. <see cref="FrameRate"/> is then the field rate, so
+    /// <c>--fps=50 --interlaced</c> produces 1080i50 (25 interleaved frames per second).
+    /// </summary>
+    public bool Interlaced { get; }
+
+    /// <summary>
+    /// Gets a value indicating whether a vertical flicker filter is applied while weaving fields.
+    /// </summary>
+    public bool InterlaceFlickerFilter { get; }
+
+    /// <summary>
+    /// Gets the pages blended above the main page into the single output, with their alignment delays.
+    /// </summary>
+    public CompositorLayerStack Layers { get; }
+
+    /// <summary>
+    /// Gets the alpha representation of frames sent to NDI.
+    /// </summary>
+    public AlphaMode AlphaMode { get; }
+
+    /// <summary>
+    /// Gets the priority, CPU pinning and timer slack of the capture, compositor and paced sender threads.
+    /// </summary>
+    public ThreadPolicy ThreadPolicy { get; }
+
+    /// <summary>
+    /// Gets how the native helper allocates its frame pools.
+    /// </summary>
+    public FrameMemoryOptions FrameMemory { get; }
+
+    /// <summary>
+    /// Gets the cap on frame memory across the native pools and the paced buffers in bytes, or 0 for no cap.
+    /// </summary>
+    public long FrameMemoryBudgetBytes { get; }
+
+    /// <summary>
+    /// Gets the directory flight recorder traces are written to after an underrun, or <c>null</c> to only dump on demand.
+    /// </summary>
+    public string? FlightRecorderDirectory { get; }
+
+    /// <summary>
+    /// Gets the faults the native fallback capture loop injects into its cadence.
+    /// </summary>
+    public CaptureFaultProfile CaptureFaults { get; }
+
+    /// <summary>
+    /// Gets the range and underrun target within which the paced buffer tunes its own depth.
+    /// </summary>
+    public BufferDepthTuning AutoBufferDepth { get; }
+
+    /// <summary>
+    /// Gets the timebase the paced sender locks its ticks to, so several machines send in phase.
+    /// </summary>
+    public PacingReference PacingReference { get; }
+
+    /// <summary>
+    /// Gets the genlock reference whose frame arrivals the paced sender follows.
+    /// </summary>
+    public GenlockReference Genlock { get; }
+
+    /// <summary>
+    /// Gets how many frames the paced sender may hand to a dedicated NDI send thread, or zero to send on its own thread.
+    /// </summary>
+    public int NdiSendThreadDepth { get; }
+
+    /// <summary>
+    /// Gets how repeated frames are detected and how often a static page is sent.
+    /// </summary>
+    public IdleOutput IdleOutput { get; }
+
     /// <summary>
     /// Attempts to create a <see cref="LaunchParameters"/> instance from command-line arguments.
     /// </summary>
@@ -394,6 +528,18 @@ public sealed class LaunchParameters
         var disableBackgroundThrottling = HasFlag("--disable-background-throttling") || HasFlag("--disable-renderer-backgrounding");
         var presetHighPerformance = HasFlag("--preset-high-performance");
         var ndiSendAsync = HasFlag("--ndi-send-async");
+        var ndiSendThreadDepth = 0;
+        var ndiSendThreadArg = GetArgValue("--ndi-send-thread");
+        if (ndiSendThreadArg is not null && (!int.TryParse(ndiSendThreadArg, NumberStyles.Integer, CultureInfo.InvariantCulture, out ndiSendThreadDepth) || ndiSendThreadDepth < 0))
+        {
+            Log.Error("Could not parse the --ndi-send-thread parameter. Exiting.");
+            return false;
+        }
+
+        if (ndiSendThreadDepth > 0 && ndiSendAsync)
+        {
+            Log.Warning("--ndi-send-thread has no effect with --ndi-send-async, whose sends already return at once.");
+        }
         var pacingMode = PacingMode.Latency;
         var pacingModeArg = GetArgValue("--pacing-mode");
         if (pacingModeArg is not null && !Enum.TryParse(pacingModeArg, true, out pacingMode))
@@ -408,6 +554,203 @@ public sealed class LaunchParameters
             bufferDepth = SmoothnessDefaultBufferDepth;
         }
 
+        IReadOnlyList<OutputRendition> renditions;
+        try
+        {
+            renditions = OutputRendition.ParseList(GetArgValue("--renditions"));
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --renditions parameter. Exiting.");
+            return false;
+        }
+
+        var supersampleFactor = 1;
+        var supersampleArg = GetArgValue("--supersample");
+        if (supersampleArg is not null && (!int.TryParse(supersampleArg, NumberStyles.Integer, CultureInfo.InvariantCulture, out supersampleFactor) || !IsSupportedSupersampleFactor(supersampleFactor)))
+        {
+            Log.Error("Could not parse the --supersample parameter (expected 1, 2 or 4). Exiting.");
+            return false;
+        }
+
+        var supersampleFilter = SupersampleFilter.Box;
+        var supersampleFilterArg = GetArgValue("--supersample-filter");
+        if (supersampleFilterArg is not null && (!Enum.TryParse(supersampleFilterArg, true, out supersampleFilter) || !Enum.IsDefined(supersampleFilter)))
+        {
+            Log.Error("Could not parse the --supersample-filter parameter (expected box or lanczos3). Exiting.");
+            return false;
+        }
+
+        FrameRate? sourceFrameRate = null;
+        var sourceFpsArg = GetArgValue("--source-fps");
+        if (sourceFpsArg is not null)
+        {
+            try
+            {
+                sourceFrameRate = FrameRate.Parse(sourceFpsArg);
+            }
+            catch (Exception ex)
+            {
+                Log.Error(ex, "Could not parse the --source-fps parameter. Exiting.");
+                return false;
+            }
+        }
+
+        var frameRateConversion = FrameRateConversion.DropRepeat;
+        var frameRateConversionArg = GetArgValue("--rate-conversion");
+        if (frameRateConversionArg is not null && !TryParseFrameRateConversion(frameRateConversionArg, out frameRateConversion))
+        {
+            Log.Error("Could not parse the --rate-conversion parameter (expected drop-repeat or blend). Exiting.");
+            return false;
+        }
+
+        CompositorLayerStack layers;
+        try
+        {
+            layers = CompositorLayerStack.Parse(GetArgValue("--layers"), GetArgValue("--layer-delays"));
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --layers or --layer-delays parameter. Exiting.");
+            return false;
+        }
+
+        var alphaMode = AlphaMode.Premultiplied;
+        var alphaModeArg = GetArgValue("--alpha-mode");
+        if (alphaModeArg is not null && (!Enum.TryParse(alphaModeArg, true, out alphaMode) || !Enum.IsDefined(alphaMode)))
+        {
+            Log.Error("Could not parse the --alpha-mode parameter (expected premultiplied or straight). Exiting.");
+            return false;
+        }
+
+        var threadPriority = ThreadPriorityClass.Normal;
+        var threadPriorityArg = GetArgValue("--thread-priority");
+        if (threadPriorityArg is not null && (!Enum.TryParse(threadPriorityArg, true, out threadPriority) || !Enum.IsDefined(threadPriority)))
+        {
+            Log.Error("Could not parse the --thread-priority parameter (expected normal, high or realtime). Exiting.");
+            return false;
+        }
+
+        ulong threadAffinity;
+        try
+        {
+            threadAffinity = ThreadPolicy.ParseAffinity(GetArgValue("--thread-affinity"));
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --thread-affinity parameter. Exiting.");
+            return false;
+        }
+
+        var timerSlack = TimeSpan.Zero;
+        var timerSlackArg = GetArgValue("--timer-slack-us");
+        if (timerSlackArg is not null)
+        {
+            if (!double.TryParse(timerSlackArg, NumberStyles.Float, CultureInfo.InvariantCulture, out var timerSlackMicroseconds) || timerSlackMicroseconds < 0)
+            {
+                Log.Error("Could not parse the --timer-slack-us parameter. Exiting.");
+                return false;
+            }
+
+            timerSlack = TimeSpan.FromMicroseconds(timerSlackMicroseconds);
+        }
+
+        var frameMemoryBudgetBytes = 0L;
+        var frameMemoryBudgetArg = GetArgValue("--frame-memory-budget-mb");
+        if (frameMemoryBudgetArg is not null)
+        {
+            if (!int.TryParse(frameMemoryBudgetArg, NumberStyles.Integer, CultureInfo.InvariantCulture, out var frameMemoryBudgetMegabytes) || frameMemoryBudgetMegabytes < 0)
+            {
+                Log.Error("Could not parse the --frame-memory-budget-mb parameter. Exiting.");
+                return false;
+            }
+
+            frameMemoryBudgetBytes = frameMemoryBudgetMegabytes * 1024L * 1024L;
+        }
+
+        var flightRecorderDirectory = GetArgValue("--flight-recorder-dir");
+
+        CaptureFaultProfile captureFaults;
+        try
+        {
+            captureFaults = CaptureFaultProfile.Parse(GetArgValue("--capture-faults"));
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --capture-faults parameter. Exiting.");
+            return false;
+        }
+
+        var targetUnderrunProbability = BufferDepthTuning.DefaultTargetUnderrunProbability;
+        var targetUnderrunArg = GetArgValue("--target-underrun-probability");
+        if (targetUnderrunArg is not null && !double.TryParse(targetUnderrunArg, NumberStyles.Float, CultureInfo.InvariantCulture, out targetUnderrunProbability))
+        {
+            Log.Error("Could not parse the --target-underrun-probability parameter. Exiting.");
+            return false;
+        }
+
+        BufferDepthTuning autoBufferDepth;
+        try
+        {
+            autoBufferDepth = BufferDepthTuning.Parse(GetArgValue("--auto-buffer-depth"), targetUnderrunProbability);
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --auto-buffer-depth parameter. Exiting.");
+            return false;
+        }
+
+        var maxSlewPpm = PacingReference.DefaultMaxSlewPpm;
+        var maxSlewArg = GetArgValue("--pacing-reference-slew-ppm");
+        if (maxSlewArg is not null && !double.TryParse(maxSlewArg, NumberStyles.Float, CultureInfo.InvariantCulture, out maxSlewPpm))
+        {
+            Log.Error("Could not parse the --pacing-reference-slew-ppm parameter. Exiting.");
+            return false;
+        }
+
+        PacingReference pacingReference;
+        try
+        {
+            pacingReference = PacingReference.Parse(GetArgValue("--pacing-reference"), maxSlewPpm);
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --pacing-reference parameter. Exiting.");
+            return false;
+        }
+
+        GenlockReference genlock;
+        try
+        {
+            genlock = GenlockReference.Parse(GetArgValue("--genlock"), maxSlewPpm);
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --genlock parameter. Exiting.");
+            return false;
+        }
+
+        if (genlock.IsEnabled && pacingReference.IsEnabled)
+        {
+            Log.Error("--genlock and --pacing-reference both set the paced sender's timebase; choose one. Exiting.");
+            return false;
+        }
+
+        IdleOutput idleOutput;
+        try
+        {
+            idleOutput = IdleOutput.Parse(GetArgValue("--idle-output"));
+        }
+        catch (FormatException ex)
+        {
+            Log.Error(ex, "Could not parse the --idle-output parameter. Exiting.");
+            return false;
+        }
+
+        // A tuned depth and a locked cadence both need the paced buffer; without --buffer-depth it starts from the
+        // default depth.
+        enableBuffering |= autoBufferDepth.IsEnabled || pacingReference.IsEnabled || genlock.IsEnabled;
+
         int? windowlessFrameRateOverride = null;
         var windowlessRateArg = GetArgValue("--windowless-frame-rate");
         if (windowlessRateArg is not null)
@@ -451,7 +794,27 @@ public sealed class LaunchParameters
             disableBackgroundThrottling,
             presetHighPerformance,
             pacingMode,
-            ndiSendAsync);
+            ndiSendAsync,
+            renditions,
+            supersampleFactor,
+            supersampleFilter,
+            sourceFrameRate,
+            frameRateConversion,
+            HasFlag("--interlaced"),
+            HasFlag("--interlace-flicker-filter"),
+            layers,
+            alphaMode,
+            new ThreadPolicy(threadPriority, threadAffinity, timerSlack),
+            (HasFlag("--large-pages") ? FrameMemoryOptions.LargePages : FrameMemoryOptions.None) |
+            (HasFlag("--numa-local") ? FrameMemoryOptions.NumaLocal : FrameMemoryOptions.None),
+            frameMemoryBudgetBytes,
+            string.IsNullOrWhiteSpace(flightRecorderDirectory) ? null : flightRecorderDirectory,
+            captureFaults,
+            autoBufferDepth,
+            pacingReference,
+            genlock,
+            ndiSendThreadDepth,
+            idleOutput);
 
         return true;
     }
@@ -523,6 +886,51 @@ public sealed class LaunchParameters
             throw new FormatException("Buffer depth must be at least 1 when buffering is enabled.");
         }
 
+        var renditions = OutputRendition.ParseList(settings.Renditions);
+
+        if (!IsSupportedSupersampleFactor(settings.SupersampleFactor))
+        {
+            throw new FormatException("Supersample factor must be 1, 2 or 4.");
+        }
+
+        if (settings.TimerSlackMicroseconds < 0)
+        {
+            throw new FormatException("Timer slack cannot be negative.");
+        }
+
+        if (settings.FrameMemoryBudgetMegabytes < 0)
+        {
+            throw new FormatException("Frame memory budget cannot be negative.");
+        }
+
+        if (settings.NdiSendThreadDepth < 0)
+        {
+            throw new FormatException("NDI send thread depth cannot be negative.");
+        }
+
+        var autoBufferDepth = BufferDepthTuning.Parse(settings.AutoBufferDepth, settings.TargetUnderrunProbability);
+        var pacingReference = PacingReference.Parse(settings.PacingReference, settings.PacingReferenceSlewPpm);
+        var genlock = GenlockReference.Parse(settings.Genlock, settings.PacingReferenceSlewPpm);
+        if (genlock.IsEnabled && pacingReference.IsEnabled)
+        {
+            throw new FormatException("Genlock and a pacing reference both set the paced sender's timebase; choose one.");
+        }
+
+        var idleOutput = IdleOutput.Parse(settings.IdleOutput);
+
+        FrameRate? sourceFrameRate = null;
+        if (!string.IsNullOrWhiteSpace(settings.SourceFrameRate))
+        {
+            try
+            {
+                sourceFrameRate = FrameRate.Parse(settings.SourceFrameRate);
+            }
+            catch (Exception ex)
+            {
+                throw new FormatException("The configured source frame rate is invalid.", ex);
+            }
+        }
+
         return new LaunchParameters(
             settings.NdiName,
             settings.Port,
@@ -530,7 +938,7 @@ public sealed class LaunchParameters
             settings.Width,
             settings.Height,
             frameRate,
-            settings.EnableBuffering,
+            settings.EnableBuffering || autoBufferDepth.IsEnabled || pacingReference.IsEnabled || genlock.IsEnabled,
             settings.EnableBuffering ? settings.BufferDepth : 0,
             TimeSpan.FromSeconds(settings.TelemetryIntervalSeconds),
             windowlessFrameRateOverride,
@@ -551,6 +959,44 @@ public sealed class LaunchParameters
             settings.DisableBackgroundThrottling,
             settings.PresetHighPerformance,
             settings.PacingMode,
-            settings.NdiSendAsync);
+            settings.NdiSendAsync,
+            renditions,
+            settings.SupersampleFactor,
+            settings.SupersampleFilter,
+            sourceFrameRate,
+            settings.FrameRateConversion,
+            settings.Interlaced,
+            settings.InterlaceFlickerFilter,
+            CompositorLayerStack.Parse(settings.Layers, settings.LayerDelays),
+            settings.AlphaMode,
+            new ThreadPolicy(settings.ThreadPriority, ThreadPolicy.ParseAffinity(settings.ThreadAffinity), TimeSpan.FromMicroseconds(settings.TimerSlackMicroseconds)),
+            (settings.UseLargePages ? FrameMemoryOptions.LargePages : FrameMemoryOptions.None) |
+            (settings.NumaLocalBuffers ? FrameMemoryOptions.NumaLocal : FrameMemoryOptions.None),
+            settings.FrameMemoryBudgetMegabytes * 1024L * 1024L,
+            string.IsNullOrWhiteSpace(settings.FlightRecorderDirectory) ? null : settings.FlightRecorderDirectory,
+            CaptureFaultProfile.None,
+            autoBufferDepth,
+            pacingReference,
+            genlock,
+            settings.NdiSendThreadDepth,
+            idleOutput);
+    }
+
+    /// <summary>
+    /// Determines whether the native helper can resolve the given supersampling factor.
+    /// </summary>
+    /// <param name="factor">The requested factor.</param>
+    /// <returns><c>true</c> for 1, 2 and 4; otherwise <c>false</c>.</returns>
+    private static bool IsSupportedSupersampleFactor(int factor) => factor is 1 or 2 or 4;
+
+    /// <summary>
+    /// Parses a rate conversion name, accepting both <c>drop-repeat</c> and <c>DropRepeat</c> spellings.
+    /// </summary>
+    /// <param name="text">The text to parse.</param>
+    /// <param name="conversion">The parsed conversion mode.</param>
+    /// <returns><c>true</c> when the text names a known mode; otherwise <c>false</c>.</returns>
+    private static bool TryParseFrameRateConversion(string text, out FrameRateConversion conversion)
+    {
+        return Enum.TryParse(text.Replace("-", string.Empty, StringComparison.Ordinal), true, out conversion) && Enum.IsDefined(conversion);
     }
 }
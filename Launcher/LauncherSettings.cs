@@ -1,3 +1,5 @@
+using Tractus.HtmlToNdi.Video;
+
 namespace Tractus.HtmlToNdi.Launcher;
 
 /// <summary>
@@ -159,4 +161,140 @@ public class LauncherSettings
     /// Gets or sets a value indicating whether the NDI sender should use the asynchronous send method.
     /// </summary>
     public bool NdiSendAsync { get; set; }
+
+    /// <summary>
+    /// Gets or sets how many frames the paced sender may hand to a dedicated NDI send thread, or zero to send on its
+    /// own thread.
+    /// </summary>
+    public int NdiSendThreadDepth { get; set; }
+
+    /// <summary>
+    /// Gets or sets additional scaled outputs as a comma-separated list such as <c>960x540/2,640x360/4:bilinear</c>.
+    /// </summary>
+    public string? Renditions { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the compositor capture supersampling factor (1, 2 or 4).
+    /// </summary>
+    public int SupersampleFactor { get; set; } = 1;
+
+    /// <summary>
+    /// Gets or sets the filter used to resolve supersampled captures.
+    /// </summary>
+    public SupersampleFilter SupersampleFilter { get; set; } = SupersampleFilter.Box;
+
+    /// <summary>
+    /// Gets or sets the page render rate for compositor capture (for example <c>60</c> when sending 59.94). Empty keeps the output rate.
+    /// </summary>
+    public string? SourceFrameRate { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets how compositor frames are converted between the source and output rates.
+    /// </summary>
+    public FrameRateConversion FrameRateConversion { get; set; } = FrameRateConversion.DropRepeat;
+
+    /// <summary>
+    /// Gets or sets a value indicating whether output should be interlaced, treating the frame rate as the field rate.
+    /// </summary>
+    public bool Interlaced { get; set; }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether a vertical flicker filter is applied while weaving fields.
+    /// </summary>
+    public bool InterlaceFlickerFilter { get; set; }
+
+    /// <summary>
+    /// Gets or sets the pages blended above the main page as a <c>|</c>-separated list of URLs, bottom to top.
+    /// </summary>
+    public string? Layers { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the per-layer alignment delays in frames as a comma-separated list, main page first.
+    /// </summary>
+    public string? LayerDelays { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the alpha representation of frames sent to NDI.
+    /// </summary>
+    public AlphaMode AlphaMode { get; set; } = AlphaMode.Premultiplied;
+
+    /// <summary>
+    /// Gets or sets the scheduling class of the capture, compositor and paced sender threads.
+    /// </summary>
+    public ThreadPriorityClass ThreadPriority { get; set; } = ThreadPriorityClass.Normal;
+
+    /// <summary>
+    /// Gets or sets the CPUs those threads may run on, as a list such as <c>2,4-7</c>. Empty keeps the inherited affinity.
+    /// </summary>
+    public string? ThreadAffinity { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the timer slack of those threads in microseconds. Zero keeps the system default.
+    /// </summary>
+    public double TimerSlackMicroseconds { get; set; }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether the native frame pools should prefer large pages.
+    /// </summary>
+    public bool UseLargePages { get; set; }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether the native frame pools should be bound to the NUMA node of the thread affinity.
+    /// </summary>
+    public bool NumaLocalBuffers { get; set; }
+
+    /// <summary>
+    /// Gets or sets the cap on frame memory across the native pools and the paced buffers in megabytes. Zero means no cap.
+    /// </summary>
+    public int FrameMemoryBudgetMegabytes { get; set; }
+
+    /// <summary>
+    /// Gets or sets the directory flight recorder traces are written to after an underrun. Empty only dumps on demand.
+    /// </summary>
+    public string? FlightRecorderDirectory { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the depth range, such as <c>1-8</c>, within which the paced buffer tunes its own depth. Empty keeps
+    /// <see cref="BufferDepth"/>.
+    /// </summary>
+    public string? AutoBufferDepth { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets the share of output frames the tuned buffer may send without a fresh frame.
+    /// </summary>
+    public double TargetUnderrunProbability { get; set; }
+        = BufferDepthTuning.DefaultTargetUnderrunProbability;
+
+    /// <summary>
+    /// Gets or sets the timebase the paced sender locks its ticks to: <c>system</c>, or empty to free-run.
+    /// </summary>
+    public string? PacingReference { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets how fast, in parts per million, the reference lock or genlock follower may pull the output's phase in.
+    /// </summary>
+    public double PacingReferenceSlewPpm { get; set; }
+        = Video.PacingReference.DefaultMaxSlewPpm;
+
+    /// <summary>
+    /// Gets or sets the genlock reference the paced sender follows, such as <c>synthetic,drift=80,jitter=1</c>, or
+    /// empty to free-run.
+    /// </summary>
+    public string? Genlock { get; set; }
+        = null;
+
+    /// <summary>
+    /// Gets or sets how repeated frames are detected and how often a static page is sent, such as <c>keepalive</c>,
+    /// <c>5,after=2</c> or <c>detect</c>, or empty to send every frame.
+    /// </summary>
+    public string? IdleOutput { get; set; }
+        = null;
 }
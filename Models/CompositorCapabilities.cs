@@ -0,0 +1,102 @@
+using System.Text.Json.Serialization;
+
+namespace Tractus.HtmlToNdi.Models;
+
+/// <summary>
+/// Instruction set tiers, lowest first.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorSimdLevel</c> in the native helper.</remarks>
+[JsonConverter(typeof(JsonStringEnumConverter))]
+public enum CompositorSimdLevel
+{
+    Scalar = 0,
+    Sse2 = 1,
+    Sse41 = 2,
+    Avx2 = 3,
+    Avx512 = 4,
+}
+
+/// <summary>
+/// Pixel formats the native helper can deliver.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorPixelFormat</c> in the native helper.</remarks>
+[Flags]
+[JsonConverter(typeof(JsonStringEnumConverter))]
+public enum CompositorPixelFormats
+{
+    None = 0,
+    Bgra8 = 1 << 0,
+}
+
+/// <summary>
+/// Optional features of the native helper.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorFeature</c> in the native helper.</remarks>
+[Flags]
+[JsonConverter(typeof(JsonStringEnumConverter))]
+public enum CompositorFeatures
+{
+    None = 0,
+
+    /// <summary>
+    /// Frames come from Chromium's viz capturer rather than the helper's built-in test pattern.
+    /// </summary>
+    VizCapture = 1 << 0,
+    Renditions = 1 << 1,
+    Supersampling = 1 << 2,
+    RateConversion = 1 << 3,
+    FrameBlending = 1 << 4,
+    Interlacing = 1 << 5,
+    Overlays = 1 << 6,
+    Layers = 1 << 7,
+    StraightAlpha = 1 << 8,
+    ThreadPolicy = 1 << 9,
+    MemoryFlags = 1 << 10,
+    MemoryBudget = 1 << 11,
+    Counters = 1 << 12,
+    FlightRecorder = 1 << 13,
+
+    /// <summary>
+    /// The helper's fallback capture loop injects the configured capture faults.
+    /// </summary>
+    CaptureFaults = 1 << 14,
+}
+
+/// <summary>
+/// What the loaded native helper supports, as reported by <c>cc_query_capabilities</c>.
+/// </summary>
+/// <param name="AbiVersion">The helper's C ABI version.</param>
+/// <param name="PixelFormats">The pixel formats sessions can deliver.</param>
+/// <param name="Features">The optional features compiled into the helper.</param>
+/// <param name="CompiledSimdLevel">The tier the helper's pixel kernels were compiled for.</param>
+/// <param name="CpuSimdLevel">The highest tier the CPU and operating system support.</param>
+/// <param name="MaxSupersampleFactor">The largest supersampling factor.</param>
+/// <param name="MaxLayers">The layers one compositor blends, including the main page.</param>
+/// <param name="SchedulerWorkers">The workers in the shared frame task scheduler.</param>
+/// <param name="SourceFramePoolDepth">The source frames each session keeps for rate conversion.</param>
+/// <param name="ClockResolutionMicroseconds">The tick of the clock used for frame timestamps.</param>
+/// <param name="SleepResolutionMilliseconds">The shortest sleep the helper's threads achieved.</param>
+/// <param name="LargePageBytes">The large page size the helper can allocate, or 0 when large pages are unavailable.</param>
+/// <param name="NumaNodes">The NUMA nodes in the system.</param>
+public sealed record CompositorCapabilities(
+    int AbiVersion,
+    CompositorPixelFormats PixelFormats,
+    CompositorFeatures Features,
+    CompositorSimdLevel CompiledSimdLevel,
+    CompositorSimdLevel CpuSimdLevel,
+    int MaxSupersampleFactor,
+    int MaxLayers,
+    int SchedulerWorkers,
+    int SourceFramePoolDepth,
+    double ClockResolutionMicroseconds,
+    double SleepResolutionMilliseconds,
+    long LargePageBytes,
+    int NumaNodes)
+{
+    /// <summary>
+    /// Determines whether every one of the given features is available.
+    /// </summary>
+    /// <param name="features">The features to check.</param>
+    /// <returns><c>true</c> when the helper supports all of them.</returns>
+    public bool Supports(CompositorFeatures features) => (this.Features & features) == features;
+}
@@ -0,0 +1,51 @@
+namespace Tractus.HtmlToNdi.Models;
+
+/// <summary>
+/// A duration histogram from the native helper. Bucket <c>i</c> counts durations up to
+/// <see cref="UpperBoundNanoseconds"/> of <c>i</c>; the last bucket counts everything longer.
+/// </summary>
+/// <param name="Count">The durations recorded.</param>
+/// <param name="SumNanoseconds">The sum of the durations recorded.</param>
+/// <param name="Buckets">The per-bucket counts, not cumulative.</param>
+public sealed record CompositorHistogram(long Count, long SumNanoseconds, IReadOnlyList<long> Buckets)
+{
+    /// <summary>
+    /// The number of buckets, including the unbounded last one.
+    /// </summary>
+    public const int BucketCount = 17;
+
+    /// <summary>
+    /// Gets the inclusive upper bound of a bucket, or <see cref="long.MaxValue"/> for the last one.
+    /// </summary>
+    /// <param name="bucket">The bucket index.</param>
+    /// <returns>The bound in nanoseconds.</returns>
+    public static long UpperBoundNanoseconds(int bucket) => bucket >= BucketCount - 1 ? long.MaxValue : 1024L << bucket;
+}
+
+/// <summary>
+/// Event counts and duration histograms of the native helper since the process started, as reported by
+/// <c>cc_get_counters</c>.
+/// </summary>
+/// <param name="FramesCaptured">The frames produced by capture sessions.</param>
+/// <param name="FramesDelivered">The frames handed to session callbacks.</param>
+/// <param name="LayerFramesSubmitted">The frames submitted to a layer compositor instead of a callback.</param>
+/// <param name="RenditionFramesDelivered">The scaled frames handed to rendition callbacks.</param>
+/// <param name="OverlayFrames">The frames that had overlays burned in.</param>
+/// <param name="CompositesDelivered">The frames delivered by layer compositors.</param>
+/// <param name="TilesComposed">The layer tiles blended.</param>
+/// <param name="TilesSkipped">The layer tiles left untouched because no layer changed them.</param>
+/// <param name="FrameConversion">The time to produce each output frame, from rate conversion to alpha conversion.</param>
+/// <param name="RenditionConversion">The time to scale and convert each rendition frame.</param>
+/// <param name="Composite">The time to blend each layer composite.</param>
+public sealed record CompositorCounters(
+    long FramesCaptured,
+    long FramesDelivered,
+    long LayerFramesSubmitted,
+    long RenditionFramesDelivered,
+    long OverlayFrames,
+    long CompositesDelivered,
+    long TilesComposed,
+    long TilesSkipped,
+    CompositorHistogram FrameConversion,
+    CompositorHistogram RenditionConversion,
+    CompositorHistogram Composite);
@@ -0,0 +1,32 @@
+namespace Tractus.HtmlToNdi.Models;
+
+/// <summary>
+/// Use and high-water mark of one frame pool.
+/// </summary>
+/// <param name="InUseBytes">The bytes currently allocated.</param>
+/// <param name="HighWaterBytes">The most bytes allocated at once.</param>
+/// <param name="Refusals">The allocations refused because they would have exceeded the budget.</param>
+public sealed record FrameMemoryPoolStatistics(long InUseBytes, long HighWaterBytes, long Refusals);
+
+/// <summary>
+/// Frame-memory budget figures for the process, as reported by <c>cc_get_memory_stats</c>.
+/// </summary>
+/// <param name="BudgetBytes">The budget, or 0 when frame memory is unlimited.</param>
+/// <param name="InUseBytes">The bytes currently allocated across all pools.</param>
+/// <param name="HighWaterBytes">The most bytes allocated at once across all pools.</param>
+/// <param name="Refusals">The allocations refused because they would have exceeded the budget.</param>
+/// <param name="TrimmedBytes">The bytes freed because sessions stopped and their pools went idle.</param>
+/// <param name="Capture">The session staging, supersampling, rate-conversion, interlace and straight-alpha buffers.</param>
+/// <param name="Renditions">The scaled rendition outputs.</param>
+/// <param name="Layers">The layer compositor rings and composites.</param>
+/// <param name="Pipeline">The frames buffered by the paced pipelines.</param>
+public sealed record FrameMemoryStatistics(
+    long BudgetBytes,
+    long InUseBytes,
+    long HighWaterBytes,
+    long Refusals,
+    long TrimmedBytes,
+    FrameMemoryPoolStatistics Capture,
+    FrameMemoryPoolStatistics Renditions,
+    FrameMemoryPoolStatistics Layers,
+    FrameMemoryPoolStatistics Pipeline);
@@ -0,0 +1,37 @@
+namespace Tractus.HtmlToNdi.Models;
+
+/// <summary>
+/// Alignment figures for one composited layer. Ages run from a frame's capture to the composite that used it.
+/// </summary>
+/// <param name="ZOrder">The layer position; the main page is 0 and higher layers are drawn on top.</param>
+/// <param name="DelayFrames">The configured alignment delay.</param>
+/// <param name="FramesSubmitted">Frames the layer's capture session handed to the compositor.</param>
+/// <param name="FramesDropped">Frames discarded because the compositor was still reading the slot they needed.</param>
+/// <param name="LastAgeMilliseconds">The age of the frame used by the most recent composite.</param>
+/// <param name="MeanAgeMilliseconds">The mean age across all composites.</param>
+/// <param name="SkewMilliseconds">How much older this layer's frames are on average than the freshest layer's.</param>
+public sealed record LayerStatistics(
+    int ZOrder,
+    int DelayFrames,
+    ulong FramesSubmitted,
+    ulong FramesDropped,
+    double LastAgeMilliseconds,
+    double MeanAgeMilliseconds,
+    double SkewMilliseconds);
+
+/// <summary>
+/// Response of the "layers" API endpoint.
+/// </summary>
+/// <param name="Frames">The number of composites produced.</param>
+/// <param name="TilesComposed">Tiles blended into the output.</param>
+/// <param name="TilesSkipped">Tiles left untouched because no contributing layer changed.</param>
+/// <param name="LastComposeMilliseconds">The duration of the most recent composite.</param>
+/// <param name="PeakComposeMilliseconds">The slowest composite observed.</param>
+/// <param name="Layers">Per-layer figures, bottom to top.</param>
+public sealed record LayerCompositorStatistics(
+    ulong Frames,
+    ulong TilesComposed,
+    ulong TilesSkipped,
+    double LastComposeMilliseconds,
+    double PeakComposeMilliseconds,
+    IReadOnlyList<LayerStatistics> Layers);
@@ -0,0 +1,198 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Models;
+
+/// <summary>
+/// Kinds of overlay the native compositor can burn into captured frames.
+/// </summary>
+public enum OverlayKind
+{
+    /// <summary>
+    /// Running timecode derived from the output frame count (drop-frame for 29.97 and 59.94).
+    /// </summary>
+    Timecode = 0,
+
+    /// <summary>
+    /// Local wall-clock time.
+    /// </summary>
+    Clock = 1,
+
+    /// <summary>
+    /// Solid border around the whole frame.
+    /// </summary>
+    TallyBorder = 2,
+
+    /// <summary>
+    /// Action-safe (93%) and title-safe (90%) outlines.
+    /// </summary>
+    SafeArea = 3,
+
+    /// <summary>
+    /// Filled rectangle.
+    /// </summary>
+    Rectangle = 4,
+}
+
+/// <summary>
+/// Represents one overlay in the "overlays" API endpoint.
+/// </summary>
+public class OverlayModel
+{
+    /// <summary>
+    /// Gets or sets the overlay kind: <c>timecode</c>, <c>clock</c>, <c>tally</c>, <c>safe-area</c> or <c>rectangle</c>.
+    /// </summary>
+    public required string Kind { get; set; }
+
+    /// <summary>
+    /// Gets or sets the left edge of text and rectangles, in pixels.
+    /// </summary>
+    public int X { get; set; }
+
+    /// <summary>
+    /// Gets or sets the top edge of text and rectangles, in pixels.
+    /// </summary>
+    public int Y { get; set; }
+
+    /// <summary>
+    /// Gets or sets the rectangle width; ignored by the other kinds.
+    /// </summary>
+    public int Width { get; set; }
+
+    /// <summary>
+    /// Gets or sets the rectangle height; ignored by the other kinds.
+    /// </summary>
+    public int Height { get; set; }
+
+    /// <summary>
+    /// Gets or sets the fill colour as <c>#RRGGBB</c> or <c>#AARRGGBB</c>.
+    /// </summary>
+    public string Color { get; set; } = "#FFFFFFFF";
+
+    /// <summary>
+    /// Gets or sets the box colour drawn behind timecode and clock text, or <c>null</c> for none.
+    /// </summary>
+    public string? Background { get; set; }
+
+    /// <summary>
+    /// Gets or sets the text scale; each font pixel becomes <c>Scale</c> x <c>Scale</c> output pixels (1-16).
+    /// </summary>
+    public int Scale { get; set; } = 4;
+
+    /// <summary>
+    /// Gets or sets the line thickness of tally borders and safe-area outlines; zero selects a default.
+    /// </summary>
+    public int Thickness { get; set; }
+
+    /// <summary>
+    /// Validates the model and converts it to the form passed to the native compositor.
+    /// </summary>
+    /// <param name="definition">When this method returns <c>true</c>, contains the parsed overlay.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes the invalid field.</param>
+    /// <returns><c>true</c> when the model is valid.</returns>
+    public bool TryCreateDefinition(out OverlayDefinition definition, out string? error)
+    {
+        definition = default!;
+        if (!TryParseKind(this.Kind, out var kind))
+        {
+            error = $"Unknown overlay kind '{this.Kind}'.";
+            return false;
+        }
+
+        if (!TryParseColor(this.Color, out var color))
+        {
+            error = $"Invalid overlay colour '{this.Color}'.";
+            return false;
+        }
+
+        uint background = 0;
+        if (!string.IsNullOrWhiteSpace(this.Background) && !TryParseColor(this.Background, out background))
+        {
+            error = $"Invalid overlay background '{this.Background}'.";
+            return false;
+        }
+
+        if (this.Scale is < 1 or > 16)
+        {
+            error = "Overlay scale must be between 1 and 16.";
+            return false;
+        }
+
+        if (kind == OverlayKind.Rectangle && (this.Width <= 0 || this.Height <= 0))
+        {
+            error = "Rectangle overlays need a positive width and height.";
+            return false;
+        }
+
+        definition = new OverlayDefinition(kind, this.X, this.Y, this.Width, this.Height, color, background, this.Scale, Math.Max(0, this.Thickness));
+        error = null;
+        return true;
+    }
+
+    /// <summary>
+    /// Parses an overlay kind, accepting the enum names and the hyphenated API spellings.
+    /// </summary>
+    internal static bool TryParseKind(string? value, out OverlayKind kind)
+    {
+        kind = OverlayKind.Rectangle;
+        if (string.IsNullOrWhiteSpace(value))
+        {
+            return false;
+        }
+
+        var normalized = value.Trim().Replace("-", string.Empty, StringComparison.Ordinal);
+        if (normalized.Equals("tally", StringComparison.OrdinalIgnoreCase))
+        {
+            kind = OverlayKind.TallyBorder;
+            return true;
+        }
+
+        return Enum.TryParse(normalized, ignoreCase: true, out kind) && Enum.IsDefined(kind) && !int.TryParse(normalized, out _);
+    }
+
+    /// <summary>
+    /// Parses <c>#RRGGBB</c> (opaque) or <c>#AARRGGBB</c> into a straight-alpha <c>0xAARRGGBB</c> value.
+    /// </summary>
+    internal static bool TryParseColor(string? value, out uint color)
+    {
+        color = 0;
+        if (string.IsNullOrWhiteSpace(value))
+        {
+            return false;
+        }
+
+        var hex = value.Trim().TrimStart('#');
+        if ((hex.Length != 6 && hex.Length != 8) || !uint.TryParse(hex, NumberStyles.AllowHexSpecifier, CultureInfo.InvariantCulture, out color))
+        {
+            return false;
+        }
+
+        if (hex.Length == 6)
+        {
+            color |= 0xFF000000u;
+        }
+
+        return true;
+    }
+}
+
+/// <summary>
+/// A validated overlay with colours resolved to straight-alpha <c>0xAARRGGBB</c>.
+/// </summary>
+public sealed record OverlayDefinition(OverlayKind Kind, int X, int Y, int Width, int Height, uint Color, uint Background, int Scale, int Thickness);
+
+/// <summary>
+/// Overlay blend cost reported by the native compositor since the overlays were last replaced.
+/// </summary>
+/// <param name="Frames">The number of frames the overlays were blended into.</param>
+/// <param name="LastPixelsBlended">The number of pixels written for the most recent frame.</param>
+/// <param name="LastBlendMilliseconds">The blend time of the most recent frame.</param>
+/// <param name="PeakBlendMilliseconds">The slowest blend observed.</param>
+/// <param name="AverageBlendMilliseconds">The mean blend time per frame.</param>
+public sealed record OverlayStatistics(ulong Frames, ulong LastPixelsBlended, double LastBlendMilliseconds, double PeakBlendMilliseconds, double AverageBlendMilliseconds);
+
+/// <summary>
+/// Response of the "overlays" API endpoint.
+/// </summary>
+/// <param name="Overlays">The overlays currently applied.</param>
+/// <param name="Statistics">The blend statistics, or <c>null</c> when compositor capture is not active.</param>
+public sealed record OverlayStatusModel(IReadOnlyList<OverlayModel> Overlays, OverlayStatistics? Statistics);
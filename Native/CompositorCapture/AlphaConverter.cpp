@@ -0,0 +1,243 @@
+#include "AlphaConverter.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_ALPHA_SSE2 1
+#else
+#define TRACTUS_ALPHA_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr int32_t kRowsPerBand = 64;
+
+/// <summary>
+/// One entry per alpha value holding <c>255 / a</c> for the three colour lanes and 1 for the alpha lane, laid
+/// out in BGRA order so a pixel widened to four floats is converted by one multiply.
+/// </summary>
+struct alignas(16) ReciprocalEntry
+{
+    float lanes[4];
+};
+
+const std::array<ReciprocalEntry, 256>& Reciprocals()
+{
+    static const auto table = []
+    {
+        std::array<ReciprocalEntry, 256> entries{};
+        entries[0] = {{0.0f, 0.0f, 0.0f, 1.0f}};
+        for (int alpha = 1; alpha < 256; ++alpha)
+        {
+            // Nudged up by 2^-19 so products that land exactly on .5 round up like the integer divide does;
+            // the nudge is far smaller than the distance from .5 of any product that is not a tie.
+            const auto reciprocal = alpha == 255 ? 1.0f : static_cast<float>(255.0 / alpha * (1.0 + 1.0 / 524288.0));
+            entries[alpha] = {{reciprocal, reciprocal, reciprocal, 1.0f}};
+        }
+
+        return entries;
+    }();
+
+    return table;
+}
+
+inline uint8_t UnpremultiplyChannel(uint8_t channel, const ReciprocalEntry& entry)
+{
+    const auto value = static_cast<int32_t>(static_cast<float>(channel) * entry.lanes[0] + 0.5f);
+    return static_cast<uint8_t>(value > 255 ? 255 : value);
+}
+
+#if TRACTUS_ALPHA_SSE2
+inline __m128i UnpremultiplyPixel(__m128i widened, const ReciprocalEntry& entry)
+{
+    const auto scaled = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(widened), _mm_load_ps(entry.lanes)), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(scaled);
+}
+#endif
+} // namespace
+
+bool IsOpaque(const uint8_t* pixels, int32_t stride, int32_t width, int32_t row_begin, int32_t row_end)
+{
+    for (int32_t y = row_begin; y < row_end; ++y)
+    {
+        const auto* row = pixels + static_cast<size_t>(y) * static_cast<size_t>(stride);
+        int32_t x = 0;
+
+#if TRACTUS_ALPHA_SSE2
+        const auto alpha_mask = _mm_set1_epi32(static_cast<int32_t>(0xFF000000u));
+        auto all = _mm_set1_epi32(-1);
+        for (; x + 16 <= width; x += 16)
+        {
+            const auto* block = reinterpret_cast<const __m128i*>(row + static_cast<size_t>(x) * 4u);
+            all = _mm_and_si128(all, _mm_and_si128(_mm_and_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+                                                   _mm_and_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3))));
+        }
+
+        for (; x + 4 <= width; x += 4)
+        {
+            all = _mm_and_si128(all, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(x) * 4u)));
+        }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, alpha_mask), alpha_mask)) != 0xFFFF)
+        {
+            return false;
+        }
+#endif
+
+        for (; x < width; ++x)
+        {
+            if (row[static_cast<size_t>(x) * 4u + 3u] != 255u)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void UnpremultiplyRow(const uint8_t* source, uint8_t* destination, int32_t pixels)
+{
+    const auto& reciprocals = Reciprocals();
+    int32_t x = 0;
+
+#if TRACTUS_ALPHA_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto alpha_mask = _mm_set1_epi32(static_cast<int32_t>(0xFF000000u));
+    for (; x + 4 <= pixels; x += 4)
+    {
+        const auto offset = static_cast<size_t>(x) * 4u;
+        const auto packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+        const auto alphas = _mm_and_si128(packed, alpha_mask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphas, alpha_mask)) == 0xFFFF)
+        {
+            if (source != destination)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), packed);
+            }
+
+            continue;
+        }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphas, zero)) == 0xFFFF)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), zero);
+            continue;
+        }
+
+        const auto* alpha = source + offset + 3u;
+        const auto low = _mm_unpacklo_epi8(packed, zero);
+        const auto high = _mm_unpackhi_epi8(packed, zero);
+        const auto p0 = UnpremultiplyPixel(_mm_unpacklo_epi16(low, zero), reciprocals[alpha[0]]);
+        const auto p1 = UnpremultiplyPixel(_mm_unpackhi_epi16(low, zero), reciprocals[alpha[4]]);
+        const auto p2 = UnpremultiplyPixel(_mm_unpacklo_epi16(high, zero), reciprocals[alpha[8]]);
+        const auto p3 = UnpremultiplyPixel(_mm_unpackhi_epi16(high, zero), reciprocals[alpha[12]]);
+        // Saturating packs clamp colours that exceeded their alpha in malformed input to 255.
+        const auto result = _mm_packus_epi16(_mm_packs_epi32(p0, p1), _mm_packs_epi32(p2, p3));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), result);
+    }
+#endif
+
+    for (; x < pixels; ++x)
+    {
+        const auto* in = source + static_cast<size_t>(x) * 4u;
+        auto* out = destination + static_cast<size_t>(x) * 4u;
+        const auto alpha = in[3];
+        const auto& entry = reciprocals[alpha];
+        out[0] = UnpremultiplyChannel(in[0], entry);
+        out[1] = UnpremultiplyChannel(in[1], entry);
+        out[2] = UnpremultiplyChannel(in[2], entry);
+        out[3] = alpha;
+    }
+}
+
+void UnpremultiplyRows(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t row_begin, int32_t row_end)
+{
+    for (int32_t y = row_begin; y < row_end; ++y)
+    {
+        const auto offset = static_cast<size_t>(y) * static_cast<size_t>(stride);
+        UnpremultiplyRow(source + offset, destination + offset, width);
+    }
+}
+
+const uint8_t* UnpremultiplyFrame(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t height,
+                                  FrameTaskScheduler* scheduler, FrameTaskClock::time_point due, bool& opaque)
+{
+    const auto bands = static_cast<size_t>((height + kRowsPerBand - 1) / kRowsPerBand);
+    std::vector<uint8_t> opaque_bands(bands, 0u);
+    std::atomic<size_t> opaque_count{0};
+    const auto convert = [&](size_t begin, size_t end)
+    {
+        for (auto band = begin; band < end; ++band)
+        {
+            const auto row_begin = static_cast<int32_t>(band) * kRowsPerBand;
+            const auto row_end = row_begin + kRowsPerBand < height ? row_begin + kRowsPerBand : height;
+            if (IsOpaque(source, stride, width, row_begin, row_end))
+            {
+                opaque_bands[band] = 1u;
+                opaque_count.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            UnpremultiplyRows(source, destination, stride, width, row_begin, row_end);
+        }
+    };
+
+    if (scheduler)
+    {
+        scheduler->ParallelFor(bands, 1, due, convert);
+    }
+    else
+    {
+        convert(0, bands);
+    }
+
+    opaque = opaque_count.load() == bands;
+    if (opaque)
+    {
+        return source;
+    }
+
+    if (source != destination)
+    {
+        // Opaque bands were skipped above; bring them across so the converted frame is complete.
+        const auto bytes = static_cast<size_t>(width) * 4u;
+        const auto copy = [&](size_t begin, size_t end)
+        {
+            for (auto band = begin; band < end; ++band)
+            {
+                if (!opaque_bands[band])
+                {
+                    continue;
+                }
+
+                const auto row_begin = static_cast<int32_t>(band) * kRowsPerBand;
+                const auto row_end = row_begin + kRowsPerBand < height ? row_begin + kRowsPerBand : height;
+                for (auto y = row_begin; y < row_end; ++y)
+                {
+                    const auto offset = static_cast<size_t>(y) * static_cast<size_t>(stride);
+                    std::memcpy(destination + offset, source + offset, bytes);
+                }
+            }
+        };
+
+        if (scheduler)
+        {
+            scheduler->ParallelFor(bands, 1, due, copy);
+        }
+        else
+        {
+            copy(0, bands);
+        }
+    }
+
+    return destination;
+}
+} // namespace tractus
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "FrameTaskScheduler.h"
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Returns true when every pixel in rows [<paramref name="row_begin"/>, <paramref name="row_end"/>) has alpha 255.
+/// The scan stops at the first row that is not opaque, so translucent frames cost little more than one row.
+/// </summary>
+bool IsOpaque(const uint8_t* pixels, int32_t stride, int32_t width, int32_t row_begin, int32_t row_end);
+
+/// <summary>
+/// Converts premultiplied BGRA to straight alpha: each colour becomes <c>round(c * 255 / a)</c>, clamped to 255,
+/// and pixels with zero alpha become transparent black. The divide is replaced by a multiply with a per-alpha
+/// reciprocal from a lookup table; results match the exact divide for every input. Groups of four opaque pixels
+/// are copied unchanged and groups of four transparent pixels are cleared without arithmetic.
+/// <paramref name="source"/> may equal <paramref name="destination"/>.
+/// </summary>
+void UnpremultiplyRow(const uint8_t* source, uint8_t* destination, int32_t pixels);
+
+/// <summary>
+/// Runs <see cref="UnpremultiplyRow"/> over rows [<paramref name="row_begin"/>, <paramref name="row_end"/>).
+/// </summary>
+void UnpremultiplyRows(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t row_begin, int32_t row_end);
+
+/// <summary>
+/// Converts a whole frame to straight alpha. Each band of rows is scanned first and only converted when it holds a
+/// translucent pixel, so an opaque frame is read once and never written. When every band is opaque the source is
+/// returned untouched; otherwise the result is in <paramref name="destination"/>, which may equal
+/// <paramref name="source"/>. Bands run on the scheduler's deadline lane when one is supplied.
+/// </summary>
+/// <param name="opaque">Set to whether every pixel had alpha 255.</param>
+/// <returns>The buffer holding the straight-alpha frame.</returns>
+const uint8_t* UnpremultiplyFrame(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t height,
+                                  FrameTaskScheduler* scheduler, FrameTaskClock::time_point due, bool& opaque);
+} // namespace tractus
@@ -0,0 +1,114 @@
+#include "BoxDownsampler.h"
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_BOX_SSE2 1
+#else
+#define TRACTUS_BOX_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+void DownsampleRow2x(const uint8_t* row0, const uint8_t* row1, uint8_t* output, int32_t width)
+{
+    int32_t x = 0;
+
+#if TRACTUS_BOX_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto round = _mm_set1_epi16(2);
+    // Each iteration consumes four source pixels per row and produces two output pixels.
+    for (; x + 2 <= width; x += 2)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + static_cast<size_t>(x) * 8u));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + static_cast<size_t>(x) * 8u));
+        const auto low = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        const auto high = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        auto sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), _mm_unpackhi_epi64(low, high));
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + static_cast<size_t>(x) * 4u), _mm_packus_epi16(sum, sum));
+    }
+#endif
+
+    for (; x < width; ++x)
+    {
+        const auto* a = row0 + static_cast<size_t>(x) * 8u;
+        const auto* b = row1 + static_cast<size_t>(x) * 8u;
+        for (int c = 0; c < 4; ++c)
+        {
+            output[x * 4 + c] = static_cast<uint8_t>((a[c] + a[c + 4] + b[c] + b[c + 4] + 2) >> 2);
+        }
+    }
+}
+
+void DownsampleRow4x(const uint8_t* const* rows, uint8_t* output, int32_t width)
+{
+    int32_t x = 0;
+
+#if TRACTUS_BOX_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto round = _mm_set1_epi16(8);
+    // Each iteration consumes four source pixels per row (one 16-byte load) and produces one output pixel.
+    for (; x < width; ++x)
+    {
+        auto sum = zero;
+        for (int r = 0; r < 4; ++r)
+        {
+            const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[r] + static_cast<size_t>(x) * 16u));
+            sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_unpacklo_epi8(v, zero), _mm_unpackhi_epi8(v, zero)));
+        }
+
+        sum = _mm_add_epi16(sum, _mm_srli_si128(sum, 8));
+        sum = _mm_srli_epi16(_mm_add_epi16(sum, round), 4);
+        const auto packed = _mm_cvtsi128_si32(_mm_packus_epi16(sum, sum));
+        std::memcpy(output + static_cast<size_t>(x) * 4u, &packed, sizeof(packed));
+    }
+#endif
+
+    for (; x < width; ++x)
+    {
+        for (int c = 0; c < 4; ++c)
+        {
+            uint32_t sum = 8;
+            for (int r = 0; r < 4; ++r)
+            {
+                const auto* p = rows[r] + static_cast<size_t>(x) * 16u;
+                sum += p[c] + p[c + 4] + p[c + 8] + p[c + 12];
+            }
+
+            output[x * 4 + c] = static_cast<uint8_t>(sum >> 4);
+        }
+    }
+}
+} // namespace
+
+bool DownsampleBox(const uint8_t* source, int32_t source_stride, uint8_t* destination, int32_t destination_stride,
+                   int32_t destination_width, int32_t first_row, int32_t end_row, int32_t factor)
+{
+    if (factor != 2 && factor != 4)
+    {
+        return false;
+    }
+
+    for (int32_t y = first_row; y < end_row; ++y)
+    {
+        const auto* base = source + static_cast<size_t>(y) * factor * source_stride;
+        auto* output = destination + static_cast<size_t>(y) * destination_stride;
+        if (factor == 2)
+        {
+            DownsampleRow2x(base, base + source_stride, output, destination_width);
+        }
+        else
+        {
+            const uint8_t* rows[4] = {base, base + source_stride, base + 2 * static_cast<size_t>(source_stride), base + 3 * static_cast<size_t>(source_stride)};
+            DownsampleRow4x(rows, output, destination_width);
+        }
+    }
+
+    return true;
+}
+} // namespace tractus
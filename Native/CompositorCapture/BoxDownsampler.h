@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Averages <paramref name="factor"/> x <paramref name="factor"/> blocks of a BGRA surface into destination rows
+/// [<paramref name="first_row"/>, <paramref name="end_row"/>). Supports factors 2 and 4; the source is read exactly
+/// once and each destination pixel is written once, so the downsample doubles as the copy into the output buffer.
+/// </summary>
+/// <returns><c>false</c> when the factor is unsupported.</returns>
+bool DownsampleBox(const uint8_t* source, int32_t source_stride, uint8_t* destination, int32_t destination_stride,
+                   int32_t destination_width, int32_t first_row, int32_t end_row, int32_t factor);
+} // namespace tractus
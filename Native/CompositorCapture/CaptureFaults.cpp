@@ -0,0 +1,169 @@
+#include "CaptureFaults.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace tractus
+{
+bool CaptureFaultProfile::Enabled() const
+{
+    return jitter.count() > 0 || (burst_period > 0 && burst_length > 1) || (stall_probability > 0.0 && max_stall.count() > 0) ||
+           drift_ppm != 0.0 || (preemption_probability > 0.0 && preemption.count() > 0);
+}
+
+CaptureFaultInjector::CaptureFaultInjector(const CaptureFaultProfile& profile, PacingClock::Duration interval)
+    : profile_(profile),
+      interval_ticks_(static_cast<double>(interval.count()) / (1.0 + profile.drift_ppm / 1'000'000.0)),
+      random_(profile.seed)
+{
+    if (profile_.max_stall < profile_.min_stall)
+    {
+        profile_.max_stall = profile_.min_stall;
+    }
+}
+
+void CaptureFaultInjector::Restart(PacingClock::TimePoint origin)
+{
+    origin_ = origin;
+    origin_frame_ = next_frame_;
+    stall_end_ = origin;
+    burst_remaining_ = 0;
+    last_due_ = origin;
+}
+
+CaptureFaultStep CaptureFaultInjector::Next()
+{
+    uint64_t frame = 0;
+    PacingClock::TimePoint nominal;
+    for (;;)
+    {
+        frame = next_frame_++;
+        nominal = Nominal(frame);
+        if (nominal >= stall_end_ && burst_remaining_ == 0 && profile_.stall_probability > 0.0 && NextUniform() < profile_.stall_probability)
+        {
+            const auto span = static_cast<double>((profile_.max_stall - profile_.min_stall).count());
+            stall_end_ = nominal + profile_.min_stall + PacingClock::Duration(static_cast<PacingClock::Duration::rep>(span * NextUniform()));
+        }
+
+        if (nominal >= stall_end_)
+        {
+            break;
+        }
+
+        frames_stalled_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (burst_remaining_ == 0 && profile_.burst_period > 0 && profile_.burst_length > 1 && frame % profile_.burst_period == 0)
+    {
+        burst_remaining_ = profile_.burst_length;
+        burst_release_ = Nominal(frame + profile_.burst_length - 1);
+    }
+
+    auto due = nominal;
+    if (profile_.jitter.count() > 0)
+    {
+        due += PacingClock::Duration(static_cast<PacingClock::Duration::rep>(std::abs(NextGaussian()) * static_cast<double>(profile_.jitter.count())));
+    }
+
+    if (burst_remaining_ > 0)
+    {
+        --burst_remaining_;
+        due = std::max(due, burst_release_);
+        burst_frames_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // A source delivers its frames in order, however late each one is.
+    due = std::max(due, last_due_);
+    last_due_ = due;
+
+    CaptureFaultStep step;
+    step.frame_index = frame;
+    step.due = due;
+    if (profile_.preemption_probability > 0.0 && profile_.preemption.count() > 0 && NextUniform() < profile_.preemption_probability)
+    {
+        step.preemption = profile_.preemption;
+        preemptions_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    frames_delivered_.fetch_add(1, std::memory_order_relaxed);
+    const auto delay = (due - nominal).count();
+    if (delay > max_delay_.load(std::memory_order_relaxed))
+    {
+        max_delay_.store(delay, std::memory_order_relaxed);
+    }
+
+    return step;
+}
+
+CaptureFaultStats CaptureFaultInjector::Stats() const
+{
+    CaptureFaultStats stats;
+    stats.frames_delivered = frames_delivered_.load(std::memory_order_relaxed);
+    stats.frames_stalled = frames_stalled_.load(std::memory_order_relaxed);
+    stats.burst_frames = burst_frames_.load(std::memory_order_relaxed);
+    stats.preemptions = preemptions_.load(std::memory_order_relaxed);
+    stats.max_delay = PacingClock::Duration(max_delay_.load(std::memory_order_relaxed));
+    return stats;
+}
+
+PacingClock::TimePoint CaptureFaultInjector::Nominal(uint64_t frame) const
+{
+    const auto frames = static_cast<double>(frame - origin_frame_);
+    return origin_ + PacingClock::Duration(static_cast<PacingClock::Duration::rep>(std::llround(frames * interval_ticks_)));
+}
+
+double CaptureFaultInjector::NextUniform()
+{
+    // The top 53 bits of the engine's output, which the standard fixes, rather than a distribution, which it does not.
+    return static_cast<double>(random_() >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double CaptureFaultInjector::NextGaussian()
+{
+    const auto u1 = 1.0 - NextUniform();
+    const auto u2 = NextUniform();
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+}
+
+void RunCaptureLoop(PacingClock& clock, PacingClock::Duration interval, CaptureFaultInjector* faults, const std::atomic<bool>& running,
+                    uint64_t& next_frame_index, const std::function<bool(const CaptureLoopFrame&)>& produce)
+{
+    FrameCadence cadence(clock, interval);
+    if (faults)
+    {
+        faults->Restart(clock.Now());
+    }
+
+    while (running.load())
+    {
+        CaptureFaultStep fault;
+        if (faults)
+        {
+            // The injector owns the cadence: it decides when each frame arrives and which frames a stall loses.
+            fault = faults->Next();
+            clock.SleepUntil(fault.due);
+            if (!running.load())
+            {
+                break;
+            }
+        }
+
+        CaptureLoopFrame frame;
+        frame.monotonic = clock.Now();
+        frame.frame_index = faults ? fault.frame_index : next_frame_index++;
+        if (!produce(frame))
+        {
+            break;
+        }
+
+        if (faults)
+        {
+            clock.SleepUntil(clock.Now() + fault.preemption);
+        }
+        else
+        {
+            cadence.WaitForNextFrame(frame.monotonic);
+        }
+    }
+}
+} // namespace tractus
@@ -0,0 +1,138 @@
+#pragma once
+
+#include "PacingClock.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace tractus
+{
+/// <summary>
+/// The disturbances a <c>CaptureFaultInjector</c> adds to a steady capture cadence. All zero adds none.
+/// </summary>
+struct CaptureFaultProfile
+{
+    /// <summary>Seeds every random choice, so a profile replays the same faults.</summary>
+    uint64_t seed{1};
+
+    /// <summary>Standard deviation of how late each frame is delivered after it is due.</summary>
+    PacingClock::Duration jitter{0};
+
+    /// <summary>Every this many frames a burst begins; zero disables bursts.</summary>
+    uint32_t burst_period{0};
+
+    /// <summary>Frames held back at the start of each period and delivered back to back with the last of them.</summary>
+    uint32_t burst_length{0};
+
+    /// <summary>Chance, per frame, that the source renders nothing for a while.</summary>
+    double stall_probability{0.0};
+
+    PacingClock::Duration min_stall{0};
+    PacingClock::Duration max_stall{0};
+
+    /// <summary>How far the source clock runs ahead of nominal, in parts per million; negative runs slow.</summary>
+    double drift_ppm{0.0};
+
+    /// <summary>Chance, per frame, that the delivering thread is descheduled after the callback returns.</summary>
+    double preemption_probability{0.0};
+
+    PacingClock::Duration preemption{0};
+
+    bool Enabled() const;
+};
+
+/// <summary>
+/// When and how to deliver the next frame.
+/// </summary>
+struct CaptureFaultStep
+{
+    /// <summary>Source frame number; frames lost to a stall are skipped.</summary>
+    uint64_t frame_index{0};
+
+    /// <summary>When the frame is delivered.</summary>
+    PacingClock::TimePoint due{};
+
+    /// <summary>How long the delivering thread stays off the CPU after the callback returns.</summary>
+    PacingClock::Duration preemption{0};
+};
+
+/// <summary>
+/// Faults injected since the injector was created.
+/// </summary>
+struct CaptureFaultStats
+{
+    uint64_t frames_delivered{0};
+    uint64_t frames_stalled{0};
+    uint64_t burst_frames{0};
+    uint64_t preemptions{0};
+    /// <summary>Longest a frame was delivered after its nominal time.</summary>
+    PacingClock::Duration max_delay{0};
+};
+
+/// <summary>
+/// Turns a steady frame cadence into a disturbed one: frames are due on a drifted grid, delivered late by seeded
+/// Gaussian jitter, held back and released together in periodic bursts, skipped through stalls, and followed by
+/// preemptions of the delivering thread. Deliveries never go backwards. The random stream is a fixed
+/// <c>mt19937_64</c> sequence, so a seed replays the same faults on every platform. <c>Next</c> is called by one
+/// thread; <c>Stats</c> may be read from any.
+/// </summary>
+class CaptureFaultInjector
+{
+public:
+    CaptureFaultInjector(const CaptureFaultProfile& profile, PacingClock::Duration interval);
+
+    /// <summary>
+    /// Lays the grid from <paramref name="origin"/> again, as when a capture loop restarts. Frame numbers, the random
+    /// stream and the statistics carry on.
+    /// </summary>
+    void Restart(PacingClock::TimePoint origin);
+
+    CaptureFaultStep Next();
+
+    CaptureFaultStats Stats() const;
+
+private:
+    PacingClock::TimePoint Nominal(uint64_t frame) const;
+    double NextUniform();
+    double NextGaussian();
+
+    CaptureFaultProfile profile_;
+    double interval_ticks_;
+    PacingClock::TimePoint origin_{};
+    uint64_t origin_frame_{0};
+    uint64_t next_frame_{0};
+    PacingClock::TimePoint stall_end_{};
+    PacingClock::TimePoint burst_release_{};
+    uint32_t burst_remaining_{0};
+    PacingClock::TimePoint last_due_{};
+    std::mt19937_64 random_;
+    std::atomic<uint64_t> frames_delivered_{0};
+    std::atomic<uint64_t> frames_stalled_{0};
+    std::atomic<uint64_t> burst_frames_{0};
+    std::atomic<uint64_t> preemptions_{0};
+    std::atomic<PacingClock::Duration::rep> max_delay_{0};
+};
+
+/// <summary>
+/// A frame the capture loop is about to produce.
+/// </summary>
+struct CaptureLoopFrame
+{
+    /// <summary>Source frame number; with faults, frames lost to a stall are skipped.</summary>
+    uint64_t frame_index{0};
+
+    /// <summary>When the frame was captured, read from the loop's clock.</summary>
+    PacingClock::TimePoint monotonic{};
+};
+
+/// <summary>
+/// Runs the fallback capture loop on <paramref name="clock"/> until <paramref name="running"/> clears or
+/// <paramref name="produce"/> returns <c>false</c>. Without <paramref name="faults"/> frames are numbered on from
+/// <paramref name="next_frame_index"/> and paced by a <c>FrameCadence</c>; with an injector, it decides when each frame
+/// arrives, which frames a stall loses and how long the thread is preempted after each one.
+/// </summary>
+void RunCaptureLoop(PacingClock& clock, PacingClock::Duration interval, CaptureFaultInjector* faults, const std::atomic<bool>& running,
+                    uint64_t& next_frame_index, const std::function<bool(const CaptureLoopFrame&)>& produce);
+} // namespace tractus
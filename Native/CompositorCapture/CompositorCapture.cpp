@@ -1,7 +1,30 @@
 #include "CompositorCapture.h"
 
+#include "AlphaConverter.h"
+#include "BoxDownsampler.h"
+#include "CaptureFaults.h"
+#include "ContentHash.h"
+#include "CpuFeatures.h"
+#include "FieldWeaver.h"
+#include "FlightRecorder.h"
+#include "FrameAllocator.h"
+#include "FrameCopy.h"
+#include "FrameRateConverter.h"
+#include "FrameScaler.h"
+#include "FrameTaskScheduler.h"
+#include "LayerCompositor.h"
+#include "MemoryGovernor.h"
+#include "OverlayCompositor.h"
+#include "PacingClock.h"
+#include "TelemetryCounters.h"
+#include "ThreadPolicy.h"
+
+#include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstring>
 #include <memory>
 #include <thread>
 #include <vector>
@@ -28,18 +51,135 @@ public:
 
 namespace
 {
+/// <summary>
+/// Copies a caller's versioned struct into a zero-initialised one of the helper's own size. Fields the caller's
+/// header did not have keep their zero defaults, and fields from a newer header are ignored.
+/// </summary>
+/// <param name="minimum_size">Bytes the caller must supply for the struct to be usable.</param>
+/// <returns>false when the struct is unversioned or smaller than <paramref name="minimum_size"/>.</returns>
+template <typename T>
+bool ReadVersionedStruct(const T& input, T& output, size_t minimum_size)
+{
+    if (input.abi_version == 0 || input.struct_size < minimum_size)
+    {
+        return false;
+    }
+
+    output = T{};
+    std::memcpy(&output, &input, std::min<size_t>(input.struct_size, sizeof(T)));
+    output.struct_size = sizeof(T);
+    return true;
+}
+
+/// <summary>
+/// Translates the C ABI thread policy, treating unknown priority classes as normal.
+/// </summary>
+tractus::ThreadPolicy ToThreadPolicy(const CompositorThreadPolicy& policy)
+{
+    tractus::ThreadPolicy result;
+    if (policy.priority == CompositorThreadPriority::kHigh || policy.priority == CompositorThreadPriority::kRealtime)
+    {
+        result.priority = static_cast<tractus::ThreadPriorityClass>(policy.priority);
+    }
+
+    result.affinity_mask = policy.affinity_mask;
+    result.timer_slack_nanoseconds = policy.timer_slack_nanoseconds;
+    return result;
+}
+
+/// <summary>
+/// Translates the C ABI memory flags. NUMA placement follows the thread affinity, so it only applies when the thread
+/// that touches the pools is pinned.
+/// </summary>
+tractus::FrameMemoryPolicy ToMemoryPolicy(uint32_t memory_flags, const CompositorThreadPolicy& thread_policy, tractus::MemoryPool pool)
+{
+    tractus::FrameMemoryPolicy result;
+    result.pool = pool;
+    result.large_pages = (memory_flags & static_cast<uint32_t>(CompositorMemoryFlags::kLargePages)) != 0;
+    if ((memory_flags & static_cast<uint32_t>(CompositorMemoryFlags::kNumaLocal)) != 0)
+    {
+        result.numa_node = tractus::NumaNodeForAffinity(thread_policy.affinity_mask);
+    }
+
+    return result;
+}
+
+/// <summary>
+/// Translates the C ABI capture faults, treating negative durations and probabilities as zero.
+/// </summary>
+tractus::CaptureFaultProfile ToFaultProfile(const CompositorCaptureFaults& faults)
+{
+    auto microseconds = [](int64_t value) { return std::chrono::duration_cast<tractus::PacingClock::Duration>(std::chrono::microseconds(std::max<int64_t>(0, value))); };
+
+    tractus::CaptureFaultProfile result;
+    result.seed = faults.seed;
+    result.jitter = microseconds(faults.jitter_microseconds);
+    result.burst_period = static_cast<uint32_t>(std::max(0, faults.burst_period_frames));
+    result.burst_length = static_cast<uint32_t>(std::max(0, faults.burst_length_frames));
+    result.stall_probability = std::clamp(faults.stall_probability, 0.0, 1.0);
+    result.min_stall = microseconds(faults.min_stall_microseconds);
+    result.max_stall = microseconds(faults.max_stall_microseconds);
+    // Beyond ±50% the "drift" is a different frame rate, which source_frame_rate_numerator already expresses.
+    result.drift_ppm = std::clamp(faults.drift_ppm, -500'000.0, 500'000.0);
+    result.preemption_probability = std::clamp(faults.preemption_probability, 0.0, 1.0);
+    result.preemption = microseconds(faults.preemption_microseconds);
+    return result;
+}
+
+/// <summary>
+/// Measures the shortest sleep the platform delivers, which bounds how precisely capture threads can pace frames.
+/// </summary>
+int64_t MeasureSleepResolution()
+{
+    auto shortest = std::chrono::nanoseconds::max();
+    for (int attempt = 0; attempt < 3; ++attempt)
+    {
+        const auto started = std::chrono::steady_clock::now();
+        std::this_thread::sleep_for(std::chrono::microseconds(1));
+        shortest = std::min(shortest, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started));
+    }
+
+    return shortest.count();
+}
+
 /// <summary>
 /// Implements compositor capture orchestration by owning the viz capturer and dispatch logic.
 /// </summary>
 class CompositorCaptureSessionImpl
 {
 public:
+    /// <summary>Source frames kept for rate conversion; drop/repeat and blending need at most two.</summary>
+    static constexpr size_t kSourceFramePoolDepth = 2;
+
     /// <summary>
-    /// Creates a new compositor capture session implementation.
+    /// Creates a new compositor capture session implementation whose fallback loop runs on <paramref name="clock"/>.
     /// </summary>
-    CompositorCaptureSessionImpl(CefBrowserHost* /*browser_host*/, const CompositorCaptureConfig& config, CompositorFrameCallback callback, void* user_data)
-        : config_(config), callback_(callback), user_data_(user_data)
+    CompositorCaptureSessionImpl(CefBrowserHost* /*browser_host*/, const CompositorCaptureConfig& config, CompositorFrameCallback callback, void* user_data,
+                                 tractus::PacingClock& clock = tractus::PacingClock::System())
+        : config_(config), callback_(callback), user_data_(user_data), clock_(clock), scheduler_(tractus::FrameTaskScheduler::AcquireShared())
     {
+        if (config_.supersample_factor != 2 && config_.supersample_factor != 4)
+        {
+            config_.supersample_factor = 1;
+        }
+
+        memory_policy_ = ToMemoryPolicy(config_.memory_flags, config_.thread_policy, tractus::MemoryPool::kCapture);
+        for (auto* buffer : {&staging_buffer_, &surface_buffer_, &interleaved_buffer_, &straight_buffer_})
+        {
+            buffer->SetPolicy(memory_policy_);
+        }
+
+        for (auto& source : source_frames_)
+        {
+            source.pixels.SetPolicy(memory_policy_);
+        }
+
+        const auto faults = ToFaultProfile(config_.faults);
+        if (faults.Enabled())
+        {
+            faults_ = std::make_unique<tractus::CaptureFaultInjector>(faults, CalculateFrameInterval(config_));
+        }
+
         capturer_ = CreateCapturer();
     }
 
@@ -54,7 +194,8 @@ public:
     /// <summary>
     /// Starts the compositor capture flow and primes the viz capturer when available.
     /// </summary>
-    void Start()
+    /// <returns><c>false</c> when the session's frame pools do not fit in the frame-memory budget.</returns>
+    bool Start()
     {
 #if TRACTUS_HAS_VIZ_CAPTURER
         if (capturer_)
@@ -62,9 +203,13 @@ public:
             capturer_->Start();
         }
 #else
-        StartFallbackLoop();
+        if (!StartFallbackLoop())
+        {
+            return false;
+        }
 #endif
         started_ = true;
+        return true;
     }
 
     /// <summary>
@@ -83,6 +228,115 @@ public:
         started_ = false;
     }
 
+    /// <summary>
+    /// Adds a scaled output rendition. Renditions are fixed once the session starts so the capture thread can
+    /// walk them without locking.
+    /// </summary>
+    int32_t AddRendition(const CompositorRenditionConfig& config, CompositorFrameCallback callback, void* user_data)
+    {
+        if (started_ || callback == nullptr || config.width <= 0 || config.height <= 0)
+        {
+            return -1;
+        }
+
+        auto rendition = std::make_unique<Rendition>();
+        rendition->config = config;
+        rendition->config.frame_rate_divider = std::max(1, config.frame_rate_divider);
+        rendition->callback = callback;
+        rendition->user_data = user_data;
+        auto rendition_policy = memory_policy_;
+        rendition_policy.pool = tractus::MemoryPool::kRenditions;
+        rendition->buffer.SetPolicy(rendition_policy);
+        renditions_.push_back(std::move(rendition));
+        return static_cast<int32_t>(renditions_.size() - 1);
+    }
+
+    /// <summary>
+    /// Sends frames to a layer compositor instead of the session callback. Fixed once the session starts.
+    /// </summary>
+    bool SetLayerTarget(tractus::LayerCompositor* compositor, int32_t layer)
+    {
+        if (started_ || config_.width <= 0 || config_.height <= 0)
+        {
+            return false;
+        }
+
+        layer_target_ = compositor;
+        layer_index_ = layer;
+        return true;
+    }
+
+    bool IsStarted() const
+    {
+        return started_;
+    }
+
+    const CompositorCaptureConfig& Config() const
+    {
+        return config_;
+    }
+
+    /// <summary>
+    /// Replaces the overlays drawn into every frame and resets the blend statistics.
+    /// </summary>
+    void SetOverlays(const CompositorOverlay* overlays, int32_t count)
+    {
+        std::vector<tractus::OverlaySpec> specs;
+        specs.reserve(static_cast<size_t>(count));
+        for (int32_t i = 0; i < count; ++i)
+        {
+            const auto& overlay = overlays[i];
+            tractus::OverlaySpec spec;
+            spec.kind = static_cast<tractus::OverlayKind>(overlay.kind);
+            spec.x = overlay.x;
+            spec.y = overlay.y;
+            spec.width = overlay.width;
+            spec.height = overlay.height;
+            spec.color = overlay.color;
+            spec.background = overlay.background;
+            spec.scale = overlay.scale;
+            spec.thickness = overlay.thickness;
+            specs.push_back(spec);
+        }
+
+        overlays_.SetOverlays(std::move(specs));
+        overlay_frames_.store(0);
+        overlay_last_pixels_.store(0);
+        overlay_last_nanoseconds_.store(0);
+        overlay_peak_nanoseconds_.store(0);
+        overlay_total_nanoseconds_.store(0);
+    }
+
+    CompositorOverlayStats GetOverlayStats() const
+    {
+        CompositorOverlayStats stats{};
+        stats.frames = overlay_frames_.load();
+        stats.last_pixels_blended = overlay_last_pixels_.load();
+        stats.last_blend_nanoseconds = overlay_last_nanoseconds_.load();
+        stats.peak_blend_nanoseconds = overlay_peak_nanoseconds_.load();
+        stats.total_blend_nanoseconds = overlay_total_nanoseconds_.load();
+        return stats;
+    }
+
+    /// <summary>
+    /// Returns the faults the fallback loop has injected; all zero when the session injects none.
+    /// </summary>
+    CompositorCaptureFaultStats GetFaultStats() const
+    {
+        CompositorCaptureFaultStats stats{};
+        if (faults_)
+        {
+            const auto injected = faults_->Stats();
+            stats.frames_delivered = injected.frames_delivered;
+            stats.frames_stalled = injected.frames_stalled;
+            stats.burst_frames = injected.burst_frames;
+            stats.preemptions = injected.preemptions;
+            stats.max_delay_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(injected.max_delay).count();
+        }
+
+        return stats;
+    }
+
     /// <summary>
     /// Releases compositor frame resources once managed consumers signal completion.
     /// </summary>
@@ -104,22 +358,43 @@ private:
 #endif
     }
 
-    void StartFallbackLoop()
+    bool StartFallbackLoop()
     {
         if (!callback_)
         {
-            return;
+            return true;
         }
 
         bool expected = false;
         if (!running_.compare_exchange_strong(expected, true))
         {
-            return;
+            return true;
+        }
+
+        try
+        {
+            const auto bufferSize = CalculateBufferSize();
+            staging_buffer_.assign(bufferSize, 0u);
+            PrepareSupersampling();
+            PrepareRateConversion();
+            PrepareRenditions();
+            interleaved_buffer_.assign(config_.scan_mode == CompositorScanMode::kInterleaved ? bufferSize : 0u, 0u);
+            straight_buffer_.assign(config_.alpha_mode == CompositorAlphaMode::kStraight && !layer_target_ ? bufferSize : 0u, 0u);
+        }
+        catch (const tractus::FrameBudgetExceeded&)
+        {
+            // Refuse the whole session rather than run with some pools missing; hand back what was allocated.
+            TrimPools();
+            running_.store(false);
+            return false;
         }
 
-        const auto bufferSize = CalculateBufferSize();
-        staging_buffer_.assign(bufferSize, 0u);
-        capture_thread_ = std::thread([this]() { RunFallbackLoop(); });
+        capture_thread_ = std::thread([this]()
+        {
+            const tractus::ScopedThreadPolicy policy(ToThreadPolicy(config_.thread_policy));
+            RunFallbackLoop();
+        });
+        return true;
     }
 
     void StopFallbackLoop()
@@ -133,6 +408,203 @@ private:
         {
             capture_thread_.join();
         }
+
+        TrimPools();
+    }
+
+    /// <summary>
+    /// Frees every frame pool of a stopped session so an idle session holds no budget. <c>StartFallbackLoop</c>
+    /// allocates them again.
+    /// </summary>
+    void TrimPools()
+    {
+        for (auto* buffer : {&staging_buffer_, &surface_buffer_, &interleaved_buffer_, &straight_buffer_})
+        {
+            buffer->Trim();
+        }
+
+        for (auto& source : source_frames_)
+        {
+            source.pixels.Trim();
+        }
+
+        for (auto& rendition : renditions_)
+        {
+            rendition->buffer.Trim();
+        }
+    }
+
+    /// <summary>
+    /// Allocates the enlarged capture surface when supersampling. Lanczos resolves reuse the streaming scaler;
+    /// box resolves need no state beyond the surface.
+    /// </summary>
+    void PrepareSupersampling()
+    {
+        const auto factor = config_.supersample_factor;
+        if (factor <= 1 || staging_buffer_.empty())
+        {
+            surface_buffer_.clear();
+            supersample_scaler_.reset();
+            return;
+        }
+
+        surface_buffer_.assign(staging_buffer_.size() * static_cast<size_t>(factor) * factor, 0u);
+        if (config_.supersample_filter == CompositorSupersampleFilter::kLanczos3)
+        {
+            supersample_scaler_ = std::make_unique<tractus::FrameScaler>(config_.width * factor, config_.height * factor, config_.width, config_.height, tractus::ScaleFilter::kLanczos3);
+        }
+    }
+
+    /// <summary>
+    /// Resolves the supersampled surface into the output staging buffer. The downsample is the copy into the
+    /// output buffer, so each surface pixel is read once and each output pixel written once.
+    /// </summary>
+    void ResolveSupersample(uint8_t* output, std::chrono::steady_clock::time_point due)
+    {
+        const auto factor = config_.supersample_factor;
+        const auto surface_stride = CalculateStride() * factor;
+        if (supersample_scaler_)
+        {
+            supersample_scaler_->Scale(surface_buffer_.data(), surface_stride, output, CalculateStride(), scheduler_.get(), due);
+            return;
+        }
+
+        const auto* surface = surface_buffer_.data();
+        const auto stride = CalculateStride();
+        const auto width = config_.width;
+        scheduler_->ParallelFor(static_cast<size_t>(config_.height), kRowsPerBand / static_cast<size_t>(factor), due, [&](size_t begin, size_t end)
+        {
+            tractus::DownsampleBox(surface, surface_stride, output, stride, width, static_cast<int32_t>(begin), static_cast<int32_t>(end), factor);
+        });
+    }
+
+    /// <summary>
+    /// Creates the rate converter when the source cadence differs from the output cadence. Matching rates
+    /// leave the converter unset so frames flow straight through.
+    /// </summary>
+    void PrepareRateConversion()
+    {
+        rate_converter_.reset();
+        if (config_.source_frame_rate_numerator <= 0 || config_.source_frame_rate_denominator <= 0 || staging_buffer_.empty())
+        {
+            return;
+        }
+
+        const auto mode = config_.rate_conversion == CompositorRateConversion::kBlend ? tractus::RateConversionMode::kBlend : tractus::RateConversionMode::kDropRepeat;
+        // Interleaved output converts to the field rate, which is twice the configured frame rate.
+        auto converter = std::make_unique<tractus::FrameRateConverter>(config_.source_frame_rate_numerator, config_.source_frame_rate_denominator,
+                                                                       config_.frame_rate_numerator * PicturesPerFrame(), config_.frame_rate_denominator, mode);
+        if (converter->IsIdentity())
+        {
+            return;
+        }
+
+        for (auto& source : source_frames_)
+        {
+            source.index = kNoSourceFrame;
+            source.pixels.assign(staging_buffer_.size(), 0u);
+        }
+
+        rate_converter_ = std::move(converter);
+    }
+
+    /// <summary>
+    /// Returns the pixels of the given source frame, producing it into the least recently needed slot when it is
+    /// not already held. <paramref name="keep"/> names a frame the caller still needs. The viz capturer lands
+    /// frames in these slots as they arrive; the stub renders them on demand.
+    /// </summary>
+    uint8_t* AcquireSourceFrame(uint64_t index, uint64_t keep, std::chrono::steady_clock::time_point due)
+    {
+        for (auto& source : source_frames_)
+        {
+            if (source.index == index)
+            {
+                return source.pixels.data();
+            }
+        }
+
+        // Evict an empty slot first, otherwise the older frame, but never the one the caller is still holding.
+        auto older = [](const SourceFrame& a, const SourceFrame& b) { return a.index == kNoSourceFrame || (b.index != kNoSourceFrame && a.index < b.index); };
+        auto* victim = older(source_frames_[0], source_frames_[1]) ? &source_frames_[0] : &source_frames_[1];
+        if (victim->index == keep)
+        {
+            victim = victim == &source_frames_[0] ? &source_frames_[1] : &source_frames_[0];
+        }
+
+        victim->index = index;
+        ProduceSourceFrame(index, victim->pixels.data(), due);
+        return victim->pixels.data();
+    }
+
+    int32_t PicturesPerFrame() const
+    {
+        return config_.scan_mode == CompositorScanMode::kInterleaved ? 2 : 1;
+    }
+
+    /// <summary>
+    /// Weaves one progressive picture into the even (<paramref name="parity"/> 0) or odd rows of the interleaved buffer.
+    /// </summary>
+    void WeaveField(const uint8_t* picture, int32_t parity, std::chrono::steady_clock::time_point due)
+    {
+        auto* output = interleaved_buffer_.data();
+        const auto stride = CalculateStride();
+        const auto width = config_.width;
+        const auto height = config_.height;
+        const auto filter = config_.field_flicker_filter != 0;
+        scheduler_->ParallelFor(static_cast<size_t>(tractus::FieldLineCount(height, parity)), kRowsPerBand, due, [&](size_t begin, size_t end)
+        {
+            tractus::WeaveField(picture, output, stride, width, height, parity, static_cast<int32_t>(begin), static_cast<int32_t>(end), filter);
+        });
+    }
+
+    /// <summary>
+    /// Produces the picture for the next output tick (a frame, or a field when interleaving), converting from the
+    /// source cadence when needed.
+    /// Drop/repeat hands out a cached source frame without copying; blends are written into the staging buffer.
+    /// </summary>
+    uint8_t* ProduceOutputFrame(uint64_t output_index, std::chrono::steady_clock::time_point due)
+    {
+        if (staging_buffer_.empty())
+        {
+            return nullptr;
+        }
+
+        if (!rate_converter_)
+        {
+            ProduceSourceFrame(output_index, staging_buffer_.data(), due);
+            return staging_buffer_.data();
+        }
+
+        const auto step = rate_converter_->Next();
+        auto* first = AcquireSourceFrame(step.source_index, kNoSourceFrame, due);
+        if (step.blend_weight == 0)
+        {
+            return first;
+        }
+
+        const auto* second = AcquireSourceFrame(step.source_index + 1, step.source_index, due);
+        auto* output = staging_buffer_.data();
+        const auto stride = CalculateStride();
+        const auto width = config_.width;
+        scheduler_->ParallelFor(static_cast<size_t>(config_.height), kRowsPerBand, due, [&](size_t begin, size_t end)
+        {
+            tractus::BlendFrames(first, second, output, stride, width, static_cast<int32_t>(begin), static_cast<int32_t>(end), step.blend_weight);
+        });
+
+        return output;
+    }
+
+    /// <summary>
+    /// Builds scaler coefficient tables and output buffers for every registered rendition.
+    /// </summary>
+    void PrepareRenditions()
+    {
+        for (auto& rendition : renditions_)
+        {
+            const auto filter = rendition->config.filter == CompositorScaleFilter::kBilinear ? tractus::ScaleFilter::kBilinear : tractus::ScaleFilter::kLanczos3;
+            rendition->scaler = std::make_unique<tractus::FrameScaler>(config_.width, config_.height, rendition->config.width, rendition->config.height, filter);
+            rendition->buffer.assign(static_cast<size_t>(rendition->config.width) * rendition->config.height * 4u, 0u);
+        }
     }
 
     size_t CalculateBufferSize() const
@@ -173,19 +645,98 @@ private:
         return std::chrono::microseconds(microseconds);
     }
 
+    /// <summary>
+    /// Renders source frame <paramref name="frame_index"/> and resolves it into <paramref name="output"/>.
+    /// </summary>
+    void ProduceSourceFrame(uint64_t frame_index, uint8_t* output, std::chrono::steady_clock::time_point due)
+    {
+        if (surface_buffer_.empty())
+        {
+            RenderTestPattern(frame_index, output, due);
+            return;
+        }
+
+        RenderTestPattern(frame_index, surface_buffer_.data(), due);
+        ResolveSupersample(output, due);
+    }
+
+    /// <summary>
+    /// Renders a moving test bar into the staging buffer. Row bands are fanned out on the shared scheduler's
+    /// deadline lane so several sessions converting at once are ordered by whichever frame is due first.
+    /// </summary>
+    void RenderTestPattern(uint64_t frame_index, uint8_t* pixels, std::chrono::steady_clock::time_point due)
+    {
+        if (!scheduler_)
+        {
+            return;
+        }
+
+        // When supersampling the pattern is drawn on the enlarged surface, just as the compositor would render it.
+        const auto factor = static_cast<size_t>(config_.supersample_factor);
+        const auto width = static_cast<size_t>(config_.width) * factor;
+        const auto stride = width * 4u;
+        const auto bar_width = std::max<size_t>(1, width / 16);
+        const auto bar_start = static_cast<size_t>(frame_index * 4u * factor % width);
+
+        scheduler_->ParallelFor(static_cast<size_t>(config_.height) * factor, kRowsPerBand, due, [&](size_t begin, size_t end)
+        {
+            for (size_t y = begin; y < end; ++y)
+            {
+                auto* row = reinterpret_cast<uint32_t*>(pixels + y * stride);
+                std::fill(row, row + width, 0xFF000000u);
+                for (size_t x = 0; x < bar_width; ++x)
+                {
+                    row[(bar_start + x) % width] = 0xFFFFFFFFu;
+                }
+            }
+        });
+    }
+
     void RunFallbackLoop()
     {
         const auto interval = CalculateFrameInterval(config_);
         const auto stride = CalculateStride();
-
-        while (running_.load())
+        tractus::RunCaptureLoop(clock_, interval, faults_.get(), running_, output_frame_index_, [&](const tractus::CaptureLoopFrame& captured)
         {
-            const auto monotonic = std::chrono::steady_clock::now();
+            const auto monotonic = captured.monotonic;
             const auto system = std::chrono::system_clock::now();
+            const auto work_started = std::chrono::steady_clock::now();
+
+            const auto frame_index = captured.frame_index;
+            uint8_t* pixels = nullptr;
+            uint8_t* progressive = nullptr;
+            if (interleaved_buffer_.empty())
+            {
+                pixels = ProduceOutputFrame(frame_index, monotonic + interval);
+                progressive = pixels;
+            }
+            else
+            {
+                // Each field is a full picture rendered at its own instant; only its rows survive the weave.
+                for (int32_t field = 0; field < 2; ++field)
+                {
+                    const auto field_due = monotonic + interval * (field + 1) / 2;
+                    progressive = ProduceOutputFrame(frame_index * 2u + static_cast<uint64_t>(field), field_due);
+                    if (progressive)
+                    {
+                        WeaveField(progressive, field, field_due);
+                    }
+                }
+
+                pixels = interleaved_buffer_.data();
+            }
+
+            pixels = ApplyOverlays(pixels, frame_index, system);
+            const auto* delivered = ConvertAlpha(pixels, monotonic + interval);
+
+            tractus::TelemetryCounters::Record(tractus::TelemetryHistogram::kFrameConversion,
+                                               std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - work_started).count());
 
             CompositorCapturedFrame frame{};
+            frame.struct_size = sizeof(CompositorCapturedFrame);
+            frame.abi_version = kCompositorAbiVersion;
             frame.frame_token = ++next_frame_token_;
-            frame.pixel_buffer = staging_buffer_.empty() ? nullptr : staging_buffer_.data();
+            frame.pixel_buffer = const_cast<uint8_t*>(delivered);
             frame.shared_handle = nullptr;
             frame.width = config_.width;
             frame.height = config_.height;
@@ -194,35 +745,359 @@ private:
             frame.timestamp_utc_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(system.time_since_epoch()).count();
             frame.storage_type = CompositorFrameStorageType::kSystemMemory;
 
-            if (callback_)
+            tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kFramesCaptured);
+            tractus::FlightRecorder::Record(tractus::FlightEvent::kFrameCaptured, tractus::FlightRecorder::kHelperTrack, 1);
+            if (layer_target_)
+            {
+                if (pixels)
+                {
+                    layer_target_->Submit(layer_index_, pixels, stride, frame.monotonic_timestamp);
+                    tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kLayerFramesSubmitted);
+                }
+            }
+            else if (callback_)
             {
                 callback_(&frame, user_data_);
+                tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kFramesDelivered);
             }
             else
             {
                 running_.store(false);
-                break;
+                return false;
             }
 
-            const auto next_fire = monotonic + interval;
-            std::this_thread::sleep_until(next_fire);
-        }
+            // Renditions are progressive, so interleaved sessions scale the second field's picture instead of the weave.
+            auto rendition_source = frame;
+            rendition_source.pixel_buffer = progressive;
+            DispatchRenditions(rendition_source, frame_index, monotonic + interval);
+            return true;
+        });
     }
 
-    CompositorCaptureConfig config_;
-    CompositorFrameCallback callback_;
-    void* user_data_;
-    std::unique_ptr<viz::FrameSinkVideoCapturer> capturer_;
-    bool started_{false};
-    std::atomic<bool> running_{false};
-    std::thread capture_thread_;
-    std::vector<uint8_t> staging_buffer_;
-    uint64_t next_frame_token_{0};
-};
-} // namespace
+    /// <summary>
+    /// Burns the configured overlays into the outgoing frame and records how long the blend took. Drop/repeat
+    /// output points into the rate converter's cache, so it is copied to the staging buffer first to keep a
+    /// repeated frame from collecting two timecodes.
+    /// </summary>
+    uint8_t* ApplyOverlays(uint8_t* pixels, uint64_t frame_index, std::chrono::system_clock::time_point system)
+    {
+        if (pixels == nullptr || !overlays_.HasOverlays())
+        {
+            return pixels;
+        }
 
-extern "C"
-{
+        if (pixels != staging_buffer_.data() && pixels != interleaved_buffer_.data())
+        {
+            tractus::CopyFrame(staging_buffer_.data(), pixels, staging_buffer_.size());
+            pixels = staging_buffer_.data();
+        }
+
+        tractus::OverlayFrameInfo info;
+        info.frame_index = frame_index;
+        info.frame_rate_numerator = config_.frame_rate_numerator;
+        info.frame_rate_denominator = config_.frame_rate_denominator;
+        info.timestamp_utc_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(system.time_since_epoch()).count();
+
+        const auto started = std::chrono::steady_clock::now();
+        const auto blended = overlays_.Apply(pixels, CalculateStride(), config_.width, config_.height, info);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+
+        overlay_frames_.fetch_add(1);
+        tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kOverlayFrames);
+        overlay_last_pixels_.store(blended);
+        overlay_last_nanoseconds_.store(elapsed);
+        overlay_total_nanoseconds_.fetch_add(elapsed);
+        auto peak = overlay_peak_nanoseconds_.load();
+        while (elapsed > peak && !overlay_peak_nanoseconds_.compare_exchange_weak(peak, elapsed))
+        {
+        }
+
+        return pixels;
+    }
+
+    /// <summary>
+    /// Converts the outgoing frame to straight alpha when configured. The result goes to a dedicated buffer so the
+    /// premultiplied frame stays intact for renditions and for repeats out of the rate converter's cache; opaque
+    /// frames are detected by the band pre-scan and delivered without a copy.
+    /// </summary>
+    const uint8_t* ConvertAlpha(const uint8_t* pixels, std::chrono::steady_clock::time_point due)
+    {
+        if (pixels == nullptr || straight_buffer_.empty())
+        {
+            return pixels;
+        }
+
+        bool opaque = false;
+        return tractus::UnpremultiplyFrame(pixels, straight_buffer_.data(), CalculateStride(), config_.width, config_.height, scheduler_.get(), due, opaque);
+    }
+
+    /// <summary>
+    /// Scales the captured frame into each rendition whose divider selects this frame and hands it to that
+    /// rendition's callback. Scaling runs on the shared scheduler so renditions across sessions share workers.
+    /// </summary>
+    void DispatchRenditions(const CompositorCapturedFrame& source, uint64_t frame_index, std::chrono::steady_clock::time_point due)
+    {
+        if (source.pixel_buffer == nullptr)
+        {
+            return;
+        }
+
+        for (auto& rendition : renditions_)
+        {
+            if (frame_index % static_cast<uint64_t>(rendition->config.frame_rate_divider) != 0 || !rendition->scaler)
+            {
+                continue;
+            }
+
+            const auto stride = rendition->config.width * 4;
+            const auto started = std::chrono::steady_clock::now();
+            rendition->scaler->Scale(static_cast<const uint8_t*>(source.pixel_buffer), source.stride, rendition->buffer.data(), stride, scheduler_.get(), due);
+            if (config_.alpha_mode == CompositorAlphaMode::kStraight)
+            {
+                // Scaling has to see premultiplied colour, so each rendition is converted after it is resampled.
+                bool opaque = false;
+                tractus::UnpremultiplyFrame(rendition->buffer.data(), rendition->buffer.data(), stride, rendition->config.width, rendition->config.height, scheduler_.get(), due, opaque);
+            }
+
+            tractus::TelemetryCounters::Record(tractus::TelemetryHistogram::kRenditionConversion,
+                                               std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count());
+
+            CompositorCapturedFrame frame = source;
+            frame.frame_token = ++next_frame_token_;
+            frame.pixel_buffer = rendition->buffer.data();
+            frame.width = rendition->config.width;
+            frame.height = rendition->config.height;
+            frame.stride = stride;
+            rendition->callback(&frame, rendition->user_data);
+            tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kRenditionFramesDelivered);
+        }
+    }
+
+    /// <summary>
+    /// Registered output rendition together with its scaler and output buffer.
+    /// </summary>
+    struct Rendition
+    {
+        CompositorRenditionConfig config{};
+        CompositorFrameCallback callback{nullptr};
+        void* user_data{nullptr};
+        std::unique_ptr<tractus::FrameScaler> scaler;
+        tractus::FrameBuffer buffer;
+    };
+
+    /// <summary>
+    /// A source frame held for rate conversion; drop/repeat and blending need at most two at a time.
+    /// </summary>
+    struct SourceFrame
+    {
+        uint64_t index{kNoSourceFrame};
+        tractus::FrameBuffer pixels;
+    };
+
+    CompositorCaptureConfig config_;
+    CompositorFrameCallback callback_;
+    void* user_data_;
+    tractus::PacingClock& clock_;
+    std::unique_ptr<tractus::CaptureFaultInjector> faults_;
+    std::unique_ptr<viz::FrameSinkVideoCapturer> capturer_;
+    bool started_{false};
+    std::atomic<bool> running_{false};
+    std::thread capture_thread_;
+    tractus::FrameMemoryPolicy memory_policy_;
+    tractus::FrameBuffer staging_buffer_;
+    tractus::FrameBuffer surface_buffer_;
+    tractus::FrameBuffer interleaved_buffer_;
+    tractus::FrameBuffer straight_buffer_;
+    std::unique_ptr<tractus::FrameScaler> supersample_scaler_;
+    uint64_t next_frame_token_{0};
+    uint64_t output_frame_index_{0};
+    std::unique_ptr<tractus::FrameRateConverter> rate_converter_;
+    std::array<SourceFrame, kSourceFramePoolDepth> source_frames_;
+    std::vector<std::unique_ptr<Rendition>> renditions_;
+    std::shared_ptr<tractus::FrameTaskScheduler> scheduler_;
+    tractus::OverlayCompositor overlays_;
+    tractus::LayerCompositor* layer_target_{nullptr};
+    int32_t layer_index_{-1};
+    std::atomic<uint64_t> overlay_frames_{0};
+    std::atomic<uint64_t> overlay_last_pixels_{0};
+    std::atomic<int64_t> overlay_last_nanoseconds_{0};
+    std::atomic<int64_t> overlay_peak_nanoseconds_{0};
+    std::atomic<int64_t> overlay_total_nanoseconds_{0};
+
+    static constexpr size_t kRowsPerBand = 64;
+    static constexpr uint64_t kNoSourceFrame = UINT64_MAX;
+};
+/// <summary>
+/// Owns a <c>LayerCompositor</c> and the thread that composes it at the output cadence.
+/// </summary>
+class LayerCompositorImpl
+{
+public:
+    LayerCompositorImpl(const CompositorLayerCompositorConfig& config, CompositorFrameCallback callback, void* user_data,
+                        tractus::PacingClock& clock = tractus::PacingClock::System())
+        : config_(config),
+          callback_(callback),
+          user_data_(user_data),
+          clock_(clock),
+          memory_policy_(ToMemoryPolicy(config.memory_flags, config.thread_policy, tractus::MemoryPool::kLayers)),
+          compositor_(config.width, config.height, memory_policy_),
+          scheduler_(tractus::FrameTaskScheduler::AcquireShared()),
+          output_(memory_policy_),
+          straight_(memory_policy_)
+    {
+        output_.assign(static_cast<size_t>(std::max(0, config.width)) * static_cast<size_t>(std::max(0, config.height)) * 4u, 0u);
+        straight_.assign(config.alpha_mode == CompositorAlphaMode::kStraight ? output_.size() : 0u, 0u);
+    }
+
+    ~LayerCompositorImpl()
+    {
+        Stop();
+    }
+
+    int32_t AttachLayer(CompositorCaptureSessionImpl& session, int32_t z_order, int32_t delay_frames)
+    {
+        const auto& session_config = session.Config();
+        if (running_.load() || session.IsStarted() || session_config.width != config_.width || session_config.height != config_.height)
+        {
+            return -1;
+        }
+
+        int32_t layer = -1;
+        try
+        {
+            layer = compositor_.AddLayer(z_order, delay_frames);
+        }
+        catch (const tractus::FrameBudgetExceeded&)
+        {
+            return -1;
+        }
+
+        if (layer >= 0)
+        {
+            session.SetLayerTarget(&compositor_, layer);
+        }
+
+        return layer;
+    }
+
+    void Start()
+    {
+        bool expected = false;
+        if (output_.empty() || !running_.compare_exchange_strong(expected, true))
+        {
+            return;
+        }
+
+        thread_ = std::thread([this]()
+        {
+            const tractus::ScopedThreadPolicy policy(ToThreadPolicy(config_.thread_policy));
+            Run();
+        });
+    }
+
+    void Stop()
+    {
+        if (!running_.exchange(false))
+        {
+            return;
+        }
+
+        if (thread_.joinable())
+        {
+            thread_.join();
+        }
+    }
+
+    CompositorLayerStats GetLayerStats(int32_t layer) const
+    {
+        const auto statistics = compositor_.GetLayerStatistics(layer);
+        CompositorLayerStats stats{};
+        stats.z_order = statistics.z_order;
+        stats.delay_frames = statistics.delay_frames;
+        stats.frames_submitted = statistics.frames_submitted;
+        stats.frames_dropped = statistics.frames_dropped;
+        stats.last_age_microseconds = statistics.last_age_microseconds;
+        stats.mean_age_microseconds = statistics.mean_age_microseconds;
+        return stats;
+    }
+
+    CompositorLayerCompositorStats GetStats() const
+    {
+        const auto statistics = compositor_.GetStatistics();
+        CompositorLayerCompositorStats stats{};
+        stats.frames = statistics.frames;
+        stats.tiles_composed = statistics.tiles_composed;
+        stats.tiles_skipped = statistics.tiles_skipped;
+        stats.last_compose_nanoseconds = statistics.last_compose_nanoseconds;
+        stats.peak_compose_nanoseconds = statistics.peak_compose_nanoseconds;
+        return stats;
+    }
+
+    int32_t LayerCount() const
+    {
+        return compositor_.LayerCount();
+    }
+
+private:
+    void Run()
+    {
+        const auto rate_numerator = config_.frame_rate_numerator > 0 ? config_.frame_rate_numerator : 60;
+        const auto rate_denominator = config_.frame_rate_denominator > 0 ? config_.frame_rate_denominator : 1;
+        const auto interval = std::chrono::microseconds(static_cast<int64_t>(1'000'000.0 * rate_denominator / rate_numerator));
+        const auto stride = config_.width * 4;
+        tractus::FrameCadence cadence(clock_, interval);
+
+        while (running_.load())
+        {
+            const auto monotonic = clock_.Now();
+            const auto system = std::chrono::system_clock::now();
+            const auto monotonic_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(monotonic.time_since_epoch()).count();
+            compositor_.Compose(output_.data(), stride, monotonic_microseconds, scheduler_.get(), monotonic + interval);
+
+            // Unchanged tiles are left as they are in output_, so straight alpha is written to a separate buffer.
+            const uint8_t* delivered = output_.data();
+            if (!straight_.empty())
+            {
+                bool opaque = false;
+                delivered = tractus::UnpremultiplyFrame(output_.data(), straight_.data(), stride, config_.width, config_.height, scheduler_.get(), monotonic + interval, opaque);
+            }
+
+            CompositorCapturedFrame frame{};
+            frame.struct_size = sizeof(CompositorCapturedFrame);
+            frame.abi_version = kCompositorAbiVersion;
+            frame.frame_token = ++next_frame_token_;
+            frame.pixel_buffer = const_cast<uint8_t*>(delivered);
+            frame.shared_handle = nullptr;
+            frame.width = config_.width;
+            frame.height = config_.height;
+            frame.stride = stride;
+            frame.monotonic_timestamp = monotonic_microseconds;
+            frame.timestamp_utc_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(system.time_since_epoch()).count();
+            frame.storage_type = CompositorFrameStorageType::kSystemMemory;
+            tractus::FlightRecorder::Record(tractus::FlightEvent::kFrameCaptured, tractus::FlightRecorder::kHelperTrack, 1);
+            callback_(&frame, user_data_);
+            tractus::TelemetryCounters::Add(tractus::TelemetryCounter::kCompositesDelivered);
+            cadence.WaitForNextFrame(monotonic);
+        }
+    }
+
+    CompositorLayerCompositorConfig config_;
+    CompositorFrameCallback callback_;
+    void* user_data_;
+    tractus::PacingClock& clock_;
+    tractus::FrameMemoryPolicy memory_policy_;
+    tractus::LayerCompositor compositor_;
+    std::shared_ptr<tractus::FrameTaskScheduler> scheduler_;
+    tractus::FrameBuffer output_;
+    tractus::FrameBuffer straight_;
+    std::atomic<bool> running_{false};
+    std::thread thread_;
+    uint64_t next_frame_token_{0};
+};
+} // namespace
+
+extern "C"
+{
 struct CompositorCaptureSession
 {
     explicit CompositorCaptureSession(CompositorCaptureSessionImpl* impl)
@@ -238,25 +1113,282 @@ struct CompositorCaptureSession
     CompositorCaptureSessionImpl* impl_;
 };
 
+int32_t cc_query_capabilities(CompositorCapabilities* capabilities)
+{
+    if (capabilities == nullptr || capabilities->struct_size < offsetof(CompositorCapabilities, pixel_formats))
+    {
+        return -1;
+    }
+
+    auto feature = [](CompositorFeature value) { return static_cast<uint32_t>(value); };
+
+    CompositorCapabilities result{};
+    result.struct_size = sizeof(CompositorCapabilities);
+    result.abi_version = kCompositorAbiVersion;
+    result.pixel_formats = static_cast<uint32_t>(CompositorPixelFormat::kBgra8);
+    result.features = feature(CompositorFeature::kRenditions) | feature(CompositorFeature::kSupersampling) |
+                      feature(CompositorFeature::kRateConversion) | feature(CompositorFeature::kFrameBlending) |
+                      feature(CompositorFeature::kInterlacing) | feature(CompositorFeature::kOverlays) |
+                      feature(CompositorFeature::kLayers) | feature(CompositorFeature::kStraightAlpha) |
+                      feature(CompositorFeature::kThreadPolicy) | feature(CompositorFeature::kMemoryFlags) |
+                      feature(CompositorFeature::kMemoryBudget) | feature(CompositorFeature::kCounters) |
+                      feature(CompositorFeature::kFlightRecorder);
+#if TRACTUS_HAS_VIZ_CAPTURER
+    result.features |= feature(CompositorFeature::kVizCapture);
+#else
+    // Faults are injected by the fallback loop, which only runs without the viz capturer.
+    result.features |= feature(CompositorFeature::kCaptureFaults);
+#endif
+    result.compiled_simd_level = static_cast<CompositorSimdLevel>(tractus::CompiledSimdLevel());
+    result.cpu_simd_level = static_cast<CompositorSimdLevel>(tractus::DetectSimdLevel());
+    result.max_supersample_factor = 4;
+    result.max_layers = tractus::LayerCompositor::kMaxLayers;
+    result.scheduler_workers = static_cast<int32_t>(std::max(1u, std::thread::hardware_concurrency()));
+    result.source_frame_pool_depth = static_cast<int32_t>(CompositorCaptureSessionImpl::kSourceFramePoolDepth);
+    result.clock_resolution_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::duration(1)).count();
+    static const auto sleep_resolution = MeasureSleepResolution();
+    result.sleep_resolution_nanoseconds = sleep_resolution;
+    result.large_page_bytes = static_cast<int64_t>(tractus::LargePageSize());
+    result.numa_node_count = tractus::NumaNodeCount();
+
+    // Only as much as the caller's struct holds; it keeps its own struct_size so it can tell what was filled.
+    const auto caller_size = capabilities->struct_size;
+    std::memcpy(capabilities, &result, std::min<size_t>(caller_size, sizeof(CompositorCapabilities)));
+    capabilities->struct_size = caller_size;
+    return 0;
+}
+
+void cc_copy_frame(void* destination, const void* source, size_t bytes)
+{
+    if (destination == nullptr || source == nullptr)
+    {
+        return;
+    }
+
+    tractus::CopyFrame(static_cast<uint8_t*>(destination), static_cast<const uint8_t*>(source), bytes);
+}
+
+int32_t cc_hash_frame(const void* pixels, int32_t row_bytes, int32_t height, int32_t stride, CompositorContentHash* hash)
+{
+    if (hash == nullptr || (height > 1 && stride < row_bytes))
+    {
+        return -1;
+    }
+
+    const auto digest = tractus::HashFrame(static_cast<const uint8_t*>(pixels), row_bytes, height, stride);
+    hash->low = digest.low;
+    hash->high = digest.high;
+    return 0;
+}
+
+int32_t cc_set_frame_memory_budget(int64_t bytes)
+{
+    if (bytes < 0)
+    {
+        return -1;
+    }
+
+    tractus::MemoryGovernor::Instance().SetBudget(static_cast<uint64_t>(bytes));
+    return 0;
+}
+
+int32_t cc_get_memory_stats(CompositorMemoryStats* stats)
+{
+    if (stats == nullptr || stats->struct_size < offsetof(CompositorMemoryStats, budget_bytes))
+    {
+        return -1;
+    }
+
+    const auto governor = tractus::MemoryGovernor::Instance().GetStatistics();
+    CompositorMemoryStats result{};
+    result.struct_size = sizeof(CompositorMemoryStats);
+    result.abi_version = kCompositorAbiVersion;
+    result.budget_bytes = governor.budget_bytes;
+    result.in_use_bytes = governor.in_use_bytes;
+    result.high_water_bytes = governor.high_water_bytes;
+    result.refusals = governor.refusals;
+    result.trimmed_bytes = governor.trimmed_bytes;
+    for (int32_t i = 0; i < kCompositorMemoryPoolCount; ++i)
+    {
+        result.pools[i].in_use_bytes = governor.pools[i].in_use_bytes;
+        result.pools[i].high_water_bytes = governor.pools[i].high_water_bytes;
+        result.pools[i].refusals = governor.pools[i].refusals;
+    }
+
+    const auto caller_size = stats->struct_size;
+    std::memcpy(stats, &result, std::min<size_t>(caller_size, sizeof(CompositorMemoryStats)));
+    stats->struct_size = caller_size;
+    return 0;
+}
+
+int32_t cc_reserve_frame_memory(CompositorMemoryPool pool, int64_t bytes, int32_t required)
+{
+    const auto index = static_cast<int32_t>(pool);
+    if (index < 0 || index >= kCompositorMemoryPoolCount || bytes < 0)
+    {
+        return -1;
+    }
+
+    auto& governor = tractus::MemoryGovernor::Instance();
+    if (required != 0)
+    {
+        governor.Reserve(static_cast<tractus::MemoryPool>(index), static_cast<uint64_t>(bytes));
+        return 0;
+    }
+
+    return governor.TryReserve(static_cast<tractus::MemoryPool>(index), static_cast<uint64_t>(bytes)) ? 0 : -2;
+}
+
+void cc_release_frame_memory(CompositorMemoryPool pool, int64_t bytes)
+{
+    const auto index = static_cast<int32_t>(pool);
+    if (index < 0 || index >= kCompositorMemoryPoolCount || bytes <= 0)
+    {
+        return;
+    }
+
+    tractus::MemoryGovernor::Instance().Release(static_cast<tractus::MemoryPool>(index), static_cast<uint64_t>(bytes));
+}
+
+static_assert(kCompositorHistogramBucketCount == static_cast<int32_t>(tractus::kTelemetryHistogramBuckets), "exported histograms must match the internal buckets");
+static_assert(kCompositorHistogramFirstBoundNanoseconds == static_cast<int64_t>(tractus::kTelemetryHistogramFirstBound), "exported histogram bounds must match the internal buckets");
+
+int32_t cc_get_counters(CompositorCounters* counters)
+{
+    if (counters == nullptr || counters->struct_size < offsetof(CompositorCounters, frames_captured))
+    {
+        return -1;
+    }
+
+    using tractus::TelemetryCounter;
+    using tractus::TelemetryHistogram;
+    const auto snapshot = tractus::TelemetryCounters::Snapshot();
+    auto count = [&snapshot](TelemetryCounter counter) { return snapshot[counter]; };
+    auto histogram = [&snapshot](TelemetryHistogram id, CompositorHistogram& target)
+    {
+        const auto& source = snapshot[id];
+        target.count = source.count;
+        target.sum_nanoseconds = source.sum_nanoseconds;
+        std::copy(source.buckets.begin(), source.buckets.end(), target.buckets);
+    };
+
+    CompositorCounters result{};
+    result.struct_size = sizeof(CompositorCounters);
+    result.abi_version = kCompositorAbiVersion;
+    result.frames_captured = count(TelemetryCounter::kFramesCaptured);
+    result.frames_delivered = count(TelemetryCounter::kFramesDelivered);
+    result.layer_frames_submitted = count(TelemetryCounter::kLayerFramesSubmitted);
+    result.rendition_frames_delivered = count(TelemetryCounter::kRenditionFramesDelivered);
+    result.overlay_frames = count(TelemetryCounter::kOverlayFrames);
+    result.composites_delivered = count(TelemetryCounter::kCompositesDelivered);
+    result.tiles_composed = count(TelemetryCounter::kTilesComposed);
+    result.tiles_skipped = count(TelemetryCounter::kTilesSkipped);
+    histogram(TelemetryHistogram::kFrameConversion, result.frame_conversion);
+    histogram(TelemetryHistogram::kRenditionConversion, result.rendition_conversion);
+    histogram(TelemetryHistogram::kComposite, result.composite);
+
+    const auto caller_size = counters->struct_size;
+    std::memcpy(counters, &result, std::min<size_t>(caller_size, sizeof(CompositorCounters)));
+    counters->struct_size = caller_size;
+    return 0;
+}
+
+static_assert(static_cast<int32_t>(CompositorFlightEvent::kTicketExpired) + 1 == static_cast<int32_t>(tractus::kFlightEventCount), "exported flight events must match the recorder's");
+
+int32_t cc_flight_register_track(const char* name)
+{
+    if (name == nullptr)
+    {
+        return -1;
+    }
+
+    return tractus::FlightRecorder::RegisterTrack(name);
+}
+
+void cc_flight_record(int32_t track, CompositorFlightEvent event, int64_t value)
+{
+    const auto index = static_cast<int32_t>(event);
+    if (track < 0 || track >= static_cast<int32_t>(tractus::FlightRecorder::kMaxTracks) || index < 0 || index >= static_cast<int32_t>(tractus::kFlightEventCount))
+    {
+        return;
+    }
+
+    tractus::FlightRecorder::Record(static_cast<tractus::FlightEvent>(index), static_cast<uint16_t>(track), value);
+}
+
+int32_t cc_flight_dump(const char* path)
+{
+    if (path == nullptr)
+    {
+        return -1;
+    }
+
+    return tractus::FlightRecorder::DumpChromeTrace(path) ? 0 : -2;
+}
+
 CompositorCaptureSession* cc_create_session(CefBrowserHost* host, const CompositorCaptureConfig* config, CompositorFrameCallback callback, void* user_data)
 {
-    if (config == nullptr || callback == nullptr)
+    CompositorCaptureConfig versioned{};
+    if (config == nullptr || callback == nullptr || !ReadVersionedStruct(*config, versioned, offsetof(CompositorCaptureConfig, supersample_factor)))
     {
         return nullptr;
     }
 
-    auto impl = new CompositorCaptureSessionImpl(host, *config, callback, user_data);
+    auto impl = new CompositorCaptureSessionImpl(host, versioned, callback, user_data);
     return new CompositorCaptureSession(impl);
 }
 
-void cc_start_session(CompositorCaptureSession* session)
+int32_t cc_add_rendition(CompositorCaptureSession* session, const CompositorRenditionConfig* config, CompositorFrameCallback callback, void* user_data)
+{
+    if (session == nullptr || session->impl_ == nullptr || config == nullptr)
+    {
+        return -1;
+    }
+
+    return session->impl_->AddRendition(*config, callback, user_data);
+}
+
+int32_t cc_set_overlays(CompositorCaptureSession* session, const CompositorOverlay* overlays, int32_t count)
+{
+    if (session == nullptr || session->impl_ == nullptr || count < 0 || (count > 0 && overlays == nullptr))
+    {
+        return -1;
+    }
+
+    session->impl_->SetOverlays(overlays, count);
+    return 0;
+}
+
+int32_t cc_get_overlay_stats(CompositorCaptureSession* session, CompositorOverlayStats* stats)
+{
+    if (session == nullptr || session->impl_ == nullptr || stats == nullptr)
+    {
+        return -1;
+    }
+
+    *stats = session->impl_->GetOverlayStats();
+    return 0;
+}
+
+int32_t cc_get_capture_fault_stats(CompositorCaptureSession* session, CompositorCaptureFaultStats* stats)
+{
+    if (session == nullptr || session->impl_ == nullptr || stats == nullptr)
+    {
+        return -1;
+    }
+
+    *stats = session->impl_->GetFaultStats();
+    return 0;
+}
+
+int32_t cc_start_session(CompositorCaptureSession* session)
 {
     if (session == nullptr || session->impl_ == nullptr)
     {
-        return;
+        return -1;
     }
 
-    session->impl_->Start();
+    return session->impl_->Start() ? 0 : -2;
 }
 
 void cc_stop_session(CompositorCaptureSession* session)
@@ -283,4 +1415,95 @@ void cc_destroy_session(CompositorCaptureSession* session)
 {
     delete session;
 }
+
+struct CompositorLayerCompositor
+{
+    explicit CompositorLayerCompositor(LayerCompositorImpl* impl)
+        : impl_(impl)
+    {
+    }
+
+    ~CompositorLayerCompositor()
+    {
+        delete impl_;
+    }
+
+    LayerCompositorImpl* impl_;
+};
+
+CompositorLayerCompositor* cc_create_layer_compositor(const CompositorLayerCompositorConfig* config, CompositorFrameCallback callback, void* user_data)
+{
+    CompositorLayerCompositorConfig versioned{};
+    if (config == nullptr || callback == nullptr || !ReadVersionedStruct(*config, versioned, offsetof(CompositorLayerCompositorConfig, alpha_mode)) ||
+        versioned.width <= 0 || versioned.height <= 0)
+    {
+        return nullptr;
+    }
+
+    try
+    {
+        return new CompositorLayerCompositor(new LayerCompositorImpl(versioned, callback, user_data));
+    }
+    catch (const tractus::FrameBudgetExceeded&)
+    {
+        return nullptr;
+    }
+}
+
+int32_t cc_attach_layer(CompositorLayerCompositor* compositor, CompositorCaptureSession* session, int32_t z_order, int32_t delay_frames)
+{
+    if (compositor == nullptr || compositor->impl_ == nullptr || session == nullptr || session->impl_ == nullptr || delay_frames < 0)
+    {
+        return -1;
+    }
+
+    return compositor->impl_->AttachLayer(*session->impl_, z_order, delay_frames);
+}
+
+void cc_start_layer_compositor(CompositorLayerCompositor* compositor)
+{
+    if (compositor == nullptr || compositor->impl_ == nullptr)
+    {
+        return;
+    }
+
+    compositor->impl_->Start();
+}
+
+void cc_stop_layer_compositor(CompositorLayerCompositor* compositor)
+{
+    if (compositor == nullptr || compositor->impl_ == nullptr)
+    {
+        return;
+    }
+
+    compositor->impl_->Stop();
+}
+
+int32_t cc_get_layer_stats(CompositorLayerCompositor* compositor, int32_t layer, CompositorLayerStats* stats)
+{
+    if (compositor == nullptr || compositor->impl_ == nullptr || stats == nullptr || layer < 0 || layer >= compositor->impl_->LayerCount())
+    {
+        return -1;
+    }
+
+    *stats = compositor->impl_->GetLayerStats(layer);
+    return 0;
+}
+
+int32_t cc_get_layer_compositor_stats(CompositorLayerCompositor* compositor, CompositorLayerCompositorStats* stats)
+{
+    if (compositor == nullptr || compositor->impl_ == nullptr || stats == nullptr)
+    {
+        return -1;
+    }
+
+    *stats = compositor->impl_->GetStats();
+    return 0;
+}
+
+void cc_destroy_layer_compositor(CompositorLayerCompositor* compositor)
+{
+    delete compositor;
+}
 }
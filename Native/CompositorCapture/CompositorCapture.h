@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 class CefBrowserHost;
@@ -8,15 +9,185 @@ namespace viz
 class FrameSinkVideoCapturer;
 }
 
+/// <summary>
+/// Version of this header's C ABI. Versioned structs start with <c>struct_size</c> and <c>abi_version</c>; new
+/// fields are only ever appended, so a caller built against an older header passes a smaller <c>struct_size</c> and
+/// the helper zero-fills the fields it did not supply. Zero is reserved for callers that predate versioning.
+/// </summary>
+constexpr uint32_t kCompositorAbiVersion = 1;
+
+/// <summary>
+/// Filter used to resolve a supersampled capture surface down to the output size.
+/// </summary>
+enum class CompositorSupersampleFilter : int32_t
+{
+    /// <summary>Averages factor x factor blocks; exact for 2:1 and 4:1 and cheapest.</summary>
+    kBox = 0,
+    /// <summary>Routes the surface through the Lanczos3 scaler for slightly crisper edges.</summary>
+    kLanczos3 = 1,
+};
+
+/// <summary>
+/// Strategy used when the page renders at a different rate from the output.
+/// </summary>
+enum class CompositorRateConversion : int32_t
+{
+    /// <summary>Shows the source frame nearest each output instant, repeating or dropping frames.</summary>
+    kDropRepeat = 0,
+    /// <summary>Blends the two source frames either side of each output instant by phase.</summary>
+    kBlend = 1,
+};
+
+/// <summary>
+/// Scan format of the frames delivered to the session callback.
+/// </summary>
+enum class CompositorScanMode : int32_t
+{
+    /// <summary>Each callback frame is one progressive picture.</summary>
+    kProgressive = 0,
+    /// <summary>
+    /// The session renders at twice the configured frame rate and weaves consecutive pictures into one frame,
+    /// the first field on even rows and the second on odd rows.
+    /// </summary>
+    kInterleaved = 1,
+};
+
+/// <summary>
+/// Alpha representation of the frames delivered to callbacks. Chromium composes premultiplied BGRA.
+/// </summary>
+enum class CompositorAlphaMode : int32_t
+{
+    /// <summary>Frames are delivered as composed, with colour already multiplied by alpha.</summary>
+    kPremultiplied = 0,
+    /// <summary>Colour is divided back out by alpha before delivery. Fully opaque frames are passed through.</summary>
+    kStraight = 1,
+};
+
+/// <summary>
+/// Scheduling class of the helper's capture and composition threads.
+/// </summary>
+enum class CompositorThreadPriority : int32_t
+{
+    kNormal = 0,
+    /// <summary><c>THREAD_PRIORITY_HIGHEST</c> on Windows, nice -10 on Linux.</summary>
+    kHigh = 1,
+    /// <summary>MMCSS "Pro Audio" on Windows, <c>SCHED_FIFO</c> on Linux; falls back to <c>kHigh</c> when refused.</summary>
+    kRealtime = 2,
+};
+
+/// <summary>
+/// Priority, CPU pinning and timer slack for a thread the helper owns. All zero leaves the thread as created, which
+/// is also what callers that predate the field get.
+/// </summary>
+struct CompositorThreadPolicy
+{
+    CompositorThreadPriority priority;
+    int32_t reserved;
+    /// <summary>CPUs the thread may run on, bit n for CPU n; zero keeps the inherited affinity.</summary>
+    uint64_t affinity_mask;
+    /// <summary>
+    /// Linux <c>PR_SET_TIMERSLACK</c> in nanoseconds; zero keeps the default. On Windows any positive value opts the
+    /// thread out of EcoQoS power throttling instead.
+    /// </summary>
+    int64_t timer_slack_nanoseconds;
+};
+
+/// <summary>
+/// Allocation preferences for the frame pools of a session or layer compositor. Zero allocates ordinary pages.
+/// </summary>
+enum class CompositorMemoryFlags : uint32_t
+{
+    kNone = 0,
+    /// <summary>Back pools with 2 MB pages: reserved huge pages first, transparent huge pages or ordinary pages otherwise.</summary>
+    kLargePages = 1u << 0,
+    /// <summary>Bind pools to the NUMA node of the first CPU in <c>thread_policy.affinity_mask</c>; ignored without a mask.</summary>
+    kNumaLocal = 1u << 1,
+};
+
+/// <summary>
+/// Disturbances the fallback capture loop adds to its cadence, so the managed pacer's recovery paths can be driven
+/// without a misbehaving page. All zero adds none; sessions fed by Chromium's viz capturer ignore it.
+/// </summary>
+struct CompositorCaptureFaults
+{
+    /// <summary>Seeds every random choice; the same seed replays the same faults.</summary>
+    uint64_t seed;
+    /// <summary>Standard deviation of how late each frame is delivered after it is due.</summary>
+    int64_t jitter_microseconds;
+    /// <summary>Every this many frames a burst begins; zero disables bursts.</summary>
+    int32_t burst_period_frames;
+    /// <summary>Frames held back at the start of each burst period and delivered back to back.</summary>
+    int32_t burst_length_frames;
+    /// <summary>Chance, per frame, that the page renders nothing for between the minimum and maximum stall.</summary>
+    double stall_probability;
+    int64_t min_stall_microseconds;
+    int64_t max_stall_microseconds;
+    /// <summary>How far the source clock runs ahead of the output rate, in parts per million; negative runs slow.</summary>
+    double drift_ppm;
+    /// <summary>Chance, per frame, that the capture thread is kept off the CPU after the callback returns.</summary>
+    double preemption_probability;
+    int64_t preemption_microseconds;
+};
+
+/// <summary>
+/// Faults a session has injected since it was created, filled by <c>cc_get_capture_fault_stats</c>.
+/// </summary>
+struct CompositorCaptureFaultStats
+{
+    uint64_t frames_delivered;
+    /// <summary>Frames the page did not render because they fell in a stall.</summary>
+    uint64_t frames_stalled;
+    uint64_t burst_frames;
+    uint64_t preemptions;
+    /// <summary>Longest a frame was delivered after it was due.</summary>
+    int64_t max_delay_microseconds;
+};
+
 /// <summary>
 /// Configuration supplied when creating a compositor capture session.
 /// </summary>
 struct CompositorCaptureConfig
 {
+    /// <summary>Set by the caller to <c>sizeof(CompositorCaptureConfig)</c> as it was compiled.</summary>
+    uint32_t struct_size;
+    /// <summary>Set by the caller to the <c>kCompositorAbiVersion</c> it was compiled against.</summary>
+    uint32_t abi_version;
+    /// <summary>Output width delivered to callbacks.</summary>
     int32_t width;
+    /// <summary>Output height delivered to callbacks.</summary>
     int32_t height;
     int32_t frame_rate_numerator;
     int32_t frame_rate_denominator;
+    /// <summary>
+    /// Capture surface scale relative to the output (1, 2 or 4). The compositor renders at width x factor and the
+    /// helper downsamples while copying into the output buffer. Other values fall back to 1.
+    /// </summary>
+    int32_t supersample_factor;
+    CompositorSupersampleFilter supersample_filter;
+    /// <summary>
+    /// Rate at which the compositor produces frames. Zero means the source runs at the output rate; any other
+    /// rate is converted to <c>frame_rate_numerator / frame_rate_denominator</c> using exact rational phase.
+    /// </summary>
+    int32_t source_frame_rate_numerator;
+    int32_t source_frame_rate_denominator;
+    CompositorRateConversion rate_conversion;
+    /// <summary>
+    /// Scan format of delivered frames. For interleaved output <c>frame_rate_numerator / frame_rate_denominator</c>
+    /// is the frame rate (25 for 1080i50) and pictures are captured at twice that rate.
+    /// </summary>
+    CompositorScanMode scan_mode;
+    /// <summary>Non-zero applies a 1-2-1 vertical flicker filter while weaving fields.</summary>
+    int32_t field_flicker_filter;
+    /// <summary>
+    /// Alpha representation of delivered frames and renditions. Sessions attached to a layer compositor always
+    /// submit premultiplied frames; the compositor's own configuration decides its output.
+    /// </summary>
+    CompositorAlphaMode alpha_mode;
+    /// <summary>Applied to the capture thread, which also runs rate conversion, overlays and the frame callback.</summary>
+    CompositorThreadPolicy thread_policy;
+    /// <summary>Combination of <c>CompositorMemoryFlags</c> for the staging, surface, rate-conversion and rendition pools.</summary>
+    uint32_t memory_flags;
+    CompositorCaptureFaults faults;
 };
 
 /// <summary>
@@ -34,17 +205,347 @@ enum class CompositorFrameStorageType : uint32_t
 /// </summary>
 struct CompositorCapturedFrame
 {
+    /// <summary>Set by the helper to its <c>sizeof(CompositorCapturedFrame)</c>; callers read only the fields they know.</summary>
+    uint32_t struct_size;
+    /// <summary>Set by the helper to its <c>kCompositorAbiVersion</c>.</summary>
+    uint32_t abi_version;
     uint64_t frame_token;
     void* pixel_buffer;
     void* shared_handle;
     int32_t width;
     int32_t height;
     int32_t stride;
+    /// <summary><c>steady_clock</c> microseconds; the managed bridge converts them to <c>Stopwatch</c> ticks.</summary>
     int64_t monotonic_timestamp;
     int64_t timestamp_utc_microseconds;
     CompositorFrameStorageType storage_type;
 };
 
+/// <summary>
+/// Resampling filter used when deriving an additional output rendition from the captured frame.
+/// </summary>
+enum class CompositorScaleFilter : int32_t
+{
+    kBilinear = 0,
+    kLanczos3 = 1,
+};
+
+/// <summary>
+/// Describes an additional output rendition scaled from every captured frame (for example a 540p proxy).
+/// </summary>
+struct CompositorRenditionConfig
+{
+    int32_t width;
+    int32_t height;
+    /// <summary>Publishes every Nth captured frame; 2 turns a 60 fps capture into a 30 fps rendition.</summary>
+    int32_t frame_rate_divider;
+    CompositorScaleFilter filter;
+};
+
+/// <summary>
+/// Overlay kinds burned into every captured frame by the native overlay compositor.
+/// </summary>
+enum class CompositorOverlayKind : int32_t
+{
+    kTimecode = 0,
+    kClock = 1,
+    kTallyBorder = 2,
+    kSafeArea = 3,
+    kRectangle = 4,
+};
+
+/// <summary>
+/// Describes one overlay. Colours are straight-alpha <c>0xAARRGGBB</c>.
+/// </summary>
+struct CompositorOverlay
+{
+    CompositorOverlayKind kind;
+    int32_t x;
+    int32_t y;
+    /// <summary>Rectangle size; ignored by the other kinds.</summary>
+    int32_t width;
+    int32_t height;
+    uint32_t color;
+    /// <summary>Box drawn behind timecode and clock text; zero alpha skips it.</summary>
+    uint32_t background;
+    /// <summary>Glyph scale for text (1-16).</summary>
+    int32_t scale;
+    /// <summary>Line thickness for tally borders and safe-area outlines; zero selects a default.</summary>
+    int32_t thickness;
+};
+
+/// <summary>
+/// Overlay blend cost accumulated since the overlays were last replaced.
+/// </summary>
+struct CompositorOverlayStats
+{
+    uint64_t frames;
+    uint64_t last_pixels_blended;
+    int64_t last_blend_nanoseconds;
+    int64_t peak_blend_nanoseconds;
+    int64_t total_blend_nanoseconds;
+};
+
+/// <summary>
+/// Output of a layer compositor that blends several capture sessions into one frame.
+/// </summary>
+struct CompositorLayerCompositorConfig
+{
+    uint32_t struct_size;
+    uint32_t abi_version;
+    int32_t width;
+    int32_t height;
+    int32_t frame_rate_numerator;
+    int32_t frame_rate_denominator;
+    CompositorAlphaMode alpha_mode;
+    /// <summary>Applied to the composition thread, which also runs the output callback.</summary>
+    CompositorThreadPolicy thread_policy;
+    /// <summary>Combination of <c>CompositorMemoryFlags</c> for the layer rings and output buffers.</summary>
+    uint32_t memory_flags;
+};
+
+/// <summary>
+/// Submission and alignment figures for one layer. Ages run from a frame's capture to the composite that used it.
+/// </summary>
+struct CompositorLayerStats
+{
+    int32_t z_order;
+    int32_t delay_frames;
+    uint64_t frames_submitted;
+    uint64_t frames_dropped;
+    int64_t last_age_microseconds;
+    int64_t mean_age_microseconds;
+};
+
+/// <summary>
+/// A 128-bit digest of a frame's pixels, filled by <c>cc_hash_frame</c>.
+/// </summary>
+struct CompositorContentHash
+{
+    uint64_t low;
+    uint64_t high;
+};
+
+/// <summary>
+/// Tile and timing figures for a layer compositor.
+/// </summary>
+struct CompositorLayerCompositorStats
+{
+    uint64_t frames;
+    uint64_t tiles_composed;
+    uint64_t tiles_skipped;
+    int64_t last_compose_nanoseconds;
+    int64_t peak_compose_nanoseconds;
+};
+
+/// <summary>
+/// Instruction set tiers, lowest first.
+/// </summary>
+enum class CompositorSimdLevel : int32_t
+{
+    kScalar = 0,
+    kSse2 = 1,
+    kSse41 = 2,
+    kAvx2 = 3,
+    kAvx512 = 4,
+};
+
+/// <summary>
+/// Pixel formats a session can deliver, combined as bit flags in <c>CompositorCapabilities::pixel_formats</c>.
+/// </summary>
+enum class CompositorPixelFormat : uint32_t
+{
+    /// <summary>8-bit BGRA, premultiplied or straight according to <c>CompositorAlphaMode</c>.</summary>
+    kBgra8 = 1u << 0,
+};
+
+/// <summary>
+/// Optional features, combined as bit flags in <c>CompositorCapabilities::features</c>.
+/// </summary>
+enum class CompositorFeature : uint32_t
+{
+    /// <summary>Frames come from Chromium's viz capturer rather than the built-in test pattern.</summary>
+    kVizCapture = 1u << 0,
+    kRenditions = 1u << 1,
+    kSupersampling = 1u << 2,
+    kRateConversion = 1u << 3,
+    kFrameBlending = 1u << 4,
+    kInterlacing = 1u << 5,
+    kOverlays = 1u << 6,
+    kLayers = 1u << 7,
+    kStraightAlpha = 1u << 8,
+    kThreadPolicy = 1u << 9,
+    kMemoryFlags = 1u << 10,
+    kMemoryBudget = 1u << 11,
+    kCounters = 1u << 12,
+    kFlightRecorder = 1u << 13,
+    /// <summary>The fallback capture loop honours <c>CompositorCaptureConfig::faults</c>.</summary>
+    kCaptureFaults = 1u << 14,
+};
+
+/// <summary>
+/// What this build of the helper supports, filled by <c>cc_query_capabilities</c> so callers can pick the fastest
+/// mode available instead of discovering missing features when a session fails to start.
+/// </summary>
+struct CompositorCapabilities
+{
+    /// <summary>Set by the caller to the size of its buffer; the helper fills at most that many bytes.</summary>
+    uint32_t struct_size;
+    /// <summary>Set by the helper to its <c>kCompositorAbiVersion</c>.</summary>
+    uint32_t abi_version;
+    /// <summary>Combination of <c>CompositorPixelFormat</c> flags.</summary>
+    uint32_t pixel_formats;
+    /// <summary>Combination of <c>CompositorFeature</c> flags.</summary>
+    uint32_t features;
+    /// <summary>Tier the pixel kernels were compiled for.</summary>
+    CompositorSimdLevel compiled_simd_level;
+    /// <summary>Highest tier the CPU and operating system support.</summary>
+    CompositorSimdLevel cpu_simd_level;
+    int32_t max_supersample_factor;
+    /// <summary>Layers a layer compositor blends, including the bottom one.</summary>
+    int32_t max_layers;
+    /// <summary>Workers in the shared frame task scheduler.</summary>
+    int32_t scheduler_workers;
+    /// <summary>Source frames each session keeps for rate conversion.</summary>
+    int32_t source_frame_pool_depth;
+    /// <summary>Tick of the monotonic clock used for frame timestamps.</summary>
+    int64_t clock_resolution_nanoseconds;
+    /// <summary>Shortest sleep the capture threads achieved when asked for one microsecond; measured once.</summary>
+    int64_t sleep_resolution_nanoseconds;
+    /// <summary>Large page size the process can allocate, or 0 when large pages are unavailable.</summary>
+    int64_t large_page_bytes;
+    int32_t numa_node_count;
+};
+
+/// <summary>
+/// Pools that draw on the frame-memory budget.
+/// </summary>
+enum class CompositorMemoryPool : int32_t
+{
+    /// <summary>Session staging, supersampling, rate-conversion, interlace and straight-alpha buffers.</summary>
+    kCapture = 0,
+    kRenditions = 1,
+    /// <summary>Layer compositor rings and composites.</summary>
+    kLayers = 2,
+    /// <summary>Frames buffered by the managed pipelines, charged with <c>cc_reserve_frame_memory</c>.</summary>
+    kPipeline = 3,
+};
+
+constexpr int32_t kCompositorMemoryPoolCount = 4;
+
+/// <summary>
+/// Use and high-water mark of one pool.
+/// </summary>
+struct CompositorMemoryPoolStats
+{
+    uint64_t in_use_bytes;
+    uint64_t high_water_bytes;
+    /// <summary>Reservations refused because they would have exceeded the budget.</summary>
+    uint64_t refusals;
+};
+
+/// <summary>
+/// Frame-memory budget figures for the whole process, filled by <c>cc_get_memory_stats</c>.
+/// </summary>
+struct CompositorMemoryStats
+{
+    /// <summary>Set by the caller to the size of its buffer; the helper fills at most that many bytes.</summary>
+    uint32_t struct_size;
+    /// <summary>Set by the helper to its <c>kCompositorAbiVersion</c>.</summary>
+    uint32_t abi_version;
+    /// <summary>The budget, or 0 when frame memory is unlimited.</summary>
+    uint64_t budget_bytes;
+    uint64_t in_use_bytes;
+    uint64_t high_water_bytes;
+    uint64_t refusals;
+    /// <summary>Bytes freed because sessions stopped and their pools went idle.</summary>
+    uint64_t trimmed_bytes;
+    /// <summary>Indexed by <c>CompositorMemoryPool</c>.</summary>
+    CompositorMemoryPoolStats pools[kCompositorMemoryPoolCount];
+};
+
+constexpr int32_t kCompositorHistogramBucketCount = 17;
+
+/// <summary>
+/// Upper bound of the first histogram bucket. Each bucket doubles the previous bound, so bucket <c>i</c> holds
+/// durations up to <c>1024 &lt;&lt; i</c> nanoseconds and the last bucket holds everything beyond 34 ms.
+/// </summary>
+constexpr int64_t kCompositorHistogramFirstBoundNanoseconds = 1024;
+
+/// <summary>
+/// A duration histogram embedded in <c>CompositorCounters</c>.
+/// </summary>
+struct CompositorHistogram
+{
+    uint64_t count;
+    uint64_t sum_nanoseconds;
+    /// <summary>Per-bucket counts, not cumulative.</summary>
+    uint64_t buckets[kCompositorHistogramBucketCount];
+};
+
+/// <summary>
+/// Process-wide event counts, filled by <c>cc_get_counters</c>. They only grow; callers diff two snapshots for rates.
+/// </summary>
+struct CompositorCounters
+{
+    /// <summary>Set by the caller to the size of its buffer; the helper fills at most that many bytes.</summary>
+    uint32_t struct_size;
+    /// <summary>Set by the helper to its <c>kCompositorAbiVersion</c>.</summary>
+    uint32_t abi_version;
+    /// <summary>Frames produced by capture sessions, whether they went to a callback or a layer compositor.</summary>
+    uint64_t frames_captured;
+    uint64_t frames_delivered;
+    uint64_t layer_frames_submitted;
+    uint64_t rendition_frames_delivered;
+    uint64_t overlay_frames;
+    /// <summary>Frames delivered by layer compositors.</summary>
+    uint64_t composites_delivered;
+    uint64_t tiles_composed;
+    /// <summary>Tiles left untouched because no layer changed them.</summary>
+    uint64_t tiles_skipped;
+    /// <summary>Time from the start of a capture loop iteration to the frame being ready to deliver.</summary>
+    CompositorHistogram frame_conversion;
+    /// <summary>Time to scale, and convert the alpha of, one rendition frame.</summary>
+    CompositorHistogram rendition_conversion;
+    /// <summary>Time to blend one layer composite.</summary>
+    CompositorHistogram composite;
+};
+
+/// <summary>
+/// Pipeline events kept by the flight recorder, passed to <c>cc_flight_record</c>.
+/// </summary>
+enum class CompositorFlightEvent : int32_t
+{
+    /// <summary>A frame reached the pipeline; the value is 1 for compositor frames and 0 for paints.</summary>
+    kFrameCaptured = 0,
+    /// <summary>A frame entered the paced buffer; the value is the backlog afterwards.</summary>
+    kFrameEnqueued = 1,
+    kSendBegin = 2,
+    kSendEnd = 3,
+    kRepeat = 4,
+    /// <summary>A frame was discarded; the value is a <c>CompositorFlightDropReason</c>.</summary>
+    kDrop = 5,
+    /// <summary>The paced buffer started refilling; the value is the backlog.</summary>
+    kWarmupEnter = 6,
+    kWarmupExit = 7,
+    /// <summary>The paced buffer ran dry after it had been primed; the value is the backlog.</summary>
+    kUnderrun = 8,
+    /// <summary>An invalidation ticket was issued; the value is the number pending afterwards.</summary>
+    kTicketIssued = 9,
+    kTicketExpired = 10,
+};
+
+/// <summary>
+/// Why a <c>CompositorFlightEvent::kDrop</c> frame was discarded.
+/// </summary>
+enum class CompositorFlightDropReason : int64_t
+{
+    kOverflow = 0,
+    kResync = 1,
+    kUnsupportedStorage = 2,
+    kSpurious = 3,
+};
+
 /// <summary>
 /// Callback signature used by the compositor capture helper to surface frames to managed callers.
 /// </summary>
@@ -54,29 +555,176 @@ extern "C"
 {
 struct CompositorCaptureSession;
 
+/// <summary>
+/// Reports the ABI version, pixel formats, features, SIMD tiers, pool sizes and timer resolution of this helper.
+/// The first call measures sleep resolution and can take a few scheduler ticks.
+/// </summary>
+/// <param name="capabilities">Receives the capabilities; <c>struct_size</c> must be set by the caller.</param>
+/// <returns>0 on success, or -1 when the pointer is null or <c>struct_size</c> does not cover the version fields.</returns>
+__declspec(dllexport) int32_t cc_query_capabilities(CompositorCapabilities* capabilities);
+
+/// <summary>
+/// Copies a frame between non-overlapping buffers, bypassing the cache with non-temporal stores for frames of 4 MB
+/// and more. Exported so the managed pipeline's frame copies use the same primitive as the helper's own.
+/// </summary>
+__declspec(dllexport) void cc_copy_frame(void* destination, const void* source, size_t bytes);
+
+/// <summary>
+/// Hashes the first <paramref name="row_bytes"/> of each row into a 128-bit digest with the helper's SSE2 kernel,
+/// so the managed pipelines can tell a repeated picture from a changed one at memory speed.
+/// </summary>
+/// <returns>0 on success, or -1 when <paramref name="hash"/> is null or the stride is shorter than a row.</returns>
+__declspec(dllexport) int32_t cc_hash_frame(const void* pixels, int32_t row_bytes, int32_t height, int32_t stride, CompositorContentHash* hash);
+
+/// <summary>
+/// Caps the frame memory of every pool in the process. Sessions that would exceed it refuse to start and layers
+/// refuse to attach; memory already in use is kept. Zero removes the cap.
+/// </summary>
+/// <returns>0 on success, or -1 when <paramref name="bytes"/> is negative.</returns>
+__declspec(dllexport) int32_t cc_set_frame_memory_budget(int64_t bytes);
+
+/// <summary>
+/// Copies the budget, use, high-water marks and refusals of the frame pools.
+/// </summary>
+/// <param name="stats">Receives the figures; <c>struct_size</c> must be set by the caller.</param>
+/// <returns>0 on success, or -1 when the pointer is null or <c>struct_size</c> does not cover the version fields.</returns>
+__declspec(dllexport) int32_t cc_get_memory_stats(CompositorMemoryStats* stats);
+
+/// <summary>
+/// Charges frame memory allocated outside the helper to <paramref name="pool"/>. With <paramref name="required"/>
+/// non-zero the bytes are charged even over budget.
+/// </summary>
+/// <returns>0 on success, -1 when the arguments are invalid, or -2 when the bytes do not fit in the budget.</returns>
+__declspec(dllexport) int32_t cc_reserve_frame_memory(CompositorMemoryPool pool, int64_t bytes, int32_t required);
+
+/// <summary>
+/// Returns bytes charged with <c>cc_reserve_frame_memory</c>.
+/// </summary>
+__declspec(dllexport) void cc_release_frame_memory(CompositorMemoryPool pool, int64_t bytes);
+
+/// <summary>
+/// Sums the helper's per-thread event counters and duration histograms. Hot paths count into blocks owned by their own thread, so this is
+/// the only place the counts meet; call it at telemetry rate rather than per frame.
+/// </summary>
+/// <param name="counters">Receives the counts; <c>struct_size</c> must be set by the caller.</param>
+/// <returns>0 on success, or -1 when the pointer is null or <c>struct_size</c> does not cover the version fields.</returns>
+__declspec(dllexport) int32_t cc_get_counters(CompositorCounters* counters);
+
+/// <summary>
+/// Registers a named flight recorder track, such as one output pipeline. Each track shows as a process of its own
+/// in a dumped trace; track 0 is the helper's own capture sessions.
+/// </summary>
+/// <returns>The track id, or -1 when the name is null or every track is taken.</returns>
+__declspec(dllexport) int32_t cc_flight_register_track(const char* name);
+
+/// <summary>
+/// Appends an event to the calling thread's flight recorder ring. Costs a clock read and a few stores, takes no
+/// lock after the thread's first event, and ignores tracks and events out of range.
+/// </summary>
+__declspec(dllexport) void cc_flight_record(int32_t track, CompositorFlightEvent event, int64_t value);
+
+/// <summary>
+/// Writes the events every thread's ring still holds, oldest first, as Chrome trace event JSON that Perfetto and
+/// <c>chrome://tracing</c> open.
+/// </summary>
+/// <param name="path">UTF-8 path of the file to create or replace.</param>
+/// <returns>0 on success, -1 when the path is null, or -2 when the file could not be written.</returns>
+__declspec(dllexport) int32_t cc_flight_dump(const char* path);
+
 /// <summary>
 /// Creates a compositor capture session for the specified browser host and configuration.
 /// </summary>
 /// <param name="host">Optional browser host pointer (when available) that owns the compositor.</param>
-/// <param name="config">Requested capture configuration (size and cadence).</param>
+/// <param name="config">Requested capture configuration (size and cadence) with <c>struct_size</c> and <c>abi_version</c> set.</param>
 /// <param name="callback">Callback invoked for each captured frame.</param>
 /// <param name="user_data">Opaque pointer forwarded with each callback invocation.</param>
-/// <returns>A session handle that must be destroyed with <c>cc_destroy_session</c>.</returns>
+/// <returns>
+/// A session handle that must be destroyed with <c>cc_destroy_session</c>, or null when the arguments are invalid or
+/// the configuration is unversioned.
+/// </returns>
 __declspec(dllexport) CompositorCaptureSession* cc_create_session(CefBrowserHost* host, const CompositorCaptureConfig* config, CompositorFrameCallback callback, void* user_data);
 /// <summary>
+/// Registers an additional scaled output for the session. Must be called before <c>cc_start_session</c>.
+/// Frames are delivered to <paramref name="callback"/> and released with <c>cc_release_frame</c> like primary frames.
+/// </summary>
+/// <returns>The zero-based rendition index, or -1 when the configuration is invalid or the session is already running.</returns>
+__declspec(dllexport) int32_t cc_add_rendition(CompositorCaptureSession* session, const CompositorRenditionConfig* config, CompositorFrameCallback callback, void* user_data);
+/// <summary>
+/// Replaces the overlays drawn into every frame. Safe to call while the session runs; a count of zero clears them.
+/// </summary>
+/// <returns>0 on success, or -1 when the arguments are invalid.</returns>
+__declspec(dllexport) int32_t cc_set_overlays(CompositorCaptureSession* session, const CompositorOverlay* overlays, int32_t count);
+/// <summary>
+/// Copies the overlay blend statistics for the session.
+/// </summary>
+/// <returns>0 on success, or -1 when the arguments are invalid.</returns>
+__declspec(dllexport) int32_t cc_get_overlay_stats(CompositorCaptureSession* session, CompositorOverlayStats* stats);
+/// <summary>
+/// Copies the faults the session's capture loop has injected.
+/// </summary>
+/// <returns>0 on success, or -1 when the arguments are invalid.</returns>
+__declspec(dllexport) int32_t cc_get_capture_fault_stats(CompositorCaptureSession* session, CompositorCaptureFaultStats* stats);
+/// <summary>
 /// Begins compositor capture for the supplied session.
 /// </summary>
-__declspec(dllexport) void cc_start_session(CompositorCaptureSession* session);
+/// <returns>0 on success, -1 when the session is invalid, or -2 when its frame pools do not fit in the budget.</returns>
+__declspec(dllexport) int32_t cc_start_session(CompositorCaptureSession* session);
 /// <summary>
-/// Stops compositor capture for the supplied session.
+/// Stops compositor capture for the supplied session and frees its frame pools until it is started again.
 /// </summary>
 __declspec(dllexport) void cc_stop_session(CompositorCaptureSession* session);
 /// <summary>
-/// Returns a frame to the native compositor once managed consumers have finished processing it.
+/// Returns a frame to the native compositor once managed consumers have finished processing it. Releasing late does
+/// not pin the pixels: the session renders every frame into the same output buffers, so they are only valid until the
+/// next frame is delivered and a consumer that needs them longer must copy them.
 /// </summary>
 __declspec(dllexport) void cc_release_frame(CompositorCaptureSession* session, uint64_t frame_token);
 /// <summary>
 /// Destroys a compositor capture session and releases native resources.
 /// </summary>
 __declspec(dllexport) void cc_destroy_session(CompositorCaptureSession* session);
+
+struct CompositorLayerCompositor;
+
+/// <summary>
+/// Creates a compositor that blends the frames of attached sessions and delivers one paced output.
+/// </summary>
+/// <returns>
+/// A handle that must be destroyed with <c>cc_destroy_layer_compositor</c> after every attached session is stopped,
+/// or null when the arguments are invalid or the output does not fit in the frame-memory budget.
+/// </returns>
+__declspec(dllexport) CompositorLayerCompositor* cc_create_layer_compositor(const CompositorLayerCompositorConfig* config, CompositorFrameCallback callback, void* user_data);
+/// <summary>
+/// Routes a session's frames into the compositor instead of the session callback. Neither the session nor the
+/// compositor may be running yet, though sessions attached earlier may be. The session must match the compositor's
+/// size, and at most eight layers can be attached. <paramref name="delay_frames"/> holds the layer back by that many
+/// of its own frames so it lines up with slower layers.
+/// </summary>
+/// <returns>
+/// The layer index, or -1 when the arguments are invalid, either object is running or the layer's ring does not fit
+/// in the frame-memory budget.
+/// </returns>
+__declspec(dllexport) int32_t cc_attach_layer(CompositorLayerCompositor* compositor, CompositorCaptureSession* session, int32_t z_order, int32_t delay_frames);
+/// <summary>
+/// Starts composing at the configured rate.
+/// </summary>
+__declspec(dllexport) void cc_start_layer_compositor(CompositorLayerCompositor* compositor);
+/// <summary>
+/// Stops composing.
+/// </summary>
+__declspec(dllexport) void cc_stop_layer_compositor(CompositorLayerCompositor* compositor);
+/// <summary>
+/// Copies the statistics of one layer.
+/// </summary>
+/// <returns>0 on success, or -1 when the arguments are invalid.</returns>
+__declspec(dllexport) int32_t cc_get_layer_stats(CompositorLayerCompositor* compositor, int32_t layer, CompositorLayerStats* stats);
+/// <summary>
+/// Copies the compositor's tile and timing statistics.
+/// </summary>
+/// <returns>0 on success, or -1 when the arguments are invalid.</returns>
+__declspec(dllexport) int32_t cc_get_layer_compositor_stats(CompositorLayerCompositor* compositor, CompositorLayerCompositorStats* stats);
+/// <summary>
+/// Destroys a layer compositor.
+/// </summary>
+__declspec(dllexport) void cc_destroy_layer_compositor(CompositorLayerCompositor* compositor);
 }
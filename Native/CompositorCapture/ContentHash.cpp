@@ -0,0 +1,251 @@
+#include "ContentHash.h"
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_HASH_SSE2 1
+#else
+#define TRACTUS_HASH_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr size_t kStripeBytes = 64;
+constexpr size_t kLanes = 8;
+constexpr size_t kStripesPerBlock = 16;
+constexpr size_t kSecretWords = kStripesPerBlock + kLanes;
+constexpr size_t kScrambleOffset = kStripesPerBlock;
+constexpr size_t kLowMergeOffset = 0;
+constexpr size_t kHighMergeOffset = 11;
+
+constexpr uint64_t kPrime32_1 = 0x9E3779B1u;
+constexpr uint64_t kPrime32_2 = 0x85EBCA77u;
+constexpr uint64_t kPrime32_3 = 0xC2B2AE3Du;
+constexpr uint64_t kPrime64_1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t kPrime64_2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t kPrime64_3 = 0x165667B19E3779F9ull;
+constexpr uint64_t kPrime64_4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t kPrime64_5 = 0x27D4EB2F165667C5ull;
+
+/// <summary>
+/// The secret: successive SplitMix64 outputs from zero, so the managed port can derive the same words.
+/// </summary>
+constexpr std::array<uint64_t, kSecretWords> MakeSecret()
+{
+    std::array<uint64_t, kSecretWords> secret{};
+    uint64_t state = 0;
+    for (size_t i = 0; i < kSecretWords; ++i)
+    {
+        state += 0x9E3779B97F4A7C15ull;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        secret[i] = z ^ (z >> 31);
+    }
+
+    return secret;
+}
+
+alignas(16) constexpr std::array<uint64_t, kSecretWords> kSecret = MakeSecret();
+
+using Accumulators = std::array<uint64_t, kLanes>;
+
+constexpr Accumulators kInitialAccumulators{kPrime32_3, kPrime64_1, kPrime64_2, kPrime64_3, kPrime64_4, kPrime32_2, kPrime64_5, kPrime32_1};
+
+uint64_t ReadWord(const uint8_t* bytes)
+{
+    uint64_t word;
+    std::memcpy(&word, bytes, sizeof(word));
+    return word;
+}
+
+void AccumulateScalar(Accumulators& acc, const uint8_t* stripe, const uint64_t* key)
+{
+    for (size_t i = 0; i < kLanes; ++i)
+    {
+        const auto data = ReadWord(stripe + (i * 8));
+        const auto keyed = data ^ key[i];
+        acc[i ^ 1] += data;
+        acc[i] += (keyed & 0xFFFFFFFFu) * (keyed >> 32);
+    }
+}
+
+void ScrambleScalar(Accumulators& acc)
+{
+    for (size_t i = 0; i < kLanes; ++i)
+    {
+        auto value = acc[i];
+        value ^= value >> 47;
+        value ^= kSecret[kScrambleOffset + i];
+        acc[i] = value * kPrime32_1;
+    }
+}
+
+#if TRACTUS_HASH_SSE2
+/// <summary>
+/// The accumulators as four registers of two lanes each, held across a whole frame.
+/// </summary>
+struct VectorAccumulators
+{
+    __m128i lanes[kLanes / 2];
+};
+
+void AccumulateSse2(VectorAccumulators& acc, const uint8_t* stripe, const uint64_t* key)
+{
+    for (size_t j = 0; j < kLanes / 2; ++j)
+    {
+        const auto data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe) + j);
+        const auto keyed = _mm_xor_si128(data, _mm_loadu_si128(reinterpret_cast<const __m128i*>(key + (j * 2))));
+        const auto product = _mm_mul_epu32(keyed, _mm_srli_epi64(keyed, 32));
+        const auto swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+        acc.lanes[j] = _mm_add_epi64(acc.lanes[j], _mm_add_epi64(product, swapped));
+    }
+}
+
+void ScrambleSse2(VectorAccumulators& acc)
+{
+    const auto prime = _mm_set_epi32(0, static_cast<int32_t>(kPrime32_1), 0, static_cast<int32_t>(kPrime32_1));
+    for (size_t j = 0; j < kLanes / 2; ++j)
+    {
+        auto value = acc.lanes[j];
+        value = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+        value = _mm_xor_si128(value, _mm_load_si128(reinterpret_cast<const __m128i*>(kSecret.data() + kScrambleOffset + (j * 2))));
+
+        // A 64x32-bit multiply from two 32x32-bit halves.
+        const auto low = _mm_mul_epu32(value, prime);
+        const auto high = _mm_mul_epu32(_mm_srli_epi64(value, 32), prime);
+        acc.lanes[j] = _mm_add_epi64(low, _mm_slli_epi64(high, 32));
+    }
+}
+#endif
+
+/// <summary>
+/// Folds the 128-bit product of two words to 64 bits.
+/// </summary>
+uint64_t MultiplyFold(uint64_t a, uint64_t b)
+{
+    const auto low_low = (a & 0xFFFFFFFFu) * (b & 0xFFFFFFFFu);
+    const auto high_low = (a >> 32) * (b & 0xFFFFFFFFu);
+    const auto low_high = (a & 0xFFFFFFFFu) * (b >> 32);
+    const auto high_high = (a >> 32) * (b >> 32);
+    const auto cross = (low_low >> 32) + (high_low & 0xFFFFFFFFu) + low_high;
+    const auto upper = (high_low >> 32) + (cross >> 32) + high_high;
+    const auto lower = (cross << 32) | (low_low & 0xFFFFFFFFu);
+    return lower ^ upper;
+}
+
+uint64_t Avalanche(uint64_t value)
+{
+    value ^= value >> 37;
+    value *= 0x165667919E3779F9ull;
+    return value ^ (value >> 32);
+}
+
+uint64_t Merge(const Accumulators& acc, size_t offset, uint64_t start)
+{
+    auto result = start;
+    for (size_t i = 0; i < kLanes; i += 2)
+    {
+        result += MultiplyFold(acc[i] ^ kSecret[offset + i], acc[i + 1] ^ kSecret[offset + i + 1]);
+    }
+
+    return Avalanche(result);
+}
+
+ContentHash128 Finish(const Accumulators& acc, int32_t row_bytes, int32_t height)
+{
+    const auto bytes_per_row = static_cast<uint64_t>(row_bytes);
+    const auto total = bytes_per_row * static_cast<uint64_t>(height);
+    return ContentHash128{
+        Merge(acc, kLowMergeOffset, (total * kPrime64_1) + (bytes_per_row * kPrime64_3)),
+        Merge(acc, kHighMergeOffset, ~(total * kPrime64_2) + (bytes_per_row * kPrime64_4)),
+    };
+}
+
+/// <summary>
+/// Walks the frame stripe by stripe, padding each row's tail, and scrambles after every block of stripes.
+/// </summary>
+template <typename State, typename AccumulateFn, typename ScrambleFn>
+void Walk(State& state, const uint8_t* pixels, int32_t row_bytes, int32_t height, int32_t stride, AccumulateFn accumulate, ScrambleFn scramble)
+{
+    const auto bytes_per_row = static_cast<size_t>(row_bytes);
+    size_t stripe = 0;
+    auto advance = [&]() {
+        if (++stripe == kStripesPerBlock)
+        {
+            scramble(state);
+            stripe = 0;
+        }
+    };
+
+    for (int32_t y = 0; y < height; ++y)
+    {
+        const auto* row = pixels + (static_cast<ptrdiff_t>(y) * stride);
+        size_t offset = 0;
+        for (; offset + kStripeBytes <= bytes_per_row; offset += kStripeBytes)
+        {
+            accumulate(state, row + offset, kSecret.data() + stripe);
+            advance();
+        }
+
+        if (offset < bytes_per_row)
+        {
+            alignas(16) uint8_t tail[kStripeBytes] = {};
+            std::memcpy(tail, row + offset, bytes_per_row - offset);
+            accumulate(state, tail, kSecret.data() + stripe);
+            advance();
+        }
+    }
+}
+
+bool IsEmpty(const uint8_t* pixels, int32_t row_bytes, int32_t height)
+{
+    return pixels == nullptr || row_bytes <= 0 || height <= 0;
+}
+} // namespace
+
+ContentHash128 HashFrameScalar(const uint8_t* pixels, int32_t row_bytes, int32_t height, int32_t stride)
+{
+    if (IsEmpty(pixels, row_bytes, height))
+    {
+        return Finish(kInitialAccumulators, 0, 0);
+    }
+
+    auto acc = kInitialAccumulators;
+    Walk(acc, pixels, row_bytes, height, stride, AccumulateScalar, ScrambleScalar);
+    return Finish(acc, row_bytes, height);
+}
+
+ContentHash128 HashFrame(const uint8_t* pixels, int32_t row_bytes, int32_t height, int32_t stride)
+{
+#if TRACTUS_HASH_SSE2
+    if (IsEmpty(pixels, row_bytes, height))
+    {
+        return Finish(kInitialAccumulators, 0, 0);
+    }
+
+    VectorAccumulators vector{};
+    for (size_t j = 0; j < kLanes / 2; ++j)
+    {
+        vector.lanes[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kInitialAccumulators.data() + (j * 2)));
+    }
+
+    Walk(vector, pixels, row_bytes, height, stride, AccumulateSse2, ScrambleSse2);
+
+    alignas(16) Accumulators acc{};
+    for (size_t j = 0; j < kLanes / 2; ++j)
+    {
+        _mm_store_si128(reinterpret_cast<__m128i*>(acc.data() + (j * 2)), vector.lanes[j]);
+    }
+
+    return Finish(acc, row_bytes, height);
+#else
+    return HashFrameScalar(pixels, row_bytes, height, stride);
+#endif
+}
+} // namespace tractus
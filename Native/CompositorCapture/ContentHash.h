@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// A 128-bit digest of a frame's pixels. Two frames with equal digests are treated as identical.
+/// </summary>
+struct ContentHash128
+{
+    uint64_t low;
+    uint64_t high;
+};
+
+inline bool operator==(const ContentHash128& a, const ContentHash128& b)
+{
+    return a.low == b.low && a.high == b.high;
+}
+
+inline bool operator!=(const ContentHash128& a, const ContentHash128& b)
+{
+    return !(a == b);
+}
+
+/// <summary>
+/// Hashes the first <paramref name="row_bytes"/> of each of <paramref name="height"/> rows, so row padding never
+/// makes two identical pictures differ. The construction follows XXH3: eight 64-bit lanes take a 32x32-bit multiply
+/// of each input word keyed by a fixed secret, plus the neighbouring word, 64 bytes at a time, and are scrambled
+/// every 1 KB, so one pass runs at memory speed with SSE2. It is not XXH3-compatible and not cryptographic; it only
+/// needs to tell a repeated picture from a changed one. Each row's tail is zero-padded to a whole 64-byte stripe.
+/// </summary>
+ContentHash128 HashFrame(const uint8_t* pixels, int32_t row_bytes, int32_t height, int32_t stride);
+
+/// <summary>
+/// The portable form of <see cref="HashFrame"/>, which the SSE2 kernel must match bit for bit.
+/// </summary>
+ContentHash128 HashFrameScalar(const uint8_t* pixels, int32_t row_bytes, int32_t height, int32_t stride);
+} // namespace tractus
@@ -0,0 +1,89 @@
+#include "CpuFeatures.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h>
+#include <intrin.h>
+#define TRACTUS_CPUID_MSVC 1
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TRACTUS_CPUID_BUILTIN 1
+#endif
+
+namespace tractus
+{
+namespace
+{
+SimdLevel QuerySimdLevel()
+{
+#if defined(TRACTUS_CPUID_MSVC)
+    int registers[4] = {};
+    __cpuid(registers, 0);
+    const auto highest_leaf = registers[0];
+
+    __cpuid(registers, 1);
+    const auto ecx = static_cast<uint32_t>(registers[2]);
+    const auto edx = static_cast<uint32_t>(registers[3]);
+    if ((edx & (1u << 26)) == 0)
+    {
+        return SimdLevel::kScalar;
+    }
+
+    if ((ecx & (1u << 19)) == 0)
+    {
+        return SimdLevel::kSse2;
+    }
+
+    // AVX state has to be enabled by the OS (OSXSAVE plus XMM/YMM in XCR0) before AVX2 can be used.
+    const bool os_saves_avx = (ecx & (1u << 27)) != 0 && (ecx & (1u << 28)) != 0 && (_xgetbv(0) & 0x6u) == 0x6u;
+    if (!os_saves_avx || highest_leaf < 7)
+    {
+        return SimdLevel::kSse41;
+    }
+
+    __cpuidex(registers, 7, 0);
+    const auto ebx = static_cast<uint32_t>(registers[1]);
+    if ((ebx & (1u << 5)) == 0)
+    {
+        return SimdLevel::kSse41;
+    }
+
+    const bool os_saves_avx512 = (_xgetbv(0) & 0xE6u) == 0xE6u;
+    return (ebx & (1u << 16)) != 0 && os_saves_avx512 ? SimdLevel::kAvx512 : SimdLevel::kAvx2;
+#elif defined(TRACTUS_CPUID_BUILTIN)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SimdLevel::kAvx512;
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SimdLevel::kAvx2;
+    }
+
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+        return SimdLevel::kSse41;
+    }
+
+    return __builtin_cpu_supports("sse2") ? SimdLevel::kSse2 : SimdLevel::kScalar;
+#else
+    return SimdLevel::kScalar;
+#endif
+}
+} // namespace
+
+SimdLevel CompiledSimdLevel()
+{
+#if defined(_M_X64) || defined(__SSE2__)
+    return SimdLevel::kSse2;
+#else
+    return SimdLevel::kScalar;
+#endif
+}
+
+SimdLevel DetectSimdLevel()
+{
+    static const auto level = QuerySimdLevel();
+    return level;
+}
+} // namespace tractus
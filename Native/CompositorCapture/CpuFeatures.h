@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Instruction set tiers relevant to the helper's pixel kernels, lowest first.
+/// </summary>
+enum class SimdLevel : int32_t
+{
+    kScalar = 0,
+    kSse2 = 1,
+    kSse41 = 2,
+    kAvx2 = 3,
+    kAvx512 = 4,
+};
+
+/// <summary>
+/// Returns the tier the helper's kernels were compiled for. Every kernel shares the same SSE2 guard, so this is
+/// SSE2 on x86/x64 builds and scalar elsewhere.
+/// </summary>
+SimdLevel CompiledSimdLevel();
+
+/// <summary>
+/// Returns the highest tier the CPU and operating system support, including the OS saving the wider register state.
+/// The result is computed once.
+/// </summary>
+SimdLevel DetectSimdLevel();
+} // namespace tractus
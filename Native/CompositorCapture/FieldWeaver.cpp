@@ -0,0 +1,70 @@
+#include "FieldWeaver.h"
+
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_WEAVE_SSE2 1
+#else
+#define TRACTUS_WEAVE_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+void FilterRow(const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* output, size_t bytes)
+{
+    size_t x = 0;
+
+#if TRACTUS_WEAVE_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto round = _mm_set1_epi16(2);
+    for (; x + 16 <= bytes; x += 16)
+    {
+        const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(above + x));
+        const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x));
+        const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(below + x));
+        auto low = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)), _mm_slli_epi16(_mm_unpacklo_epi8(c, zero), 1));
+        auto high = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)), _mm_slli_epi16(_mm_unpackhi_epi8(c, zero), 1));
+        low = _mm_srli_epi16(_mm_add_epi16(low, round), 2);
+        high = _mm_srli_epi16(_mm_add_epi16(high, round), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x), _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; x < bytes; ++x)
+    {
+        output[x] = static_cast<uint8_t>((above[x] + 2u * row[x] + below[x] + 2u) >> 2);
+    }
+}
+} // namespace
+
+void WeaveField(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t height, int32_t parity,
+                int32_t first_line, int32_t end_line, bool flicker_filter)
+{
+    const auto bytes = static_cast<size_t>(width) * 4u;
+    for (int32_t line = first_line; line < end_line; ++line)
+    {
+        const auto y = line * 2 + parity;
+        if (y >= height)
+        {
+            break;
+        }
+
+        const auto* row = source + static_cast<size_t>(y) * stride;
+        auto* output = destination + static_cast<size_t>(y) * stride;
+        if (!flicker_filter)
+        {
+            std::memcpy(output, row, bytes);
+            continue;
+        }
+
+        // Edge rows reuse themselves as the missing neighbour.
+        const auto* above = y > 0 ? row - stride : row;
+        const auto* below = y + 1 < height ? row + stride : row;
+        FilterRow(above, row, below, output, bytes);
+    }
+}
+} // namespace tractus
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Writes one field of an interleaved frame. Field line <c>i</c> maps to frame row <c>2 * i + parity</c>, so field
+/// 0 fills the even rows and field 1 the odd rows, matching NDI's interleaved layout. Lines
+/// [<paramref name="first_line"/>, <paramref name="end_line"/>) are processed, which lets callers band the work.
+/// </summary>
+/// <param name="source">The progressive picture rendered at this field's instant.</param>
+/// <param name="flicker_filter">
+/// When set, each row is blended 1-2-1 with its vertical neighbours in <paramref name="source"/> so single-pixel
+/// horizontal lines do not twitter at frame rate on interlaced displays.
+/// </param>
+void WeaveField(const uint8_t* source, uint8_t* destination, int32_t stride, int32_t width, int32_t height, int32_t parity,
+                int32_t first_line, int32_t end_line, bool flicker_filter);
+
+/// <summary>
+/// Returns the number of lines in the field with the given parity for a frame of <paramref name="height"/> rows.
+/// </summary>
+inline int32_t FieldLineCount(int32_t height, int32_t parity)
+{
+    return (height - parity + 1) / 2;
+}
+} // namespace tractus
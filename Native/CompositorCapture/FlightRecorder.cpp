@@ -0,0 +1,468 @@
+#include "FlightRecorder.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr size_t kCacheLineSize = 64;
+
+/// <summary>
+/// One recorded event. Only the owning thread writes a slot; the atomics exist so snapshot readers on other threads
+/// never see a torn word, and the ring's counters tell them whether the words belong together.
+/// </summary>
+struct FlightSlot
+{
+    std::atomic<int64_t> timestamp{0};
+    std::atomic<int64_t> value{0};
+    /// <summary>Thread id in the high 32 bits, track in the next 16 and event in the low 16.</summary>
+    std::atomic<uint64_t> meta{0};
+};
+
+struct alignas(kCacheLineSize) FlightRing
+{
+    /// <summary>Events whose slots may have been written, including one being written now.</summary>
+    std::atomic<uint64_t> claimed{0};
+    /// <summary>Events whose slots are completely written.</summary>
+    std::atomic<uint64_t> committed{0};
+    std::array<FlightSlot, FlightRecorder::kEventsPerThread> slots;
+};
+
+static_assert((FlightRecorder::kEventsPerThread & (FlightRecorder::kEventsPerThread - 1)) == 0, "the ring size must be a power of two");
+
+uint32_t CurrentThreadId()
+{
+#if defined(_WIN32)
+    return static_cast<uint32_t>(GetCurrentThreadId());
+#elif defined(__linux__)
+    return static_cast<uint32_t>(syscall(SYS_gettid));
+#else
+    return static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+}
+
+class FlightRegistry
+{
+public:
+    FlightRegistry()
+    {
+        track_names_.emplace_back("CompositorCapture helper");
+    }
+
+    FlightRing* Acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!free_.empty())
+        {
+            auto* ring = free_.back();
+            free_.pop_back();
+            return ring;
+        }
+
+        rings_.push_back(std::make_unique<FlightRing>());
+        return rings_.back().get();
+    }
+
+    void Release(FlightRing* ring)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        free_.push_back(ring);
+    }
+
+    int32_t RegisterTrack(const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (track_names_.size() >= FlightRecorder::kMaxTracks)
+        {
+            return -1;
+        }
+
+        track_names_.push_back(name);
+        return static_cast<int32_t>(track_names_.size() - 1);
+    }
+
+    std::vector<std::string> TrackNames()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return track_names_;
+    }
+
+    std::vector<FlightRecord> Snapshot()
+    {
+        std::vector<FlightRecord> records;
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& ring : rings_)
+        {
+            CopyRing(*ring, records);
+        }
+
+        return records;
+    }
+
+private:
+    static void CopyRing(const FlightRing& ring, std::vector<FlightRecord>& records)
+    {
+        constexpr uint64_t kMask = FlightRecorder::kEventsPerThread - 1;
+        const auto committed = ring.committed.load(std::memory_order_acquire);
+        const auto oldest = committed > FlightRecorder::kEventsPerThread ? committed - FlightRecorder::kEventsPerThread : 0;
+
+        const auto first = records.size();
+        for (auto index = oldest; index < committed; ++index)
+        {
+            const auto& slot = ring.slots[index & kMask];
+            FlightRecord record;
+            record.timestamp_nanoseconds = slot.timestamp.load(std::memory_order_relaxed);
+            record.value = slot.value.load(std::memory_order_relaxed);
+            const auto meta = slot.meta.load(std::memory_order_relaxed);
+            record.thread_id = static_cast<uint32_t>(meta >> 32);
+            record.track = static_cast<uint16_t>(meta >> 16);
+            record.event = static_cast<FlightEvent>(meta & 0xFFFFu);
+            records.push_back(record);
+        }
+
+        // Pairs with the writer's release fence: any slot we read from a later lap shows up here as a higher claim,
+        // and every slot that lap may have touched is dropped.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const auto claimed = ring.claimed.load(std::memory_order_relaxed);
+        const auto overwritten = claimed > FlightRecorder::kEventsPerThread ? claimed - FlightRecorder::kEventsPerThread : 0;
+        if (overwritten > oldest)
+        {
+            const auto torn = static_cast<size_t>(std::min(overwritten, committed) - oldest);
+            records.erase(records.begin() + static_cast<std::ptrdiff_t>(first), records.begin() + static_cast<std::ptrdiff_t>(first + torn));
+        }
+    }
+
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<FlightRing>> rings_;
+    std::vector<FlightRing*> free_;
+    std::vector<std::string> track_names_;
+};
+
+FlightRegistry& Registry()
+{
+    // Leaked so threads that outlive static destruction can still hand their rings back.
+    static auto* registry = new FlightRegistry();
+    return *registry;
+}
+
+/// <summary>
+/// Claims a ring on the thread's first event and hands it back, events intact, when the thread exits.
+/// </summary>
+struct ThreadFlightRing
+{
+    ThreadFlightRing()
+        : ring(Registry().Acquire()),
+          thread_bits(static_cast<uint64_t>(CurrentThreadId()) << 32)
+    {
+    }
+
+    ~ThreadFlightRing()
+    {
+        Registry().Release(ring);
+    }
+
+    FlightRing* ring;
+    uint64_t thread_bits;
+};
+
+struct EventFormat
+{
+    const char* name;
+    /// <summary>Name of the value in the trace's args, or null when the value carries nothing.</summary>
+    const char* argument;
+};
+
+constexpr std::array<EventFormat, kFlightEventCount> kEventFormats{{
+    {"frame captured", "compositor"},
+    {"frame enqueued", "buffered"},
+    {"send", nullptr},
+    {"send", nullptr},
+    {"repeat", nullptr},
+    {"drop", "reason"},
+    {"warmup", "buffered"},
+    {"warmup", "buffered"},
+    {"underrun", "buffered"},
+    {"ticket issued", "pending"},
+    {"ticket expired", "pending"},
+}};
+
+constexpr std::array<const char*, static_cast<size_t>(FlightDropReason::kCount)> kDropReasonNames{{
+    "overflow",
+    "resync",
+    "unsupported storage",
+    "spurious",
+}};
+
+void AppendEscaped(std::string& output, const std::string& text)
+{
+    for (const auto c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            output += '\\';
+            output += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+            output += escaped;
+        }
+        else
+        {
+            output += c;
+        }
+    }
+}
+
+class TraceWriter
+{
+public:
+    explicit TraceWriter(int64_t origin_nanoseconds)
+        : origin_(origin_nanoseconds)
+    {
+        output_ = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    }
+
+    void ProcessName(uint16_t track, const std::string& name)
+    {
+        Open("process_name", "M", track, 0);
+        output_ += ",\"args\":{\"name\":\"";
+        AppendEscaped(output_, name);
+        output_ += "\"}}";
+    }
+
+    void Complete(const FlightRecord& begin, int64_t end_nanoseconds)
+    {
+        Open("send", "X", begin.track, begin.thread_id);
+        Timestamp(begin.timestamp_nanoseconds);
+        output_ += ",\"dur\":";
+        Microseconds(end_nanoseconds - begin.timestamp_nanoseconds);
+        output_ += '}';
+    }
+
+    void Async(const FlightRecord& record, const char* phase)
+    {
+        Open(kEventFormats[static_cast<size_t>(record.event)].name, phase, record.track, record.thread_id);
+        Timestamp(record.timestamp_nanoseconds);
+        char id[32];
+        std::snprintf(id, sizeof(id), ",\"id\":%u", static_cast<unsigned>(record.track));
+        output_ += id;
+        Arguments(record);
+        output_ += '}';
+    }
+
+    void Instant(const FlightRecord& record)
+    {
+        Open(kEventFormats[static_cast<size_t>(record.event)].name, "i", record.track, record.thread_id);
+        Timestamp(record.timestamp_nanoseconds);
+        output_ += ",\"s\":\"t\"";
+        Arguments(record);
+        output_ += '}';
+    }
+
+    std::string Finish()
+    {
+        output_ += "]}";
+        return std::move(output_);
+    }
+
+private:
+    void Open(const char* name, const char* phase, uint16_t track, uint32_t thread_id)
+    {
+        if (!first_)
+        {
+            output_ += ',';
+        }
+
+        first_ = false;
+        char head[160];
+        // pid 0 is reserved by some viewers, so tracks are shifted up by one.
+        std::snprintf(head, sizeof(head), "\n{\"name\":\"%s\",\"cat\":\"pipeline\",\"ph\":\"%s\",\"pid\":%u,\"tid\":%" PRIu32, name, phase,
+                      static_cast<unsigned>(track) + 1u, thread_id);
+        output_ += head;
+    }
+
+    void Timestamp(int64_t nanoseconds)
+    {
+        output_ += ",\"ts\":";
+        Microseconds(nanoseconds - origin_);
+    }
+
+    void Microseconds(int64_t nanoseconds)
+    {
+        char number[32];
+        std::snprintf(number, sizeof(number), "%" PRId64 ".%03" PRId64, nanoseconds / 1000, nanoseconds % 1000);
+        output_ += number;
+    }
+
+    void Arguments(const FlightRecord& record)
+    {
+        const auto* argument = kEventFormats[static_cast<size_t>(record.event)].argument;
+        if (argument == nullptr)
+        {
+            return;
+        }
+
+        char args[96];
+        if (record.event == FlightEvent::kDrop && record.value >= 0 && record.value < static_cast<int64_t>(kDropReasonNames.size()))
+        {
+            std::snprintf(args, sizeof(args), ",\"args\":{\"%s\":\"%s\"}", argument, kDropReasonNames[static_cast<size_t>(record.value)]);
+        }
+        else
+        {
+            std::snprintf(args, sizeof(args), ",\"args\":{\"%s\":%" PRId64 "}", argument, record.value);
+        }
+
+        output_ += args;
+    }
+
+    int64_t origin_;
+    std::string output_;
+    bool first_{true};
+};
+} // namespace
+
+int32_t FlightRecorder::RegisterTrack(const std::string& name)
+{
+    return Registry().RegisterTrack(name);
+}
+
+void FlightRecorder::Record(FlightEvent event, uint16_t track, int64_t value)
+{
+    thread_local ThreadFlightRing local;
+    auto& ring = *local.ring;
+    const auto index = ring.committed.load(std::memory_order_relaxed);
+    auto& slot = ring.slots[index & (kEventsPerThread - 1)];
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    // Announce the overwrite before touching the slot so a concurrent snapshot can tell it raced us.
+    ring.claimed.store(index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestamp.store(now, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.meta.store(local.thread_bits | (static_cast<uint64_t>(track) << 16) | static_cast<uint64_t>(event), std::memory_order_relaxed);
+    ring.committed.store(index + 1, std::memory_order_release);
+}
+
+std::vector<FlightRecord> FlightRecorder::Snapshot()
+{
+    auto records = Registry().Snapshot();
+    std::stable_sort(records.begin(), records.end(), [](const FlightRecord& left, const FlightRecord& right)
+    {
+        return left.timestamp_nanoseconds < right.timestamp_nanoseconds;
+    });
+    return records;
+}
+
+std::string FlightRecorder::FormatChromeTrace(const std::vector<FlightRecord>& records)
+{
+    const auto names = Registry().TrackNames();
+    TraceWriter writer(records.empty() ? 0 : records.front().timestamp_nanoseconds);
+
+    std::vector<bool> seen(names.size(), false);
+    for (const auto& record : records)
+    {
+        if (record.track < seen.size() && !seen[record.track])
+        {
+            seen[record.track] = true;
+            writer.ProcessName(record.track, names[record.track]);
+        }
+    }
+
+    // Sends pair up on their thread. Warmups can start on the sender and end on the capture thread, so they pair
+    // per track as async slices; a warmup still open at the end of the snapshot stays open in the viewer.
+    std::unordered_map<uint64_t, FlightRecord> open_sends;
+    std::unordered_map<uint16_t, bool> warming;
+    for (const auto& record : records)
+    {
+        switch (record.event)
+        {
+        case FlightEvent::kSendBegin:
+            open_sends[(static_cast<uint64_t>(record.thread_id) << 16) | record.track] = record;
+            break;
+        case FlightEvent::kSendEnd:
+        {
+            const auto open = open_sends.find((static_cast<uint64_t>(record.thread_id) << 16) | record.track);
+            if (open != open_sends.end())
+            {
+                writer.Complete(open->second, record.timestamp_nanoseconds);
+                open_sends.erase(open);
+            }
+
+            break;
+        }
+        case FlightEvent::kWarmupEnter:
+            if (!warming[record.track])
+            {
+                warming[record.track] = true;
+                writer.Async(record, "b");
+            }
+
+            break;
+        case FlightEvent::kWarmupExit:
+            if (warming[record.track])
+            {
+                warming[record.track] = false;
+                writer.Async(record, "e");
+            }
+
+            break;
+        default:
+            if (record.event < FlightEvent::kCount)
+            {
+                writer.Instant(record);
+            }
+
+            break;
+        }
+    }
+
+    return writer.Finish();
+}
+
+bool FlightRecorder::DumpChromeTrace(const std::string& path)
+{
+    const auto trace = FormatChromeTrace(Snapshot());
+#if defined(_WIN32)
+    // The path is UTF-8 from the managed side.
+    const auto length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (length <= 0)
+    {
+        return false;
+    }
+
+    std::wstring wide(static_cast<size_t>(length), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, wide.data(), length);
+    FILE* file = _wfopen(wide.c_str(), L"wb");
+#else
+    FILE* file = std::fopen(path.c_str(), "wb");
+#endif
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    const auto written = std::fwrite(trace.data(), 1, trace.size(), file);
+    const auto closed = std::fclose(file) == 0;
+    return written == trace.size() && closed;
+}
+} // namespace tractus
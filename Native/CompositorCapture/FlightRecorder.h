@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace tractus
+{
+/// <summary>
+/// Pipeline events kept by the flight recorder. The values are shared with the managed pipeline through
+/// <c>cc_flight_record</c>, so they are only ever appended.
+/// </summary>
+enum class FlightEvent : uint16_t
+{
+    /// <summary>A frame reached the pipeline or, on the helper's own track, left a capture session.</summary>
+    kFrameCaptured = 0,
+    /// <summary>A frame entered the paced buffer; the value is the backlog afterwards.</summary>
+    kFrameEnqueued,
+    kSendBegin,
+    kSendEnd,
+    /// <summary>The previous frame was sent again because no fresh frame was ready.</summary>
+    kRepeat,
+    /// <summary>A frame was discarded; the value is a <c>FlightDropReason</c>.</summary>
+    kDrop,
+    /// <summary>The paced buffer started refilling; the value is the backlog.</summary>
+    kWarmupEnter,
+    kWarmupExit,
+    /// <summary>The paced buffer ran dry after it had been primed; the value is the backlog.</summary>
+    kUnderrun,
+    /// <summary>An invalidation ticket was issued; the value is the number pending afterwards.</summary>
+    kTicketIssued,
+    kTicketExpired,
+    kCount,
+};
+
+constexpr size_t kFlightEventCount = static_cast<size_t>(FlightEvent::kCount);
+
+/// <summary>
+/// Why a <c>FlightEvent::kDrop</c> frame was discarded.
+/// </summary>
+enum class FlightDropReason : int64_t
+{
+    /// <summary>The paced buffer was full and its oldest frame made room.</summary>
+    kOverflow = 0,
+    /// <summary>The pacer trimmed a frame to pull latency back to the target.</summary>
+    kResync,
+    /// <summary>The frame's pixels were not CPU-accessible.</summary>
+    kUnsupportedStorage,
+    /// <summary>A paint arrived without an invalidation ticket.</summary>
+    kSpurious,
+    kCount,
+};
+
+/// <summary>
+/// One event as read back from the recorder.
+/// </summary>
+struct FlightRecord
+{
+    /// <summary>Nanoseconds on <c>std::chrono::steady_clock</c>, the clock of frame timestamps.</summary>
+    int64_t timestamp_nanoseconds{0};
+    int64_t value{0};
+    /// <summary>Operating system id of the recording thread.</summary>
+    uint32_t thread_id{0};
+    uint16_t track{0};
+    FlightEvent event{FlightEvent::kFrameCaptured};
+};
+
+/// <summary>
+/// An always-on recorder of pipeline events. Each thread writes a fixed ring of its own with relaxed stores and no
+/// lock, so recording costs a clock read and a few stores; the rings are only read when a snapshot is taken. Rings
+/// outlive their threads and are handed to the next new thread, so memory stays bounded however many threads come
+/// and go, and a trace still shows a thread that has since exited.
+/// </summary>
+class FlightRecorder
+{
+public:
+    /// <summary>
+    /// Events each thread keeps; at 60 fps a paced sender thread keeps about ten seconds of history.
+    /// </summary>
+    static constexpr size_t kEventsPerThread = 4096;
+
+    /// <summary>
+    /// The track of the helper's own capture sessions. Tracks registered by callers start at 1.
+    /// </summary>
+    static constexpr uint16_t kHelperTrack = 0;
+
+    static constexpr size_t kMaxTracks = 256;
+
+    /// <summary>
+    /// Registers a named track, such as one output pipeline, that shows as a process of its own in a trace.
+    /// </summary>
+    /// <returns>The track id, or -1 when every track is taken.</returns>
+    static int32_t RegisterTrack(const std::string& name);
+
+    /// <summary>
+    /// Appends an event to the calling thread's ring, overwriting its oldest event once the ring is full. Wait-free
+    /// after the thread's first event, which claims a ring.
+    /// </summary>
+    static void Record(FlightEvent event, uint16_t track, int64_t value = 0);
+
+    /// <summary>
+    /// Copies every complete event in every ring, oldest first. Events a writer overwrote while they were being
+    /// copied are left out rather than returned torn.
+    /// </summary>
+    static std::vector<FlightRecord> Snapshot();
+
+    /// <summary>
+    /// Formats events in the Chrome trace event JSON format that Perfetto and <c>chrome://tracing</c> open. Sends
+    /// become slices on the sending thread, warmups become async slices on their track, and everything else is an
+    /// instant event.
+    /// </summary>
+    static std::string FormatChromeTrace(const std::vector<FlightRecord>& records);
+
+    /// <summary>
+    /// Writes a snapshot in the Chrome trace format to <paramref name="path"/>, replacing any existing file.
+    /// </summary>
+    /// <returns><c>false</c> when the file could not be written.</returns>
+    static bool DumpChromeTrace(const std::string& path);
+};
+} // namespace tractus
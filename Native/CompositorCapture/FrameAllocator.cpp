@@ -0,0 +1,307 @@
+#include "FrameAllocator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+#include <utility>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tractus
+{
+namespace
+{
+size_t RoundUp(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+#if defined(_WIN32)
+/// <summary>
+/// Large pages need SeLockMemoryPrivilege granted to the account and enabled in the process token.
+/// </summary>
+bool EnableLockMemoryPrivilege()
+{
+    static const bool enabled = []()
+    {
+        HANDLE token = nullptr;
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token))
+        {
+            return false;
+        }
+
+        TOKEN_PRIVILEGES privileges{};
+        privileges.PrivilegeCount = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+        bool granted = LookupPrivilegeValueW(nullptr, SE_LOCK_MEMORY_NAME, &privileges.Privileges[0].Luid) &&
+                       AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+                       GetLastError() == ERROR_SUCCESS;
+        CloseHandle(token);
+        return granted;
+    }();
+    return enabled;
+}
+#elif defined(__linux__)
+constexpr unsigned long kMpolPreferred = 1;
+
+/// <summary>
+/// Prefers <paramref name="node"/> for the pages in the range. Called before the first touch, so every page lands
+/// there unless the node runs out of memory. Uses the raw syscall to avoid a libnuma dependency.
+/// </summary>
+bool BindToNode(void* address, size_t length, int32_t node)
+{
+    if (node < 0 || node >= 64)
+    {
+        return false;
+    }
+
+    unsigned long mask = 1ul << node;
+    return syscall(SYS_mbind, address, length, kMpolPreferred, &mask, sizeof(mask) * 8 + 1, 0u) == 0;
+}
+#endif
+} // namespace
+
+size_t LargePageSize()
+{
+#if defined(_WIN32)
+    static const size_t size = EnableLockMemoryPrivilege() ? GetLargePageMinimum() : 0u;
+    return size;
+#elif defined(__linux__)
+    static const size_t size = []() -> size_t
+    {
+        auto* meminfo = std::fopen("/proc/meminfo", "r");
+        if (meminfo == nullptr)
+        {
+            return 0u;
+        }
+
+        char line[128];
+        size_t kilobytes = 0;
+        while (std::fgets(line, sizeof(line), meminfo) != nullptr)
+        {
+            if (std::sscanf(line, "Hugepagesize: %zu kB", &kilobytes) == 1)
+            {
+                break;
+            }
+        }
+
+        std::fclose(meminfo);
+        return kilobytes * 1024u;
+    }();
+    return size;
+#else
+    return 0u;
+#endif
+}
+
+int32_t NumaNodeCount()
+{
+#if defined(_WIN32)
+    ULONG highest = 0;
+    return GetNumaHighestNodeNumber(&highest) ? static_cast<int32_t>(highest) + 1 : 1;
+#elif defined(__linux__)
+    int32_t count = 0;
+    char path[64];
+    for (int32_t node = 0; node < 64; ++node)
+    {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/node/node%d", node);
+        if (access(path, F_OK) == 0)
+        {
+            count = node + 1;
+        }
+    }
+
+    return count > 0 ? count : 1;
+#else
+    return 1;
+#endif
+}
+
+int32_t NumaNodeForAffinity(uint64_t affinity_mask)
+{
+    if (affinity_mask == 0)
+    {
+        return -1;
+    }
+
+    int32_t cpu = 0;
+    while (((affinity_mask >> cpu) & 1u) == 0)
+    {
+        ++cpu;
+    }
+
+#if defined(_WIN32)
+    PROCESSOR_NUMBER processor{};
+    processor.Group = 0;
+    processor.Number = static_cast<BYTE>(cpu);
+    USHORT node = 0;
+    return GetNumaProcessorNodeEx(&processor, &node) && node != 0xFFFF ? static_cast<int32_t>(node) : -1;
+#elif defined(__linux__)
+    char path[64];
+    for (int32_t node = 0; node < 64; ++node)
+    {
+        std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/node%d", cpu, node);
+        if (access(path, F_OK) == 0)
+        {
+            return node;
+        }
+    }
+
+    return -1;
+#else
+    return -1;
+#endif
+}
+
+FrameBuffer::~FrameBuffer()
+{
+    Release();
+}
+
+FrameBuffer::FrameBuffer(FrameBuffer&& other) noexcept
+    : policy_(other.policy_),
+      charged_pool_(other.charged_pool_),
+      data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0u)),
+      mapped_(std::exchange(other.mapped_, 0u)),
+      kind_(std::exchange(other.kind_, FramePageKind::kNone)),
+      numa_bound_(std::exchange(other.numa_bound_, false))
+{
+}
+
+FrameBuffer& FrameBuffer::operator=(FrameBuffer&& other) noexcept
+{
+    if (this != &other)
+    {
+        Release();
+        policy_ = other.policy_;
+        charged_pool_ = other.charged_pool_;
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0u);
+        mapped_ = std::exchange(other.mapped_, 0u);
+        kind_ = std::exchange(other.kind_, FramePageKind::kNone);
+        numa_bound_ = std::exchange(other.numa_bound_, false);
+    }
+
+    return *this;
+}
+
+void FrameBuffer::assign(size_t size, uint8_t value)
+{
+    if (size != size_)
+    {
+        Release();
+        if (size == 0)
+        {
+            return;
+        }
+
+        auto& governor = MemoryGovernor::Instance();
+        if (!governor.TryReserve(policy_.pool, size))
+        {
+            throw FrameBudgetExceeded();
+        }
+
+        const auto large_page = policy_.large_pages ? LargePageSize() : 0u;
+        const bool want_large = large_page != 0 && size >= large_page / 2;
+        void* memory = nullptr;
+
+#if defined(_WIN32)
+        const DWORD node = policy_.numa_node >= 0 ? static_cast<DWORD>(policy_.numa_node) : NUMA_NO_PREFERRED_NODE;
+        if (want_large)
+        {
+            mapped_ = RoundUp(size, large_page);
+            memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, mapped_, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE, node);
+            kind_ = FramePageKind::kHuge;
+        }
+
+        if (memory == nullptr)
+        {
+            mapped_ = size;
+            memory = VirtualAllocExNuma(GetCurrentProcess(), nullptr, mapped_, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE, node);
+            kind_ = FramePageKind::kStandard;
+        }
+
+        numa_bound_ = memory != nullptr && policy_.numa_node >= 0;
+#elif defined(__linux__)
+        if (want_large)
+        {
+            mapped_ = RoundUp(size, large_page);
+            memory = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            memory = memory == MAP_FAILED ? nullptr : memory;
+            kind_ = FramePageKind::kHuge;
+        }
+
+        if (memory == nullptr)
+        {
+            // No reserved huge pages: ask for transparent huge pages instead, aligned so whole 2 MB extents can be promoted.
+            mapped_ = want_large ? RoundUp(size, large_page) : size;
+            memory = mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            memory = memory == MAP_FAILED ? nullptr : memory;
+            kind_ = want_large && memory != nullptr && madvise(memory, mapped_, MADV_HUGEPAGE) == 0 ? FramePageKind::kTransparentHuge : FramePageKind::kStandard;
+        }
+
+        numa_bound_ = memory != nullptr && BindToNode(memory, mapped_, policy_.numa_node);
+#else
+        mapped_ = size;
+        memory = ::operator new(size, std::align_val_t(4096), std::nothrow);
+        kind_ = FramePageKind::kStandard;
+#endif
+
+        if (memory == nullptr)
+        {
+            mapped_ = 0;
+            kind_ = FramePageKind::kNone;
+            numa_bound_ = false;
+            governor.Release(policy_.pool, size);
+            throw std::bad_alloc();
+        }
+
+        data_ = static_cast<uint8_t*>(memory);
+        charged_pool_ = policy_.pool;
+        size_ = size;
+    }
+
+    if (data_ != nullptr)
+    {
+        std::memset(data_, value, size_);
+    }
+}
+
+void FrameBuffer::clear()
+{
+    Release();
+}
+
+void FrameBuffer::Trim()
+{
+    Release(true);
+}
+
+void FrameBuffer::Release(bool idle)
+{
+    if (data_ != nullptr)
+    {
+        MemoryGovernor::Instance().Release(charged_pool_, size_, idle);
+#if defined(_WIN32)
+        VirtualFree(data_, 0, MEM_RELEASE);
+#elif defined(__linux__)
+        munmap(data_, mapped_);
+#else
+        ::operator delete(data_, std::align_val_t(4096), std::nothrow);
+#endif
+    }
+
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = 0;
+    kind_ = FramePageKind::kNone;
+    numa_bound_ = false;
+}
+} // namespace tractus
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "MemoryGovernor.h"
+
+namespace tractus
+{
+/// <summary>
+/// How the pages behind a <see cref="FrameBuffer"/> ended up being backed.
+/// </summary>
+enum class FramePageKind : int32_t
+{
+    kNone = 0,
+    /// <summary>Ordinary 4 KB pages.</summary>
+    kStandard = 1,
+    /// <summary>4 KB pages marked with <c>MADV_HUGEPAGE</c>; the kernel promotes them to 2 MB when it can.</summary>
+    kTransparentHuge = 2,
+    /// <summary>Explicit large pages (<c>MAP_HUGETLB</c>, or <c>MEM_LARGE_PAGES</c> on Windows).</summary>
+    kHuge = 3,
+};
+
+/// <summary>
+/// Where and how frame pools are allocated.
+/// </summary>
+struct FrameMemoryPolicy
+{
+    /// <summary>Prefer large pages for buffers of at least half a large page.</summary>
+    bool large_pages{false};
+    /// <summary>NUMA node the pages are bound to, or -1 to leave placement to the OS.</summary>
+    int32_t numa_node{-1};
+    /// <summary>The budget pool allocations are charged to.</summary>
+    MemoryPool pool{MemoryPool::kCapture};
+
+    bool operator==(const FrameMemoryPolicy& other) const
+    {
+        return large_pages == other.large_pages && numa_node == other.numa_node && pool == other.pool;
+    }
+
+    bool operator!=(const FrameMemoryPolicy& other) const { return !(*this == other); }
+};
+
+/// <summary>
+/// Returns the large page size, or 0 when the system has none the process can use.
+/// </summary>
+size_t LargePageSize();
+
+/// <summary>
+/// Returns the number of NUMA nodes, at least 1.
+/// </summary>
+int32_t NumaNodeCount();
+
+/// <summary>
+/// Returns the NUMA node of the lowest CPU in <paramref name="affinity_mask"/>, or -1 when the mask is zero or the
+/// node is unknown. Threads without an affinity can migrate between nodes, so there is nothing to bind to.
+/// </summary>
+int32_t NumaNodeForAffinity(uint64_t affinity_mask);
+
+/// <summary>
+/// Page-aligned pixel buffer for the helper's frame pools. It prefers large pages and a NUMA node when its policy
+/// asks for them and falls back to ordinary pages when the OS refuses. The interface mirrors the parts of
+/// <c>std::vector&lt;uint8_t&gt;</c> the pools use, and <c>assign</c> touches every page up front so the capture
+/// thread never takes a page fault mid-frame. Every allocation is charged to the policy's pool in the
+/// <see cref="MemoryGovernor"/>; one that would exceed the frame-memory budget throws <see cref="FrameBudgetExceeded"/>.
+/// </summary>
+class FrameBuffer
+{
+public:
+    FrameBuffer() = default;
+    explicit FrameBuffer(const FrameMemoryPolicy& policy) : policy_(policy) {}
+    ~FrameBuffer();
+
+    FrameBuffer(FrameBuffer&& other) noexcept;
+    FrameBuffer& operator=(FrameBuffer&& other) noexcept;
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator=(const FrameBuffer&) = delete;
+
+    /// <summary>
+    /// Sets the policy used by the next allocation; an existing allocation is kept until the size changes.
+    /// </summary>
+    void SetPolicy(const FrameMemoryPolicy& policy) { policy_ = policy; }
+
+    /// <summary>
+    /// Resizes to <paramref name="size"/> bytes, reallocating only when the size changes, and fills with
+    /// <paramref name="value"/>.
+    /// </summary>
+    /// <exception cref="FrameBudgetExceeded">The new size does not fit in the frame-memory budget.</exception>
+    void assign(size_t size, uint8_t value);
+
+    void clear();
+
+    /// <summary>
+    /// Frees the buffer because its pool went idle, reporting the bytes to the governor as trimmed.
+    /// </summary>
+    void Trim();
+
+    uint8_t* data() { return data_; }
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    FramePageKind page_kind() const { return kind_; }
+
+    /// <summary>Gets a value indicating whether the pages were bound to the policy's NUMA node.</summary>
+    bool numa_bound() const { return numa_bound_; }
+
+private:
+    void Release(bool idle = false);
+
+    FrameMemoryPolicy policy_;
+    MemoryPool charged_pool_{MemoryPool::kCapture};
+    uint8_t* data_{nullptr};
+    size_t size_{0};
+    size_t mapped_{0};
+    FramePageKind kind_{FramePageKind::kNone};
+    bool numa_bound_{false};
+};
+} // namespace tractus
@@ -0,0 +1,69 @@
+#include "FrameCopy.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_COPY_SSE2 1
+#else
+#define TRACTUS_COPY_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+/// <summary>
+/// How far ahead of the loads the source is prefetched: eight cache lines covers the memory latency at the rate one
+/// thread can stream. <c>_MM_HINT_NTA</c> was tried and halved throughput on a virtualised Xeon without sparing the
+/// workload's lines, since the source still passes through L2, so the source is prefetched normally.
+/// </summary>
+constexpr size_t kPrefetchDistance = 512;
+} // namespace
+
+void StreamCopy(uint8_t* destination, const uint8_t* source, size_t bytes)
+{
+#if TRACTUS_COPY_SSE2
+    // Streaming stores need an aligned destination; the source is read unaligned.
+    const auto misalignment = reinterpret_cast<uintptr_t>(destination) & 15u;
+    const auto head = misalignment == 0 ? size_t{0} : std::min<size_t>(bytes, 16u - misalignment);
+    std::memcpy(destination, source, head);
+
+    size_t offset = head;
+    for (; offset + 64u <= bytes; offset += 64u)
+    {
+        // Prefetching past the end of the frame is harmless: prefetches never fault.
+        _mm_prefetch(reinterpret_cast<const char*>(source + offset + kPrefetchDistance), _MM_HINT_T0);
+        const auto* s = reinterpret_cast<const __m128i*>(source + offset);
+        auto* d = reinterpret_cast<__m128i*>(destination + offset);
+        const auto a = _mm_loadu_si128(s);
+        const auto b = _mm_loadu_si128(s + 1);
+        const auto c = _mm_loadu_si128(s + 2);
+        const auto e = _mm_loadu_si128(s + 3);
+        _mm_stream_si128(d, a);
+        _mm_stream_si128(d + 1, b);
+        _mm_stream_si128(d + 2, c);
+        _mm_stream_si128(d + 3, e);
+    }
+
+    std::memcpy(destination + offset, source + offset, bytes - offset);
+
+    // Streaming stores are weakly ordered; without the fence a consumer on another core could see stale lines.
+    _mm_sfence();
+#else
+    std::memcpy(destination, source, bytes);
+#endif
+}
+
+void CopyFrame(uint8_t* destination, const uint8_t* source, size_t bytes)
+{
+    if (bytes >= kStreamingCopyThreshold)
+    {
+        StreamCopy(destination, source, bytes);
+        return;
+    }
+
+    std::memcpy(destination, source, bytes);
+}
+} // namespace tractus
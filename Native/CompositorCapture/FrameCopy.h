@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Copies at or above this size bypass the cache: about twice a per-core L2, so a 1080p BGRA frame (7.9 MB) and
+/// larger stream. Smaller copies mostly fit in cache and are often read again straight away, so they keep
+/// <c>memcpy</c>, which the <c>copy</c> benchmark found faster at 720p.
+/// </summary>
+constexpr size_t kStreamingCopyThreshold = 4u * 1024u * 1024u;
+
+/// <summary>
+/// Copies a whole frame. Frames of at least <see cref="kStreamingCopyThreshold"/> bytes are written with
+/// non-temporal stores behind a software prefetch of the source, so the destination never displaces the lines that
+/// Chromium's raster threads and the other sessions are working in, and no read-for-ownership traffic is spent on it. The destination is fenced before returning,
+/// so the frame can be handed to another thread straight away. The buffers must not overlap.
+/// </summary>
+void CopyFrame(uint8_t* destination, const uint8_t* source, size_t bytes);
+
+/// <summary>
+/// Copies with non-temporal stores regardless of size; the streaming half of <see cref="CopyFrame"/>. Falls back to
+/// <c>memcpy</c> on targets without SSE2.
+/// </summary>
+void StreamCopy(uint8_t* destination, const uint8_t* source, size_t bytes);
+} // namespace tractus
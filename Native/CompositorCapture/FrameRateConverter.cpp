@@ -0,0 +1,100 @@
+#include "FrameRateConverter.h"
+
+#include <cstddef>
+#include <numeric>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_BLEND_SSE2 1
+#else
+#define TRACTUS_BLEND_SSE2 0
+#endif
+
+namespace tractus
+{
+FrameRateConverter::FrameRateConverter(int32_t source_numerator, int32_t source_denominator, int32_t output_numerator,
+                                       int32_t output_denominator, RateConversionMode mode)
+    : mode_(mode)
+{
+    // Output frame k sits at source position k * (source rate / output rate). Keeping that ratio as a reduced
+    // fraction and advancing an integer remainder makes each step exact.
+    const auto source_num = static_cast<uint64_t>(source_numerator > 0 ? source_numerator : 1);
+    const auto source_den = static_cast<uint64_t>(source_denominator > 0 ? source_denominator : 1);
+    const auto output_num = static_cast<uint64_t>(output_numerator > 0 ? output_numerator : 1);
+    const auto output_den = static_cast<uint64_t>(output_denominator > 0 ? output_denominator : 1);
+
+    step_ = source_num * output_den;
+    modulus_ = source_den * output_num;
+    const auto divisor = std::gcd(step_, modulus_);
+    step_ /= divisor;
+    modulus_ /= divisor;
+}
+
+RateConversionStep FrameRateConverter::Next()
+{
+    RateConversionStep result{source_index_, 0u};
+    if (mode_ == RateConversionMode::kBlend)
+    {
+        const auto weight = static_cast<uint32_t>((remainder_ * 256u + modulus_ / 2u) / modulus_);
+        if (weight >= 256u)
+        {
+            result.source_index += 1u;
+        }
+        else
+        {
+            result.blend_weight = weight;
+        }
+    }
+    else if (remainder_ * 2u > modulus_)
+    {
+        // Ties keep the earlier frame so 30 -> 60 repeats each frame in place rather than running half a frame ahead.
+        result.source_index += 1u;
+    }
+
+    ++output_index_;
+    remainder_ += step_;
+    source_index_ += remainder_ / modulus_;
+    remainder_ %= modulus_;
+    return result;
+}
+
+void BlendFrames(const uint8_t* first, const uint8_t* second, uint8_t* destination, int32_t stride, int32_t width,
+                 int32_t first_row, int32_t end_row, uint32_t weight)
+{
+    const auto bytes = static_cast<size_t>(width) * 4u;
+    const auto first_weight = static_cast<uint16_t>(256u - weight);
+    const auto second_weight = static_cast<uint16_t>(weight);
+
+    for (int32_t y = first_row; y < end_row; ++y)
+    {
+        const auto offset = static_cast<size_t>(y) * stride;
+        const auto* a = first + offset;
+        const auto* b = second + offset;
+        auto* output = destination + offset;
+        size_t x = 0;
+
+#if TRACTUS_BLEND_SSE2
+        // a * (256 - w) + b * w + 128 peaks at 65408, so the whole sum stays in unsigned 16-bit lanes.
+        const auto zero = _mm_setzero_si128();
+        const auto wa = _mm_set1_epi16(static_cast<short>(first_weight));
+        const auto wb = _mm_set1_epi16(static_cast<short>(second_weight));
+        const auto round = _mm_set1_epi16(128);
+        for (; x + 16 <= bytes; x += 16)
+        {
+            const auto va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + x));
+            const auto vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + x));
+            auto low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, zero), wa), _mm_mullo_epi16(_mm_unpacklo_epi8(vb, zero), wb));
+            auto high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, zero), wa), _mm_mullo_epi16(_mm_unpackhi_epi8(vb, zero), wb));
+            low = _mm_srli_epi16(_mm_add_epi16(low, round), 8);
+            high = _mm_srli_epi16(_mm_add_epi16(high, round), 8);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x), _mm_packus_epi16(low, high));
+        }
+#endif
+
+        for (; x < bytes; ++x)
+        {
+            output[x] = static_cast<uint8_t>((a[x] * first_weight + b[x] * second_weight + 128u) >> 8);
+        }
+    }
+}
+} // namespace tractus
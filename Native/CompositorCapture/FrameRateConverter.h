@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Strategy used when the source and output frame rates are not equal.
+/// </summary>
+enum class RateConversionMode : int32_t
+{
+    /// <summary>Shows the source frame nearest to each output instant, repeating or dropping as needed.</summary>
+    kDropRepeat = 0,
+    /// <summary>Mixes the two source frames either side of each output instant by their phase.</summary>
+    kBlend = 1,
+};
+
+/// <summary>
+/// Describes which source frames make up one output frame.
+/// </summary>
+struct RateConversionStep
+{
+    /// <summary>Index of the first (or only) source frame.</summary>
+    uint64_t source_index;
+    /// <summary>Weight of <c>source_index + 1</c> out of 256; zero when the output is a plain copy.</summary>
+    uint32_t blend_weight;
+};
+
+/// <summary>
+/// Maps output frame indices onto source frame positions using exact rational arithmetic, so 59.94 from 60,
+/// 60 from 50 or 60 from 30 never drift no matter how long the session runs.
+/// </summary>
+class FrameRateConverter
+{
+public:
+    FrameRateConverter(int32_t source_numerator, int32_t source_denominator, int32_t output_numerator, int32_t output_denominator,
+                       RateConversionMode mode);
+
+    /// <summary>Gets a value indicating whether every output frame maps to exactly one new source frame.</summary>
+    bool IsIdentity() const { return step_ == modulus_; }
+
+    /// <summary>Gets the number of output frames produced so far.</summary>
+    uint64_t OutputIndex() const { return output_index_; }
+
+    /// <summary>
+    /// Returns the source frames for the next output frame and advances the output position.
+    /// </summary>
+    RateConversionStep Next();
+
+private:
+    RateConversionMode mode_;
+    uint64_t step_;
+    uint64_t modulus_;
+    uint64_t source_index_{0};
+    uint64_t remainder_{0};
+    uint64_t output_index_{0};
+};
+
+/// <summary>
+/// Writes <c>(first * (256 - weight) + second * weight) / 256</c> for rows [<paramref name="first_row"/>,
+/// <paramref name="end_row"/>) of two BGRA frames that share a stride.
+/// </summary>
+void BlendFrames(const uint8_t* first, const uint8_t* second, uint8_t* destination, int32_t stride, int32_t width,
+                 int32_t first_row, int32_t end_row, uint32_t weight);
+} // namespace tractus
@@ -0,0 +1,306 @@
+#include "FrameScaler.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_SCALER_SSE2 1
+#else
+#define TRACTUS_SCALER_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr int32_t kWeightBits = 14;
+constexpr int32_t kWeightOne = 1 << kWeightBits;
+// Horizontal results keep 6 fractional bits (pixel * 64) so Lanczos overshoot still fits in int16.
+constexpr int32_t kHorizontalShift = 8;
+constexpr int32_t kVerticalShift = kWeightBits * 2 - kHorizontalShift;
+constexpr int32_t kBandRows = 32;
+
+constexpr double kPi = 3.14159265358979323846;
+
+double Sinc(double x)
+{
+    if (x == 0.0)
+    {
+        return 1.0;
+    }
+
+    const auto px = kPi * x;
+    return std::sin(px) / px;
+}
+
+double FilterRadius(ScaleFilter filter)
+{
+    return filter == ScaleFilter::kLanczos3 ? 3.0 : 1.0;
+}
+
+double EvaluateKernel(ScaleFilter filter, double x)
+{
+    x = std::fabs(x);
+    if (filter == ScaleFilter::kLanczos3)
+    {
+        return x < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0;
+    }
+
+    return x < 1.0 ? 1.0 - x : 0.0;
+}
+
+uint8_t ClampToByte(int32_t value)
+{
+    return static_cast<uint8_t>(std::min(255, std::max(0, value)));
+}
+
+int16_t ClampToInt16(int32_t value)
+{
+    return static_cast<int16_t>(std::min(32767, std::max(-32768, value)));
+}
+
+/// <summary>
+/// Scratch rows reused by every band a thread processes so steady-state scaling never allocates.
+/// </summary>
+thread_local std::vector<int16_t> ring_storage;
+} // namespace
+
+FrameScaler::FrameScaler(int32_t source_width, int32_t source_height, int32_t destination_width, int32_t destination_height, ScaleFilter filter)
+    : source_width_(std::max(1, source_width)),
+      source_height_(std::max(1, source_height)),
+      destination_width_(std::max(1, destination_width)),
+      destination_height_(std::max(1, destination_height)),
+      filter_(filter)
+{
+    horizontal_ = BuildFilterBank(source_width_, destination_width_, filter_);
+    vertical_ = BuildFilterBank(source_height_, destination_height_, filter_);
+}
+
+FrameScaler::FilterBank FrameScaler::BuildFilterBank(int32_t source_size, int32_t destination_size, ScaleFilter filter)
+{
+    const auto scale = static_cast<double>(source_size) / destination_size;
+    const auto filter_scale = std::max(1.0, scale);
+    const auto half_width = FilterRadius(filter) * filter_scale;
+
+    FilterBank bank;
+    bank.taps = static_cast<int32_t>(std::floor(half_width * 2.0)) + 2;
+    bank.taps += bank.taps & 1;
+    bank.taps = std::min(bank.taps, source_size);
+    bank.starts.resize(destination_size);
+    bank.weights.assign(static_cast<size_t>(destination_size) * bank.taps, 0);
+
+    std::vector<double> accumulated(source_size);
+    for (int32_t i = 0; i < destination_size; ++i)
+    {
+        const auto center = (i + 0.5) * scale - 0.5;
+        const auto left = static_cast<int32_t>(std::ceil(center - half_width));
+        const auto right = static_cast<int32_t>(std::floor(center + half_width));
+
+        // Fold samples that fall outside the frame onto the edge pixels (clamp-to-edge addressing).
+        auto low = std::min(source_size - 1, std::max(0, left));
+        auto high = std::min(source_size - 1, std::max(0, right));
+        std::fill(accumulated.begin() + low, accumulated.begin() + high + 1, 0.0);
+        double sum = 0.0;
+        for (int32_t j = left; j <= right; ++j)
+        {
+            const auto weight = EvaluateKernel(filter, (j - center) / filter_scale);
+            accumulated[std::min(source_size - 1, std::max(0, j))] += weight;
+            sum += weight;
+        }
+
+        if (left > right || sum == 0.0)
+        {
+            low = high = std::min(source_size - 1, std::max(0, static_cast<int32_t>(std::lround(center))));
+            accumulated[low] = 1.0;
+            sum = 1.0;
+        }
+
+        auto start = std::min(low, source_size - bank.taps);
+        start = std::max(0, start);
+        bank.starts[i] = start;
+
+        auto* weights = bank.weights.data() + static_cast<size_t>(i) * bank.taps;
+        int32_t fixed_sum = 0;
+        int32_t largest = 0;
+        for (int32_t j = low; j <= high && j - start < bank.taps; ++j)
+        {
+            const auto tap = j - start;
+            weights[tap] = static_cast<int16_t>(std::lround(accumulated[j] / sum * kWeightOne));
+            fixed_sum += weights[tap];
+            if (std::abs(weights[tap]) > std::abs(weights[largest]))
+            {
+                largest = tap;
+            }
+        }
+
+        // Push the rounding residue into the dominant tap so flat fields stay exactly flat.
+        weights[largest] = static_cast<int16_t>(weights[largest] + (kWeightOne - fixed_sum));
+    }
+
+    if ((bank.taps & 1) == 0)
+    {
+        bank.weight_pairs.resize(bank.weights.size() / 2);
+        for (size_t p = 0; p < bank.weight_pairs.size(); ++p)
+        {
+            const auto low_weight = static_cast<uint16_t>(bank.weights[p * 2]);
+            const auto high_weight = static_cast<uint16_t>(bank.weights[p * 2 + 1]);
+            bank.weight_pairs[p] = static_cast<int32_t>(static_cast<uint32_t>(high_weight) << 16 | low_weight);
+        }
+    }
+
+    return bank;
+}
+
+void FrameScaler::Scale(const uint8_t* source, int32_t source_stride, uint8_t* destination, int32_t destination_stride,
+                        FrameTaskScheduler* scheduler, FrameTaskClock::time_point due) const
+{
+    if (source == nullptr || destination == nullptr)
+    {
+        return;
+    }
+
+    if (scheduler == nullptr)
+    {
+        ScaleRows(source, source_stride, destination, destination_stride, 0, destination_height_);
+        return;
+    }
+
+    scheduler->ParallelFor(static_cast<size_t>(destination_height_), kBandRows, due, [&](size_t begin, size_t end)
+    {
+        ScaleRows(source, source_stride, destination, destination_stride, static_cast<int32_t>(begin), static_cast<int32_t>(end));
+    });
+}
+
+void FrameScaler::ScaleRows(const uint8_t* source, int32_t source_stride, uint8_t* destination, int32_t destination_stride,
+                            int32_t first_row, int32_t end_row) const
+{
+    first_row = std::max(0, first_row);
+    end_row = std::min(destination_height_, end_row);
+    if (first_row >= end_row)
+    {
+        return;
+    }
+
+    // The ring only has to hold one vertical window because filter starts never move backwards.
+    const auto ring_rows = vertical_.taps;
+    const auto row_values = static_cast<size_t>(destination_width_) * 4u;
+    ring_storage.resize(row_values * ring_rows + 8u);
+
+    std::vector<const int16_t*> window(ring_rows);
+    auto next_source_row = vertical_.starts[first_row];
+    for (int32_t y = first_row; y < end_row; ++y)
+    {
+        const auto start = vertical_.starts[y];
+        next_source_row = std::max(next_source_row, start);
+        for (; next_source_row < start + ring_rows; ++next_source_row)
+        {
+            auto* slot = ring_storage.data() + static_cast<size_t>(next_source_row % ring_rows) * row_values;
+            FilterRowHorizontal(source + static_cast<size_t>(next_source_row) * source_stride, slot);
+        }
+
+        for (int32_t k = 0; k < ring_rows; ++k)
+        {
+            window[k] = ring_storage.data() + static_cast<size_t>((start + k) % ring_rows) * row_values;
+        }
+
+        FilterRowVertical(window.data(), y, destination + static_cast<size_t>(y) * destination_stride);
+    }
+}
+
+void FrameScaler::FilterRowHorizontal(const uint8_t* source_row, int16_t* output) const
+{
+    const auto taps = horizontal_.taps;
+    const auto rounding = 1 << (kHorizontalShift - 1);
+
+#if TRACTUS_SCALER_SSE2
+    if (!horizontal_.weight_pairs.empty())
+    {
+        const auto zero = _mm_setzero_si128();
+        const auto round = _mm_set1_epi32(rounding);
+        const auto pairs_per_pixel = taps / 2;
+        for (int32_t x = 0; x < destination_width_; ++x)
+        {
+            const auto* pixels = source_row + static_cast<size_t>(horizontal_.starts[x]) * 4u;
+            const auto* pairs = horizontal_.weight_pairs.data() + static_cast<size_t>(x) * pairs_per_pixel;
+            auto sum = round;
+            for (int32_t p = 0; p < pairs_per_pixel; ++p)
+            {
+                // Interleave two neighbouring BGRA pixels channel by channel so one madd applies both taps.
+                const auto two = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(pixels + p * 8));
+                const auto interleaved = _mm_unpacklo_epi8(_mm_unpacklo_epi8(two, _mm_srli_si128(two, 4)), zero);
+                sum = _mm_add_epi32(sum, _mm_madd_epi16(interleaved, _mm_set1_epi32(pairs[p])));
+            }
+
+            const auto packed = _mm_packs_epi32(_mm_srai_epi32(sum, kHorizontalShift), zero);
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + static_cast<size_t>(x) * 4u), packed);
+        }
+
+        return;
+    }
+#endif
+
+    for (int32_t x = 0; x < destination_width_; ++x)
+    {
+        const auto* pixels = source_row + static_cast<size_t>(horizontal_.starts[x]) * 4u;
+        const auto* weights = horizontal_.weights.data() + static_cast<size_t>(x) * taps;
+        int32_t sum[4] = {rounding, rounding, rounding, rounding};
+        for (int32_t t = 0; t < taps; ++t)
+        {
+            for (int c = 0; c < 4; ++c)
+            {
+                sum[c] += weights[t] * pixels[t * 4 + c];
+            }
+        }
+
+        for (int c = 0; c < 4; ++c)
+        {
+            output[x * 4 + c] = ClampToInt16(sum[c] >> kHorizontalShift);
+        }
+    }
+}
+
+void FrameScaler::FilterRowVertical(const int16_t* const* rows, int32_t destination_row, uint8_t* output) const
+{
+    const auto taps = vertical_.taps;
+    const auto values = destination_width_ * 4;
+    const auto rounding = 1 << (kVerticalShift - 1);
+    const auto* weights = vertical_.weights.data() + static_cast<size_t>(destination_row) * taps;
+    int32_t x = 0;
+
+#if TRACTUS_SCALER_SSE2
+    if (!vertical_.weight_pairs.empty())
+    {
+        const auto round = _mm_set1_epi32(rounding);
+        const auto* pairs = vertical_.weight_pairs.data() + static_cast<size_t>(destination_row) * (taps / 2);
+        for (; x + 8 <= values; x += 8)
+        {
+            auto low = round;
+            auto high = round;
+            for (int32_t p = 0; p < taps / 2; ++p)
+            {
+                const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[p * 2] + x));
+                const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[p * 2 + 1] + x));
+                const auto weight = _mm_set1_epi32(pairs[p]);
+                low = _mm_add_epi32(low, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weight));
+                high = _mm_add_epi32(high, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), weight));
+            }
+
+            const auto words = _mm_packs_epi32(_mm_srai_epi32(low, kVerticalShift), _mm_srai_epi32(high, kVerticalShift));
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(output + x), _mm_packus_epi16(words, words));
+        }
+    }
+#endif
+
+    for (; x < values; ++x)
+    {
+        int32_t sum = rounding;
+        for (int32_t t = 0; t < taps; ++t)
+        {
+            sum += weights[t] * rows[t][x];
+        }
+
+        output[x] = ClampToByte(sum >> kVerticalShift);
+    }
+}
+} // namespace tractus
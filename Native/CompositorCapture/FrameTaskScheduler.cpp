@@ -0,0 +1,322 @@
+#include "FrameTaskScheduler.h"
+
+#include <algorithm>
+
+namespace tractus
+{
+namespace
+{
+/// <summary>
+/// Identifies the scheduler and queue owned by the current worker thread so nested submissions stay local.
+/// </summary>
+struct WorkerIdentity
+{
+    const FrameTaskScheduler* scheduler;
+    size_t index;
+};
+
+thread_local WorkerIdentity current_worker{nullptr, 0};
+
+std::mutex shared_scheduler_mutex;
+std::weak_ptr<FrameTaskScheduler> shared_scheduler;
+
+size_t PriorityIndex(FrameTaskPriority priority)
+{
+    return static_cast<size_t>(priority);
+}
+} // namespace
+
+FrameTaskScheduler::FrameTaskScheduler(size_t worker_count)
+{
+    worker_count = std::max<size_t>(1, worker_count);
+    queues_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        queues_.push_back(std::make_unique<WorkerQueues>());
+    }
+
+    workers_.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+    {
+        workers_.emplace_back([this, i]() { RunWorker(i); });
+    }
+}
+
+FrameTaskScheduler::~FrameTaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        stopping_.store(true);
+    }
+
+    idle_cv_.notify_all();
+    for (auto& worker : workers_)
+    {
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+    }
+}
+
+std::shared_ptr<FrameTaskScheduler> FrameTaskScheduler::AcquireShared()
+{
+    std::lock_guard<std::mutex> lock(shared_scheduler_mutex);
+    auto scheduler = shared_scheduler.lock();
+    if (!scheduler)
+    {
+        scheduler = std::make_shared<FrameTaskScheduler>(std::thread::hardware_concurrency());
+        shared_scheduler = scheduler;
+    }
+
+    return scheduler;
+}
+
+void FrameTaskScheduler::SubmitDeadline(Task task, FrameTaskClock::time_point due)
+{
+    {
+        std::lock_guard<std::mutex> lock(deadline_mutex_);
+        deadline_heap_.push_back(DeadlineTask{std::move(task), due, deadline_sequence_++});
+        std::push_heap(deadline_heap_.begin(), deadline_heap_.end(), DeadlineLater);
+    }
+
+    submitted_[PriorityIndex(FrameTaskPriority::kDeadline)].value.fetch_add(1, std::memory_order_relaxed);
+    NotifyWork();
+}
+
+void FrameTaskScheduler::Submit(Task task, FrameTaskPriority priority)
+{
+    if (priority == FrameTaskPriority::kDeadline)
+    {
+        SubmitDeadline(std::move(task), FrameTaskClock::now());
+        return;
+    }
+
+    size_t index;
+    if (current_worker.scheduler == this)
+    {
+        index = current_worker.index;
+    }
+    else
+    {
+        index = next_queue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    {
+        auto& queues = *queues_[index];
+        std::lock_guard<std::mutex> lock(queues.mutex);
+        auto& target = priority == FrameTaskPriority::kBackground ? queues.background : queues.normal;
+        target.push_back(std::move(task));
+    }
+
+    submitted_[PriorityIndex(priority)].value.fetch_add(1, std::memory_order_relaxed);
+    NotifyWork();
+}
+
+void FrameTaskScheduler::ParallelFor(size_t count, size_t grain, FrameTaskClock::time_point due, const std::function<void(size_t begin, size_t end)>& body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+
+    grain = std::max<size_t>(1, grain);
+    const auto chunks = (count + grain - 1) / grain;
+    if (chunks == 1)
+    {
+        body(0, count);
+        return;
+    }
+
+    struct Group
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> completed{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+
+    auto group = std::make_shared<Group>();
+    const auto chunk_count = chunks;
+    auto drain = [group, chunk_count, count, grain, &body]()
+    {
+        size_t finished = 0;
+        for (auto chunk = group->next.fetch_add(1); chunk < chunk_count; chunk = group->next.fetch_add(1))
+        {
+            const auto begin = chunk * grain;
+            body(begin, std::min(count, begin + grain));
+            ++finished;
+        }
+
+        if (finished > 0 && group->completed.fetch_add(finished) + finished == chunk_count)
+        {
+            std::lock_guard<std::mutex> lock(group->mutex);
+            group->done.notify_all();
+        }
+    };
+
+    // Helpers capture body by reference; the wait below keeps it alive until every chunk has completed,
+    // and helpers that start late observe next >= chunk_count without touching body.
+    const auto helpers = std::min(chunks - 1, workers_.size());
+    for (size_t i = 0; i < helpers; ++i)
+    {
+        SubmitDeadline(drain, due);
+    }
+
+    drain();
+
+    std::unique_lock<std::mutex> lock(group->mutex);
+    group->done.wait(lock, [&]() { return group->completed.load() == chunk_count; });
+}
+
+FrameTaskSchedulerStats FrameTaskScheduler::GetStats() const
+{
+    FrameTaskSchedulerStats stats{};
+    for (size_t i = 0; i < 3; ++i)
+    {
+        stats.submitted[i] = submitted_[i].value.load(std::memory_order_relaxed);
+        stats.executed[i] = executed_[i].value.load(std::memory_order_relaxed);
+    }
+
+    stats.steals = steals_.value.load(std::memory_order_relaxed);
+    stats.deadline_misses = deadline_misses_.value.load(std::memory_order_relaxed);
+    stats.worker_count = static_cast<uint32_t>(workers_.size());
+    return stats;
+}
+
+void FrameTaskScheduler::RunWorker(size_t index)
+{
+    current_worker = WorkerIdentity{this, index};
+
+    while (true)
+    {
+        if (TryRunOne(index))
+        {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(idle_mutex_);
+        idle_cv_.wait(lock, [this]() { return stopping_.load() || pending_.load() > 0; });
+        if (stopping_.load() && pending_.load() <= 0)
+        {
+            break;
+        }
+    }
+
+    current_worker = WorkerIdentity{nullptr, 0};
+}
+
+bool FrameTaskScheduler::TryRunOne(size_t index)
+{
+    DeadlineTask deadline;
+    if (TryPopDeadline(deadline))
+    {
+        if (FrameTaskClock::now() > deadline.due)
+        {
+            deadline_misses_.value.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        Execute(deadline.task, FrameTaskPriority::kDeadline);
+        return true;
+    }
+
+    Task task;
+    for (const auto priority : {FrameTaskPriority::kNormal, FrameTaskPriority::kBackground})
+    {
+        if (TryPopLocal(index, priority, task) || TrySteal(index, priority, task))
+        {
+            Execute(task, priority);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool FrameTaskScheduler::TryPopDeadline(DeadlineTask& out)
+{
+    std::lock_guard<std::mutex> lock(deadline_mutex_);
+    if (deadline_heap_.empty())
+    {
+        return false;
+    }
+
+    std::pop_heap(deadline_heap_.begin(), deadline_heap_.end(), DeadlineLater);
+    out = std::move(deadline_heap_.back());
+    deadline_heap_.pop_back();
+    return true;
+}
+
+bool FrameTaskScheduler::TryPopLocal(size_t index, FrameTaskPriority priority, Task& out)
+{
+    auto& queues = *queues_[index];
+    std::lock_guard<std::mutex> lock(queues.mutex);
+    auto& source = priority == FrameTaskPriority::kBackground ? queues.background : queues.normal;
+    if (source.empty())
+    {
+        return false;
+    }
+
+    out = std::move(source.back());
+    source.pop_back();
+    return true;
+}
+
+bool FrameTaskScheduler::TrySteal(size_t thief, FrameTaskPriority priority, Task& out)
+{
+    const auto count = queues_.size();
+    for (size_t offset = 1; offset < count; ++offset)
+    {
+        auto& victim = *queues_[(thief + offset) % count];
+        std::unique_lock<std::mutex> lock(victim.mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            continue;
+        }
+
+        auto& source = priority == FrameTaskPriority::kBackground ? victim.background : victim.normal;
+        if (source.empty())
+        {
+            continue;
+        }
+
+        out = std::move(source.front());
+        source.pop_front();
+        steals_.value.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    return false;
+}
+
+void FrameTaskScheduler::Execute(Task& task, FrameTaskPriority priority)
+{
+    pending_.fetch_sub(1);
+    if (task)
+    {
+        task();
+    }
+
+    executed_[PriorityIndex(priority)].value.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameTaskScheduler::NotifyWork()
+{
+    {
+        std::lock_guard<std::mutex> lock(idle_mutex_);
+        pending_.fetch_add(1);
+    }
+
+    idle_cv_.notify_one();
+}
+
+bool FrameTaskScheduler::DeadlineLater(const DeadlineTask& left, const DeadlineTask& right)
+{
+    if (left.due != right.due)
+    {
+        return left.due > right.due;
+    }
+
+    return left.sequence > right.sequence;
+}
+} // namespace tractus
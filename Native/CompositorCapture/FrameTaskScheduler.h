@@ -0,0 +1,152 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+/// <summary>
+/// Clock used to express frame deadlines for scheduled work.
+/// </summary>
+using FrameTaskClock = std::chrono::steady_clock;
+
+/// <summary>
+/// Scheduling class for per-frame jobs. Deadline jobs always run before normal and background jobs.
+/// </summary>
+enum class FrameTaskPriority : uint8_t
+{
+    /// <summary>Deadline-critical work such as conversion for the next frame; executed earliest-deadline-first.</summary>
+    kDeadline = 0,
+    /// <summary>Regular per-frame work such as hashing or statistics.</summary>
+    kNormal = 1,
+    /// <summary>Throughput work such as recording that may lag behind the output cadence.</summary>
+    kBackground = 2,
+};
+
+/// <summary>
+/// Aggregate counters describing scheduler behaviour since creation.
+/// </summary>
+struct FrameTaskSchedulerStats
+{
+    uint64_t submitted[3];
+    uint64_t executed[3];
+    uint64_t steals;
+    uint64_t deadline_misses;
+    uint32_t worker_count;
+};
+
+/// <summary>
+/// Work-stealing scheduler shared by every capture session in the process. Each worker owns a pair of
+/// deques (normal and background) that it drains LIFO while idle workers steal FIFO from their peers.
+/// Deadline jobs bypass the deques and sit in a shared earliest-deadline-first lane that every worker
+/// checks before touching its own queue.
+/// </summary>
+class FrameTaskScheduler
+{
+public:
+    using Task = std::function<void()>;
+
+    /// <summary>
+    /// Creates a scheduler with the requested number of worker threads (at least one).
+    /// </summary>
+    explicit FrameTaskScheduler(size_t worker_count);
+
+    /// <summary>
+    /// Drains outstanding work and joins every worker thread.
+    /// </summary>
+    ~FrameTaskScheduler();
+
+    FrameTaskScheduler(const FrameTaskScheduler&) = delete;
+    FrameTaskScheduler& operator=(const FrameTaskScheduler&) = delete;
+
+    /// <summary>
+    /// Returns the process-wide scheduler, creating it with one worker per hardware thread on first use.
+    /// The scheduler is destroyed when the last session releases its reference.
+    /// </summary>
+    static std::shared_ptr<FrameTaskScheduler> AcquireShared();
+
+    /// <summary>
+    /// Queues a deadline-critical job. Jobs with earlier due times run first regardless of submission order.
+    /// </summary>
+    void SubmitDeadline(Task task, FrameTaskClock::time_point due);
+
+    /// <summary>
+    /// Queues a normal or background job. Jobs submitted from a worker land on that worker's own deque;
+    /// jobs submitted from other threads are distributed round-robin.
+    /// </summary>
+    void Submit(Task task, FrameTaskPriority priority = FrameTaskPriority::kNormal);
+
+    /// <summary>
+    /// Splits <paramref name="count"/> items into chunks of <paramref name="grain"/> and runs them on the
+    /// deadline lane. The calling thread participates and the call returns once every chunk has completed,
+    /// so progress is guaranteed even when all workers are busy.
+    /// </summary>
+    void ParallelFor(size_t count, size_t grain, FrameTaskClock::time_point due, const std::function<void(size_t begin, size_t end)>& body);
+
+    /// <summary>
+    /// Gets the number of worker threads.
+    /// </summary>
+    size_t WorkerCount() const { return workers_.size(); }
+
+    /// <summary>
+    /// Captures a snapshot of the scheduler counters.
+    /// </summary>
+    FrameTaskSchedulerStats GetStats() const;
+
+private:
+    struct DeadlineTask
+    {
+        Task task;
+        FrameTaskClock::time_point due;
+        uint64_t sequence;
+    };
+
+    struct alignas(64) WorkerQueues
+    {
+        std::mutex mutex;
+        std::deque<Task> normal;
+        std::deque<Task> background;
+    };
+
+    struct alignas(64) Counter
+    {
+        std::atomic<uint64_t> value{0};
+    };
+
+    void RunWorker(size_t index);
+    bool TryRunOne(size_t index);
+    bool TryPopDeadline(DeadlineTask& out);
+    bool TryPopLocal(size_t index, FrameTaskPriority priority, Task& out);
+    bool TrySteal(size_t thief, FrameTaskPriority priority, Task& out);
+    void Execute(Task& task, FrameTaskPriority priority);
+    void NotifyWork();
+    static bool DeadlineLater(const DeadlineTask& left, const DeadlineTask& right);
+
+    std::vector<std::unique_ptr<WorkerQueues>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::mutex deadline_mutex_;
+    std::vector<DeadlineTask> deadline_heap_;
+    uint64_t deadline_sequence_{0};
+
+    std::mutex idle_mutex_;
+    std::condition_variable idle_cv_;
+    std::atomic<int64_t> pending_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<size_t> next_queue_{0};
+
+    Counter submitted_[3];
+    Counter executed_[3];
+    Counter steals_;
+    Counter deadline_misses_;
+};
+} // namespace tractus
@@ -0,0 +1,410 @@
+#include "LayerCompositor.h"
+
+#include "TelemetryCounters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_LAYER_SSE2 1
+#else
+#define TRACTUS_LAYER_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr uint64_t kNeverComposed = UINT64_MAX;
+
+/// <summary>
+/// Classifies one tile by its alpha channel.
+/// </summary>
+TileCoverage ClassifyTile(const uint8_t* pixels, int32_t stride, int32_t width, int32_t height)
+{
+    bool any_visible = false;
+    bool all_opaque = true;
+    for (int32_t y = 0; y < height && (all_opaque || !any_visible); ++y)
+    {
+        const auto* row = pixels + static_cast<size_t>(y) * stride;
+        int32_t x = 0;
+#if TRACTUS_LAYER_SSE2
+        const auto alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+        auto any = _mm_setzero_si128();
+        auto all = alpha_mask;
+        for (; x + 4 <= width; x += 4)
+        {
+            const auto alpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row + static_cast<size_t>(x) * 4u)), alpha_mask);
+            any = _mm_or_si128(any, alpha);
+            all = _mm_and_si128(all, alpha);
+        }
+
+        any_visible = any_visible || _mm_movemask_epi8(_mm_cmpeq_epi32(any, _mm_setzero_si128())) != 0xFFFF;
+        all_opaque = all_opaque && _mm_movemask_epi8(_mm_cmpeq_epi32(all, alpha_mask)) == 0xFFFF;
+#endif
+        for (; x < width; ++x)
+        {
+            const auto alpha = row[static_cast<size_t>(x) * 4u + 3u];
+            any_visible = any_visible || alpha != 0;
+            all_opaque = all_opaque && alpha == 0xFF;
+        }
+    }
+
+    if (all_opaque)
+    {
+        return TileCoverage::kOpaque;
+    }
+
+    return any_visible ? TileCoverage::kMixed : TileCoverage::kTransparent;
+}
+} // namespace
+
+void BlendPremultipliedRow(const uint8_t* source, uint8_t* destination, int32_t pixels)
+{
+    int32_t x = 0;
+
+#if TRACTUS_LAYER_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto rounding = _mm_set1_epi16(128);
+    const auto alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    for (; x + 4 <= pixels; x += 4)
+    {
+        const auto offset = static_cast<size_t>(x) * 4u;
+        const auto s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+        const auto alpha = _mm_and_si128(s, alpha_mask);
+        const auto transparent = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero));
+        if (transparent == 0xFFFF)
+        {
+            continue;
+        }
+
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alpha_mask)) == 0xFFFF)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), s);
+            continue;
+        }
+
+        // Broadcast each pixel's alpha to its four bytes, then invert to get 255 - a.
+        auto a = _mm_srli_epi32(s, 24);
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 8));
+        a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+        const auto inverse = _mm_xor_si128(a, _mm_set1_epi32(-1));
+
+        const auto d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(destination + offset));
+        auto low = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(inverse, zero)), rounding);
+        auto high = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(inverse, zero)), rounding);
+        low = _mm_srli_epi16(_mm_add_epi16(low, _mm_srli_epi16(low, 8)), 8);
+        high = _mm_srli_epi16(_mm_add_epi16(high, _mm_srli_epi16(high, 8)), 8);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + offset), _mm_adds_epu8(s, _mm_packus_epi16(low, high)));
+    }
+#endif
+
+    for (; x < pixels; ++x)
+    {
+        const auto* s = source + static_cast<size_t>(x) * 4u;
+        auto* d = destination + static_cast<size_t>(x) * 4u;
+        const auto inverse = 255u - s[3];
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto value = d[c] * inverse + 128u;
+            d[c] = static_cast<uint8_t>(std::min(255u, s[c] + ((value + (value >> 8)) >> 8)));
+        }
+    }
+}
+
+LayerCompositor::LayerCompositor(int32_t width, int32_t height, const FrameMemoryPolicy& memory_policy)
+    : width_(std::max(0, width)),
+      height_(std::max(0, height)),
+      tiles_x_((width_ + kTileSize - 1) / kTileSize),
+      tiles_y_((height_ + kTileSize - 1) / kTileSize),
+      memory_policy_(memory_policy)
+{
+}
+
+int32_t LayerCompositor::AddLayer(int32_t z_order, int32_t delay_frames)
+{
+    const auto index = LayerCount();
+    if (index >= kMaxLayers)
+    {
+        return -1;
+    }
+
+    const auto tiles = static_cast<size_t>(tiles_x_) * tiles_y_;
+    auto layer = std::make_unique<Layer>();
+    layer->z_order = z_order;
+    layer->delay_frames = std::max(0, delay_frames);
+    // One slot for each frame of delay, one for the newest frame and one for the frame being written while the
+    // compositor reads.
+    layer->slots.resize(static_cast<size_t>(layer->delay_frames) + 2u);
+    for (auto& slot : layer->slots)
+    {
+        slot.pixels.SetPolicy(memory_policy_);
+        slot.pixels.assign(static_cast<size_t>(width_) * height_ * 4u, 0u);
+        slot.coverage.assign(tiles, TileCoverage::kTransparent);
+        slot.versions.assign(tiles, 0u);
+    }
+
+    layer->composed_versions.assign(tiles, kNeverComposed);
+    layers_[index] = std::move(layer);
+    layer_count_.store(index + 1);
+
+    order_.push_back(index);
+    std::stable_sort(order_.begin(), order_.end(), [this](int32_t a, int32_t b) { return layers_[a]->z_order < layers_[b]->z_order; });
+    return index;
+}
+
+bool LayerCompositor::Submit(int32_t index, const uint8_t* pixels, int32_t stride, int64_t capture_microseconds)
+{
+    if (index < 0 || index >= LayerCount() || pixels == nullptr)
+    {
+        return false;
+    }
+
+    auto& layer = *layers_[index];
+    std::lock_guard<std::mutex> lock(layer.mutex);
+    const auto slot_count = static_cast<int32_t>(layer.slots.size());
+    const auto next = (layer.newest + 1) % slot_count;
+    if (next == layer.reading)
+    {
+        ++layer.dropped;
+        return false;
+    }
+
+    const Slot* previous = layer.newest >= 0 ? &layer.slots[layer.newest] : nullptr;
+    auto& slot = layer.slots[next];
+    const auto sequence = ++layer.sequence;
+    const auto slot_stride = static_cast<size_t>(width_) * 4u;
+    for (int32_t tile_y = 0; tile_y < tiles_y_; ++tile_y)
+    {
+        const auto y0 = tile_y * kTileSize;
+        const auto rows = std::min(kTileSize, height_ - y0);
+        for (int32_t tile_x = 0; tile_x < tiles_x_; ++tile_x)
+        {
+            const auto tile = static_cast<size_t>(tile_y) * tiles_x_ + tile_x;
+            const auto x0 = static_cast<size_t>(tile_x) * kTileSize * 4u;
+            const auto bytes = static_cast<size_t>(std::min(kTileSize, width_ - tile_x * kTileSize)) * 4u;
+            const auto* source = pixels + static_cast<size_t>(y0) * stride + x0;
+            auto* destination = slot.pixels.data() + static_cast<size_t>(y0) * slot_stride + x0;
+
+            bool changed = previous == nullptr;
+            for (int32_t row = 0; row < rows && !changed; ++row)
+            {
+                changed = std::memcmp(source + static_cast<size_t>(row) * stride, previous->pixels.data() + (static_cast<size_t>(y0 + row) * slot_stride + x0), bytes) != 0;
+            }
+
+            for (int32_t row = 0; row < rows; ++row)
+            {
+                std::memcpy(destination + static_cast<size_t>(row) * slot_stride, source + static_cast<size_t>(row) * stride, bytes);
+            }
+
+            slot.versions[tile] = changed ? sequence : previous->versions[tile];
+            slot.coverage[tile] = changed ? ClassifyTile(source, stride, static_cast<int32_t>(bytes / 4u), rows) : previous->coverage[tile];
+        }
+    }
+
+    slot.capture_microseconds = capture_microseconds;
+    layer.newest = next;
+    layer.filled = std::min(layer.filled + 1, slot_count);
+    ++layer.submitted;
+    return true;
+}
+
+void LayerCompositor::Compose(uint8_t* output, int32_t stride, int64_t now_microseconds, FrameTaskScheduler* scheduler, FrameTaskClock::time_point due)
+{
+    if (output == nullptr)
+    {
+        return;
+    }
+
+    const auto started = std::chrono::steady_clock::now();
+    for (auto& layer : layers_)
+    {
+        if (!layer)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(layer->mutex);
+        layer->view = nullptr;
+        if (layer->newest < 0)
+        {
+            continue;
+        }
+
+        // Until the ring has filled, the oldest frame held is as close to the requested delay as possible.
+        const auto slot_count = static_cast<int32_t>(layer->slots.size());
+        const auto delay = std::min(layer->delay_frames, layer->filled - 1);
+        layer->reading = (layer->newest - delay + slot_count) % slot_count;
+        layer->view = &layer->slots[layer->reading];
+        layer->last_age_microseconds = now_microseconds - layer->view->capture_microseconds;
+        layer->total_age_microseconds += layer->last_age_microseconds;
+        ++layer->composites;
+    }
+
+    const bool force = output != last_output_;
+    auto body = [&](size_t begin, size_t end)
+    {
+        // Counted per band so scheduler workers touch the shared counters once per band rather than once per tile.
+        uint64_t composed = 0;
+        uint64_t skipped = 0;
+        for (auto tile_y = begin; tile_y < end; ++tile_y)
+        {
+            for (int32_t tile_x = 0; tile_x < tiles_x_; ++tile_x)
+            {
+                if (ComposeTile(tile_x, static_cast<int32_t>(tile_y), output, stride, force))
+                {
+                    ++composed;
+                }
+                else
+                {
+                    ++skipped;
+                }
+            }
+        }
+
+        tiles_composed_.fetch_add(composed, std::memory_order_relaxed);
+        tiles_skipped_.fetch_add(skipped, std::memory_order_relaxed);
+        TelemetryCounters::Add(TelemetryCounter::kTilesComposed, composed);
+        TelemetryCounters::Add(TelemetryCounter::kTilesSkipped, skipped);
+    };
+
+    if (scheduler)
+    {
+        scheduler->ParallelFor(static_cast<size_t>(tiles_y_), 1, due, body);
+    }
+    else
+    {
+        body(0, static_cast<size_t>(tiles_y_));
+    }
+
+    for (auto& layer : layers_)
+    {
+        if (!layer)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(layer->mutex);
+        layer->reading = -1;
+        layer->view = nullptr;
+    }
+
+    last_output_ = output;
+    frames_.fetch_add(1);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+    last_compose_nanoseconds_.store(elapsed);
+    TelemetryCounters::Record(TelemetryHistogram::kComposite, elapsed);
+    auto peak = peak_compose_nanoseconds_.load();
+    while (elapsed > peak && !peak_compose_nanoseconds_.compare_exchange_weak(peak, elapsed))
+    {
+    }
+}
+
+bool LayerCompositor::ComposeTile(int32_t tile_x, int32_t tile_y, uint8_t* output, int32_t stride, bool force)
+{
+    const auto tile = static_cast<size_t>(tile_y) * tiles_x_ + tile_x;
+    const auto layer_count = static_cast<int32_t>(order_.size());
+
+    // Nothing beneath the topmost opaque tile can show through, so blending starts there.
+    int32_t start = 0;
+    for (int32_t k = layer_count - 1; k >= 0; --k)
+    {
+        const auto* view = layers_[order_[k]]->view;
+        if (view && view->coverage[tile] == TileCoverage::kOpaque)
+        {
+            start = k;
+            break;
+        }
+    }
+
+    bool dirty = force;
+    for (int32_t k = start; k < layer_count && !dirty; ++k)
+    {
+        const auto& layer = *layers_[order_[k]];
+        dirty = layer.view && layer.view->versions[tile] != layer.composed_versions[tile];
+    }
+
+    if (!dirty)
+    {
+        return false;
+    }
+
+    const auto x0 = static_cast<size_t>(tile_x) * kTileSize * 4u;
+    const auto y0 = tile_y * kTileSize;
+    const auto rows = std::min(kTileSize, height_ - y0);
+    const auto columns = std::min(kTileSize, width_ - tile_x * kTileSize);
+    const auto slot_stride = static_cast<size_t>(width_) * 4u;
+    auto* destination = output + static_cast<size_t>(y0) * stride + x0;
+
+    const auto* base = layers_[order_[start]]->view;
+    const bool opaque_base = base && base->coverage[tile] == TileCoverage::kOpaque;
+    for (int32_t row = 0; row < rows; ++row)
+    {
+        auto* line = destination + static_cast<size_t>(row) * stride;
+        if (opaque_base)
+        {
+            std::memcpy(line, base->pixels.data() + static_cast<size_t>(y0 + row) * slot_stride + x0, static_cast<size_t>(columns) * 4u);
+        }
+        else
+        {
+            std::memset(line, 0, static_cast<size_t>(columns) * 4u);
+        }
+    }
+
+    for (int32_t k = start; k < layer_count; ++k)
+    {
+        auto& layer = *layers_[order_[k]];
+        const auto* view = layer.view;
+        if (view == nullptr)
+        {
+            continue;
+        }
+
+        layer.composed_versions[tile] = view->versions[tile];
+        if ((k == start && opaque_base) || view->coverage[tile] == TileCoverage::kTransparent)
+        {
+            continue;
+        }
+
+        for (int32_t row = 0; row < rows; ++row)
+        {
+            BlendPremultipliedRow(view->pixels.data() + static_cast<size_t>(y0 + row) * slot_stride + x0, destination + static_cast<size_t>(row) * stride, columns);
+        }
+    }
+
+    return true;
+}
+
+LayerStatistics LayerCompositor::GetLayerStatistics(int32_t index) const
+{
+    LayerStatistics statistics{};
+    if (index < 0 || index >= LayerCount())
+    {
+        return statistics;
+    }
+
+    const auto& layer = *layers_[index];
+    std::lock_guard<std::mutex> lock(layer.mutex);
+    statistics.z_order = layer.z_order;
+    statistics.delay_frames = layer.delay_frames;
+    statistics.frames_submitted = layer.submitted;
+    statistics.frames_dropped = layer.dropped;
+    statistics.last_age_microseconds = layer.last_age_microseconds;
+    statistics.mean_age_microseconds = layer.composites == 0 ? 0 : layer.total_age_microseconds / static_cast<int64_t>(layer.composites);
+    return statistics;
+}
+
+LayerCompositorStatistics LayerCompositor::GetStatistics() const
+{
+    LayerCompositorStatistics statistics{};
+    statistics.frames = frames_.load();
+    statistics.tiles_composed = tiles_composed_.load();
+    statistics.tiles_skipped = tiles_skipped_.load();
+    statistics.last_compose_nanoseconds = last_compose_nanoseconds_.load();
+    statistics.peak_compose_nanoseconds = peak_compose_nanoseconds_.load();
+    return statistics;
+}
+} // namespace tractus
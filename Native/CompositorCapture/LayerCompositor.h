@@ -0,0 +1,155 @@
+#pragma once
+
+#include "FrameAllocator.h"
+#include "FrameTaskScheduler.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace tractus
+{
+/// <summary>
+/// Alpha coverage of one tile of a layer frame, computed once when the frame is submitted.
+/// </summary>
+enum class TileCoverage : uint8_t
+{
+    kTransparent = 0,
+    kOpaque = 1,
+    kMixed = 2,
+};
+
+/// <summary>
+/// Submission and alignment figures for one layer.
+/// </summary>
+struct LayerStatistics
+{
+    int32_t z_order{0};
+    int32_t delay_frames{0};
+    uint64_t frames_submitted{0};
+    /// <summary>Frames discarded because the compositor was still reading the slot they would have overwritten.</summary>
+    uint64_t frames_dropped{0};
+    /// <summary>Age of the frame used by the last composite, measured from its capture timestamp.</summary>
+    int64_t last_age_microseconds{0};
+    /// <summary>Mean age across every composite since the layer was added.</summary>
+    int64_t mean_age_microseconds{0};
+};
+
+/// <summary>
+/// Work done by the compositor across all composites.
+/// </summary>
+struct LayerCompositorStatistics
+{
+    uint64_t frames{0};
+    uint64_t tiles_composed{0};
+    /// <summary>Tiles left untouched because no contributing layer changed since the previous composite.</summary>
+    uint64_t tiles_skipped{0};
+    int64_t last_compose_nanoseconds{0};
+    int64_t peak_compose_nanoseconds{0};
+};
+
+/// <summary>
+/// Blends premultiplied BGRA frames from several capture sessions in z-order. Frames are split into 64x64 tiles whose
+/// coverage and change version are recorded when each frame is submitted, so a composite starts from the topmost
+/// opaque tile, skips transparent tiles, and leaves output tiles alone when nothing beneath them changed.
+/// Each layer holds a short ring of frames so a layer that renders ahead can be delayed by a fixed number of frames
+/// to line up with slower layers.
+/// </summary>
+class LayerCompositor
+{
+public:
+    static constexpr int32_t kTileSize = 64;
+    static constexpr int32_t kMaxLayers = 8;
+
+    /// <summary>
+    /// Creates a compositor whose layer rings are allocated with <paramref name="memory_policy"/>.
+    /// </summary>
+    LayerCompositor(int32_t width, int32_t height, const FrameMemoryPolicy& memory_policy = FrameMemoryPolicy{});
+
+    /// <summary>
+    /// Adds a layer. Layers with a higher <paramref name="z_order"/> are drawn on top. Layers that are already
+    /// submitting are unaffected, but no <see cref="Compose"/> may run concurrently.
+    /// </summary>
+    /// <returns>The layer index used with <see cref="Submit"/>, or -1 once <see cref="kMaxLayers"/> layers exist.</returns>
+    int32_t AddLayer(int32_t z_order, int32_t delay_frames);
+
+    /// <summary>
+    /// Copies a captured frame into the layer's ring. Safe to call from the layer's capture thread while another
+    /// thread composes.
+    /// </summary>
+    /// <returns><c>false</c> when the frame was dropped.</returns>
+    bool Submit(int32_t layer, const uint8_t* pixels, int32_t stride, int64_t capture_microseconds);
+
+    /// <summary>
+    /// Composes the current layer frames into <paramref name="output"/>, which must be the same buffer on every call
+    /// because unchanged tiles are not rewritten.
+    /// </summary>
+    void Compose(uint8_t* output, int32_t stride, int64_t now_microseconds, FrameTaskScheduler* scheduler, FrameTaskClock::time_point due);
+
+    int32_t LayerCount() const { return layer_count_.load(); }
+
+    LayerStatistics GetLayerStatistics(int32_t layer) const;
+
+    LayerCompositorStatistics GetStatistics() const;
+
+private:
+    struct Slot
+    {
+        FrameBuffer pixels;
+        std::vector<TileCoverage> coverage;
+        /// <summary>Sequence number of the frame in which each tile last changed.</summary>
+        std::vector<uint64_t> versions;
+        int64_t capture_microseconds{0};
+    };
+
+    struct Layer
+    {
+        int32_t z_order{0};
+        int32_t delay_frames{0};
+        std::vector<Slot> slots;
+        int32_t newest{-1};
+        int32_t filled{0};
+        int32_t reading{-1};
+        uint64_t sequence{0};
+        uint64_t submitted{0};
+        uint64_t dropped{0};
+        int64_t last_age_microseconds{0};
+        int64_t total_age_microseconds{0};
+        uint64_t composites{0};
+        /// <summary>Tile versions that were blended into the output by the last composite that touched each tile.</summary>
+        std::vector<uint64_t> composed_versions;
+        const Slot* view{nullptr};
+        mutable std::mutex mutex;
+    };
+
+    /// <summary>
+    /// Blends one tile into the output. Returns false when no layer changed the tile and it was left as it was.
+    /// </summary>
+    bool ComposeTile(int32_t tile_x, int32_t tile_y, uint8_t* output, int32_t stride, bool force);
+
+    int32_t width_;
+    int32_t height_;
+    int32_t tiles_x_;
+    int32_t tiles_y_;
+    FrameMemoryPolicy memory_policy_;
+    std::array<std::unique_ptr<Layer>, kMaxLayers> layers_;
+    std::atomic<int32_t> layer_count_{0};
+    /// <summary>Layer indices sorted bottom to top.</summary>
+    std::vector<int32_t> order_;
+    const uint8_t* last_output_{nullptr};
+    std::atomic<uint64_t> frames_{0};
+    std::atomic<uint64_t> tiles_composed_{0};
+    std::atomic<uint64_t> tiles_skipped_{0};
+    std::atomic<int64_t> last_compose_nanoseconds_{0};
+    std::atomic<int64_t> peak_compose_nanoseconds_{0};
+};
+
+/// <summary>
+/// Blends premultiplied BGRA <paramref name="source"/> over <paramref name="destination"/> in place:
+/// <c>d = s + d * (255 - s.a) / 255</c> for every channel including alpha.
+/// </summary>
+void BlendPremultipliedRow(const uint8_t* source, uint8_t* destination, int32_t pixels);
+} // namespace tractus
@@ -0,0 +1,90 @@
+#include "MemoryGovernor.h"
+
+namespace tractus
+{
+MemoryGovernor& MemoryGovernor::Instance()
+{
+    static MemoryGovernor governor;
+    return governor;
+}
+
+bool MemoryGovernor::TryReserve(MemoryPool pool, uint64_t bytes)
+{
+    auto& counters = pools_[static_cast<size_t>(pool)];
+    auto in_use = in_use_.load();
+    for (;;)
+    {
+        const auto budget = budget_.load();
+        if (budget != 0 && in_use + bytes > budget)
+        {
+            refusals_.fetch_add(1);
+            counters.refusals.fetch_add(1);
+            return false;
+        }
+
+        if (in_use_.compare_exchange_weak(in_use, in_use + bytes))
+        {
+            break;
+        }
+    }
+
+    RaiseHighWater(high_water_, in_use + bytes);
+    RaiseHighWater(counters.high_water, counters.in_use.fetch_add(bytes) + bytes);
+    return true;
+}
+
+void MemoryGovernor::Reserve(MemoryPool pool, uint64_t bytes)
+{
+    auto& counters = pools_[static_cast<size_t>(pool)];
+    RaiseHighWater(high_water_, in_use_.fetch_add(bytes) + bytes);
+    RaiseHighWater(counters.high_water, counters.in_use.fetch_add(bytes) + bytes);
+}
+
+void MemoryGovernor::Release(MemoryPool pool, uint64_t bytes, bool idle)
+{
+    in_use_.fetch_sub(bytes);
+    pools_[static_cast<size_t>(pool)].in_use.fetch_sub(bytes);
+    if (idle)
+    {
+        trimmed_.fetch_add(bytes);
+    }
+}
+
+MemoryGovernorStatistics MemoryGovernor::GetStatistics() const
+{
+    MemoryGovernorStatistics statistics;
+    statistics.budget_bytes = budget_.load();
+    statistics.in_use_bytes = in_use_.load();
+    statistics.high_water_bytes = high_water_.load();
+    statistics.refusals = refusals_.load();
+    statistics.trimmed_bytes = trimmed_.load();
+    for (size_t i = 0; i < pools_.size(); ++i)
+    {
+        statistics.pools[i].in_use_bytes = pools_[i].in_use.load();
+        statistics.pools[i].high_water_bytes = pools_[i].high_water.load();
+        statistics.pools[i].refusals = pools_[i].refusals.load();
+    }
+
+    return statistics;
+}
+
+void MemoryGovernor::ResetStatistics()
+{
+    high_water_.store(in_use_.load());
+    refusals_.store(0);
+    trimmed_.store(0);
+    for (auto& pool : pools_)
+    {
+        pool.high_water.store(pool.in_use.load());
+        pool.refusals.store(0);
+    }
+}
+
+void MemoryGovernor::RaiseHighWater(std::atomic<uint64_t>& high_water, uint64_t value)
+{
+    auto current = high_water.load();
+    while (value > current && !high_water.compare_exchange_weak(current, value))
+    {
+    }
+}
+} // namespace tractus
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace tractus
+{
+/// <summary>
+/// The pools that draw frame memory from the process budget.
+/// </summary>
+enum class MemoryPool : int32_t
+{
+    /// <summary>Session staging, supersampled surface, rate-conversion, interlace and straight-alpha buffers.</summary>
+    kCapture = 0,
+    /// <summary>Scaled rendition outputs.</summary>
+    kRenditions = 1,
+    /// <summary>Layer compositor rings and composites.</summary>
+    kLayers = 2,
+    /// <summary>Frames buffered and retained by the managed pipelines.</summary>
+    kPipeline = 3,
+    kCount = 4,
+};
+
+struct MemoryPoolStatistics
+{
+    uint64_t in_use_bytes{0};
+    uint64_t high_water_bytes{0};
+    uint64_t refusals{0};
+};
+
+struct MemoryGovernorStatistics
+{
+    /// <summary>The budget, or 0 when frame memory is unlimited.</summary>
+    uint64_t budget_bytes{0};
+    uint64_t in_use_bytes{0};
+    uint64_t high_water_bytes{0};
+    /// <summary>Reservations refused because they would have exceeded the budget.</summary>
+    uint64_t refusals{0};
+    /// <summary>Bytes handed back by pools that were released while idle.</summary>
+    uint64_t trimmed_bytes{0};
+    std::array<MemoryPoolStatistics, static_cast<size_t>(MemoryPool::kCount)> pools{};
+};
+
+/// <summary>
+/// Thrown by <see cref="FrameBuffer"/> when an allocation would exceed the frame-memory budget.
+/// </summary>
+class FrameBudgetExceeded : public std::bad_alloc
+{
+public:
+    const char* what() const noexcept override { return "frame memory budget exceeded"; }
+};
+
+/// <summary>
+/// Process-wide ledger of frame memory. Every frame pool reserves its bytes here before allocating and releases
+/// them when it frees, so one budget caps the helper's pools and the managed pipelines' buffers together. A budget
+/// of zero only keeps the books. Lock-free, so pools may reserve from any thread.
+/// </summary>
+class MemoryGovernor
+{
+public:
+    static MemoryGovernor& Instance();
+
+    /// <summary>
+    /// Sets the budget in bytes; 0 removes it. Memory already in use is kept even when it exceeds a lower budget.
+    /// </summary>
+    void SetBudget(uint64_t bytes) { budget_.store(bytes); }
+
+    uint64_t Budget() const { return budget_.load(); }
+
+    /// <summary>
+    /// Reserves <paramref name="bytes"/> for <paramref name="pool"/> when they fit in the budget.
+    /// </summary>
+    /// <returns><c>false</c>, counting a refusal, when the reservation would exceed the budget.</returns>
+    bool TryReserve(MemoryPool pool, uint64_t bytes);
+
+    /// <summary>
+    /// Charges bytes a pool cannot do without, such as the single frame a pipeline needs to run at all. They are
+    /// never refused but still count against the budget, so later reservations see less headroom.
+    /// </summary>
+    void Reserve(MemoryPool pool, uint64_t bytes);
+
+    /// <summary>
+    /// Returns bytes reserved for <paramref name="pool"/>. <paramref name="idle"/> marks memory released because the
+    /// pool went idle rather than because it was resized, which is reported as trimmed.
+    /// </summary>
+    void Release(MemoryPool pool, uint64_t bytes, bool idle = false);
+
+    MemoryGovernorStatistics GetStatistics() const;
+
+    /// <summary>
+    /// Restarts the high-water marks from current use and clears the refusal and trim counters.
+    /// </summary>
+    void ResetStatistics();
+
+private:
+    struct Pool
+    {
+        std::atomic<uint64_t> in_use{0};
+        std::atomic<uint64_t> high_water{0};
+        std::atomic<uint64_t> refusals{0};
+    };
+
+    static void RaiseHighWater(std::atomic<uint64_t>& high_water, uint64_t value);
+
+    std::atomic<uint64_t> budget_{0};
+    std::atomic<uint64_t> in_use_{0};
+    std::atomic<uint64_t> high_water_{0};
+    std::atomic<uint64_t> refusals_{0};
+    std::atomic<uint64_t> trimmed_{0};
+    std::array<Pool, static_cast<size_t>(MemoryPool::kCount)> pools_;
+};
+} // namespace tractus
@@ -0,0 +1,355 @@
+#include "OverlayCompositor.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define TRACTUS_OVERLAY_SSE2 1
+#else
+#define TRACTUS_OVERLAY_SSE2 0
+#endif
+
+namespace tractus
+{
+namespace
+{
+constexpr int32_t kFontWidth = 5;
+constexpr int32_t kFontHeight = 7;
+constexpr char kGlyphCharacters[] = "0123456789:;.- ";
+constexpr int32_t kGlyphCount = static_cast<int32_t>(sizeof(kGlyphCharacters) - 1);
+
+// 5x7 bitmaps, one byte per row with the leftmost pixel in bit 4, in kGlyphCharacters order.
+constexpr uint8_t kFont[kGlyphCount][kFontHeight] = {
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // 0
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 1
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // 2
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // 3
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // 4
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // 5
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // 6
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // 7
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // 8
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // 9
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // :
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08}, // ;
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // .
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // -
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // space
+};
+
+int32_t GlyphIndex(char c)
+{
+    for (int32_t i = 0; i < kGlyphCount; ++i)
+    {
+        if (kGlyphCharacters[i] == c)
+        {
+            return i;
+        }
+    }
+
+    return kGlyphCount - 1;
+}
+
+/// <summary>
+/// Blends one row. <paramref name="mask"/> may be null for a constant alpha. All arithmetic is
+/// (a * b + 127) / 255 rounded with the (x + (x >> 8)) >> 8 identity, which stays inside 16-bit lanes.
+/// </summary>
+void BlendRow(uint8_t* row, const uint8_t* mask, int32_t pixels, uint32_t color)
+{
+    const auto alpha = color >> 24;
+    // The colour's own alpha lane is 255 so the destination alpha becomes a + d * (1 - a).
+    const uint8_t channels[4] = {static_cast<uint8_t>(color), static_cast<uint8_t>(color >> 8), static_cast<uint8_t>(color >> 16), 0xFFu};
+    int32_t x = 0;
+
+#if TRACTUS_OVERLAY_SSE2
+    const auto zero = _mm_setzero_si128();
+    const auto rounding = _mm_set1_epi16(128);
+    const auto full = _mm_set1_epi16(255);
+    const auto source = _mm_set_epi16(channels[3], channels[2], channels[1], channels[0], channels[3], channels[2], channels[1], channels[0]);
+    const auto constant_alpha = _mm_set1_epi16(static_cast<short>(alpha));
+    auto divide255 = [&](__m128i value)
+    {
+        value = _mm_add_epi16(value, rounding);
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    };
+
+    for (; x + 4 <= pixels; x += 4)
+    {
+        auto* p = row + static_cast<size_t>(x) * 4u;
+        const auto destination = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+        __m128i alpha_low = constant_alpha;
+        __m128i alpha_high = constant_alpha;
+        if (mask)
+        {
+            int32_t packed = 0;
+            std::memcpy(&packed, mask + x, sizeof(packed));
+            if (packed == 0)
+            {
+                continue;
+            }
+
+            // Replicate each coverage byte across its pixel's four channels, then scale by the colour alpha.
+            auto coverage = _mm_cvtsi32_si128(packed);
+            coverage = _mm_unpacklo_epi8(coverage, coverage);
+            coverage = _mm_unpacklo_epi16(coverage, coverage);
+            alpha_low = divide255(_mm_mullo_epi16(_mm_unpacklo_epi8(coverage, zero), constant_alpha));
+            alpha_high = divide255(_mm_mullo_epi16(_mm_unpackhi_epi8(coverage, zero), constant_alpha));
+        }
+
+        const auto low = divide255(_mm_add_epi16(_mm_mullo_epi16(source, alpha_low), _mm_mullo_epi16(_mm_unpacklo_epi8(destination, zero), _mm_sub_epi16(full, alpha_low))));
+        const auto high = divide255(_mm_add_epi16(_mm_mullo_epi16(source, alpha_high), _mm_mullo_epi16(_mm_unpackhi_epi8(destination, zero), _mm_sub_epi16(full, alpha_high))));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (; x < pixels; ++x)
+    {
+        auto a = alpha;
+        if (mask)
+        {
+            const auto scaled = mask[x] * alpha + 128u;
+            a = (scaled + (scaled >> 8)) >> 8;
+            if (a == 0)
+            {
+                continue;
+            }
+        }
+
+        auto* p = row + static_cast<size_t>(x) * 4u;
+        for (int c = 0; c < 4; ++c)
+        {
+            const auto value = channels[c] * a + p[c] * (255u - a) + 128u;
+            p[c] = static_cast<uint8_t>((value + (value >> 8)) >> 8);
+        }
+    }
+}
+
+/// <summary>
+/// Clips a rectangle to the frame; returns false when nothing remains.
+/// </summary>
+bool Clip(int32_t width, int32_t height, int32_t& x, int32_t& y, int32_t& rect_width, int32_t& rect_height, int32_t& skip_x, int32_t& skip_y)
+{
+    skip_x = std::max(0, -x);
+    skip_y = std::max(0, -y);
+    x += skip_x;
+    y += skip_y;
+    rect_width = std::min(rect_width - skip_x, width - x);
+    rect_height = std::min(rect_height - skip_y, height - y);
+    return rect_width > 0 && rect_height > 0;
+}
+
+std::string FormatClock(int64_t timestamp_utc_microseconds)
+{
+    const auto seconds = static_cast<std::time_t>(timestamp_utc_microseconds / 1000000);
+    std::tm local{};
+#if defined(_WIN32)
+    localtime_s(&local, &seconds);
+#else
+    localtime_r(&seconds, &local);
+#endif
+    char text[16];
+    std::snprintf(text, sizeof(text), "%02d:%02d:%02d", local.tm_hour, local.tm_min, local.tm_sec);
+    return text;
+}
+
+uint64_t DrawOutline(uint8_t* frame, int32_t stride, int32_t width, int32_t height, int32_t x, int32_t y, int32_t rect_width,
+                     int32_t rect_height, int32_t thickness, uint32_t color)
+{
+    thickness = std::max(1, std::min(thickness, std::min(rect_width, rect_height) / 2));
+    uint64_t pixels = 0;
+    pixels += BlendRect(frame, stride, width, height, x, y, rect_width, thickness, color);
+    pixels += BlendRect(frame, stride, width, height, x, y + rect_height - thickness, rect_width, thickness, color);
+    pixels += BlendRect(frame, stride, width, height, x, y + thickness, thickness, rect_height - 2 * thickness, color);
+    pixels += BlendRect(frame, stride, width, height, x + rect_width - thickness, y + thickness, thickness, rect_height - 2 * thickness, color);
+    return pixels;
+}
+} // namespace
+
+uint64_t BlendRect(uint8_t* frame, int32_t stride, int32_t width, int32_t height, int32_t x, int32_t y, int32_t rect_width,
+                   int32_t rect_height, uint32_t color)
+{
+    int32_t skip_x = 0;
+    int32_t skip_y = 0;
+    if ((color >> 24) == 0 || !Clip(width, height, x, y, rect_width, rect_height, skip_x, skip_y))
+    {
+        return 0;
+    }
+
+    for (int32_t row = 0; row < rect_height; ++row)
+    {
+        BlendRow(frame + static_cast<size_t>(y + row) * stride + static_cast<size_t>(x) * 4u, nullptr, rect_width, color);
+    }
+
+    return static_cast<uint64_t>(rect_width) * static_cast<uint64_t>(rect_height);
+}
+
+uint64_t BlendMask(uint8_t* frame, int32_t stride, int32_t width, int32_t height, int32_t x, int32_t y, const uint8_t* mask,
+                   int32_t mask_stride, int32_t mask_width, int32_t mask_height, uint32_t color)
+{
+    int32_t skip_x = 0;
+    int32_t skip_y = 0;
+    if ((color >> 24) == 0 || !Clip(width, height, x, y, mask_width, mask_height, skip_x, skip_y))
+    {
+        return 0;
+    }
+
+    for (int32_t row = 0; row < mask_height; ++row)
+    {
+        const auto* coverage = mask + static_cast<size_t>(row + skip_y) * mask_stride + skip_x;
+        BlendRow(frame + static_cast<size_t>(y + row) * stride + static_cast<size_t>(x) * 4u, coverage, mask_width, color);
+    }
+
+    return static_cast<uint64_t>(mask_width) * static_cast<uint64_t>(mask_height);
+}
+
+std::string FormatTimecode(uint64_t frame_index, int32_t frame_rate_numerator, int32_t frame_rate_denominator)
+{
+    const auto numerator = std::max(1, frame_rate_numerator);
+    const auto denominator = std::max(1, frame_rate_denominator);
+    const auto nominal = static_cast<uint64_t>((numerator + denominator - 1) / denominator);
+    const bool drop_frame = denominator == 1001 && (nominal == 30 || nominal == 60);
+
+    auto frames = frame_index;
+    if (drop_frame)
+    {
+        // Skip the first 2 (or 4) frame numbers of every minute except each tenth minute.
+        const auto dropped = nominal / 15u;
+        const auto per_ten_minutes = nominal * 600u - dropped * 9u;
+        const auto per_minute = nominal * 60u - dropped;
+        const auto tens = frames / per_ten_minutes;
+        const auto remainder = frames % per_ten_minutes;
+        frames += dropped * 9u * tens;
+        if (remainder > dropped)
+        {
+            frames += dropped * ((remainder - dropped) / per_minute);
+        }
+    }
+
+    const auto frame = frames % nominal;
+    const auto total_seconds = frames / nominal;
+    char text[32];
+    std::snprintf(text, sizeof(text), "%02u:%02u:%02u%c%02u", static_cast<unsigned>((total_seconds / 3600u) % 24u),
+                  static_cast<unsigned>((total_seconds / 60u) % 60u), static_cast<unsigned>(total_seconds % 60u), drop_frame ? ';' : ':',
+                  static_cast<unsigned>(frame));
+    return text;
+}
+
+void OverlayCompositor::SetOverlays(std::vector<OverlaySpec> overlays)
+{
+    auto list = std::make_shared<const std::vector<OverlaySpec>>(std::move(overlays));
+    std::lock_guard<std::mutex> lock(mutex_);
+    overlays_ = std::move(list);
+}
+
+bool OverlayCompositor::HasOverlays() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return overlays_ && !overlays_->empty();
+}
+
+uint64_t OverlayCompositor::Apply(uint8_t* frame, int32_t stride, int32_t width, int32_t height, const OverlayFrameInfo& info)
+{
+    std::shared_ptr<const std::vector<OverlaySpec>> overlays;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        overlays = overlays_;
+    }
+
+    if (!overlays || frame == nullptr)
+    {
+        return 0;
+    }
+
+    uint64_t pixels = 0;
+    for (const auto& spec : *overlays)
+    {
+        switch (spec.kind)
+        {
+        case OverlayKind::kTimecode:
+            pixels += DrawText(frame, stride, width, height, spec, FormatTimecode(info.frame_index, info.frame_rate_numerator, info.frame_rate_denominator));
+            break;
+        case OverlayKind::kClock:
+            pixels += DrawText(frame, stride, width, height, spec, FormatClock(info.timestamp_utc_microseconds));
+            break;
+        case OverlayKind::kTallyBorder:
+            pixels += DrawOutline(frame, stride, width, height, 0, 0, width, height, spec.thickness > 0 ? spec.thickness : 8, spec.color);
+            break;
+        case OverlayKind::kSafeArea:
+        {
+            const auto thickness = spec.thickness > 0 ? spec.thickness : 2;
+            for (const auto percent : {93, 90})
+            {
+                const auto inset_x = width * (100 - percent) / 200;
+                const auto inset_y = height * (100 - percent) / 200;
+                pixels += DrawOutline(frame, stride, width, height, inset_x, inset_y, width - 2 * inset_x, height - 2 * inset_y, thickness, spec.color);
+            }
+
+            break;
+        }
+        case OverlayKind::kRectangle:
+            pixels += BlendRect(frame, stride, width, height, spec.x, spec.y, spec.width, spec.height, spec.color);
+            break;
+        }
+    }
+
+    return pixels;
+}
+
+const OverlayCompositor::GlyphAtlas& OverlayCompositor::AtlasForScale(int32_t scale)
+{
+    auto& atlas = atlases_[scale];
+    if (!atlas.coverage.empty())
+    {
+        return atlas;
+    }
+
+    // Each cell leaves one font pixel of spacing on the right and above and below the glyph.
+    atlas.cell_width = (kFontWidth + 1) * scale;
+    atlas.cell_height = (kFontHeight + 2) * scale;
+    atlas.stride = atlas.cell_width * kGlyphCount;
+    atlas.coverage.assign(static_cast<size_t>(atlas.stride) * atlas.cell_height, 0u);
+    for (int32_t glyph = 0; glyph < kGlyphCount; ++glyph)
+    {
+        for (int32_t row = 0; row < kFontHeight; ++row)
+        {
+            for (int32_t column = 0; column < kFontWidth; ++column)
+            {
+                if ((kFont[glyph][row] & (0x10 >> column)) == 0)
+                {
+                    continue;
+                }
+
+                for (int32_t dy = 0; dy < scale; ++dy)
+                {
+                    auto* line = atlas.coverage.data() + static_cast<size_t>((row + 1) * scale + dy) * atlas.stride;
+                    std::fill_n(line + glyph * atlas.cell_width + column * scale, scale, static_cast<uint8_t>(0xFFu));
+                }
+            }
+        }
+    }
+
+    return atlas;
+}
+
+uint64_t OverlayCompositor::DrawText(uint8_t* frame, int32_t stride, int32_t width, int32_t height, const OverlaySpec& spec, const std::string& text)
+{
+    const auto scale = std::max(1, std::min(spec.scale, 16));
+    const auto& atlas = AtlasForScale(scale);
+    const auto text_width = atlas.cell_width * static_cast<int32_t>(text.size()) + scale;
+
+    uint64_t pixels = BlendRect(frame, stride, width, height, spec.x, spec.y, text_width + scale, atlas.cell_height, spec.background);
+    auto x = spec.x + scale;
+    for (const auto c : text)
+    {
+        const auto* mask = atlas.coverage.data() + GlyphIndex(c) * atlas.cell_width;
+        pixels += BlendMask(frame, stride, width, height, x, spec.y, mask, atlas.stride, atlas.cell_width, atlas.cell_height, spec.color);
+        x += atlas.cell_width;
+    }
+
+    return pixels;
+}
+} // namespace tractus
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace tractus
+{
+/// <summary>
+/// Kinds of overlay the compositor can burn into a frame.
+/// </summary>
+enum class OverlayKind : int32_t
+{
+    /// <summary>Running timecode derived from the output frame index and rate (drop-frame for 29.97/59.94).</summary>
+    kTimecode = 0,
+    /// <summary>Local wall clock (HH:MM:SS) taken from the frame timestamp.</summary>
+    kClock = 1,
+    /// <summary>Solid border around the whole frame.</summary>
+    kTallyBorder = 2,
+    /// <summary>Outlines of the 93% action-safe and 90% title-safe areas.</summary>
+    kSafeArea = 3,
+    /// <summary>Filled rectangle.</summary>
+    kRectangle = 4,
+};
+
+/// <summary>
+/// Describes one overlay. Colours are straight-alpha <c>0xAARRGGBB</c>, which is BGRA byte order in memory.
+/// </summary>
+struct OverlaySpec
+{
+    OverlayKind kind{OverlayKind::kRectangle};
+    /// <summary>Top-left corner for text and rectangles.</summary>
+    int32_t x{0};
+    int32_t y{0};
+    /// <summary>Rectangle size; ignored by the other kinds.</summary>
+    int32_t width{0};
+    int32_t height{0};
+    uint32_t color{0xFFFFFFFFu};
+    /// <summary>Box drawn behind text; an alpha of zero skips it.</summary>
+    uint32_t background{0x00000000u};
+    /// <summary>Glyph scale for text; each font pixel becomes scale x scale output pixels.</summary>
+    int32_t scale{4};
+    /// <summary>Line thickness for borders and safe-area outlines.</summary>
+    int32_t thickness{0};
+};
+
+/// <summary>
+/// Per-frame inputs used to render dynamic overlays.
+/// </summary>
+struct OverlayFrameInfo
+{
+    uint64_t frame_index{0};
+    int32_t frame_rate_numerator{60};
+    int32_t frame_rate_denominator{1};
+    int64_t timestamp_utc_microseconds{0};
+};
+
+/// <summary>
+/// Alpha-blends timecode, clock and simple shapes into BGRA frames. Text comes from glyph atlases prerendered once
+/// per scale, and every kernel writes only the pixels inside its overlay rectangle.
+/// </summary>
+class OverlayCompositor
+{
+public:
+    /// <summary>
+    /// Replaces the overlay list. Safe to call from any thread; the next <see cref="Apply"/> picks it up.
+    /// </summary>
+    void SetOverlays(std::vector<OverlaySpec> overlays);
+
+    /// <summary>Gets a value indicating whether any overlay is configured.</summary>
+    bool HasOverlays() const;
+
+    /// <summary>
+    /// Blends every configured overlay into the frame.
+    /// </summary>
+    /// <returns>The number of pixels written.</returns>
+    uint64_t Apply(uint8_t* frame, int32_t stride, int32_t width, int32_t height, const OverlayFrameInfo& info);
+
+private:
+    /// <summary>
+    /// Coverage masks for the supported characters at one scale, stored side by side in a single A8 strip.
+    /// </summary>
+    struct GlyphAtlas
+    {
+        int32_t cell_width{0};
+        int32_t cell_height{0};
+        int32_t stride{0};
+        std::vector<uint8_t> coverage;
+    };
+
+    const GlyphAtlas& AtlasForScale(int32_t scale);
+    uint64_t DrawText(uint8_t* frame, int32_t stride, int32_t width, int32_t height, const OverlaySpec& spec, const std::string& text);
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const std::vector<OverlaySpec>> overlays_;
+    std::map<int32_t, GlyphAtlas> atlases_;
+};
+
+/// <summary>
+/// Blends a constant straight-alpha colour over a clipped rectangle.
+/// </summary>
+/// <returns>The number of pixels written.</returns>
+uint64_t BlendRect(uint8_t* frame, int32_t stride, int32_t width, int32_t height, int32_t x, int32_t y, int32_t rect_width,
+                   int32_t rect_height, uint32_t color);
+
+/// <summary>
+/// Blends a straight-alpha colour through an A8 coverage mask placed at (<paramref name="x"/>, <paramref name="y"/>),
+/// clipped to the frame.
+/// </summary>
+/// <returns>The number of pixels written.</returns>
+uint64_t BlendMask(uint8_t* frame, int32_t stride, int32_t width, int32_t height, int32_t x, int32_t y, const uint8_t* mask,
+                   int32_t mask_stride, int32_t mask_width, int32_t mask_height, uint32_t color);
+
+/// <summary>
+/// Formats a frame count as SMPTE timecode. 29.97 and 59.94 use drop-frame counting and a ';' separator.
+/// </summary>
+std::string FormatTimecode(uint64_t frame_index, int32_t frame_rate_numerator, int32_t frame_rate_denominator);
+} // namespace tractus
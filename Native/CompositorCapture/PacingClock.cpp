@@ -0,0 +1,97 @@
+#include "PacingClock.h"
+
+#include <thread>
+
+namespace tractus
+{
+namespace
+{
+class SystemPacingClock final : public PacingClock
+{
+public:
+    TimePoint Now() override
+    {
+        return std::chrono::steady_clock::now();
+    }
+
+    void SleepUntil(TimePoint deadline) override
+    {
+        std::this_thread::sleep_until(deadline);
+    }
+};
+} // namespace
+
+PacingClock& PacingClock::System()
+{
+    static SystemPacingClock clock;
+    return clock;
+}
+
+VirtualPacingClock::VirtualPacingClock(TimePoint origin)
+    : now_(origin.time_since_epoch().count())
+{
+}
+
+PacingClock::TimePoint VirtualPacingClock::Now()
+{
+    return TimePoint(Duration(now_.load(std::memory_order_acquire)));
+}
+
+void VirtualPacingClock::SleepUntil(TimePoint deadline)
+{
+    if (deadline.time_since_epoch().count() <= now_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    sleeps_.fetch_add(1, std::memory_order_relaxed);
+    MoveTo(deadline.time_since_epoch().count() + wake_latency_.load(std::memory_order_relaxed));
+}
+
+void VirtualPacingClock::Advance(Duration duration)
+{
+    if (duration.count() > 0)
+    {
+        now_.fetch_add(duration.count(), std::memory_order_acq_rel);
+    }
+}
+
+void VirtualPacingClock::SetWakeLatency(Duration latency)
+{
+    wake_latency_.store(latency.count() > 0 ? latency.count() : 0, std::memory_order_relaxed);
+}
+
+uint64_t VirtualPacingClock::Sleeps() const
+{
+    return sleeps_.load(std::memory_order_relaxed);
+}
+
+void VirtualPacingClock::MoveTo(Duration::rep ticks)
+{
+    auto current = now_.load(std::memory_order_acquire);
+    while (current < ticks && !now_.compare_exchange_weak(current, ticks, std::memory_order_acq_rel))
+    {
+    }
+}
+
+FrameCadence::FrameCadence(PacingClock& clock, PacingClock::Duration interval)
+    : clock_(clock), interval_(interval)
+{
+}
+
+void FrameCadence::WaitForNextFrame(PacingClock::TimePoint frame_start)
+{
+    next_due_ = started_ ? next_due_ + interval_ : frame_start + interval_;
+    started_ = true;
+    const auto now = clock_.Now();
+    if (next_due_ < now)
+    {
+        // The frame overran its slot: start the next one straight away and lay the grid from there.
+        next_due_ = now;
+        ++resyncs_;
+        return;
+    }
+
+    clock_.SleepUntil(next_due_);
+}
+} // namespace tractus
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// The time source of the helper's frame loops. The system clock reads <c>std::chrono::steady_clock</c> and really
+/// sleeps; <c>VirtualPacingClock</c> lets a test run a loop through hours of frames without waiting.
+/// </summary>
+class PacingClock
+{
+public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+    using Duration = std::chrono::steady_clock::duration;
+
+    virtual ~PacingClock() = default;
+
+    virtual TimePoint Now() = 0;
+
+    /// <summary>
+    /// Blocks the calling thread until <paramref name="deadline"/>; returns at once for a deadline in the past.
+    /// </summary>
+    virtual void SleepUntil(TimePoint deadline) = 0;
+
+    /// <summary>
+    /// The process-wide <c>steady_clock</c>.
+    /// </summary>
+    static PacingClock& System();
+};
+
+/// <summary>
+/// A clock that jumps to each deadline instead of sleeping, so a frame loop runs as fast as it can compute while
+/// seeing the timestamps it would see in real time. Thread-safe; time never moves backwards.
+/// </summary>
+class VirtualPacingClock final : public PacingClock
+{
+public:
+    /// <summary>
+    /// Starts the clock at <paramref name="origin"/>. The default is the real time now, so deadlines the loop hands to
+    /// the <c>FrameTaskScheduler</c> stay comparable with its own clock.
+    /// </summary>
+    explicit VirtualPacingClock(TimePoint origin = std::chrono::steady_clock::now());
+
+    TimePoint Now() override;
+
+    /// <summary>
+    /// Moves the clock to <paramref name="deadline"/> plus the wake latency.
+    /// </summary>
+    void SleepUntil(TimePoint deadline) override;
+
+    /// <summary>
+    /// Moves the clock forward, standing in for work or a stall on the looping thread.
+    /// </summary>
+    void Advance(Duration duration);
+
+    /// <summary>
+    /// Sets how late each sleep wakes, standing in for timer and scheduler latency.
+    /// </summary>
+    void SetWakeLatency(Duration latency);
+
+    /// <summary>
+    /// The sleeps that moved the clock.
+    /// </summary>
+    uint64_t Sleeps() const;
+
+private:
+    void MoveTo(Duration::rep ticks);
+
+    std::atomic<Duration::rep> now_;
+    std::atomic<Duration::rep> wake_latency_{0};
+    std::atomic<uint64_t> sleeps_{0};
+};
+
+/// <summary>
+/// Paces a frame loop to a fixed interval on a <c>PacingClock</c>. Frames are due on a grid from the first frame, so
+/// late wakes do not add up over time; when a frame overruns its slot the next one starts at once and the grid restarts
+/// from there instead of bursting to catch up.
+/// </summary>
+class FrameCadence
+{
+public:
+    FrameCadence(PacingClock& clock, PacingClock::Duration interval);
+
+    /// <summary>
+    /// Sleeps until the frame after the one that started at <paramref name="frame_start"/> is due.
+    /// </summary>
+    void WaitForNextFrame(PacingClock::TimePoint frame_start);
+
+    /// <summary>
+    /// The times a frame overran its slot and the grid restarted.
+    /// </summary>
+    uint64_t Resyncs() const
+    {
+        return resyncs_;
+    }
+
+private:
+    PacingClock& clock_;
+    PacingClock::Duration interval_;
+    PacingClock::TimePoint next_due_{};
+    bool started_{false};
+    uint64_t resyncs_{0};
+};
+} // namespace tractus
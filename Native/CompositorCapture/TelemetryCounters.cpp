@@ -0,0 +1,149 @@
+#include "TelemetryCounters.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace tractus
+{
+namespace
+{
+constexpr size_t kCacheLineSize = 64;
+
+/// <summary>
+/// One thread's counters. Only the owning thread writes them, so a relaxed load and store is a complete increment;
+/// the atomics exist so snapshot readers on other threads never see a torn value.
+/// </summary>
+struct alignas(kCacheLineSize) CounterBlock
+{
+    std::array<std::atomic<uint64_t>, kTelemetryCounterCount> values{};
+    std::array<std::array<std::atomic<uint64_t>, kTelemetryHistogramBuckets>, kTelemetryHistogramCount> buckets{};
+    std::array<std::atomic<uint64_t>, kTelemetryHistogramCount> sums{};
+};
+
+void Bump(std::atomic<uint64_t>& slot, uint64_t value)
+{
+    slot.store(slot.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void Accumulate(const CounterBlock& block, TelemetrySnapshot& snapshot)
+{
+    for (size_t i = 0; i < kTelemetryCounterCount; ++i)
+    {
+        snapshot.counters[i] += block.values[i].load(std::memory_order_relaxed);
+    }
+
+    for (size_t h = 0; h < kTelemetryHistogramCount; ++h)
+    {
+        auto& histogram = snapshot.histograms[h];
+        histogram.sum_nanoseconds += block.sums[h].load(std::memory_order_relaxed);
+        for (size_t b = 0; b < kTelemetryHistogramBuckets; ++b)
+        {
+            const auto count = block.buckets[h][b].load(std::memory_order_relaxed);
+            histogram.buckets[b] += count;
+            histogram.count += count;
+        }
+    }
+}
+
+static_assert(sizeof(CounterBlock) % kCacheLineSize == 0, "counter blocks must fill whole cache lines");
+
+class CounterRegistry
+{
+public:
+    void Register(CounterBlock* block)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        blocks_.push_back(block);
+    }
+
+    void Retire(CounterBlock* block)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Accumulate(*block, retired_);
+        blocks_.erase(std::remove(blocks_.begin(), blocks_.end(), block), blocks_.end());
+    }
+
+    TelemetrySnapshot Snapshot()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto snapshot = retired_;
+        for (const auto* block : blocks_)
+        {
+            Accumulate(*block, snapshot);
+        }
+
+        return snapshot;
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<CounterBlock*> blocks_;
+    TelemetrySnapshot retired_;
+};
+
+CounterRegistry& Registry()
+{
+    // Leaked so threads that outlive static destruction can still retire their blocks.
+    static auto* registry = new CounterRegistry();
+    return *registry;
+}
+
+/// <summary>
+/// Registers the calling thread's block on first use and retires it when the thread exits.
+/// </summary>
+struct ThreadCounterBlock
+{
+    ThreadCounterBlock()
+    {
+        Registry().Register(&block);
+    }
+
+    ~ThreadCounterBlock()
+    {
+        Registry().Retire(&block);
+    }
+
+    CounterBlock block;
+};
+
+CounterBlock& LocalBlock()
+{
+    thread_local ThreadCounterBlock local;
+    return local.block;
+}
+} // namespace
+
+void TelemetryCounters::Add(TelemetryCounter counter, uint64_t value)
+{
+    Bump(LocalBlock().values[static_cast<size_t>(counter)], value);
+}
+
+void TelemetryCounters::Record(TelemetryHistogram histogram, int64_t nanoseconds)
+{
+    const auto duration = nanoseconds > 0 ? static_cast<uint64_t>(nanoseconds) : 0u;
+    auto& block = LocalBlock();
+    const auto index = static_cast<size_t>(histogram);
+    Bump(block.buckets[index][BucketOf(nanoseconds)], 1u);
+    Bump(block.sums[index], duration);
+}
+
+size_t TelemetryCounters::BucketOf(int64_t nanoseconds)
+{
+    // At most sixteen doublings, which is cheaper than the cache miss a lookup table would risk.
+    size_t bucket = 0;
+    auto bound = static_cast<int64_t>(kTelemetryHistogramFirstBound);
+    while (bucket + 1 < kTelemetryHistogramBuckets && nanoseconds > bound)
+    {
+        bound <<= 1;
+        ++bucket;
+    }
+
+    return bucket;
+}
+
+TelemetrySnapshot TelemetryCounters::Snapshot()
+{
+    return Registry().Snapshot();
+}
+} // namespace tractus
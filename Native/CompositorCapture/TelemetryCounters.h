@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Process-wide event counters kept by the helper's hot paths.
+/// </summary>
+enum class TelemetryCounter : uint32_t
+{
+    /// <summary>Frames produced by capture sessions, before any layer or callback sees them.</summary>
+    kFramesCaptured = 0,
+    /// <summary>Frames handed to session callbacks.</summary>
+    kFramesDelivered,
+    /// <summary>Frames submitted to a layer compositor instead of a callback.</summary>
+    kLayerFramesSubmitted,
+    kRenditionFramesDelivered,
+    /// <summary>Frames that had overlays burned in.</summary>
+    kOverlayFrames,
+    /// <summary>Frames delivered by layer compositors.</summary>
+    kCompositesDelivered,
+    kTilesComposed,
+    kTilesSkipped,
+    kCount,
+};
+
+constexpr size_t kTelemetryCounterCount = static_cast<size_t>(TelemetryCounter::kCount);
+
+/// <summary>
+/// Durations the helper's hot paths record into histograms.
+/// </summary>
+enum class TelemetryHistogram : uint32_t
+{
+    /// <summary>Producing one output frame: rate conversion, weave, overlays and alpha conversion.</summary>
+    kFrameConversion = 0,
+    /// <summary>Scaling and converting one rendition frame.</summary>
+    kRenditionConversion,
+    /// <summary>Blending one layer composite.</summary>
+    kComposite,
+    kCount,
+};
+
+constexpr size_t kTelemetryHistogramCount = static_cast<size_t>(TelemetryHistogram::kCount);
+
+/// <summary>
+/// Buckets per histogram. Bucket <c>i</c> holds durations up to <c>kTelemetryHistogramFirstBound &lt;&lt; i</c>
+/// nanoseconds (about 1 µs to 34 ms); the last bucket holds everything longer.
+/// </summary>
+constexpr size_t kTelemetryHistogramBuckets = 17;
+constexpr uint64_t kTelemetryHistogramFirstBound = 1024;
+
+struct TelemetryHistogramSnapshot
+{
+    uint64_t count{0};
+    uint64_t sum_nanoseconds{0};
+    /// <summary>Per-bucket counts, not cumulative.</summary>
+    std::array<uint64_t, kTelemetryHistogramBuckets> buckets{};
+};
+
+struct TelemetrySnapshot
+{
+    std::array<uint64_t, kTelemetryCounterCount> counters{};
+    std::array<TelemetryHistogramSnapshot, kTelemetryHistogramCount> histograms{};
+
+    uint64_t operator[](TelemetryCounter counter) const
+    {
+        return counters[static_cast<size_t>(counter)];
+    }
+
+    const TelemetryHistogramSnapshot& operator[](TelemetryHistogram histogram) const
+    {
+        return histograms[static_cast<size_t>(histogram)];
+    }
+};
+
+/// <summary>
+/// Event counters that cost the hot path a plain add. Each thread writes a block of its own, aligned and padded to
+/// whole cache lines so no two writers share a line, and the blocks are only summed when a snapshot is taken. A
+/// thread's counts move into a retired total when it exits, so snapshots never go backwards.
+/// </summary>
+class TelemetryCounters
+{
+public:
+    /// <summary>
+    /// Adds <paramref name="value"/> to the calling thread's block. Wait-free: no lock prefix, no shared line.
+    /// </summary>
+    static void Add(TelemetryCounter counter, uint64_t value = 1);
+
+    /// <summary>
+    /// Records one duration in the calling thread's block. Wait-free like <see cref="Add"/>.
+    /// </summary>
+    static void Record(TelemetryHistogram histogram, int64_t nanoseconds);
+
+    /// <summary>
+    /// Returns the bucket a duration falls in.
+    /// </summary>
+    static size_t BucketOf(int64_t nanoseconds);
+
+    /// <summary>
+    /// Sums every live block and the retired total, counters and histograms alike. Takes the registry lock, so call it at telemetry rate, not
+    /// per frame.
+    /// </summary>
+    static TelemetrySnapshot Snapshot();
+};
+} // namespace tractus
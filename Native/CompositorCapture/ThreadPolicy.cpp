@@ -0,0 +1,127 @@
+#include "ThreadPolicy.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <avrt.h>
+// Linked here rather than in each project so the tests and benchmarks that compile this file pick it up too.
+#pragma comment(lib, "Avrt.lib")
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace tractus
+{
+namespace
+{
+#if defined(__linux__)
+// Below the kernel's threaded IRQ handlers (50) so a stuck capture loop cannot starve interrupt delivery.
+constexpr int kRealtimeFifoPriority = 20;
+constexpr int kHighNiceValue = -10;
+#endif
+
+bool ApplyHighPriority()
+{
+#if defined(_WIN32)
+    return SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST) != FALSE;
+#elif defined(__linux__)
+    // Linux threads are scheduling entities of their own, so PRIO_PROCESS with a thread id only renices this thread.
+    return setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), kHighNiceValue) == 0;
+#else
+    return false;
+#endif
+}
+
+bool ApplyAffinity(uint64_t mask)
+{
+#if defined(_WIN32)
+    return SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(mask)) != 0;
+#elif defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < 64; ++cpu)
+    {
+        if ((mask >> cpu) & 1u)
+        {
+            CPU_SET(cpu, &set);
+        }
+    }
+
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)mask;
+    return false;
+#endif
+}
+
+bool ApplyTimerSlack(int64_t nanoseconds)
+{
+#if defined(_WIN32)
+    (void)nanoseconds;
+    THREAD_POWER_THROTTLING_STATE state{};
+    state.Version = THREAD_POWER_THROTTLING_CURRENT_VERSION;
+    state.ControlMask = THREAD_POWER_THROTTLING_EXECUTION_SPEED;
+    state.StateMask = 0;
+    return SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling, &state, sizeof(state)) != FALSE;
+#elif defined(__linux__)
+    return prctl(PR_SET_TIMERSLACK, static_cast<unsigned long>(nanoseconds), 0, 0, 0) == 0;
+#else
+    (void)nanoseconds;
+    return false;
+#endif
+}
+} // namespace
+
+ScopedThreadPolicy::ScopedThreadPolicy(const ThreadPolicy& policy)
+{
+    if (policy.priority == ThreadPriorityClass::kRealtime)
+    {
+#if defined(_WIN32)
+        DWORD task_index = 0;
+        mmcss_handle_ = AvSetMmThreadCharacteristicsW(L"Pro Audio", &task_index);
+        if (mmcss_handle_ != nullptr)
+        {
+            AvSetMmThreadPriority(mmcss_handle_, AVRT_PRIORITY_HIGH);
+            outcome_.priority = ThreadPriorityClass::kRealtime;
+        }
+#elif defined(__linux__)
+        sched_param parameters{};
+        parameters.sched_priority = kRealtimeFifoPriority;
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0)
+        {
+            outcome_.priority = ThreadPriorityClass::kRealtime;
+        }
+#endif
+    }
+
+    // Realtime scheduling needs MMCSS or CAP_SYS_NICE; without it the thread still gets the best ordinary priority.
+    if (policy.priority != ThreadPriorityClass::kNormal && outcome_.priority == ThreadPriorityClass::kNormal && ApplyHighPriority())
+    {
+        outcome_.priority = ThreadPriorityClass::kHigh;
+    }
+
+    if (policy.affinity_mask != 0)
+    {
+        outcome_.affinity_applied = ApplyAffinity(policy.affinity_mask);
+    }
+
+    if (policy.timer_slack_nanoseconds > 0)
+    {
+        outcome_.timer_slack_applied = ApplyTimerSlack(policy.timer_slack_nanoseconds);
+    }
+}
+
+ScopedThreadPolicy::~ScopedThreadPolicy()
+{
+#if defined(_WIN32)
+    if (mmcss_handle_ != nullptr)
+    {
+        AvRevertMmThreadCharacteristics(mmcss_handle_);
+    }
+#endif
+}
+} // namespace tractus
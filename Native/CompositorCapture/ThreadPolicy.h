@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+
+namespace tractus
+{
+/// <summary>
+/// Scheduling class requested for a latency-sensitive thread.
+/// </summary>
+enum class ThreadPriorityClass : int32_t
+{
+    /// <summary>Leaves the thread's priority untouched.</summary>
+    kNormal = 0,
+    /// <summary>Highest non-realtime priority: <c>THREAD_PRIORITY_HIGHEST</c> on Windows, nice -10 on Linux.</summary>
+    kHigh = 1,
+    /// <summary>MMCSS "Pro Audio" on Windows, <c>SCHED_FIFO</c> on Linux. Falls back to <c>kHigh</c> when refused.</summary>
+    kRealtime = 2,
+};
+
+/// <summary>
+/// Scheduling settings for one thread. Zero in every field leaves the thread as the OS created it.
+/// </summary>
+struct ThreadPolicy
+{
+    ThreadPriorityClass priority{ThreadPriorityClass::kNormal};
+    /// <summary>CPUs the thread may run on, bit n for CPU n; zero keeps the inherited affinity.</summary>
+    uint64_t affinity_mask{0};
+    /// <summary>
+    /// How late the kernel may fire the thread's timers so it can batch wakeups; zero keeps the default (50 us on
+    /// Linux). Windows has no per-thread slack, so any positive value opts the thread out of EcoQoS throttling instead,
+    /// which is what coalesces its timers there.
+    /// </summary>
+    int64_t timer_slack_nanoseconds{0};
+
+    bool IsDefault() const
+    {
+        return priority == ThreadPriorityClass::kNormal && affinity_mask == 0 && timer_slack_nanoseconds <= 0;
+    }
+};
+
+/// <summary>
+/// What actually took effect when a policy was applied; requests the OS refused are left at their defaults.
+/// </summary>
+struct ThreadPolicyOutcome
+{
+    ThreadPriorityClass priority{ThreadPriorityClass::kNormal};
+    bool affinity_applied{false};
+    bool timer_slack_applied{false};
+};
+
+/// <summary>
+/// Applies a <see cref="ThreadPolicy"/> to the calling thread. Construct it at the top of a thread's entry point, on
+/// that thread; the destructor releases the MMCSS registration, and everything else ends with the thread.
+/// </summary>
+class ScopedThreadPolicy
+{
+public:
+    explicit ScopedThreadPolicy(const ThreadPolicy& policy);
+    ~ScopedThreadPolicy();
+
+    ScopedThreadPolicy(const ScopedThreadPolicy&) = delete;
+    ScopedThreadPolicy& operator=(const ScopedThreadPolicy&) = delete;
+
+    const ThreadPolicyOutcome& Outcome() const { return outcome_; }
+
+private:
+    ThreadPolicyOutcome outcome_;
+    void* mmcss_handle_{nullptr};
+};
+} // namespace tractus
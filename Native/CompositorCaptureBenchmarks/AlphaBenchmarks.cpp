@@ -0,0 +1,145 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/AlphaConverter.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+constexpr int32_t kWidth = 1920;
+constexpr int32_t kHeight = 1080;
+constexpr int32_t kStride = kWidth * 4;
+
+/// <summary>
+/// Runs <paramref name="convert"/> back to back until the measurement budget is spent and returns the mean
+/// milliseconds per frame.
+/// </summary>
+template <typename Convert>
+double MeasureMillisecondsPerFrame(Convert&& convert, std::chrono::milliseconds budget)
+{
+    convert(FrameTaskClock::now());
+
+    uint64_t frames = 0;
+    const auto start = FrameTaskClock::now();
+    const auto end = start + budget;
+    auto now = start;
+    while (now < end || frames < 3)
+    {
+        convert(now + std::chrono::milliseconds(16));
+        ++frames;
+        now = FrameTaskClock::now();
+    }
+
+    return std::chrono::duration<double, std::milli>(now - start).count() / static_cast<double>(frames);
+}
+
+/// <summary>
+/// The straightforward conversion the lookup table replaces: one integer divide per colour channel.
+/// </summary>
+void UnpremultiplyDivide(const uint8_t* source, uint8_t* destination, size_t pixels)
+{
+    for (size_t i = 0; i < pixels * 4u; i += 4)
+    {
+        const uint32_t alpha = source[i + 3];
+        for (size_t c = 0; c < 3; ++c)
+        {
+            destination[i + c] = alpha == 0 ? 0 : static_cast<uint8_t>(std::min(255u, (source[i + c] * 510u + alpha) / (2u * alpha)));
+        }
+
+        destination[i + 3] = static_cast<uint8_t>(alpha);
+    }
+}
+
+/// <summary>
+/// Premultiplied pixel with the given alpha and a colour derived from <paramref name="seed"/>.
+/// </summary>
+void WritePixel(uint8_t* pixel, uint32_t seed, uint8_t alpha)
+{
+    for (int c = 0; c < 3; ++c)
+    {
+        pixel[c] = static_cast<uint8_t>(((seed * (c + 7u)) & 0xFFu) * alpha / 255u);
+    }
+
+    pixel[3] = alpha;
+}
+
+enum class Content
+{
+    kOpaquePage,
+    kLowerThird,
+    kTranslucentNoise,
+};
+
+std::vector<uint8_t> CreateFrame(Content content)
+{
+    std::vector<uint8_t> frame(static_cast<size_t>(kStride) * kHeight, 0u);
+    for (int32_t y = 0; y < kHeight; ++y)
+    {
+        for (int32_t x = 0; x < kWidth; ++x)
+        {
+            auto* pixel = frame.data() + static_cast<size_t>(y) * kStride + static_cast<size_t>(x) * 4u;
+            const auto seed = static_cast<uint32_t>(y * 131 + x * 17);
+            switch (content)
+            {
+            case Content::kOpaquePage:
+                WritePixel(pixel, seed, 255u);
+                break;
+            case Content::kLowerThird:
+                // Transparent except a band along the bottom third with an opaque box and soft edges.
+                if (y >= kHeight * 2 / 3 && y < kHeight * 5 / 6 && x >= kWidth / 10 && x < kWidth * 7 / 10)
+                {
+                    const auto edge = std::min({x - kWidth / 10, kWidth * 7 / 10 - 1 - x, 24});
+                    WritePixel(pixel, seed, static_cast<uint8_t>(edge >= 24 ? 255 : edge * 10));
+                }
+                break;
+            case Content::kTranslucentNoise:
+                WritePixel(pixel, seed, static_cast<uint8_t>(seed * 2654435761u >> 24));
+                break;
+            }
+        }
+    }
+
+    return frame;
+}
+} // namespace
+
+void RunAlphaBenchmarks(const BenchmarkOptions& options)
+{
+    const auto workers = std::max(1u, std::thread::hardware_concurrency());
+    FrameTaskScheduler scheduler(workers);
+    std::vector<uint8_t> output(static_cast<size_t>(kStride) * kHeight);
+
+    std::printf("milliseconds per 1080p frame; 'frame' adds the opaque pre-scan, 'parallel' uses a %u-worker scheduler\n", workers);
+    std::printf("%-20s %12s %12s %12s %12s\n", "content", "divide", "lookup", "frame", "parallel");
+
+    const struct
+    {
+        const char* name;
+        Content content;
+    } cases[] = {
+        {"opaque page", Content::kOpaquePage},
+        {"lower third", Content::kLowerThird},
+        {"translucent noise", Content::kTranslucentNoise},
+    };
+
+    for (const auto& test : cases)
+    {
+        const auto source = CreateFrame(test.content);
+        bool opaque = false;
+
+        const auto divide = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point) { UnpremultiplyDivide(source.data(), output.data(), static_cast<size_t>(kWidth) * kHeight); }, options.MeasurementDuration());
+        const auto lookup = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point) { UnpremultiplyRows(source.data(), output.data(), kStride, kWidth, 0, kHeight); }, options.MeasurementDuration());
+        const auto frame = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { UnpremultiplyFrame(source.data(), output.data(), kStride, kWidth, kHeight, nullptr, due, opaque); }, options.MeasurementDuration());
+        const auto parallel = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { UnpremultiplyFrame(source.data(), output.data(), kStride, kWidth, kHeight, &scheduler, due, opaque); }, options.MeasurementDuration());
+        std::printf("%-20s %12.3f %12.3f %12.3f %12.3f\n", test.name, divide, lookup, frame, parallel);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
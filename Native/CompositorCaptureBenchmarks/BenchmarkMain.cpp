@@ -0,0 +1,92 @@
+#include "Benchmarks.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+/// <summary>
+/// Associates a suite name with its entry point so individual suites can be selected from the command line.
+/// </summary>
+struct BenchmarkSuite
+{
+    const char* name;
+    void (*run)(const tractus::benchmarks::BenchmarkOptions& options);
+};
+
+const BenchmarkSuite kSuites[] = {
+    {"scheduler", tractus::benchmarks::RunFrameTaskSchedulerBenchmarks},
+    {"scaler", tractus::benchmarks::RunFrameScalerBenchmarks},
+    {"supersample", tractus::benchmarks::RunSupersampleBenchmarks},
+    {"alpha", tractus::benchmarks::RunAlphaBenchmarks},
+    {"wakeup", tractus::benchmarks::RunThreadPolicyBenchmarks},
+    {"memory", tractus::benchmarks::RunFrameAllocatorBenchmarks},
+    {"copy", tractus::benchmarks::RunFrameCopyBenchmarks},
+    {"counters", tractus::benchmarks::RunTelemetryCountersBenchmarks},
+    {"flight", tractus::benchmarks::RunFlightRecorderBenchmarks},
+    {"hash", tractus::benchmarks::RunContentHashBenchmarks},
+};
+
+void PrintUsage()
+{
+    std::printf("usage: CompositorCaptureBenchmarks [--quick] [suite...]\nsuites:");
+    for (const auto& suite : kSuites)
+    {
+        std::printf(" %s", suite.name);
+    }
+
+    std::printf("\n");
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    tractus::benchmarks::BenchmarkOptions options;
+    bool selected[sizeof(kSuites) / sizeof(kSuites[0])] = {};
+    bool any_selected = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--quick") == 0)
+        {
+            options.quick = true;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--help") == 0)
+        {
+            PrintUsage();
+            return 0;
+        }
+
+        bool matched = false;
+        for (size_t s = 0; s < sizeof(kSuites) / sizeof(kSuites[0]); ++s)
+        {
+            if (std::strcmp(argv[i], kSuites[s].name) == 0)
+            {
+                selected[s] = true;
+                any_selected = true;
+                matched = true;
+            }
+        }
+
+        if (!matched)
+        {
+            std::fprintf(stderr, "Unknown suite '%s'.\n", argv[i]);
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    for (size_t s = 0; s < sizeof(kSuites) / sizeof(kSuites[0]); ++s)
+    {
+        if (!any_selected || selected[s])
+        {
+            std::printf("== %s ==\n", kSuites[s].name);
+            kSuites[s].run(options);
+            std::printf("\n");
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace tractus
+{
+namespace benchmarks
+{
+/// <summary>
+/// Options shared by every benchmark suite.
+/// </summary>
+struct BenchmarkOptions
+{
+    /// <summary>Shortens each measurement so the whole run fits in a smoke test.</summary>
+    bool quick{false};
+
+    /// <summary>Gets the wall-clock budget allotted to a single measurement.</summary>
+    std::chrono::milliseconds MeasurementDuration() const
+    {
+        return quick ? std::chrono::milliseconds(200) : std::chrono::milliseconds(2000);
+    }
+};
+
+/// <summary>
+/// Sweeps the frame task scheduler from 1 to 64 workers with synthetic capture sessions.
+/// </summary>
+void RunFrameTaskSchedulerBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Measures the separable scaler at common proxy ratios, single-threaded and banded across the scheduler.
+/// </summary>
+void RunFrameScalerBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Compares the cost of resolving 2x and 4x supersampled surfaces against a plain copy of the output frame.
+/// </summary>
+void RunSupersampleBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Compares the reciprocal-table unpremultiply, with and without the opaque pre-scan, against a per-channel divide.
+/// </summary>
+void RunAlphaBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Measures how late 1 ms sleeps wake under each thread policy, idle and with every hardware thread saturated.
+/// </summary>
+void RunThreadPolicyBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Compares 4K copy, unpremultiply and downscale throughput on ordinary, large and NUMA-bound frame buffers.
+/// </summary>
+void RunFrameAllocatorBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Compares <c>memcpy</c> with the streaming <c>CopyFrame</c> on whole frames, and how much each slows a concurrent
+/// cache-resident workload.
+/// </summary>
+void RunFrameCopyBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Compares the per-frame cost of a dozen shared atomic increments with the same counts kept in per-thread
+/// <c>TelemetryCounters</c> blocks, with a capture and a sender thread running at 240 fps worth of frames.
+/// </summary>
+void RunTelemetryCountersBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Times one <c>FlightRecorder</c> event next to the clock read it contains, alone and while another thread
+/// snapshots every ring, and how long a full ring takes to format as a Chrome trace.
+/// </summary>
+void RunFlightRecorderBenchmarks(const BenchmarkOptions& options);
+
+/// <summary>
+/// Times the SSE2 and scalar <c>HashFrame</c> on whole frames next to a <c>memcmp</c> of two identical frames.
+/// </summary>
+void RunContentHashBenchmarks(const BenchmarkOptions& options);
+} // namespace benchmarks
+} // namespace tractus
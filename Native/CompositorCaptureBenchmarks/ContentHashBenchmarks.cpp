@@ -0,0 +1,83 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/ContentHash.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// <summary>
+/// Runs <paramref name="work"/> over a rotating set of frames until the measurement budget is spent and returns the
+/// mean milliseconds per frame. Several frames, so each pass reads from memory as a capture thread would.
+/// </summary>
+template <typename Work>
+double MeasureMillisecondsPerFrame(Work&& work, size_t frame_count, std::chrono::milliseconds budget)
+{
+    uint64_t frames = 0;
+    const auto start = Clock::now();
+    const auto end = start + budget;
+    auto now = start;
+    while (now < end || frames < 3)
+    {
+        work(frames % frame_count);
+        ++frames;
+        now = Clock::now();
+    }
+
+    return std::chrono::duration<double, std::milli>(now - start).count() / static_cast<double>(frames);
+}
+} // namespace
+
+void RunContentHashBenchmarks(const BenchmarkOptions& options)
+{
+    std::printf("milliseconds per frame (GB/s); 'compare' is memcmp against the previous frame, the alternative to keeping a digest\n");
+    std::printf("%-8s %18s %18s %18s\n", "frame", "sse2", "scalar", "compare");
+
+    const struct
+    {
+        const char* name;
+        int32_t width;
+        int32_t height;
+    } sizes[] = {
+        {"720p", 1280, 720},
+        {"1080p", 1920, 1080},
+        {"2160p", 3840, 2160},
+    };
+
+    for (const auto& size : sizes)
+    {
+        const auto stride = size.width * 4;
+        const auto bytes = static_cast<size_t>(stride) * size.height;
+        std::vector<std::vector<uint8_t>> frames(4, std::vector<uint8_t>(bytes));
+        for (size_t f = 0; f < frames.size(); ++f)
+        {
+            for (size_t i = 0; i < bytes; ++i)
+            {
+                frames[f][i] = static_cast<uint8_t>(((i + f) * 2654435761u) >> 24);
+            }
+        }
+
+        // Identical frames are the case that matters: a compare has to read both to the end.
+        frames[1] = frames[0];
+        frames[3] = frames[2];
+
+        std::atomic<uint64_t> sink{0};
+        const auto simd = MeasureMillisecondsPerFrame([&](size_t f) { sink.fetch_xor(HashFrame(frames[f].data(), stride, size.height, stride).low, std::memory_order_relaxed); }, frames.size(), options.MeasurementDuration());
+        const auto scalar = MeasureMillisecondsPerFrame([&](size_t f) { sink.fetch_xor(HashFrameScalar(frames[f].data(), stride, size.height, stride).low, std::memory_order_relaxed); }, frames.size(), options.MeasurementDuration());
+        const auto compare = MeasureMillisecondsPerFrame([&](size_t f) { sink.fetch_add(std::memcmp(frames[f].data(), frames[f ^ 1].data(), bytes) == 0, std::memory_order_relaxed); }, frames.size(), options.MeasurementDuration());
+
+        const auto gigabytes = static_cast<double>(bytes) / 1e6;
+        std::printf("%-8s %8.3f (%6.1f) %8.3f (%6.1f) %8.3f (%6.1f)\n", size.name, simd, gigabytes / simd, scalar, gigabytes / scalar, compare, gigabytes / compare);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
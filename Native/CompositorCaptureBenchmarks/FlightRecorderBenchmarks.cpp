@@ -0,0 +1,92 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/FlightRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// <summary>
+/// Operations timed between two clock reads.
+/// </summary>
+constexpr uint64_t kBatch = 256;
+
+/// <summary>
+/// Returns the mean nanoseconds of <paramref name="operation"/>, timed in batches so the clock reads around each
+/// batch do not swamp the few nanoseconds being measured.
+/// </summary>
+template <typename Operation>
+double Measure(Operation operation, std::chrono::milliseconds budget)
+{
+    int64_t spent = 0;
+    uint64_t count = 0;
+    const auto end = Clock::now() + budget;
+    while (Clock::now() < end)
+    {
+        const auto start = Clock::now();
+        for (uint64_t i = 0; i < kBatch; ++i)
+        {
+            operation(i);
+        }
+
+        spent += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        count += kBatch;
+    }
+
+    return static_cast<double>(spent) / static_cast<double>(std::max<uint64_t>(count, 1u));
+}
+} // namespace
+
+void RunFlightRecorderBenchmarks(const BenchmarkOptions& options)
+{
+    const auto track = static_cast<uint16_t>(std::max(0, FlightRecorder::RegisterTrack("benchmark")));
+    std::atomic<int64_t> sink{0};
+
+    const auto clock = Measure([&sink](uint64_t)
+    {
+        sink.fetch_add(Clock::now().time_since_epoch().count() & 1, std::memory_order_relaxed);
+    }, options.MeasurementDuration());
+    const auto alone = Measure([track](uint64_t i)
+    {
+        FlightRecorder::Record(FlightEvent::kFrameEnqueued, track, static_cast<int64_t>(i));
+    }, options.MeasurementDuration());
+
+    // A reader copying every ring as fast as it can, far more often than anyone dumps, to show what a snapshot costs the writers.
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> snapshots{0};
+    std::thread reader([&]()
+    {
+        while (running.load())
+        {
+            sink.fetch_add(static_cast<int64_t>(FlightRecorder::Snapshot().size()), std::memory_order_relaxed);
+            snapshots.fetch_add(1);
+        }
+    });
+    const auto snapshotting = Measure([track](uint64_t i)
+    {
+        FlightRecorder::Record(FlightEvent::kFrameEnqueued, track, static_cast<int64_t>(i));
+    }, options.MeasurementDuration());
+    running.store(false);
+    reader.join();
+
+    const auto trace_started = Clock::now();
+    const auto trace = FlightRecorder::FormatChromeTrace(FlightRecorder::Snapshot());
+    const auto trace_milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - trace_started).count();
+
+    std::printf("%-28s %10s\n", "operation", "ns/event");
+    std::printf("%-28s %10.1f\n", "steady_clock::now alone", clock);
+    std::printf("%-28s %10.1f\n", "Record", alone);
+    std::printf("%-28s %10.1f   (%llu snapshots)\n", "Record while snapshotting", snapshotting, static_cast<unsigned long long>(snapshots.load()));
+    std::printf("formatting the Chrome trace: %.1f ms for %zu bytes\n", trace_milliseconds, trace.size());
+}
+} // namespace benchmarks
+} // namespace tractus
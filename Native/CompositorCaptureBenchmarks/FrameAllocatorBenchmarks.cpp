@@ -0,0 +1,105 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/AlphaConverter.h"
+#include "../CompositorCapture/FrameAllocator.h"
+#include "../CompositorCapture/FrameScaler.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+constexpr int32_t kWidth = 3840;
+constexpr int32_t kHeight = 2160;
+constexpr int32_t kStride = kWidth * 4;
+constexpr size_t kFrameBytes = static_cast<size_t>(kStride) * kHeight;
+
+/// <summary>
+/// Runs <paramref name="work"/> back to back until the measurement budget is spent and returns the mean
+/// milliseconds per call.
+/// </summary>
+template <typename Work>
+double MeasureMilliseconds(Work&& work, std::chrono::milliseconds budget)
+{
+    work();
+
+    uint64_t calls = 0;
+    const auto start = FrameTaskClock::now();
+    const auto end = start + budget;
+    auto now = start;
+    while (now < end || calls < 3)
+    {
+        work();
+        ++calls;
+        now = FrameTaskClock::now();
+    }
+
+    return std::chrono::duration<double, std::milli>(now - start).count() / static_cast<double>(calls);
+}
+
+const char* PageKindName(FramePageKind kind)
+{
+    switch (kind)
+    {
+    case FramePageKind::kStandard:
+        return "4 KB";
+    case FramePageKind::kTransparentHuge:
+        return "THP";
+    case FramePageKind::kHuge:
+        return "huge";
+    default:
+        return "none";
+    }
+}
+} // namespace
+
+void RunFrameAllocatorBenchmarks(const BenchmarkOptions& options)
+{
+    std::printf("milliseconds per 4K (3840x2160) frame; large page size %zu KB, %d NUMA node(s)\n", LargePageSize() / 1024u, NumaNodeCount());
+    std::printf("'allocate' maps and pre-faults a fresh frame, 'scale' is bilinear 2160p->1080p\n");
+    std::printf("%-22s %6s %6s %10s %10s %13s %10s\n", "policy", "pages", "numa", "allocate", "copy", "unpremultiply", "scale");
+
+    FrameMemoryPolicy numa_local;
+    numa_local.large_pages = true;
+    numa_local.numa_node = NumaNodeForAffinity(1u);
+
+    const struct
+    {
+        const char* name;
+        FrameMemoryPolicy policy;
+    } cases[] = {
+        {"standard", FrameMemoryPolicy{}},
+        {"large pages", FrameMemoryPolicy{true, -1}},
+        {"large pages, cpu0 node", numa_local},
+    };
+
+    const FrameScaler scaler(kWidth, kHeight, kWidth / 2, kHeight / 2, ScaleFilter::kBilinear);
+    for (const auto& test : cases)
+    {
+        FrameBuffer source(test.policy);
+        FrameBuffer destination(test.policy);
+        source.assign(kFrameBytes, 0u);
+        destination.assign(kFrameBytes, 0u);
+        for (size_t i = 0; i < kFrameBytes; ++i)
+        {
+            source.data()[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+        }
+
+        const auto allocate = MeasureMilliseconds([&]()
+        {
+            FrameBuffer scratch(test.policy);
+            scratch.assign(kFrameBytes, 0u);
+        }, options.MeasurementDuration());
+        const auto copy = MeasureMilliseconds([&]() { std::memcpy(destination.data(), source.data(), kFrameBytes); }, options.MeasurementDuration());
+        const auto unpremultiply = MeasureMilliseconds([&]() { UnpremultiplyRows(source.data(), destination.data(), kStride, kWidth, 0, kHeight); }, options.MeasurementDuration());
+        const auto scale = MeasureMilliseconds([&]() { scaler.Scale(source.data(), kStride, destination.data(), kStride / 2, nullptr, FrameTaskClock::now()); }, options.MeasurementDuration());
+
+        std::printf("%-22s %6s %6s %10.3f %10.3f %13.3f %10.3f\n", test.name, PageKindName(source.page_kind()), source.numa_bound() ? "bound" : "-", allocate, copy, unpremultiply, scale);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
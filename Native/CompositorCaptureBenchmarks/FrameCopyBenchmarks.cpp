@@ -0,0 +1,129 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/FrameCopy.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+/// <summary>
+/// Working set of the cache workload: about what a raster thread keeps hot in L2 while it paints a few tiles.
+/// </summary>
+constexpr size_t kWorkingSetBytes = 1024u * 1024u;
+
+/// <summary>
+/// Stands in for a Chromium raster thread sharing the core: walks its working set one cache line at a time. A
+/// pass is fast while the lines are cached and slows down by however much the preceding copy evicted.
+/// </summary>
+class CacheWorkload
+{
+public:
+    CacheWorkload() : lines_(kWorkingSetBytes / sizeof(uint64_t), 1u) {}
+
+    /// <summary>
+    /// Makes one pass and returns how long it took in nanoseconds.
+    /// </summary>
+    int64_t Pass()
+    {
+        const auto start = Clock::now();
+        uint64_t sum = 0;
+        for (size_t i = 0; i < lines_.size(); i += 8)
+        {
+            sum += lines_[i];
+        }
+
+        sink_ = sum;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+    }
+
+private:
+    std::vector<uint64_t> lines_;
+    volatile uint64_t sink_{0};
+};
+
+struct CopyResult
+{
+    double gigabytes_per_second{0.0};
+    double pass_microseconds{0.0};
+};
+
+/// <summary>
+/// Alternates copying a frame from a rotating set of sources, as a buffering pipeline does, with one workload
+/// pass, until the measurement budget is spent. A null <paramref name="copy"/> measures the workload alone.
+/// </summary>
+CopyResult Measure(void (*copy)(uint8_t*, const uint8_t*, size_t), std::vector<std::vector<uint8_t>>& sources,
+                   std::vector<uint8_t>& destination, CacheWorkload& workload, std::chrono::milliseconds budget)
+{
+    workload.Pass();
+
+    uint64_t frames = 0;
+    int64_t copy_nanoseconds = 0;
+    int64_t pass_nanoseconds = 0;
+    const auto end = Clock::now() + budget;
+    while (Clock::now() < end || frames < 3)
+    {
+        const auto& source = sources[frames % sources.size()];
+        const auto start = Clock::now();
+        if (copy != nullptr)
+        {
+            copy(destination.data(), source.data(), source.size());
+        }
+
+        copy_nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+        pass_nanoseconds += workload.Pass();
+        ++frames;
+    }
+
+    CopyResult result;
+    result.gigabytes_per_second = copy == nullptr ? 0.0 : static_cast<double>(frames) * static_cast<double>(destination.size()) / static_cast<double>(copy_nanoseconds);
+    result.pass_microseconds = static_cast<double>(pass_nanoseconds) / 1000.0 / static_cast<double>(frames);
+    return result;
+}
+
+void OrdinaryCopy(uint8_t* destination, const uint8_t* source, size_t bytes)
+{
+    std::memcpy(destination, source, bytes);
+}
+} // namespace
+
+void RunFrameCopyBenchmarks(const BenchmarkOptions& options)
+{
+    std::printf("each copy is followed by one pass of a %zu KB cache workload; 'pass' is its mean time in microseconds\n", kWorkingSetBytes / 1024u);
+    std::printf("%-8s %10s %14s %10s %14s %10s\n", "frame", "idle pass", "memcpy GB/s", "pass", "CopyFrame GB/s", "pass");
+
+    const struct
+    {
+        const char* name;
+        size_t width;
+        size_t height;
+    } cases[] = {
+        {"720p", 1280, 720},
+        {"1080p", 1920, 1080},
+        {"2160p", 3840, 2160},
+    };
+
+    CacheWorkload workload;
+    for (const auto& test : cases)
+    {
+        const auto bytes = test.width * test.height * 4u;
+        // Several sources, so no frame is still cached from the previous copy.
+        std::vector<std::vector<uint8_t>> sources(4, std::vector<uint8_t>(bytes, 0x5Au));
+        std::vector<uint8_t> destination(bytes, 0u);
+
+        const auto idle = Measure(nullptr, sources, destination, workload, options.MeasurementDuration());
+        const auto ordinary = Measure(OrdinaryCopy, sources, destination, workload, options.MeasurementDuration());
+        const auto streaming = Measure(CopyFrame, sources, destination, workload, options.MeasurementDuration());
+        std::printf("%-8s %10.1f %14.2f %10.1f %14.2f %10.1f\n", test.name, idle.pass_microseconds, ordinary.gigabytes_per_second,
+                    ordinary.pass_microseconds, streaming.gigabytes_per_second, streaming.pass_microseconds);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
@@ -0,0 +1,96 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/FrameScaler.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+/// <summary>
+/// Source and destination sizes for one measured scaling ratio.
+/// </summary>
+struct ScaleCase
+{
+    const char* label;
+    int32_t source_width;
+    int32_t source_height;
+    int32_t destination_width;
+    int32_t destination_height;
+};
+
+const ScaleCase kScaleCases[] = {
+    {"1080p->540p (1/2)", 1920, 1080, 960, 540},
+    {"1080p->720p (2/3)", 1920, 1080, 1280, 720},
+    {"1080p->360p (1/3)", 1920, 1080, 640, 360},
+    {"1080p->270p (1/4)", 1920, 1080, 480, 270},
+    {"2160p->1080p (1/2)", 3840, 2160, 1920, 1080},
+    {"720p->1080p (3/2)", 1280, 720, 1920, 1080},
+};
+
+const char* FilterName(ScaleFilter filter)
+{
+    return filter == ScaleFilter::kLanczos3 ? "lanczos3" : "bilinear";
+}
+
+/// <summary>
+/// Scales frames back to back until the measurement budget is spent and returns the mean milliseconds per frame.
+/// </summary>
+double MeasureMillisecondsPerFrame(const FrameScaler& scaler, const std::vector<uint8_t>& source, std::vector<uint8_t>& destination,
+                                   FrameTaskScheduler* scheduler, std::chrono::milliseconds budget)
+{
+    const auto source_stride = scaler.SourceWidth() * 4;
+    const auto destination_stride = scaler.DestinationWidth() * 4;
+
+    // Warm the coefficient tables, ring buffers and caches before timing.
+    scaler.Scale(source.data(), source_stride, destination.data(), destination_stride, scheduler, FrameTaskClock::now());
+
+    uint64_t frames = 0;
+    const auto start = FrameTaskClock::now();
+    const auto end = start + budget;
+    auto now = start;
+    while (now < end || frames < 3)
+    {
+        scaler.Scale(source.data(), source_stride, destination.data(), destination_stride, scheduler, now + std::chrono::milliseconds(16));
+        ++frames;
+        now = FrameTaskClock::now();
+    }
+
+    return std::chrono::duration<double, std::milli>(now - start).count() / static_cast<double>(frames);
+}
+} // namespace
+
+void RunFrameScalerBenchmarks(const BenchmarkOptions& options)
+{
+    const auto workers = std::max(1u, std::thread::hardware_concurrency());
+    FrameTaskScheduler scheduler(workers);
+
+    std::printf("milliseconds per frame; 'parallel' uses a %u-worker scheduler\n", workers);
+    std::printf("%-20s %-9s %12s %12s %12s\n", "ratio", "filter", "1 thread", "parallel", "Mpix/s (1t)");
+
+    for (const auto& scale_case : kScaleCases)
+    {
+        std::vector<uint8_t> source(static_cast<size_t>(scale_case.source_width) * scale_case.source_height * 4u);
+        for (size_t i = 0; i < source.size(); ++i)
+        {
+            source[i] = static_cast<uint8_t>((i * 7u) ^ (i >> 11));
+        }
+
+        std::vector<uint8_t> destination(static_cast<size_t>(scale_case.destination_width) * scale_case.destination_height * 4u);
+        for (const auto filter : {ScaleFilter::kBilinear, ScaleFilter::kLanczos3})
+        {
+            FrameScaler scaler(scale_case.source_width, scale_case.source_height, scale_case.destination_width, scale_case.destination_height, filter);
+            const auto serial = MeasureMillisecondsPerFrame(scaler, source, destination, nullptr, options.MeasurementDuration());
+            const auto parallel = MeasureMillisecondsPerFrame(scaler, source, destination, &scheduler, options.MeasurementDuration());
+            const auto megapixels = static_cast<double>(scale_case.destination_width) * scale_case.destination_height / 1e6;
+            std::printf("%-20s %-9s %12.3f %12.3f %12.1f\n", scale_case.label, FilterName(filter), serial, parallel, megapixels / (serial / 1000.0));
+        }
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
@@ -0,0 +1,188 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/FrameTaskScheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+constexpr int kFrameWidth = 1280;
+constexpr int kFrameHeight = 720;
+constexpr size_t kRowsPerBand = 45;
+constexpr int kSessionCount = 8;
+constexpr int kMaxOutstandingRecordings = 4;
+constexpr auto kConversionBudget = std::chrono::milliseconds(2);
+
+/// <summary>
+/// Results gathered from one synthetic session during a measurement window.
+/// </summary>
+struct SessionResult
+{
+    uint64_t frames{0};
+    uint64_t late_conversions{0};
+    uint64_t dropped_recordings{0};
+};
+
+/// <summary>
+/// Emulates a capture session: each frame converts BGRA rows into luma on the deadline lane, hashes the
+/// result as a normal job and copies it into a recording buffer as a background job.
+/// </summary>
+class SyntheticSession
+{
+public:
+    explicit SyntheticSession(FrameTaskScheduler& scheduler)
+        : scheduler_(scheduler),
+          source_(static_cast<size_t>(kFrameWidth) * kFrameHeight * 4u),
+          luma_(static_cast<size_t>(kFrameWidth) * kFrameHeight),
+          recording_(luma_.size())
+    {
+        for (size_t i = 0; i < source_.size(); ++i)
+        {
+            source_[i] = static_cast<uint8_t>(i * 31u);
+        }
+    }
+
+    SessionResult Run(FrameTaskClock::time_point end)
+    {
+        SessionResult result;
+        while (FrameTaskClock::now() < end)
+        {
+            const auto due = FrameTaskClock::now() + kConversionBudget;
+            scheduler_.ParallelFor(kFrameHeight, kRowsPerBand, due, [this](size_t begin, size_t finish) { ConvertRows(begin, finish); });
+            if (FrameTaskClock::now() > due)
+            {
+                ++result.late_conversions;
+            }
+
+            outstanding_hashes_.fetch_add(1);
+            scheduler_.Submit([this]()
+            {
+                hash_ = HashLuma();
+                outstanding_hashes_.fetch_sub(1);
+            }, FrameTaskPriority::kNormal);
+
+            if (outstanding_recordings_.load() < kMaxOutstandingRecordings)
+            {
+                outstanding_recordings_.fetch_add(1);
+                scheduler_.Submit([this]()
+                {
+                    std::memcpy(recording_.data(), luma_.data(), luma_.size());
+                    outstanding_recordings_.fetch_sub(1);
+                }, FrameTaskPriority::kBackground);
+            }
+            else
+            {
+                ++result.dropped_recordings;
+            }
+
+            ++result.frames;
+        }
+
+        while (outstanding_recordings_.load() > 0 || outstanding_hashes_.load() > 0)
+        {
+            std::this_thread::yield();
+        }
+
+        return result;
+    }
+
+private:
+    void ConvertRows(size_t begin, size_t end)
+    {
+        for (size_t y = begin; y < end; ++y)
+        {
+            const auto* src = source_.data() + y * kFrameWidth * 4u;
+            auto* dst = luma_.data() + y * kFrameWidth;
+            for (int x = 0; x < kFrameWidth; ++x)
+            {
+                const uint32_t b = src[x * 4];
+                const uint32_t g = src[x * 4 + 1];
+                const uint32_t r = src[x * 4 + 2];
+                dst[x] = static_cast<uint8_t>((47u * r + 157u * g + 16u * b + 128u) >> 8);
+            }
+        }
+    }
+
+    uint64_t HashLuma() const
+    {
+        uint64_t hash = 1469598103934665603ull;
+        for (size_t i = 0; i < luma_.size(); i += 64)
+        {
+            hash = (hash ^ luma_[i]) * 1099511628211ull;
+        }
+
+        return hash;
+    }
+
+    FrameTaskScheduler& scheduler_;
+    std::vector<uint8_t> source_;
+    std::vector<uint8_t> luma_;
+    std::vector<uint8_t> recording_;
+    std::atomic<int> outstanding_recordings_{0};
+    std::atomic<int> outstanding_hashes_{0};
+    std::atomic<uint64_t> hash_{0};
+};
+} // namespace
+
+void RunFrameTaskSchedulerBenchmarks(const BenchmarkOptions& options)
+{
+    std::printf("%d synthetic %dx%d sessions, conversion budget %lld ms, hardware threads %u\n",
+                kSessionCount, kFrameWidth, kFrameHeight,
+                static_cast<long long>(kConversionBudget.count()), std::thread::hardware_concurrency());
+    std::printf("%8s %12s %12s %10s %10s %10s %10s\n", "workers", "frames/s", "jobs/s", "late", "misses", "steals", "rec-drop");
+
+    for (size_t workers = 1; workers <= 64; workers *= 2)
+    {
+        FrameTaskScheduler scheduler(workers);
+        std::vector<std::unique_ptr<SyntheticSession>> sessions;
+        for (int i = 0; i < kSessionCount; ++i)
+        {
+            sessions.push_back(std::make_unique<SyntheticSession>(scheduler));
+        }
+
+        std::vector<SessionResult> results(sessions.size());
+        std::vector<std::thread> threads;
+        const auto start = FrameTaskClock::now();
+        const auto end = start + options.MeasurementDuration();
+        for (size_t i = 0; i < sessions.size(); ++i)
+        {
+            threads.emplace_back([&, i]() { results[i] = sessions[i]->Run(end); });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        const auto elapsed = std::chrono::duration<double>(FrameTaskClock::now() - start).count();
+        SessionResult total;
+        for (const auto& result : results)
+        {
+            total.frames += result.frames;
+            total.late_conversions += result.late_conversions;
+            total.dropped_recordings += result.dropped_recordings;
+        }
+
+        const auto stats = scheduler.GetStats();
+        const auto jobs = stats.executed[0] + stats.executed[1] + stats.executed[2];
+        std::printf("%8zu %12.1f %12.1f %10llu %10llu %10llu %10llu\n",
+                    workers,
+                    total.frames / elapsed,
+                    jobs / elapsed,
+                    static_cast<unsigned long long>(total.late_conversions),
+                    static_cast<unsigned long long>(stats.deadline_misses),
+                    static_cast<unsigned long long>(stats.steals),
+                    static_cast<unsigned long long>(total.dropped_recordings));
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
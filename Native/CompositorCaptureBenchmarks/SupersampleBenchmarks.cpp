@@ -0,0 +1,126 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/BoxDownsampler.h"
+#include "../CompositorCapture/FrameScaler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+constexpr int32_t kOutputWidth = 1920;
+constexpr int32_t kOutputHeight = 1080;
+constexpr size_t kBandRows = 32;
+
+/// <summary>
+/// Runs <paramref name="resolve"/> back to back until the measurement budget is spent and returns the mean
+/// milliseconds per frame.
+/// </summary>
+template <typename Resolve>
+double MeasureMillisecondsPerFrame(Resolve&& resolve, std::chrono::milliseconds budget)
+{
+    resolve(FrameTaskClock::now());
+
+    uint64_t frames = 0;
+    const auto start = FrameTaskClock::now();
+    const auto end = start + budget;
+    auto now = start;
+    while (now < end || frames < 3)
+    {
+        resolve(now + std::chrono::milliseconds(16));
+        ++frames;
+        now = FrameTaskClock::now();
+    }
+
+    return std::chrono::duration<double, std::milli>(now - start).count() / static_cast<double>(frames);
+}
+
+std::vector<uint8_t> CreateSurface(int32_t factor)
+{
+    std::vector<uint8_t> surface(static_cast<size_t>(kOutputWidth) * factor * kOutputHeight * factor * 4u);
+    for (size_t i = 0; i < surface.size(); ++i)
+    {
+        surface[i] = static_cast<uint8_t>((i * 13u) ^ (i >> 9));
+    }
+
+    return surface;
+}
+} // namespace
+
+void RunSupersampleBenchmarks(const BenchmarkOptions& options)
+{
+    const auto workers = std::max(1u, std::thread::hardware_concurrency());
+    FrameTaskScheduler scheduler(workers);
+    const auto output_stride = kOutputWidth * 4;
+    std::vector<uint8_t> output(static_cast<size_t>(output_stride) * kOutputHeight);
+
+    std::printf("milliseconds per 1080p output frame; 'parallel' uses a %u-worker scheduler\n", workers);
+    std::printf("%-24s %12s %12s\n", "resolve", "1 thread", "parallel");
+
+    {
+        const auto source = CreateSurface(1);
+        auto copy = [&](FrameTaskScheduler* pool, FrameTaskClock::time_point due)
+        {
+            auto body = [&](size_t begin, size_t end)
+            {
+                std::memcpy(output.data() + begin * output_stride, source.data() + begin * output_stride, (end - begin) * output_stride);
+            };
+
+            if (pool)
+            {
+                pool->ParallelFor(kOutputHeight, kBandRows, due, body);
+            }
+            else
+            {
+                body(0, kOutputHeight);
+            }
+        };
+
+        const auto serial = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { copy(nullptr, due); }, options.MeasurementDuration());
+        const auto parallel = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { copy(&scheduler, due); }, options.MeasurementDuration());
+        std::printf("%-24s %12.3f %12.3f\n", "1x memcpy (baseline)", serial, parallel);
+    }
+
+    for (const auto factor : {2, 4})
+    {
+        const auto surface = CreateSurface(factor);
+        const auto surface_stride = output_stride * factor;
+
+        auto box = [&](FrameTaskScheduler* pool, FrameTaskClock::time_point due)
+        {
+            auto body = [&](size_t begin, size_t end)
+            {
+                DownsampleBox(surface.data(), surface_stride, output.data(), output_stride, kOutputWidth, static_cast<int32_t>(begin), static_cast<int32_t>(end), factor);
+            };
+
+            if (pool)
+            {
+                pool->ParallelFor(kOutputHeight, kBandRows / static_cast<size_t>(factor), due, body);
+            }
+            else
+            {
+                body(0, kOutputHeight);
+            }
+        };
+
+        char label[32];
+        std::snprintf(label, sizeof(label), "%dx box", factor);
+        auto serial = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { box(nullptr, due); }, options.MeasurementDuration());
+        auto parallel = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { box(&scheduler, due); }, options.MeasurementDuration());
+        std::printf("%-24s %12.3f %12.3f\n", label, serial, parallel);
+
+        FrameScaler scaler(kOutputWidth * factor, kOutputHeight * factor, kOutputWidth, kOutputHeight, ScaleFilter::kLanczos3);
+        std::snprintf(label, sizeof(label), "%dx lanczos3", factor);
+        serial = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { scaler.Scale(surface.data(), surface_stride, output.data(), output_stride, nullptr, due); }, options.MeasurementDuration());
+        parallel = MeasureMillisecondsPerFrame([&](FrameTaskClock::time_point due) { scaler.Scale(surface.data(), surface_stride, output.data(), output_stride, &scheduler, due); }, options.MeasurementDuration());
+        std::printf("%-24s %12.3f %12.3f\n", label, serial, parallel);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
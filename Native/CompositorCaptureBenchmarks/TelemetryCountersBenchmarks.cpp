@@ -0,0 +1,122 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/TelemetryCounters.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kFrameInterval = std::chrono::nanoseconds(1000000000 / 240);
+
+/// <summary>
+/// Counter updates each thread makes per frame, about what the capture and sender paths of the pipeline make.
+/// </summary>
+constexpr int32_t kIncrementsPerFrame = 12;
+
+/// <summary>
+/// The layout being replaced: every counter in one shared array, updated with locked read-modify-writes.
+/// </summary>
+std::array<std::atomic<uint64_t>, kTelemetryCounterCount> shared_counters{};
+
+void SharedIncrements(int32_t role)
+{
+    for (int32_t i = 0; i < kIncrementsPerFrame; ++i)
+    {
+        shared_counters[static_cast<size_t>(role + i) % kTelemetryCounterCount].fetch_add(1);
+    }
+}
+
+void PerThreadIncrements(int32_t role)
+{
+    for (int32_t i = 0; i < kIncrementsPerFrame; ++i)
+    {
+        TelemetryCounters::Add(static_cast<TelemetryCounter>(static_cast<size_t>(role + i) % kTelemetryCounterCount));
+    }
+}
+
+/// <summary>
+/// Runs a capture and a sender thread that each make one frame's increments per iteration, paced to 240 fps or
+/// back to back, while a third thread snapshots at telemetry rate. Returns the mean nanoseconds per frame spent
+/// in the increments.
+/// </summary>
+double Measure(void (*increments)(int32_t), bool paced, std::chrono::milliseconds budget)
+{
+    std::atomic<int64_t> nanoseconds{0};
+    std::atomic<uint64_t> frames{0};
+    std::atomic<bool> running{true};
+
+    auto worker = [&](int32_t role)
+    {
+        int64_t spent = 0;
+        uint64_t count = 0;
+        auto next = Clock::now();
+        const auto end = next + budget;
+        // Back-to-back frames are timed in batches so the clock reads do not swamp a few nanoseconds of work.
+        const uint64_t batch = paced ? 1u : 256u;
+        while (Clock::now() < end)
+        {
+            const auto start = Clock::now();
+            for (uint64_t i = 0; i < batch; ++i)
+            {
+                increments(role);
+            }
+
+            spent += std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+            count += batch;
+            if (paced)
+            {
+                next += kFrameInterval;
+                std::this_thread::sleep_until(next);
+            }
+        }
+
+        nanoseconds.fetch_add(spent);
+        frames.fetch_add(count);
+    };
+
+    std::thread reader([&]()
+    {
+        while (running.load())
+        {
+            TelemetryCounters::Snapshot();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    });
+
+    std::thread capture(worker, 0);
+    std::thread sender(worker, 1);
+    capture.join();
+    sender.join();
+    running.store(false);
+    reader.join();
+
+    return static_cast<double>(nanoseconds.load()) / static_cast<double>(std::max<uint64_t>(frames.load(), 1u));
+}
+} // namespace
+
+void RunTelemetryCountersBenchmarks(const BenchmarkOptions& options)
+{
+    const auto frame_nanoseconds = static_cast<double>(kFrameInterval.count());
+    std::printf("capture and sender threads each make %d counter updates per frame; 'budget' is the share of a 240 fps frame\n", kIncrementsPerFrame);
+    std::printf("%-8s %14s %10s %14s %10s\n", "pacing", "shared ns", "budget", "per-thread ns", "budget");
+
+    for (const bool paced : {true, false})
+    {
+        const auto shared = Measure(SharedIncrements, paced, options.MeasurementDuration());
+        const auto per_thread = Measure(PerThreadIncrements, paced, options.MeasurementDuration());
+        std::printf("%-8s %14.1f %9.4f%% %14.1f %9.4f%%\n", paced ? "240 fps" : "burst", shared, shared * 100.0 / frame_nanoseconds,
+                    per_thread, per_thread * 100.0 / frame_nanoseconds);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
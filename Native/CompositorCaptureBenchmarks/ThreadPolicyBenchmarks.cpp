@@ -0,0 +1,159 @@
+#include "Benchmarks.h"
+
+#include "../CompositorCapture/ThreadPolicy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace benchmarks
+{
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kPeriod = std::chrono::milliseconds(1);
+
+struct WakeupLatency
+{
+    ThreadPolicyOutcome outcome;
+    double p50_microseconds{0.0};
+    double p99_microseconds{0.0};
+    double max_microseconds{0.0};
+};
+
+/// <summary>
+/// Sleeps to a 1 ms grid on a fresh thread running under <paramref name="policy"/> and records how late each wakeup
+/// arrives, the way the capture loop waits for its next frame deadline.
+/// </summary>
+WakeupLatency MeasureWakeups(const ThreadPolicy& policy, std::chrono::milliseconds budget)
+{
+    WakeupLatency result;
+    std::thread sleeper([&]()
+    {
+        const ScopedThreadPolicy applied(policy);
+        result.outcome = applied.Outcome();
+
+        std::vector<double> lateness;
+        lateness.reserve(static_cast<size_t>(budget / kPeriod) + 1u);
+        const auto end = Clock::now() + budget;
+        auto deadline = Clock::now();
+        while (deadline < end)
+        {
+            deadline += kPeriod;
+            std::this_thread::sleep_until(deadline);
+            lateness.push_back(std::chrono::duration<double, std::micro>(Clock::now() - deadline).count());
+        }
+
+        std::sort(lateness.begin(), lateness.end());
+        result.p50_microseconds = lateness[lateness.size() / 2];
+        result.p99_microseconds = lateness[lateness.size() * 99 / 100];
+        result.max_microseconds = lateness.back();
+    });
+    sleeper.join();
+    return result;
+}
+
+/// <summary>
+/// Keeps every hardware thread busy at normal priority, standing in for Chromium's raster and renderer threads.
+/// </summary>
+class BackgroundLoad
+{
+public:
+    explicit BackgroundLoad(unsigned threads)
+    {
+        for (unsigned i = 0; i < threads; ++i)
+        {
+            threads_.emplace_back([this]()
+            {
+                volatile uint64_t sink = 0;
+                while (!stop_.load(std::memory_order_relaxed))
+                {
+                    sink = sink * 6364136223846793005ull + 1442695040888963407ull;
+                }
+            });
+        }
+    }
+
+    ~BackgroundLoad()
+    {
+        stop_.store(true);
+        for (auto& thread : threads_)
+        {
+            thread.join();
+        }
+    }
+
+private:
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+const char* PriorityName(ThreadPriorityClass priority)
+{
+    switch (priority)
+    {
+    case ThreadPriorityClass::kHigh:
+        return "high";
+    case ThreadPriorityClass::kRealtime:
+        return "realtime";
+    default:
+        return "normal";
+    }
+}
+} // namespace
+
+void RunThreadPolicyBenchmarks(const BenchmarkOptions& options)
+{
+    const auto workers = std::max(1u, std::thread::hardware_concurrency());
+    const auto budget = options.MeasurementDuration();
+
+    ThreadPolicy high;
+    high.priority = ThreadPriorityClass::kHigh;
+    ThreadPolicy realtime;
+    realtime.priority = ThreadPriorityClass::kRealtime;
+    ThreadPolicy tuned = realtime;
+    tuned.timer_slack_nanoseconds = 1000;
+    ThreadPolicy pinned = tuned;
+    pinned.affinity_mask = 1u;
+
+    const struct
+    {
+        const char* name;
+        ThreadPolicy policy;
+    } cases[] = {
+        {"default", ThreadPolicy{}},
+        {"high", high},
+        {"realtime", realtime},
+        {"realtime, 1us slack", tuned},
+        {"... pinned to cpu 0", pinned},
+    };
+
+    std::printf("lateness of 1 ms sleeps in microseconds; 'loaded' spins %u normal-priority threads alongside\n", workers);
+    std::printf("%-22s %-9s %9s %9s %9s %9s %9s %9s\n", "policy", "granted", "idle p50", "idle p99", "idle max", "load p50", "load p99", "load max");
+    for (const auto& test : cases)
+    {
+        const auto idle = MeasureWakeups(test.policy, budget);
+        WakeupLatency loaded;
+        {
+            BackgroundLoad load(workers);
+            loaded = MeasureWakeups(test.policy, budget);
+        }
+
+        std::printf("%-22s %-9s %9.1f %9.1f %9.1f %9.1f %9.1f %9.1f\n",
+                    test.name,
+                    PriorityName(loaded.outcome.priority),
+                    idle.p50_microseconds,
+                    idle.p99_microseconds,
+                    idle.max_microseconds,
+                    loaded.p50_microseconds,
+                    loaded.p99_microseconds,
+                    loaded.max_microseconds);
+    }
+}
+} // namespace benchmarks
+} // namespace tractus
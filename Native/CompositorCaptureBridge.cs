@@ -1,8 +1,10 @@
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Runtime.InteropServices;
 using CefSharp;
 using Serilog;
+using Tractus.HtmlToNdi.Models;
 using Tractus.HtmlToNdi.Video;
 
 namespace Tractus.HtmlToNdi.Native;
@@ -12,10 +14,28 @@ namespace Tractus.HtmlToNdi.Native;
 /// </summary>
 internal sealed class CompositorCaptureBridge : IDisposable
 {
+    /// <summary>
+    /// The C ABI version of <c>CompositorCapture.h</c> the native structs below mirror.
+    /// </summary>
+    internal const uint NativeAbiVersion = 1;
+
+    /// <summary>
+    /// <c>CompositorMemoryPool::kPipeline</c>, the pool managed pipeline frames are charged to.
+    /// </summary>
+    private const int NativePipelineMemoryPool = 3;
+
+    private static volatile bool nativeCopyUnavailable;
+    private static volatile bool nativeHashUnavailable;
+    private static volatile bool nativeBudgetUnavailable;
+    private static volatile bool nativeFlightRecorderUnavailable;
     private readonly ILogger logger;
     private SafeCompositorCaptureHandle? sessionHandle;
     private GCHandle selfHandle;
     private FrameReadyCallback? frameCallback;
+    private FrameReadyCallback? renditionCallback;
+    private readonly List<GCHandle> renditionHandles = new();
+    private (LayerCompositorBridge Compositor, int ZOrder, int DelayFrames)? layerAttachment;
+    private bool injectingFaults;
     private bool disposed;
 
     /// <summary>
@@ -32,6 +52,370 @@ internal sealed class CompositorCaptureBridge : IDisposable
     /// </summary>
     internal event EventHandler<CapturedFrame>? FrameArrived;
 
+    /// <summary>
+    /// Occurs when the native helper has scaled a captured frame into one of the requested renditions.
+    /// </summary>
+    internal event EventHandler<RenditionFrameEventArgs>? RenditionFrameArrived;
+
+    /// <summary>
+    /// Routes this session's frames into a layer compositor instead of <see cref="FrameArrived"/>. Must be called
+    /// before <see cref="TryStart"/>; renditions are still raised through <see cref="RenditionFrameArrived"/>.
+    /// </summary>
+    /// <param name="compositor">The compositor that blends this session with other layers.</param>
+    /// <param name="zOrder">The layer position; higher layers are drawn on top.</param>
+    /// <param name="delayFrames">How many of its own frames this layer is held back by.</param>
+    internal void AttachToLayerCompositor(LayerCompositorBridge compositor, int zOrder, int delayFrames)
+    {
+        layerAttachment = (compositor ?? throw new ArgumentNullException(nameof(compositor)), zOrder, delayFrames);
+    }
+
+    /// <summary>
+    /// Asks the native helper which ABI version, features and SIMD tiers it supports.
+    /// </summary>
+    /// <param name="capabilities">When this method returns <c>true</c>, contains the helper's capabilities.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the helper could not be queried.</param>
+    /// <returns><c>true</c> when the helper is loadable and speaks a compatible ABI; otherwise <c>false</c>.</returns>
+    internal static bool TryQueryCapabilities(out CompositorCapabilities? capabilities, out string? error)
+    {
+        capabilities = null;
+        var native = new NativeCapabilities
+        {
+            StructSize = (uint)Marshal.SizeOf<NativeCapabilities>(),
+        };
+
+        try
+        {
+            if (NativeMethods.cc_query_capabilities(ref native) != 0)
+            {
+                error = "The compositor capture helper rejected the capability query.";
+                return false;
+            }
+        }
+        catch (DllNotFoundException ex)
+        {
+            error = ex.Message;
+            return false;
+        }
+        catch (EntryPointNotFoundException)
+        {
+            error = "The compositor capture helper predates the versioned ABI; rebuild Native/CompositorCapture.";
+            return false;
+        }
+
+        if (native.AbiVersion < NativeAbiVersion)
+        {
+            error = $"The compositor capture helper reports ABI version {native.AbiVersion}; version {NativeAbiVersion} or later is required.";
+            return false;
+        }
+
+        capabilities = new CompositorCapabilities(
+            (int)native.AbiVersion,
+            (CompositorPixelFormats)native.PixelFormats,
+            (CompositorFeatures)native.Features,
+            (CompositorSimdLevel)native.CompiledSimdLevel,
+            (CompositorSimdLevel)native.CpuSimdLevel,
+            native.MaxSupersampleFactor,
+            native.MaxLayers,
+            native.SchedulerWorkers,
+            native.SourceFramePoolDepth,
+            native.ClockResolutionNanoseconds / 1000.0,
+            native.SleepResolutionNanoseconds / 1_000_000.0,
+            native.LargePageBytes,
+            Math.Max(1, native.NumaNodeCount));
+        error = null;
+        return true;
+    }
+
+    /// <summary>
+    /// Copies a frame with the helper's cache-bypassing copy so moving 4K frames does not evict Chromium's working
+    /// set. Falls back to <see cref="Buffer.MemoryCopy"/> for good once the helper turns out not to be loadable.
+    /// </summary>
+    /// <param name="destination">The destination buffer.</param>
+    /// <param name="source">The source buffer, which must not overlap <paramref name="destination"/>.</param>
+    /// <param name="bytes">The number of bytes to copy.</param>
+    internal static unsafe void CopyFrame(IntPtr destination, IntPtr source, long bytes)
+    {
+        if (!nativeCopyUnavailable)
+        {
+            try
+            {
+                NativeMethods.cc_copy_frame(destination, source, (nuint)bytes);
+                return;
+            }
+            catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+            {
+                nativeCopyUnavailable = true;
+            }
+        }
+
+        Buffer.MemoryCopy((void*)source, (void*)destination, bytes, bytes);
+    }
+
+    /// <summary>
+    /// Hashes the visible bytes of each row with the helper's SSE2 kernel. Falls back to the identical managed port
+    /// for good once the helper turns out not to be loadable.
+    /// </summary>
+    /// <param name="pixels">The first row of the frame.</param>
+    /// <param name="rowBytes">The visible bytes of each row.</param>
+    /// <param name="height">The number of rows.</param>
+    /// <param name="stride">The distance between rows in bytes.</param>
+    /// <returns>The digest.</returns>
+    internal static FrameContentHash HashFrame(IntPtr pixels, int rowBytes, int height, int stride)
+    {
+        if (!nativeHashUnavailable)
+        {
+            try
+            {
+                var hash = new NativeContentHash();
+                if (NativeMethods.cc_hash_frame(pixels, rowBytes, height, stride, ref hash) == 0)
+                {
+                    return new FrameContentHash(hash.Low, hash.High);
+                }
+            }
+            catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+            {
+                nativeHashUnavailable = true;
+            }
+        }
+
+        return FrameContentHash.ComputeManaged(pixels, rowBytes, height, stride);
+    }
+
+    /// <summary>
+    /// Caps the frame memory of the helper's pools and the pipelines' buffered frames.
+    /// </summary>
+    /// <param name="bytes">The budget in bytes, or 0 to remove it.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the budget could not be set.</param>
+    /// <returns><c>true</c> when the helper accepted the budget; otherwise <c>false</c>.</returns>
+    internal static bool TrySetFrameMemoryBudget(long bytes, out string? error)
+    {
+        try
+        {
+            if (NativeMethods.cc_set_frame_memory_budget(bytes) != 0)
+            {
+                error = "The compositor capture helper rejected the frame memory budget.";
+                return false;
+            }
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            error = ex.Message;
+            return false;
+        }
+
+        error = null;
+        return true;
+    }
+
+    /// <summary>
+    /// Reads the budget, use, high-water marks and refusals of the frame pools.
+    /// </summary>
+    /// <param name="statistics">When this method returns <c>true</c>, contains the figures.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the helper could not be queried.</param>
+    /// <returns><c>true</c> when the helper reported its figures; otherwise <c>false</c>.</returns>
+    internal static bool TryGetMemoryStatistics(out FrameMemoryStatistics? statistics, out string? error)
+    {
+        statistics = null;
+        var native = new NativeMemoryStats
+        {
+            StructSize = (uint)Marshal.SizeOf<NativeMemoryStats>(),
+        };
+
+        try
+        {
+            if (NativeMethods.cc_get_memory_stats(ref native) != 0)
+            {
+                error = "The compositor capture helper rejected the memory statistics query.";
+                return false;
+            }
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            error = ex.Message;
+            return false;
+        }
+
+        statistics = new FrameMemoryStatistics(
+            (long)native.BudgetBytes,
+            (long)native.InUseBytes,
+            (long)native.HighWaterBytes,
+            (long)native.Refusals,
+            (long)native.TrimmedBytes,
+            native.Capture.ToModel(),
+            native.Renditions.ToModel(),
+            native.Layers.ToModel(),
+            native.Pipeline.ToModel());
+        error = null;
+        return true;
+    }
+
+    /// <summary>
+    /// Sums the helper's per-thread event counters.
+    /// </summary>
+    /// <param name="counters">When this method returns <c>true</c>, contains the counts.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the helper could not be queried.</param>
+    /// <returns><c>true</c> when the helper reported its counts; otherwise <c>false</c>.</returns>
+    internal static bool TryGetCounters(out CompositorCounters? counters, out string? error)
+    {
+        counters = null;
+        var native = new NativeCounters
+        {
+            StructSize = (uint)Marshal.SizeOf<NativeCounters>(),
+        };
+
+        try
+        {
+            if (NativeMethods.cc_get_counters(ref native) != 0)
+            {
+                error = "The compositor capture helper rejected the counters query.";
+                return false;
+            }
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            error = ex.Message;
+            return false;
+        }
+
+        counters = new CompositorCounters(
+            (long)native.FramesCaptured,
+            (long)native.FramesDelivered,
+            (long)native.LayerFramesSubmitted,
+            (long)native.RenditionFramesDelivered,
+            (long)native.OverlayFrames,
+            (long)native.CompositesDelivered,
+            (long)native.TilesComposed,
+            (long)native.TilesSkipped,
+            native.FrameConversion.ToModel(),
+            native.RenditionConversion.ToModel(),
+            native.Composite.ToModel());
+        error = null;
+        return true;
+    }
+
+    /// <summary>
+    /// Charges managed pipeline frames to the helper's pipeline pool. Succeeds without charging anything once the
+    /// helper turns out not to be loadable, since there is then no budget to enforce.
+    /// </summary>
+    /// <param name="bytes">The bytes to charge.</param>
+    /// <param name="required">Whether to charge the bytes even when they exceed the budget.</param>
+    /// <returns><c>false</c> when the bytes do not fit in the budget.</returns>
+    internal static bool TryReserveFrameMemory(long bytes, bool required)
+    {
+        if (nativeBudgetUnavailable)
+        {
+            return true;
+        }
+
+        try
+        {
+            return NativeMethods.cc_reserve_frame_memory(NativePipelineMemoryPool, bytes, required ? 1 : 0) != -2;
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            nativeBudgetUnavailable = true;
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Returns bytes charged by <see cref="TryReserveFrameMemory"/>.
+    /// </summary>
+    /// <param name="bytes">The bytes to return.</param>
+    internal static void ReleaseFrameMemory(long bytes)
+    {
+        if (nativeBudgetUnavailable)
+        {
+            return;
+        }
+
+        try
+        {
+            NativeMethods.cc_release_frame_memory(NativePipelineMemoryPool, bytes);
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            nativeBudgetUnavailable = true;
+        }
+    }
+
+    /// <summary>
+    /// Registers a flight recorder track, which shows as a process of its own in dumped traces.
+    /// </summary>
+    /// <param name="name">The track name, normally the NDI source name of the pipeline.</param>
+    /// <param name="track">When this method returns <c>true</c>, contains the track id to record against.</param>
+    /// <returns><c>true</c> when the helper registered the track; otherwise <c>false</c>.</returns>
+    internal static bool TryRegisterFlightTrack(string name, out int track)
+    {
+        track = -1;
+        if (nativeFlightRecorderUnavailable)
+        {
+            return false;
+        }
+
+        try
+        {
+            track = NativeMethods.cc_flight_register_track(name);
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            nativeFlightRecorderUnavailable = true;
+            return false;
+        }
+
+        return track >= 0;
+    }
+
+    /// <summary>
+    /// Appends an event to the calling thread's flight recorder ring. Does nothing once the helper turns out not to
+    /// be loadable.
+    /// </summary>
+    /// <param name="track">A track from <see cref="TryRegisterFlightTrack"/>.</param>
+    /// <param name="pipelineEvent">The event.</param>
+    /// <param name="value">The event's value.</param>
+    internal static void RecordFlightEvent(int track, PipelineEvent pipelineEvent, long value)
+    {
+        if (nativeFlightRecorderUnavailable)
+        {
+            return;
+        }
+
+        try
+        {
+            NativeMethods.cc_flight_record(track, (int)pipelineEvent, value);
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            nativeFlightRecorderUnavailable = true;
+        }
+    }
+
+    /// <summary>
+    /// Writes every event the flight recorder still holds to a Chrome trace JSON file.
+    /// </summary>
+    /// <param name="path">The file to create or replace.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the trace could not be written.</param>
+    /// <returns><c>true</c> when the trace was written; otherwise <c>false</c>.</returns>
+    internal static bool TryDumpFlightRecorder(string path, out string? error)
+    {
+        try
+        {
+            if (NativeMethods.cc_flight_dump(path) != 0)
+            {
+                error = $"The compositor capture helper could not write {path}.";
+                return false;
+            }
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException or BadImageFormatException)
+        {
+            error = ex.Message;
+            return false;
+        }
+
+        error = null;
+        return true;
+    }
+
     /// <summary>
     /// Attempts to start a compositor capture session that delivers frames via the supplied callback.
     /// </summary>
@@ -39,9 +423,20 @@ internal sealed class CompositorCaptureBridge : IDisposable
     /// <param name="width">The expected frame width.</param>
     /// <param name="height">The expected frame height.</param>
     /// <param name="frameRate">The target frame rate advertised to the compositor helper.</param>
+    /// <param name="renditions">Additional scaled outputs to derive from each captured frame, delivered via <see cref="RenditionFrameArrived"/>.</param>
+    /// <param name="supersampleFactor">The capture surface scale relative to <paramref name="width"/> x <paramref name="height"/> (1, 2 or 4).</param>
+    /// <param name="supersampleFilter">The filter used to resolve the supersampled surface.</param>
+    /// <param name="sourceFrameRate">The rate the page renders at, or <c>null</c> when it matches <paramref name="frameRate"/>.</param>
+    /// <param name="frameRateConversion">How source frames are converted to <paramref name="frameRate"/>.</param>
+    /// <param name="interlaced">Whether to render two fields per frame and deliver them woven into one interleaved frame.</param>
+    /// <param name="interlaceFlickerFilter">Whether to apply a vertical flicker filter while weaving fields.</param>
+    /// <param name="alphaMode">The alpha representation of delivered frames and renditions.</param>
+    /// <param name="threadPolicy">The priority, CPU pinning and timer slack of the native capture thread.</param>
+    /// <param name="frameMemory">How the session's frame pools are allocated.</param>
+    /// <param name="captureFaults">The faults the helper's fallback capture loop injects into its cadence.</param>
     /// <param name="error">When this method returns <c>false</c>, contains the error message describing why start-up failed.</param>
     /// <returns><c>true</c> when the compositor capture session was created and started; otherwise <c>false</c>.</returns>
-    internal bool TryStart(IBrowserHost host, int width, int height, FrameRate frameRate, out string? error)
+    internal bool TryStart(IBrowserHost host, int width, int height, FrameRate frameRate, IReadOnlyList<OutputRendition> renditions, int supersampleFactor, SupersampleFilter supersampleFilter, FrameRate? sourceFrameRate, FrameRateConversion frameRateConversion, bool interlaced, bool interlaceFlickerFilter, AlphaMode alphaMode, ThreadPolicy threadPolicy, FrameMemoryOptions frameMemory, CaptureFaultProfile captureFaults, out string? error)
     {
         if (host is null)
         {
@@ -56,11 +451,25 @@ internal sealed class CompositorCaptureBridge : IDisposable
 
         var config = new NativeCompositorCaptureConfig
         {
+            StructSize = (uint)Marshal.SizeOf<NativeCompositorCaptureConfig>(),
+            AbiVersion = NativeAbiVersion,
             Width = width,
             Height = height,
             FrameRateNumerator = frameRate.Numerator,
             FrameRateDenominator = frameRate.Denominator,
+            SupersampleFactor = supersampleFactor,
+            SupersampleFilter = (int)supersampleFilter,
+            SourceFrameRateNumerator = sourceFrameRate?.Numerator ?? 0,
+            SourceFrameRateDenominator = sourceFrameRate?.Denominator ?? 0,
+            RateConversion = (int)frameRateConversion,
+            ScanMode = interlaced ? 1 : 0,
+            FieldFlickerFilter = interlaceFlickerFilter ? 1 : 0,
+            AlphaMode = (int)alphaMode,
+            ThreadPolicy = NativeThreadPolicy.From(threadPolicy),
+            MemoryFlags = (uint)frameMemory,
+            Faults = NativeCaptureFaults.From(captureFaults),
         };
+        injectingFaults = captureFaults.IsEnabled;
 
         frameCallback = OnNativeFrame;
         selfHandle = GCHandle.Alloc(this);
@@ -103,9 +512,25 @@ internal sealed class CompositorCaptureBridge : IDisposable
         }
 
         sessionHandle = handle;
+        RegisterRenditions(handle, renditions);
+
+        if (layerAttachment is { } layer && !layer.Compositor.TryAttach(handle.DangerousGetHandle(), layer.ZOrder, layer.DelayFrames))
+        {
+            Stop();
+            error = "Layer compositor rejected the session.";
+            return false;
+        }
+
         try
         {
-            NativeMethods.cc_start_session(handle);
+            if (NativeMethods.cc_start_session(handle) == -2)
+            {
+                logger.Warning("Compositor capture session refused: its frame pools exceed the frame memory budget");
+                Stop();
+                error = "The session's frame pools exceed the frame memory budget.";
+                return false;
+            }
+
             error = null;
             logger.Information("Compositor capture session started (size={Width}x{Height}, rate={Rate})", width, height, frameRate);
             return true;
@@ -119,6 +544,163 @@ internal sealed class CompositorCaptureBridge : IDisposable
         }
     }
 
+    /// <summary>
+    /// Registers each requested rendition with the native session. Renditions the helper rejects are logged and skipped
+    /// so the primary output still starts.
+    /// </summary>
+    /// <param name="handle">The created, not yet started, session.</param>
+    /// <param name="renditions">The renditions to register.</param>
+    private void RegisterRenditions(SafeCompositorCaptureHandle handle, IReadOnlyList<OutputRendition> renditions)
+    {
+        if (renditions is null || renditions.Count == 0)
+        {
+            return;
+        }
+
+        renditionCallback = OnNativeRenditionFrame;
+        for (var index = 0; index < renditions.Count; index++)
+        {
+            var rendition = renditions[index];
+            var config = new NativeRenditionConfig
+            {
+                Width = rendition.Width,
+                Height = rendition.Height,
+                FrameRateDivider = rendition.FrameRateDivider,
+                Filter = (int)rendition.Filter,
+            };
+
+            var contextHandle = GCHandle.Alloc(new RenditionContext(this, index));
+            int result;
+            try
+            {
+                result = NativeMethods.cc_add_rendition(handle, ref config, renditionCallback, GCHandle.ToIntPtr(contextHandle));
+            }
+            catch (EntryPointNotFoundException ex)
+            {
+                contextHandle.Free();
+                logger.Warning(ex, "Compositor capture helper does not support renditions; {Count} rendition(s) disabled", renditions.Count);
+                return;
+            }
+
+            if (result < 0)
+            {
+                contextHandle.Free();
+                logger.Warning("Compositor capture helper rejected rendition {Rendition}", rendition);
+                continue;
+            }
+
+            renditionHandles.Add(contextHandle);
+        }
+    }
+
+    /// <summary>
+    /// Replaces the overlays the native helper burns into every captured frame.
+    /// </summary>
+    /// <param name="overlays">The overlays to draw; an empty list clears them.</param>
+    /// <returns><c>true</c> when the running session accepted the overlays.</returns>
+    internal bool TrySetOverlays(IReadOnlyList<OverlayDefinition> overlays)
+    {
+        var handle = sessionHandle;
+        if (handle is null || handle.IsInvalid)
+        {
+            return false;
+        }
+
+        var native = new NativeOverlay[overlays.Count];
+        for (var index = 0; index < overlays.Count; index++)
+        {
+            var overlay = overlays[index];
+            native[index] = new NativeOverlay
+            {
+                Kind = (int)overlay.Kind,
+                X = overlay.X,
+                Y = overlay.Y,
+                Width = overlay.Width,
+                Height = overlay.Height,
+                Color = overlay.Color,
+                Background = overlay.Background,
+                Scale = overlay.Scale,
+                Thickness = overlay.Thickness,
+            };
+        }
+
+        try
+        {
+            return NativeMethods.cc_set_overlays(handle, native, native.Length) == 0;
+        }
+        catch (EntryPointNotFoundException ex)
+        {
+            logger.Warning(ex, "Compositor capture helper does not support overlays");
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Reads the overlay blend statistics of the running session.
+    /// </summary>
+    /// <param name="statistics">When this method returns <c>true</c>, contains the blend statistics.</param>
+    /// <returns><c>true</c> when a session is running and the helper reported statistics.</returns>
+    internal bool TryGetOverlayStatistics(out OverlayStatistics? statistics)
+    {
+        statistics = null;
+        var handle = sessionHandle;
+        if (handle is null || handle.IsInvalid)
+        {
+            return false;
+        }
+
+        NativeOverlayStats native;
+        try
+        {
+            if (NativeMethods.cc_get_overlay_stats(handle, out native) != 0)
+            {
+                return false;
+            }
+        }
+        catch (EntryPointNotFoundException)
+        {
+            return false;
+        }
+
+        const double nanosecondsPerMillisecond = 1_000_000.0;
+        statistics = new OverlayStatistics(
+            native.Frames,
+            native.LastPixelsBlended,
+            native.LastBlendNanoseconds / nanosecondsPerMillisecond,
+            native.PeakBlendNanoseconds / nanosecondsPerMillisecond,
+            native.Frames == 0 ? 0 : native.TotalBlendNanoseconds / nanosecondsPerMillisecond / native.Frames);
+        return true;
+    }
+
+    /// <summary>
+    /// Logs what the session's capture faults amounted to, so a run can be read against the pacing telemetry.
+    /// </summary>
+    private void LogInjectedFaults(SafeCompositorCaptureHandle handle)
+    {
+        if (!injectingFaults)
+        {
+            return;
+        }
+
+        try
+        {
+            if (NativeMethods.cc_get_capture_fault_stats(handle, out var stats) == 0)
+            {
+                logger.Information(
+                    "Capture faults injected: {Delivered} frames delivered, {Stalled} lost to stalls, {Burst} in bursts, {Preemptions} preemptions, longest delay {MaxDelayMs:F1} ms",
+                    stats.FramesDelivered,
+                    stats.FramesStalled,
+                    stats.BurstFrames,
+                    stats.Preemptions,
+                    stats.MaxDelayMicroseconds / 1000.0);
+            }
+        }
+        catch (EntryPointNotFoundException)
+        {
+            // Older helpers inject nothing, and negotiation has already said so.
+        }
+    }
+
     /// <summary>
     /// Stops the compositor capture session and releases any pinned managed resources.
     /// </summary>
@@ -139,6 +721,7 @@ internal sealed class CompositorCaptureBridge : IDisposable
                 handle.DangerousAddRef(ref added);
                 if (added)
                 {
+                    LogInjectedFaults(handle);
                     NativeMethods.cc_stop_session(handle.DangerousGetHandle());
                 }
             }
@@ -183,6 +766,16 @@ internal sealed class CompositorCaptureBridge : IDisposable
 
         frameCallback = null;
 
+        foreach (var contextHandle in renditionHandles)
+        {
+            if (contextHandle.IsAllocated)
+            {
+                contextHandle.Free();
+            }
+        }
+
+        renditionHandles.Clear();
+        renditionCallback = null;
     }
 
     /// <summary>
@@ -215,16 +808,127 @@ internal sealed class CompositorCaptureBridge : IDisposable
         bridge.DispatchFrame(frame);
     }
 
+    /// <summary>
+    /// Static callback invoked by the native helper whenever a rendition frame becomes available.
+    /// </summary>
+    /// <param name="frame">The scaled frame provided by the native helper.</param>
+    /// <param name="userData">Opaque pointer used to recover the <see cref="RenditionContext"/>.</param>
+    private static void OnNativeRenditionFrame(ref NativeCapturedFrame frame, IntPtr userData)
+    {
+        if (userData == IntPtr.Zero)
+        {
+            return;
+        }
+
+        GCHandle handle;
+        try
+        {
+            handle = GCHandle.FromIntPtr(userData);
+        }
+        catch (Exception)
+        {
+            return;
+        }
+
+        if (!handle.IsAllocated || handle.Target is not RenditionContext context)
+        {
+            return;
+        }
+
+        context.Bridge.DispatchRenditionFrame(context.Index, frame);
+    }
+
     /// <summary>
     /// Translates the native frame representation into a managed <see cref="CapturedFrame"/> and raises <see cref="FrameArrived"/>.
     /// </summary>
     /// <param name="frame">The native frame payload.</param>
     private void DispatchFrame(NativeCapturedFrame frame)
     {
+        if (!TryCreateCapturedFrame(frame, out var capturedFrame))
+        {
+            return;
+        }
+
+        var handlers = FrameArrived;
+        if (handlers is null)
+        {
+            capturedFrame.Dispose();
+            return;
+        }
+
+        try
+        {
+            handlers.Invoke(this, capturedFrame);
+        }
+        catch (Exception ex)
+        {
+            logger.Warning(ex, "Unhandled exception while delivering compositor frame");
+            capturedFrame.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Translates a native rendition frame into a managed <see cref="CapturedFrame"/> and raises <see cref="RenditionFrameArrived"/>.
+    /// </summary>
+    /// <param name="index">The zero-based rendition index.</param>
+    /// <param name="frame">The native frame payload.</param>
+    private void DispatchRenditionFrame(int index, NativeCapturedFrame frame)
+    {
+        if (!TryCreateCapturedFrame(frame, out var capturedFrame))
+        {
+            return;
+        }
+
+        var handlers = RenditionFrameArrived;
+        if (handlers is null)
+        {
+            capturedFrame.Dispose();
+            return;
+        }
+
+        try
+        {
+            handlers.Invoke(this, new RenditionFrameEventArgs(index, capturedFrame));
+        }
+        catch (Exception ex)
+        {
+            logger.Warning(ex, "Unhandled exception while delivering rendition {Index} frame", index);
+            capturedFrame.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Converts a helper frame's <c>monotonic_timestamp</c>, in <c>steady_clock</c> microseconds, to
+    /// <see cref="Stopwatch"/> ticks. Both clocks read the same counter (QPC on Windows, <c>CLOCK_MONOTONIC</c> on
+    /// Linux), so only the unit differs. A missing timestamp becomes the time of arrival.
+    /// </summary>
+    /// <param name="monotonicMicroseconds">The helper's timestamp, or 0 when it did not set one.</param>
+    /// <returns>The timestamp in <see cref="Stopwatch"/> ticks.</returns>
+    internal static long ToStopwatchTimestamp(long monotonicMicroseconds)
+    {
+        if (monotonicMicroseconds <= 0)
+        {
+            return Stopwatch.GetTimestamp();
+        }
+
+        // Split at whole seconds so days of uptime at a nanosecond frequency cannot overflow.
+        var frequency = Stopwatch.Frequency;
+        return (monotonicMicroseconds / 1_000_000 * frequency) + (monotonicMicroseconds % 1_000_000 * frequency / 1_000_000);
+    }
+
+    /// <summary>
+    /// Wraps a native frame descriptor in a <see cref="CapturedFrame"/> whose disposal returns it to the native session.
+    /// </summary>
+    /// <param name="frame">The native frame payload.</param>
+    /// <param name="capturedFrame">When this method returns <c>true</c>, contains the managed frame.</param>
+    /// <returns><c>true</c> when the session is still active; otherwise <c>false</c>.</returns>
+    private bool TryCreateCapturedFrame(NativeCapturedFrame frame, out CapturedFrame capturedFrame)
+    {
+        capturedFrame = default;
         var session = sessionHandle;
         if (session is null || session.IsInvalid)
         {
-            return;
+            return false;
         }
 
         DateTime timestampUtc;
@@ -238,7 +942,7 @@ internal sealed class CompositorCaptureBridge : IDisposable
             timestampUtc = DateTime.UtcNow;
         }
 
-        var monotonicTicks = frame.MonotonicTimestamp != 0 ? frame.MonotonicTimestamp : Stopwatch.GetTimestamp();
+        var monotonicTicks = ToStopwatchTimestamp(frame.MonotonicTimestamp);
         var bufferPointer = ResolveBufferPointer(frame);
         var releaseAction = CreateReleaseAction(session, frame.FrameToken);
         var storageKind = frame.StorageType switch
@@ -247,7 +951,7 @@ internal sealed class CompositorCaptureBridge : IDisposable
             NativeFrameStorageType.SharedMemoryHandle => CapturedFrameStorageKind.SharedMemoryHandle,
             _ => CapturedFrameStorageKind.CpuMemory,
         };
-        var capturedFrame = new CapturedFrame(
+        capturedFrame = new CapturedFrame(
             bufferPointer,
             frame.Width,
             frame.Height,
@@ -256,23 +960,7 @@ internal sealed class CompositorCaptureBridge : IDisposable
             timestampUtc,
             releaseAction,
             storageKind);
-
-        var handlers = FrameArrived;
-        if (handlers is null)
-        {
-            capturedFrame.Dispose();
-            return;
-        }
-
-        try
-        {
-            handlers.Invoke(this, capturedFrame);
-        }
-        catch (Exception ex)
-        {
-            logger.Warning(ex, "Unhandled exception while delivering compositor frame");
-            capturedFrame.Dispose();
-        }
+        return true;
     }
 
     /// <summary>
@@ -376,18 +1064,262 @@ internal sealed class CompositorCaptureBridge : IDisposable
     [StructLayout(LayoutKind.Sequential)]
     private struct NativeCompositorCaptureConfig
     {
+        public uint StructSize;
+        public uint AbiVersion;
         public int Width;
         public int Height;
         public int FrameRateNumerator;
         public int FrameRateDenominator;
+        public int SupersampleFactor;
+        public int SupersampleFilter;
+        public int SourceFrameRateNumerator;
+        public int SourceFrameRateDenominator;
+        public int RateConversion;
+        public int ScanMode;
+        public int FieldFlickerFilter;
+        public int AlphaMode;
+        public NativeThreadPolicy ThreadPolicy;
+        public uint MemoryFlags;
+        public NativeCaptureFaults Faults;
+    }
+
+    /// <summary>
+    /// Native thread policy embedded in session and layer compositor configurations.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    internal struct NativeThreadPolicy
+    {
+        public int Priority;
+        public int Reserved;
+        public ulong AffinityMask;
+        public long TimerSlackNanoseconds;
+
+        internal static NativeThreadPolicy From(ThreadPolicy policy)
+        {
+            return new NativeThreadPolicy
+            {
+                Priority = (int)policy.Priority,
+                AffinityMask = policy.AffinityMask,
+                TimerSlackNanoseconds = policy.TimerSlack.Ticks * 100,
+            };
+        }
+    }
+
+    /// <summary>
+    /// Native capture faults embedded in the session configuration.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeCaptureFaults
+    {
+        public ulong Seed;
+        public long JitterMicroseconds;
+        public int BurstPeriodFrames;
+        public int BurstLengthFrames;
+        public double StallProbability;
+        public long MinStallMicroseconds;
+        public long MaxStallMicroseconds;
+        public double DriftPpm;
+        public double PreemptionProbability;
+        public long PreemptionMicroseconds;
+
+        internal static NativeCaptureFaults From(CaptureFaultProfile profile)
+        {
+            if (!profile.IsEnabled)
+            {
+                return default;
+            }
+
+            return new NativeCaptureFaults
+            {
+                Seed = profile.Seed,
+                JitterMicroseconds = (long)profile.Jitter.TotalMicroseconds,
+                BurstPeriodFrames = profile.BurstPeriod,
+                BurstLengthFrames = profile.BurstLength,
+                StallProbability = profile.StallProbability,
+                MinStallMicroseconds = (long)profile.MinStall.TotalMicroseconds,
+                MaxStallMicroseconds = (long)profile.MaxStall.TotalMicroseconds,
+                DriftPpm = profile.DriftPpm,
+                PreemptionProbability = profile.PreemptionProbability,
+                PreemptionMicroseconds = (long)profile.Preemption.TotalMicroseconds,
+            };
+        }
+    }
+
+    /// <summary>
+    /// Native capture fault counts filled by <c>cc_get_capture_fault_stats</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeCaptureFaultStats
+    {
+        public ulong FramesDelivered;
+        public ulong FramesStalled;
+        public ulong BurstFrames;
+        public ulong Preemptions;
+        public long MaxDelayMicroseconds;
+    }
+
+    /// <summary>
+    /// Native capability report filled by <c>cc_query_capabilities</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeCapabilities
+    {
+        public uint StructSize;
+        public uint AbiVersion;
+        public uint PixelFormats;
+        public uint Features;
+        public int CompiledSimdLevel;
+        public int CpuSimdLevel;
+        public int MaxSupersampleFactor;
+        public int MaxLayers;
+        public int SchedulerWorkers;
+        public int SourceFramePoolDepth;
+        public long ClockResolutionNanoseconds;
+        public long SleepResolutionNanoseconds;
+        public long LargePageBytes;
+        public int NumaNodeCount;
+    }
+
+    /// <summary>
+    /// Native digest filled by <c>cc_hash_frame</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeContentHash
+    {
+        public ulong Low;
+        public ulong High;
+    }
+
+    /// <summary>
+    /// Native pool figures embedded in <see cref="NativeMemoryStats"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeMemoryPoolStats
+    {
+        public ulong InUseBytes;
+        public ulong HighWaterBytes;
+        public ulong Refusals;
+
+        public readonly FrameMemoryPoolStatistics ToModel() => new((long)InUseBytes, (long)HighWaterBytes, (long)Refusals);
+    }
+
+    /// <summary>
+    /// Native budget figures filled by <c>cc_get_memory_stats</c>; the pools are in <c>CompositorMemoryPool</c> order.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeMemoryStats
+    {
+        public uint StructSize;
+        public uint AbiVersion;
+        public ulong BudgetBytes;
+        public ulong InUseBytes;
+        public ulong HighWaterBytes;
+        public ulong Refusals;
+        public ulong TrimmedBytes;
+        public NativeMemoryPoolStats Capture;
+        public NativeMemoryPoolStats Renditions;
+        public NativeMemoryPoolStats Layers;
+        public NativeMemoryPoolStats Pipeline;
+    }
+
+    /// <summary>
+    /// Native duration histogram embedded in <see cref="NativeCounters"/>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private unsafe struct NativeHistogram
+    {
+        public ulong Count;
+        public ulong SumNanoseconds;
+        public fixed ulong Buckets[CompositorHistogram.BucketCount];
+
+        public readonly CompositorHistogram ToModel()
+        {
+            var buckets = new long[CompositorHistogram.BucketCount];
+            for (var i = 0; i < buckets.Length; i++)
+            {
+                buckets[i] = (long)Buckets[i];
+            }
+
+            return new CompositorHistogram((long)Count, (long)SumNanoseconds, buckets);
+        }
+    }
+
+    /// <summary>
+    /// Native event counts filled by <c>cc_get_counters</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeCounters
+    {
+        public uint StructSize;
+        public uint AbiVersion;
+        public ulong FramesCaptured;
+        public ulong FramesDelivered;
+        public ulong LayerFramesSubmitted;
+        public ulong RenditionFramesDelivered;
+        public ulong OverlayFrames;
+        public ulong CompositesDelivered;
+        public ulong TilesComposed;
+        public ulong TilesSkipped;
+        public NativeHistogram FrameConversion;
+        public NativeHistogram RenditionConversion;
+        public NativeHistogram Composite;
+    }
+
+    /// <summary>
+    /// Native rendition description passed to <c>cc_add_rendition</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeRenditionConfig
+    {
+        public int Width;
+        public int Height;
+        public int FrameRateDivider;
+        public int Filter;
     }
 
+    /// <summary>
+    /// Native overlay description passed to <c>cc_set_overlays</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeOverlay
+    {
+        public int Kind;
+        public int X;
+        public int Y;
+        public int Width;
+        public int Height;
+        public uint Color;
+        public uint Background;
+        public int Scale;
+        public int Thickness;
+    }
+
+    /// <summary>
+    /// Native overlay statistics filled by <c>cc_get_overlay_stats</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeOverlayStats
+    {
+        public ulong Frames;
+        public ulong LastPixelsBlended;
+        public long LastBlendNanoseconds;
+        public long PeakBlendNanoseconds;
+        public long TotalBlendNanoseconds;
+    }
+
+    /// <summary>
+    /// Identifies the bridge and rendition index behind a rendition callback's user data pointer.
+    /// </summary>
+    private sealed record RenditionContext(CompositorCaptureBridge Bridge, int Index);
+
     /// <summary>
     /// Native frame descriptor supplied by the compositor helper callback.
     /// </summary>
     [StructLayout(LayoutKind.Sequential)]
-    private struct NativeCapturedFrame
+    internal struct NativeCapturedFrame
     {
+        public uint StructSize;
+        public uint AbiVersion;
         public ulong FrameToken;
         public IntPtr Buffer;
         public IntPtr SharedHandle;
@@ -402,7 +1334,7 @@ internal sealed class CompositorCaptureBridge : IDisposable
     /// <summary>
     /// Storage hints surfaced by the native helper to describe each frame.
     /// </summary>
-    private enum NativeFrameStorageType
+    internal enum NativeFrameStorageType
     {
         SystemMemory = 0,
         SharedTextureHandle = 1,
@@ -413,18 +1345,63 @@ internal sealed class CompositorCaptureBridge : IDisposable
     /// Delegate signature used by the native helper to deliver frames.
     /// </summary>
     [UnmanagedFunctionPointer(CallingConvention.Cdecl)]
-    private delegate void FrameReadyCallback(ref NativeCapturedFrame frame, IntPtr userData);
+    internal delegate void FrameReadyCallback(ref NativeCapturedFrame frame, IntPtr userData);
 
     /// <summary>
     /// P/Invoke declarations that bridge to the native compositor helper.
     /// </summary>
     private static class NativeMethods
     {
+        [DllImport("CompositorCapture", EntryPoint = "cc_query_capabilities", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_query_capabilities(ref NativeCapabilities capabilities);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_copy_frame", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_copy_frame(IntPtr destination, IntPtr source, nuint bytes);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_hash_frame", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_hash_frame(IntPtr pixels, int rowBytes, int height, int stride, ref NativeContentHash hash);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_set_frame_memory_budget", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_set_frame_memory_budget(long bytes);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_memory_stats", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_memory_stats(ref NativeMemoryStats stats);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_counters", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_counters(ref NativeCounters counters);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_reserve_frame_memory", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_reserve_frame_memory(int pool, long bytes, int required);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_release_frame_memory", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_release_frame_memory(int pool, long bytes);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_flight_register_track", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_flight_register_track([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_flight_record", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_flight_record(int track, int flightEvent, long value);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_flight_dump", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_flight_dump([MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
         [DllImport("CompositorCapture", EntryPoint = "cc_create_session", CallingConvention = CallingConvention.Cdecl)]
         internal static extern SafeCompositorCaptureHandle cc_create_session(IntPtr browserHost, ref NativeCompositorCaptureConfig config, FrameReadyCallback callback, IntPtr userData);
 
+        [DllImport("CompositorCapture", EntryPoint = "cc_add_rendition", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_add_rendition(SafeCompositorCaptureHandle session, ref NativeRenditionConfig config, FrameReadyCallback callback, IntPtr userData);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_set_overlays", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_set_overlays(SafeCompositorCaptureHandle session, [In] NativeOverlay[] overlays, int count);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_overlay_stats", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_overlay_stats(SafeCompositorCaptureHandle session, out NativeOverlayStats stats);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_capture_fault_stats", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_capture_fault_stats(SafeCompositorCaptureHandle session, out NativeCaptureFaultStats stats);
+
         [DllImport("CompositorCapture", EntryPoint = "cc_start_session", CallingConvention = CallingConvention.Cdecl)]
-        internal static extern void cc_start_session(SafeCompositorCaptureHandle session);
+        internal static extern int cc_start_session(SafeCompositorCaptureHandle session);
 
         [DllImport("CompositorCapture", EntryPoint = "cc_stop_session", CallingConvention = CallingConvention.Cdecl)]
         internal static extern void cc_stop_session(IntPtr session);
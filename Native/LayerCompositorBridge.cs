@@ -0,0 +1,384 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Runtime.InteropServices;
+using Serilog;
+using Tractus.HtmlToNdi.Models;
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Native;
+
+/// <summary>
+/// Managed wrapper around the native layer compositor, which blends the frames of several compositor capture
+/// sessions in z-order and delivers one paced output.
+/// </summary>
+internal sealed class LayerCompositorBridge : IDisposable
+{
+    private readonly ILogger logger;
+    private SafeLayerCompositorHandle? compositorHandle;
+    private GCHandle selfHandle;
+    private CompositorCaptureBridge.FrameReadyCallback? frameCallback;
+    private int layerCount;
+    private bool disposed;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="LayerCompositorBridge"/> class.
+    /// </summary>
+    /// <param name="logger">The logger used for diagnostics and error reporting.</param>
+    internal LayerCompositorBridge(ILogger logger)
+    {
+        this.logger = (logger ?? throw new ArgumentNullException(nameof(logger))).ForContext<LayerCompositorBridge>();
+    }
+
+    /// <summary>
+    /// Occurs when a composite frame is ready for the video pipeline.
+    /// </summary>
+    internal event EventHandler<CapturedFrame>? FrameArrived;
+
+    /// <summary>
+    /// Attempts to create the native compositor. Layers are attached with <see cref="TryAttach"/> before <see cref="Start"/>.
+    /// </summary>
+    /// <param name="width">The output width; every attached session must match it.</param>
+    /// <param name="height">The output height; every attached session must match it.</param>
+    /// <param name="frameRate">The rate composites are produced at.</param>
+    /// <param name="alphaMode">The alpha representation of delivered composites.</param>
+    /// <param name="threadPolicy">The priority, CPU pinning and timer slack of the composition thread.</param>
+    /// <param name="frameMemory">How the layer rings and output buffers are allocated.</param>
+    /// <param name="error">When this method returns <c>false</c>, contains the reason.</param>
+    /// <returns><c>true</c> when the compositor was created.</returns>
+    internal bool TryCreate(int width, int height, FrameRate frameRate, AlphaMode alphaMode, ThreadPolicy threadPolicy, FrameMemoryOptions frameMemory, out string? error)
+    {
+        if (compositorHandle is not null && !compositorHandle.IsInvalid)
+        {
+            error = "Layer compositor already created.";
+            return false;
+        }
+
+        var config = new NativeLayerCompositorConfig
+        {
+            StructSize = (uint)Marshal.SizeOf<NativeLayerCompositorConfig>(),
+            AbiVersion = CompositorCaptureBridge.NativeAbiVersion,
+            Width = width,
+            Height = height,
+            FrameRateNumerator = frameRate.Numerator,
+            FrameRateDenominator = frameRate.Denominator,
+            AlphaMode = (int)alphaMode,
+            ThreadPolicy = CompositorCaptureBridge.NativeThreadPolicy.From(threadPolicy),
+            MemoryFlags = (uint)frameMemory,
+        };
+
+        frameCallback = OnNativeFrame;
+        selfHandle = GCHandle.Alloc(this);
+
+        try
+        {
+            var handle = NativeMethods.cc_create_layer_compositor(ref config, frameCallback, GCHandle.ToIntPtr(selfHandle));
+            if (handle is null || handle.IsInvalid)
+            {
+                CleanupCallbackState();
+                error = "Native layer compositor was not created; the arguments were invalid or its output exceeds the frame memory budget.";
+                return false;
+            }
+
+            compositorHandle = handle;
+            error = null;
+            return true;
+        }
+        catch (Exception ex) when (ex is DllNotFoundException or EntryPointNotFoundException)
+        {
+            logger.Warning(ex, "Compositor capture helper does not support layer compositing");
+            CleanupCallbackState();
+            error = ex.Message;
+            return false;
+        }
+    }
+
+    /// <summary>
+    /// Routes a created, not yet started, capture session into the compositor.
+    /// </summary>
+    /// <param name="session">The native session pointer.</param>
+    /// <param name="zOrder">The layer position; higher layers are drawn on top.</param>
+    /// <param name="delayFrames">How many of its own frames the layer is held back by.</param>
+    /// <returns><c>true</c> when the layer was attached.</returns>
+    internal bool TryAttach(IntPtr session, int zOrder, int delayFrames)
+    {
+        var handle = compositorHandle;
+        if (handle is null || handle.IsInvalid || session == IntPtr.Zero)
+        {
+            return false;
+        }
+
+        var index = NativeMethods.cc_attach_layer(handle, session, zOrder, delayFrames);
+        if (index < 0)
+        {
+            logger.Warning("Layer compositor rejected layer {ZOrder} (delay {DelayFrames})", zOrder, delayFrames);
+            return false;
+        }
+
+        layerCount = Math.Max(layerCount, index + 1);
+        return true;
+    }
+
+    /// <summary>
+    /// Starts producing composites.
+    /// </summary>
+    internal void Start()
+    {
+        var handle = compositorHandle;
+        if (handle is null || handle.IsInvalid)
+        {
+            return;
+        }
+
+        NativeMethods.cc_start_layer_compositor(handle);
+        logger.Information("Layer compositor started with {Count} layer(s)", layerCount);
+    }
+
+    /// <summary>
+    /// Reads the tile, timing and per-layer alignment figures.
+    /// </summary>
+    /// <returns>The statistics, or <c>null</c> when the compositor is not running.</returns>
+    internal LayerCompositorStatistics? GetStatistics()
+    {
+        var handle = compositorHandle;
+        if (handle is null || handle.IsInvalid || NativeMethods.cc_get_layer_compositor_stats(handle, out var native) != 0)
+        {
+            return null;
+        }
+
+        const double microsecondsPerMillisecond = 1_000.0;
+        const double nanosecondsPerMillisecond = 1_000_000.0;
+        var layers = new List<NativeLayerStats>(layerCount);
+        for (var index = 0; index < layerCount; index++)
+        {
+            if (NativeMethods.cc_get_layer_stats(handle, index, out var layer) == 0)
+            {
+                layers.Add(layer);
+            }
+        }
+
+        var freshest = layers.Count == 0 ? 0 : layers.Min(layer => layer.MeanAgeMicroseconds);
+        var statistics = layers
+            .OrderBy(layer => layer.ZOrder)
+            .Select(layer => new LayerStatistics(
+                layer.ZOrder,
+                layer.DelayFrames,
+                layer.FramesSubmitted,
+                layer.FramesDropped,
+                layer.LastAgeMicroseconds / microsecondsPerMillisecond,
+                layer.MeanAgeMicroseconds / microsecondsPerMillisecond,
+                (layer.MeanAgeMicroseconds - freshest) / microsecondsPerMillisecond))
+            .ToList();
+
+        return new LayerCompositorStatistics(
+            native.Frames,
+            native.TilesComposed,
+            native.TilesSkipped,
+            native.LastComposeNanoseconds / nanosecondsPerMillisecond,
+            native.PeakComposeNanoseconds / nanosecondsPerMillisecond,
+            statistics);
+    }
+
+    /// <summary>
+    /// Stops the compositor. Attached sessions must already be stopped.
+    /// </summary>
+    internal void Stop()
+    {
+        var handle = compositorHandle;
+        if (handle is null)
+        {
+            CleanupCallbackState();
+            return;
+        }
+
+        try
+        {
+            if (!handle.IsInvalid)
+            {
+                NativeMethods.cc_stop_layer_compositor(handle);
+            }
+        }
+        catch (Exception ex)
+        {
+            logger.Debug(ex, "Stopping the layer compositor raised an exception");
+        }
+        finally
+        {
+            handle.Dispose();
+            compositorHandle = null;
+            CleanupCallbackState();
+            logger.Information("Layer compositor stopped");
+        }
+    }
+
+    /// <summary>
+    /// Releases the GC handle and delegate pinned for the native callback.
+    /// </summary>
+    private void CleanupCallbackState()
+    {
+        if (selfHandle.IsAllocated)
+        {
+            selfHandle.Free();
+        }
+
+        frameCallback = null;
+    }
+
+    /// <summary>
+    /// Static callback invoked by the native compositor for each composite.
+    /// </summary>
+    /// <param name="frame">The composite; its buffer stays valid until the next composite.</param>
+    /// <param name="userData">Opaque pointer used to recover the managed bridge.</param>
+    private static void OnNativeFrame(ref CompositorCaptureBridge.NativeCapturedFrame frame, IntPtr userData)
+    {
+        if (userData == IntPtr.Zero)
+        {
+            return;
+        }
+
+        GCHandle handle;
+        try
+        {
+            handle = GCHandle.FromIntPtr(userData);
+        }
+        catch (Exception)
+        {
+            return;
+        }
+
+        if (!handle.IsAllocated || handle.Target is not LayerCompositorBridge bridge)
+        {
+            return;
+        }
+
+        var handlers = bridge.FrameArrived;
+        if (handlers is null)
+        {
+            return;
+        }
+
+        var capturedFrame = new CapturedFrame(
+            frame.Buffer,
+            frame.Width,
+            frame.Height,
+            frame.Stride,
+            CompositorCaptureBridge.ToStopwatchTimestamp(frame.MonotonicTimestamp),
+            frame.TimestampMicrosecondsUtc > 0 ? DateTime.UnixEpoch.AddTicks(frame.TimestampMicrosecondsUtc * 10) : DateTime.UtcNow);
+
+        try
+        {
+            handlers.Invoke(bridge, capturedFrame);
+        }
+        catch (Exception ex)
+        {
+            bridge.logger.Warning(ex, "Unhandled exception while delivering composite frame");
+            capturedFrame.Dispose();
+        }
+    }
+
+    /// <summary>
+    /// Releases resources held by the <see cref="LayerCompositorBridge"/>.
+    /// </summary>
+    public void Dispose()
+    {
+        if (disposed)
+        {
+            return;
+        }
+
+        disposed = true;
+        Stop();
+    }
+
+    /// <summary>
+    /// Safe handle wrapper for the native layer compositor.
+    /// </summary>
+    private sealed class SafeLayerCompositorHandle : SafeHandle
+    {
+        private SafeLayerCompositorHandle()
+            : base(IntPtr.Zero, ownsHandle: true)
+        {
+        }
+
+        /// <inheritdoc />
+        public override bool IsInvalid => handle == IntPtr.Zero;
+
+        protected override bool ReleaseHandle()
+        {
+            NativeMethods.cc_destroy_layer_compositor(handle);
+            return true;
+        }
+    }
+
+    /// <summary>
+    /// Native configuration passed to <c>cc_create_layer_compositor</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeLayerCompositorConfig
+    {
+        public uint StructSize;
+        public uint AbiVersion;
+        public int Width;
+        public int Height;
+        public int FrameRateNumerator;
+        public int FrameRateDenominator;
+        public int AlphaMode;
+        public CompositorCaptureBridge.NativeThreadPolicy ThreadPolicy;
+        public uint MemoryFlags;
+    }
+
+    /// <summary>
+    /// Native per-layer statistics filled by <c>cc_get_layer_stats</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeLayerStats
+    {
+        public int ZOrder;
+        public int DelayFrames;
+        public ulong FramesSubmitted;
+        public ulong FramesDropped;
+        public long LastAgeMicroseconds;
+        public long MeanAgeMicroseconds;
+    }
+
+    /// <summary>
+    /// Native compositor statistics filled by <c>cc_get_layer_compositor_stats</c>.
+    /// </summary>
+    [StructLayout(LayoutKind.Sequential)]
+    private struct NativeLayerCompositorStats
+    {
+        public ulong Frames;
+        public ulong TilesComposed;
+        public ulong TilesSkipped;
+        public long LastComposeNanoseconds;
+        public long PeakComposeNanoseconds;
+    }
+
+    /// <summary>
+    /// P/Invoke declarations for the layer compositor exports of the native helper.
+    /// </summary>
+    private static class NativeMethods
+    {
+        [DllImport("CompositorCapture", EntryPoint = "cc_create_layer_compositor", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern SafeLayerCompositorHandle cc_create_layer_compositor(ref NativeLayerCompositorConfig config, CompositorCaptureBridge.FrameReadyCallback callback, IntPtr userData);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_attach_layer", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_attach_layer(SafeLayerCompositorHandle compositor, IntPtr session, int zOrder, int delayFrames);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_start_layer_compositor", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_start_layer_compositor(SafeLayerCompositorHandle compositor);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_stop_layer_compositor", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_stop_layer_compositor(SafeLayerCompositorHandle compositor);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_layer_stats", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_layer_stats(SafeLayerCompositorHandle compositor, int layer, out NativeLayerStats stats);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_get_layer_compositor_stats", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern int cc_get_layer_compositor_stats(SafeLayerCompositorHandle compositor, out NativeLayerCompositorStats stats);
+
+        [DllImport("CompositorCapture", EntryPoint = "cc_destroy_layer_compositor", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void cc_destroy_layer_compositor(IntPtr compositor);
+    }
+}
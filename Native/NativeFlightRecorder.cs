@@ -0,0 +1,119 @@
+using System.Diagnostics;
+using System.Globalization;
+using Serilog;
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Native;
+
+/// <summary>
+/// Records one pipeline's events into the native helper's flight recorder under a track named after the pipeline,
+/// and dumps the recorder to a Chrome trace shortly after an underrun when anomaly dumps are enabled.
+/// </summary>
+internal sealed class NativeFlightRecorder : IPipelineEventRecorder
+{
+    /// <summary>
+    /// How long after an underrun the dump is written, so the trace also shows the warmup that follows it.
+    /// </summary>
+    private static readonly TimeSpan AnomalyDumpDelay = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// The shortest time between anomaly dumps, so a page that keeps underrunning does not fill the disk.
+    /// </summary>
+    private static readonly TimeSpan AnomalyDumpCooldown = TimeSpan.FromSeconds(30);
+
+    private static readonly object AnomalyGate = new();
+    private static string? anomalyDirectory;
+    private static ILogger? anomalyLogger;
+    private static long nextAnomalyDumpTimestamp;
+
+    private readonly int track;
+    private readonly string name;
+
+    private NativeFlightRecorder(int track, string name)
+    {
+        this.track = track;
+        this.name = name;
+    }
+
+    /// <summary>
+    /// Registers a track for a pipeline.
+    /// </summary>
+    /// <param name="name">The pipeline's NDI source name.</param>
+    /// <returns>The recorder, or <c>null</c> when the native helper cannot be loaded.</returns>
+    public static NativeFlightRecorder? TryCreate(string name)
+    {
+        return CompositorCaptureBridge.TryRegisterFlightTrack(name, out var track)
+            ? new NativeFlightRecorder(track, name)
+            : null;
+    }
+
+    /// <summary>
+    /// Dumps the recorder into <paramref name="directory"/> after underruns, at most once per
+    /// <see cref="AnomalyDumpCooldown"/>.
+    /// </summary>
+    /// <param name="directory">The directory the traces are written to; created when missing.</param>
+    /// <param name="logger">The logger that reports each dump.</param>
+    public static void EnableAnomalyDumps(string directory, ILogger logger)
+    {
+        ArgumentException.ThrowIfNullOrWhiteSpace(directory);
+        Directory.CreateDirectory(directory);
+        lock (AnomalyGate)
+        {
+            anomalyDirectory = directory;
+            anomalyLogger = (logger ?? throw new ArgumentNullException(nameof(logger))).ForContext<NativeFlightRecorder>();
+        }
+    }
+
+    /// <summary>
+    /// Writes every event the recorder still holds to a Chrome trace file.
+    /// </summary>
+    /// <param name="path">The file to create or replace.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why the trace could not be written.</param>
+    /// <returns><c>true</c> when the trace was written; otherwise <c>false</c>.</returns>
+    public static bool TryDump(string path, out string? error) => CompositorCaptureBridge.TryDumpFlightRecorder(path, out error);
+
+    /// <inheritdoc />
+    public void Record(PipelineEvent pipelineEvent, long value = 0)
+    {
+        CompositorCaptureBridge.RecordFlightEvent(track, pipelineEvent, value);
+        if (pipelineEvent == PipelineEvent.Underrun && Volatile.Read(ref anomalyDirectory) is not null)
+        {
+            ScheduleAnomalyDump();
+        }
+    }
+
+    private void ScheduleAnomalyDump()
+    {
+        string directory;
+        ILogger logger;
+        lock (AnomalyGate)
+        {
+            var now = Stopwatch.GetTimestamp();
+            if (anomalyDirectory is null || anomalyLogger is null || now < nextAnomalyDumpTimestamp)
+            {
+                return;
+            }
+
+            nextAnomalyDumpTimestamp = now + (long)(AnomalyDumpCooldown.TotalSeconds * Stopwatch.Frequency);
+            directory = anomalyDirectory;
+            logger = anomalyLogger;
+        }
+
+        var fileName = string.Create(
+            CultureInfo.InvariantCulture,
+            $"flight-{DateTime.Now:yyyyMMdd-HHmmss-fff}-{string.Concat(name.Select(c => char.IsLetterOrDigit(c) ? c : '_'))}.json");
+        var path = Path.Combine(directory, fileName);
+        _ = Task.Run(async () =>
+        {
+            await Task.Delay(AnomalyDumpDelay).ConfigureAwait(false);
+            if (TryDump(path, out var error))
+            {
+                logger.Warning("Underrun on {Output}; flight recorder trace written to {Path}", name, path);
+            }
+            else
+            {
+                logger.Warning("Underrun on {Output}; flight recorder trace could not be written: {Error}", name, error);
+            }
+        });
+    }
+}
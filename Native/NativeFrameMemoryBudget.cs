@@ -0,0 +1,28 @@
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Native;
+
+/// <summary>
+/// Charges pipeline frames to the native helper's memory governor, so one budget covers the helper's pools and the
+/// managed buffers. Without a loadable helper every reservation succeeds.
+/// </summary>
+internal sealed class NativeFrameMemoryBudget : IFrameMemoryBudget
+{
+    /// <summary>
+    /// Gets the budget shared by every pipeline in the process.
+    /// </summary>
+    public static NativeFrameMemoryBudget Instance { get; } = new();
+
+    private NativeFrameMemoryBudget()
+    {
+    }
+
+    /// <inheritdoc />
+    public bool TryReserve(long bytes) => CompositorCaptureBridge.TryReserveFrameMemory(bytes, required: false);
+
+    /// <inheritdoc />
+    public void Reserve(long bytes) => CompositorCaptureBridge.TryReserveFrameMemory(bytes, required: true);
+
+    /// <inheritdoc />
+    public void Release(long bytes) => CompositorCaptureBridge.ReleaseFrameMemory(bytes);
+}
@@ -0,0 +1,30 @@
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Native;
+
+/// <summary>
+/// Carries a scaled rendition frame surfaced by <see cref="CompositorCaptureBridge"/>.
+/// </summary>
+internal sealed class RenditionFrameEventArgs : EventArgs
+{
+    /// <summary>
+    /// Initializes a new instance of the <see cref="RenditionFrameEventArgs"/> class.
+    /// </summary>
+    /// <param name="index">The zero-based index of the rendition in the list passed to the bridge.</param>
+    /// <param name="frame">The scaled frame. Consumers own it and must dispose it once processed.</param>
+    public RenditionFrameEventArgs(int index, CapturedFrame frame)
+    {
+        Index = index;
+        Frame = frame;
+    }
+
+    /// <summary>
+    /// Gets the zero-based rendition index.
+    /// </summary>
+    public int Index { get; }
+
+    /// <summary>
+    /// Gets the scaled frame.
+    /// </summary>
+    public CapturedFrame Frame { get; }
+}
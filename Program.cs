@@ -22,6 +22,7 @@ using System.Windows.Forms;
 using Tractus.HtmlToNdi.Chromium;
 using Tractus.HtmlToNdi.Launcher;
 using Tractus.HtmlToNdi.Models;
+using Tractus.HtmlToNdi.Native;
 using Tractus.HtmlToNdi.Video;
 
 namespace Tractus.HtmlToNdi;
@@ -36,6 +37,7 @@ public class Program
     /// </summary>
     public static nint NdiSenderPtr;
     internal static CefWrapper browserWrapper = null!;
+    private static CompositorCapabilities? compositorCapabilities;
 
     private static readonly object NdiLibraryLock = new();
     private static bool NdiLibraryConfigured;
@@ -145,7 +147,6 @@ public class Program
 
         var useHighPerformancePreset = parameters.PresetHighPerformance;
 
-        var frameRate = parameters.FrameRate;
         var width = parameters.Width;
         var height = parameters.Height;
         var startUrl = parameters.StartUrl;
@@ -167,6 +168,11 @@ public class Program
         {
             EnableBuffering = enableBuffering,
             BufferDepth = effectiveDepth,
+            AutoBufferDepth = parameters.AutoBufferDepth,
+            PacingReference = parameters.PacingReference,
+            Genlock = parameters.Genlock,
+            SendThreadDepth = parameters.NdiSendThreadDepth,
+            IdleOutput = parameters.IdleOutput,
             TelemetryInterval = parameters.TelemetryInterval,
             AllowLatencyExpansion = parameters.AllowLatencyExpansion,
             AlignWithCaptureTimestamps = parameters.AlignWithCaptureTimestamps,
@@ -177,9 +183,61 @@ public class Program
             EnablePumpCadenceAdaptation = parameters.EnablePumpCadenceAdaptation,
             SmoothnessPumpAtWindowlessRate = parameters.SmoothnessPumpAtWindowlessRate,
             EnableCompositorCapture = parameters.EnableCompositorCapture,
+            SupersampleFactor = parameters.SupersampleFactor,
+            SupersampleFilter = parameters.SupersampleFilter,
+            SourceFrameRate = parameters.SourceFrameRate,
+            FrameRateConversion = parameters.FrameRateConversion,
+            Interlaced = parameters.Interlaced,
+            InterlaceFlickerFilter = parameters.InterlaceFlickerFilter,
+            Layers = parameters.Layers,
+            AlphaMode = parameters.AlphaMode,
+            ThreadPolicy = parameters.ThreadPolicy,
+            FrameMemory = parameters.FrameMemory,
+            CaptureFaults = parameters.CaptureFaults,
+            FrameBytes = (long)parameters.Width * parameters.Height * 4,
             PacingMode = parameters.PacingMode,
         };
 
+        if (pipelineOptions.EnableCompositorCapture)
+        {
+            if (CompositorCaptureBridge.TryQueryCapabilities(out compositorCapabilities, out var capabilityError))
+            {
+                Log.Information("Compositor capture helper capabilities: {@Capabilities}", compositorCapabilities);
+            }
+            else
+            {
+                Log.Warning("Compositor capture helper is unavailable: {Error}", capabilityError);
+            }
+
+            pipelineOptions = CompositorNegotiation.Negotiate(pipelineOptions, compositorCapabilities, Log.Logger);
+        }
+
+        // Only the compositor path weaves fields, so the rate is halved only once negotiation has kept both.
+        var frameRate = parameters.FrameRate;
+        if (pipelineOptions.Interlaced && pipelineOptions.EnableCompositorCapture)
+        {
+            // --fps names the field rate for interlaced formats (1080i50); NDI and the pipeline run at the frame rate.
+            frameRate = frameRate.DivideBy(2);
+            Log.Information("Interlaced output: {FieldRate} fields/s woven into {FrameRate} frames/s", parameters.FrameRate, frameRate);
+        }
+        else if (parameters.Interlaced)
+        {
+            pipelineOptions = pipelineOptions with { Interlaced = false, InterlaceFlickerFilter = false };
+            Log.Warning("Interlaced output needs compositor capture; sending progressive frames at {FrameRate} frames/s", frameRate);
+        }
+
+        if (parameters.FrameMemoryBudgetBytes > 0)
+        {
+            if (CompositorCaptureBridge.TrySetFrameMemoryBudget(parameters.FrameMemoryBudgetBytes, out var budgetError))
+            {
+                Log.Information("Frame memory budget set to {BudgetMegabytes} MB", parameters.FrameMemoryBudgetBytes / (1024 * 1024));
+            }
+            else
+            {
+                Log.Warning("Frame memory budget could not be applied: {Error}", budgetError);
+            }
+        }
+
         NativeNdiVideoSender? ndiSender = null;
         NdiVideoPipeline? videoPipeline = null;
         CancellationTokenSource? metadataCancellation = null;
@@ -229,7 +287,13 @@ public class Program
             Log.Information("NDI sender created successfully");
 
             ndiSender = new NativeNdiVideoSender(Program.NdiSenderPtr, parameters.NdiSendAsync);
-            videoPipeline = new NdiVideoPipeline(ndiSender, frameRate, pipelineOptions, Log.Logger);
+            if (parameters.FlightRecorderDirectory is not null)
+            {
+                NativeFlightRecorder.EnableAnomalyDumps(parameters.FlightRecorderDirectory, Log.Logger);
+            }
+
+            videoPipeline = new NdiVideoPipeline(ndiSender, frameRate, pipelineOptions, Log.Logger, NativeFrameMemoryBudget.Instance, NativeFlightRecorder.TryCreate(parameters.NdiName));
+            var renditionOutputs = CreateRenditionOutputs(parameters, frameRate, pipelineOptions);
 
             try
             {
@@ -289,7 +353,8 @@ public class Program
                         videoPipeline,
                         frameRate,
                         Log.Logger,
-                        windowlessFrameRateOverride);
+                        windowlessFrameRateOverride,
+                        renditionOutputs);
                     pipelineAttachedToBrowser = true;
 
                     await browserWrapper.InitializeWrapperAsync();
@@ -461,6 +526,98 @@ public class Program
             browserWrapper.RefreshPage();
         }).WithOpenApi();
 
+        app.MapGet("/overlays", () =>
+        {
+            return new OverlayStatusModel(browserWrapper.Overlays, browserWrapper.GetOverlayStatistics());
+        }).WithOpenApi();
+
+        app.MapPost("/overlays", (OverlayModel[] overlays) =>
+        {
+            var definitions = new List<OverlayDefinition>(overlays.Length);
+            foreach (var overlay in overlays)
+            {
+                if (!overlay.TryCreateDefinition(out var definition, out var error))
+                {
+                    return Results.BadRequest(error);
+                }
+
+                definitions.Add(definition);
+            }
+
+            return browserWrapper.TrySetOverlays(overlays, definitions)
+                ? Results.Ok(new OverlayStatusModel(browserWrapper.Overlays, browserWrapper.GetOverlayStatistics()))
+                : Results.Conflict("Overlays require an active compositor capture session (--enable-compositor-capture).");
+        }).WithOpenApi();
+
+        app.MapGet("/capabilities", () =>
+        {
+            return compositorCapabilities is null
+                ? Results.NotFound("Compositor capture is not enabled or its helper could not be queried.")
+                : Results.Ok(compositorCapabilities);
+        }).WithOpenApi();
+
+        app.MapGet("/stats", () =>
+        {
+            // The pipeline's fields never depend on the native helper; its fields are null when it cannot be loaded.
+            CompositorCaptureBridge.TryGetMemoryStatistics(out var memory, out _);
+            CompositorCaptureBridge.TryGetCounters(out var counters, out _);
+            return Results.Ok(new
+            {
+                FrameMemory = memory,
+                BufferDepth = videoPipeline?.BufferDepth,
+                RequestedBufferDepth = videoPipeline?.RequestedBufferDepth,
+                CapturedFrames = videoPipeline?.CapturedFrames,
+                SentFrames = videoPipeline?.SentFrames,
+                RepeatedFrames = videoPipeline?.RepeatedFrames,
+                SendLatency = videoPipeline?.SendLatency,
+                NativeCounters = counters,
+            });
+        }).WithOpenApi();
+
+        app.MapGet("/metrics", () =>
+        {
+            var pipelines = new List<(string Output, PipelineMetrics Metrics)>();
+            if (videoPipeline is not null)
+            {
+                pipelines.Add((parameters.NdiName, videoPipeline.GetMetrics()));
+            }
+
+            foreach (var rendition in renditionOutputs)
+            {
+                pipelines.Add((rendition.SourceName, rendition.Pipeline.GetMetrics()));
+            }
+
+            CompositorCaptureBridge.TryGetCounters(out var counters, out _);
+            CompositorCaptureBridge.TryGetMemoryStatistics(out var memory, out _);
+            return Results.Text(OpenMetricsFormatter.Format(pipelines, counters, memory), OpenMetricsFormatter.ContentType);
+        }).WithOpenApi();
+
+        app.MapGet("/trace", () =>
+        {
+            var path = Path.Combine(Path.GetTempPath(), $"htmltondi-flight-{Guid.NewGuid():N}.json");
+            try
+            {
+                if (!NativeFlightRecorder.TryDump(path, out var error))
+                {
+                    return Results.NotFound($"The flight recorder is unavailable: {error}");
+                }
+
+                return Results.File(File.ReadAllBytes(path), "application/json", "htmltondi-flight.json");
+            }
+            finally
+            {
+                File.Delete(path);
+            }
+        }).WithOpenApi();
+
+        app.MapGet("/layers", () =>
+        {
+            var statistics = browserWrapper.GetLayerStatistics();
+            return statistics is null
+                ? Results.NotFound("Layer compositing is not active (--layers with --enable-compositor-capture).")
+                : Results.Ok(statistics);
+        }).WithOpenApi();
+
             Log.Information("Starting ASP.NET Core host");
             try
             {
@@ -628,6 +785,44 @@ public class Program
         }
     }
 
+    /// <summary>
+    /// Creates an NDI sender and pipeline for every requested output rendition.
+    /// </summary>
+    /// <param name="parameters">The launch parameters listing the renditions.</param>
+    /// <param name="frameRate">The primary capture frame rate.</param>
+    /// <param name="pipelineOptions">The primary pipeline options inherited by each rendition.</param>
+    /// <returns>The created outputs; empty when no renditions were requested or compositor capture is disabled.</returns>
+    private static IReadOnlyList<RenditionOutput> CreateRenditionOutputs(LaunchParameters parameters, FrameRate frameRate, NdiVideoPipelineOptions pipelineOptions)
+    {
+        if (parameters.Renditions.Count == 0)
+        {
+            return Array.Empty<RenditionOutput>();
+        }
+
+        if (!pipelineOptions.EnableCompositorCapture)
+        {
+            Log.Warning("Output renditions require --enable-compositor-capture; ignoring {Count} rendition(s)", parameters.Renditions.Count);
+            return Array.Empty<RenditionOutput>();
+        }
+
+        if (compositorCapabilities is not null && !compositorCapabilities.Supports(CompositorFeatures.Renditions))
+        {
+            Log.Warning("Compositor capture helper does not support renditions; ignoring {Count} rendition(s)", parameters.Renditions.Count);
+            return Array.Empty<RenditionOutput>();
+        }
+
+        var outputs = new List<RenditionOutput>();
+        foreach (var rendition in parameters.Renditions)
+        {
+            if (RenditionOutput.TryCreate(rendition, parameters.NdiName, frameRate, pipelineOptions, parameters.NdiSendAsync, Log.Logger, out var output))
+            {
+                outputs.Add(output!);
+            }
+        }
+
+        return outputs;
+    }
+
     private static void EnsureNdiNativeLibraryLoaded()
     {
         if (!OperatingSystem.IsWindows())
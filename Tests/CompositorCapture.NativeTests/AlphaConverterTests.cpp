@@ -0,0 +1,159 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/AlphaConverter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+uint8_t ReferenceStraight(uint8_t channel, uint8_t alpha)
+{
+    if (alpha == 0)
+    {
+        return 0;
+    }
+
+    return static_cast<uint8_t>(std::min(255u, (channel * 510u + alpha) / (2u * alpha)));
+}
+
+std::vector<uint8_t> OpaqueFrame(int32_t width, int32_t height)
+{
+    std::vector<uint8_t> frame(static_cast<size_t>(width) * height * 4u);
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+        frame[i] = static_cast<uint8_t>(i % 4 == 3 ? 255u : i * 13u);
+    }
+
+    return frame;
+}
+
+void UnpremultiplyMatchesExactDivide(TestContext& context)
+{
+    // Every (colour, alpha) pair, including colours above alpha, laid out on an odd width so the SIMD groups and
+    // the scalar tail both see every alpha value.
+    constexpr int32_t width = 257;
+    constexpr int32_t height = 256;
+    std::vector<uint8_t> source(static_cast<size_t>(width) * height * 4u);
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            auto* pixel = source.data() + (static_cast<size_t>(y) * width + x) * 4u;
+            pixel[0] = static_cast<uint8_t>(y);
+            pixel[1] = static_cast<uint8_t>(y + x);
+            pixel[2] = static_cast<uint8_t>(y * 3 + 1);
+            pixel[3] = static_cast<uint8_t>(x);
+        }
+    }
+
+    std::vector<uint8_t> destination(source.size());
+    UnpremultiplyRows(source.data(), destination.data(), width * 4, width, 0, height);
+
+    bool matches = true;
+    for (size_t i = 0; i < source.size(); i += 4)
+    {
+        const auto alpha = source[i + 3];
+        matches = matches && destination[i + 3] == alpha;
+        for (size_t c = 0; c < 3; ++c)
+        {
+            matches = matches && destination[i + c] == ReferenceStraight(source[i + c], alpha);
+        }
+    }
+
+    TRACTUS_EXPECT(context, matches);
+}
+
+void TransparentPixelsBecomeTransparentBlack(TestContext& context)
+{
+    // Nine pixels: two whole SIMD groups and a scalar tail, all with zero alpha but stray colour.
+    std::vector<uint8_t> source(9 * 4u, 0x55u);
+    for (size_t i = 3; i < source.size(); i += 4)
+    {
+        source[i] = 0u;
+    }
+
+    std::vector<uint8_t> destination(source.size(), 0xCDu);
+    UnpremultiplyRow(source.data(), destination.data(), 9);
+
+    TRACTUS_EXPECT(context, std::all_of(destination.begin(), destination.end(), [](uint8_t value) { return value == 0u; }));
+}
+
+void OpaqueScanFindsSingleTranslucentPixel(TestContext& context)
+{
+    constexpr int32_t width = 19;
+    constexpr int32_t height = 3;
+    auto frame = OpaqueFrame(width, height);
+    TRACTUS_EXPECT(context, IsOpaque(frame.data(), width * 4, width, 0, height));
+
+    // The last pixel of a row falls in the scalar tail; pixel 5 falls in a SIMD group.
+    for (const auto x : {18, 5})
+    {
+        auto copy = frame;
+        copy[(static_cast<size_t>(2) * width + x) * 4u + 3u] = 254u;
+        TRACTUS_EXPECT(context, !IsOpaque(copy.data(), width * 4, width, 0, height));
+        TRACTUS_EXPECT(context, IsOpaque(copy.data(), width * 4, width, 0, 2));
+    }
+}
+
+void OpaqueFramesAreNotWritten(TestContext& context)
+{
+    constexpr int32_t width = 33;
+    constexpr int32_t height = 130;
+    const auto source = OpaqueFrame(width, height);
+    std::vector<uint8_t> destination(source.size(), 0xCDu);
+
+    bool opaque = false;
+    const auto* result = UnpremultiplyFrame(source.data(), destination.data(), width * 4, width, height, nullptr, FrameTaskClock::now(), opaque);
+
+    TRACTUS_EXPECT(context, opaque);
+    TRACTUS_EXPECT(context, result == source.data());
+    TRACTUS_EXPECT(context, std::all_of(destination.begin(), destination.end(), [](uint8_t value) { return value == 0xCDu; }));
+}
+
+void MixedFramesCopyOpaqueBands(TestContext& context)
+{
+    constexpr int32_t width = 33;
+    constexpr int32_t height = 130;
+    auto source = OpaqueFrame(width, height);
+    // One translucent pixel in the second band; the first and third bands stay opaque.
+    auto* pixel = source.data() + (static_cast<size_t>(100) * width + 7) * 4u;
+    pixel[0] = 40u;
+    pixel[1] = 64u;
+    pixel[2] = 128u;
+    pixel[3] = 128u;
+
+    std::vector<uint8_t> destination(source.size(), 0xCDu);
+    bool opaque = true;
+    const auto* result = UnpremultiplyFrame(source.data(), destination.data(), width * 4, width, height, nullptr, FrameTaskClock::now(), opaque);
+
+    auto expected = source;
+    auto* converted = expected.data() + (static_cast<size_t>(100) * width + 7) * 4u;
+    converted[0] = ReferenceStraight(40u, 128u);
+    converted[1] = ReferenceStraight(64u, 128u);
+    converted[2] = 255u;
+
+    TRACTUS_EXPECT(context, !opaque);
+    TRACTUS_EXPECT(context, result == destination.data());
+    TRACTUS_EXPECT(context, destination == expected);
+
+    // In place, the same frame converts without touching the opaque bands.
+    UnpremultiplyFrame(source.data(), source.data(), width * 4, width, height, nullptr, FrameTaskClock::now(), opaque);
+    TRACTUS_EXPECT(context, source == expected);
+}
+} // namespace
+
+void RunAlphaConverterTests(TestContext& context)
+{
+    UnpremultiplyMatchesExactDivide(context);
+    TransparentPixelsBecomeTransparentBlack(context);
+    OpaqueScanFindsSingleTranslucentPixel(context);
+    OpaqueFramesAreNotWritten(context);
+    MixedFramesCopyOpaqueBands(context);
+}
+} // namespace tests
+} // namespace tractus
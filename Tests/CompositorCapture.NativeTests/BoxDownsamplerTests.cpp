@@ -0,0 +1,131 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/BoxDownsampler.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+constexpr uint8_t kUntouched = 0xA5;
+
+std::vector<uint8_t> CreateSurface(int32_t stride, int32_t height, uint32_t seed)
+{
+    std::vector<uint8_t> surface(static_cast<size_t>(stride) * height);
+    for (size_t i = 0; i < surface.size(); ++i)
+    {
+        surface[i] = static_cast<uint8_t>(i * seed + (i >> 5));
+    }
+
+    return surface;
+}
+
+/// <summary>
+/// The rounded mean of the <paramref name="factor"/> x <paramref name="factor"/> block behind one destination channel.
+/// </summary>
+uint8_t BlockAverage(const std::vector<uint8_t>& source, int32_t source_stride, int32_t x, int32_t y, int32_t channel, int32_t factor)
+{
+    uint32_t sum = 0;
+    for (int32_t row = 0; row < factor; ++row)
+    {
+        for (int32_t column = 0; column < factor; ++column)
+        {
+            sum += source[static_cast<size_t>(y * factor + row) * source_stride + static_cast<size_t>(x * factor + column) * 4u + channel];
+        }
+    }
+
+    const auto samples = static_cast<uint32_t>(factor * factor);
+    return static_cast<uint8_t>((sum + samples / 2) / samples);
+}
+
+void BlocksMatchTheReferenceAverage(TestContext& context)
+{
+    // Odd widths leave a scalar tail after the SSE2 pairs; the padded strides keep rows from lining up with the blocks.
+    constexpr int32_t height = 3;
+    for (const auto factor : {2, 4})
+    {
+        for (const auto width : {1, 2, 3, 5, 17, 64})
+        {
+            const auto source_stride = width * factor * 4 + 12;
+            const auto destination_stride = width * 4 + 8;
+            const auto source = CreateSurface(source_stride, height * factor, 37u + static_cast<uint32_t>(width));
+            std::vector<uint8_t> destination(static_cast<size_t>(destination_stride) * height, kUntouched);
+            TRACTUS_EXPECT(context, DownsampleBox(source.data(), source_stride, destination.data(), destination_stride, width, 0, height, factor));
+
+            bool averaged = true;
+            for (int32_t y = 0; y < height; ++y)
+            {
+                for (int32_t x = 0; x < destination_stride; ++x)
+                {
+                    const auto actual = destination[static_cast<size_t>(y) * destination_stride + x];
+                    const auto expected = x < width * 4 ? BlockAverage(source, source_stride, x / 4, y, x % 4, factor) : kUntouched;
+                    averaged = averaged && actual == expected;
+                }
+            }
+
+            TRACTUS_EXPECT(context, averaged);
+        }
+    }
+}
+
+void RowRangesWriteOnlyTheirRows(TestContext& context)
+{
+    constexpr int32_t width = 9;
+    constexpr int32_t height = 7;
+    for (const auto factor : {2, 4})
+    {
+        const auto source_stride = width * factor * 4;
+        const auto destination_stride = width * 4;
+        const auto source = CreateSurface(source_stride, height * factor, 53u);
+        std::vector<uint8_t> whole(static_cast<size_t>(destination_stride) * height, kUntouched);
+        DownsampleBox(source.data(), source_stride, whole.data(), destination_stride, width, 0, height, factor);
+
+        // A middle band writes its rows and nothing above or below them.
+        std::vector<uint8_t> band(whole.size(), kUntouched);
+        TRACTUS_EXPECT(context, DownsampleBox(source.data(), source_stride, band.data(), destination_stride, width, 2, 5, factor));
+        bool confined = true;
+        for (size_t i = 0; i < band.size(); ++i)
+        {
+            const auto row = static_cast<int32_t>(i / destination_stride);
+            confined = confined && band[i] == (row >= 2 && row < 5 ? whole[i] : kUntouched);
+        }
+
+        TRACTUS_EXPECT(context, confined);
+
+        // Bands that tile the frame, as the scheduler splits it, add up to the whole frame; an empty range writes nothing.
+        std::vector<uint8_t> tiled(whole.size(), kUntouched);
+        for (const auto& range : {std::pair<int32_t, int32_t>{0, 2}, {2, 2}, {2, 6}, {6, 7}})
+        {
+            DownsampleBox(source.data(), source_stride, tiled.data(), destination_stride, width, range.first, range.second, factor);
+        }
+
+        TRACTUS_EXPECT(context, tiled == whole);
+    }
+}
+
+void UnsupportedFactorsAreRefused(TestContext& context)
+{
+    constexpr int32_t width = 4;
+    const auto source = CreateSurface(width * 8 * 4, 8, 11u);
+    for (const auto factor : {-2, 0, 1, 3, 8})
+    {
+        std::vector<uint8_t> destination(static_cast<size_t>(width) * 4u, kUntouched);
+        TRACTUS_EXPECT(context, !DownsampleBox(source.data(), width * 8 * 4, destination.data(), width * 4, width, 0, 1, factor));
+        TRACTUS_EXPECT(context, destination == std::vector<uint8_t>(destination.size(), kUntouched));
+    }
+}
+} // namespace
+
+void RunBoxDownsamplerTests(TestContext& context)
+{
+    BlocksMatchTheReferenceAverage(context);
+    RowRangesWriteOnlyTheirRows(context);
+    UnsupportedFactorsAreRefused(context);
+}
+} // namespace tests
+} // namespace tractus
@@ -0,0 +1,314 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/CaptureFaults.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+constexpr PacingClock::Duration kInterval = std::chrono::microseconds(16667);
+const PacingClock::TimePoint kOrigin{};
+
+std::vector<CaptureFaultStep> Run(const CaptureFaultProfile& profile, int frames, PacingClock::Duration interval = kInterval)
+{
+    CaptureFaultInjector injector(profile, interval);
+    injector.Restart(kOrigin);
+    std::vector<CaptureFaultStep> steps;
+    for (int i = 0; i < frames; ++i)
+    {
+        steps.push_back(injector.Next());
+    }
+
+    return steps;
+}
+
+void CleanProfileDeliversOnTheGrid(TestContext& context)
+{
+    const CaptureFaultProfile profile;
+    TRACTUS_EXPECT(context, !profile.Enabled());
+
+    const auto steps = Run(profile, 100);
+    bool on_grid = true;
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        on_grid = on_grid && steps[i].frame_index == i && steps[i].due == kOrigin + kInterval * static_cast<int64_t>(i) && steps[i].preemption.count() == 0;
+    }
+
+    TRACTUS_EXPECT(context, on_grid);
+}
+
+void SameSeedReplaysTheSameFaults(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.seed = 42;
+    profile.jitter = 2ms;
+    profile.stall_probability = 0.01;
+    profile.min_stall = 40ms;
+    profile.max_stall = 120ms;
+    profile.preemption_probability = 0.02;
+    profile.preemption = 8ms;
+
+    const auto first = Run(profile, 2000);
+    const auto second = Run(profile, 2000);
+    profile.seed = 43;
+    const auto reseeded = Run(profile, 2000);
+
+    bool same = true;
+    bool differs = false;
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        same = same && first[i].frame_index == second[i].frame_index && first[i].due == second[i].due && first[i].preemption == second[i].preemption;
+        differs = differs || first[i].due != reseeded[i].due;
+    }
+
+    TRACTUS_EXPECT(context, same);
+    TRACTUS_EXPECT(context, differs);
+}
+
+void BurstsReleaseTheirFramesTogether(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.burst_period = 10;
+    profile.burst_length = 4;
+    TRACTUS_EXPECT(context, profile.Enabled());
+
+    CaptureFaultInjector injector(profile, kInterval);
+    injector.Restart(kOrigin);
+    std::vector<CaptureFaultStep> steps;
+    for (int i = 0; i < 20; ++i)
+    {
+        steps.push_back(injector.Next());
+    }
+
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        const auto period_start = i / 10 * 10;
+        const auto expected = i - period_start < 4 ? period_start + 3 : i;
+        TRACTUS_EXPECT(context, steps[i].due == kOrigin + kInterval * static_cast<int64_t>(expected));
+    }
+
+    TRACTUS_EXPECT(context, injector.Stats().burst_frames == 8u);
+    TRACTUS_EXPECT(context, injector.Stats().max_delay == kInterval * 3);
+}
+
+void StallsSkipFramesAndDeliveriesStayInOrder(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.seed = 5;
+    profile.jitter = 3ms;
+    profile.stall_probability = 0.02;
+    profile.min_stall = 50ms;
+    profile.max_stall = 100ms;
+
+    CaptureFaultInjector injector(profile, kInterval);
+    injector.Restart(kOrigin);
+    constexpr int kFrames = 10000;
+    bool ordered = true;
+    CaptureFaultStep previous = injector.Next();
+    for (int i = 1; i < kFrames; ++i)
+    {
+        const auto step = injector.Next();
+        ordered = ordered && step.frame_index > previous.frame_index && step.due >= previous.due;
+        previous = step;
+    }
+
+    const auto stats = injector.Stats();
+    TRACTUS_EXPECT(context, ordered);
+    TRACTUS_EXPECT(context, stats.frames_delivered == static_cast<uint64_t>(kFrames));
+    // Every frame number up to the last was either delivered or lost to a stall.
+    TRACTUS_EXPECT(context, stats.frames_stalled == previous.frame_index + 1 - static_cast<uint64_t>(kFrames));
+    // Each stall of 50-100 ms swallows three to six frames at 60 fps.
+    TRACTUS_EXPECT(context, stats.frames_stalled >= 3u * 100u && stats.frames_stalled <= 6u * 400u);
+}
+
+void DriftStretchesTheGrid(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.drift_ppm = -1000.0;
+    const auto slow = Run(profile, 1001, 10ms);
+    profile.drift_ppm = 1000.0;
+    const auto fast = Run(profile, 1001, 10ms);
+
+    // A source 0.1% off delivers its thousandth frame about one whole interval early or late, with no rounding creep.
+    auto expected = [](double rate) { return std::chrono::duration_cast<PacingClock::Duration>(std::chrono::duration<double, std::milli>(10000.0 / rate)); };
+    TRACTUS_EXPECT(context, std::llabs((slow[1000].due - kOrigin - expected(0.999)).count()) <= 1);
+    TRACTUS_EXPECT(context, std::llabs((fast[1000].due - kOrigin - expected(1.001)).count()) <= 1);
+    TRACTUS_EXPECT(context, slow[1000].due - fast[1000].due > 19ms);
+}
+
+void JitterAndPreemptionFollowTheirSettings(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.seed = 9;
+    profile.jitter = 1ms;
+    profile.preemption_probability = 0.1;
+    profile.preemption = 8ms;
+
+    // With 100 ms frames the jitter never reorders a delivery, so each delay is the raw half-normal sample.
+    constexpr int kFrames = 20000;
+    const auto steps = Run(profile, kFrames, 100ms);
+    double total_delay = 0.0;
+    int preempted = 0;
+    for (size_t i = 0; i < steps.size(); ++i)
+    {
+        total_delay += std::chrono::duration<double, std::milli>(steps[i].due - (kOrigin + 100ms * static_cast<int64_t>(i))).count();
+        if (steps[i].preemption.count() > 0)
+        {
+            TRACTUS_EXPECT(context, steps[i].preemption == 8ms);
+            ++preempted;
+        }
+    }
+
+    // The mean of |N(0, σ)| is σ·√(2/π).
+    const auto mean_delay = total_delay / kFrames;
+    TRACTUS_EXPECT(context, std::abs(mean_delay - 0.7979) < 0.03);
+    TRACTUS_EXPECT(context, preempted > kFrames / 10 - 300 && preempted < kFrames / 10 + 300);
+}
+
+void CaptureLoopRunsOnTheCadenceGrid(TestContext& context)
+{
+    VirtualPacingClock clock(kOrigin);
+    clock.SetWakeLatency(300us);
+    std::atomic<bool> running{true};
+    uint64_t next_frame_index = 7;
+    std::vector<CaptureLoopFrame> frames;
+    RunCaptureLoop(clock, kInterval, nullptr, running, next_frame_index, [&](const CaptureLoopFrame& frame)
+    {
+        frames.push_back(frame);
+        if (frames.size() == 101)
+        {
+            // The hundred-and-first frame overruns its slot by one and a half intervals.
+            clock.Advance(kInterval * 5 / 2);
+        }
+
+        return frames.size() < 300;
+    });
+
+    TRACTUS_EXPECT(context, frames.size() == 300u);
+    TRACTUS_EXPECT(context, next_frame_index == 307u);
+    TRACTUS_EXPECT(context, !frames.empty() && frames.front().monotonic == kOrigin);
+    bool numbered = true;
+    bool on_grid = true;
+    for (size_t i = 1; i < frames.size(); ++i)
+    {
+        numbered = numbered && frames[i].frame_index == frames[i - 1].frame_index + 1;
+
+        // Wakes are late by the same latency every frame, so the grid from the first frame holds them one interval
+        // apart; the frame after the overrun starts at once, and the grid restarts from there.
+        auto expected = kInterval;
+        if (i == 1 || i == 102)
+        {
+            expected += 300us;
+        }
+        else if (i == 101)
+        {
+            expected = kInterval * 5 / 2;
+        }
+
+        on_grid = on_grid && frames[i].monotonic - frames[i - 1].monotonic == expected;
+    }
+
+    TRACTUS_EXPECT(context, numbered && frames.front().frame_index == 7u);
+    TRACTUS_EXPECT(context, on_grid);
+
+    // Clearing the flag from inside a frame ends the loop after that frame.
+    running.store(true);
+    int produced = 0;
+    RunCaptureLoop(clock, kInterval, nullptr, running, next_frame_index, [&](const CaptureLoopFrame&)
+    {
+        if (++produced == 3)
+        {
+            running.store(false);
+        }
+
+        return true;
+    });
+
+    TRACTUS_EXPECT(context, produced == 3);
+    TRACTUS_EXPECT(context, next_frame_index == 310u);
+}
+
+void CaptureLoopFollowsInjectedFaults(TestContext& context)
+{
+    CaptureFaultProfile profile;
+    profile.seed = 11;
+    profile.jitter = 2ms;
+    profile.burst_period = 30;
+    profile.burst_length = 4;
+    profile.stall_probability = 0.02;
+    profile.min_stall = 40ms;
+    profile.max_stall = 90ms;
+    profile.preemption_probability = 0.05;
+    profile.preemption = 25ms;
+
+    VirtualPacingClock clock(kOrigin);
+    CaptureFaultInjector faults(profile, kInterval);
+    std::atomic<bool> running{true};
+    uint64_t next_frame_index = 0;
+    constexpr size_t kFrames = 2000;
+    std::vector<CaptureLoopFrame> frames;
+    RunCaptureLoop(clock, kInterval, &faults, running, next_frame_index, [&](const CaptureLoopFrame& frame)
+    {
+        frames.push_back(frame);
+        if (frames.size() == kFrames)
+        {
+            running.store(false);
+        }
+
+        return true;
+    });
+
+    // A twin injector with the same seed says when each frame was due. A preemption longer than an interval holds the
+    // thread past the next frame's delivery, which then starts as soon as the thread is back.
+    CaptureFaultInjector twin(profile, kInterval);
+    twin.Restart(kOrigin);
+    auto expected_start = kOrigin;
+    bool replayed = true;
+    bool skipped = false;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+        const auto step = twin.Next();
+        expected_start = std::max(expected_start, step.due);
+        replayed = replayed && frames[i].frame_index == step.frame_index && frames[i].monotonic == expected_start;
+        skipped = skipped || (i > 0 && frames[i].frame_index > frames[i - 1].frame_index + 1);
+        expected_start += step.preemption;
+    }
+
+    const auto stats = faults.Stats();
+    TRACTUS_EXPECT(context, frames.size() == kFrames);
+    TRACTUS_EXPECT(context, replayed);
+    TRACTUS_EXPECT(context, skipped);
+    TRACTUS_EXPECT(context, stats.frames_delivered == kFrames);
+    TRACTUS_EXPECT(context, stats.frames_stalled > 0u && stats.burst_frames > 0u && stats.preemptions > 0u);
+    TRACTUS_EXPECT(context, stats.frames_stalled == twin.Stats().frames_stalled);
+    // The injector numbers the frames, so the loop's own counter is left for the next clean run.
+    TRACTUS_EXPECT(context, next_frame_index == 0u);
+    TRACTUS_EXPECT(context, clock.Now() == expected_start);
+}
+} // namespace
+
+void RunCaptureFaultsTests(TestContext& context)
+{
+    CleanProfileDeliversOnTheGrid(context);
+    SameSeedReplaysTheSameFaults(context);
+    BurstsReleaseTheirFramesTogether(context);
+    StallsSkipFramesAndDeliveriesStayInOrder(context);
+    DriftStretchesTheGrid(context);
+    JitterAndPreemptionFollowTheirSettings(context);
+    CaptureLoopRunsOnTheCadenceGrid(context);
+    CaptureLoopFollowsInjectedFaults(context);
+}
+} // namespace tests
+} // namespace tractus
@@ -0,0 +1,126 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/ContentHash.h"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+/// <summary>
+/// Fills rows of <paramref name="row_bytes"/> with a pattern and the padding after each row with 0xEE.
+/// </summary>
+std::vector<uint8_t> Frame(int32_t row_bytes, int32_t height, int32_t stride, uint32_t seed)
+{
+    std::vector<uint8_t> frame(static_cast<size_t>(stride) * height, 0xEEu);
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < row_bytes; ++x)
+        {
+            frame[(static_cast<size_t>(y) * stride) + x] = static_cast<uint8_t>(((y * 131u + x) * 2654435761u + seed) >> 24);
+        }
+    }
+
+    return frame;
+}
+
+void SimdKernelMatchesScalar(TestContext& context)
+{
+    // Row lengths cover partial and whole stripes; heights run past several 1 KB blocks.
+    for (const auto row_bytes : {1, 4, 63, 64, 65, 200, 256, 1000, 7680})
+    {
+        for (const auto height : {1, 3, 40})
+        {
+            const auto stride = row_bytes + 12;
+            const auto frame = Frame(row_bytes, height, stride, 7u);
+            TRACTUS_EXPECT(context, HashFrame(frame.data(), row_bytes, height, stride) == HashFrameScalar(frame.data(), row_bytes, height, stride));
+        }
+    }
+}
+
+void RowPaddingIsIgnored(TestContext& context)
+{
+    const auto packed = Frame(1000, 24, 1000, 3u);
+    auto padded = Frame(1000, 24, 1088, 3u);
+    const auto expected = HashFrame(packed.data(), 1000, 24, 1000);
+    TRACTUS_EXPECT(context, HashFrame(padded.data(), 1000, 24, 1088) == expected);
+
+    padded[1000] = 0x11u;
+    padded[1087] = 0x22u;
+    TRACTUS_EXPECT(context, HashFrame(padded.data(), 1000, 24, 1088) == expected);
+}
+
+void EveryBitChangesBothHalves(TestContext& context)
+{
+    constexpr int32_t kRowBytes = 256 * 4;
+    constexpr int32_t kHeight = 16;
+    auto frame = Frame(kRowBytes, kHeight, kRowBytes, 11u);
+    const auto original = HashFrame(frame.data(), kRowBytes, kHeight, kRowBytes);
+    for (size_t byte = 0; byte < frame.size(); byte += 37)
+    {
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            frame[byte] ^= static_cast<uint8_t>(1u << bit);
+            const auto changed = HashFrame(frame.data(), kRowBytes, kHeight, kRowBytes);
+            frame[byte] ^= static_cast<uint8_t>(1u << bit);
+            TRACTUS_EXPECT(context, changed.low != original.low);
+            TRACTUS_EXPECT(context, changed.high != original.high);
+        }
+    }
+}
+
+void MovedContentChangesTheHash(TestContext& context)
+{
+    constexpr int32_t kRowBytes = 4096;
+    auto frame = Frame(kRowBytes, 4, kRowBytes, 5u);
+    const auto original = HashFrame(frame.data(), kRowBytes, 4, kRowBytes);
+
+    // Swapping two stripes of one block, or two blocks, must not cancel out in the lane sums.
+    for (const auto& swap : {std::pair<size_t, size_t>{0, 64}, std::pair<size_t, size_t>{128, 1024 + 128}, std::pair<size_t, size_t>{0, kRowBytes}})
+    {
+        auto moved = frame;
+        for (size_t i = 0; i < 64; ++i)
+        {
+            std::swap(moved[swap.first + i], moved[swap.second + i]);
+        }
+
+        TRACTUS_EXPECT(context, HashFrame(moved.data(), kRowBytes, 4, kRowBytes) != original);
+    }
+}
+
+void ShapeIsPartOfTheHash(TestContext& context)
+{
+    const std::vector<uint8_t> zeros(256, 0u);
+    const auto wide = HashFrame(zeros.data(), 128, 2, 128);
+    TRACTUS_EXPECT(context, wide != HashFrame(zeros.data(), 64, 4, 64));
+    TRACTUS_EXPECT(context, wide != HashFrame(zeros.data(), 256, 1, 256));
+    TRACTUS_EXPECT(context, wide != HashFrame(zeros.data(), 128, 1, 128));
+    TRACTUS_EXPECT(context, HashFrame(nullptr, 0, 0, 0) == HashFrameScalar(nullptr, 0, 0, 0));
+}
+
+void MatchesTheManagedPort(TestContext& context)
+{
+    // The same frame and digest are checked by FrameContentHashTests, which runs the managed fallback.
+    const auto frame = Frame(200, 9, 208, 42u);
+    const auto hash = HashFrame(frame.data(), 200, 9, 208);
+    TRACTUS_EXPECT(context, hash.low == 0xD7F48ADA4D3D7DF6ull);
+    TRACTUS_EXPECT(context, hash.high == 0xFCD962AD6AB38BD3ull);
+}
+} // namespace
+
+void RunContentHashTests(TestContext& context)
+{
+    SimdKernelMatchesScalar(context);
+    RowPaddingIsIgnored(context);
+    EveryBitChangesBothHalves(context);
+    MovedContentChangesTheHash(context);
+    ShapeIsPartOfTheHash(context);
+    MatchesTheManagedPort(context);
+}
+} // namespace tests
+} // namespace tractus
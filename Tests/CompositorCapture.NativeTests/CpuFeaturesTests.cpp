@@ -0,0 +1,34 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/CpuFeatures.h"
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+void CpuRunsTheCompiledKernels(TestContext& context)
+{
+    // The test binary shares the helper's SSE2 guard, so reaching this line means the CPU runs the compiled tier.
+    TRACTUS_EXPECT(context, DetectSimdLevel() >= CompiledSimdLevel());
+#if defined(_M_X64) || defined(__x86_64__)
+    TRACTUS_EXPECT(context, CompiledSimdLevel() == SimdLevel::kSse2);
+#endif
+}
+
+void DetectionIsStable(TestContext& context)
+{
+    const auto first = DetectSimdLevel();
+    TRACTUS_EXPECT(context, first >= SimdLevel::kScalar && first <= SimdLevel::kAvx512);
+    TRACTUS_EXPECT(context, DetectSimdLevel() == first);
+}
+} // namespace
+
+void RunCpuFeaturesTests(TestContext& context)
+{
+    CpuRunsTheCompiledKernels(context);
+    DetectionIsStable(context);
+}
+} // namespace tests
+} // namespace tractus
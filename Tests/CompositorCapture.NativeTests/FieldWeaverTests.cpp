@@ -0,0 +1,82 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FieldWeaver.h"
+
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+std::vector<uint8_t> CreatePicture(int32_t stride, int32_t height, uint32_t seed)
+{
+    std::vector<uint8_t> picture(static_cast<size_t>(stride) * height);
+    for (size_t i = 0; i < picture.size(); ++i)
+    {
+        picture[i] = static_cast<uint8_t>(i * seed + (i >> 7));
+    }
+
+    return picture;
+}
+
+void FieldsLandOnAlternateRows(TestContext& context)
+{
+    constexpr int32_t width = 9;
+    constexpr int32_t stride = width * 4;
+    for (const auto height : {1, 2, 5, 8})
+    {
+        const auto first = CreatePicture(stride, height, 31u);
+        const auto second = CreatePicture(stride, height, 57u);
+        std::vector<uint8_t> frame(first.size(), 0u);
+        WeaveField(first.data(), frame.data(), stride, width, height, 0, 0, FieldLineCount(height, 0), false);
+        WeaveField(second.data(), frame.data(), stride, width, height, 1, 0, FieldLineCount(height, 1), false);
+
+        bool matches = FieldLineCount(height, 0) + FieldLineCount(height, 1) == height;
+        for (size_t i = 0; i < frame.size(); ++i)
+        {
+            const auto row = static_cast<int32_t>(i / stride);
+            matches = matches && frame[i] == (row % 2 == 0 ? first[i] : second[i]);
+        }
+
+        TRACTUS_EXPECT(context, matches);
+    }
+}
+
+void FlickerFilterMatchesScalarReference(TestContext& context)
+{
+    constexpr int32_t width = 7;
+    constexpr int32_t stride = width * 4 + 4;
+    constexpr int32_t height = 6;
+    const auto picture = CreatePicture(stride, height, 13u);
+    bool matches = true;
+    for (int32_t parity = 0; parity < 2; ++parity)
+    {
+        std::vector<uint8_t> frame(picture.size(), 0xAAu);
+        WeaveField(picture.data(), frame.data(), stride, width, height, parity, 0, FieldLineCount(height, parity), true);
+        for (int32_t y = 0; y < height; ++y)
+        {
+            for (int32_t x = 0; x < stride; ++x)
+            {
+                const auto at = [&](int32_t row) { return picture[static_cast<size_t>(row) * stride + x]; };
+                const auto above = at(y > 0 ? y - 1 : y);
+                const auto below = at(y + 1 < height ? y + 1 : y);
+                const bool written = y % 2 == parity && x < width * 4;
+                const auto expected = written ? static_cast<uint8_t>((above + 2u * at(y) + below + 2u) >> 2) : 0xAAu;
+                matches = matches && frame[static_cast<size_t>(y) * stride + x] == expected;
+            }
+        }
+    }
+
+    TRACTUS_EXPECT(context, matches);
+}
+} // namespace
+
+void RunFieldWeaverTests(TestContext& context)
+{
+    FieldsLandOnAlternateRows(context);
+    FlickerFilterMatchesScalarReference(context);
+}
+} // namespace tests
+} // namespace tractus
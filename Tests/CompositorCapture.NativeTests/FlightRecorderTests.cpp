@@ -0,0 +1,185 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FlightRecorder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+std::vector<FlightRecord> EventsOn(uint16_t track)
+{
+    std::vector<FlightRecord> events;
+    for (const auto& record : FlightRecorder::Snapshot())
+    {
+        if (record.track == track)
+        {
+            events.push_back(record);
+        }
+    }
+
+    return events;
+}
+
+uint16_t NewTrack(const char* name)
+{
+    const auto track = FlightRecorder::RegisterTrack(name);
+    return track > 0 ? static_cast<uint16_t>(track) : uint16_t{0};
+}
+
+void EventsComeBackInOrderOnTheirTrack(TestContext& context)
+{
+    const auto track = NewTrack("order");
+    TRACTUS_EXPECT(context, track > FlightRecorder::kHelperTrack);
+
+    FlightRecorder::Record(FlightEvent::kFrameEnqueued, track, 2);
+    FlightRecorder::Record(FlightEvent::kSendBegin, track);
+    FlightRecorder::Record(FlightEvent::kSendEnd, track);
+    FlightRecorder::Record(FlightEvent::kDrop, track, static_cast<int64_t>(FlightDropReason::kResync));
+
+    const auto events = EventsOn(track);
+    TRACTUS_EXPECT(context, events.size() == 4u);
+    if (events.size() != 4u)
+    {
+        return;
+    }
+
+    TRACTUS_EXPECT(context, events[0].event == FlightEvent::kFrameEnqueued && events[0].value == 2);
+    TRACTUS_EXPECT(context, events[1].event == FlightEvent::kSendBegin);
+    TRACTUS_EXPECT(context, events[2].event == FlightEvent::kSendEnd);
+    TRACTUS_EXPECT(context, events[3].event == FlightEvent::kDrop && events[3].value == static_cast<int64_t>(FlightDropReason::kResync));
+    TRACTUS_EXPECT(context, events[0].thread_id == events[3].thread_id);
+    for (size_t i = 1; i < events.size(); ++i)
+    {
+        TRACTUS_EXPECT(context, events[i].timestamp_nanoseconds >= events[i - 1].timestamp_nanoseconds);
+    }
+}
+
+void FullRingsKeepTheNewestEventsAndOutliveTheirThread(TestContext& context)
+{
+    const auto track = NewTrack("wrap");
+    constexpr int64_t kEvents = static_cast<int64_t>(FlightRecorder::kEventsPerThread) + 100;
+    std::thread writer([track]()
+    {
+        for (int64_t i = 0; i < kEvents; ++i)
+        {
+            FlightRecorder::Record(FlightEvent::kRepeat, track, i);
+        }
+    });
+    writer.join();
+
+    const auto events = EventsOn(track);
+    TRACTUS_EXPECT(context, events.size() == FlightRecorder::kEventsPerThread);
+    TRACTUS_EXPECT(context, !events.empty() && events.front().value == kEvents - static_cast<int64_t>(FlightRecorder::kEventsPerThread));
+    TRACTUS_EXPECT(context, !events.empty() && events.back().value == kEvents - 1);
+}
+
+void SnapshotsDuringWritesAreNeverTorn(TestContext& context)
+{
+    constexpr int32_t kWriters = 3;
+    std::vector<uint16_t> tracks;
+    for (int32_t w = 0; w < kWriters; ++w)
+    {
+        tracks.push_back(NewTrack("race"));
+    }
+
+    // Each value carries its own track, so a slot assembled from two different writes shows up as a mismatch.
+    std::atomic<bool> running{true};
+    std::vector<std::thread> writers;
+    for (int32_t w = 0; w < kWriters; ++w)
+    {
+        writers.emplace_back([&running, track = tracks[static_cast<size_t>(w)]]()
+        {
+            for (int64_t sequence = 0; running.load(std::memory_order_relaxed); ++sequence)
+            {
+                FlightRecorder::Record(FlightEvent::kFrameCaptured, track, (static_cast<int64_t>(track) << 40) | sequence);
+            }
+        });
+    }
+
+    int32_t torn = 0;
+    int32_t out_of_order = 0;
+    for (int32_t pass = 0; pass < 50; ++pass)
+    {
+        std::unordered_map<uint16_t, int64_t> last;
+        for (const auto& record : FlightRecorder::Snapshot())
+        {
+            if (record.event != FlightEvent::kFrameCaptured || (record.value >> 40) == 0)
+            {
+                continue;
+            }
+
+            torn += (record.value >> 40) == record.track ? 0 : 1;
+            const auto sequence = record.value & ((int64_t{1} << 40) - 1);
+            const auto previous = last.find(record.track);
+            out_of_order += previous != last.end() && sequence <= previous->second ? 1 : 0;
+            last[record.track] = sequence;
+        }
+    }
+
+    running.store(false);
+    for (auto& writer : writers)
+    {
+        writer.join();
+    }
+
+    TRACTUS_EXPECT(context, torn == 0);
+    TRACTUS_EXPECT(context, out_of_order == 0);
+}
+
+void ChromeTracePairsSendsAndWarmups(TestContext& context)
+{
+    const auto track = NewTrack("trace \"main\"");
+    FlightRecorder::Record(FlightEvent::kSendEnd, track);
+    FlightRecorder::Record(FlightEvent::kWarmupExit, track, 3);
+    FlightRecorder::Record(FlightEvent::kSendBegin, track);
+    FlightRecorder::Record(FlightEvent::kSendEnd, track);
+    FlightRecorder::Record(FlightEvent::kUnderrun, track, 0);
+    FlightRecorder::Record(FlightEvent::kWarmupEnter, track, 0);
+    FlightRecorder::Record(FlightEvent::kDrop, track, static_cast<int64_t>(FlightDropReason::kOverflow));
+    FlightRecorder::Record(FlightEvent::kWarmupExit, track, 3);
+    FlightRecorder::Record(FlightEvent::kSendBegin, track);
+
+    const auto trace = FlightRecorder::FormatChromeTrace(EventsOn(track));
+    auto count = [&trace](const std::string& needle)
+    {
+        size_t found = 0;
+        for (auto at = trace.find(needle); at != std::string::npos; at = trace.find(needle, at + 1))
+        {
+            ++found;
+        }
+
+        return found;
+    };
+
+    TRACTUS_EXPECT(context, trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    TRACTUS_EXPECT(context, trace.size() >= 2 && trace.compare(trace.size() - 2, 2, "]}") == 0);
+    TRACTUS_EXPECT(context, count("\"args\":{\"name\":\"trace \\\"main\\\"\"}") == 1u);
+    // Only the send with both ends becomes a slice; the unmatched end and the trailing begin are left out.
+    TRACTUS_EXPECT(context, count("\"name\":\"send\"") == 1u);
+    TRACTUS_EXPECT(context, count("\"ph\":\"X\"") == 1u);
+    // The exit before any entry is dropped, so the warmup is one balanced async slice.
+    TRACTUS_EXPECT(context, count("\"ph\":\"b\"") == 1u);
+    TRACTUS_EXPECT(context, count("\"ph\":\"e\"") == 1u);
+    TRACTUS_EXPECT(context, count("\"name\":\"underrun\"") == 1u);
+    TRACTUS_EXPECT(context, count("\"reason\":\"overflow\"") == 1u);
+}
+} // namespace
+
+void RunFlightRecorderTests(TestContext& context)
+{
+    EventsComeBackInOrderOnTheirTrack(context);
+    FullRingsKeepTheNewestEventsAndOutliveTheirThread(context);
+    SnapshotsDuringWritesAreNeverTorn(context);
+    ChromeTracePairsSendsAndWarmups(context);
+}
+} // namespace tests
+} // namespace tractus
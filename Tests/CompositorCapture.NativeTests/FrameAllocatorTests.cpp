@@ -0,0 +1,110 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FrameAllocator.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+bool AllBytesEqual(const FrameBuffer& buffer, uint8_t value)
+{
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        if (buffer.data()[i] != value)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void AssignFillsAndReusesPages(TestContext& context)
+{
+    FrameBuffer buffer;
+    TRACTUS_EXPECT(context, buffer.empty());
+    TRACTUS_EXPECT(context, buffer.page_kind() == FramePageKind::kNone);
+
+    buffer.assign(1920u * 1080u * 4u, 7u);
+    TRACTUS_EXPECT(context, buffer.size() == 1920u * 1080u * 4u);
+    TRACTUS_EXPECT(context, AllBytesEqual(buffer, 7u));
+    TRACTUS_EXPECT(context, buffer.page_kind() == FramePageKind::kStandard);
+
+    // The pools re-assign the same size whenever a rate converter is rebuilt; that must refill, not reallocate.
+    const auto* pages = buffer.data();
+    buffer.assign(1920u * 1080u * 4u, 0u);
+    TRACTUS_EXPECT(context, buffer.data() == pages);
+    TRACTUS_EXPECT(context, AllBytesEqual(buffer, 0u));
+
+    buffer.assign(64u, 3u);
+    TRACTUS_EXPECT(context, buffer.size() == 64u);
+    TRACTUS_EXPECT(context, AllBytesEqual(buffer, 3u));
+
+    buffer.clear();
+    TRACTUS_EXPECT(context, buffer.empty());
+    TRACTUS_EXPECT(context, buffer.data() == nullptr);
+    TRACTUS_EXPECT(context, buffer.page_kind() == FramePageKind::kNone);
+}
+
+void MoveTransfersOwnership(TestContext& context)
+{
+    FrameBuffer source;
+    source.assign(4096u, 9u);
+    const auto* pages = source.data();
+
+    FrameBuffer moved(std::move(source));
+    TRACTUS_EXPECT(context, moved.data() == pages);
+    TRACTUS_EXPECT(context, moved.size() == 4096u);
+    TRACTUS_EXPECT(context, source.empty());
+    TRACTUS_EXPECT(context, source.data() == nullptr);
+
+    FrameBuffer assigned;
+    assigned.assign(128u, 1u);
+    assigned = std::move(moved);
+    TRACTUS_EXPECT(context, assigned.data() == pages);
+    TRACTUS_EXPECT(context, AllBytesEqual(assigned, 9u));
+    TRACTUS_EXPECT(context, moved.empty());
+}
+
+void LargePagesFallBack(TestContext& context)
+{
+    // Whether the OS grants large pages depends on the machine; the buffer must be usable either way.
+    FrameMemoryPolicy policy;
+    policy.large_pages = true;
+    policy.numa_node = NumaNodeForAffinity(1u);
+    FrameBuffer buffer(policy);
+    buffer.assign(3840u * 2160u * 4u, 5u);
+    TRACTUS_EXPECT(context, buffer.size() == 3840u * 2160u * 4u);
+    TRACTUS_EXPECT(context, buffer.page_kind() != FramePageKind::kNone);
+    TRACTUS_EXPECT(context, AllBytesEqual(buffer, 5u));
+    TRACTUS_EXPECT(context, buffer.page_kind() != FramePageKind::kHuge || LargePageSize() > 0);
+
+    // Small buffers are not worth a large page.
+    FrameBuffer small(policy);
+    small.assign(4096u, 0u);
+    TRACTUS_EXPECT(context, small.page_kind() == FramePageKind::kStandard);
+}
+
+void NumaTopologyIsConsistent(TestContext& context)
+{
+    TRACTUS_EXPECT(context, NumaNodeCount() >= 1);
+    TRACTUS_EXPECT(context, NumaNodeForAffinity(0u) == -1);
+    const auto node = NumaNodeForAffinity(1u);
+    TRACTUS_EXPECT(context, node >= -1 && node < NumaNodeCount());
+}
+} // namespace
+
+void RunFrameAllocatorTests(TestContext& context)
+{
+    AssignFillsAndReusesPages(context);
+    MoveTransfersOwnership(context);
+    LargePagesFallBack(context);
+    NumaTopologyIsConsistent(context);
+}
+} // namespace tests
+} // namespace tractus
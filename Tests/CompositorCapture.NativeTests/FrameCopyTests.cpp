@@ -0,0 +1,73 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FrameCopy.h"
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+std::vector<uint8_t> Pattern(size_t bytes)
+{
+    std::vector<uint8_t> pattern(bytes);
+    for (size_t i = 0; i < bytes; ++i)
+    {
+        pattern[i] = static_cast<uint8_t>(i * 2654435761u >> 24);
+    }
+
+    return pattern;
+}
+
+void StreamCopyHandlesEveryAlignment(TestContext& context)
+{
+    // Every head and tail combination: destination offsets cover each position in a 16-byte store and lengths
+    // cover partial and whole 64-byte blocks.
+    const auto source = Pattern(512);
+    for (size_t source_offset = 0; source_offset < 16; source_offset += 5)
+    {
+        for (size_t destination_offset = 0; destination_offset < 16; ++destination_offset)
+        {
+            for (size_t bytes = 0; bytes <= 200; ++bytes)
+            {
+                std::vector<uint8_t> destination(256, 0xEEu);
+                StreamCopy(destination.data() + destination_offset, source.data() + source_offset, bytes);
+                const bool copied = std::memcmp(destination.data() + destination_offset, source.data() + source_offset, bytes) == 0;
+                bool untouched = true;
+                for (size_t i = 0; i < destination.size(); ++i)
+                {
+                    const bool inside = i >= destination_offset && i < destination_offset + bytes;
+                    untouched = untouched && (inside || destination[i] == 0xEEu);
+                }
+
+                TRACTUS_EXPECT(context, copied);
+                TRACTUS_EXPECT(context, untouched);
+            }
+        }
+    }
+}
+
+void CopyFrameMatchesMemcpyAroundThreshold(TestContext& context)
+{
+    const auto source = Pattern(kStreamingCopyThreshold + 4096u);
+    for (const auto bytes : {kStreamingCopyThreshold - 1u, kStreamingCopyThreshold, kStreamingCopyThreshold + 4095u})
+    {
+        // Offset by three bytes so the streaming path has to align its head.
+        std::vector<uint8_t> destination(bytes + 3u, 0u);
+        CopyFrame(destination.data() + 3, source.data() + 1, bytes);
+        TRACTUS_EXPECT(context, std::memcmp(destination.data() + 3, source.data() + 1, bytes) == 0);
+    }
+}
+} // namespace
+
+void RunFrameCopyTests(TestContext& context)
+{
+    StreamCopyHandlesEveryAlignment(context);
+    CopyFrameMatchesMemcpyAroundThreshold(context);
+}
+} // namespace tests
+} // namespace tractus
@@ -0,0 +1,304 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FrameTaskScheduler.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+constexpr auto kHangLimit = std::chrono::seconds(10);
+
+/// <summary>
+/// A one-shot signal a test thread can wait on with a timeout.
+/// </summary>
+class Latch
+{
+public:
+    void Open()
+    {
+        // Notifying under the lock lets a waiter destroy the latch as soon as it sees it open.
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        opened_.notify_all();
+    }
+
+    bool WaitFor(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return opened_.wait_for(lock, timeout, [this]() { return open_; });
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable opened_;
+    bool open_{false};
+};
+
+/// <summary>
+/// Runs <paramref name="action"/> on its own thread. A hung scheduler cannot be unwound safely, so a run that outlives
+/// the limit is reported and ends the process rather than blocking the whole test run.
+/// </summary>
+void ExpectFinishesWithin(TestContext& context, std::chrono::seconds limit, const char* what, const std::function<void()>& action)
+{
+    auto finished = std::make_shared<Latch>();
+    std::thread runner([&action, finished]()
+    {
+        action();
+        finished->Open();
+    });
+
+    if (!finished->WaitFor(limit))
+    {
+        context.Fail(__FILE__, __LINE__, what);
+        std::fprintf(stderr, "  %s did not finish within %lld s; aborting the run\n", what, static_cast<long long>(limit.count()));
+        std::fflush(stderr);
+        std::_Exit(1);
+    }
+
+    runner.join();
+}
+
+void ParallelForCoversEveryIndexExactlyOnce(TestContext& context)
+{
+    FrameTaskScheduler scheduler(4);
+    const auto due = FrameTaskClock::now() + std::chrono::milliseconds(5);
+
+    struct Case
+    {
+        size_t count;
+        size_t grain;
+    };
+
+    // Uneven tails, a single item, a grain larger than the range and a grain of zero, which is treated as one.
+    const Case cases[] = {{10007, 64}, {4096, 1}, {1, 16}, {100, 1000}, {257, 0}, {64, 64}};
+    for (const auto& test : cases)
+    {
+        std::vector<std::atomic<uint32_t>> hits(test.count);
+        std::atomic<size_t> calls{0};
+        std::atomic<bool> empty_chunk{false};
+        scheduler.ParallelFor(test.count, test.grain, due, [&](size_t begin, size_t end)
+        {
+            calls.fetch_add(1);
+            if (begin >= end || end > test.count)
+            {
+                empty_chunk.store(true);
+                return;
+            }
+
+            for (size_t i = begin; i < end; ++i)
+            {
+                hits[i].fetch_add(1);
+            }
+        });
+
+        const auto grain = test.grain == 0 ? 1 : test.grain;
+        TRACTUS_EXPECT(context, calls.load() == (test.count + grain - 1) / grain);
+        TRACTUS_EXPECT(context, !empty_chunk.load());
+        size_t covered_once = 0;
+        for (const auto& hit : hits)
+        {
+            covered_once += hit.load() == 1 ? 1 : 0;
+        }
+
+        TRACTUS_EXPECT(context, covered_once == test.count);
+    }
+
+    bool called = false;
+    scheduler.ParallelFor(0, 8, due, [&](size_t, size_t) { called = true; });
+    TRACTUS_EXPECT(context, !called);
+}
+
+void ParallelForFinishesWhenEveryWorkerIsBusy(TestContext& context)
+{
+    FrameTaskScheduler scheduler(2);
+    Latch release;
+    std::atomic<int> blocked{0};
+    for (int i = 0; i < 2; ++i)
+    {
+        scheduler.Submit([&]()
+        {
+            blocked.fetch_add(1);
+            release.WaitFor(kHangLimit * 2);
+        });
+    }
+
+    while (blocked.load() < 2)
+    {
+        std::this_thread::yield();
+    }
+
+    // Both workers are parked inside a job, so only the calling thread can run the chunks.
+    std::vector<std::atomic<uint32_t>> hits(1000);
+    ExpectFinishesWithin(context, kHangLimit, "ParallelFor with every worker busy", [&]()
+    {
+        scheduler.ParallelFor(hits.size(), 10, FrameTaskClock::now(), [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
+            {
+                hits[i].fetch_add(1);
+            }
+        });
+    });
+
+    release.Open();
+    size_t covered_once = 0;
+    for (const auto& hit : hits)
+    {
+        covered_once += hit.load() == 1 ? 1 : 0;
+    }
+
+    TRACTUS_EXPECT(context, covered_once == hits.size());
+}
+
+void DeadlineJobsRunEarliestDeadlineFirst(TestContext& context)
+{
+    FrameTaskScheduler scheduler(1);
+    Latch started;
+    Latch release;
+    scheduler.SubmitDeadline([&]()
+    {
+        started.Open();
+        release.WaitFor(kHangLimit * 2);
+    }, FrameTaskClock::now() + std::chrono::seconds(30));
+    TRACTUS_EXPECT(context, started.WaitFor(kHangLimit));
+
+    // The only worker is held, so every job below queues before any of them runs. Due times are submitted out of
+    // order with a tie, and normal and background jobs are submitted first to show the deadline lane outranks them.
+    constexpr size_t kJobs = 9;
+    std::mutex order_mutex;
+    std::vector<int> order;
+    Latch drained;
+    auto record = [&](int id)
+    {
+        return [&, id]()
+        {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(id);
+            if (order.size() == kJobs)
+            {
+                drained.Open();
+            }
+        };
+    };
+
+    scheduler.Submit(record(100), FrameTaskPriority::kBackground);
+    scheduler.Submit(record(90), FrameTaskPriority::kNormal);
+    const auto base = FrameTaskClock::now() + std::chrono::seconds(30);
+    const int offsets_ms[] = {50, 10, 40, 20, 10, 0, 30};
+    for (int i = 0; i < 7; ++i)
+    {
+        scheduler.SubmitDeadline(record(i), base + std::chrono::milliseconds(offsets_ms[i]));
+    }
+
+    release.Open();
+    TRACTUS_EXPECT(context, drained.WaitFor(kHangLimit));
+
+    // Equal due times keep their submission order, so job 1 runs before job 4.
+    const std::vector<int> expected{5, 1, 4, 3, 6, 2, 0, 90, 100};
+    std::lock_guard<std::mutex> lock(order_mutex);
+    TRACTUS_EXPECT(context, order == expected);
+
+    const auto stats = scheduler.GetStats();
+    TRACTUS_EXPECT(context, stats.deadline_misses == 0u);
+}
+
+void IdleWorkersWakeForEverySubmission(TestContext& context)
+{
+    FrameTaskScheduler scheduler(3);
+
+    // Each round waits for the scheduler to go idle before submitting again, so a wakeup lost between a worker's empty
+    // poll and its wait would leave the job stranded.
+    ExpectFinishesWithin(context, kHangLimit, "idle wakeups", [&]()
+    {
+        for (int round = 0; round < 2000; ++round)
+        {
+            Latch ran;
+            switch (round % 3)
+            {
+            case 0:
+                scheduler.Submit([&]() { ran.Open(); });
+                break;
+            case 1:
+                scheduler.Submit([&]() { ran.Open(); }, FrameTaskPriority::kBackground);
+                break;
+            default:
+                scheduler.SubmitDeadline([&]() { ran.Open(); }, FrameTaskClock::now());
+                break;
+            }
+
+            if (!ran.WaitFor(std::chrono::seconds(2)))
+            {
+                context.Fail(__FILE__, __LINE__, "job submitted to an idle scheduler ran");
+                return;
+            }
+        }
+    });
+}
+
+void ShutdownRunsEveryPendingJob(TestContext& context)
+{
+    for (int round = 0; round < 20; ++round)
+    {
+        std::atomic<int> ran{0};
+        int submitted = 0;
+        ExpectFinishesWithin(context, kHangLimit, "scheduler shutdown with pending jobs", [&]()
+        {
+            FrameTaskScheduler scheduler(4);
+            for (int i = 0; i < 200; ++i)
+            {
+                switch (i % 4)
+                {
+                case 0:
+                    scheduler.Submit([&]() { ran.fetch_add(1); });
+                    break;
+                case 1:
+                    scheduler.Submit([&]() { ran.fetch_add(1); }, FrameTaskPriority::kBackground);
+                    break;
+                case 2:
+                    scheduler.SubmitDeadline([&]() { ran.fetch_add(1); }, FrameTaskClock::now() + std::chrono::milliseconds(i));
+                    break;
+                default:
+                    // A job that queues another one while the destructor may already be stopping the workers.
+                    scheduler.Submit([&]()
+                    {
+                        ran.fetch_add(1);
+                        scheduler.Submit([&]() { ran.fetch_add(1); });
+                    });
+                    ++submitted;
+                    break;
+                }
+
+                ++submitted;
+            }
+
+            // The destructor runs here with most of the jobs still queued.
+        });
+
+        TRACTUS_EXPECT(context, ran.load() == submitted);
+    }
+}
+} // namespace
+
+void RunFrameTaskSchedulerTests(TestContext& context)
+{
+    ParallelForCoversEveryIndexExactlyOnce(context);
+    ParallelForFinishesWhenEveryWorkerIsBusy(context);
+    DeadlineJobsRunEarliestDeadlineFirst(context);
+    IdleWorkersWakeForEverySubmission(context);
+    ShutdownRunsEveryPendingJob(context);
+}
+} // namespace tests
+} // namespace tractus
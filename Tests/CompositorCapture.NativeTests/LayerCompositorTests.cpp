@@ -0,0 +1,142 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/LayerCompositor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+constexpr int32_t kWidth = 150;
+constexpr int32_t kHeight = 70;
+constexpr int32_t kStride = kWidth * 4;
+constexpr uint64_t kTileCount = 3 * 2;
+
+std::vector<uint8_t> SolidFrame(uint32_t bgra)
+{
+    std::vector<uint8_t> frame(static_cast<size_t>(kStride) * kHeight);
+    for (size_t i = 0; i < frame.size(); i += 4)
+    {
+        frame[i] = static_cast<uint8_t>(bgra);
+        frame[i + 1] = static_cast<uint8_t>(bgra >> 8);
+        frame[i + 2] = static_cast<uint8_t>(bgra >> 16);
+        frame[i + 3] = static_cast<uint8_t>(bgra >> 24);
+    }
+
+    return frame;
+}
+
+uint8_t ReferenceOver(uint8_t source, uint8_t destination, uint8_t source_alpha)
+{
+    return static_cast<uint8_t>(std::min(255u, source + (destination * (255u - source_alpha) + 127u) / 255u));
+}
+
+void BlendMatchesScalarReference(TestContext& context)
+{
+    constexpr int32_t pixels = 37;
+    std::vector<uint8_t> source(pixels * 4);
+    std::vector<uint8_t> destination(pixels * 4);
+    for (int32_t x = 0; x < pixels; ++x)
+    {
+        // Premultiplied: colour never exceeds alpha. Include fully transparent and fully opaque runs.
+        const auto alpha = static_cast<uint8_t>(x < 4 ? 0 : (x < 8 ? 255 : x * 53 % 256));
+        for (int c = 0; c < 3; ++c)
+        {
+            source[x * 4 + c] = static_cast<uint8_t>(alpha == 0 ? 0 : (x * 31 + c * 17) % (alpha + 1));
+            destination[x * 4 + c] = static_cast<uint8_t>(x * 7 + c * 90);
+        }
+
+        source[x * 4 + 3] = alpha;
+        destination[x * 4 + 3] = static_cast<uint8_t>(x * 11);
+    }
+
+    auto blended = destination;
+    BlendPremultipliedRow(source.data(), blended.data(), pixels);
+
+    bool matches = true;
+    for (size_t i = 0; i < blended.size(); ++i)
+    {
+        matches = matches && blended[i] == ReferenceOver(source[i], destination[i], source[i / 4 * 4 + 3]);
+    }
+
+    TRACTUS_EXPECT(context, matches);
+}
+
+void UnchangedAndCoveredTilesAreSkipped(TestContext& context)
+{
+    LayerCompositor compositor(kWidth, kHeight);
+    const auto background = compositor.AddLayer(0, 0);
+    const auto graphic = compositor.AddLayer(1, 0);
+
+    const auto base = SolidFrame(0xFF204060u);
+    auto top = SolidFrame(0x00000000u);
+    // A half-transparent red patch straddling the first two tiles of the top tile row.
+    for (int32_t y = 10; y < 20; ++y)
+    {
+        for (int32_t x = 60; x < 70; ++x)
+        {
+            auto* p = top.data() + static_cast<size_t>(y) * kStride + static_cast<size_t>(x) * 4u;
+            p[2] = 0x80;
+            p[3] = 0x80;
+        }
+    }
+
+    std::vector<uint8_t> output(static_cast<size_t>(kStride) * kHeight, 0xEEu);
+    compositor.Submit(background, base.data(), kStride, 0);
+    compositor.Submit(graphic, top.data(), kStride, 0);
+    compositor.Compose(output.data(), kStride, 0, nullptr, FrameTaskClock::now());
+
+    bool matches = true;
+    for (size_t i = 0; i < output.size(); ++i)
+    {
+        matches = matches && output[i] == ReferenceOver(top[i], base[i], top[i / 4 * 4 + 3]);
+    }
+
+    TRACTUS_EXPECT(context, matches);
+    TRACTUS_EXPECT(context, compositor.GetStatistics().tiles_composed == kTileCount);
+
+    // Resubmitting identical frames changes no tile versions, so the next composite writes nothing.
+    compositor.Submit(background, base.data(), kStride, 1);
+    compositor.Submit(graphic, top.data(), kStride, 1);
+    compositor.Compose(output.data(), kStride, 1, nullptr, FrameTaskClock::now());
+    TRACTUS_EXPECT(context, compositor.GetStatistics().tiles_composed == kTileCount);
+    TRACTUS_EXPECT(context, compositor.GetStatistics().tiles_skipped == kTileCount);
+
+    // Touching one pixel of the top layer recomposes only its tile.
+    top[static_cast<size_t>(66) * kStride + 140u * 4u + 3u] = 0x40;
+    compositor.Submit(graphic, top.data(), kStride, 2);
+    compositor.Compose(output.data(), kStride, 2, nullptr, FrameTaskClock::now());
+    TRACTUS_EXPECT(context, compositor.GetStatistics().tiles_composed == kTileCount + 1);
+}
+
+void DelayedLayerUsesOlderFrame(TestContext& context)
+{
+    LayerCompositor compositor(kWidth, kHeight);
+    const auto fast = compositor.AddLayer(0, 2);
+    std::vector<uint8_t> output(static_cast<size_t>(kStride) * kHeight);
+    for (uint32_t frame = 1; frame <= 4; ++frame)
+    {
+        const auto pixels = SolidFrame(0xFF000000u | frame);
+        compositor.Submit(fast, pixels.data(), kStride, static_cast<int64_t>(frame) * 1000);
+    }
+
+    compositor.Compose(output.data(), kStride, 5000, nullptr, FrameTaskClock::now());
+    const auto statistics = compositor.GetLayerStatistics(fast);
+    TRACTUS_EXPECT(context, output[0] == 2u);
+    TRACTUS_EXPECT(context, statistics.last_age_microseconds == 3000);
+    TRACTUS_EXPECT(context, statistics.frames_submitted == 4u);
+}
+} // namespace
+
+void RunLayerCompositorTests(TestContext& context)
+{
+    BlendMatchesScalarReference(context);
+    UnchangedAndCoveredTilesAreSkipped(context);
+    DelayedLayerUsesOlderFrame(context);
+}
+} // namespace tests
+} // namespace tractus
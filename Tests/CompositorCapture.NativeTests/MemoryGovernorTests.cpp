@@ -0,0 +1,115 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/FrameAllocator.h"
+#include "../../Native/CompositorCapture/MemoryGovernor.h"
+
+#include <cstdint>
+#include <utility>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+const MemoryPoolStatistics& PoolOf(const MemoryGovernorStatistics& statistics, MemoryPool pool)
+{
+    return statistics.pools[static_cast<size_t>(pool)];
+}
+
+void ReservationsAreCountedPerPool(TestContext& context)
+{
+    auto& governor = MemoryGovernor::Instance();
+    governor.SetBudget(0);
+    governor.ResetStatistics();
+    const auto before = governor.GetStatistics();
+
+    TRACTUS_EXPECT(context, governor.TryReserve(MemoryPool::kRenditions, 1000u));
+    governor.Reserve(MemoryPool::kPipeline, 500u);
+    auto during = governor.GetStatistics();
+    TRACTUS_EXPECT(context, during.in_use_bytes == before.in_use_bytes + 1500u);
+    TRACTUS_EXPECT(context, PoolOf(during, MemoryPool::kRenditions).in_use_bytes == PoolOf(before, MemoryPool::kRenditions).in_use_bytes + 1000u);
+    TRACTUS_EXPECT(context, PoolOf(during, MemoryPool::kPipeline).in_use_bytes == PoolOf(before, MemoryPool::kPipeline).in_use_bytes + 500u);
+
+    governor.Release(MemoryPool::kRenditions, 1000u);
+    governor.Release(MemoryPool::kPipeline, 500u, true);
+    const auto after = governor.GetStatistics();
+    TRACTUS_EXPECT(context, after.in_use_bytes == before.in_use_bytes);
+    TRACTUS_EXPECT(context, after.high_water_bytes >= before.in_use_bytes + 1500u);
+    TRACTUS_EXPECT(context, PoolOf(after, MemoryPool::kRenditions).high_water_bytes >= 1000u);
+    TRACTUS_EXPECT(context, after.trimmed_bytes == 500u);
+    TRACTUS_EXPECT(context, after.refusals == 0u);
+}
+
+void BudgetRefusesAndRequiredBytesOvercommit(TestContext& context)
+{
+    auto& governor = MemoryGovernor::Instance();
+    governor.ResetStatistics();
+    const auto base = governor.GetStatistics().in_use_bytes;
+    governor.SetBudget(base + 4096u);
+
+    TRACTUS_EXPECT(context, governor.TryReserve(MemoryPool::kPipeline, 4096u));
+    TRACTUS_EXPECT(context, !governor.TryReserve(MemoryPool::kPipeline, 1u));
+    auto statistics = governor.GetStatistics();
+    TRACTUS_EXPECT(context, statistics.refusals == 1u);
+    TRACTUS_EXPECT(context, PoolOf(statistics, MemoryPool::kPipeline).refusals == 1u);
+
+    // Required bytes go over budget and leave no headroom for anything else.
+    governor.Reserve(MemoryPool::kPipeline, 1024u);
+    governor.Release(MemoryPool::kPipeline, 4096u);
+    TRACTUS_EXPECT(context, !governor.TryReserve(MemoryPool::kCapture, 3584u));
+    TRACTUS_EXPECT(context, governor.TryReserve(MemoryPool::kCapture, 3072u));
+    governor.Release(MemoryPool::kCapture, 3072u);
+    governor.Release(MemoryPool::kPipeline, 1024u);
+
+    TRACTUS_EXPECT(context, governor.GetStatistics().in_use_bytes == base);
+    governor.SetBudget(0);
+}
+
+void FrameBuffersDrawFromTheirPool(TestContext& context)
+{
+    auto& governor = MemoryGovernor::Instance();
+    governor.ResetStatistics();
+    const auto base = governor.GetStatistics();
+    governor.SetBudget(base.in_use_bytes + 1024u * 1024u);
+
+    FrameMemoryPolicy policy;
+    policy.pool = MemoryPool::kLayers;
+    FrameBuffer buffer(policy);
+    buffer.assign(512u * 1024u, 0u);
+    TRACTUS_EXPECT(context, PoolOf(governor.GetStatistics(), MemoryPool::kLayers).in_use_bytes == PoolOf(base, MemoryPool::kLayers).in_use_bytes + 512u * 1024u);
+
+    // An allocation over budget throws and leaves the buffer empty rather than half-charged.
+    bool refused = false;
+    try
+    {
+        buffer.assign(2u * 1024u * 1024u, 0u);
+    }
+    catch (const FrameBudgetExceeded&)
+    {
+        refused = true;
+    }
+
+    TRACTUS_EXPECT(context, refused);
+    TRACTUS_EXPECT(context, buffer.empty());
+    TRACTUS_EXPECT(context, governor.GetStatistics().in_use_bytes == base.in_use_bytes);
+
+    buffer.assign(1024u * 1024u, 0u);
+    FrameBuffer moved(std::move(buffer));
+    moved.Trim();
+    const auto after = governor.GetStatistics();
+    TRACTUS_EXPECT(context, after.in_use_bytes == base.in_use_bytes);
+    TRACTUS_EXPECT(context, after.trimmed_bytes == 1024u * 1024u);
+    TRACTUS_EXPECT(context, PoolOf(after, MemoryPool::kLayers).refusals == 1u);
+    governor.SetBudget(0);
+}
+} // namespace
+
+void RunMemoryGovernorTests(TestContext& context)
+{
+    ReservationsAreCountedPerPool(context);
+    BudgetRefusesAndRequiredBytesOvercommit(context);
+    FrameBuffersDrawFromTheirPool(context);
+}
+} // namespace tests
+} // namespace tractus
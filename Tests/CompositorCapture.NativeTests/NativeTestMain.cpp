@@ -0,0 +1,61 @@
+#include "NativeTests.h"
+
+#include <cstring>
+
+namespace
+{
+/// <summary>
+/// Associates a test group name with its entry point so individual groups can be selected from the command line.
+/// </summary>
+struct TestGroup
+{
+    const char* name;
+    void (*run)(tractus::tests::TestContext& context);
+};
+
+const TestGroup kGroups[] = {
+    {"rate-conversion", tractus::tests::RunFrameRateConverterTests},
+    {"field-weave", tractus::tests::RunFieldWeaverTests},
+    {"overlay", tractus::tests::RunOverlayCompositorTests},
+    {"layer-compose", tractus::tests::RunLayerCompositorTests},
+    {"alpha", tractus::tests::RunAlphaConverterTests},
+    {"cpu-features", tractus::tests::RunCpuFeaturesTests},
+    {"thread-policy", tractus::tests::RunThreadPolicyTests},
+    {"frame-allocator", tractus::tests::RunFrameAllocatorTests},
+    {"frame-copy", tractus::tests::RunFrameCopyTests},
+    {"memory-governor", tractus::tests::RunMemoryGovernorTests},
+    {"telemetry-counters", tractus::tests::RunTelemetryCountersTests},
+    {"flight-recorder", tractus::tests::RunFlightRecorderTests},
+    {"pacing-clock", tractus::tests::RunPacingClockTests},
+    {"capture-faults", tractus::tests::RunCaptureFaultsTests},
+    {"content-hash", tractus::tests::RunContentHashTests},
+    {"frame-scheduler", tractus::tests::RunFrameTaskSchedulerTests},
+    {"frame-scaler", tractus::tests::RunFrameScalerTests},
+    {"box-downsample", tractus::tests::RunBoxDownsamplerTests},
+};
+} // namespace
+
+int main(int argc, char** argv)
+{
+    int failed_groups = 0;
+    for (const auto& group : kGroups)
+    {
+        bool selected = argc <= 1;
+        for (int i = 1; i < argc; ++i)
+        {
+            selected = selected || std::strcmp(argv[i], group.name) == 0;
+        }
+
+        if (!selected)
+        {
+            continue;
+        }
+
+        tractus::tests::TestContext context;
+        group.run(context);
+        std::printf("%-20s %s\n", group.name, context.failures == 0 ? "passed" : "FAILED");
+        failed_groups += context.failures == 0 ? 0 : 1;
+    }
+
+    return failed_groups == 0 ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cstdio>
+
+namespace tractus
+{
+namespace tests
+{
+/// <summary>
+/// Tracks the failures raised while the current test runs.
+/// </summary>
+struct TestContext
+{
+    int failures{0};
+
+    void Fail(const char* file, int line, const char* expression)
+    {
+        ++failures;
+        std::fprintf(stderr, "  %s(%d): check failed: %s\n", file, line, expression);
+    }
+};
+
+/// <summary>
+/// Verifies the reciprocal-table unpremultiply against an exact divide and the opaque pre-scan of <c>AlphaConverter</c>.
+/// </summary>
+void RunAlphaConverterTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>DownsampleBox</c> matches a rounded block average for factors 2 and 4, writes only the requested
+/// destination rows and refuses other factors.
+/// </summary>
+void RunBoxDownsamplerTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>CaptureFaultInjector</c> replays by seed, releases bursts together, skips stalled frames, drifts
+/// without rounding creep and draws jitter and preemptions at their configured rates, and that <c>RunCaptureLoop</c>
+/// follows the cadence or the injector on a <c>VirtualPacingClock</c>.
+/// </summary>
+void RunCaptureFaultsTests(TestContext& context);
+
+/// <summary>
+/// Verifies that the SSE2 <c>HashFrame</c> matches its scalar form, ignores row padding, changes with every input bit
+/// and with moved content, and matches the managed port.
+/// </summary>
+void RunContentHashTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>DetectSimdLevel</c> covers the tier the kernels were compiled for and is stable.
+/// </summary>
+void RunCpuFeaturesTests(TestContext& context);
+
+/// <summary>
+/// Verifies event order, ring wrap-around, tear-free snapshots under concurrent writers and the Chrome trace output
+/// of <c>FlightRecorder</c>.
+/// </summary>
+void RunFlightRecorderTests(TestContext& context);
+
+/// <summary>
+/// Verifies fill, reuse and move semantics of <c>FrameBuffer</c> and that large-page requests fall back cleanly.
+/// </summary>
+void RunFrameAllocatorTests(TestContext& context);
+
+/// <summary>
+/// Verifies that the streaming <c>CopyFrame</c> matches <c>memcpy</c> for every alignment and around its threshold.
+/// </summary>
+void RunFrameCopyTests(TestContext& context);
+
+/// <summary>
+/// Verifies exact-phase scheduling, drop/repeat cadences and blend judder of <c>FrameRateConverter</c>.
+/// </summary>
+void RunFrameRateConverterTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>FrameScaler</c> keeps flat colours flat and copies at identity size with both filters, matches a
+/// double-precision reference for odd-sized up- and downscales, and scales the same through scheduler bands as in one pass.
+/// </summary>
+void RunFrameScalerTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>FrameTaskScheduler::ParallelFor</c> runs every index exactly once even with every worker busy, that
+/// the deadline lane runs earliest-deadline-first ahead of other jobs, and that idle wakeups and shutdown lose no job.
+/// </summary>
+void RunFrameTaskSchedulerTests(TestContext& context);
+
+/// <summary>
+/// Verifies field parity, odd heights and the flicker filter of <c>WeaveField</c>.
+/// </summary>
+void RunFieldWeaverTests(TestContext& context);
+
+/// <summary>
+/// Verifies premultiplied blending, tile skipping and per-layer delay of <c>LayerCompositor</c>.
+/// </summary>
+void RunLayerCompositorTests(TestContext& context);
+
+/// <summary>
+/// Verifies per-pool accounting, budget refusals and idle trimming of <c>MemoryGovernor</c> and its use by <c>FrameBuffer</c>.
+/// </summary>
+void RunMemoryGovernorTests(TestContext& context);
+
+/// <summary>
+/// Verifies blend rounding and clipping, drop-frame timecode and overlay bounds of <c>OverlayCompositor</c>.
+/// </summary>
+void RunOverlayCompositorTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>VirtualPacingClock</c> jumps to deadlines without going backwards and that <c>FrameCadence</c>
+/// keeps its rate through late wakes and restarts its grid after an overrun.
+/// </summary>
+void RunPacingClockTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>TelemetryCounters</c> sums every thread's block, keeps the counts of threads that have exited, and
+/// buckets durations by doubling bounds.
+/// </summary>
+void RunTelemetryCountersTests(TestContext& context);
+
+/// <summary>
+/// Verifies that <c>ScopedThreadPolicy</c> leaves default threads alone, applies affinity and timer slack, and never
+/// grants more than the requested priority.
+/// </summary>
+void RunThreadPolicyTests(TestContext& context);
+} // namespace tests
+} // namespace tractus
+
+/// <summary>
+/// Records a failure without aborting the test so every broken expectation is reported in one run.
+/// </summary>
+#define TRACTUS_EXPECT(context, condition)                         \
+    do                                                             \
+    {                                                              \
+        if (!(condition))                                          \
+        {                                                          \
+            (context).Fail(__FILE__, __LINE__, #condition);        \
+        }                                                          \
+    } while (false)
@@ -0,0 +1,168 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/OverlayCompositor.h"
+
+#include <cstring>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+std::vector<uint8_t> CreateFrame(int32_t stride, int32_t height)
+{
+    std::vector<uint8_t> frame(static_cast<size_t>(stride) * height);
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+        frame[i] = static_cast<uint8_t>(i * 37u + (i >> 5));
+    }
+
+    return frame;
+}
+
+uint8_t ReferenceBlend(uint32_t source, uint32_t destination, uint32_t alpha)
+{
+    return static_cast<uint8_t>((source * alpha + destination * (255u - alpha) + 127u) / 255u);
+}
+
+void RectangleBlendMatchesScalarReference(TestContext& context)
+{
+    constexpr int32_t width = 23;
+    constexpr int32_t height = 9;
+    constexpr int32_t stride = width * 4 + 8;
+    constexpr uint32_t color = 0x80C04020u;
+    const auto original = CreateFrame(stride, height);
+
+    // The second and third rectangles hang off the top-left and bottom-right edges and must be clipped.
+    const int32_t rects[][4] = {{3, 2, 11, 5}, {-4, -3, 9, 6}, {17, 6, 20, 20}};
+    for (const auto& rect : rects)
+    {
+        auto frame = original;
+        const auto pixels = BlendRect(frame.data(), stride, width, height, rect[0], rect[1], rect[2], rect[3], color);
+
+        uint64_t expected_pixels = 0;
+        bool matches = true;
+        for (int32_t y = 0; y < height; ++y)
+        {
+            for (int32_t x = 0; x < stride; ++x)
+            {
+                const auto offset = static_cast<size_t>(y) * stride + x;
+                const auto px = x / 4;
+                const bool inside = x < width * 4 && px >= rect[0] && px < rect[0] + rect[2] && y >= rect[1] && y < rect[1] + rect[3];
+                auto expected = original[offset];
+                if (inside)
+                {
+                    const auto channel = x % 4;
+                    const auto source = channel == 3 ? 255u : (color >> (8 * channel)) & 0xFFu;
+                    expected = ReferenceBlend(source, original[offset], color >> 24);
+                    expected_pixels += channel == 0 ? 1u : 0u;
+                }
+
+                matches = matches && frame[offset] == expected;
+            }
+        }
+
+        TRACTUS_EXPECT(context, matches);
+        TRACTUS_EXPECT(context, pixels == expected_pixels);
+    }
+}
+
+void MaskBlendHonoursCoverage(TestContext& context)
+{
+    constexpr int32_t width = 13;
+    constexpr int32_t height = 3;
+    constexpr int32_t stride = width * 4;
+    constexpr uint32_t color = 0xFF10E0F0u;
+    const auto original = CreateFrame(stride, height);
+    std::vector<uint8_t> mask(static_cast<size_t>(width) * height);
+    for (size_t i = 0; i < mask.size(); ++i)
+    {
+        mask[i] = static_cast<uint8_t>(i % 3 == 0 ? 0u : i * 29u);
+    }
+
+    auto frame = original;
+    BlendMask(frame.data(), stride, width, height, 0, 0, mask.data(), width, width, height, color);
+
+    bool matches = true;
+    for (size_t i = 0; i < frame.size(); ++i)
+    {
+        const auto channel = i % 4;
+        const auto source = channel == 3 ? 255u : (color >> (8 * channel)) & 0xFFu;
+        matches = matches && frame[i] == ReferenceBlend(source, original[i], mask[i / 4]);
+    }
+
+    TRACTUS_EXPECT(context, matches);
+}
+
+void TimecodeCountsDropFrames(TestContext& context)
+{
+    TRACTUS_EXPECT(context, FormatTimecode(0, 30000, 1001) == "00:00:00;00");
+    TRACTUS_EXPECT(context, FormatTimecode(1799, 30000, 1001) == "00:00:59;29");
+    TRACTUS_EXPECT(context, FormatTimecode(1800, 30000, 1001) == "00:01:00;02");
+    TRACTUS_EXPECT(context, FormatTimecode(17982, 30000, 1001) == "00:10:00;00");
+    TRACTUS_EXPECT(context, FormatTimecode(3600, 60000, 1001) == "00:01:00;04");
+    TRACTUS_EXPECT(context, FormatTimecode(90000, 25, 1) == "01:00:00:00");
+    TRACTUS_EXPECT(context, FormatTimecode(24, 24000, 1001) == "00:00:01:00");
+}
+
+void OverlaysTouchOnlyTheirRectangles(TestContext& context)
+{
+    constexpr int32_t width = 320;
+    constexpr int32_t height = 180;
+    constexpr int32_t stride = width * 4;
+    const auto original = CreateFrame(stride, height);
+
+    OverlaySpec timecode;
+    timecode.kind = OverlayKind::kTimecode;
+    timecode.x = 40;
+    timecode.y = 100;
+    timecode.scale = 2;
+    timecode.background = 0xC0000000u;
+
+    OverlayCompositor compositor;
+    compositor.SetOverlays({timecode});
+    TRACTUS_EXPECT(context, compositor.HasOverlays());
+
+    auto frame = original;
+    OverlayFrameInfo info;
+    info.frame_index = 123456;
+    const auto pixels = compositor.Apply(frame.data(), stride, width, height, info);
+
+    // "HH:MM:SS:FF" is 11 glyph cells of 12x18 pixels plus one font pixel of padding on each side.
+    const int32_t box_width = 11 * 12 + 4;
+    const int32_t box_height = 18;
+    bool outside_untouched = true;
+    bool inside_changed = false;
+    for (int32_t y = 0; y < height; ++y)
+    {
+        for (int32_t x = 0; x < width; ++x)
+        {
+            const auto offset = static_cast<size_t>(y) * stride + static_cast<size_t>(x) * 4u;
+            const bool changed = std::memcmp(frame.data() + offset, original.data() + offset, 4) != 0;
+            const bool inside = x >= timecode.x && x < timecode.x + box_width && y >= timecode.y && y < timecode.y + box_height;
+            outside_untouched = outside_untouched && (inside || !changed);
+            inside_changed = inside_changed || (inside && changed);
+        }
+    }
+
+    TRACTUS_EXPECT(context, outside_untouched);
+    TRACTUS_EXPECT(context, inside_changed);
+    TRACTUS_EXPECT(context, pixels >= static_cast<uint64_t>(box_width) * box_height);
+
+    compositor.SetOverlays({});
+    TRACTUS_EXPECT(context, !compositor.HasOverlays());
+    TRACTUS_EXPECT(context, compositor.Apply(frame.data(), stride, width, height, info) == 0);
+}
+} // namespace
+
+void RunOverlayCompositorTests(TestContext& context)
+{
+    RectangleBlendMatchesScalarReference(context);
+    MaskBlendHonoursCoverage(context);
+    TimecodeCountsDropFrames(context);
+    OverlaysTouchOnlyTheirRectangles(context);
+}
+} // namespace tests
+} // namespace tractus
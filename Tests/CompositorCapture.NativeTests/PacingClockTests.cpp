@@ -0,0 +1,102 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/PacingClock.h"
+
+#include <chrono>
+#include <cstdint>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+using namespace std::chrono_literals;
+
+constexpr PacingClock::Duration kInterval = std::chrono::microseconds(16667);
+
+void VirtualSleepsJumpToTheDeadline(TestContext& context)
+{
+    const PacingClock::TimePoint origin{};
+    VirtualPacingClock clock(origin);
+    TRACTUS_EXPECT(context, clock.Now() == origin);
+
+    clock.SleepUntil(origin + 5ms);
+    TRACTUS_EXPECT(context, clock.Now() == origin + 5ms);
+
+    // Sleeping until a deadline that has passed neither waits nor moves the clock back.
+    clock.SleepUntil(origin + 1ms);
+    TRACTUS_EXPECT(context, clock.Now() == origin + 5ms);
+    TRACTUS_EXPECT(context, clock.Sleeps() == 1u);
+
+    clock.Advance(2ms);
+    clock.SetWakeLatency(300us);
+    clock.SleepUntil(origin + 10ms);
+    TRACTUS_EXPECT(context, clock.Now() == origin + 10ms + 300us);
+    TRACTUS_EXPECT(context, clock.Sleeps() == 2u);
+}
+
+void CadenceKeepsItsRateThroughLateWakes(TestContext& context)
+{
+    const PacingClock::TimePoint origin{};
+    VirtualPacingClock clock(origin);
+    clock.SetWakeLatency(400us);
+    FrameCadence cadence(clock, kInterval);
+
+    // An hour of 60 fps frames, each taking 2 ms of work on top of a late wake.
+    constexpr int64_t kFrames = 60 * 60 * 60;
+    const auto first = clock.Now();
+    for (int64_t frame = 0; frame < kFrames; ++frame)
+    {
+        const auto started = clock.Now();
+        clock.Advance(2ms);
+        cadence.WaitForNextFrame(started);
+    }
+
+    // Late wakes shift every frame by the same amount instead of piling up over the hour.
+    TRACTUS_EXPECT(context, clock.Now() == first + kInterval * kFrames + 400us);
+    TRACTUS_EXPECT(context, cadence.Resyncs() == 0u);
+}
+
+void CadenceRestartsAfterAnOverrun(TestContext& context)
+{
+    const PacingClock::TimePoint origin{};
+    VirtualPacingClock clock(origin);
+    FrameCadence cadence(clock, kInterval);
+
+    cadence.WaitForNextFrame(clock.Now());
+    TRACTUS_EXPECT(context, clock.Now() == origin + kInterval);
+
+    // A frame that stalls for three intervals is followed at once by the next, not by a burst of catch-up frames.
+    const auto stalled = clock.Now();
+    clock.Advance(kInterval * 3);
+    cadence.WaitForNextFrame(stalled);
+    const auto resumed = clock.Now();
+    TRACTUS_EXPECT(context, resumed == stalled + kInterval * 3);
+    TRACTUS_EXPECT(context, cadence.Resyncs() == 1u);
+
+    cadence.WaitForNextFrame(resumed);
+    TRACTUS_EXPECT(context, clock.Now() == resumed + kInterval);
+    cadence.WaitForNextFrame(clock.Now());
+    TRACTUS_EXPECT(context, clock.Now() == resumed + kInterval * 2);
+    TRACTUS_EXPECT(context, cadence.Resyncs() == 1u);
+}
+
+void SystemClockSleepsUntilTheDeadline(TestContext& context)
+{
+    auto& clock = PacingClock::System();
+    const auto deadline = clock.Now() + 2ms;
+    clock.SleepUntil(deadline);
+    TRACTUS_EXPECT(context, clock.Now() >= deadline);
+}
+} // namespace
+
+void RunPacingClockTests(TestContext& context)
+{
+    VirtualSleepsJumpToTheDeadline(context);
+    CadenceKeepsItsRateThroughLateWakes(context);
+    CadenceRestartsAfterAnOverrun(context);
+    SystemClockSleepsUntilTheDeadline(context);
+}
+} // namespace tests
+} // namespace tractus
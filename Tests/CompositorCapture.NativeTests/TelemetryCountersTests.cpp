@@ -0,0 +1,108 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/TelemetryCounters.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+uint64_t CountOf(const TelemetrySnapshot& snapshot, TelemetryCounter counter)
+{
+    return snapshot[counter];
+}
+
+void CountsFromEveryThreadAreSummed(TestContext& context)
+{
+    const auto before = TelemetryCounters::Snapshot();
+
+    constexpr int32_t kThreads = 4;
+    constexpr uint64_t kIncrements = 10000;
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < kThreads; ++t)
+    {
+        threads.emplace_back([]()
+        {
+            for (uint64_t i = 0; i < kIncrements; ++i)
+            {
+                TelemetryCounters::Add(TelemetryCounter::kFramesCaptured);
+            }
+
+            TelemetryCounters::Add(TelemetryCounter::kTilesSkipped, 7u);
+        });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    // Every writer has exited, so its counts must have been folded into the retired total rather than lost.
+    const auto after = TelemetryCounters::Snapshot();
+    TRACTUS_EXPECT(context, CountOf(after, TelemetryCounter::kFramesCaptured) - CountOf(before, TelemetryCounter::kFramesCaptured) == kThreads * kIncrements);
+    TRACTUS_EXPECT(context, CountOf(after, TelemetryCounter::kTilesSkipped) - CountOf(before, TelemetryCounter::kTilesSkipped) == kThreads * 7u);
+    TRACTUS_EXPECT(context, CountOf(after, TelemetryCounter::kOverlayFrames) == CountOf(before, TelemetryCounter::kOverlayFrames));
+}
+
+void LiveThreadsAreVisibleAndSnapshotsNeverGoBackwards(TestContext& context)
+{
+    const auto before = TelemetryCounters::Snapshot();
+    TelemetryCounters::Add(TelemetryCounter::kCompositesDelivered, 3u);
+    const auto live = TelemetryCounters::Snapshot();
+    TRACTUS_EXPECT(context, CountOf(live, TelemetryCounter::kCompositesDelivered) == CountOf(before, TelemetryCounter::kCompositesDelivered) + 3u);
+
+    std::thread writer([]()
+    {
+        TelemetryCounters::Add(TelemetryCounter::kCompositesDelivered, 5u);
+    });
+    writer.join();
+
+    const auto after = TelemetryCounters::Snapshot();
+    TRACTUS_EXPECT(context, CountOf(after, TelemetryCounter::kCompositesDelivered) == CountOf(live, TelemetryCounter::kCompositesDelivered) + 5u);
+    for (size_t i = 0; i < kTelemetryCounterCount; ++i)
+    {
+        TRACTUS_EXPECT(context, after.counters[i] >= live.counters[i]);
+    }
+}
+
+void DurationsLandInDoublingBuckets(TestContext& context)
+{
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(-5) == 0u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(0) == 0u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(1024) == 0u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(1025) == 1u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(2048) == 1u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(1'000'000) == 10u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(static_cast<int64_t>(kTelemetryHistogramFirstBound) << 15) == 15u);
+    TRACTUS_EXPECT(context, TelemetryCounters::BucketOf(int64_t{1} << 40) == kTelemetryHistogramBuckets - 1);
+
+    const auto before = TelemetryCounters::Snapshot()[TelemetryHistogram::kComposite];
+    std::thread writer([]()
+    {
+        TelemetryCounters::Record(TelemetryHistogram::kComposite, 500);
+        TelemetryCounters::Record(TelemetryHistogram::kComposite, 3'000'000);
+    });
+    writer.join();
+    TelemetryCounters::Record(TelemetryHistogram::kComposite, 3'000'000);
+
+    const auto after = TelemetryCounters::Snapshot()[TelemetryHistogram::kComposite];
+    TRACTUS_EXPECT(context, after.count == before.count + 3u);
+    TRACTUS_EXPECT(context, after.sum_nanoseconds == before.sum_nanoseconds + 6'000'500u);
+    TRACTUS_EXPECT(context, after.buckets[0] == before.buckets[0] + 1u);
+    TRACTUS_EXPECT(context, after.buckets[12] == before.buckets[12] + 2u);
+}
+} // namespace
+
+void RunTelemetryCountersTests(TestContext& context)
+{
+    CountsFromEveryThreadAreSummed(context);
+    LiveThreadsAreVisibleAndSnapshotsNeverGoBackwards(context);
+    DurationsLandInDoublingBuckets(context);
+}
+} // namespace tests
+} // namespace tractus
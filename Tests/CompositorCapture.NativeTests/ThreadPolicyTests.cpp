@@ -0,0 +1,74 @@
+#include "NativeTests.h"
+
+#include "../../Native/CompositorCapture/ThreadPolicy.h"
+
+#include <thread>
+
+namespace tractus
+{
+namespace tests
+{
+namespace
+{
+/// <summary>
+/// Applies <paramref name="policy"/> on a throwaway thread so the test runner's own thread keeps its scheduling.
+/// </summary>
+ThreadPolicyOutcome ApplyOnThread(const ThreadPolicy& policy)
+{
+    ThreadPolicyOutcome outcome;
+    std::thread thread([&]()
+    {
+        const ScopedThreadPolicy applied(policy);
+        outcome = applied.Outcome();
+    });
+    thread.join();
+    return outcome;
+}
+
+void DefaultPolicyChangesNothing(TestContext& context)
+{
+    const ThreadPolicy policy;
+    TRACTUS_EXPECT(context, policy.IsDefault());
+
+    const auto outcome = ApplyOnThread(policy);
+    TRACTUS_EXPECT(context, outcome.priority == ThreadPriorityClass::kNormal);
+    TRACTUS_EXPECT(context, !outcome.affinity_applied);
+    TRACTUS_EXPECT(context, !outcome.timer_slack_applied);
+}
+
+void AffinityAndSlackApply(TestContext& context)
+{
+    ThreadPolicy policy;
+    policy.affinity_mask = 1u;
+    policy.timer_slack_nanoseconds = 1000;
+    TRACTUS_EXPECT(context, !policy.IsDefault());
+
+    const auto outcome = ApplyOnThread(policy);
+#if defined(_WIN32) || defined(__linux__)
+    TRACTUS_EXPECT(context, outcome.affinity_applied);
+    TRACTUS_EXPECT(context, outcome.timer_slack_applied);
+#endif
+    TRACTUS_EXPECT(context, outcome.priority == ThreadPriorityClass::kNormal);
+}
+
+void GrantedPriorityNeverExceedsRequest(TestContext& context)
+{
+    // Whether realtime or raised priorities are granted depends on privileges, so only the ordering is fixed.
+    ThreadPolicy policy;
+    policy.priority = ThreadPriorityClass::kHigh;
+    TRACTUS_EXPECT(context, ApplyOnThread(policy).priority != ThreadPriorityClass::kRealtime);
+
+    policy.priority = ThreadPriorityClass::kRealtime;
+    const auto granted = ApplyOnThread(policy).priority;
+    TRACTUS_EXPECT(context, granted >= ThreadPriorityClass::kNormal && granted <= ThreadPriorityClass::kRealtime);
+}
+} // namespace
+
+void RunThreadPolicyTests(TestContext& context)
+{
+    DefaultPolicyChangesNothing(context);
+    AffinityAndSlackApply(context);
+    GrantedPriorityNeverExceedsRequest(context);
+}
+} // namespace tests
+} // namespace tractus
@@ -0,0 +1,236 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using NewTek;
+using Serilog;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class AsyncSendRetentionTests
+{
+    /// <summary>
+    /// Models NDI's asynchronous send: the buffer of each send is read until the next send or a flush returns. Every
+    /// call checks that buffer is still alive and still holds the first byte it was sent with, and records a
+    /// violation when it has been freed or rewritten.
+    /// </summary>
+    private sealed class AsyncSender : INdiVideoSender
+    {
+        private readonly Func<IntPtr, bool> isAlive;
+        private IntPtr inFlight;
+        private byte inFlightValue;
+
+        public AsyncSender(Func<IntPtr, bool> isAlive)
+        {
+            this.isAlive = isAlive;
+        }
+
+        public bool RequiresFrameRetention => true;
+
+        public List<IntPtr> Sent { get; } = new();
+
+        public List<string> Violations { get; } = new();
+
+        public int Flushes { get; private set; }
+
+        public bool Fail { get; set; }
+
+        public void Send(ref NDIlib.video_frame_v2_t frame)
+        {
+            if (Fail)
+            {
+                throw new InvalidOperationException("Send failed.");
+            }
+
+            CheckInFlight();
+            if (!isAlive(frame.p_data))
+            {
+                Violations.Add($"Sent a released buffer {frame.p_data}.");
+            }
+
+            Sent.Add(frame.p_data);
+            inFlight = frame.p_data;
+            inFlightValue = Marshal.ReadByte(inFlight);
+        }
+
+        public void Flush()
+        {
+            CheckInFlight();
+            inFlight = IntPtr.Zero;
+            Flushes++;
+        }
+
+        private void CheckInFlight()
+        {
+            if (inFlight != IntPtr.Zero && !isAlive(inFlight))
+            {
+                Violations.Add($"Released {inFlight} while NDI could still read it.");
+            }
+            else if (inFlight != IntPtr.Zero && Marshal.ReadByte(inFlight) != inFlightValue)
+            {
+                Violations.Add($"Rewrote {inFlight} while NDI could still read it.");
+            }
+        }
+    }
+
+    /// <summary>
+    /// Delivers every captured frame in one unmanaged buffer, as Chromium's paint buffer and the helper's output
+    /// buffers do: each capture rewrites the pixels of the one before it.
+    /// </summary>
+    private sealed class OutputBuffer : IDisposable
+    {
+        public IntPtr Buffer { get; } = Marshal.AllocHGlobal(16);
+
+        public int Released { get; private set; }
+
+        public CapturedFrame Capture(byte value)
+        {
+            Marshal.WriteByte(Buffer, value);
+            return new CapturedFrame(Buffer, 2, 2, 8, Stopwatch.GetTimestamp(), DateTime.UtcNow, () => Released++);
+        }
+
+        public void Dispose() => Marshal.FreeHGlobal(Buffer);
+    }
+
+    private static NdiVideoFrame CreateFrame()
+    {
+        return new NdiVideoFrame(2, 2, 8, Marshal.AllocHGlobal(16));
+    }
+
+    private static NDIlib.video_frame_v2_t Describe(IntPtr buffer) => new()
+    {
+        xres = 2,
+        yres = 2,
+        line_stride_in_bytes = 8,
+        p_data = buffer,
+    };
+
+    private static bool IsLive(IEnumerable<NdiVideoFrame> frames, IntPtr buffer) => frames.Any(frame => frame.Buffer == buffer);
+
+    [Fact]
+    public void APacedFrameDisposedAfterItsSendIsFreedWhenTheNextSendReturns()
+    {
+        var frames = new List<NdiVideoFrame> { CreateFrame(), CreateFrame(), CreateFrame() };
+        var sender = new AsyncSender(buffer => IsLive(frames, buffer));
+        var retention = new AsyncSendRetention(sender);
+
+        foreach (var frame in frames)
+        {
+            var ndiFrame = Describe(frame.Buffer);
+            retention.Send(frame, ref ndiFrame);
+
+            // The pipeline replaces its last sent frame as soon as the send returns.
+            frame.Dispose();
+            Assert.NotEqual(IntPtr.Zero, frame.Buffer);
+        }
+
+        Assert.Equal(IntPtr.Zero, frames[0].Buffer);
+        Assert.Equal(IntPtr.Zero, frames[1].Buffer);
+
+        retention.Flush();
+
+        Assert.Equal(IntPtr.Zero, frames[2].Buffer);
+        Assert.Empty(sender.Violations);
+        Assert.Equal(3, sender.Sent.Count);
+        Assert.Equal(1, sender.Flushes);
+        Assert.False(retention.IsRetaining);
+    }
+
+    [Fact]
+    public void RepeatingTheRetainedFrameKeepsItAlive()
+    {
+        var frame = CreateFrame();
+        var sender = new AsyncSender(buffer => frame.Buffer == buffer);
+        var retention = new AsyncSendRetention(sender);
+        var buffer = frame.Buffer;
+
+        for (var i = 0; i < 4; i++)
+        {
+            var ndiFrame = Describe(buffer);
+            retention.Send(frame, ref ndiFrame);
+        }
+
+        frame.Dispose();
+        Assert.Equal(1, frame.SendReferences);
+        Assert.NotEqual(IntPtr.Zero, frame.Buffer);
+
+        retention.Flush();
+
+        Assert.Equal(IntPtr.Zero, frame.Buffer);
+        Assert.Empty(sender.Violations);
+    }
+
+    [Fact]
+    public void AFailedSendKeepsThePreviousFrameRetained()
+    {
+        var frames = new List<NdiVideoFrame> { CreateFrame(), CreateFrame() };
+        var sender = new AsyncSender(buffer => IsLive(frames, buffer));
+        var retention = new AsyncSendRetention(sender);
+        var ndiFrame = Describe(frames[0].Buffer);
+        retention.Send(frames[0], ref ndiFrame);
+        frames[0].Dispose();
+
+        sender.Fail = true;
+        ndiFrame = Describe(frames[1].Buffer);
+        Assert.Throws<InvalidOperationException>(() => retention.Send(frames[1], ref ndiFrame));
+
+        // The failed frame holds no send reference, so the caller's dispose frees it at once.
+        Assert.Equal(0, frames[1].SendReferences);
+        frames[1].Dispose();
+        Assert.Equal(IntPtr.Zero, frames[1].Buffer);
+        Assert.NotEqual(IntPtr.Zero, frames[0].Buffer);
+        Assert.True(retention.IsRetaining);
+
+        sender.Fail = false;
+        retention.Flush();
+        Assert.Equal(IntPtr.Zero, frames[0].Buffer);
+        Assert.Empty(sender.Violations);
+    }
+
+    [Fact]
+    public void FlushingWithNothingRetainedDoesNotCallTheSender()
+    {
+        var sender = new AsyncSender(_ => true);
+        var retention = new AsyncSendRetention(sender);
+
+        retention.Flush();
+
+        Assert.Equal(0, sender.Flushes);
+        Assert.Equal(0, retention.Flushes);
+    }
+
+    [Fact]
+    public void AsyncDirectSendsRetainACopySoTheNextCaptureCannotRewriteIt()
+    {
+        using var output = new OutputBuffer();
+        var sender = new AsyncSender(_ => true);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = false,
+            TelemetryInterval = TimeSpan.FromDays(1)
+        };
+
+        var pipeline = new NdiVideoPipeline(sender, new FrameRate(60, 1), options, new LoggerConfiguration().WriteTo.Sink(new NullSink()).CreateLogger());
+        try
+        {
+            for (var i = 0; i < 5; i++)
+            {
+                pipeline.HandleFrame(output.Capture((byte)(0x10 + i)));
+
+                // The capture goes back at once; NDI keeps reading the retained copy.
+                Assert.Equal(i + 1, output.Released);
+            }
+
+            pipeline.Stop();
+        }
+        finally
+        {
+            pipeline.Dispose();
+        }
+
+        Assert.Equal(1, sender.Flushes);
+        Assert.Equal(5, sender.Sent.Count);
+        Assert.DoesNotContain(sender.Sent, buffer => buffer == output.Buffer);
+        Assert.Empty(sender.Violations);
+    }
+}
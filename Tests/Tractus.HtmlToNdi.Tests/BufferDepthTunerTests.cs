@@ -0,0 +1,130 @@
+using System.Linq;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class BufferDepthTunerTests
+{
+    private static readonly BufferDepthTuning Tuning = BufferDepthTuning.Parse("1-8");
+
+    /// <summary>
+    /// One second of capture at 60 fps: on-time intervals plus the given number of gaps of the given length.
+    /// </summary>
+    private static long[] Second(int gaps = 0, double gapFrames = 0)
+    {
+        var histogram = new long[BufferDepthTuner.HistogramBuckets];
+        histogram[BufferDepthTuner.BucketOf(1)] = 60 - gaps;
+        if (gaps > 0)
+        {
+            histogram[BufferDepthTuner.BucketOf(gapFrames)] += gaps;
+        }
+
+        return histogram;
+    }
+
+    [Fact]
+    public void SteadyCaptureSettlesOneFrameAtATimeAfterEachHold()
+    {
+        var tuner = new BufferDepthTuner(Tuning, initialDepth: 4, depthCeiling: 8);
+        var decisions = new List<(int Second, BufferDepthDecision Decision)>();
+        for (var second = 0; second < 200; second++)
+        {
+            if (tuner.Evaluate(Second(), 0, second * 60L) is { } decision)
+            {
+                decisions.Add((second, decision));
+            }
+        }
+
+        Assert.Equal(1, tuner.Depth);
+        Assert.Equal(new[] { 3, 2, 1 }, decisions.Select(entry => entry.Decision.Depth));
+        Assert.All(decisions, entry => Assert.Equal(BufferDepthChangeReason.Settled, entry.Decision.Reason));
+        Assert.All(decisions.Zip(decisions.Skip(1)), pair => Assert.True(pair.Second.Second - pair.First.Second > 30));
+    }
+
+    [Fact]
+    public void LongCaptureGapsDeepenTheBufferUntilItCoversThem()
+    {
+        var tuner = new BufferDepthTuner(Tuning, initialDepth: 1, depthCeiling: 8);
+        var depths = new List<int>();
+        for (var second = 0; second < 20; second++)
+        {
+            tuner.Evaluate(Second(gaps: 1, gapFrames: 3.5), 0, second * 60L);
+            depths.Add(tuner.Depth);
+        }
+
+        // A gap of 3.5 intervals drains up to four frames, reached one frame per second and then held.
+        Assert.Equal(new[] { 2, 3, 4 }, depths.Take(3));
+        Assert.All(depths.Skip(3), depth => Assert.Equal(4, depth));
+        Assert.Equal(BufferDepthChangeReason.CaptureGaps, tuner.LastDecision?.Reason);
+        Assert.Equal(4, tuner.LastDecision?.RequiredDepth);
+    }
+
+    [Fact]
+    public void StarvedTicksDeepenTheBufferWhenTheGapsLookHarmless()
+    {
+        var tuner = new BufferDepthTuner(Tuning, initialDepth: 2, depthCeiling: 8);
+        tuner.Evaluate(Second(), 0, 0);
+        var decision = tuner.Evaluate(Second(), 1, 60);
+
+        Assert.Equal(3, tuner.Depth);
+        Assert.Equal(BufferDepthChangeReason.Starved, decision?.Reason);
+        Assert.True(decision?.StarvedProbability > Tuning.TargetUnderrunProbability);
+
+        // Steady ticks after the starvation hold the depth rather than shrinking straight back.
+        for (var second = 2; second < 30; second++)
+        {
+            Assert.Null(tuner.Evaluate(Second(), 1, second * 60L));
+        }
+    }
+
+    [Fact]
+    public void DepthStaysBetweenTheMinimumAndTheCeiling()
+    {
+        var tuner = new BufferDepthTuner(BufferDepthTuning.Parse("2-8"), initialDepth: 10, depthCeiling: 5);
+        Assert.Equal(5, tuner.Depth);
+        Assert.Equal(5, tuner.MaxDepth);
+
+        for (var second = 0; second < 10; second++)
+        {
+            tuner.Evaluate(Second(gaps: 5, gapFrames: 20), second, second * 60L);
+        }
+
+        Assert.Equal(5, tuner.Depth);
+
+        var settling = new BufferDepthTuner(BufferDepthTuning.Parse("2-8"), initialDepth: 3, depthCeiling: 8);
+        for (var second = 0; second < 300; second++)
+        {
+            settling.Evaluate(Second(), 0, second * 60L);
+        }
+
+        Assert.Equal(2, settling.Depth);
+    }
+
+    [Theory]
+    [InlineData("8", 1, 8)]
+    [InlineData("2-6", 2, 6)]
+    [InlineData(" 3 - 3 ", 3, 3)]
+    public void ParseReadsDepthRanges(string text, int minDepth, int maxDepth)
+    {
+        var tuning = BufferDepthTuning.Parse(text, 0.001);
+
+        Assert.True(tuning.IsEnabled);
+        Assert.Equal(minDepth, tuning.MinDepth);
+        Assert.Equal(maxDepth, tuning.MaxDepth);
+        Assert.Equal(0.001, tuning.TargetUnderrunProbability);
+        Assert.False(BufferDepthTuning.Parse(null).IsEnabled);
+    }
+
+    [Theory]
+    [InlineData("0-4", 1e-4)]
+    [InlineData("5-2", 1e-4)]
+    [InlineData("1-2-3", 1e-4)]
+    [InlineData("deep", 1e-4)]
+    [InlineData("1-8", 0)]
+    [InlineData("1-8", 1)]
+    public void ParseRejectsInvalidSettings(string text, double target)
+    {
+        Assert.Throws<FormatException>(() => BufferDepthTuning.Parse(text, target));
+    }
+}
@@ -0,0 +1,67 @@
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class CaptureFaultProfileTests
+{
+    [Fact]
+    public void ParseReturnsNoneWithoutFaults()
+    {
+        var profile = CaptureFaultProfile.Parse(" ");
+
+        Assert.Same(CaptureFaultProfile.None, profile);
+        Assert.False(profile.IsEnabled);
+    }
+
+    [Fact]
+    public void ParseReadsEveryFault()
+    {
+        var profile = CaptureFaultProfile.Parse("jitter=3, burst=120x4, stall=0.002:50-250, drift=-200, preempt=0.01:8.5, seed=7");
+
+        Assert.True(profile.IsEnabled);
+        Assert.Equal(7UL, profile.Seed);
+        Assert.Equal(TimeSpan.FromMilliseconds(3), profile.Jitter);
+        Assert.Equal(120, profile.BurstPeriod);
+        Assert.Equal(4, profile.BurstLength);
+        Assert.Equal(0.002, profile.StallProbability);
+        Assert.Equal(TimeSpan.FromMilliseconds(50), profile.MinStall);
+        Assert.Equal(TimeSpan.FromMilliseconds(250), profile.MaxStall);
+        Assert.Equal(-200, profile.DriftPpm);
+        Assert.Equal(0.01, profile.PreemptionProbability);
+        Assert.Equal(TimeSpan.FromMilliseconds(8.5), profile.Preemption);
+    }
+
+    [Fact]
+    public void ASingleStallLengthIsBothBounds()
+    {
+        var profile = CaptureFaultProfile.Parse("stall=0.01:100");
+
+        Assert.Equal(TimeSpan.FromMilliseconds(100), profile.MinStall);
+        Assert.Equal(TimeSpan.FromMilliseconds(100), profile.MaxStall);
+    }
+
+    [Fact]
+    public void ASeedAloneInjectsNothing()
+    {
+        Assert.False(CaptureFaultProfile.Parse("seed=3").IsEnabled);
+    }
+
+    [Theory]
+    [InlineData("wobble=1")]
+    [InlineData("jitter=-1")]
+    [InlineData("jitter=fast")]
+    [InlineData("burst=4")]
+    [InlineData("burst=3x4")]
+    [InlineData("burst=10x1")]
+    [InlineData("stall=1.5:10-20")]
+    [InlineData("stall=0.1:20-10")]
+    [InlineData("stall=0.1")]
+    [InlineData("drift=600000")]
+    [InlineData("preempt=0.1")]
+    [InlineData("seed=-1")]
+    public void ParseRejectsInvalidFaults(string text)
+    {
+        Assert.Throws<FormatException>(() => CaptureFaultProfile.Parse(text));
+    }
+}
@@ -0,0 +1,55 @@
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class CompositorLayerTests
+{
+    [Fact]
+    public void ParseReturnsEmptyStackWithoutUrlsOrDelays()
+    {
+        var stack = CompositorLayerStack.Parse(null, null);
+
+        Assert.Same(CompositorLayerStack.Empty, stack);
+        Assert.False(stack.HasLayers);
+    }
+
+    [Fact]
+    public void ParseAssignsDelaysWithMainPageFirst()
+    {
+        var stack = CompositorLayerStack.Parse("https://example.com/lower-third | https://example.com/bug", "2, 0, 1");
+
+        Assert.Equal(2, stack.BaseDelayFrames);
+        Assert.Equal(2, stack.Layers.Count);
+        Assert.Equal(new CompositorLayer("https://example.com/lower-third", 0), stack.Layers[0]);
+        Assert.Equal(new CompositorLayer("https://example.com/bug", 1), stack.Layers[1]);
+    }
+
+    [Fact]
+    public void ParseTreatsMissingDelaysAsZero()
+    {
+        var stack = CompositorLayerStack.Parse("https://example.com/a|https://example.com/b", "1");
+
+        Assert.Equal(1, stack.BaseDelayFrames);
+        Assert.All(stack.Layers, layer => Assert.Equal(0, layer.DelayFrames));
+    }
+
+    [Theory]
+    [InlineData("not a url", null)]
+    [InlineData("https://example.com/a", "0,-1")]
+    [InlineData("https://example.com/a", "0,31")]
+    [InlineData("https://example.com/a", "0,one")]
+    [InlineData("https://example.com/a", "0,1,2")]
+    public void ParseRejectsInvalidUrlsAndDelays(string urls, string? delays)
+    {
+        Assert.Throws<FormatException>(() => CompositorLayerStack.Parse(urls, delays));
+    }
+
+    [Fact]
+    public void ParseRejectsMoreLayersThanTheCompositorBlends()
+    {
+        var urls = string.Join('|', Enumerable.Range(0, CompositorLayerStack.MaxLayers).Select(index => $"https://example.com/{index}"));
+
+        Assert.Throws<FormatException>(() => CompositorLayerStack.Parse(urls, null));
+    }
+}
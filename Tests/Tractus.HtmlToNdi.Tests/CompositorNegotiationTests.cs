@@ -0,0 +1,117 @@
+using Serilog;
+using Tractus.HtmlToNdi.Models;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class CompositorNegotiationTests
+{
+    private const CompositorFeatures AllFeatures =
+        CompositorFeatures.Renditions | CompositorFeatures.Supersampling | CompositorFeatures.RateConversion |
+        CompositorFeatures.FrameBlending | CompositorFeatures.Interlacing | CompositorFeatures.Overlays |
+        CompositorFeatures.Layers | CompositorFeatures.StraightAlpha | CompositorFeatures.ThreadPolicy |
+        CompositorFeatures.MemoryFlags;
+
+    [Fact]
+    public void NegotiateLeavesOptionsUntouchedWhenEverythingIsSupported()
+    {
+        var options = CreateOptions() with
+        {
+            SupersampleFactor = 2,
+            SupersampleFilter = SupersampleFilter.Lanczos3,
+            FrameRateConversion = FrameRateConversion.Blend,
+            AlphaMode = AlphaMode.Straight,
+            FrameMemory = FrameMemoryOptions.LargePages,
+        };
+
+        var negotiated = CompositorNegotiation.Negotiate(options, CreateCapabilities(), CreateNullLogger());
+
+        Assert.Same(options, negotiated);
+    }
+
+    [Fact]
+    public void NegotiateFallsBackToPaintCaptureWithoutCapabilities()
+    {
+        var negotiated = CompositorNegotiation.Negotiate(CreateOptions(), null, CreateNullLogger());
+
+        Assert.False(negotiated.EnableCompositorCapture);
+    }
+
+    [Fact]
+    public void NegotiateDowngradesUnsupportedFeatures()
+    {
+        var options = CreateOptions() with
+        {
+            SupersampleFactor = 4,
+            FrameRateConversion = FrameRateConversion.Blend,
+            AlphaMode = AlphaMode.Straight,
+            Interlaced = true,
+            Layers = CompositorLayerStack.Parse("https://example.com/a", null),
+            CaptureFaults = CaptureFaultProfile.Parse("jitter=2"),
+        };
+        var capabilities = CreateCapabilities() with { Features = CompositorFeatures.Supersampling | CompositorFeatures.RateConversion, MaxSupersampleFactor = 2 };
+
+        var negotiated = CompositorNegotiation.Negotiate(options, capabilities, CreateNullLogger());
+
+        Assert.True(negotiated.EnableCompositorCapture);
+        Assert.Equal(2, negotiated.SupersampleFactor);
+        Assert.Equal(FrameRateConversion.DropRepeat, negotiated.FrameRateConversion);
+        Assert.Equal(AlphaMode.Premultiplied, negotiated.AlphaMode);
+        Assert.False(negotiated.Interlaced);
+        Assert.False(negotiated.Layers.HasLayers);
+        Assert.False(negotiated.CaptureFaults.IsEnabled);
+    }
+
+    [Fact]
+    public void NegotiateTrimsLayersAboveTheHelperLimit()
+    {
+        var options = CreateOptions() with { Layers = CompositorLayerStack.Parse("https://example.com/a|https://example.com/b|https://example.com/c", null) };
+
+        var negotiated = CompositorNegotiation.Negotiate(options, CreateCapabilities() with { MaxLayers = 2 }, CreateNullLogger());
+
+        Assert.Single(negotiated.Layers.Layers);
+        Assert.Equal("https://example.com/a", negotiated.Layers.Layers[0].Url);
+    }
+
+    [Fact]
+    public void NegotiatePrefersTheBoxFilterWhenKernelsAreScalar()
+    {
+        var options = CreateOptions() with { SupersampleFactor = 2, SupersampleFilter = SupersampleFilter.Lanczos3 };
+
+        var negotiated = CompositorNegotiation.Negotiate(options, CreateCapabilities() with { CompiledSimdLevel = CompositorSimdLevel.Scalar }, CreateNullLogger());
+
+        Assert.Equal(SupersampleFilter.Box, negotiated.SupersampleFilter);
+    }
+
+    [Fact]
+    public void NegotiateKeepsFrameMemoryOnlyWhenTheHelperSupportsIt()
+    {
+        var options = CreateOptions() with { FrameMemory = FrameMemoryOptions.LargePages | FrameMemoryOptions.NumaLocal };
+
+        var withoutLargePages = CompositorNegotiation.Negotiate(options, CreateCapabilities() with { LargePageBytes = 0 }, CreateNullLogger());
+        var unsupported = CompositorNegotiation.Negotiate(options, CreateCapabilities() with { Features = AllFeatures & ~CompositorFeatures.MemoryFlags }, CreateNullLogger());
+
+        Assert.Equal(options.FrameMemory, withoutLargePages.FrameMemory);
+        Assert.Equal(FrameMemoryOptions.None, unsupported.FrameMemory);
+    }
+
+    private static NdiVideoPipelineOptions CreateOptions() => new() { EnableCompositorCapture = true };
+
+    private static CompositorCapabilities CreateCapabilities() => new(
+        1,
+        CompositorPixelFormats.Bgra8,
+        AllFeatures,
+        CompositorSimdLevel.Sse2,
+        CompositorSimdLevel.Avx2,
+        4,
+        CompositorLayerStack.MaxLayers,
+        8,
+        2,
+        0.1,
+        1.0,
+        2 * 1024 * 1024,
+        1);
+
+    private static ILogger CreateNullLogger() => new LoggerConfiguration().WriteTo.Sink(new NullSink()).CreateLogger();
+}
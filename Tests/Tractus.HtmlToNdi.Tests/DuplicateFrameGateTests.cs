@@ -0,0 +1,192 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using NewTek;
+using Serilog;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class DuplicateFrameGateTests
+{
+    private const long FrameBytes = 1920 * 1080 * 4;
+
+    private static readonly FrameContentHash Page = new(1, 2);
+    private static readonly FrameContentHash ChangedPage = new(3, 4);
+
+    private sealed class CountingSender : INdiVideoSender
+    {
+        public bool RequiresFrameRetention => false;
+
+        public List<byte> Sent { get; } = new();
+
+        public void Send(ref NDIlib.video_frame_v2_t frame) => Sent.Add(Marshal.ReadByte(frame.p_data));
+
+        public void Flush()
+        {
+        }
+    }
+
+    private static long Ticks(double seconds) => (long)(seconds * Stopwatch.Frequency);
+
+    /// <summary>
+    /// Offers the gate one frame of <paramref name="hash"/> every 1/60 s for <paramref name="seconds"/>, starting at
+    /// <paramref name="start"/>, and returns how many it passed.
+    /// </summary>
+    private static int Offer(DuplicateFrameGate gate, FrameContentHash? hash, double start, double seconds)
+    {
+        var passed = 0;
+        for (var frame = 0; frame < (int)Math.Round(seconds * 60); frame++)
+        {
+            if (gate.ShouldSend(hash, Ticks(start + (frame / 60d)), FrameBytes))
+            {
+                passed++;
+            }
+        }
+
+        return passed;
+    }
+
+    [Fact]
+    public void ParseReadsTheModesAndDelay()
+    {
+        Assert.False(IdleOutput.Parse(null).IsEnabled);
+        Assert.False(IdleOutput.Parse(" ").IsEnabled);
+
+        var detect = IdleOutput.Parse("detect");
+        Assert.True(detect.IsEnabled);
+        Assert.False(detect.LowersRate);
+
+        var keepalive = IdleOutput.Parse(" Keepalive , after=2.5 ");
+        Assert.Equal(IdleOutput.KeepaliveInterval, keepalive.Interval);
+        Assert.Equal(TimeSpan.FromSeconds(2.5), keepalive.After);
+
+        var rate = IdleOutput.Parse("5");
+        Assert.True(rate.LowersRate);
+        Assert.Equal(TimeSpan.FromMilliseconds(200), rate.Interval);
+        Assert.Equal(IdleOutput.DefaultAfter, rate.After);
+    }
+
+    [Theory]
+    [InlineData("idle")]
+    [InlineData("0")]
+    [InlineData("120")]
+    [InlineData("keepalive,after=-1")]
+    [InlineData("keepalive,after=soon")]
+    [InlineData("detect,interval=1")]
+    public void ParseRejectsInvalidSettings(string text)
+    {
+        Assert.Throws<FormatException>(() => IdleOutput.Parse(text));
+    }
+
+    [Fact]
+    public void DetectionCountsRepeatsButSendsEveryFrame()
+    {
+        var gate = new DuplicateFrameGate(IdleOutput.Parse("detect"), Stopwatch.Frequency);
+
+        Assert.Equal(600, Offer(gate, Page, 0, 10));
+
+        var metrics = gate.GetMetrics();
+        Assert.Equal(599, metrics.DuplicateFrames);
+        Assert.Equal(0, metrics.SuppressedFrames);
+        Assert.False(metrics.Idle);
+    }
+
+    [Fact]
+    public void AStaticPageDropsToTheKeepaliveRateAfterTheDelay()
+    {
+        var gate = new DuplicateFrameGate(IdleOutput.Parse("keepalive,after=1"), Stopwatch.Frequency);
+
+        // A second at full rate, then one frame a second for the nine that follow.
+        var passed = Offer(gate, Page, 0, 10);
+
+        Assert.InRange(passed, 60 + 9, 60 + 10);
+        var metrics = gate.GetMetrics();
+        Assert.True(metrics.Idle);
+        Assert.Equal(1, metrics.IdleEntries);
+        Assert.Equal(600 - passed, metrics.SuppressedFrames);
+        Assert.Equal(metrics.SuppressedFrames * FrameBytes, metrics.SuppressedBytes);
+    }
+
+    [Fact]
+    public void TheFirstChangeIsSentAtOnceAndRestoresTheFullRate()
+    {
+        var gate = new DuplicateFrameGate(IdleOutput.Parse("2,after=0.5"), Stopwatch.Frequency);
+        Offer(gate, Page, 0, 5);
+        Assert.True(gate.IsIdle);
+
+        Assert.True(gate.ShouldSend(ChangedPage, Ticks(5), FrameBytes));
+        Assert.False(gate.IsIdle);
+
+        // Unchanged again, but not yet for the delay: every frame goes out.
+        Assert.Equal(29, Offer(gate, ChangedPage, 5 + (1 / 60d), 29 / 60d));
+        Assert.False(gate.IsIdle);
+
+        Offer(gate, ChangedPage, 5.5, 2);
+        Assert.True(gate.IsIdle);
+        Assert.Equal(2, gate.GetMetrics().IdleEntries);
+    }
+
+    [Fact]
+    public void UnhashedFramesAreAlwaysSent()
+    {
+        var gate = new DuplicateFrameGate(IdleOutput.Parse("keepalive,after=0"), Stopwatch.Frequency);
+
+        Assert.Equal(120, Offer(gate, null, 0, 2));
+        Assert.Equal(0, gate.GetMetrics().DuplicateFrames);
+    }
+
+    [Fact]
+    public void DirectSendsOfAnIdlePageAreSuppressedUntilItChanges()
+    {
+        var clock = new VirtualPipelineClock();
+        var sender = new CountingSender();
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = false,
+            TelemetryInterval = TimeSpan.FromDays(1),
+            IdleOutput = IdleOutput.Parse("keepalive,after=0.5"),
+        };
+
+        var pipeline = new NdiVideoPipeline(sender, new FrameRate(60, 1), options, new LoggerConfiguration().WriteTo.Sink(new NullSink()).CreateLogger(), clock: clock);
+        var buffers = new List<IntPtr>();
+        try
+        {
+            void Deliver(byte content, int frames)
+            {
+                for (var i = 0; i < frames; i++)
+                {
+                    var buffer = Marshal.AllocHGlobal(64);
+                    buffers.Add(buffer);
+                    for (var offset = 0; offset < 64; offset++)
+                    {
+                        Marshal.WriteByte(buffer, offset, content);
+                    }
+
+                    pipeline.HandleFrame(new CapturedFrame(buffer, 4, 4, 16, clock.GetTimestamp(), DateTime.UtcNow, () => { }));
+                    clock.AdvanceBy(TimeSpan.FromTicks(TimeSpan.TicksPerSecond / 60));
+                }
+            }
+
+            Deliver(1, 180);
+            var sentWhileStatic = sender.Sent.Count;
+            Deliver(2, 1);
+
+            // Half a second at full rate, then a keepalive a second, then the change at once.
+            Assert.InRange(sentWhileStatic, 30 + 2, 30 + 3);
+            Assert.Equal(2, sender.Sent[^1]);
+            Assert.Equal(sentWhileStatic + 1, pipeline.SentFrames);
+
+            var duplicates = pipeline.GetMetrics().Duplicates!.Value;
+            Assert.Equal(179, duplicates.DuplicateFrames);
+            Assert.Equal(180 - sentWhileStatic, duplicates.SuppressedFrames);
+            Assert.Equal(duplicates.SuppressedFrames * 64, duplicates.SuppressedBytes);
+            Assert.False(duplicates.Idle);
+        }
+        finally
+        {
+            pipeline.Dispose();
+            buffers.ForEach(Marshal.FreeHGlobal);
+        }
+    }
+}
@@ -0,0 +1,93 @@
+using System.Runtime.InteropServices;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class FrameContentHashTests
+{
+    /// <summary>
+    /// Fills rows of <paramref name="rowBytes"/> with the pattern <c>ContentHashTests.cpp</c> uses and the padding
+    /// after each row with 0xEE.
+    /// </summary>
+    private static byte[] Frame(int rowBytes, int height, int stride, uint seed)
+    {
+        var frame = new byte[stride * height];
+        Array.Fill(frame, (byte)0xEE);
+        for (var y = 0; y < height; y++)
+        {
+            for (var x = 0; x < rowBytes; x++)
+            {
+                frame[(y * stride) + x] = (byte)(unchecked((((uint)y * 131u) + (uint)x) * 2654435761u + seed) >> 24);
+            }
+        }
+
+        return frame;
+    }
+
+    private static FrameContentHash Hash(byte[] frame, int rowBytes, int height, int stride, bool managed = true)
+    {
+        var handle = GCHandle.Alloc(frame, GCHandleType.Pinned);
+        try
+        {
+            var pixels = handle.AddrOfPinnedObject();
+            return managed
+                ? FrameContentHash.ComputeManaged(pixels, rowBytes, height, stride)
+                : FrameContentHash.Compute(pixels, rowBytes, height, stride);
+        }
+        finally
+        {
+            handle.Free();
+        }
+    }
+
+    [Fact]
+    public void TheManagedPortMatchesTheNativeKernel()
+    {
+        // The same frame and digest are checked by the native content-hash group against the SSE2 kernel.
+        var hash = Hash(Frame(200, 9, 208, 42), 200, 9, 208);
+
+        Assert.Equal(0xD7F48ADA4D3D7DF6ul, hash.Low);
+        Assert.Equal(0xFCD962AD6AB38BD3ul, hash.High);
+    }
+
+    [Fact]
+    public void ComputeAgreesWithTheManagedPortWhicheverRuns()
+    {
+        foreach (var (rowBytes, height) in new[] { (1, 1), (63, 3), (64, 17), (1000, 24), (7680, 5) })
+        {
+            var frame = Frame(rowBytes, height, rowBytes + 16, 9);
+            Assert.Equal(Hash(frame, rowBytes, height, rowBytes + 16), Hash(frame, rowBytes, height, rowBytes + 16, managed: false));
+        }
+    }
+
+    [Fact]
+    public void RowPaddingIsIgnored()
+    {
+        var packed = Hash(Frame(1000, 24, 1000, 3), 1000, 24, 1000);
+        var padded = Frame(1000, 24, 1088, 3);
+        padded[1000] = 0x11;
+        padded[1087] = 0x22;
+
+        Assert.Equal(packed, Hash(padded, 1000, 24, 1088));
+    }
+
+    [Fact]
+    public void OneChangedPixelChangesBothHalves()
+    {
+        var frame = Frame(7680, 8, 7680, 5);
+        var original = Hash(frame, 7680, 8, 7680);
+        frame[(4 * 7680) + 3001] ^= 0x01;
+        var changed = Hash(frame, 7680, 8, 7680);
+
+        Assert.NotEqual(original.Low, changed.Low);
+        Assert.NotEqual(original.High, changed.High);
+    }
+
+    [Fact]
+    public void AnEmptyFrameHashesToAFixedDigest()
+    {
+        Assert.Equal(FrameContentHash.ComputeManaged(IntPtr.Zero, 0, 0, 0), FrameContentHash.ComputeManaged(IntPtr.Zero, 1920 * 4, 0, 1920 * 4));
+        Assert.NotEqual(FrameContentHash.ComputeManaged(IntPtr.Zero, 0, 0, 0), Hash(new byte[64], 64, 1, 64));
+    }
+}
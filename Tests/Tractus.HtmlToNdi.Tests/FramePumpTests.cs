@@ -1,11 +1,11 @@
 using System;
-using System.Diagnostics;
 using System.Runtime.CompilerServices;
 using System.Threading;
 using System.Threading.Tasks;
 using CefSharp.OffScreen;
 using Serilog;
 using Tractus.HtmlToNdi.Chromium;
+using Tractus.HtmlToNdi.Video;
 using Xunit;
 
 namespace Tractus.HtmlToNdi.Tests;
@@ -142,9 +142,38 @@ public class FramePumpTests
         await Assert.ThrowsAsync<TaskCanceledException>(() => pump.RequestInvalidateAsync());
     }
 
+    [Fact]
+    public void PeriodicPumpInvalidatesOncePerIntervalOfItsClock()
+    {
+        var clock = new VirtualPipelineClock();
+        var invocations = 0;
+        using var pump = new FramePump(
+            CreateBrowserStub(),
+            TimeSpan.FromMilliseconds(10),
+            TimeSpan.FromHours(1),
+            CreateNullLogger(),
+            FramePumpMode.Periodic,
+            cadenceAdaptationEnabled: false,
+            (_, _, _) =>
+            {
+                Interlocked.Increment(ref invocations);
+                return Task.CompletedTask;
+            },
+            clock);
+
+        pump.Start();
+        clock.WaitForWaiter();
+
+        // The periodic loop runs in lockstep with the clock, so each deadline passed is exactly one invalidation.
+        clock.AdvanceBy(TimeSpan.FromMilliseconds(95));
+
+        Assert.Equal(9, Volatile.Read(ref invocations));
+    }
+
     [Fact]
     public async Task WatchdogTriggersInvalidateAfterIdle()
     {
+        var clock = new VirtualPipelineClock();
         var tcs = new TaskCompletionSource<int>(TaskCreationOptions.RunContinuationsAsynchronously);
         using var pump = new FramePump(
             CreateBrowserStub(),
@@ -157,43 +186,62 @@ public class FramePumpTests
             {
                 tcs.TrySetResult(1);
                 return Task.CompletedTask;
-            });
+            },
+            clock);
 
         pump.Start();
 
+        // The watchdog polls in real time but measures idleness on the pump's clock, which has not moved.
+        await Task.Delay(120);
+        Assert.False(tcs.Task.IsCompleted);
+
+        clock.AdvanceBy(TimeSpan.FromMilliseconds(41));
         await tcs.Task.WaitAsync(TimeSpan.FromSeconds(1));
     }
 
     [Fact]
     public async Task CadenceAlignmentDelaysOnDemandRequests()
     {
-        var stopwatch = Stopwatch.StartNew();
-        var tcs = new TaskCompletionSource<TimeSpan>(TaskCreationOptions.RunContinuationsAsynchronously);
+        var clock = new VirtualPipelineClock();
+        var invocations = 0;
         using var pump = new FramePump(
             CreateBrowserStub(),
             TimeSpan.FromMilliseconds(80),
-            TimeSpan.FromMilliseconds(200),
+            TimeSpan.FromHours(1),
             CreateNullLogger(),
             FramePumpMode.OnDemand,
             cadenceAdaptationEnabled: true,
             (_, _, _) =>
             {
-                tcs.TrySetResult(stopwatch.Elapsed);
+                Interlocked.Increment(ref invocations);
                 return Task.CompletedTask;
-            });
+            },
+            clock);
 
         pump.Start();
         pump.UpdateCadenceAlignment(1d);
 
-        await pump.RequestInvalidateAsync().WaitAsync(TimeSpan.FromSeconds(1));
-        var elapsed = await tcs.Task.WaitAsync(TimeSpan.FromSeconds(1));
+        // The second request brings the processing thread back to the clock once the first has been sent.
+        var first = pump.RequestInvalidateAsync();
+        var second = pump.RequestInvalidateAsync();
+        clock.WaitForWaiter();
+
+        // A frame behind, each request waits a quarter of the 80 ms interval.
+        clock.AdvanceBy(TimeSpan.FromMilliseconds(19));
+        Assert.Equal(0, Volatile.Read(ref invocations));
 
-        Assert.True(elapsed >= TimeSpan.FromMilliseconds(15), $"Expected at least 15ms delay, saw {elapsed.TotalMilliseconds:F2}ms");
+        clock.AdvanceBy(TimeSpan.FromMilliseconds(1));
+        await first.WaitAsync(TimeSpan.FromSeconds(1));
+        Assert.Equal(1, Volatile.Read(ref invocations));
+
+        pump.Dispose();
+        await Assert.ThrowsAnyAsync<OperationCanceledException>(() => second.WaitAsync(TimeSpan.FromSeconds(1)));
     }
 
     [Fact]
     public async Task WatchdogRemainsIdleWhenPaintsArrive()
     {
+        var clock = new VirtualPipelineClock();
         var invalidations = 0;
         using var pump = new FramePump(
             CreateBrowserStub(),
@@ -206,14 +254,16 @@ public class FramePumpTests
             {
                 Interlocked.Increment(ref invalidations);
                 return Task.CompletedTask;
-            });
+            },
+            clock);
 
         pump.Start();
 
-        var deadline = DateTime.UtcNow + TimeSpan.FromMilliseconds(280);
-        while (DateTime.UtcNow < deadline)
+        // A paint every 30 ms of the pump's clock; the real delay only gives the watchdog time to poll.
+        for (var paint = 0; paint < 10; paint++)
         {
             pump.NotifyPaint();
+            clock.AdvanceBy(TimeSpan.FromMilliseconds(30));
             await Task.Delay(30);
             Assert.Equal(0, Volatile.Read(ref invalidations));
         }
@@ -20,6 +20,18 @@ public class FrameRateTests
         Assert.Equal(expectedDenominator, rate.Denominator);
     }
 
+    [Theory]
+    [InlineData(50, 1, 2, 25, 1)]
+    [InlineData(60000, 1001, 2, 30000, 1001)]
+    [InlineData(60, 1, 4, 15, 1)]
+    public void DivideByReducesToLowestTerms(int numerator, int denominator, int divisor, int expectedNumerator, int expectedDenominator)
+    {
+        var rate = new FrameRate(numerator, denominator).DivideBy(divisor);
+
+        Assert.Equal(expectedNumerator, rate.Numerator);
+        Assert.Equal(expectedDenominator, rate.Denominator);
+    }
+
     [Fact]
     public void FromDoubleProducesReasonableFraction()
     {
@@ -121,4 +121,55 @@ public class FrameRingBufferTests
         Assert.Equal(droppedAfterTrim + 1, buffer.DroppedAsStale);
         Assert.Equal(0, buffer.Count);
     }
+
+    [Fact]
+    public void ResizeKeepsFramesAndDropsTheOldestBeyondTheNewCapacity()
+    {
+        var buffer = new FrameRingBuffer<DisposableStub>(2);
+        var frames = Enumerable.Range(0, 4).Select(_ => new DisposableStub()).ToArray();
+        buffer.Enqueue(frames[0], out _);
+        buffer.Enqueue(frames[1], out _);
+
+        Assert.Equal(0, buffer.Resize(4));
+        buffer.Enqueue(frames[2], out var dropped);
+        buffer.Enqueue(frames[3], out dropped);
+        Assert.Null(dropped);
+        Assert.Equal(4, buffer.Count);
+
+        Assert.Equal(2, buffer.Resize(2));
+        Assert.Equal(2, buffer.Capacity);
+        Assert.True(frames[0].Disposed && frames[1].Disposed);
+        Assert.Equal(2, buffer.DroppedFromOverflow);
+        Assert.True(buffer.TryDequeue(out var oldest));
+        Assert.Same(frames[2], oldest);
+
+        Assert.Throws<ArgumentOutOfRangeException>(() => buffer.Resize(0));
+    }
+
+    [Fact]
+    public void ShrinkTowardDrainsWithoutDroppingFrames()
+    {
+        var buffer = new FrameRingBuffer<DisposableStub>(6);
+        var frames = Enumerable.Range(0, 5).Select(_ => new DisposableStub()).ToArray();
+        foreach (var frame in frames)
+        {
+            buffer.Enqueue(frame, out _);
+        }
+
+        // Five frames held: the capacity stops one above them, so a new frame still fits.
+        Assert.Equal(6, buffer.ShrinkToward(3));
+        Assert.True(buffer.TryDequeue(out _));
+        Assert.Equal(5, buffer.ShrinkToward(3));
+        buffer.Enqueue(new DisposableStub(), out var dropped);
+        Assert.Null(dropped);
+
+        Assert.True(buffer.TryDequeue(out _));
+        Assert.True(buffer.TryDequeue(out _));
+        Assert.True(buffer.TryDequeue(out _));
+        Assert.Equal(3, buffer.ShrinkToward(3));
+        Assert.Equal(3, buffer.ShrinkToward(8));
+        Assert.Equal(0, buffer.DroppedFromOverflow);
+        Assert.DoesNotContain(frames, frame => frame.Disposed);
+        Assert.Throws<ArgumentOutOfRangeException>(() => buffer.ShrinkToward(0));
+    }
 }
@@ -0,0 +1,225 @@
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+using NewTek;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class NdiSendStageTests
+{
+    /// <summary>
+    /// Reads the first byte of each frame it sends, optionally holding every send until released or failing one value.
+    /// </summary>
+    private sealed class BlockingSender : INdiVideoSender
+    {
+        private readonly object gate = new();
+        private readonly List<(byte Value, string? ThreadName)> sends = new();
+
+        public ManualResetEventSlim Release { get; } = new(true);
+
+        public TimeSpan SendDuration { get; init; }
+
+        public byte? FailOn { get; init; }
+
+        public bool RequiresFrameRetention => false;
+
+        public void Flush()
+        {
+        }
+
+        public IReadOnlyList<(byte Value, string? ThreadName)> Sends
+        {
+            get
+            {
+                lock (gate)
+                {
+                    return sends.ToList();
+                }
+            }
+        }
+
+        public void Send(ref NDIlib.video_frame_v2_t frame)
+        {
+            Release.Wait();
+            if (SendDuration > TimeSpan.Zero)
+            {
+                Thread.Sleep(SendDuration);
+            }
+
+            var value = Marshal.ReadByte(frame.p_data);
+            if (value == FailOn)
+            {
+                throw new InvalidOperationException("Send failed.");
+            }
+
+            lock (gate)
+            {
+                sends.Add((value, Thread.CurrentThread.Name));
+            }
+        }
+    }
+
+    private static NdiVideoFrame CreateFrame(byte value)
+    {
+        var buffer = Marshal.AllocHGlobal(16);
+        Marshal.WriteByte(buffer, value);
+        return new NdiVideoFrame(2, 2, 8, buffer);
+    }
+
+    private static NDIlib.video_frame_v2_t Describe(NdiVideoFrame frame) => new()
+    {
+        xres = frame.Width,
+        yres = frame.Height,
+        line_stride_in_bytes = frame.Stride,
+        p_data = frame.Buffer,
+    };
+
+    [Fact]
+    public void SendsInHandOverOrderOnItsOwnThread()
+    {
+        var sender = new BlockingSender();
+        using var stage = new NdiSendStage(sender, 3, SystemPipelineClock.Instance);
+        stage.Start();
+
+        var frames = Enumerable.Range(0, 100).Select(i => CreateFrame((byte)i)).ToList();
+        foreach (var frame in frames)
+        {
+            Assert.True(stage.Enqueue(frame, Describe(frame), CancellationToken.None));
+            frame.Dispose();
+        }
+
+        stage.Stop();
+
+        Assert.Equal(Enumerable.Range(0, 100).Select(i => (byte)i).ToArray(), sender.Sends.Select(s => s.Value).ToArray());
+        Assert.All(sender.Sends, s => Assert.Equal(NdiSendStage.ThreadName, s.ThreadName));
+        Assert.Equal(100, stage.GetMetrics().Frames);
+        Assert.Equal(0, stage.InFlight);
+        Assert.All(frames, frame => Assert.Equal(IntPtr.Zero, frame.Buffer));
+    }
+
+    [Fact]
+    public void PacedSenderWaitsOnceTheInFlightLimitIsReached()
+    {
+        var sender = new BlockingSender();
+        sender.Release.Reset();
+        using var stage = new NdiSendStage(sender, 2, SystemPipelineClock.Instance);
+        stage.Start();
+        var frames = Enumerable.Range(1, 3).Select(i => CreateFrame((byte)i)).ToList();
+
+        Assert.True(stage.Enqueue(frames[0], Describe(frames[0]), CancellationToken.None));
+        Assert.True(stage.Enqueue(frames[1], Describe(frames[1]), CancellationToken.None));
+        var third = Task.Run(() => stage.Enqueue(frames[2], Describe(frames[2]), CancellationToken.None));
+
+        Assert.False(third.Wait(TimeSpan.FromMilliseconds(200)));
+        Assert.Equal(2, stage.InFlight);
+        Assert.Equal(1, stage.GetMetrics().Stalls);
+
+        sender.Release.Set();
+        Assert.True(third.Wait(TimeSpan.FromSeconds(5)));
+        Assert.True(third.Result);
+        stage.Stop();
+
+        Assert.Equal(new byte[] { 1, 2, 3 }, sender.Sends.Select(s => s.Value).ToArray());
+        frames.ForEach(frame => frame.Dispose());
+    }
+
+    [Fact]
+    public void CancellingTheWaitForASlotLeavesTheFrameUnsent()
+    {
+        var sender = new BlockingSender();
+        sender.Release.Reset();
+        using var stage = new NdiSendStage(sender, 1, SystemPipelineClock.Instance);
+        stage.Start();
+        using var first = CreateFrame(1);
+        using var second = CreateFrame(2);
+        using var cancellation = new CancellationTokenSource(TimeSpan.FromMilliseconds(100));
+
+        Assert.True(stage.Enqueue(first, Describe(first), CancellationToken.None));
+        Assert.False(stage.Enqueue(second, Describe(second), cancellation.Token));
+        Assert.Equal(0, second.SendReferences);
+
+        sender.Release.Set();
+        stage.Stop();
+        Assert.Equal(new byte[] { 1 }, sender.Sends.Select(s => s.Value).ToArray());
+    }
+
+    [Fact]
+    public void AFrameDisposedInFlightIsFreedByItsLastSend()
+    {
+        var sender = new BlockingSender();
+        sender.Release.Reset();
+        using var stage = new NdiSendStage(sender, 4, SystemPipelineClock.Instance);
+        stage.Start();
+        var frame = CreateFrame(0x5A);
+
+        // A repeat queues the same frame twice; the pipeline then replaces it.
+        stage.Enqueue(frame, Describe(frame), CancellationToken.None);
+        stage.Enqueue(frame, Describe(frame), CancellationToken.None);
+        frame.Dispose();
+        Assert.NotEqual(IntPtr.Zero, frame.Buffer);
+        Assert.Equal(2, frame.SendReferences);
+
+        sender.Release.Set();
+        stage.Stop();
+
+        Assert.Equal(new byte[] { 0x5A, 0x5A }, sender.Sends.Select(s => s.Value).ToArray());
+        Assert.Equal(0, frame.SendReferences);
+        Assert.Equal(IntPtr.Zero, frame.Buffer);
+    }
+
+    [Fact]
+    public void QueueAndSendTimesAreMeasuredSeparately()
+    {
+        var sender = new BlockingSender { SendDuration = TimeSpan.FromMilliseconds(20) };
+        using var stage = new NdiSendStage(sender, 3, SystemPipelineClock.Instance);
+        stage.Start();
+        var frames = Enumerable.Range(0, 3).Select(i => CreateFrame((byte)i)).ToList();
+        foreach (var frame in frames)
+        {
+            stage.Enqueue(frame, Describe(frame), CancellationToken.None);
+        }
+
+        stage.Stop();
+        var metrics = stage.GetMetrics();
+
+        // Handed over at once, the third frame waits behind two sends.
+        Assert.Equal(3, metrics.Frames);
+        Assert.InRange(metrics.SendSeconds, 0.055, 5);
+        Assert.InRange(metrics.MaxSendSeconds, 0.018, 5);
+        Assert.InRange(metrics.MaxQueueSeconds, 0.035, 5);
+        Assert.InRange(metrics.QueueSeconds, metrics.MaxQueueSeconds, 5);
+        frames.ForEach(frame => frame.Dispose());
+    }
+
+    [Fact]
+    public void AFailedSendIsSkippedAndReleasesItsFrameAndSlot()
+    {
+        var sender = new BlockingSender { FailOn = 0x02 };
+        using var stage = new NdiSendStage(sender, 1, SystemPipelineClock.Instance);
+        stage.Start();
+        var frames = Enumerable.Range(1, 3).Select(i => CreateFrame((byte)i)).ToList();
+        foreach (var frame in frames)
+        {
+            // One slot: each hand-over waits for the send before it, failed or not.
+            Assert.True(stage.Enqueue(frame, Describe(frame), CancellationToken.None));
+            frame.Dispose();
+        }
+
+        stage.Stop();
+        var metrics = stage.GetMetrics();
+
+        Assert.Equal(new byte[] { 0x01, 0x03 }, sender.Sends.Select(s => s.Value).ToArray());
+        Assert.Equal(2, metrics.Frames);
+        Assert.Equal(1, metrics.Failures);
+        Assert.Equal(0, stage.InFlight);
+        Assert.All(frames, frame => Assert.Equal(IntPtr.Zero, frame.Buffer));
+    }
+
+    [Fact]
+    public void RejectsAnEmptyStage()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() => new NdiSendStage(new BlockingSender(), 0, SystemPipelineClock.Instance));
+    }
+}
@@ -26,15 +26,52 @@ public class NdiVideoPipelineTests
         this.output = output;
     }
 
-    private sealed record SentFrame(NDIlib.video_frame_v2_t Frame, byte[] Payload, DateTime Timestamp, long MonotonicTimestamp);
+    private sealed record SentFrame(NDIlib.video_frame_v2_t Frame, byte[] Payload, DateTime Timestamp, long MonotonicTimestamp, string? ThreadName);
+
+    /// <summary>
+    /// Holds every send until released, then passes it on.
+    /// </summary>
+    private sealed class HoldingSender : INdiVideoSender
+    {
+        private readonly INdiVideoSender inner;
+        private readonly ManualResetEventSlim release;
+
+        public HoldingSender(INdiVideoSender inner, ManualResetEventSlim release)
+        {
+            this.inner = inner;
+            this.release = release;
+        }
+
+        public bool RequiresFrameRetention => false;
+
+        public void Flush()
+        {
+        }
+
+        public void Send(ref NDIlib.video_frame_v2_t frame)
+        {
+            release.Wait();
+            inner.Send(ref frame);
+        }
+    }
 
     private sealed class CollectingSender : INdiVideoSender
     {
         private readonly object gate = new();
         private readonly List<SentFrame> frames = new();
+        private readonly IPipelineClock clock;
+
+        public CollectingSender(IPipelineClock? clock = null)
+        {
+            this.clock = clock ?? SystemPipelineClock.Instance;
+        }
 
         public bool RequiresFrameRetention => false;
 
+        public void Flush()
+        {
+        }
+
         public IReadOnlyList<SentFrame> Frames
         {
             get
@@ -57,7 +94,62 @@ public class NdiVideoPipelineTests
                     Marshal.Copy(frame.p_data, payload, 0, size);
                 }
 
-                frames.Add(new SentFrame(frame, payload, DateTime.UtcNow, Stopwatch.GetTimestamp()));
+                frames.Add(new SentFrame(frame, payload, DateTime.UtcNow, clock.GetTimestamp(), Thread.CurrentThread.Name));
+            }
+        }
+    }
+
+    private sealed class TestMemoryBudget : IFrameMemoryBudget
+    {
+        private readonly long budget;
+
+        public TestMemoryBudget(long budget)
+        {
+            this.budget = budget;
+        }
+
+        public long InUse { get; private set; }
+
+        public int Refusals { get; private set; }
+
+        public bool TryReserve(long bytes)
+        {
+            if (InUse + bytes > budget)
+            {
+                Refusals++;
+                return false;
+            }
+
+            InUse += bytes;
+            return true;
+        }
+
+        public void Reserve(long bytes) => InUse += bytes;
+
+        public void Release(long bytes) => InUse -= bytes;
+    }
+
+    private sealed class TestEventRecorder : IPipelineEventRecorder
+    {
+        private readonly object gate = new();
+        private readonly List<(PipelineEvent Event, long Value)> events = new();
+
+        public IReadOnlyList<(PipelineEvent Event, long Value)> Events
+        {
+            get
+            {
+                lock (gate)
+                {
+                    return events.ToList();
+                }
+            }
+        }
+
+        public void Record(PipelineEvent pipelineEvent, long value = 0)
+        {
+            lock (gate)
+            {
+                events.Add((pipelineEvent, value));
             }
         }
     }
@@ -221,9 +313,128 @@ public class NdiVideoPipelineTests
 
     private static ILogger CreateNullLogger() => new LoggerConfiguration().WriteTo.Sink(new NullSink()).CreateLogger();
 
-    private static CapturedFrame CreateCapturedFrame(IntPtr buffer, int width, int height, int stride)
+    private static CapturedFrame CreateCapturedFrame(IntPtr buffer, int width, int height, int stride, IPipelineClock? clock = null)
+    {
+        return new CapturedFrame(buffer, width, height, stride, (clock ?? SystemPipelineClock.Instance).GetTimestamp(), DateTime.UtcNow);
+    }
+
+    /// <summary>
+    /// Starts a pipeline whose paced sender runs in lockstep with <paramref name="clock"/>, so each output tick
+    /// happens only when the test advances the clock past it.
+    /// </summary>
+    private static NdiVideoPipeline StartPaced(CollectingSender sender, FrameRate frameRate, NdiVideoPipelineOptions options, VirtualPipelineClock clock, IPipelineEventRecorder? eventRecorder = null)
     {
-        return new CapturedFrame(buffer, width, height, stride, Stopwatch.GetTimestamp(), DateTime.UtcNow);
+        var pipeline = new NdiVideoPipeline(sender, frameRate, options, CreateNullLogger(), eventRecorder: eventRecorder, clock: clock);
+        pipeline.Start();
+        clock.WaitForWaiter();
+        return pipeline;
+    }
+
+    /// <summary>
+    /// Advances <paramref name="clock"/> by <paramref name="frames"/> output frames.
+    /// </summary>
+    private static void RunFrames(VirtualPipelineClock clock, NdiVideoPipeline pipeline, int frames)
+    {
+        clock.AdvanceBy(TimeSpan.FromTicks(pipeline.FrameRate.FrameDuration.Ticks * frames));
+    }
+
+    /// <summary>
+    /// Steps <paramref name="clock"/> one pacer tick at a time until <paramref name="condition"/> holds, for at most
+    /// <paramref name="maxTicks"/> ticks. Ticks follow the pacer's adjusted deadlines rather than whole frames.
+    /// </summary>
+    private static bool RunUntil(VirtualPipelineClock clock, Func<bool> condition, int maxTicks)
+    {
+        for (var tick = 0; tick < maxTicks && !condition(); tick++)
+        {
+            Assert.True(clock.AdvanceToNextDeadline());
+        }
+
+        return condition();
+    }
+
+    [Fact]
+    public void BufferDepthShrinksToFitTheFrameMemoryBudget()
+    {
+        const long frameBytes = 1920L * 1080 * 4;
+        var sink = new CollectingSink();
+        var logger = new LoggerConfiguration().WriteTo.Sink(sink).CreateLogger();
+        var budget = new TestMemoryBudget(5 * frameBytes);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = true,
+            BufferDepth = 6,
+            TelemetryInterval = TimeSpan.FromDays(1),
+            FrameBytes = frameBytes,
+        };
+
+        var pipeline = new NdiVideoPipeline(new CollectingSender(), new FrameRate(60, 1), options, logger, budget);
+        try
+        {
+            // Depth 3 holds five frames: three buffered, the ring's spare slot and the last sent frame.
+            Assert.Equal(3, pipeline.BufferDepth);
+            Assert.Equal(6, pipeline.RequestedBufferDepth);
+            Assert.Equal(5 * frameBytes, budget.InUse);
+            Assert.Equal(3, budget.Refusals);
+            Assert.Contains(sink.Events, e => e.Level == LogEventLevel.Warning && e.RenderMessage().Contains("buffer depth reduced to 3", StringComparison.Ordinal));
+        }
+        finally
+        {
+            pipeline.Dispose();
+        }
+
+        Assert.Equal(0, budget.InUse);
+    }
+
+    [Fact]
+    public void BufferDepthNeverDropsBelowOneFrame()
+    {
+        const long frameBytes = 1280L * 720 * 4;
+        var budget = new TestMemoryBudget(frameBytes);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = true,
+            BufferDepth = 4,
+            TelemetryInterval = TimeSpan.FromDays(1),
+            FrameBytes = frameBytes,
+        };
+
+        var pipeline = new NdiVideoPipeline(new CollectingSender(), new FrameRate(60, 1), options, CreateNullLogger(), budget);
+        Assert.Equal(1, pipeline.BufferDepth);
+        Assert.Equal(3 * frameBytes, budget.InUse);
+        pipeline.Dispose();
+        Assert.Equal(0, budget.InUse);
+    }
+
+    [Fact]
+    public void DirectSendsRecordTheirCaptureToSendLatency()
+    {
+        var clock = new VirtualPipelineClock();
+        clock.AdvanceTo(TimeSpan.FromSeconds(1));
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = false,
+            TelemetryInterval = TimeSpan.FromDays(1)
+        };
+
+        var pipeline = new NdiVideoPipeline(new CollectingSender(), new FrameRate(60, 1), options, CreateNullLogger(), clock: clock);
+        var buffer = Marshal.AllocHGlobal(16);
+        try
+        {
+            // Captured 5 ms before it reached the pipeline.
+            var captured = clock.GetTimestamp() - (Stopwatch.Frequency / 200);
+            pipeline.HandleFrame(new CapturedFrame(buffer, 2, 2, 8, captured, DateTime.UtcNow));
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(buffer);
+            pipeline.Dispose();
+        }
+
+        var latency = pipeline.SendLatency;
+        Assert.Equal(1, latency.Direct.Count);
+        Assert.Equal(5_000, latency.Direct.MaxMicroseconds);
+        Assert.Equal(new[] { FrameSendPath.Direct }, latency.RecordedPaths().Select(h => h.Path).ToArray());
+        Assert.Equal(latency, pipeline.GetMetrics().SendLatency);
     }
 
     [Fact]
@@ -289,6 +500,38 @@ public class NdiVideoPipelineTests
         Assert.Equal(1, frames[0].Frame.frame_rate_D);
     }
 
+    [Fact]
+    public void InterlacedCompositorFramesAreSignalledAsInterleaved()
+    {
+        var sender = new CollectingSender();
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = false,
+            TelemetryInterval = TimeSpan.FromDays(1),
+            EnableCompositorCapture = true,
+            Interlaced = true,
+        };
+
+        var pipeline = new NdiVideoPipeline(sender, new FrameRate(25, 1), options, CreateNullLogger());
+
+        var size = 4 * 2 * 2;
+        var buffer = Marshal.AllocHGlobal(size);
+        try
+        {
+            pipeline.HandleCompositorFrame(CreateCapturedFrame(buffer, 2, 2, 8));
+        }
+        finally
+        {
+            Marshal.FreeHGlobal(buffer);
+            pipeline.Dispose();
+        }
+
+        var frames = sender.Frames;
+        Assert.Single(frames);
+        Assert.Equal(NDIlib.frame_format_type_e.frame_format_type_interleaved, frames[0].Frame.frame_format_type);
+        Assert.Equal(25, frames[0].Frame.frame_rate_N);
+    }
+
     [Fact]
     public void CompositorFrameInvokesReleaseAction()
     {
@@ -335,9 +578,10 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task BufferedModeWaitsForWarmupBeforeSending()
+    public void BufferedModeWaitsForWarmupBeforeSending()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -345,24 +589,23 @@ public class NdiVideoPipelineTests
             TelemetryInterval = TimeSpan.FromDays(1)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new IntPtr[3];
         try
         {
-            await Task.Delay(150);
+            RunFrames(clock, pipeline, 5);
             Assert.Empty(sender.Frames);
 
             for (var i = 0; i < buffers.Length; i++)
             {
                 buffers[i] = Marshal.AllocHGlobal(frameSize);
                 FillBuffer(buffers[i], frameSize, (byte)(0x10 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
             }
 
-            var warmed = SpinWait.SpinUntil(() => sender.Frames.Count >= buffers.Length, TimeSpan.FromMilliseconds(600));
+            var warmed = RunUntil(clock, () => sender.Frames.Count >= buffers.Length, 18);
             Assert.True(warmed);
             Assert.True(pipeline.BufferPrimed);
 
@@ -385,19 +628,112 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task BufferedModeRepeatsLastFrameWhenIdle()
+    public void BufferedModeSendsOnTheSendThreadWhenConfigured()
+    {
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = true,
+            BufferDepth = 2,
+            SendThreadDepth = 2,
+            TelemetryInterval = TimeSpan.FromDays(1)
+        };
+
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
+
+        var frameSize = 4 * 2 * 2;
+        var buffers = new IntPtr[2];
+        try
+        {
+            buffers[0] = Marshal.AllocHGlobal(frameSize);
+            buffers[1] = Marshal.AllocHGlobal(frameSize);
+            FillBuffer(buffers[0], frameSize, 0x20);
+            FillBuffer(buffers[1], frameSize, 0x30);
+
+            pipeline.HandleFrame(CreateCapturedFrame(buffers[0], 2, 2, 8, clock));
+            pipeline.HandleFrame(CreateCapturedFrame(buffers[1], 2, 2, 8, clock));
+
+            // Two fresh frames, then repeats of the second, whose buffer the send thread must still see. The pacer
+            // hands over on the clock's ticks; only the send thread's own progress is waited for.
+            RunFrames(clock, pipeline, 6);
+            Assert.True(SpinWait.SpinUntil(() => sender.Frames.Count >= 4, TimeSpan.FromSeconds(2)));
+            var frames = sender.Frames;
+            Assert.All(frames, frame => Assert.Equal(NdiSendStage.ThreadName, frame.ThreadName));
+            Assert.Equal(new byte[] { 0x20, 0x30, 0x30, 0x30 }, frames.Take(4).Select(frame => frame.Payload[0]).ToArray());
+
+            var stage = pipeline.GetMetrics().SendStage.GetValueOrDefault();
+            Assert.Equal(2, stage.MaxInFlight);
+            Assert.True(stage.Frames >= 4);
+        }
+        finally
+        {
+            pipeline.Dispose();
+            foreach (var ptr in buffers)
+            {
+                if (ptr != IntPtr.Zero)
+                {
+                    Marshal.FreeHGlobal(ptr);
+                }
+            }
+        }
+    }
+
+    [Fact]
+    public void AHandOverCancelledByStopIsNotCounted()
     {
         var sender = new CollectingSender();
+        var blocked = new ManualResetEventSlim(false);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
             BufferDepth = 2,
+            SendThreadDepth = 1,
             TelemetryInterval = TimeSpan.FromDays(1)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
+        var pipeline = new NdiVideoPipeline(new HoldingSender(sender, blocked), new FrameRate(30, 1), options, CreateNullLogger());
         pipeline.Start();
 
+        var frameSize = 4 * 2 * 2;
+        var buffer = Marshal.AllocHGlobal(frameSize);
+        try
+        {
+            FillBuffer(buffer, frameSize, 0x40);
+            pipeline.HandleFrame(CreateCapturedFrame(buffer, 2, 2, 8));
+            pipeline.HandleFrame(CreateCapturedFrame(buffer, 2, 2, 8));
+
+            // The first send holds the only slot, so the pacer waits on the next hand-over until Stop cancels it.
+            Assert.True(SpinWait.SpinUntil(() => pipeline.GetMetrics().SendStage.GetValueOrDefault().Stalls >= 1, TimeSpan.FromSeconds(2)));
+            var stopping = Task.Run(pipeline.Stop);
+            Thread.Sleep(100);
+            blocked.Set();
+            Assert.True(stopping.Wait(TimeSpan.FromSeconds(2)));
+
+            Assert.Equal(sender.Frames.Count, pipeline.SentFrames + pipeline.RepeatedFrames);
+        }
+        finally
+        {
+            blocked.Set();
+            pipeline.Dispose();
+            Marshal.FreeHGlobal(buffer);
+        }
+    }
+
+    [Fact]
+    public void BufferedModeRepeatsLastFrameWhenIdle()
+    {
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = true,
+            BufferDepth = 2,
+            TelemetryInterval = TimeSpan.FromDays(1)
+        };
+
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
+
         var frameSize = 4 * 2 * 2;
         var buffers = new IntPtr[2];
         try
@@ -407,13 +743,13 @@ public class NdiVideoPipelineTests
             FillBuffer(buffers[0], frameSize, 0x20);
             FillBuffer(buffers[1], frameSize, 0x30);
 
-            pipeline.HandleFrame(CreateCapturedFrame(buffers[0], 2, 2, 8));
-            pipeline.HandleFrame(CreateCapturedFrame(buffers[1], 2, 2, 8));
+            pipeline.HandleFrame(CreateCapturedFrame(buffers[0], 2, 2, 8, clock));
+            pipeline.HandleFrame(CreateCapturedFrame(buffers[1], 2, 2, 8, clock));
 
-            var primed = SpinWait.SpinUntil(() => sender.Frames.Count >= 2, TimeSpan.FromMilliseconds(500));
+            var primed = RunUntil(clock, () => sender.Frames.Count >= 2, 15);
             Assert.True(primed);
 
-            await Task.Delay(400);
+            RunFrames(clock, pipeline, 12);
 
             var frames = sender.Frames;
             Assert.True(frames.Count >= 4, "Expected repeated frames while idle");
@@ -436,9 +772,11 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task BufferedModeRewarmsAfterUnderrun()
+    public void FlightRecorderSeesTheUnderrunBetweenTwoWarmups()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
+        var recorder = new TestEventRecorder();
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -446,8 +784,63 @@ public class NdiVideoPipelineTests
             TelemetryInterval = TimeSpan.FromDays(1)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock, recorder);
+
+        var frameSize = 4 * 2 * 2;
+        var buffers = new IntPtr[2];
+        try
+        {
+            for (var i = 0; i < buffers.Length; i++)
+            {
+                buffers[i] = Marshal.AllocHGlobal(frameSize);
+                FillBuffer(buffers[i], frameSize, (byte)(0x40 + i));
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
+            }
+
+            var underrun = RunUntil(clock, () => pipeline.BufferUnderruns >= 1 && sender.Frames.Count >= 3, 24);
+            Assert.True(underrun);
+            RunFrames(clock, pipeline, 2);
+        }
+        finally
+        {
+            pipeline.Dispose();
+            foreach (var ptr in buffers)
+            {
+                if (ptr != IntPtr.Zero)
+                {
+                    Marshal.FreeHGlobal(ptr);
+                }
+            }
+        }
+
+        var events = recorder.Events.Select(e => e.Event).ToList();
+        Assert.Equal(PipelineEvent.WarmupEnter, events[0]);
+        Assert.Equal(2, events.Count(e => e == PipelineEvent.FrameCaptured));
+        Assert.Contains(recorder.Events, e => e.Event == PipelineEvent.FrameEnqueued && e.Value == 2);
+
+        var primed = events.IndexOf(PipelineEvent.WarmupExit);
+        var underrunAt = events.IndexOf(PipelineEvent.Underrun);
+        Assert.InRange(primed, 1, int.MaxValue);
+        Assert.True(underrunAt > primed);
+        Assert.Equal(PipelineEvent.WarmupEnter, events[underrunAt + 1]);
+        Assert.Contains(PipelineEvent.Repeat, events.Skip(underrunAt));
+        Assert.Equal(events.Count(e => e == PipelineEvent.SendBegin), events.Count(e => e == PipelineEvent.SendEnd));
+        Assert.Equal(sender.Frames.Count, events.Count(e => e == PipelineEvent.SendEnd));
+    }
+
+    [Fact]
+    public void BufferedModeRewarmsAfterUnderrun()
+    {
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = true,
+            BufferDepth = 2,
+            TelemetryInterval = TimeSpan.FromDays(1)
+        };
+
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new IntPtr[4];
@@ -457,13 +850,13 @@ public class NdiVideoPipelineTests
             {
                 buffers[i] = Marshal.AllocHGlobal(frameSize);
                 FillBuffer(buffers[i], frameSize, (byte)(0x40 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
             }
 
-            var primed = SpinWait.SpinUntil(() => pipeline.BufferPrimed && sender.Frames.Count >= 2, TimeSpan.FromMilliseconds(500));
+            var primed = RunUntil(clock, () => pipeline.BufferPrimed && sender.Frames.Count >= 2, 15);
             Assert.True(primed);
 
-            await Task.Delay(250);
+            RunFrames(clock, pipeline, 8);
             Assert.True(pipeline.BufferUnderruns >= 1);
             Assert.False(pipeline.BufferPrimed);
 
@@ -471,10 +864,10 @@ public class NdiVideoPipelineTests
             {
                 buffers[i] = Marshal.AllocHGlobal(frameSize);
                 FillBuffer(buffers[i], frameSize, (byte)(0x60 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
             }
 
-            var rearmed = SpinWait.SpinUntil(() => pipeline.BufferPrimed && sender.Frames.Any(f => f.Payload[0] == 0x63), TimeSpan.FromMilliseconds(800));
+            var rearmed = RunUntil(clock, () => pipeline.BufferPrimed && sender.Frames.Any(f => f.Payload[0] == 0x63), 24);
             Assert.True(rearmed);
             Assert.True(pipeline.LastWarmupDuration > TimeSpan.Zero);
         }
@@ -632,7 +1025,8 @@ public class NdiVideoPipelineTests
     [Fact]
     public void LatencyExpansionPlaysQueuedFramesBeforeRepeats()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -641,8 +1035,7 @@ public class NdiVideoPipelineTests
             AllowLatencyExpansion = true
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new IntPtr[5];
@@ -652,10 +1045,19 @@ public class NdiVideoPipelineTests
             {
                 buffers[i] = Marshal.AllocHGlobal(frameSize);
                 FillBuffer(buffers[i], frameSize, (byte)(0x80 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8));
             }
 
-            var sentAll = SpinWait.SpinUntil(() => sender.Frames.Count >= buffers.Length, TimeSpan.FromMilliseconds(1200));
+            // The ring holds one frame beyond the target depth, so the last frame waits until the sender has made
+            // room and the backlog is back at the target; a fuller ring would overflow or be trimmed by resync.
+            for (var i = 0; i < buffers.Length - 1; i++)
+            {
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
+            }
+
+            Assert.True(RunUntil(clock, () => sender.Frames.Count >= 2, 12));
+            pipeline.HandleFrame(CreateCapturedFrame(buffers[^1], 2, 2, 8, clock));
+
+            var sentAll = RunUntil(clock, () => sender.Frames.Count >= buffers.Length, 36);
             Assert.True(sentAll);
             Assert.True(pipeline.BufferUnderruns >= 1);
             Assert.True(pipeline.LatencyExpansionSessions >= 1);
@@ -663,10 +1065,11 @@ public class NdiVideoPipelineTests
             var uniqueCount = sender.Frames.Take(buffers.Length).Select(f => f.Payload[0]).Distinct().Count();
             Assert.Equal(buffers.Length, uniqueCount);
 
-            var repeated = SpinWait.SpinUntil(
+            var repeated = RunUntil(
+                clock,
                 () => sender.Frames.Count > buffers.Length &&
                       sender.Frames[^1].Payload[0] == sender.Frames[^2].Payload[0],
-                TimeSpan.FromMilliseconds(800));
+                24);
             Assert.True(repeated);
         }
         finally
@@ -683,9 +1086,10 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task LatencyExpansionExitsAfterBacklogRecovers()
+    public void LatencyExpansionExitsAfterBacklogRecovers()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -694,8 +1098,7 @@ public class NdiVideoPipelineTests
             AllowLatencyExpansion = true
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new List<IntPtr>();
@@ -706,15 +1109,15 @@ public class NdiVideoPipelineTests
                 var ptr = Marshal.AllocHGlobal(frameSize);
                 buffers.Add(ptr);
                 FillBuffer(ptr, frameSize, (byte)(0x90 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8, clock));
             }
 
-            var primed = SpinWait.SpinUntil(() => pipeline.BufferPrimed, TimeSpan.FromMilliseconds(600));
+            var primed = RunUntil(clock, () => pipeline.BufferPrimed, 18);
             Assert.True(primed);
 
-            await Task.Delay(300);
-
-            var expansionStarted = SpinWait.SpinUntil(() => pipeline.LatencyExpansionActive, TimeSpan.FromMilliseconds(800));
+            // Expansion starts on the tick that finds the backlog at the low watermark and lasts only until the ring
+            // runs dry, so it is observed tick by tick while the queued frames drain.
+            var expansionStarted = RunUntil(clock, () => pipeline.LatencyExpansionActive, 24);
             Assert.True(expansionStarted);
 
             for (var i = 0; i < 4; i++)
@@ -722,10 +1125,10 @@ public class NdiVideoPipelineTests
                 var ptr = Marshal.AllocHGlobal(frameSize);
                 buffers.Add(ptr);
                 FillBuffer(ptr, frameSize, (byte)(0xA0 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8, clock));
             }
 
-            var exited = SpinWait.SpinUntil(() => pipeline.BufferPrimed && !pipeline.LatencyExpansionActive, TimeSpan.FromMilliseconds(1200));
+            var exited = RunUntil(clock, () => pipeline.BufferPrimed && !pipeline.LatencyExpansionActive, 36);
             Assert.True(exited);
             Assert.True(pipeline.LatencyExpansionSessions >= 1);
             Assert.True(pipeline.LatencyExpansionFramesServed > 0);
@@ -744,9 +1147,10 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task BufferedModeDropsFramesWhenAhead()
+    public void BufferedModeDropsFramesWhenAhead()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -754,8 +1158,7 @@ public class NdiVideoPipelineTests
             TelemetryInterval = TimeSpan.FromDays(1)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new List<IntPtr>();
@@ -766,21 +1169,26 @@ public class NdiVideoPipelineTests
                 var ptr = Marshal.AllocHGlobal(frameSize);
                 buffers.Add(ptr);
                 FillBuffer(ptr, frameSize, (byte)(0xB0 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8, clock));
             }
 
-            var primed = SpinWait.SpinUntil(() => pipeline.BufferPrimed, TimeSpan.FromMilliseconds(600));
+            var primed = RunUntil(clock, () => pipeline.BufferPrimed, 18);
             Assert.True(primed);
 
-            for (var i = 0; i < 12; i++)
+            // A source running at twice the output rate keeps the ring full, so the latency error builds tick after
+            // tick until the sender resyncs by dropping the oldest frames.
+            for (var tick = 0; tick < 18; tick++)
             {
-                var ptr = Marshal.AllocHGlobal(frameSize);
-                buffers.Add(ptr);
-                FillBuffer(ptr, frameSize, (byte)(0xC0 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8));
-            }
+                for (var i = 0; i < 2; i++)
+                {
+                    var ptr = Marshal.AllocHGlobal(frameSize);
+                    buffers.Add(ptr);
+                    FillBuffer(ptr, frameSize, (byte)(0xC0 + (tick * 2) + i));
+                    pipeline.HandleFrame(CreateCapturedFrame(ptr, 2, 2, 8, clock));
+                }
 
-            await Task.Delay(600);
+                Assert.True(clock.AdvanceToNextDeadline());
+            }
 
             Assert.True(pipeline.BufferPrimed);
 
@@ -1281,9 +1689,10 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task LatencyErrorConvergesNearZeroWithBuffering()
+    public void LatencyErrorConvergesNearZeroWithBuffering()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -1291,40 +1700,34 @@ public class NdiVideoPipelineTests
             TelemetryInterval = TimeSpan.FromMilliseconds(200)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(60, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(60, 1), options, clock);
 
         var frameInterval = pipeline.FrameRate.FrameDuration;
         var frameSize = 4 * 2 * 2;
         var buffer = Marshal.AllocHGlobal(frameSize);
-        var cts = new CancellationTokenSource();
-        Task producerTask = Task.CompletedTask;
 
         try
         {
             FillBuffer(buffer, frameSize, 0x77);
 
-            producerTask = Task.Run(async () =>
+            // A source at the output rate: one capture per frame of the clock.
+            void Capture(int frames)
             {
-                try
-                {
-                    while (!cts.IsCancellationRequested)
-                    {
-                        pipeline.HandleFrame(CreateCapturedFrame(buffer, 2, 2, 8));
-                        await Task.Delay(frameInterval, cts.Token);
-                    }
-                }
-                catch (OperationCanceledException)
+                for (var frame = 0; frame < frames; frame++)
                 {
+                    pipeline.HandleFrame(CreateCapturedFrame(buffer, 2, 2, 8, clock));
+                    RunFrames(clock, pipeline, 1);
                 }
-            });
+            }
 
-            var primed = SpinWait.SpinUntil(
-                () => pipeline.BufferPrimed && sender.Frames.Count >= options.BufferDepth,
-                TimeSpan.FromSeconds(2));
-            Assert.True(primed);
+            for (var frame = 0; frame < 120 && !(pipeline.BufferPrimed && sender.Frames.Count >= options.BufferDepth); frame++)
+            {
+                Capture(1);
+            }
+
+            Assert.True(pipeline.BufferPrimed && sender.Frames.Count >= options.BufferDepth);
 
-            await Task.Delay(TimeSpan.FromMilliseconds(frameInterval.TotalMilliseconds * 120));
+            Capture(120);
 
             var frames = sender.Frames;
             Assert.True(frames.Count > options.BufferDepth + 5, "Not enough frames captured for cadence analysis.");
@@ -1367,15 +1770,6 @@ public class NdiVideoPipelineTests
         }
         finally
         {
-            cts.Cancel();
-            try
-            {
-                await producerTask;
-            }
-            catch (OperationCanceledException)
-            {
-            }
-
             pipeline.Dispose();
             if (buffer != IntPtr.Zero)
             {
@@ -1440,9 +1834,10 @@ public class NdiVideoPipelineTests
     }
 
     [Fact]
-    public async Task BufferedModeTracksRepeatedFramesDuringStalls()
+    public void BufferedModeTracksRepeatedFramesDuringStalls()
     {
-        var sender = new CollectingSender();
+        var clock = new VirtualPipelineClock();
+        var sender = new CollectingSender(clock);
         var options = new NdiVideoPipelineOptions
         {
             EnableBuffering = true,
@@ -1450,8 +1845,7 @@ public class NdiVideoPipelineTests
             TelemetryInterval = TimeSpan.FromDays(1)
         };
 
-        var pipeline = new NdiVideoPipeline(sender, new FrameRate(30, 1), options, CreateNullLogger());
-        pipeline.Start();
+        var pipeline = StartPaced(sender, new FrameRate(30, 1), options, clock);
 
         var frameSize = 4 * 2 * 2;
         var buffers = new IntPtr[2];
@@ -1462,15 +1856,13 @@ public class NdiVideoPipelineTests
             {
                 buffers[i] = Marshal.AllocHGlobal(frameSize);
                 FillBuffer(buffers[i], frameSize, (byte)(0x30 + i));
-                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8));
+                pipeline.HandleFrame(CreateCapturedFrame(buffers[i], 2, 2, 8, clock));
             }
 
-            var primed = SpinWait.SpinUntil(
-                () => pipeline.BufferPrimed && sender.Frames.Count >= buffers.Length,
-                TimeSpan.FromMilliseconds(600));
+            var primed = RunUntil(clock, () => pipeline.BufferPrimed && sender.Frames.Count >= buffers.Length, 18);
             Assert.True(primed);
 
-            await Task.Delay(400);
+            RunFrames(clock, pipeline, 12);
 
             var repeatedField = typeof(NdiVideoPipeline)
                 .GetField("repeatedFrames", BindingFlags.Instance | BindingFlags.NonPublic);
@@ -1667,6 +2059,62 @@ public class NdiVideoPipelineTests
             pipeline.Dispose();
         }
     }
+
+    [Fact]
+    public void TelemetryWaitsForTheIntervalAndCountsEveryFrame()
+    {
+        var sender = new CollectingSender();
+        var sink = new CollectingSink();
+        var logger = new LoggerConfiguration().WriteTo.Sink(sink).CreateLogger();
+        var options = new NdiVideoPipelineOptions
+        {
+            EnableBuffering = false,
+            TelemetryInterval = TimeSpan.FromHours(1),
+            EnableCadenceTelemetry = false,
+            EnablePacedInvalidation = false,
+            DisablePacedInvalidation = true,
+            EnableCompositorCapture = true,
+        };
+
+        var pipeline = new NdiVideoPipeline(sender, new FrameRate(60, 1), options, logger);
+        try
+        {
+            pipeline.SkipTelemetryWarmupForTesting();
+
+            var buffer = Marshal.AllocHGlobal(16);
+            try
+            {
+                var baseTimestamp = Stopwatch.GetTimestamp();
+                var ticksPerFrame = Stopwatch.Frequency / 60d;
+                for (var i = 0; i < 200; i++)
+                {
+                    var timestamp = baseTimestamp + (long)Math.Round(ticksPerFrame * i);
+                    pipeline.HandleCompositorFrame(new CapturedFrame(buffer, 2, 2, 8, timestamp, DateTime.UtcNow));
+                }
+
+                // The first line is due immediately; the next one is an hour away.
+                Assert.Single(sink.Events, e => e.RenderMessage().Contains("NDI video pipeline stats", StringComparison.Ordinal));
+
+                pipeline.SkipTelemetryWarmupForTesting();
+                pipeline.HandleCompositorFrame(new CapturedFrame(buffer, 2, 2, 8, baseTimestamp + (long)Math.Round(ticksPerFrame * 200), DateTime.UtcNow));
+            }
+            finally
+            {
+                Marshal.FreeHGlobal(buffer);
+            }
+
+            var message = sink.Events
+                .Select(e => e.RenderMessage())
+                .Last(m => m.Contains("NDI video pipeline stats", StringComparison.Ordinal));
+            Assert.Contains("captured=201, sent=201", message, StringComparison.Ordinal);
+            Assert.Contains("compositorFrames=201", message, StringComparison.Ordinal);
+            Assert.Equal(201, sender.Frames.Count);
+        }
+        finally
+        {
+            pipeline.Dispose();
+        }
+    }
 }
 
 internal sealed class NullSink : ILogEventSink
@@ -0,0 +1,167 @@
+using System.Linq;
+using Tractus.HtmlToNdi.Models;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class OpenMetricsFormatterTests
+{
+    private static readonly PipelineMetrics Primary = new(
+        CapturedFrames: 120,
+        SentFrames: 118,
+        RepeatedFrames: 2,
+        Underruns: 1,
+        WarmupCycles: 2,
+        DroppedOverflow: 3,
+        DroppedStale: 4,
+        ResyncDrops: 5,
+        SpuriousCaptures: 0,
+        BufferedFrames: 3,
+        BufferDepth: 3,
+        Primed: true,
+        LatencyErrorFrames: 0.25);
+
+    private static CompositorHistogram Histogram(params (int Bucket, long Count)[] counts)
+    {
+        var buckets = new long[CompositorHistogram.BucketCount];
+        foreach (var (bucket, count) in counts)
+        {
+            buckets[bucket] = count;
+        }
+
+        return new CompositorHistogram(buckets.Sum(), 3_000_000_000, buckets);
+    }
+
+    [Fact]
+    public void PipelineCountersAndGaugesAreLabelledByOutput()
+    {
+        var text = OpenMetricsFormatter.Format(new[] { ("HTML5", Primary), ("HTML5 (960x540)", Primary with { SentFrames = 59 }) }, null, null);
+        var lines = text.Split('\n');
+
+        Assert.Contains("# TYPE htmltondi_frames_sent counter", lines);
+        Assert.Contains("htmltondi_frames_sent_total{output=\"HTML5\"} 118", lines);
+        Assert.Contains("htmltondi_frames_sent_total{output=\"HTML5 (960x540)\"} 59", lines);
+        Assert.Contains("htmltondi_frames_dropped_total{output=\"HTML5\",reason=\"resync\"} 5", lines);
+        Assert.Contains("# TYPE htmltondi_buffered_frames gauge", lines);
+        Assert.Contains("htmltondi_buffer_primed{output=\"HTML5\"} 1", lines);
+        Assert.Contains("htmltondi_latency_error_frames{output=\"HTML5\"} 0.25", lines);
+        Assert.DoesNotContain(lines, l => l.StartsWith("htmltondi_native_", StringComparison.Ordinal));
+        Assert.EndsWith("# EOF\n", text, StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void NativeHistogramsAreCumulativeInSeconds()
+    {
+        var empty = Histogram();
+        var counters = new CompositorCounters(10, 9, 0, 4, 0, 0, 7, 93, Histogram((0, 2), (10, 5), (16, 1)), empty, empty);
+        var lines = OpenMetricsFormatter.Format(Array.Empty<(string, PipelineMetrics)>(), counters, null).Split('\n');
+
+        Assert.Contains("# TYPE htmltondi_native_conversion_seconds histogram", lines);
+        Assert.Contains("htmltondi_native_conversion_seconds_bucket{stage=\"frame\",le=\"1.024E-06\"} 2", lines);
+        Assert.Contains("htmltondi_native_conversion_seconds_bucket{stage=\"frame\",le=\"0.001048576\"} 7", lines);
+        Assert.Contains("htmltondi_native_conversion_seconds_bucket{stage=\"frame\",le=\"+Inf\"} 8", lines);
+        Assert.Contains("htmltondi_native_conversion_seconds_count{stage=\"frame\"} 8", lines);
+        Assert.Contains("htmltondi_native_conversion_seconds_sum{stage=\"frame\"} 3", lines);
+        Assert.Contains("htmltondi_native_tiles_total{result=\"skipped\"} 93", lines);
+        Assert.Contains("htmltondi_native_frames_total{stage=\"rendition\"} 4", lines);
+    }
+
+    [Fact]
+    public void MemoryPoolsAndEscapedLabelsAreWritten()
+    {
+        var pool = new FrameMemoryPoolStatistics(100, 200, 1);
+        var memory = new FrameMemoryStatistics(1000, 400, 500, 4, 50, pool, pool, pool, pool);
+        var lines = OpenMetricsFormatter.Format(new[] { ("a\"b\\c", Primary) }, null, memory).Split('\n');
+
+        Assert.Contains("htmltondi_frames_captured_total{output=\"a\\\"b\\\\c\"} 120", lines);
+        Assert.Contains("htmltondi_frame_memory_budget_bytes 1000", lines);
+        Assert.Contains("htmltondi_frame_memory_in_use_bytes{pool=\"layers\"} 100", lines);
+        Assert.Contains("htmltondi_frame_memory_refusals_total{pool=\"pipeline\"} 1", lines);
+        Assert.Contains("htmltondi_frame_memory_trimmed_bytes_total 50", lines);
+    }
+
+    [Fact]
+    public void ReferenceLocksAreWrittenOnlyForPhaseLockedOutputs()
+    {
+        var locked = Primary with { ReferenceLock = new ReferenceLockMetrics(ReferenceLockState.Locked, 2.5e-6, -31.5, 1, 4) };
+        var lines = OpenMetricsFormatter.Format(new[] { ("HTML5", locked), ("Free", Primary) }, null, null).Split('\n');
+
+        Assert.Contains("# TYPE htmltondi_reference_lock_state gauge", lines);
+        Assert.Contains("htmltondi_reference_lock_state{output=\"HTML5\"} 2", lines);
+        Assert.Contains("htmltondi_reference_phase_error_seconds{output=\"HTML5\"} 2.5E-06", lines);
+        Assert.Contains("htmltondi_reference_frequency_ppm{output=\"HTML5\"} -31.5", lines);
+        Assert.Contains("htmltondi_reference_steps_total{output=\"HTML5\"} 1", lines);
+        Assert.Contains("htmltondi_reference_skipped_slots_total{output=\"HTML5\"} 4", lines);
+        Assert.DoesNotContain(lines, l => l.StartsWith("htmltondi_reference_", StringComparison.Ordinal) && l.Contains("Free", StringComparison.Ordinal));
+
+        var freeRunning = OpenMetricsFormatter.Format(new[] { ("Free", Primary) }, null, null);
+        Assert.DoesNotContain("htmltondi_reference_", freeRunning, StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void GenlockArrivalsAreWrittenOnlyForGenlockedOutputs()
+    {
+        var clockLocked = Primary with { ReferenceLock = new ReferenceLockMetrics(ReferenceLockState.Locked, 0, 0, 0, 0) };
+        var genlocked = Primary with { ReferenceLock = new ReferenceLockMetrics(ReferenceLockState.Holdover, -1e-4, 80, 0, 0, 3600, 7) };
+        var lines = OpenMetricsFormatter.Format(new[] { ("Clock", clockLocked), ("Genlock", genlocked) }, null, null).Split('\n');
+
+        Assert.Contains("htmltondi_reference_lock_state{output=\"Genlock\"} 3", lines);
+        Assert.Contains("# TYPE htmltondi_reference_arrivals counter", lines);
+        Assert.Contains("htmltondi_reference_arrivals_total{output=\"Genlock\"} 3600", lines);
+        Assert.Contains("htmltondi_reference_missed_frames_total{output=\"Genlock\"} 7", lines);
+        Assert.DoesNotContain(lines, l => l.StartsWith("htmltondi_reference_arrivals_total{output=\"Clock\"", StringComparison.Ordinal));
+        Assert.DoesNotContain("htmltondi_reference_arrivals", OpenMetricsFormatter.Format(new[] { ("Clock", clockLocked) }, null, null), StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void SendLatencyIsAHistogramPerRecordedPath()
+    {
+        var recorder = new SendLatencyRecorder();
+        var ticksPerMillisecond = System.Diagnostics.Stopwatch.Frequency / 1000;
+        recorder.Record(FrameSendPath.Buffered, 1, 1 + (40 * ticksPerMillisecond));
+        recorder.Record(FrameSendPath.Buffered, 1, 1 + (60 * ticksPerMillisecond));
+        recorder.Record(FrameSendPath.LatencyExpansion, 1, 1 + ticksPerMillisecond / 10);
+        var lines = OpenMetricsFormatter.Format(new[] { ("Main", Primary with { SendLatency = recorder.Snapshot() }) }, null, null).Split('\n');
+
+        Assert.Contains("# TYPE htmltondi_send_latency_seconds histogram", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_bucket{output=\"Main\",path=\"buffered\",le=\"0.032\"} 0", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_bucket{output=\"Main\",path=\"buffered\",le=\"0.064\"} 2", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_bucket{output=\"Main\",path=\"buffered\",le=\"+Inf\"} 2", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_count{output=\"Main\",path=\"buffered\"} 2", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_sum{output=\"Main\",path=\"buffered\"} 0.1", lines);
+        Assert.Contains("htmltondi_send_latency_seconds_bucket{output=\"Main\",path=\"latency_expansion\",le=\"0.00025\"} 1", lines);
+        Assert.DoesNotContain(lines, l => l.Contains("path=\"direct\"", StringComparison.Ordinal));
+        Assert.DoesNotContain("send_latency", OpenMetricsFormatter.Format(new[] { ("Main", Primary) }, null, null), StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void SendThreadsAreWrittenOnlyForOutputsThatHaveOne()
+    {
+        var staged = Primary with { SendStage = new SendStageMetrics(240, 4, 3, 1, 2, 0.5, 0.02, 1.25, 0.03) };
+        var lines = OpenMetricsFormatter.Format(new[] { ("Inline", Primary), ("Staged", staged) }, null, null).Split('\n');
+
+        Assert.Contains("htmltondi_send_thread_in_flight{output=\"Staged\"} 1", lines);
+        Assert.Contains("htmltondi_send_thread_stalls_total{output=\"Staged\"} 3", lines);
+        Assert.Contains("htmltondi_send_thread_failures_total{output=\"Staged\"} 4", lines);
+        Assert.Contains("# TYPE htmltondi_send_thread_queue_seconds summary", lines);
+        Assert.Contains("htmltondi_send_thread_queue_seconds_count{output=\"Staged\"} 240", lines);
+        Assert.Contains("htmltondi_send_thread_queue_seconds_sum{output=\"Staged\"} 0.5", lines);
+        Assert.Contains("htmltondi_send_thread_send_seconds_sum{output=\"Staged\"} 1.25", lines);
+        Assert.DoesNotContain(lines, l => l.Contains("send_thread", StringComparison.Ordinal) && l.Contains("Inline", StringComparison.Ordinal));
+        Assert.DoesNotContain("send_thread", OpenMetricsFormatter.Format(new[] { ("Inline", Primary) }, null, null), StringComparison.Ordinal);
+    }
+
+    [Fact]
+    public void IdleOutputIsWrittenOnlyForOutputsThatHashFrames()
+    {
+        var hashed = Primary with { Duplicates = new DuplicateFrameMetrics(540, 470, 3_897_753_600, true, 2) };
+        var lines = OpenMetricsFormatter.Format(new[] { ("Plain", Primary), ("Hashed", hashed) }, null, null).Split('\n');
+
+        Assert.Contains("htmltondi_duplicate_frames_total{output=\"Hashed\"} 540", lines);
+        Assert.Contains("htmltondi_idle{output=\"Hashed\"} 1", lines);
+        Assert.Contains("htmltondi_idle_suppressed_frames_total{output=\"Hashed\"} 470", lines);
+        Assert.Contains("htmltondi_idle_suppressed_bytes_total{output=\"Hashed\"} 3897753600", lines);
+        Assert.DoesNotContain(lines, l => l.Contains("Plain", StringComparison.Ordinal) && (l.Contains("idle", StringComparison.Ordinal) || l.Contains("duplicate", StringComparison.Ordinal)));
+    }
+}
@@ -0,0 +1,58 @@
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class OutputRenditionTests
+{
+    [Theory]
+    [InlineData("960x540/2", 960, 540, 2, RenditionScaleFilter.Lanczos3)]
+    [InlineData("640x360", 640, 360, 1, RenditionScaleFilter.Lanczos3)]
+    [InlineData(" 480x270/4:bilinear ", 480, 270, 4, RenditionScaleFilter.Bilinear)]
+    [InlineData("1280x720:Lanczos3", 1280, 720, 1, RenditionScaleFilter.Lanczos3)]
+    public void TryParseAcceptsSizeDividerAndFilter(string text, int width, int height, int divider, RenditionScaleFilter filter)
+    {
+        Assert.True(OutputRendition.TryParse(text, out var rendition, out var error), error);
+
+        Assert.Equal(new OutputRendition(width, height, divider, filter), rendition);
+    }
+
+    [Theory]
+    [InlineData("")]
+    [InlineData("960")]
+    [InlineData("960x0")]
+    [InlineData("960x540/0")]
+    [InlineData("960x540/two")]
+    [InlineData("960x540:bicubic")]
+    public void TryParseRejectsMalformedRenditions(string text)
+    {
+        Assert.False(OutputRendition.TryParse(text, out var rendition, out var error));
+        Assert.Null(rendition);
+        Assert.False(string.IsNullOrWhiteSpace(error));
+    }
+
+    [Fact]
+    public void ParseListSplitsOnCommasAndThrowsOnInvalidEntries()
+    {
+        var renditions = OutputRendition.ParseList("960x540/2, 640x360/4:bilinear");
+
+        Assert.Equal(2, renditions.Count);
+        Assert.Equal(640, renditions[1].Width);
+        Assert.Empty(OutputRendition.ParseList(null));
+        Assert.Throws<FormatException>(() => OutputRendition.ParseList("960x540/2,oops"));
+    }
+
+    [Theory]
+    [InlineData(60, 1, 2, 30, 1)]
+    [InlineData(60000, 1001, 2, 30000, 1001)]
+    [InlineData(50, 1, 4, 25, 2)]
+    public void ResolveFrameRateDividesAndReduces(int numerator, int denominator, int divider, int expectedNumerator, int expectedDenominator)
+    {
+        var rendition = new OutputRendition(960, 540, divider, RenditionScaleFilter.Lanczos3);
+
+        var rate = rendition.ResolveFrameRate(new FrameRate(numerator, denominator));
+
+        Assert.Equal(expectedNumerator, rate.Numerator);
+        Assert.Equal(expectedDenominator, rate.Denominator);
+    }
+}
@@ -0,0 +1,45 @@
+using Tractus.HtmlToNdi.Models;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class OverlayModelTests
+{
+    [Theory]
+    [InlineData("timecode", OverlayKind.Timecode)]
+    [InlineData("Clock", OverlayKind.Clock)]
+    [InlineData("tally", OverlayKind.TallyBorder)]
+    [InlineData("safe-area", OverlayKind.SafeArea)]
+    [InlineData("rectangle", OverlayKind.Rectangle)]
+    public void KindAcceptsApiSpellings(string input, OverlayKind expected)
+    {
+        var model = new OverlayModel { Kind = input, Width = 10, Height = 10 };
+
+        Assert.True(model.TryCreateDefinition(out var definition, out _));
+        Assert.Equal(expected, definition.Kind);
+    }
+
+    [Theory]
+    [InlineData("#FF8000", 0xFFFF8000u)]
+    [InlineData("#80102030", 0x80102030u)]
+    [InlineData("00ff00", 0xFF00FF00u)]
+    public void ColorParsesToStraightArgb(string input, uint expected)
+    {
+        Assert.True(OverlayModel.TryParseColor(input, out var color));
+        Assert.Equal(expected, color);
+    }
+
+    [Theory]
+    [InlineData("banner", "#FFFFFF", 4, 10)]
+    [InlineData("2", "#FFFFFF", 4, 10)]
+    [InlineData("rectangle", "#FFF", 4, 10)]
+    [InlineData("timecode", "#FFFFFF", 0, 10)]
+    [InlineData("rectangle", "#FFFFFF", 4, 0)]
+    public void InvalidModelsAreRejected(string kind, string color, int scale, int width)
+    {
+        var model = new OverlayModel { Kind = kind, Color = color, Scale = scale, Width = width, Height = 10 };
+
+        Assert.False(model.TryCreateDefinition(out _, out var error));
+        Assert.False(string.IsNullOrEmpty(error));
+    }
+}
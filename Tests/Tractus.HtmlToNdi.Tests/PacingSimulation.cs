@@ -0,0 +1,387 @@
+using System.Diagnostics;
+using System.Runtime.InteropServices;
+using NewTek;
+using Serilog;
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+/// <summary>
+/// Describes the capture side of a simulated run: a source that renders at the output rate with seeded jitter, late
+/// frames released in bursts, stalls that render nothing, and a delivering thread that is sometimes preempted.
+/// </summary>
+internal sealed record PacingScenario
+{
+    public int Seed { get; init; } = 1;
+
+    public TimeSpan Duration { get; init; } = TimeSpan.FromMinutes(1);
+
+    public FrameRate FrameRate { get; init; } = new(60, 1);
+
+    /// <summary>
+    /// The standard deviation of how late each frame arrives after its nominal time.
+    /// </summary>
+    public TimeSpan CaptureJitter { get; init; } = TimeSpan.FromMilliseconds(2);
+
+    /// <summary>
+    /// How far the source's clock runs ahead of the output clock, in parts per million; negative runs slow.
+    /// </summary>
+    public double SourceDriftPpm { get; init; }
+
+    /// <summary>
+    /// The chance, per frame, that it and the next <see cref="BurstLength"/> - 1 frames are held back and arrive
+    /// together.
+    /// </summary>
+    public double BurstProbability { get; init; }
+
+    public int BurstLength { get; init; } = 3;
+
+    /// <summary>
+    /// Every this many frames the first <see cref="BurstLength"/> are held back and arrive together, as the native
+    /// helper's <c>burst</c> fault does; zero disables periodic bursts.
+    /// </summary>
+    public int BurstPeriod { get; init; }
+
+    /// <summary>
+    /// The chance, per frame, that the source renders nothing for a while, as when the page blocks its main thread.
+    /// </summary>
+    public double StallProbability { get; init; }
+
+    public TimeSpan MinStall { get; init; } = TimeSpan.FromMilliseconds(50);
+
+    public TimeSpan MaxStall { get; init; } = TimeSpan.FromMilliseconds(250);
+
+    /// <summary>
+    /// The chance, per frame, that the delivering thread is kept off the CPU for <see cref="Preemption"/> after it
+    /// hands the frame over, holding back every frame due meanwhile.
+    /// </summary>
+    public double PreemptionProbability { get; init; }
+
+    public TimeSpan Preemption { get; init; }
+
+    /// <summary>
+    /// Creates the scenario that mirrors a <c>--capture-faults</c> profile, so a simulated run can be repeated
+    /// against the native helper.
+    /// </summary>
+    public static PacingScenario FromFaults(CaptureFaultProfile faults, TimeSpan duration, FrameRate frameRate) => new()
+    {
+        Seed = unchecked((int)faults.Seed),
+        Duration = duration,
+        FrameRate = frameRate,
+        CaptureJitter = faults.Jitter,
+        SourceDriftPpm = faults.DriftPpm,
+        BurstPeriod = faults.BurstPeriod,
+        BurstLength = faults.BurstLength,
+        StallProbability = faults.StallProbability,
+        MinStall = faults.MinStall,
+        MaxStall = faults.MaxStall,
+        PreemptionProbability = faults.PreemptionProbability,
+        Preemption = faults.Preemption,
+    };
+}
+
+/// <summary>
+/// What a simulated run sent.
+/// </summary>
+/// <param name="Metrics">The pipeline's counters at the end of the run.</param>
+/// <param name="Discontinuities">Sends that did not show the frame after the previous send's: repeats and skips.</param>
+/// <param name="MeanLatency">The mean time from a frame's arrival to its first send.</param>
+/// <param name="MaxLatency">The longest time from a frame's arrival to its first send.</param>
+/// <param name="WallTime">How long the run took in real time.</param>
+/// <param name="SendTimes">When each send happened, on the simulation's clock.</param>
+internal sealed record PacingSimulationResult(
+    PipelineMetrics Metrics,
+    long Discontinuities,
+    TimeSpan MeanLatency,
+    TimeSpan MaxLatency,
+    TimeSpan WallTime,
+    IReadOnlyList<TimeSpan> SendTimes)
+{
+    /// <summary>
+    /// Gets the output ticks: every fresh and repeated send.
+    /// </summary>
+    public long Ticks => Metrics.SentFrames + Metrics.RepeatedFrames;
+
+    /// <summary>
+    /// Gets the share of output ticks that showed the frame after the previous tick's: 1 is perfectly smooth motion,
+    /// and every repeat or skipped frame takes it down.
+    /// </summary>
+    public double Smoothness => Ticks == 0 ? 0 : 1d - ((double)Discontinuities / Ticks);
+}
+
+/// <summary>
+/// Runs the real paced sender on a <see cref="VirtualPipelineClock"/> against a <see cref="PacingScenario"/>, so hours
+/// of capture run in seconds and a seed always replays the same run.
+/// </summary>
+internal static class PacingSimulation
+{
+    private const int Width = 4;
+    private const int Height = 2;
+    private const int Stride = Width * 4;
+
+    /// <summary>
+    /// Runs <paramref name="scenario"/> once.
+    /// </summary>
+    /// <param name="scenario">The capture side.</param>
+    /// <param name="options">The pipeline under test.</param>
+    /// <param name="referenceClock">Creates the reference a phase-locked pacer follows from the simulation's clock.</param>
+    /// <remarks>A <see cref="NdiVideoPipelineOptions.Genlock"/> reference delivers its synthetic arrivals through the
+    /// simulation's scheduler, since only the paced sender may wait on the virtual clock.</remarks>
+    public static PacingSimulationResult Run(PacingScenario scenario, NdiVideoPipelineOptions options, Func<IPipelineClock, IReferenceClock>? referenceClock = null)
+    {
+        var wall = Stopwatch.StartNew();
+        var clock = new VirtualPipelineClock();
+        var scheduler = new DiscreteEventScheduler(clock);
+        var sender = new SequenceSender(clock);
+        var logger = new LoggerConfiguration().WriteTo.Sink(new NullSink()).CreateLogger();
+        var referenceSource = options.Genlock.IsEnabled
+            ? new ScheduledReferenceSource(new SyntheticReferenceSource(clock, options.Genlock, scenario.FrameRate), scheduler)
+            : null;
+        var pipeline = new NdiVideoPipeline(sender, scenario.FrameRate, options with { EnableBuffering = true }, logger, clock: clock, referenceClock: referenceClock?.Invoke(clock), referenceSource: referenceSource);
+        var buffer = Marshal.AllocHGlobal(Height * Stride);
+        try
+        {
+            var source = new SimulatedSource(scenario, scheduler, sequence =>
+            {
+                // The sequence number rides in the pixels, so the sender can tell fresh frames from repeats.
+                Marshal.WriteInt64(buffer, sequence);
+                sender.RecordArrival(sequence, clock.Elapsed);
+                pipeline.HandleFrame(new CapturedFrame(buffer, Width, Height, Stride, clock.GetTimestamp(), DateTime.UnixEpoch + clock.Elapsed));
+            });
+
+            pipeline.Start();
+            clock.WaitForWaiter();
+            source.Start();
+            scheduler.RunUntil(scenario.Duration);
+            var metrics = pipeline.GetMetrics();
+            pipeline.Stop();
+            return sender.Summarize(metrics, wall.Elapsed);
+        }
+        finally
+        {
+            pipeline.Dispose();
+            Marshal.FreeHGlobal(buffer);
+        }
+    }
+
+    /// <summary>
+    /// Runs <paramref name="scenario"/> once per pair of buffer depth and watermark hysteresis.
+    /// </summary>
+    public static IReadOnlyList<(int Depth, double? Hysteresis, PacingSimulationResult Result)> Sweep(
+        PacingScenario scenario,
+        NdiVideoPipelineOptions options,
+        IEnumerable<int> depths,
+        IEnumerable<double?> hystereses)
+    {
+        var results = new List<(int, double?, PacingSimulationResult)>();
+        foreach (var depth in depths)
+        {
+            foreach (var hysteresis in hystereses)
+            {
+                results.Add((depth, hysteresis, Run(scenario, options with { BufferDepth = depth, WatermarkHysteresis = hysteresis })));
+            }
+        }
+
+        return results;
+    }
+
+    /// <summary>
+    /// Runs every scenario against every pacing configuration: the smoothness matrix.
+    /// </summary>
+    public static IReadOnlyList<(string Scenario, string Mode, PacingSimulationResult Result)> Matrix(
+        IEnumerable<(string Name, PacingScenario Scenario)> scenarios,
+        IEnumerable<(string Name, NdiVideoPipelineOptions Options)> modes)
+    {
+        var modeList = modes.ToList();
+        var results = new List<(string, string, PacingSimulationResult)>();
+        foreach (var (scenarioName, scenario) in scenarios)
+        {
+            foreach (var (modeName, options) in modeList)
+            {
+                results.Add((scenarioName, modeName, Run(scenario, options)));
+            }
+        }
+
+        return results;
+    }
+
+    private sealed class SimulatedSource
+    {
+        private readonly PacingScenario scenario;
+        private readonly DiscreteEventScheduler scheduler;
+        private readonly Action<long> deliver;
+        private readonly Random random;
+        private readonly long intervalTicks;
+        private long sequence = -1;
+        private long delivered;
+        private TimeSpan lastArrival;
+        private TimeSpan stallEnd;
+        private int burstRemaining;
+        private TimeSpan burstRelease;
+
+        public SimulatedSource(PacingScenario scenario, DiscreteEventScheduler scheduler, Action<long> deliver)
+        {
+            this.scenario = scenario;
+            this.scheduler = scheduler;
+            this.deliver = deliver;
+            random = new Random(scenario.Seed);
+            intervalTicks = (long)(scenario.FrameRate.FrameDuration.Ticks / (1d + (scenario.SourceDriftPpm / 1_000_000d)));
+        }
+
+        public void Start() => ScheduleNext();
+
+        private void ScheduleNext()
+        {
+            TimeSpan nominal;
+            do
+            {
+                sequence++;
+                nominal = TimeSpan.FromTicks(intervalTicks * sequence);
+                if (nominal >= stallEnd && burstRemaining == 0 && random.NextDouble() < scenario.StallProbability)
+                {
+                    var span = scenario.MaxStall - scenario.MinStall;
+                    stallEnd = nominal + scenario.MinStall + TimeSpan.FromTicks((long)(span.Ticks * random.NextDouble()));
+                }
+            }
+            while (nominal < stallEnd);
+
+            var periodicBurst = scenario.BurstPeriod > 0 && scenario.BurstLength > 1 && sequence % scenario.BurstPeriod == 0;
+            if (burstRemaining == 0 && (periodicBurst || random.NextDouble() < scenario.BurstProbability))
+            {
+                burstRemaining = Math.Max(1, scenario.BurstLength);
+                burstRelease = nominal + TimeSpan.FromTicks(intervalTicks * (burstRemaining - 1));
+            }
+
+            var arrival = nominal + TimeSpan.FromTicks((long)Math.Abs(NextGaussian() * scenario.CaptureJitter.Ticks));
+            if (burstRemaining > 0)
+            {
+                burstRemaining--;
+                arrival = arrival > burstRelease ? arrival : burstRelease;
+            }
+
+            // A source delivers its frames in order, however late each one is.
+            lastArrival = arrival > lastArrival ? arrival : lastArrival;
+            // Stalled frames were never rendered, so the frames that follow carry on the delivered numbering.
+            var frame = delivered++;
+            var preempted = scenario.PreemptionProbability > 0 && random.NextDouble() < scenario.PreemptionProbability;
+            scheduler.Schedule(lastArrival, () =>
+            {
+                deliver(frame);
+                if (preempted)
+                {
+                    var resumed = lastArrival + scenario.Preemption;
+                    lastArrival = resumed > lastArrival ? resumed : lastArrival;
+                }
+
+                ScheduleNext();
+            });
+        }
+
+        private double NextGaussian()
+        {
+            var u1 = 1d - random.NextDouble();
+            var u2 = random.NextDouble();
+            return Math.Sqrt(-2d * Math.Log(u1)) * Math.Cos(2d * Math.PI * u2);
+        }
+    }
+
+    /// <summary>
+    /// Delivers a synthetic genlock reference's arrivals as scheduled events instead of from a thread of its own.
+    /// </summary>
+    private sealed class ScheduledReferenceSource : IReferenceFrameSource
+    {
+        private readonly SyntheticReferenceSource source;
+        private readonly DiscreteEventScheduler scheduler;
+        private Action<TimeSpan>? onFrame;
+
+        public ScheduledReferenceSource(SyntheticReferenceSource source, DiscreteEventScheduler scheduler)
+        {
+            this.source = source;
+            this.scheduler = scheduler;
+        }
+
+        public string Name => source.Name;
+
+        public FrameRate FrameRate => source.FrameRate;
+
+        public void Start(Action<TimeSpan> onFrame)
+        {
+            this.onFrame = onFrame;
+            source.Rewind(scheduler.Clock.Elapsed);
+            ScheduleNext();
+        }
+
+        public void Stop() => onFrame = null;
+
+        private void ScheduleNext()
+        {
+            var arrival = source.NextArrival();
+            scheduler.Schedule(arrival, () =>
+            {
+                if (onFrame is { } deliver)
+                {
+                    deliver(arrival);
+                    ScheduleNext();
+                }
+            });
+        }
+    }
+
+    private sealed class SequenceSender : INdiVideoSender
+    {
+        private readonly VirtualPipelineClock clock;
+        private readonly Queue<(long Sequence, TimeSpan At)> arrivals = new();
+        private readonly List<TimeSpan> sends = new();
+        private long lastSequence = -1;
+        private long discontinuities;
+        private long latencySamples;
+        private TimeSpan totalLatency;
+        private TimeSpan maxLatency;
+
+        public SequenceSender(VirtualPipelineClock clock)
+        {
+            this.clock = clock;
+        }
+
+        public bool RequiresFrameRetention => false;
+
+        public void Flush()
+        {
+        }
+
+        public void RecordArrival(long sequence, TimeSpan at) => arrivals.Enqueue((sequence, at));
+
+        public void Send(ref NDIlib.video_frame_v2_t frame)
+        {
+            var sequence = Marshal.ReadInt64(frame.p_data);
+            sends.Add(clock.Elapsed);
+            if (lastSequence >= 0 && sequence != lastSequence + 1)
+            {
+                discontinuities++;
+            }
+
+            // Frames the pipeline dropped never reach the sender; their arrivals are skipped here.
+            while (arrivals.TryPeek(out var head) && head.Sequence < sequence)
+            {
+                arrivals.Dequeue();
+            }
+
+            if (arrivals.TryPeek(out var arrival) && arrival.Sequence == sequence)
+            {
+                arrivals.Dequeue();
+                var latency = clock.Elapsed - arrival.At;
+                totalLatency += latency;
+                maxLatency = latency > maxLatency ? latency : maxLatency;
+                latencySamples++;
+            }
+
+            lastSequence = sequence;
+        }
+
+        public PacingSimulationResult Summarize(PipelineMetrics metrics, TimeSpan wallTime)
+        {
+            var mean = latencySamples > 0 ? TimeSpan.FromTicks(totalLatency.Ticks / latencySamples) : TimeSpan.Zero;
+            return new PacingSimulationResult(metrics, discontinuities, mean, maxLatency, wallTime, sends);
+        }
+    }
+}
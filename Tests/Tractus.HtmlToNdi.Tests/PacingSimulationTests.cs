@@ -0,0 +1,341 @@
+using System.Linq;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class PacingSimulationTests
+{
+    private static readonly NdiVideoPipelineOptions BufferedOptions = new()
+    {
+        EnableBuffering = true,
+        BufferDepth = 3,
+        TelemetryInterval = TimeSpan.FromDays(1),
+    };
+
+    private readonly ITestOutputHelper output;
+
+    public PacingSimulationTests(ITestOutputHelper output)
+    {
+        this.output = output;
+    }
+
+    [Fact]
+    public void VirtualClockWakesTheWaiterAtEachDeadline()
+    {
+        var clock = new VirtualPipelineClock();
+        var wakes = new List<TimeSpan>();
+        using var cancellation = new CancellationTokenSource();
+        var waiter = Task.Run(() =>
+        {
+            var deadline = TimeSpan.FromMilliseconds(10);
+            while (!cancellation.IsCancellationRequested)
+            {
+                clock.WaitUntil(deadline, cancellation.Token, null);
+                if (!cancellation.IsCancellationRequested)
+                {
+                    wakes.Add(clock.Elapsed);
+                }
+
+                deadline += TimeSpan.FromMilliseconds(10);
+            }
+        });
+
+        clock.WaitForWaiter();
+        clock.AdvanceTo(TimeSpan.FromMilliseconds(35));
+        Assert.Equal(
+            new[] { TimeSpan.FromMilliseconds(10), TimeSpan.FromMilliseconds(20), TimeSpan.FromMilliseconds(30) },
+            wakes);
+        Assert.Equal(TimeSpan.FromMilliseconds(35), clock.Elapsed);
+
+        Assert.True(clock.AdvanceToNextDeadline());
+        Assert.Equal(4, wakes.Count);
+        Assert.Equal(TimeSpan.FromMilliseconds(40), clock.Elapsed);
+
+        cancellation.Cancel();
+        Assert.True(waiter.Wait(TimeSpan.FromSeconds(5)));
+
+        // Once the waiter has left, the clock advances on its own.
+        Assert.False(clock.AdvanceToNextDeadline());
+        clock.AdvanceTo(TimeSpan.FromSeconds(1));
+        Assert.Equal(4, wakes.Count);
+    }
+
+    [Fact]
+    public void SameSeedReplaysTheSameRun()
+    {
+        var scenario = new PacingScenario
+        {
+            Seed = 7,
+            Duration = TimeSpan.FromMinutes(2),
+            CaptureJitter = TimeSpan.FromMilliseconds(4),
+            BurstProbability = 0.01,
+            StallProbability = 0.002,
+        };
+
+        var first = PacingSimulation.Run(scenario, BufferedOptions);
+        var second = PacingSimulation.Run(scenario, BufferedOptions);
+        var reseeded = PacingSimulation.Run(scenario with { Seed = 8 }, BufferedOptions);
+
+        Assert.Equal(first.Metrics, second.Metrics);
+        Assert.Equal(first.Discontinuities, second.Discontinuities);
+        Assert.Equal(first.MaxLatency, second.MaxLatency);
+        Assert.NotEqual(first.Metrics, reseeded.Metrics);
+    }
+
+    [Fact]
+    public void AnHourOfJitterBurstsAndStallsRunsFasterThanRealTime()
+    {
+        var scenario = new PacingScenario
+        {
+            Duration = TimeSpan.FromHours(1),
+            FrameRate = new FrameRate(30, 1),
+            CaptureJitter = TimeSpan.FromMilliseconds(3),
+            SourceDriftPpm = 50,
+            BurstProbability = 0.005,
+            StallProbability = 0.0005,
+        };
+
+        var result = PacingSimulation.Run(scenario, BufferedOptions);
+        output.WriteLine($"{result.Metrics}, discontinuities={result.Discontinuities}, meanLatency={result.MeanLatency.TotalMilliseconds:F1}ms, wall={result.WallTime.TotalSeconds:F1}s");
+
+        // A source this close to the output rate barely moves the pacer off its interval, so every tick is sent.
+        var expectedTicks = (long)(scenario.Duration.Ticks / scenario.FrameRate.FrameDuration.Ticks);
+        Assert.InRange(result.Ticks, expectedTicks - 10, expectedTicks + 1);
+        Assert.True(result.Metrics.Underruns > 0);
+        Assert.True(result.WallTime < scenario.Duration / 10);
+    }
+
+    [Fact]
+    public void DeeperBuffersRideOutStallsWithLatencyExpansion()
+    {
+        var scenario = new PacingScenario
+        {
+            Seed = 3,
+            Duration = TimeSpan.FromMinutes(10),
+            CaptureJitter = TimeSpan.FromMilliseconds(2),
+            StallProbability = 0.002,
+            MinStall = TimeSpan.FromMilliseconds(40),
+            MaxStall = TimeSpan.FromMilliseconds(120),
+        };
+
+        // Without latency expansion a dip below the low watermark trims the buffer and rewarms, whatever its depth.
+        var options = BufferedOptions with { AllowLatencyExpansion = true };
+        var sweep = PacingSimulation.Sweep(scenario, options, new[] { 1, 2, 4, 8 }, new double?[] { null });
+        foreach (var (depth, _, result) in sweep)
+        {
+            output.WriteLine($"depth={depth}: underruns={result.Metrics.Underruns}, repeats={result.Metrics.RepeatedFrames}, discontinuities={result.Discontinuities}, meanLatency={result.MeanLatency.TotalMilliseconds:F1}ms");
+        }
+
+        var underruns = sweep.Select(entry => entry.Result.Metrics.Underruns).ToList();
+        for (var i = 1; i < underruns.Count; i++)
+        {
+            Assert.True(underruns[i] <= underruns[i - 1], $"depth {sweep[i].Depth} underran {underruns[i]} times, more than depth {sweep[i - 1].Depth}");
+        }
+
+        Assert.True(underruns[^1] < underruns[0]);
+        Assert.True(sweep[^1].Result.MeanLatency > sweep[0].Result.MeanLatency);
+    }
+
+    [Fact]
+    public void SendLatencyIsRecordedForEveryFrameByPath()
+    {
+        var scenario = new PacingScenario
+        {
+            Seed = 5,
+            Duration = TimeSpan.FromMinutes(5),
+            CaptureJitter = TimeSpan.FromMilliseconds(2),
+            StallProbability = 0.002,
+            MinStall = TimeSpan.FromMilliseconds(40),
+            MaxStall = TimeSpan.FromMilliseconds(120),
+        };
+
+        var buffered = PacingSimulation.Run(scenario, BufferedOptions with { AllowLatencyExpansion = true });
+        var latency = buffered.Metrics.SendLatency!;
+        foreach (var histogram in latency.RecordedPaths())
+        {
+            output.WriteLine($"{histogram.Path}: frames={histogram.Count}, mean={histogram.MeanMilliseconds:F2}ms, p50={histogram.P50Milliseconds:F2}ms, p99={histogram.P99Milliseconds:F2}ms, max={histogram.MaxMicroseconds / 1000d:F2}ms");
+        }
+
+        // Every send is recorded once, on the path it took, and the fresh sends agree with the sender's own view.
+        Assert.Equal(0, latency.Direct.Count);
+        Assert.True(latency.LatencyExpansion.Count > 0);
+        Assert.Equal(buffered.Metrics.SentFrames, latency.Buffered.Count + latency.LatencyExpansion.Count);
+        Assert.Equal(buffered.Metrics.RepeatedFrames, latency.Repeated.Count);
+        var freshMeanMs = (latency.Buffered.SumMicroseconds + latency.LatencyExpansion.SumMicroseconds) / 1000d / buffered.Metrics.SentFrames;
+        Assert.InRange(freshMeanMs, buffered.MeanLatency.TotalMilliseconds - 0.01, buffered.MeanLatency.TotalMilliseconds + 0.01);
+        Assert.InRange(latency.Buffered.MaxMicroseconds / 1000d, 0, buffered.MaxLatency.TotalMilliseconds + 0.01);
+
+        // The buffer holds frames for about its depth, and a repeat shows a frame that has already waited that long.
+        var frameMs = 1000d / 60;
+        Assert.InRange(latency.Buffered.P50Milliseconds, frameMs, (BufferedOptions.BufferDepth + 1) * frameMs);
+        Assert.True(latency.Repeated.MeanMilliseconds > latency.Buffered.MeanMilliseconds);
+    }
+
+    [Fact]
+    public void WiderWatermarksUnderrunLessOften()
+    {
+        var scenario = new PacingScenario
+        {
+            Seed = 11,
+            Duration = TimeSpan.FromMinutes(5),
+            CaptureJitter = TimeSpan.FromMilliseconds(5),
+            BurstProbability = 0.02,
+            BurstLength = 4,
+            SourceDriftPpm = -200,
+        };
+
+        var depths = new[] { 3, 6 };
+        var hystereses = new double?[] { 0.5, 1, 2, 3 };
+        var sweep = PacingSimulation.Sweep(scenario, BufferedOptions, depths, hystereses);
+        foreach (var (depth, hysteresis, result) in sweep)
+        {
+            output.WriteLine($"depth={depth}, hysteresis={hysteresis}: underruns={result.Metrics.Underruns}, resyncDrops={result.Metrics.ResyncDrops}, overflow={result.Metrics.DroppedOverflow}, discontinuities={result.Discontinuities}");
+        }
+
+        foreach (var depth in depths)
+        {
+            var underruns = sweep.Where(entry => entry.Depth == depth).Select(entry => entry.Result.Metrics.Underruns).ToList();
+            for (var i = 1; i < underruns.Count; i++)
+            {
+                Assert.True(underruns[i] <= underruns[i - 1], $"depth {depth} underran more often with hysteresis {hystereses[i]} than {hystereses[i - 1]}");
+            }
+
+            Assert.True(underruns[^1] < underruns[0]);
+        }
+    }
+
+    [Fact]
+    public void SmoothnessMatrixScoresEachPacingModeUnderEachFault()
+    {
+        var duration = TimeSpan.FromMinutes(3);
+        var frameRate = new FrameRate(60, 1);
+        var faults = new[] { "seed=5", "jitter=4,seed=5", "burst=120x4,seed=5", "stall=0.002:50-250,seed=5", "drift=-300,seed=5", "preempt=0.01:12,seed=5", "jitter=4,burst=120x4,stall=0.002:50-250,drift=-300,preempt=0.01:12,seed=5" };
+        var scenarios = faults.Select(text => (text, PacingScenario.FromFaults(CaptureFaultProfile.Parse(text), duration, frameRate)));
+        var modes = new (string, NdiVideoPipelineOptions)[]
+        {
+            ("latency", BufferedOptions),
+            ("latency+expansion", BufferedOptions with { AllowLatencyExpansion = true }),
+            ("smoothness", BufferedOptions with { PacingMode = Launcher.PacingMode.Smoothness, BufferDepth = 8 }),
+        };
+
+        var matrix = PacingSimulation.Matrix(scenarios, modes);
+        foreach (var (scenario, mode, result) in matrix)
+        {
+            output.WriteLine($"{scenario,-72} {mode,-18} smoothness={result.Smoothness:P2}, underruns={result.Metrics.Underruns}, meanLatency={result.MeanLatency.TotalMilliseconds:F1}ms");
+        }
+
+        foreach (var (scenario, mode, result) in matrix.Where(entry => entry.Scenario == faults[0]))
+        {
+            Assert.True(result.Smoothness > 0.999, $"{mode} was only {result.Smoothness:P2} smooth without faults");
+        }
+
+        foreach (var (scenario, mode, result) in matrix)
+        {
+            var clean = matrix.Single(entry => entry.Scenario == faults[0] && entry.Mode == mode).Result;
+            Assert.True(result.Smoothness <= clean.Smoothness, $"{mode} was smoother under '{scenario}' than without faults");
+        }
+
+        // With every fault at once, the deeper smoothness buffer shows the fewest repeats and skips.
+        var combined = matrix.Where(entry => entry.Scenario == faults[^1]).ToDictionary(entry => entry.Mode, entry => entry.Result);
+        Assert.True(combined["smoothness"].Smoothness >= combined["latency"].Smoothness);
+    }
+
+    [Fact]
+    public void AutoBufferDepthSettlesOnTheShallowestDepthThatAbsorbsEachFault()
+    {
+        var frameRate = new FrameRate(60, 1);
+        var cases = new[] { ("jitter=6,seed=3", 3), ("burst=120x4,jitter=2,seed=3", 4) };
+        foreach (var (faults, expectedDepth) in cases)
+        {
+            var scenario = PacingScenario.FromFaults(CaptureFaultProfile.Parse(faults), TimeSpan.FromMinutes(5), frameRate);
+            var fixedDeep = PacingSimulation.Run(scenario, BufferedOptions with { BufferDepth = 8, AllowLatencyExpansion = true });
+            foreach (var start in new[] { 1, 8 })
+            {
+                var tuned = PacingSimulation.Run(scenario, BufferedOptions with { BufferDepth = start, AutoBufferDepth = BufferDepthTuning.Parse("1-8") });
+                output.WriteLine($"{faults} from {start}: depth={tuned.Metrics.BufferDepth}, repeats={tuned.Metrics.RepeatedFrames}, smoothness={tuned.Smoothness:P3}, meanLatency={tuned.MeanLatency.TotalMilliseconds:F1}ms (depth 8: {fixedDeep.MeanLatency.TotalMilliseconds:F1}ms)");
+
+                Assert.Equal(expectedDepth, tuned.Metrics.BufferDepth);
+                // Growing from one frame costs a few repeats before the depth catches up; shrinking costs none.
+                Assert.InRange(tuned.Metrics.RepeatedFrames, 0, start == 1 ? 10 : 0);
+                Assert.True(tuned.MeanLatency < fixedDeep.MeanLatency);
+            }
+        }
+    }
+
+    [Fact]
+    public void PhaseLockedPacerSendsOnTheReferenceGrid()
+    {
+        var frameRate = new FrameRate(60, 1);
+        var scenario = new PacingScenario { Duration = TimeSpan.FromMinutes(1), FrameRate = frameRate };
+        var references = new List<SimulatedReferenceClock>();
+        IReferenceClock Reference(IPipelineClock clock)
+        {
+            var reference = new SimulatedReferenceClock(clock, TimeSpan.FromMilliseconds(5.5), 120, TimeSpan.FromMicroseconds(2));
+            references.Add(reference);
+            return reference;
+        }
+
+        var locked = PacingSimulation.Run(scenario, BufferedOptions with { PacingReference = PacingReference.Parse("system") }, Reference);
+        var freeRunning = PacingSimulation.Run(scenario, BufferedOptions, Reference);
+
+        // How far each send after the first ten seconds landed from the nearest slot of the reference's 60 fps grid.
+        long PhaseError(PacingSimulationResult result, SimulatedReferenceClock reference) => result.SendTimes
+            .Where(at => at > TimeSpan.FromSeconds(10))
+            .Max(at =>
+            {
+                var slot = (Int128)reference.TrueTicksAt(at) * frameRate.Numerator % (frameRate.Denominator * TimeSpan.TicksPerSecond);
+                return (long)Int128.Min(slot, (frameRate.Denominator * TimeSpan.TicksPerSecond) - slot) / frameRate.Numerator;
+            });
+
+        var lockedError = PhaseError(locked, references[0]);
+        var freeRunningError = PhaseError(freeRunning, references[1]);
+        output.WriteLine($"locked: maxPhaseError={lockedError / 10d:F1}us, repeats={locked.Metrics.RepeatedFrames}, smoothness={locked.Smoothness:P3}, lock={locked.Metrics.ReferenceLock}");
+        output.WriteLine($"free-running: maxPhaseError={freeRunningError / 10d:F1}us, repeats={freeRunning.Metrics.RepeatedFrames}, smoothness={freeRunning.Smoothness:P3}");
+
+        Assert.Equal(ReferenceLockState.Locked, locked.Metrics.ReferenceLock?.State);
+        Assert.InRange(locked.Metrics.ReferenceLock?.FrequencyPpm ?? 0, 118, 122);
+        Assert.InRange(lockedError, 0, 100);
+        Assert.True(freeRunningError > TimeSpan.FromMilliseconds(1).Ticks);
+        Assert.Null(freeRunning.Metrics.ReferenceLock);
+        Assert.True(locked.Smoothness > 0.99);
+    }
+
+    [Fact]
+    public void GenlockedPacerFollowsTheReferenceArrivals()
+    {
+        var frameRate = new FrameRate(60, 1);
+        var genlock = GenlockReference.Parse("synthetic,drift=-180,jitter=1,seed=4");
+
+        // The page renders on the reference's clock, as a page fed by the same house sync would.
+        var scenario = new PacingScenario { Duration = TimeSpan.FromMinutes(2), FrameRate = frameRate, SourceDriftPpm = genlock.DriftPpm };
+        var locked = PacingSimulation.Run(scenario, BufferedOptions with { Genlock = genlock });
+        var freeRunning = PacingSimulation.Run(scenario, BufferedOptions);
+
+        // The spread of each send's phase against the reference's nominal frame grid over the second minute.
+        var interval = frameRate.Denominator * (double)TimeSpan.TicksPerSecond / frameRate.Numerator / (1d + (genlock.DriftPpm * 1e-6));
+        double PhaseSpread(PacingSimulationResult result)
+        {
+            var phases = result.SendTimes
+                .Where(at => at > TimeSpan.FromMinutes(1))
+                .Select(at => at.Ticks % interval)
+                .Select(phase => phase > interval / 2 ? phase - interval : phase)
+                .ToList();
+            return phases.Max() - phases.Min();
+        }
+
+        var lockedSpread = PhaseSpread(locked);
+        var freeRunningSpread = PhaseSpread(freeRunning);
+        output.WriteLine($"genlocked: phaseSpread={lockedSpread / 10d:F1}us, repeats={locked.Metrics.RepeatedFrames}, smoothness={locked.Smoothness:P3}, lock={locked.Metrics.ReferenceLock}");
+        output.WriteLine($"free-running: phaseSpread={freeRunningSpread / 10d:F1}us, repeats={freeRunning.Metrics.RepeatedFrames}, smoothness={freeRunning.Smoothness:P3}");
+
+        Assert.Equal(ReferenceLockState.Locked, locked.Metrics.ReferenceLock?.State);
+        Assert.InRange(locked.Metrics.ReferenceLock?.FrequencyPpm ?? 0, genlock.DriftPpm - 8, genlock.DriftPpm + 8);
+        Assert.Equal(0, locked.Metrics.ReferenceLock?.MissedFrames);
+        Assert.InRange(locked.Metrics.ReferenceLock?.Arrivals ?? 0, 7190, 7210);
+        Assert.InRange(lockedSpread, 0, TimeSpan.FromMicroseconds(500).Ticks);
+        Assert.True(freeRunningSpread > TimeSpan.FromMilliseconds(5).Ticks);
+        Assert.True(locked.Smoothness > 0.99);
+    }
+}
@@ -0,0 +1,56 @@
+using System.Threading;
+using System.Threading.Tasks;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class PaddedCounterBlockTests
+{
+    [Fact]
+    public void CountersAreIndependent()
+    {
+        var block = new PaddedCounterBlock(3);
+
+        block.Increment(0);
+        block.Increment(2);
+        block.Increment(2);
+
+        Assert.Equal(3, block.Count);
+        Assert.Equal(1, block.Read(0));
+        Assert.Equal(0, block.Read(1));
+        Assert.Equal(2, block.Read(2));
+    }
+
+    [Fact]
+    public void ReadersOnOtherThreadsSeeTheOwnersCounts()
+    {
+        var capture = new PaddedCounterBlock(1);
+        var output = new PaddedCounterBlock(1);
+        const int increments = 100_000;
+
+        var writers = new[]
+        {
+            Task.Run(() => { for (var i = 0; i < increments; i++) { capture.Increment(0); } }),
+            Task.Run(() => { for (var i = 0; i < increments; i++) { output.Increment(0); } }),
+        };
+
+        long observed = 0;
+        while (!Task.WhenAll(writers).IsCompleted)
+        {
+            var current = capture.Read(0);
+            Assert.True(current >= observed, "Counts never go backwards.");
+            observed = current;
+            Thread.Yield();
+        }
+
+        Assert.Equal(increments, capture.Read(0));
+        Assert.Equal(increments, output.Read(0));
+    }
+
+    [Fact]
+    public void RejectsEmptyBlocks()
+    {
+        Assert.Throws<ArgumentOutOfRangeException>(() => new PaddedCounterBlock(0));
+    }
+}
@@ -0,0 +1,230 @@
+using System.Linq;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class ReferenceFollowerTests
+{
+    private const double MaxSlewPpm = PacingReference.DefaultMaxSlewPpm;
+
+    /// <summary>
+    /// Hands a synthetic reference's arrivals to a follower as they come due, dropping those
+    /// <see cref="Deliver"/> refuses, as a reference on the network loses frames.
+    /// </summary>
+    private sealed class ArrivalFeed
+    {
+        private readonly SyntheticReferenceSource source;
+        private TimeSpan next;
+        private long index;
+
+        public ArrivalFeed(SyntheticReferenceSource source)
+        {
+            this.source = source;
+            source.Rewind(TimeSpan.Zero);
+            next = source.NextArrival();
+        }
+
+        public Func<long, bool> Deliver { get; set; } = _ => true;
+
+        public long Dropped { get; private set; }
+
+        public void PostUntil(TimeSpan now, ReferenceFollower follower)
+        {
+            while (next <= now)
+            {
+                if (Deliver(index))
+                {
+                    follower.Post(next);
+                }
+                else
+                {
+                    Dropped++;
+                }
+
+                index++;
+                next = source.NextArrival();
+            }
+        }
+    }
+
+    private static (VirtualPipelineClock Clock, ArrivalFeed Feed, ReferenceFollower Follower, PhaseLockedCadence Cadence) Create(
+        GenlockReference reference,
+        FrameRate outputFrameRate)
+    {
+        var clock = new VirtualPipelineClock();
+        var source = new SyntheticReferenceSource(clock, reference, outputFrameRate);
+        var follower = new ReferenceFollower(source.Name, source.FrameRate, reference.MaxSlewPpm);
+        return (clock, new ArrivalFeed(source), follower, new PhaseLockedCadence(clock, follower, outputFrameRate));
+    }
+
+    /// <summary>
+    /// Drives the cadence for <paramref name="duration"/>, posting each arrival before the tick that follows it.
+    /// </summary>
+    private static List<TimeSpan> Run(VirtualPipelineClock clock, ArrivalFeed feed, ReferenceFollower follower, PhaseLockedCadence cadence, TimeSpan duration)
+    {
+        var deadlines = new List<TimeSpan>();
+        var end = clock.Elapsed + duration;
+        while (clock.Elapsed < end)
+        {
+            feed.PostUntil(clock.Elapsed, follower);
+            var deadline = cadence.NextDeadline();
+            clock.AdvanceTo(deadline);
+            deadlines.Add(deadline);
+        }
+
+        return deadlines;
+    }
+
+    /// <summary>
+    /// Returns how far a tick landed from the nearest frame of the reference's nominal grid, which starts at zero.
+    /// </summary>
+    private static long PhaseTicks(TimeSpan at, GenlockReference reference, FrameRate frameRate)
+    {
+        var interval = frameRate.Denominator * (double)TimeSpan.TicksPerSecond / frameRate.Numerator / (1d + (reference.DriftPpm * 1e-6));
+        var phase = at.Ticks % interval;
+        return (long)(phase > interval / 2 ? phase - interval : phase);
+    }
+
+    /// <summary>
+    /// Asserts a tick landed on the reference's nominal grid. The follower locks to the least delayed arrivals, which
+    /// are a little late, so the tick may trail the grid by a share of the jitter.
+    /// </summary>
+    private static void AssertOnGrid(TimeSpan at, GenlockReference reference, FrameRate frameRate)
+    {
+        var trail = (reference.Jitter / 4) + TimeSpan.FromMicroseconds(150);
+        Assert.InRange(PhaseTicks(at, reference, frameRate), -TimeSpan.FromMicroseconds(50).Ticks, trail.Ticks);
+    }
+
+    [Theory]
+    [InlineData("synthetic,drift=80,jitter=1,seed=3", 60, 1)]
+    [InlineData("synthetic,drift=-150,jitter=2,seed=5", 60000, 1001)]
+    [InlineData("synthetic,drift=20", 50, 1)]
+    public void LocksOntoDriftingJitteryArrivals(string text, int numerator, int denominator)
+    {
+        var reference = GenlockReference.Parse(text, MaxSlewPpm);
+        var frameRate = new FrameRate(numerator, denominator);
+        var (clock, feed, follower, cadence) = Create(reference, frameRate);
+
+        var deadlines = Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(90));
+
+        Assert.Equal(ReferenceLockState.Locked, follower.Lock.State);
+        Assert.InRange(follower.Lock.FrequencyPpm, reference.DriftPpm - 8, reference.DriftPpm + 8);
+        Assert.Equal(0, follower.MissedFrames);
+        Assert.Equal(0, follower.Lock.Steps);
+        Assert.Equal(0, cadence.SkippedSlots);
+        Assert.All(deadlines.Skip(deadlines.Count / 2), at => AssertOnGrid(at, reference, frameRate));
+    }
+
+    [Fact]
+    public void MissedArrivalsAreCountedWithoutSlippingTheGrid()
+    {
+        var reference = GenlockReference.Parse("synthetic,drift=60,jitter=0.5");
+        var frameRate = new FrameRate(60, 1);
+        var (clock, feed, follower, cadence) = Create(reference, frameRate);
+        Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(45));
+
+        // Every tenth frame is lost, and then a run of five.
+        feed.Deliver = index => index % 10 != 0 && index is not (3001 or 3002 or 3003 or 3004 or 3005);
+        var deadlines = Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(30));
+
+        Assert.InRange(follower.MissedFrames, feed.Dropped - 1, feed.Dropped);
+        Assert.True(feed.Dropped > 180);
+        Assert.Equal(ReferenceLockState.Locked, follower.Lock.State);
+        Assert.Equal(0, cadence.SkippedSlots);
+        Assert.All(deadlines, at => AssertOnGrid(at, reference, frameRate));
+    }
+
+    [Fact]
+    public void HoldsOverWhenArrivalsStopAndRelocksWhenTheyResume()
+    {
+        var reference = GenlockReference.Parse("synthetic,drift=-90,jitter=0.5");
+        var frameRate = new FrameRate(30000, 1001);
+        var (clock, feed, follower, cadence) = Create(reference, frameRate);
+        Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(60));
+        Assert.Equal(ReferenceLockState.Locked, follower.Lock.State);
+
+        feed.Deliver = _ => false;
+        var heldOver = Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(5));
+
+        // The learned frequency carries the grid through the outage.
+        Assert.Equal(ReferenceLockState.Holdover, follower.Lock.State);
+        Assert.All(heldOver, at => AssertOnGrid(at, reference, frameRate));
+
+        feed.Deliver = _ => true;
+        Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(2));
+        Assert.Equal(ReferenceLockState.Locked, follower.Lock.State);
+        Assert.Equal(0, follower.Lock.Steps);
+    }
+
+    [Fact]
+    public void OutputAtTwiceTheReferenceRateTicksOnEachArrivalAndBetween()
+    {
+        var reference = GenlockReference.Parse("synthetic,rate=30,drift=45,jitter=0.5");
+        var frameRate = new FrameRate(60, 1);
+        var (clock, feed, follower, cadence) = Create(reference, frameRate);
+
+        var deadlines = Run(clock, feed, follower, cadence, TimeSpan.FromSeconds(90));
+
+        Assert.Equal(ReferenceLockState.Locked, follower.Lock.State);
+        Assert.Equal(0, cadence.SkippedSlots);
+        Assert.All(deadlines.Skip(deadlines.Count / 2), at => AssertOnGrid(at, reference, frameRate));
+    }
+
+    [Fact]
+    public void ArrivalsBeyondThePendingLimitAreDropped()
+    {
+        var follower = new ReferenceFollower("test", new FrameRate(60, 1), MaxSlewPpm);
+        for (var i = 0; i < ReferenceFollower.MaxPendingArrivals + 44; i++)
+        {
+            follower.Post(TimeSpan.FromTicks(166_667L * i));
+        }
+
+        follower.Drain(TimeSpan.FromSeconds(10).Ticks);
+
+        Assert.Equal(44, follower.DroppedArrivals);
+        Assert.Equal(ReferenceFollower.MaxPendingArrivals, follower.Arrivals);
+    }
+
+    [Fact]
+    public void SyntheticArrivalsAreOrderedAndReplayFromTheirSeed()
+    {
+        var source = new SyntheticReferenceSource(new VirtualPipelineClock(), GenlockReference.Parse("synthetic,jitter=5,seed=9"), new FrameRate(60, 1));
+        source.Rewind(TimeSpan.FromSeconds(1));
+        var first = Enumerable.Range(0, 600).Select(_ => source.NextArrival()).ToList();
+        source.Rewind(TimeSpan.FromSeconds(1));
+        var second = Enumerable.Range(0, 600).Select(_ => source.NextArrival()).ToList();
+
+        Assert.Equal(first, second);
+        Assert.All(first.Zip(first.Skip(1)), pair => Assert.True(pair.Second >= pair.First));
+        Assert.True(first[0] >= TimeSpan.FromSeconds(1));
+    }
+
+    [Fact]
+    public void ParseReadsTheSyntheticSource()
+    {
+        var reference = GenlockReference.Parse(" Synthetic , rate=59.94, drift=-75.5, jitter=1.5, seed=12 ", 200);
+
+        Assert.True(reference.IsEnabled);
+        Assert.Equal(GenlockReference.SyntheticSource, reference.Source);
+        Assert.Equal(new FrameRate(60000, 1001), reference.FrameRate);
+        Assert.Equal(-75.5, reference.DriftPpm);
+        Assert.Equal(TimeSpan.FromMilliseconds(1.5), reference.Jitter);
+        Assert.Equal(12UL, reference.Seed);
+        Assert.Equal(200, reference.MaxSlewPpm);
+        Assert.Null(GenlockReference.Parse("synthetic").FrameRate);
+        Assert.False(GenlockReference.Parse(null).IsEnabled);
+    }
+
+    [Theory]
+    [InlineData("ndi")]
+    [InlineData("drift=20")]
+    [InlineData("synthetic,drift=900")]
+    [InlineData("synthetic,jitter=-1")]
+    [InlineData("synthetic,rate=fast")]
+    [InlineData("synthetic,offset=3")]
+    public void ParseRejectsInvalidReferences(string text)
+    {
+        Assert.Throws<FormatException>(() => GenlockReference.Parse(text));
+    }
+}
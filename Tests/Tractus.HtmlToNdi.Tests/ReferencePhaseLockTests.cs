@@ -0,0 +1,177 @@
+using System.Linq;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class ReferencePhaseLockTests
+{
+    private const double MaxSlewPpm = PacingReference.DefaultMaxSlewPpm;
+
+    private sealed record Tick(TimeSpan Deadline, long Frame, long Reference, long PhaseError);
+
+    /// <summary>
+    /// Drives a phase-locked cadence for <paramref name="duration"/>, jumping the clock to each deadline as the
+    /// paced sender's wait would.
+    /// </summary>
+    private static List<Tick> Run(VirtualPipelineClock clock, SimulatedReferenceClock reference, PhaseLockedCadence cadence, TimeSpan duration)
+    {
+        var ticks = new List<Tick>();
+        var end = clock.Elapsed + duration;
+        while (clock.Elapsed < end)
+        {
+            var deadline = cadence.NextDeadline();
+            clock.AdvanceTo(deadline);
+            var truth = reference.TrueTicksAt(deadline);
+            ticks.Add(new Tick(deadline, cadence.FrameNumber, truth, truth - cadence.FrameStart(cadence.FrameNumber)));
+        }
+
+        return ticks;
+    }
+
+    [Theory]
+    [InlineData(3.3, 80d, 60, 1)]
+    [InlineData(-7.1, -150d, 60000, 1001)]
+    [InlineData(0.4, 20d, 50, 1)]
+    public void LocksOntoAnOffsetAndDriftingReference(double offsetMilliseconds, double driftPpm, int numerator, int denominator)
+    {
+        var clock = new VirtualPipelineClock();
+        var reference = new SimulatedReferenceClock(clock, TimeSpan.FromMilliseconds(offsetMilliseconds), driftPpm, TimeSpan.FromMicroseconds(2));
+        var cadence = new PhaseLockedCadence(clock, reference, new FrameRate(numerator, denominator), MaxSlewPpm);
+
+        var ticks = Run(clock, reference, cadence, TimeSpan.FromSeconds(20));
+
+        Assert.Equal(ReferenceLockState.Locked, cadence.Lock.State);
+        Assert.InRange(cadence.Lock.FrequencyPpm, driftPpm - 2, driftPpm + 2);
+        Assert.Equal(0, cadence.Lock.Steps);
+        Assert.Equal(0, cadence.SkippedSlots);
+        Assert.All(ticks.Zip(ticks.Skip(1)), pair => Assert.Equal(pair.First.Frame + 1, pair.Second.Frame));
+        Assert.All(ticks.Skip(ticks.Count / 2), tick => Assert.InRange(tick.PhaseError, -100, 100));
+    }
+
+    [Fact]
+    public void MachinesOnTheSameReferenceSendEachFrameAtTheSameInstant()
+    {
+        var machines = new[] { (Offset: 4.2, Drift: 95d), (Offset: -11.8, Drift: -60d) }.Select(machine =>
+        {
+            var clock = new VirtualPipelineClock();
+            var reference = new SimulatedReferenceClock(clock, TimeSpan.FromMilliseconds(machine.Offset), machine.Drift, TimeSpan.FromMicroseconds(2));
+            var cadence = new PhaseLockedCadence(clock, reference, new FrameRate(60000, 1001), MaxSlewPpm);
+            return Run(clock, reference, cadence, TimeSpan.FromSeconds(20)).Skip(600).ToDictionary(tick => tick.Frame, tick => tick.Reference);
+        }).ToList();
+
+        var shared = machines[0].Keys.Intersect(machines[1].Keys).ToList();
+        Assert.True(shared.Count > 500);
+        Assert.All(shared, frame => Assert.InRange(machines[0][frame] - machines[1][frame], -100, 100));
+    }
+
+    [Fact]
+    public void SmallReferenceJumpsAreSlewedWithinTheLimit()
+    {
+        var clock = new VirtualPipelineClock();
+        var reference = new SimulatedReferenceClock(clock, TimeSpan.Zero, 40);
+        var cadence = new PhaseLockedCadence(clock, reference, new FrameRate(60, 1), MaxSlewPpm);
+        Run(clock, reference, cadence, TimeSpan.FromSeconds(10));
+        Assert.Equal(ReferenceLockState.Locked, cadence.Lock.State);
+
+        reference.Step(TimeSpan.FromMilliseconds(2));
+        var ticks = Run(clock, reference, cadence, TimeSpan.FromSeconds(15));
+
+        // 2 ms at 500 ppm takes four seconds to slew out, and no frame interval moves by more than the limit allows.
+        var nominal = TimeSpan.FromSeconds(1d / 60d).Ticks / (1d + 40e-6);
+        var maxStretch = ticks.Zip(ticks.Skip(1)).Max(pair => Math.Abs((pair.Second.Deadline - pair.First.Deadline).Ticks - nominal));
+        Assert.InRange(maxStretch, 0, (nominal * MaxSlewPpm * 1e-6) + 2);
+        Assert.Equal(0, cadence.Lock.Steps);
+        Assert.Equal(0, cadence.SkippedSlots);
+        Assert.InRange(ticks.Last().PhaseError, -100, 100);
+        Assert.Equal(ReferenceLockState.Locked, cadence.Lock.State);
+        Assert.True(ticks.Take(120).All(tick => tick.PhaseError > TimeSpan.FromMilliseconds(1).Ticks));
+    }
+
+    [Fact]
+    public void LargeReferenceJumpsAreSteppedWithoutBunchingTicks()
+    {
+        var clock = new VirtualPipelineClock();
+        var reference = new SimulatedReferenceClock(clock, TimeSpan.Zero, -25);
+        var frameRate = new FrameRate(60000, 1001);
+        var cadence = new PhaseLockedCadence(clock, reference, frameRate, MaxSlewPpm);
+        var before = Run(clock, reference, cadence, TimeSpan.FromSeconds(10));
+
+        // A leap second moves a 59.94 grid by most of a frame.
+        reference.Step(TimeSpan.FromSeconds(1));
+        var after = Run(clock, reference, cadence, TimeSpan.FromSeconds(10));
+
+        Assert.Equal(1, cadence.Lock.Steps);
+        Assert.Equal(0, cadence.SkippedSlots);
+        var ticks = before.Concat(after).ToList();
+        var minInterval = ticks.Zip(ticks.Skip(1)).Min(pair => pair.Second.Deadline - pair.First.Deadline);
+        Assert.True(minInterval >= frameRate.FrameDuration / 2);
+        Assert.Equal(ReferenceLockState.Locked, cadence.Lock.State);
+        Assert.InRange(after.Last().PhaseError, -100, 100);
+    }
+
+    [Fact]
+    public void PreemptedSamplesAreDiscardedAndALockedLoopHoldsOver()
+    {
+        var phaseLock = new ReferencePhaseLock(MaxSlewPpm, TimeSpan.FromMilliseconds(8));
+        var interval = TimeSpan.FromMilliseconds(10).Ticks;
+        var spread = ReferencePhaseLock.MaxSampleSpread.Ticks * 2;
+        long local = 0;
+        for (var i = 0; i < 500; i++, local += interval)
+        {
+            phaseLock.Update(local, local + 1_000_000, local);
+        }
+
+        Assert.Equal(ReferenceLockState.Locked, phaseLock.State);
+
+        for (var i = 0; i < 150; i++, local += interval)
+        {
+            phaseLock.Update(local, local + 1_000_000, local + spread);
+        }
+
+        Assert.Equal(ReferenceLockState.Holdover, phaseLock.State);
+        Assert.Equal(150, phaseLock.RejectedSamples);
+        Assert.Equal(local + 1_000_000, phaseLock.ToReference(local));
+
+        Assert.True(phaseLock.Update(local, local + 1_000_000, local));
+        Assert.Equal(ReferenceLockState.Locked, phaseLock.State);
+    }
+
+    [Fact]
+    public void GridSlotsAreExactForFractionalRates()
+    {
+        var cadence = new PhaseLockedCadence(new VirtualPipelineClock(), new SimulatedReferenceClock(new VirtualPipelineClock(), TimeSpan.Zero, 0), new FrameRate(30000, 1001), MaxSlewPpm);
+        foreach (var frame in new[] { 1L, 29_969L, 53_000_000_000L })
+        {
+            var start = cadence.FrameStart(frame);
+            Assert.Equal(frame, cadence.FrameAt(start));
+            Assert.Equal(frame - 1, cadence.FrameAt(start - 1));
+        }
+
+        // Every thousand and one seconds hold exactly thirty thousand frames.
+        Assert.Equal(TimeSpan.FromSeconds(1001).Ticks, cadence.FrameStart(30_000 * 7) - cadence.FrameStart(30_000 * 6));
+    }
+
+    [Theory]
+    [InlineData("system", 500d)]
+    [InlineData(" System ", 100d)]
+    public void ParseAcceptsTheSystemClock(string clock, double slew)
+    {
+        var reference = PacingReference.Parse(clock, slew);
+
+        Assert.True(reference.IsEnabled);
+        Assert.Equal(PacingReference.SystemClock, reference.Clock);
+        Assert.Equal(slew, reference.MaxSlewPpm);
+        Assert.False(PacingReference.Parse(" ").IsEnabled);
+    }
+
+    [Theory]
+    [InlineData("tai", 500d)]
+    [InlineData("ptp", 500d)]
+    [InlineData("system", 0d)]
+    [InlineData("system", 20_000d)]
+    public void ParseRejectsInvalidReferences(string clock, double slew)
+    {
+        Assert.Throws<FormatException>(() => PacingReference.Parse(clock, slew));
+    }
+}
@@ -0,0 +1,94 @@
+using System.Diagnostics;
+using Tractus.HtmlToNdi.Native;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class SendLatencyRecorderTests
+{
+    private static readonly long TicksPerMillisecond = Stopwatch.Frequency / 1000;
+
+    private static void RecordMilliseconds(SendLatencyRecorder recorder, FrameSendPath path, double milliseconds)
+    {
+        const long captured = 1_000;
+        recorder.Record(path, captured, captured + (long)(milliseconds * TicksPerMillisecond));
+    }
+
+    [Fact]
+    public void LatenciesLandInDoublingBucketsPerPath()
+    {
+        var recorder = new SendLatencyRecorder();
+        RecordMilliseconds(recorder, FrameSendPath.Buffered, 0.1);
+        RecordMilliseconds(recorder, FrameSendPath.Buffered, 0.25);
+        RecordMilliseconds(recorder, FrameSendPath.Buffered, 50);
+        RecordMilliseconds(recorder, FrameSendPath.Repeated, 10_000);
+
+        var buffered = recorder.Snapshot(FrameSendPath.Buffered);
+        Assert.Equal(3, buffered.Count);
+        Assert.Equal(2, buffered.Buckets[0]);
+        Assert.Equal(1, buffered.Buckets[8]);
+        Assert.Equal(50_350, buffered.SumMicroseconds);
+        Assert.Equal(50_000, buffered.MaxMicroseconds);
+
+        var repeated = recorder.Snapshot(FrameSendPath.Repeated);
+        Assert.Equal(1, repeated.Buckets[SendLatencyHistogram.BucketCount - 1]);
+        Assert.Equal(long.MaxValue, SendLatencyHistogram.UpperBoundMicroseconds(SendLatencyHistogram.BucketCount - 1));
+        Assert.Equal(4_096_000, SendLatencyHistogram.UpperBoundMicroseconds(SendLatencyHistogram.BucketCount - 2));
+
+        var all = recorder.Snapshot();
+        Assert.Equal(0, all.Direct.Count);
+        Assert.Equal(new[] { buffered, repeated }, all.RecordedPaths());
+        Assert.Equal(all, recorder.Snapshot());
+    }
+
+    [Fact]
+    public void FramesWithoutAUsableCaptureTimeAreNotRecorded()
+    {
+        var recorder = new SendLatencyRecorder();
+        recorder.Record(FrameSendPath.Direct, 0, 5 * TicksPerMillisecond);
+        recorder.Record(FrameSendPath.Direct, 10 * TicksPerMillisecond, 5 * TicksPerMillisecond);
+
+        Assert.Equal(0, recorder.Snapshot(FrameSendPath.Direct).Count);
+        Assert.Empty(recorder.Snapshot().RecordedPaths());
+    }
+
+    [Fact]
+    public void PercentilesInterpolateWithinTheirBucketAndStopAtTheMax()
+    {
+        var recorder = new SendLatencyRecorder();
+        for (var i = 0; i < 99; i++)
+        {
+            RecordMilliseconds(recorder, FrameSendPath.Buffered, 40);
+        }
+
+        RecordMilliseconds(recorder, FrameSendPath.Buffered, 300);
+        var histogram = recorder.Snapshot(FrameSendPath.Buffered);
+
+        // The 40 ms frames fill the 32-64 ms bucket, whose estimates stop at the 64 ms bound.
+        Assert.InRange(histogram.P50Milliseconds, 32, 64);
+        Assert.InRange(histogram.P99Milliseconds, 32, 64);
+        Assert.Equal(300, histogram.PercentileMilliseconds(1));
+        Assert.Equal(42.6, histogram.MeanMilliseconds, 3);
+        Assert.Equal(0, new SendLatencyRecorder().Snapshot(FrameSendPath.Direct).P99Milliseconds);
+    }
+
+    [Fact]
+    public void CompositorTimestampsAreConvertedFromMicroseconds()
+    {
+        // The helper stamps frames with steady_clock microseconds on the counter the Stopwatch reads.
+        var arrived = Stopwatch.GetTimestamp();
+        var microseconds = (long)(arrived / (double)Stopwatch.Frequency * 1_000_000);
+        var captured = CompositorCaptureBridge.ToStopwatchTimestamp(microseconds);
+        Assert.InRange(arrived - captured, -TicksPerMillisecond, TicksPerMillisecond);
+
+        var recorder = new SendLatencyRecorder();
+        recorder.Record(FrameSendPath.Direct, captured, arrived + (5 * TicksPerMillisecond));
+        Assert.InRange(recorder.Snapshot(FrameSendPath.Direct).MaxMicroseconds, 4_000, 6_000);
+
+        // A month of uptime does not overflow, and a missing timestamp is the time of arrival.
+        const long month = 30L * 24 * 3600 * 1_000_000;
+        Assert.Equal(30L * 24 * 3600 * Stopwatch.Frequency, CompositorCaptureBridge.ToStopwatchTimestamp(month));
+        Assert.InRange(CompositorCaptureBridge.ToStopwatchTimestamp(0), arrived, Stopwatch.GetTimestamp());
+    }
+}
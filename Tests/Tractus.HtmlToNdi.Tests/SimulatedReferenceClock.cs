@@ -0,0 +1,68 @@
+using Tractus.HtmlToNdi.Video;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+/// <summary>
+/// A reference timebase seen from one simulated machine: it runs off that machine's pipeline clock with an offset, a
+/// frequency error and read jitter, and can be stepped, as when the time service sets the clock or a leap second
+/// passes. <see cref="TrueTicksAt"/> gives the exact reference instant, so a test can measure how far each send
+/// landed from the agreed frame grid.
+/// </summary>
+internal sealed class SimulatedReferenceClock : IReferenceClock
+{
+    private static readonly long Epoch = new DateTime(2026, 1, 1, 0, 0, 0, DateTimeKind.Utc).Ticks - DateTime.UnixEpoch.Ticks;
+
+    private readonly IPipelineClock local;
+    private readonly long offsetTicks;
+    private readonly double drift;
+    private readonly TimeSpan readJitter;
+    private readonly Random random;
+    private long stepTicks;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="SimulatedReferenceClock"/> class.
+    /// </summary>
+    /// <param name="local">The machine's own clock.</param>
+    /// <param name="offset">How far the reference is ahead of the machine's clock at its origin, beyond a common epoch.</param>
+    /// <param name="driftPpm">How far the reference runs ahead of the machine's clock, in parts per million.</param>
+    /// <param name="readJitter">The standard deviation of the error of each reading.</param>
+    /// <param name="seed">Seeds the read jitter.</param>
+    public SimulatedReferenceClock(IPipelineClock local, TimeSpan offset, double driftPpm, TimeSpan readJitter = default, int seed = 1)
+    {
+        this.local = local;
+        offsetTicks = offset.Ticks;
+        drift = driftPpm * 1e-6;
+        this.readJitter = readJitter;
+        random = new Random(seed);
+    }
+
+    /// <inheritdoc />
+    public string Name => "simulated";
+
+    /// <inheritdoc />
+    public long ReadTicks()
+    {
+        var jitter = readJitter > TimeSpan.Zero ? (long)(NextGaussian() * readJitter.Ticks) : 0;
+        return TrueTicksAt(local.Elapsed) + jitter;
+    }
+
+    /// <summary>
+    /// Returns the exact reference time at a reading of the machine's clock.
+    /// </summary>
+    public long TrueTicksAt(TimeSpan localTime)
+    {
+        return Epoch + offsetTicks + Interlocked.Read(ref stepTicks) + localTime.Ticks + (long)Math.Round(localTime.Ticks * drift);
+    }
+
+    /// <summary>
+    /// Sets the reference forwards or backwards from now on.
+    /// </summary>
+    public void Step(TimeSpan by) => Interlocked.Add(ref stepTicks, by.Ticks);
+
+    private double NextGaussian()
+    {
+        var u1 = 1d - random.NextDouble();
+        var u2 = random.NextDouble();
+        return Math.Sqrt(-2d * Math.Log(u1)) * Math.Cos(2d * Math.PI * u2);
+    }
+}
@@ -0,0 +1,55 @@
+using Serilog;
+using Tractus.HtmlToNdi.Video;
+using Xunit;
+
+namespace Tractus.HtmlToNdi.Tests;
+
+public class ThreadPolicyTests
+{
+    [Theory]
+    [InlineData(null, 0UL)]
+    [InlineData("", 0UL)]
+    [InlineData("0", 0x1UL)]
+    [InlineData("2, 4-7", 0xF4UL)]
+    [InlineData("63", 0x8000000000000000UL)]
+    public void ParseAffinityBuildsMask(string? cpus, ulong expected)
+    {
+        Assert.Equal(expected, ThreadPolicy.ParseAffinity(cpus));
+    }
+
+    [Theory]
+    [InlineData("64")]
+    [InlineData("-1")]
+    [InlineData("3-1")]
+    [InlineData("1-2-3")]
+    [InlineData("cpu0")]
+    public void ParseAffinityRejectsInvalidEntries(string cpus)
+    {
+        Assert.Throws<FormatException>(() => ThreadPolicy.ParseAffinity(cpus));
+    }
+
+    [Fact]
+    public void FormatAffinityRoundTrips()
+    {
+        const ulong mask = 0xF5UL | (1UL << 40);
+
+        var cpus = ThreadPolicy.FormatAffinity(mask);
+
+        Assert.Equal("0,2,4-7,40", cpus);
+        Assert.Equal(mask, ThreadPolicy.ParseAffinity(cpus));
+    }
+
+    [Fact]
+    public void DefaultPolicyLeavesTheThreadUntouched()
+    {
+        var priority = Thread.CurrentThread.Priority;
+
+        using (var scope = ThreadPolicyScope.Apply(ThreadPolicy.Default, "Test", new LoggerConfiguration().CreateLogger()))
+        {
+            Assert.Equal(ThreadPriorityClass.Normal, scope.Granted);
+        }
+
+        Assert.True(ThreadPolicy.Default.IsDefault);
+        Assert.Equal(priority, Thread.CurrentThread.Priority);
+    }
+}
@@ -0,0 +1,18 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Identifies how alpha is represented in the frames sent to NDI.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorAlphaMode</c> in the native helper.</remarks>
+public enum AlphaMode
+{
+    /// <summary>
+    /// Frames are sent as Chromium composes them, with colour already multiplied by alpha.
+    /// </summary>
+    Premultiplied = 0,
+
+    /// <summary>
+    /// Colour is divided back out by alpha so receivers that expect straight alpha key without dark fringes.
+    /// </summary>
+    Straight = 1,
+}
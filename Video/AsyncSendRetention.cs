@@ -0,0 +1,100 @@
+using NewTek;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Owns the frame an asynchronous NDI send may still be reading. NDI reads the buffer handed to
+/// <c>send_send_video_async_v2</c> until the next asynchronous send returns, or until a flush, so the retention keeps
+/// the frame of the last send and releases it exactly then: at most two frames are held, the one being sent and the
+/// one before it. Each frame is held by a send reference, so the pipeline may replace or dispose it as usual and its
+/// buffer is freed by the release instead. Only <see cref="NdiVideoFrame"/>s are retained: a captured frame's buffer
+/// belongs to Chromium or the native helper and is rewritten by the next capture, so direct sends copy it first.
+/// Sends and flushes may come from any thread and are made one at a time, as NDI requires of asynchronous sends.
+/// </summary>
+internal sealed class AsyncSendRetention
+{
+    private readonly INdiVideoSender sender;
+    private readonly object gate = new();
+    private NdiVideoFrame? retainedFrame;
+    private long flushes;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="AsyncSendRetention"/> class.
+    /// </summary>
+    /// <param name="sender">The asynchronous sender whose in-flight frame is retained.</param>
+    public AsyncSendRetention(INdiVideoSender sender)
+    {
+        this.sender = sender ?? throw new ArgumentNullException(nameof(sender));
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether a frame is held for NDI now.
+    /// </summary>
+    public bool IsRetaining
+    {
+        get
+        {
+            lock (gate)
+            {
+                return retainedFrame is not null;
+            }
+        }
+    }
+
+    /// <summary>
+    /// Gets the flushes that released a retained frame.
+    /// </summary>
+    public long Flushes => Interlocked.Read(ref flushes);
+
+    /// <summary>
+    /// Sends a frame and holds a send reference on it until the next send or flush returns.
+    /// </summary>
+    /// <param name="frame">The frame whose buffer <paramref name="ndiFrame"/> points at.</param>
+    /// <param name="ndiFrame">The NDI descriptor to send.</param>
+    public void Send(NdiVideoFrame frame, ref NDIlib.video_frame_v2_t ndiFrame)
+    {
+        ArgumentNullException.ThrowIfNull(frame);
+        lock (gate)
+        {
+            // Taken before the send, so a repeat of the retained frame keeps it alive across its own release.
+            frame.AcquireSendReference();
+            try
+            {
+                sender.Send(ref ndiFrame);
+            }
+            catch
+            {
+                frame.ReleaseSendReference();
+                throw;
+            }
+
+            ReleaseRetained();
+            retainedFrame = frame;
+        }
+    }
+
+    /// <summary>
+    /// Waits for NDI to finish with the retained frame, then releases it. Called when the pipeline stops, before
+    /// the NDI sender is destroyed.
+    /// </summary>
+    public void Flush()
+    {
+        lock (gate)
+        {
+            if (retainedFrame is null)
+            {
+                return;
+            }
+
+            sender.Flush();
+            ReleaseRetained();
+            Interlocked.Increment(ref flushes);
+        }
+    }
+
+    private void ReleaseRetained()
+    {
+        retainedFrame?.ReleaseSendReference();
+        retainedFrame = null;
+    }
+}
@@ -0,0 +1,218 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Why a <see cref="BufferDepthTuner"/> changed the depth.
+/// </summary>
+internal enum BufferDepthChangeReason
+{
+    /// <summary>
+    /// The buffer ran dry more often than the target allows.
+    /// </summary>
+    Starved,
+
+    /// <summary>
+    /// Recent capture gaps are longer than the current depth can absorb.
+    /// </summary>
+    CaptureGaps,
+
+    /// <summary>
+    /// Capture has been steady long enough for a shallower buffer to meet the target.
+    /// </summary>
+    Settled,
+}
+
+/// <summary>
+/// A depth change made by a <see cref="BufferDepthTuner"/>.
+/// </summary>
+/// <param name="PreviousDepth">The depth before the change.</param>
+/// <param name="Depth">The depth after the change.</param>
+/// <param name="Reason">Why the depth changed.</param>
+/// <param name="RequiredDepth">The depth the capture gaps alone call for.</param>
+/// <param name="StarvedProbability">The recent share of output frames sent without a fresh frame.</param>
+internal readonly record struct BufferDepthDecision(
+    int PreviousDepth,
+    int Depth,
+    BufferDepthChangeReason Reason,
+    int RequiredDepth,
+    double StarvedProbability);
+
+/// <summary>
+/// Chooses the paced buffer's depth from how capture actually behaves. A gap of <c>g</c> frame intervals between
+/// captures empties a buffer of depth <c>d</c> when <c>g &gt; d</c>, so the tuner keeps a decaying histogram of
+/// capture intervals and picks the shallowest depth whose share of longer gaps is within the target. Ticks sent
+/// without a fresh frame are the ground truth: when they exceed the target the depth grows whatever the histogram
+/// says. The depth moves one frame per evaluation, so the pacer absorbs each change by stretching or trimming a
+/// frame rather than rewarming, and it only shrinks after a hold period without starvation. Called from the paced
+/// sender's thread only.
+/// </summary>
+internal sealed class BufferDepthTuner
+{
+    /// <summary>
+    /// Histogram resolution: buckets per frame interval.
+    /// </summary>
+    internal const int BucketsPerFrame = 8;
+
+    /// <summary>
+    /// Histogram size; longer intervals land in the last bucket.
+    /// </summary>
+    internal const int HistogramBuckets = BucketsPerFrame * 64;
+
+    /// <summary>
+    /// How often the pacer calls <see cref="Evaluate"/>.
+    /// </summary>
+    internal static readonly TimeSpan EvaluationInterval = TimeSpan.FromSeconds(1);
+
+    // Evaluations are a second apart: history halves every two minutes, and shrinking waits thirty seconds after any
+    // change or starved tick.
+    private static readonly double Decay = Math.Pow(0.5, 1d / 120d);
+    private const int HoldEvaluations = 30;
+
+    private readonly BufferDepthTuning tuning;
+    private readonly int minDepth;
+    private readonly int maxDepth;
+    private readonly double[] intervals = new double[HistogramBuckets];
+    private double starvedTicks;
+    private double outputTicks;
+    private long lastRepeatedFrames = -1;
+    private long lastOutputTicks;
+    private int evaluationsSinceChange;
+    private int evaluationsSinceStarved;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="BufferDepthTuner"/> class.
+    /// </summary>
+    /// <param name="tuning">The depth range and underrun target.</param>
+    /// <param name="initialDepth">The depth to start from; clamped to the range.</param>
+    /// <param name="depthCeiling">A lower maximum than the tuning's, such as the frame-memory budget allows.</param>
+    public BufferDepthTuner(BufferDepthTuning tuning, int initialDepth, int depthCeiling)
+    {
+        this.tuning = tuning ?? throw new ArgumentNullException(nameof(tuning));
+        maxDepth = Math.Max(1, Math.Min(tuning.MaxDepth, depthCeiling));
+        minDepth = Math.Clamp(tuning.MinDepth, 1, maxDepth);
+        Depth = Math.Clamp(initialDepth, minDepth, maxDepth);
+    }
+
+    /// <summary>
+    /// Gets the depth the buffer should have.
+    /// </summary>
+    public int Depth { get; private set; }
+
+    /// <summary>
+    /// Gets the shallowest depth the tuner may choose.
+    /// </summary>
+    public int MinDepth => minDepth;
+
+    /// <summary>
+    /// Gets the deepest depth the tuner may choose.
+    /// </summary>
+    public int MaxDepth => maxDepth;
+
+    /// <summary>
+    /// Gets the number of depth changes made.
+    /// </summary>
+    public long Changes { get; private set; }
+
+    /// <summary>
+    /// Gets the most recent depth change, if any.
+    /// </summary>
+    public BufferDepthDecision? LastDecision { get; private set; }
+
+    /// <summary>
+    /// Returns the histogram bucket of a capture interval.
+    /// </summary>
+    /// <param name="intervalFrames">The interval, in frame intervals.</param>
+    /// <returns>The bucket index.</returns>
+    public static int BucketOf(double intervalFrames)
+    {
+        if (!(intervalFrames > 0))
+        {
+            return 0;
+        }
+
+        return (int)Math.Min(HistogramBuckets - 1, intervalFrames * BucketsPerFrame);
+    }
+
+    /// <summary>
+    /// Folds in the capture intervals and output ticks since the last call, and moves the depth one frame when
+    /// they call for it.
+    /// </summary>
+    /// <param name="newIntervals">Capture intervals since the last call, bucketed by <see cref="BucketOf"/>.</param>
+    /// <param name="repeatedFrames">The pipeline's running count of frames repeated because none was ready.</param>
+    /// <param name="sentTicks">The pipeline's running count of output ticks, fresh and repeated.</param>
+    /// <returns>The change made, or <c>null</c> when the depth stays.</returns>
+    public BufferDepthDecision? Evaluate(ReadOnlySpan<long> newIntervals, long repeatedFrames, long sentTicks)
+    {
+        var samples = 0d;
+        var count = Math.Min(newIntervals.Length, intervals.Length);
+        for (var i = 0; i < intervals.Length; i++)
+        {
+            intervals[i] = (intervals[i] * Decay) + (i < count ? newIntervals[i] : 0);
+            samples += intervals[i];
+        }
+
+        // The first call only sets the baseline, and a pipeline reset restarts the counters.
+        var starved = lastRepeatedFrames < 0 ? 0 : Math.Max(0, repeatedFrames - lastRepeatedFrames);
+        var ticks = lastRepeatedFrames < 0 ? 0 : Math.Max(0, sentTicks - lastOutputTicks);
+        lastRepeatedFrames = repeatedFrames;
+        lastOutputTicks = sentTicks;
+        starvedTicks = (starvedTicks * Decay) + starved;
+        outputTicks = (outputTicks * Decay) + ticks;
+        var starvedProbability = outputTicks > 0 ? starvedTicks / outputTicks : 0;
+
+        evaluationsSinceChange++;
+        evaluationsSinceStarved = starved > 0 ? 0 : evaluationsSinceStarved + 1;
+
+        var required = RequiredDepth(samples);
+        var depth = Depth;
+        BufferDepthChangeReason reason;
+        if (starved > 0 && starvedProbability > tuning.TargetUnderrunProbability && depth < maxDepth)
+        {
+            depth++;
+            reason = BufferDepthChangeReason.Starved;
+        }
+        else if (required > depth)
+        {
+            depth++;
+            reason = BufferDepthChangeReason.CaptureGaps;
+        }
+        else if (required < depth && evaluationsSinceChange > HoldEvaluations && evaluationsSinceStarved > HoldEvaluations)
+        {
+            depth--;
+            reason = BufferDepthChangeReason.Settled;
+        }
+        else
+        {
+            return null;
+        }
+
+        var decision = new BufferDepthDecision(Depth, depth, reason, required, starvedProbability);
+        Depth = depth;
+        Changes++;
+        evaluationsSinceChange = 0;
+        LastDecision = decision;
+        return decision;
+    }
+
+    private int RequiredDepth(double samples)
+    {
+        // Walk down from the longest gaps: depth d is enough when the gaps longer than d frames are within the target.
+        // The bucket starting at d itself holds on-time intervals when d is one, so it never counts against d.
+        var allowance = tuning.TargetUnderrunProbability * samples;
+        var longer = 0d;
+        var bucket = HistogramBuckets - 1;
+        for (var depth = maxDepth; depth >= minDepth; depth--)
+        {
+            for (; bucket > depth * BucketsPerFrame; bucket--)
+            {
+                longer += intervals[bucket];
+            }
+
+            if (longer > allowance)
+            {
+                return Math.Min(maxDepth, depth + 1);
+            }
+        }
+
+        return minDepth;
+    }
+}
@@ -0,0 +1,69 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Lets the paced sender choose its own buffer depth: the shallowest depth between <paramref name="MinDepth"/> and
+/// <paramref name="MaxDepth"/> at which the buffer runs dry on no more than
+/// <paramref name="TargetUnderrunProbability"/> of output frames.
+/// </summary>
+/// <param name="MinDepth">The shallowest depth the tuner may choose.</param>
+/// <param name="MaxDepth">The deepest depth the tuner may choose; zero disables tuning.</param>
+/// <param name="TargetUnderrunProbability">The accepted share of output frames sent without a fresh frame.</param>
+public sealed record BufferDepthTuning(int MinDepth, int MaxDepth, double TargetUnderrunProbability)
+{
+    /// <summary>
+    /// The target used when none is given: about one repeated frame every three minutes at 60 fps.
+    /// </summary>
+    public const double DefaultTargetUnderrunProbability = 1e-4;
+
+    /// <summary>
+    /// Gets settings that keep the configured depth.
+    /// </summary>
+    public static BufferDepthTuning Disabled { get; } = new(0, 0, DefaultTargetUnderrunProbability);
+
+    /// <summary>
+    /// Gets a value indicating whether the depth is tuned.
+    /// </summary>
+    public bool IsEnabled => MaxDepth > 0;
+
+    /// <summary>
+    /// Parses a depth range such as <c>1-8</c>, or a single maximum such as <c>8</c>, which starts the range at one.
+    /// </summary>
+    /// <param name="range">The range, or null or whitespace for <see cref="Disabled"/>.</param>
+    /// <param name="targetUnderrunProbability">The accepted share of output frames sent without a fresh frame.</param>
+    /// <returns>The parsed settings.</returns>
+    /// <exception cref="FormatException">Thrown when the range or the target is out of bounds.</exception>
+    public static BufferDepthTuning Parse(string? range, double targetUnderrunProbability = DefaultTargetUnderrunProbability)
+    {
+        if (string.IsNullOrWhiteSpace(range))
+        {
+            return Disabled;
+        }
+
+        var bounds = range.Split('-', StringSplitOptions.TrimEntries);
+        if (bounds.Length is < 1 or > 2 ||
+            !int.TryParse(bounds[^1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var maxDepth))
+        {
+            throw new FormatException($"Buffer depth range '{range}' must be <min>-<max> or <max>.");
+        }
+
+        var minDepth = 1;
+        if (bounds.Length == 2 && !int.TryParse(bounds[0], NumberStyles.Integer, CultureInfo.InvariantCulture, out minDepth))
+        {
+            throw new FormatException($"Buffer depth range '{range}' must be <min>-<max> or <max>.");
+        }
+
+        if (minDepth < 1 || maxDepth < minDepth)
+        {
+            throw new FormatException($"Buffer depth range '{range}' needs 1 <= min <= max.");
+        }
+
+        if (!(targetUnderrunProbability > 0 && targetUnderrunProbability < 1))
+        {
+            throw new FormatException("The target underrun probability must be between 0 and 1, exclusive.");
+        }
+
+        return new BufferDepthTuning(minDepth, maxDepth, targetUnderrunProbability);
+    }
+}
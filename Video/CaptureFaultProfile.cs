@@ -0,0 +1,156 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Disturbances the native helper's fallback capture loop adds to its cadence, so the paced buffer's recovery paths
+/// (warm-up, latency expansion, resync drops) can be exercised on any machine. The same profile drives
+/// <c>PacingSimulation</c> in the tests, so a simulated run can be repeated against the real pipeline.
+/// </summary>
+/// <param name="Seed">Seeds every random choice; the same seed replays the same faults.</param>
+/// <param name="Jitter">The standard deviation of how late each frame is delivered after it is due.</param>
+/// <param name="BurstPeriod">Every this many frames a burst begins; zero disables bursts.</param>
+/// <param name="BurstLength">Frames held back at the start of each burst period and delivered back to back.</param>
+/// <param name="StallProbability">The chance, per frame, that the page renders nothing for a while.</param>
+/// <param name="MinStall">The shortest stall.</param>
+/// <param name="MaxStall">The longest stall.</param>
+/// <param name="DriftPpm">How far the page's clock runs ahead of the output rate, in parts per million; negative runs slow.</param>
+/// <param name="PreemptionProbability">The chance, per frame, that the capture thread is kept off the CPU after delivering it.</param>
+/// <param name="Preemption">How long a preempted capture thread stays off the CPU.</param>
+public sealed record CaptureFaultProfile(
+    ulong Seed,
+    TimeSpan Jitter,
+    int BurstPeriod,
+    int BurstLength,
+    double StallProbability,
+    TimeSpan MinStall,
+    TimeSpan MaxStall,
+    double DriftPpm,
+    double PreemptionProbability,
+    TimeSpan Preemption)
+{
+    /// <summary>
+    /// Gets a profile that injects nothing.
+    /// </summary>
+    public static CaptureFaultProfile None { get; } = new(1, TimeSpan.Zero, 0, 0, 0, TimeSpan.Zero, TimeSpan.Zero, 0, 0, TimeSpan.Zero);
+
+    /// <summary>
+    /// Gets a value indicating whether the profile injects anything.
+    /// </summary>
+    public bool IsEnabled =>
+        Jitter > TimeSpan.Zero ||
+        (BurstPeriod > 0 && BurstLength > 1) ||
+        (StallProbability > 0 && MaxStall > TimeSpan.Zero) ||
+        DriftPpm != 0 ||
+        (PreemptionProbability > 0 && Preemption > TimeSpan.Zero);
+
+    /// <summary>
+    /// Parses a fault list such as <c>jitter=3,burst=120x4,stall=0.002:50-250,drift=-200,preempt=0.01:8,seed=7</c>.
+    /// </summary>
+    /// <param name="text">
+    /// Comma-separated entries, durations in milliseconds: <c>jitter=&lt;ms&gt;</c>,
+    /// <c>burst=&lt;period&gt;x&lt;length&gt;</c>, <c>stall=&lt;probability&gt;:&lt;min&gt;-&lt;max&gt;</c>,
+    /// <c>drift=&lt;ppm&gt;</c>, <c>preempt=&lt;probability&gt;:&lt;ms&gt;</c> and <c>seed=&lt;n&gt;</c>. Null or whitespace
+    /// yields <see cref="None"/>.
+    /// </param>
+    /// <returns>The parsed profile.</returns>
+    /// <exception cref="FormatException">Thrown when an entry is unknown or its value is out of range.</exception>
+    public static CaptureFaultProfile Parse(string? text)
+    {
+        if (string.IsNullOrWhiteSpace(text))
+        {
+            return None;
+        }
+
+        var profile = None;
+        foreach (var entry in text.Split(',', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries))
+        {
+            var parts = entry.Split('=', 2, StringSplitOptions.TrimEntries);
+            var value = parts.Length == 2 ? parts[1] : string.Empty;
+            switch (parts[0].ToLowerInvariant())
+            {
+                case "jitter":
+                    profile = profile with { Jitter = ParseMilliseconds(entry, value) };
+                    break;
+                case "burst":
+                    var burst = value.Split('x', StringSplitOptions.TrimEntries);
+                    if (burst.Length != 2 ||
+                        !int.TryParse(burst[0], NumberStyles.Integer, CultureInfo.InvariantCulture, out var period) ||
+                        !int.TryParse(burst[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var length) ||
+                        length < 2 || period < length)
+                    {
+                        throw new FormatException($"Fault '{entry}' must be burst=<period>x<length> with 2 <= length <= period.");
+                    }
+
+                    profile = profile with { BurstPeriod = period, BurstLength = length };
+                    break;
+                case "stall":
+                    var stall = value.Split(':', StringSplitOptions.TrimEntries);
+                    var bounds = stall.Length == 2 ? stall[1].Split('-', StringSplitOptions.TrimEntries) : Array.Empty<string>();
+                    if (stall.Length != 2 || bounds.Length is < 1 or > 2)
+                    {
+                        throw new FormatException($"Fault '{entry}' must be stall=<probability>:<min ms>-<max ms>.");
+                    }
+
+                    var minStall = ParseMilliseconds(entry, bounds[0]);
+                    var maxStall = ParseMilliseconds(entry, bounds[^1]);
+                    if (maxStall < minStall)
+                    {
+                        throw new FormatException($"Fault '{entry}' has a maximum stall shorter than its minimum.");
+                    }
+
+                    profile = profile with { StallProbability = ParseProbability(entry, stall[0]), MinStall = minStall, MaxStall = maxStall };
+                    break;
+                case "drift":
+                    if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var drift) || Math.Abs(drift) > 500_000)
+                    {
+                        throw new FormatException($"Fault '{entry}' must be drift=<ppm> between -500000 and 500000.");
+                    }
+
+                    profile = profile with { DriftPpm = drift };
+                    break;
+                case "preempt":
+                    var preempt = value.Split(':', StringSplitOptions.TrimEntries);
+                    if (preempt.Length != 2)
+                    {
+                        throw new FormatException($"Fault '{entry}' must be preempt=<probability>:<ms>.");
+                    }
+
+                    profile = profile with { PreemptionProbability = ParseProbability(entry, preempt[0]), Preemption = ParseMilliseconds(entry, preempt[1]) };
+                    break;
+                case "seed":
+                    if (!ulong.TryParse(value, NumberStyles.Integer, CultureInfo.InvariantCulture, out var seed))
+                    {
+                        throw new FormatException($"Fault '{entry}' must be seed=<non-negative integer>.");
+                    }
+
+                    profile = profile with { Seed = seed };
+                    break;
+                default:
+                    throw new FormatException($"Unknown fault '{entry}' (expected jitter, burst, stall, drift, preempt or seed).");
+            }
+        }
+
+        return profile;
+    }
+
+    private static TimeSpan ParseMilliseconds(string entry, string value)
+    {
+        if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var milliseconds) || milliseconds < 0 || milliseconds > 60_000)
+        {
+            throw new FormatException($"Fault '{entry}' needs durations in milliseconds between 0 and 60000.");
+        }
+
+        return TimeSpan.FromMilliseconds(milliseconds);
+    }
+
+    private static double ParseProbability(string entry, string value)
+    {
+        if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var probability) || probability is < 0 or > 1)
+        {
+            throw new FormatException($"Fault '{entry}' needs a probability between 0 and 1.");
+        }
+
+        return probability;
+    }
+}
@@ -0,0 +1,85 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Describes a page rendered in its own browser and blended above the main page by the native layer compositor.
+/// </summary>
+/// <param name="Url">The page to load.</param>
+/// <param name="DelayFrames">How many of its own frames the layer is held back to line up with slower layers.</param>
+public sealed record CompositorLayer(string Url, int DelayFrames);
+
+/// <summary>
+/// The pages stacked above the main page, bottom to top, together with the alignment delay of the main page itself.
+/// </summary>
+/// <param name="BaseDelayFrames">Frames the main page is held back by.</param>
+/// <param name="Layers">The pages above the main page, bottom to top.</param>
+public sealed record CompositorLayerStack(int BaseDelayFrames, IReadOnlyList<CompositorLayer> Layers)
+{
+    /// <summary>
+    /// The native compositor blends at most this many layers, including the main page.
+    /// </summary>
+    public const int MaxLayers = 8;
+
+    /// <summary>
+    /// Gets a stack with no extra layers.
+    /// </summary>
+    public static CompositorLayerStack Empty { get; } = new(0, Array.Empty<CompositorLayer>());
+
+    /// <summary>
+    /// Gets a value indicating whether any page is stacked above the main page.
+    /// </summary>
+    public bool HasLayers => Layers.Count > 0;
+
+    /// <summary>
+    /// Parses the layer URLs and alignment delays.
+    /// </summary>
+    /// <param name="urls">A <c>|</c>-separated list of absolute URLs, bottom to top. Null or whitespace yields <see cref="Empty"/>.</param>
+    /// <param name="delays">An optional comma-separated list of frame delays: the main page first, then each layer. Missing entries are zero.</param>
+    /// <returns>The parsed stack.</returns>
+    /// <exception cref="FormatException">Thrown when a URL or delay is invalid or there are too many layers.</exception>
+    public static CompositorLayerStack Parse(string? urls, string? delays)
+    {
+        var urlList = string.IsNullOrWhiteSpace(urls)
+            ? Array.Empty<string>()
+            : urls.Split('|', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries);
+        if (urlList.Length + 1 > MaxLayers)
+        {
+            throw new FormatException($"At most {MaxLayers - 1} layers can be stacked above the main page.");
+        }
+
+        foreach (var url in urlList)
+        {
+            if (!Uri.TryCreate(url, UriKind.Absolute, out _))
+            {
+                throw new FormatException($"Layer URL '{url}' is not an absolute URL.");
+            }
+        }
+
+        var delayList = new int[urlList.Length + 1];
+        if (!string.IsNullOrWhiteSpace(delays))
+        {
+            var entries = delays.Split(',', StringSplitOptions.TrimEntries);
+            if (entries.Length > delayList.Length)
+            {
+                throw new FormatException($"{entries.Length} layer delays were given for {delayList.Length} layers (the main page counts as the first).");
+            }
+
+            for (var index = 0; index < entries.Length; index++)
+            {
+                if (!int.TryParse(entries[index], NumberStyles.Integer, CultureInfo.InvariantCulture, out delayList[index]) || delayList[index] < 0 || delayList[index] > 30)
+                {
+                    throw new FormatException($"Layer delay '{entries[index]}' must be a whole number of frames between 0 and 30.");
+                }
+            }
+        }
+
+        if (urlList.Length == 0)
+        {
+            return delayList[0] == 0 ? Empty : new CompositorLayerStack(delayList[0], Array.Empty<CompositorLayer>());
+        }
+
+        var layers = urlList.Select((url, index) => new CompositorLayer(url, delayList[index + 1])).ToList();
+        return new CompositorLayerStack(delayList[0], layers);
+    }
+}
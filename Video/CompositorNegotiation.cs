@@ -0,0 +1,122 @@
+using Serilog;
+using Tractus.HtmlToNdi.Models;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Fits the requested compositor capture options to what the loaded native helper reports it can do, so
+/// unsupported settings degrade at start-up with a warning instead of failing when a session starts.
+/// </summary>
+internal static class CompositorNegotiation
+{
+    /// <summary>
+    /// Returns <paramref name="options"/> adjusted to the helper's capabilities.
+    /// </summary>
+    /// <param name="options">The requested pipeline options.</param>
+    /// <param name="capabilities">The helper's capabilities, or <c>null</c> when it could not be queried.</param>
+    /// <param name="logger">The logger that receives a warning for every downgrade.</param>
+    /// <returns>The options to run with; the same instance when nothing had to change.</returns>
+    public static NdiVideoPipelineOptions Negotiate(NdiVideoPipelineOptions options, CompositorCapabilities? capabilities, ILogger logger)
+    {
+        if (!options.EnableCompositorCapture)
+        {
+            return options;
+        }
+
+        if (capabilities is null)
+        {
+            logger.Warning("Compositor capture helper did not report its capabilities; falling back to paint capture");
+            return options with { EnableCompositorCapture = false };
+        }
+
+        var negotiated = options;
+        if (!capabilities.PixelFormats.HasFlag(CompositorPixelFormats.Bgra8))
+        {
+            logger.Warning("Compositor capture helper cannot deliver BGRA frames; falling back to paint capture");
+            return options with { EnableCompositorCapture = false };
+        }
+
+        if (negotiated.SupersampleFactor > 1 && (!capabilities.Supports(CompositorFeatures.Supersampling) || negotiated.SupersampleFactor > capabilities.MaxSupersampleFactor))
+        {
+            var factor = capabilities.Supports(CompositorFeatures.Supersampling) ? Math.Max(1, capabilities.MaxSupersampleFactor) : 1;
+            logger.Warning("Supersampling at {Requested}x is not supported by the helper; using {Factor}x", negotiated.SupersampleFactor, factor);
+            negotiated = negotiated with { SupersampleFactor = factor };
+        }
+
+        if (negotiated.SupersampleFactor > 1 && negotiated.SupersampleFilter == SupersampleFilter.Lanczos3 && capabilities.CompiledSimdLevel == CompositorSimdLevel.Scalar)
+        {
+            // Without vector kernels the Lanczos3 resolve is several times the cost of the box filter.
+            logger.Warning("Helper kernels are scalar on this build; resolving supersampled frames with the box filter");
+            negotiated = negotiated with { SupersampleFilter = SupersampleFilter.Box };
+        }
+
+        if (negotiated.SourceFrameRate is not null && !capabilities.Supports(CompositorFeatures.RateConversion))
+        {
+            logger.Warning("Frame rate conversion is not supported by the helper; the page renders at the output rate");
+            negotiated = negotiated with { SourceFrameRate = null };
+        }
+
+        if (negotiated.FrameRateConversion == FrameRateConversion.Blend && !capabilities.Supports(CompositorFeatures.FrameBlending))
+        {
+            logger.Warning("Blended frame rate conversion is not supported by the helper; using drop/repeat");
+            negotiated = negotiated with { FrameRateConversion = FrameRateConversion.DropRepeat };
+        }
+
+        if (negotiated.Interlaced && !capabilities.Supports(CompositorFeatures.Interlacing))
+        {
+            logger.Warning("Interlaced output is not supported by the helper; sending progressive frames");
+            negotiated = negotiated with { Interlaced = false, InterlaceFlickerFilter = false };
+        }
+
+        if (negotiated.AlphaMode == AlphaMode.Straight && !capabilities.Supports(CompositorFeatures.StraightAlpha))
+        {
+            logger.Warning("Straight alpha is not supported by the helper; frames are sent premultiplied");
+            negotiated = negotiated with { AlphaMode = AlphaMode.Premultiplied };
+        }
+
+        if (!negotiated.ThreadPolicy.IsDefault && !capabilities.Supports(CompositorFeatures.ThreadPolicy))
+        {
+            // The paced sender still applies the policy itself; only the helper's own threads run without it.
+            logger.Warning("The helper does not apply thread policies; its capture threads keep their default scheduling");
+        }
+
+        if (negotiated.FrameMemory != FrameMemoryOptions.None && !capabilities.Supports(CompositorFeatures.MemoryFlags))
+        {
+            logger.Warning("The helper does not support frame memory options; its frame pools use ordinary pages");
+            negotiated = negotiated with { FrameMemory = FrameMemoryOptions.None };
+        }
+        else
+        {
+            if (negotiated.FrameMemory.HasFlag(FrameMemoryOptions.LargePages) && capabilities.LargePageBytes == 0)
+            {
+                // Kept: the helper falls back per allocation, and the privilege may be granted before the next start.
+                logger.Warning("Large pages are unavailable (on Windows grant 'Lock pages in memory'); frame pools use ordinary pages");
+            }
+
+            if (negotiated.FrameMemory.HasFlag(FrameMemoryOptions.NumaLocal) && negotiated.ThreadPolicy.AffinityMask == 0)
+            {
+                logger.Warning("NUMA-local frame pools follow the thread affinity, which is not set; leaving placement to the OS");
+            }
+        }
+
+        if (negotiated.CaptureFaults.IsEnabled && !capabilities.Supports(CompositorFeatures.CaptureFaults))
+        {
+            logger.Warning("The helper does not inject capture faults (it does not run its fallback capture loop); frames arrive undisturbed");
+            negotiated = negotiated with { CaptureFaults = CaptureFaultProfile.None };
+        }
+
+        if (negotiated.Layers.HasLayers && !capabilities.Supports(CompositorFeatures.Layers))
+        {
+            logger.Warning("Layer compositing is not supported by the helper; publishing the main page only");
+            negotiated = negotiated with { Layers = CompositorLayerStack.Empty };
+        }
+        else if (negotiated.Layers.HasLayers && negotiated.Layers.Layers.Count + 1 > capabilities.MaxLayers)
+        {
+            var kept = Math.Max(0, capabilities.MaxLayers - 1);
+            logger.Warning("The helper blends at most {MaxLayers} layers; dropping the top {Dropped}", capabilities.MaxLayers, negotiated.Layers.Layers.Count - kept);
+            negotiated = negotiated with { Layers = negotiated.Layers with { Layers = negotiated.Layers.Layers.Take(kept).ToList() } };
+        }
+
+        return negotiated;
+    }
+}
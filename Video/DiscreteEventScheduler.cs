@@ -0,0 +1,59 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Runs timed actions in time order against a <see cref="VirtualPipelineClock"/>, advancing the clock to each one, so
+/// a simulation can interleave capture arrivals with the paced sender's own deadlines without real waiting. Actions
+/// due at the same time run in the order they were scheduled.
+/// </summary>
+internal sealed class DiscreteEventScheduler
+{
+    private readonly PriorityQueue<Action, (long Ticks, long Sequence)> events = new();
+    private long nextSequence;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="DiscreteEventScheduler"/> class.
+    /// </summary>
+    /// <param name="clock">The clock the actions run on.</param>
+    public DiscreteEventScheduler(VirtualPipelineClock clock)
+    {
+        Clock = clock ?? throw new ArgumentNullException(nameof(clock));
+    }
+
+    /// <summary>
+    /// Gets the clock the actions run on.
+    /// </summary>
+    public VirtualPipelineClock Clock { get; }
+
+    /// <summary>
+    /// Gets the actions still waiting to run.
+    /// </summary>
+    public int Pending => events.Count;
+
+    /// <summary>
+    /// Schedules <paramref name="action"/> to run when the clock reaches <paramref name="at"/>; a time in the past runs
+    /// it at the current time.
+    /// </summary>
+    /// <param name="at">The time to run at.</param>
+    /// <param name="action">The action, which may schedule further actions.</param>
+    public void Schedule(TimeSpan at, Action action)
+    {
+        ArgumentNullException.ThrowIfNull(action);
+        events.Enqueue(action, (Math.Max(at.Ticks, Clock.Elapsed.Ticks), nextSequence++));
+    }
+
+    /// <summary>
+    /// Runs every action due up to <paramref name="end"/>, then leaves the clock at <paramref name="end"/>.
+    /// </summary>
+    /// <param name="end">The time to run to.</param>
+    public void RunUntil(TimeSpan end)
+    {
+        while (events.TryPeek(out _, out var due) && due.Ticks <= end.Ticks)
+        {
+            var action = events.Dequeue();
+            Clock.AdvanceTo(TimeSpan.FromTicks(due.Ticks));
+            action();
+        }
+
+        Clock.AdvanceTo(end);
+    }
+}
@@ -0,0 +1,113 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Decides, frame by frame, whether a frame goes to NDI under <see cref="IdleOutput"/>. A frame whose digest differs
+/// from the previous one is always sent and ends idle mode. A repeat is counted; once the content has been unchanged
+/// for <see cref="IdleOutput.After"/> the gate goes idle and passes only one repeat per
+/// <see cref="IdleOutput.Interval"/>, counting the rest as suppressed along with the bytes NDI was spared. Only the
+/// sending thread calls <see cref="ShouldSend"/>; <see cref="GetMetrics"/> may be called from any thread.
+/// </summary>
+internal sealed class DuplicateFrameGate
+{
+    private readonly IdleOutput settings;
+    private readonly long afterTicks;
+    private readonly long intervalTicks;
+    private FrameContentHash? lastHash;
+    private long unchangedSince;
+    private long lastPassed;
+    private bool idle;
+    private long duplicateFrames;
+    private long suppressedFrames;
+    private long suppressedBytes;
+    private long idleEntries;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="DuplicateFrameGate"/> class.
+    /// </summary>
+    /// <param name="settings">The idle settings; <see cref="IdleOutput.DetectDuplicates"/> must be set.</param>
+    /// <param name="ticksPerSecond">The frequency of the timestamps passed to <see cref="ShouldSend"/>.</param>
+    public DuplicateFrameGate(IdleOutput settings, long ticksPerSecond)
+    {
+        this.settings = settings ?? throw new ArgumentNullException(nameof(settings));
+        afterTicks = (long)(settings.After.TotalSeconds * ticksPerSecond);
+        intervalTicks = settings.Interval is { } interval ? Math.Max(1, (long)(interval.TotalSeconds * ticksPerSecond)) : 0;
+    }
+
+    /// <summary>
+    /// Gets a value indicating whether the content is static and sent at the idle rate.
+    /// </summary>
+    public bool IsIdle => Volatile.Read(ref idle);
+
+    /// <summary>
+    /// Records a frame about to be sent and decides whether to send it.
+    /// </summary>
+    /// <param name="hash">The frame's digest, or <c>null</c> when it was not hashed, which counts as a change.</param>
+    /// <param name="timestamp">When the frame is sent, on the pipeline clock.</param>
+    /// <param name="bytes">The bytes the frame would hand to NDI.</param>
+    /// <returns><c>true</c> to send the frame; <c>false</c> to skip it.</returns>
+    public bool ShouldSend(FrameContentHash? hash, long timestamp, long bytes)
+    {
+        if (hash is null || hash != lastHash)
+        {
+            lastHash = hash;
+            unchangedSince = timestamp;
+            lastPassed = timestamp;
+            Volatile.Write(ref idle, false);
+            return true;
+        }
+
+        Volatile.Write(ref duplicateFrames, duplicateFrames + 1);
+        if (!settings.LowersRate)
+        {
+            return true;
+        }
+
+        if (!idle)
+        {
+            if (timestamp - unchangedSince < afterTicks)
+            {
+                lastPassed = timestamp;
+                return true;
+            }
+
+            Volatile.Write(ref idle, true);
+            Volatile.Write(ref idleEntries, idleEntries + 1);
+        }
+
+        if (timestamp - lastPassed >= intervalTicks)
+        {
+            lastPassed = timestamp;
+            return true;
+        }
+
+        Volatile.Write(ref suppressedFrames, suppressedFrames + 1);
+        Volatile.Write(ref suppressedBytes, suppressedBytes + bytes);
+        return false;
+    }
+
+    /// <summary>
+    /// Takes a point-in-time copy of the gate's counters.
+    /// </summary>
+    /// <returns>The counters.</returns>
+    public DuplicateFrameMetrics GetMetrics() => new(
+        Interlocked.Read(ref duplicateFrames),
+        Interlocked.Read(ref suppressedFrames),
+        Interlocked.Read(ref suppressedBytes),
+        IsIdle,
+        Interlocked.Read(ref idleEntries));
+}
+
+/// <summary>
+/// A point-in-time copy of a <see cref="DuplicateFrameGate"/>'s counters.
+/// </summary>
+/// <param name="DuplicateFrames">The frames whose pixels repeated the frame before them.</param>
+/// <param name="SuppressedFrames">The repeats not sent because the page was idle.</param>
+/// <param name="SuppressedBytes">The uncompressed bytes of the suppressed frames, which NDI never had to encode.</param>
+/// <param name="Idle">Whether the content is static and sent at the idle rate.</param>
+/// <param name="IdleEntries">The times the content went static long enough to lower the rate.</param>
+internal readonly record struct DuplicateFrameMetrics(
+    long DuplicateFrames,
+    long SuppressedFrames,
+    long SuppressedBytes,
+    bool Idle,
+    long IdleEntries);
@@ -0,0 +1,173 @@
+using System;
+using System.Runtime.CompilerServices;
+using Tractus.HtmlToNdi.Native;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// A 128-bit digest of a frame's visible pixels. Two frames with equal digests are treated as the same picture.
+/// </summary>
+/// <param name="Low">The low 64 bits of the digest.</param>
+/// <param name="High">The high 64 bits of the digest.</param>
+internal readonly record struct FrameContentHash(ulong Low, ulong High)
+{
+    private const int StripeBytes = 64;
+    private const int Lanes = 8;
+    private const int StripesPerBlock = 16;
+    private const int SecretWords = StripesPerBlock + Lanes;
+    private const int ScrambleOffset = StripesPerBlock;
+    private const int LowMergeOffset = 0;
+    private const int HighMergeOffset = 11;
+
+    private const ulong Prime32_1 = 0x9E3779B1u;
+    private const ulong Prime32_2 = 0x85EBCA77u;
+    private const ulong Prime32_3 = 0xC2B2AE3Du;
+    private const ulong Prime64_1 = 0x9E3779B185EBCA87ul;
+    private const ulong Prime64_2 = 0xC2B2AE3D27D4EB4Ful;
+    private const ulong Prime64_3 = 0x165667B19E3779F9ul;
+    private const ulong Prime64_4 = 0x85EBCA77C2B2AE63ul;
+    private const ulong Prime64_5 = 0x27D4EB2F165667C5ul;
+
+    private static readonly ulong[] Secret = CreateSecret();
+
+    /// <summary>
+    /// Hashes the first <paramref name="rowBytes"/> of each row with the native helper's SSE2 kernel, or with
+    /// <see cref="ComputeManaged"/> when the helper is not loadable. Both produce the same digest.
+    /// </summary>
+    /// <param name="pixels">The first row of the frame.</param>
+    /// <param name="rowBytes">The visible bytes of each row.</param>
+    /// <param name="height">The number of rows.</param>
+    /// <param name="stride">The distance between rows in bytes, which may exceed <paramref name="rowBytes"/>.</param>
+    /// <returns>The digest.</returns>
+    public static FrameContentHash Compute(IntPtr pixels, int rowBytes, int height, int stride)
+        => CompositorCaptureBridge.HashFrame(pixels, rowBytes, height, stride);
+
+    /// <summary>
+    /// Hashes a captured frame's visible pixels.
+    /// </summary>
+    /// <param name="frame">The frame, which must be in CPU memory.</param>
+    /// <returns>The digest.</returns>
+    public static FrameContentHash Compute(CapturedFrame frame)
+        => Compute(frame.Buffer, frame.Width * 4, frame.Height, frame.Stride);
+
+    /// <summary>
+    /// Hashes a pipeline frame's visible pixels.
+    /// </summary>
+    /// <param name="frame">The frame.</param>
+    /// <returns>The digest.</returns>
+    public static FrameContentHash Compute(NdiVideoFrame frame)
+        => Compute(frame.Buffer, frame.Width * 4, frame.Height, frame.Stride);
+
+    /// <summary>
+    /// The managed port of <c>HashFrameScalar</c> in <c>ContentHash.cpp</c>, which it must match bit for bit: eight
+    /// 64-bit lanes accumulate a keyed 32x32-bit product of each input word plus the neighbouring word, 64 bytes at a
+    /// time, and are scrambled every 1 KB. Each row's tail is zero-padded to a whole stripe.
+    /// </summary>
+    /// <param name="pixels">The first row of the frame.</param>
+    /// <param name="rowBytes">The visible bytes of each row.</param>
+    /// <param name="height">The number of rows.</param>
+    /// <param name="stride">The distance between rows in bytes.</param>
+    /// <returns>The digest.</returns>
+    internal static unsafe FrameContentHash ComputeManaged(IntPtr pixels, int rowBytes, int height, int stride)
+    {
+        var acc = stackalloc ulong[Lanes] { Prime32_3, Prime64_1, Prime64_2, Prime64_3, Prime64_4, Prime32_2, Prime64_5, Prime32_1 };
+        if (pixels == IntPtr.Zero || rowBytes <= 0 || height <= 0)
+        {
+            return Finish(acc, 0, 0);
+        }
+
+        var tail = stackalloc byte[StripeBytes];
+        var stripe = 0;
+        for (var y = 0; y < height; y++)
+        {
+            var row = (byte*)pixels + ((long)y * stride);
+            var offset = 0;
+            for (; offset + StripeBytes <= rowBytes; offset += StripeBytes)
+            {
+                Accumulate(acc, row + offset, stripe);
+                stripe = Advance(acc, stripe);
+            }
+
+            if (offset < rowBytes)
+            {
+                new Span<byte>(tail, StripeBytes).Clear();
+                new ReadOnlySpan<byte>(row + offset, rowBytes - offset).CopyTo(new Span<byte>(tail, StripeBytes));
+                Accumulate(acc, tail, stripe);
+                stripe = Advance(acc, stripe);
+            }
+        }
+
+        return Finish(acc, rowBytes, height);
+    }
+
+    private static ulong[] CreateSecret()
+    {
+        var secret = new ulong[SecretWords];
+        ulong state = 0;
+        for (var i = 0; i < secret.Length; i++)
+        {
+            state += 0x9E3779B97F4A7C15ul;
+            var z = state;
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ul;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBul;
+            secret[i] = z ^ (z >> 31);
+        }
+
+        return secret;
+    }
+
+    private static unsafe void Accumulate(ulong* acc, byte* stripe, int keyOffset)
+    {
+        for (var i = 0; i < Lanes; i++)
+        {
+            var data = Unsafe.ReadUnaligned<ulong>(stripe + (i * 8));
+            var keyed = data ^ Secret[keyOffset + i];
+            acc[i ^ 1] += data;
+            acc[i] += (keyed & 0xFFFFFFFFu) * (keyed >> 32);
+        }
+    }
+
+    private static unsafe int Advance(ulong* acc, int stripe)
+    {
+        if (++stripe < StripesPerBlock)
+        {
+            return stripe;
+        }
+
+        for (var i = 0; i < Lanes; i++)
+        {
+            var value = acc[i];
+            value ^= value >> 47;
+            value ^= Secret[ScrambleOffset + i];
+            acc[i] = value * Prime32_1;
+        }
+
+        return 0;
+    }
+
+    private static unsafe FrameContentHash Finish(ulong* acc, int rowBytes, int height)
+    {
+        var bytesPerRow = (ulong)rowBytes;
+        var total = bytesPerRow * (ulong)height;
+        return new FrameContentHash(
+            Merge(acc, LowMergeOffset, (total * Prime64_1) + (bytesPerRow * Prime64_3)),
+            Merge(acc, HighMergeOffset, ~(total * Prime64_2) + (bytesPerRow * Prime64_4)));
+    }
+
+    private static unsafe ulong Merge(ulong* acc, int offset, ulong start)
+    {
+        var result = start;
+        for (var i = 0; i < Lanes; i += 2)
+        {
+            var high = Math.BigMul(acc[i] ^ Secret[offset + i], acc[i + 1] ^ Secret[offset + i + 1], out var low);
+            result += low ^ high;
+        }
+
+        result ^= result >> 37;
+        result *= 0x165667919E3779F9ul;
+        return result ^ (result >> 32);
+    }
+
+    /// <inheritdoc />
+    public override string ToString() => $"{High:x16}{Low:x16}";
+}
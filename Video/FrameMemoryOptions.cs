@@ -0,0 +1,27 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Allocation preferences for the native helper's frame pools.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorMemoryFlags</c> in the native helper.</remarks>
+[Flags]
+public enum FrameMemoryOptions
+{
+    /// <summary>
+    /// Pools use ordinary pages wherever the OS places them.
+    /// </summary>
+    None = 0,
+
+    /// <summary>
+    /// Pools prefer 2 MB pages, which cut TLB misses when kernels stream 4K frames. On Windows this needs the
+    /// "Lock pages in memory" privilege; on Linux reserved huge pages are used first and transparent huge pages
+    /// otherwise. Ordinary pages are used when neither is available.
+    /// </summary>
+    LargePages = 1 << 0,
+
+    /// <summary>
+    /// Pools are bound to the NUMA node of the first CPU in the thread affinity, so the pinned capture threads never
+    /// read frames across the interconnect. Has no effect without an affinity.
+    /// </summary>
+    NumaLocal = 1 << 1,
+}
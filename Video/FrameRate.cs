@@ -63,6 +63,31 @@ public readonly struct FrameRate
     /// </summary>
     public TimeSpan FrameDuration => TimeSpan.FromSeconds(1.0 / Value);
 
+    /// <summary>
+    /// Divides the frame rate by an integer factor, reducing the result to lowest terms.
+    /// </summary>
+    /// <param name="divisor">The positive factor to divide by, e.g. 2 to turn a field rate into a frame rate.</param>
+    /// <returns>The divided frame rate.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">Thrown if <paramref name="divisor"/> is not positive.</exception>
+    public FrameRate DivideBy(int divisor)
+    {
+        if (divisor <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(divisor));
+        }
+
+        var numerator = (long)Numerator;
+        var denominator = (long)Denominator * divisor;
+        var a = numerator;
+        var b = denominator;
+        while (b != 0)
+        {
+            (a, b) = (b, a % b);
+        }
+
+        return new FrameRate((int)(numerator / a), (int)(denominator / a));
+    }
+
     /// <summary>
     /// Parses a frame rate from a string.
     /// </summary>
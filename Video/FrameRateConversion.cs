@@ -0,0 +1,18 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Identifies how the native helper converts a page rendering at one rate into output at another.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorRateConversion</c> in the native helper.</remarks>
+public enum FrameRateConversion
+{
+    /// <summary>
+    /// Shows the source frame nearest each output instant, repeating or dropping frames as the cadence requires.
+    /// </summary>
+    DropRepeat = 0,
+
+    /// <summary>
+    /// Mixes the two source frames either side of each output instant by phase, removing periodic hitches on motion.
+    /// </summary>
+    Blend = 1,
+}
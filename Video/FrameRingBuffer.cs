@@ -9,7 +9,7 @@ namespace Tractus.HtmlToNdi.Video;
 internal sealed class FrameRingBuffer<T>
     where T : class, IDisposable
 {
-    private readonly int capacity;
+    private int capacity;
     private readonly Queue<T> frames;
     private int overflowSinceLastDequeue;
 
@@ -32,7 +32,16 @@ internal sealed class FrameRingBuffer<T>
     /// <summary>
     /// Gets the capacity of the buffer.
     /// </summary>
-    public int Capacity => capacity;
+    public int Capacity
+    {
+        get
+        {
+            lock (frames)
+            {
+                return capacity;
+            }
+        }
+    }
 
     /// <summary>
     /// Gets the number of frames currently in the buffer.
@@ -201,6 +210,59 @@ internal sealed class FrameRingBuffer<T>
         }
     }
 
+    /// <summary>
+    /// Changes the capacity, keeping the queued frames. When the buffer holds more frames than the new capacity, the
+    /// oldest are disposed and counted as overflow, as if they had been pushed out by new frames.
+    /// </summary>
+    /// <param name="newCapacity">The new capacity of the buffer.</param>
+    /// <returns>The number of frames dropped to fit the new capacity.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">Thrown if the capacity is not positive.</exception>
+    public int Resize(int newCapacity)
+    {
+        if (newCapacity <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(newCapacity));
+        }
+
+        lock (frames)
+        {
+            capacity = newCapacity;
+            var dropped = 0;
+            while (frames.Count > capacity)
+            {
+                frames.Dequeue().Dispose();
+                DroppedFromOverflow++;
+                dropped++;
+            }
+
+            overflowSinceLastDequeue = Math.Min(overflowSinceLastDequeue, capacity);
+            return dropped;
+        }
+    }
+
+    /// <summary>
+    /// Lowers the capacity toward <paramref name="newCapacity"/> without dropping a frame: it stops one above the
+    /// frames held, so the next enqueue still fits, and never grows. Calling it again as frames are dequeued finishes
+    /// the shrink.
+    /// </summary>
+    /// <param name="newCapacity">The capacity to reach.</param>
+    /// <returns>The capacity after the call.</returns>
+    /// <exception cref="ArgumentOutOfRangeException">Thrown if the capacity is not positive.</exception>
+    public int ShrinkToward(int newCapacity)
+    {
+        if (newCapacity <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(newCapacity));
+        }
+
+        lock (frames)
+        {
+            capacity = Math.Min(capacity, Math.Max(newCapacity, frames.Count + 1));
+            overflowSinceLastDequeue = Math.Min(overflowSinceLastDequeue, capacity);
+            return capacity;
+        }
+    }
+
     /// <summary>
     /// Clears the buffer, disposing of all frames.
     /// </summary>
@@ -0,0 +1,27 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// How a frame reached <see cref="INdiVideoSender.Send"/>, which is what its capture-to-send latency is tagged by.
+/// </summary>
+public enum FrameSendPath
+{
+    /// <summary>
+    /// Sent as soon as it was captured, with no paced buffer.
+    /// </summary>
+    Direct,
+
+    /// <summary>
+    /// Dequeued from the paced buffer on a tick.
+    /// </summary>
+    Buffered,
+
+    /// <summary>
+    /// Sent again because no fresh frame was ready; its latency is the age of the picture on the wire.
+    /// </summary>
+    Repeated,
+
+    /// <summary>
+    /// Dequeued from the paced buffer while latency expansion let the sender run below the target depth.
+    /// </summary>
+    LatencyExpansion,
+}
@@ -0,0 +1,111 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Locks the paced sender's ticks to the frame arrivals of a reference source, the way a hardware output follows a
+/// genlock signal, so the output runs at the reference's rate and in its phase rather than on the local
+/// <see cref="System.Diagnostics.Stopwatch"/>. Only the <c>synthetic</c> stand-in exists so far: it generates arrivals
+/// with a frequency error and network jitter, so the follower can be exercised without a reference on the network.
+/// </summary>
+/// <param name="Source">The reference source's name, or <c>null</c> to free-run.</param>
+/// <param name="FrameRate">The reference's frame rate, or <c>null</c> for the output's.</param>
+/// <param name="DriftPpm">How far the synthetic reference runs ahead of the local clock, in parts per million.</param>
+/// <param name="Jitter">The standard deviation of how late each synthetic arrival is.</param>
+/// <param name="Seed">Seeds the synthetic jitter.</param>
+/// <param name="MaxSlewPpm">How fast, in parts per million, the follower may pull the output's phase in.</param>
+public sealed record GenlockReference(string? Source, FrameRate? FrameRate, double DriftPpm, TimeSpan Jitter, ulong Seed, double MaxSlewPpm)
+{
+    /// <summary>
+    /// The stand-in source that generates arrivals locally.
+    /// </summary>
+    public const string SyntheticSource = "synthetic";
+
+    /// <summary>
+    /// Gets settings that let the paced sender free-run.
+    /// </summary>
+    public static GenlockReference Disabled { get; } = new(null, null, 0, TimeSpan.Zero, 1, PacingReference.DefaultMaxSlewPpm);
+
+    /// <summary>
+    /// Gets a value indicating whether the paced sender follows a reference source.
+    /// </summary>
+    public bool IsEnabled => Source is not null;
+
+    /// <summary>
+    /// Parses a reference source such as <c>synthetic,rate=59.94,drift=80,jitter=1,seed=7</c>.
+    /// </summary>
+    /// <param name="text">
+    /// The source name followed by comma-separated entries: <c>rate=&lt;fps&gt;</c>, <c>drift=&lt;ppm&gt;</c>,
+    /// <c>jitter=&lt;ms&gt;</c> and <c>seed=&lt;n&gt;</c>. Null or whitespace yields <see cref="Disabled"/>.
+    /// </param>
+    /// <param name="maxSlewPpm">The slew limit in parts per million.</param>
+    /// <returns>The parsed settings.</returns>
+    /// <exception cref="FormatException">Thrown when the source or an entry is unknown or out of range.</exception>
+    public static GenlockReference Parse(string? text, double maxSlewPpm = PacingReference.DefaultMaxSlewPpm)
+    {
+        if (string.IsNullOrWhiteSpace(text))
+        {
+            return Disabled;
+        }
+
+        var entries = text.Split(',', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries);
+        if (entries.Length == 0 || !string.Equals(entries[0], SyntheticSource, StringComparison.OrdinalIgnoreCase))
+        {
+            throw new FormatException($"Unknown genlock source '{text}' (expected {SyntheticSource}; following an NDI receiver's arrivals needs a receiver, which this build does not have).");
+        }
+
+        if (!(maxSlewPpm > 0 && maxSlewPpm <= 10_000))
+        {
+            throw new FormatException(string.Create(CultureInfo.InvariantCulture, $"The genlock slew limit must be above 0 and at most 10000 ppm, not {maxSlewPpm}."));
+        }
+
+        var reference = Disabled with { Source = SyntheticSource, MaxSlewPpm = maxSlewPpm };
+        foreach (var entry in entries.Skip(1))
+        {
+            var parts = entry.Split('=', 2, StringSplitOptions.TrimEntries);
+            var value = parts.Length == 2 ? parts[1] : string.Empty;
+            switch (parts[0].ToLowerInvariant())
+            {
+                case "rate":
+                    try
+                    {
+                        reference = reference with { FrameRate = Video.FrameRate.Parse(value) };
+                    }
+                    catch (Exception ex) when (ex is FormatException or ArgumentOutOfRangeException)
+                    {
+                        throw new FormatException($"Genlock entry '{entry}' must be rate=<fps>.", ex);
+                    }
+
+                    break;
+                case "drift":
+                    if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var drift) || Math.Abs(drift) > ReferencePhaseLock.MaxFrequencyPpm)
+                    {
+                        throw new FormatException($"Genlock entry '{entry}' must be drift=<ppm> between -{ReferencePhaseLock.MaxFrequencyPpm} and {ReferencePhaseLock.MaxFrequencyPpm}.");
+                    }
+
+                    reference = reference with { DriftPpm = drift };
+                    break;
+                case "jitter":
+                    if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var jitter) || jitter < 0 || jitter > 1_000)
+                    {
+                        throw new FormatException($"Genlock entry '{entry}' must be jitter=<ms> between 0 and 1000.");
+                    }
+
+                    reference = reference with { Jitter = TimeSpan.FromMilliseconds(jitter) };
+                    break;
+                case "seed":
+                    if (!ulong.TryParse(value, NumberStyles.Integer, CultureInfo.InvariantCulture, out var seed))
+                    {
+                        throw new FormatException($"Genlock entry '{entry}' must be seed=<non-negative integer>.");
+                    }
+
+                    reference = reference with { Seed = seed };
+                    break;
+                default:
+                    throw new FormatException($"Unknown genlock entry '{entry}' (expected rate, drift, jitter or seed).");
+            }
+        }
+
+        return reference;
+    }
+}
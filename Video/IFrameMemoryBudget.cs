@@ -0,0 +1,26 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// The process-wide frame-memory budget that pipelines charge their buffered frames to.
+/// </summary>
+internal interface IFrameMemoryBudget
+{
+    /// <summary>
+    /// Charges <paramref name="bytes"/> when they fit in the budget.
+    /// </summary>
+    /// <param name="bytes">The bytes to charge.</param>
+    /// <returns><c>false</c> when the charge would exceed the budget; nothing is charged then.</returns>
+    bool TryReserve(long bytes);
+
+    /// <summary>
+    /// Charges bytes the caller cannot run without, even when they exceed the budget.
+    /// </summary>
+    /// <param name="bytes">The bytes to charge.</param>
+    void Reserve(long bytes);
+
+    /// <summary>
+    /// Returns bytes charged by <see cref="TryReserve"/> or <see cref="Reserve"/>.
+    /// </summary>
+    /// <param name="bytes">The bytes to return.</param>
+    void Release(long bytes);
+}
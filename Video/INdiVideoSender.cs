@@ -1,3 +1,4 @@
+using System.Runtime.InteropServices;
 using NewTek;
 using NewTek.NDI;
 
@@ -19,6 +20,12 @@ internal interface INdiVideoSender
     /// until the next send completes (as required by the async NDI APIs).
     /// </summary>
     bool RequiresFrameRetention { get; }
+
+    /// <summary>
+    /// Returns once NDI no longer reads any frame handed to an asynchronous send. A synchronous sender has nothing
+    /// to wait for.
+    /// </summary>
+    void Flush();
 }
 
 /// <summary>
@@ -64,4 +71,22 @@ internal sealed class NativeNdiVideoSender : INdiVideoSender
 
     /// <inheritdoc />
     public bool RequiresFrameRetention => sendAsync;
+
+    /// <summary>
+    /// Sends no frame asynchronously, which NDI documents as waiting until it has finished with the last frame.
+    /// </summary>
+    public void Flush()
+    {
+        if (sendAsync)
+        {
+            NativeMethods.NDIlib_send_send_video_async_v2(senderPtr, nint.Zero);
+        }
+    }
+
+    private static class NativeMethods
+    {
+        // The wrapper only binds the by-reference overload, which cannot pass the NULL frame a flush needs.
+        [DllImport("Processing.NDI.Lib.x64", EntryPoint = "NDIlib_send_send_video_async_v2", CallingConvention = CallingConvention.Cdecl)]
+        internal static extern void NDIlib_send_send_video_async_v2(nint instance, nint videoFrame);
+    }
 }
@@ -0,0 +1,28 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// The monotonic time source of the paced sender. <see cref="SystemPipelineClock"/> reads the
+/// <see cref="System.Diagnostics.Stopwatch"/> and really waits; <see cref="VirtualPipelineClock"/> lets a simulation
+/// run the pacing engine through hours of frames in seconds.
+/// </summary>
+internal interface IPipelineClock
+{
+    /// <summary>
+    /// Gets the time since the clock's origin, which is arbitrary but fixed.
+    /// </summary>
+    TimeSpan Elapsed { get; }
+
+    /// <summary>
+    /// Gets the current time in <see cref="System.Diagnostics.Stopwatch"/> ticks, the unit of
+    /// <see cref="CapturedFrame.MonotonicTimestamp"/>.
+    /// </summary>
+    long GetTimestamp();
+
+    /// <summary>
+    /// Blocks the calling thread until <see cref="Elapsed"/> reaches <paramref name="deadline"/>.
+    /// </summary>
+    /// <param name="deadline">The time to wait for, on the <see cref="Elapsed"/> timeline.</param>
+    /// <param name="token">Ends the wait early when cancelled.</param>
+    /// <param name="highResolutionTimer">The calling thread's waitable timer, when a real-time clock can use one.</param>
+    void WaitUntil(TimeSpan deadline, CancellationToken token, HighResolutionWaitableTimer? highResolutionTimer);
+}
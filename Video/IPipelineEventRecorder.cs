@@ -0,0 +1,15 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Receives the timestamped events of one pipeline for the flight recorder. Called on the capture and sender
+/// threads for every frame, so implementations must not block or allocate.
+/// </summary>
+internal interface IPipelineEventRecorder
+{
+    /// <summary>
+    /// Records one event, timestamped on arrival.
+    /// </summary>
+    /// <param name="pipelineEvent">The event.</param>
+    /// <param name="value">The event's value; see <see cref="PipelineEvent"/> for what each event carries.</param>
+    void Record(PipelineEvent pipelineEvent, long value = 0);
+}
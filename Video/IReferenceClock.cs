@@ -0,0 +1,20 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// A timebase several machines agree on, such as the system time disciplined by PTP or NTP. A
+/// <see cref="PhaseLockedCadence"/> locks the paced sender's ticks to it so every source sends frame <c>N</c> at the
+/// same instant.
+/// </summary>
+internal interface IReferenceClock
+{
+    /// <summary>
+    /// Gets a short name for logs and telemetry.
+    /// </summary>
+    string Name { get; }
+
+    /// <summary>
+    /// Reads the reference time.
+    /// </summary>
+    /// <returns>The time in 100 ns ticks since the Unix epoch.</returns>
+    long ReadTicks();
+}
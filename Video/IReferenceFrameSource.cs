@@ -0,0 +1,31 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Reports when each frame of a genlock reference arrives, for a <see cref="ReferenceFollower"/> to lock to.
+/// <see cref="SyntheticReferenceSource"/> stands in for a reference on the network.
+/// </summary>
+internal interface IReferenceFrameSource
+{
+    /// <summary>
+    /// Gets the source's name, for logs and telemetry.
+    /// </summary>
+    string Name { get; }
+
+    /// <summary>
+    /// Gets the reference's nominal frame rate.
+    /// </summary>
+    FrameRate FrameRate { get; }
+
+    /// <summary>
+    /// Starts reporting arrivals. Each call of <paramref name="onFrame"/> passes one arrival, on the
+    /// <see cref="IPipelineClock.Elapsed"/> timeline of the pipeline's clock, in the order the frames arrived; it may be
+    /// called on any thread, and late, as long as the order holds.
+    /// </summary>
+    /// <param name="onFrame">Receives each arrival.</param>
+    void Start(Action<TimeSpan> onFrame);
+
+    /// <summary>
+    /// Stops reporting arrivals; the source can be started again.
+    /// </summary>
+    void Stop();
+}
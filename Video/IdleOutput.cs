@@ -0,0 +1,123 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Detects frames whose pixels repeat the last one sent and, once a page has stayed unchanged for a while, lowers the
+/// rate it is sent at. The first changed frame is sent at once and restores the full rate, so idle mode only costs
+/// the receivers repeats of a picture they already show.
+/// </summary>
+/// <param name="DetectDuplicates">Whether each frame is hashed to tell repeats from changes.</param>
+/// <param name="Interval">How often a static page is re-sent while idle, or <c>null</c> to send every frame.</param>
+/// <param name="After">How long the content must stay unchanged before the rate drops.</param>
+public sealed record IdleOutput(bool DetectDuplicates, TimeSpan? Interval, TimeSpan After)
+{
+    /// <summary>
+    /// Counts duplicates without changing what is sent.
+    /// </summary>
+    public const string DetectMode = "detect";
+
+    /// <summary>
+    /// Re-sends a static page once per <see cref="KeepaliveInterval"/>.
+    /// </summary>
+    public const string KeepaliveMode = "keepalive";
+
+    /// <summary>
+    /// The fastest idle rate; anything faster saves too little to be worth it.
+    /// </summary>
+    public const double MaxIdleFrameRate = 60;
+
+    /// <summary>
+    /// How often <see cref="KeepaliveMode"/> re-sends a static page, often enough that receivers never show the
+    /// source as lost.
+    /// </summary>
+    public static readonly TimeSpan KeepaliveInterval = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// How long the content must stay unchanged by default before the rate drops.
+    /// </summary>
+    public static readonly TimeSpan DefaultAfter = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// Gets settings that send every frame without hashing it.
+    /// </summary>
+    public static IdleOutput Disabled { get; } = new(false, null, DefaultAfter);
+
+    /// <summary>
+    /// Gets a value indicating whether frames are hashed.
+    /// </summary>
+    public bool IsEnabled => DetectDuplicates;
+
+    /// <summary>
+    /// Gets a value indicating whether a static page is sent at a lower rate.
+    /// </summary>
+    public bool LowersRate => DetectDuplicates && Interval is not null;
+
+    /// <summary>
+    /// Parses idle settings such as <c>keepalive</c>, <c>5,after=2</c> or <c>detect</c>.
+    /// </summary>
+    /// <param name="text">
+    /// <c>detect</c>, <c>keepalive</c> or an idle frame rate in frames per second, optionally followed by
+    /// <c>after=&lt;seconds&gt;</c>. Null or whitespace yields <see cref="Disabled"/>.
+    /// </param>
+    /// <returns>The parsed settings.</returns>
+    /// <exception cref="FormatException">Thrown when the mode or an entry is unknown or out of range.</exception>
+    public static IdleOutput Parse(string? text)
+    {
+        if (string.IsNullOrWhiteSpace(text))
+        {
+            return Disabled;
+        }
+
+        var entries = text.Split(',', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries);
+        if (entries.Length == 0)
+        {
+            return Disabled;
+        }
+
+        var mode = entries[0];
+        IdleOutput idle;
+        if (string.Equals(mode, DetectMode, StringComparison.OrdinalIgnoreCase))
+        {
+            idle = Disabled with { DetectDuplicates = true };
+        }
+        else if (string.Equals(mode, KeepaliveMode, StringComparison.OrdinalIgnoreCase))
+        {
+            idle = Disabled with { DetectDuplicates = true, Interval = KeepaliveInterval };
+        }
+        else if (double.TryParse(mode, NumberStyles.Float, CultureInfo.InvariantCulture, out var rate))
+        {
+            if (!(rate > 0 && rate <= MaxIdleFrameRate))
+            {
+                throw new FormatException(string.Create(CultureInfo.InvariantCulture, $"The idle frame rate must be above 0 and at most {MaxIdleFrameRate} fps, not {rate}."));
+            }
+
+            idle = Disabled with { DetectDuplicates = true, Interval = TimeSpan.FromSeconds(1 / rate) };
+        }
+        else
+        {
+            throw new FormatException($"Unknown idle output mode '{mode}' (expected {DetectMode}, {KeepaliveMode} or an idle frame rate).");
+        }
+
+        foreach (var entry in entries.Skip(1))
+        {
+            var parts = entry.Split('=', 2, StringSplitOptions.TrimEntries);
+            var value = parts.Length == 2 ? parts[1] : string.Empty;
+            switch (parts[0].ToLowerInvariant())
+            {
+                case "after":
+                    if (!double.TryParse(value, NumberStyles.Float, CultureInfo.InvariantCulture, out var after) || after < 0 || after > 3_600)
+                    {
+                        throw new FormatException($"Idle output entry '{entry}' must be after=<seconds> between 0 and 3600.");
+                    }
+
+                    idle = idle with { After = TimeSpan.FromSeconds(after) };
+                    break;
+                default:
+                    throw new FormatException($"Unknown idle output entry '{entry}' (expected after).");
+            }
+        }
+
+        return idle;
+    }
+}
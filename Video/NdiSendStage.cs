@@ -0,0 +1,253 @@
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using NewTek;
+using NewTek.NDI;
+using Serilog;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Moves synchronous NDI sends off the paced sender's thread. The paced sender hands each frame over at its deadline
+/// and goes back to waiting; a dedicated thread makes the blocking <see cref="INdiVideoSender.Send"/> calls in the
+/// order the frames were handed over. At most <see cref="MaxInFlight"/> frames may be queued or sending at once; past
+/// that the paced sender waits for a slot, so a sender that cannot keep up still slows the output instead of
+/// growing a queue. Each frame holds a send reference while in flight, so the pipeline can dispose or replace it as
+/// usual without the buffer going away under the send. A send that throws is logged and skipped; its frame's
+/// reference and slot are released either way, so one failure cannot stall the paced sender.
+/// </summary>
+internal sealed class NdiSendStage : IDisposable
+{
+    /// <summary>
+    /// The name of the sending thread.
+    /// </summary>
+    internal const string ThreadName = "NDI sender";
+
+    private readonly INdiVideoSender sender;
+    private readonly IPipelineClock clock;
+    private readonly IPipelineEventRecorder? eventRecorder;
+    private readonly ILogger logger;
+    private readonly ConcurrentQueue<Entry> queue = new();
+    private readonly SemaphoreSlim slots;
+    private readonly SemaphoreSlim queued = new(0);
+    private Thread? thread;
+    private volatile bool stopping;
+    private int inFlight;
+    private long frames;
+    private long failures;
+    private long stalls;
+    private long queueTicks;
+    private long maxQueueTicks;
+    private long sendTicks;
+    private long maxSendTicks;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="NdiSendStage"/> class.
+    /// </summary>
+    /// <param name="sender">The synchronous sender the thread calls.</param>
+    /// <param name="maxInFlight">The frames that may be queued or sending at once.</param>
+    /// <param name="clock">The clock queue and send times are measured on.</param>
+    /// <param name="eventRecorder">The flight recorder that receives send begin and end events, or <c>null</c>.</param>
+    /// <param name="logger">Receives failed sends; the global logger when <c>null</c>.</param>
+    public NdiSendStage(INdiVideoSender sender, int maxInFlight, IPipelineClock clock, IPipelineEventRecorder? eventRecorder = null, ILogger? logger = null)
+    {
+        this.logger = logger ?? Log.Logger;
+        this.sender = sender ?? throw new ArgumentNullException(nameof(sender));
+        this.clock = clock ?? throw new ArgumentNullException(nameof(clock));
+        if (maxInFlight < 1)
+        {
+            throw new ArgumentOutOfRangeException(nameof(maxInFlight), maxInFlight, "At least one frame must be allowed in flight.");
+        }
+
+        this.eventRecorder = eventRecorder;
+        MaxInFlight = maxInFlight;
+        slots = new SemaphoreSlim(maxInFlight, maxInFlight);
+    }
+
+    /// <summary>
+    /// Gets the frames that may be queued or sending at once.
+    /// </summary>
+    public int MaxInFlight { get; }
+
+    /// <summary>
+    /// Gets the frames queued or sending now.
+    /// </summary>
+    public int InFlight => Volatile.Read(ref inFlight);
+
+    /// <summary>
+    /// Copies the stage's counters. Safe to call from any thread.
+    /// </summary>
+    /// <returns>The current values.</returns>
+    public SendStageMetrics GetMetrics()
+    {
+        return new SendStageMetrics(
+            Interlocked.Read(ref frames),
+            Interlocked.Read(ref failures),
+            Interlocked.Read(ref stalls),
+            InFlight,
+            MaxInFlight,
+            ToSeconds(Interlocked.Read(ref queueTicks)),
+            ToSeconds(Interlocked.Read(ref maxQueueTicks)),
+            ToSeconds(Interlocked.Read(ref sendTicks)),
+            ToSeconds(Interlocked.Read(ref maxSendTicks)));
+    }
+
+    /// <summary>
+    /// Starts the sending thread.
+    /// </summary>
+    public void Start()
+    {
+        if (thread is not null)
+        {
+            return;
+        }
+
+        stopping = false;
+        thread = new Thread(Run)
+        {
+            Name = ThreadName,
+            IsBackground = true,
+        };
+        thread.Start();
+    }
+
+    /// <summary>
+    /// Queues a frame behind those already handed over, waiting for a slot when <see cref="MaxInFlight"/> are in
+    /// flight. Called by the paced sender only.
+    /// </summary>
+    /// <param name="frame">The frame whose buffer <paramref name="ndiFrame"/> points at.</param>
+    /// <param name="ndiFrame">The NDI descriptor to send.</param>
+    /// <param name="token">Ends the wait for a slot when the pipeline stops.</param>
+    /// <returns><c>true</c> when the frame was queued; <c>false</c> when the wait was cancelled.</returns>
+    public bool Enqueue(NdiVideoFrame frame, in NDIlib.video_frame_v2_t ndiFrame, CancellationToken token)
+    {
+        ArgumentNullException.ThrowIfNull(frame);
+        if (!slots.Wait(0))
+        {
+            Interlocked.Increment(ref stalls);
+            try
+            {
+                slots.Wait(token);
+            }
+            catch (OperationCanceledException)
+            {
+                return false;
+            }
+        }
+
+        frame.AcquireSendReference();
+        Interlocked.Increment(ref inFlight);
+        queue.Enqueue(new Entry(frame, ndiFrame, clock.GetTimestamp()));
+        queued.Release();
+        return true;
+    }
+
+    /// <summary>
+    /// Sends the frames already queued, then stops the thread. The stage can be started again.
+    /// </summary>
+    public void Stop()
+    {
+        if (thread is null)
+        {
+            return;
+        }
+
+        stopping = true;
+        queued.Release();
+        thread.Join();
+        thread = null;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        Stop();
+
+        // Frames queued after the thread stopped were never sent; they still hold their buffers.
+        while (queue.TryDequeue(out var entry))
+        {
+            entry.Frame.ReleaseSendReference();
+        }
+
+        slots.Dispose();
+        queued.Dispose();
+    }
+
+    private void Run()
+    {
+        while (true)
+        {
+            queued.Wait();
+            if (!queue.TryDequeue(out var entry))
+            {
+                if (stopping)
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            var started = clock.GetTimestamp();
+            Accumulate(ref queueTicks, ref maxQueueTicks, started - entry.EnqueuedTimestamp);
+            var ndiFrame = entry.NdiFrame;
+            eventRecorder?.Record(PipelineEvent.SendBegin);
+            try
+            {
+                sender.Send(ref ndiFrame);
+                Interlocked.Increment(ref frames);
+            }
+            catch (Exception ex)
+            {
+                Interlocked.Increment(ref failures);
+                logger.Warning(ex, "NDI send thread failed to send a frame");
+            }
+            finally
+            {
+                eventRecorder?.Record(PipelineEvent.SendEnd);
+                Accumulate(ref sendTicks, ref maxSendTicks, clock.GetTimestamp() - started);
+                entry.Frame.ReleaseSendReference();
+                Interlocked.Decrement(ref inFlight);
+                slots.Release();
+            }
+        }
+    }
+
+    /// <summary>
+    /// Adds a duration measured on the sending thread, the only writer.
+    /// </summary>
+    private static void Accumulate(ref long total, ref long max, long ticks)
+    {
+        Volatile.Write(ref total, total + ticks);
+        if (ticks > max)
+        {
+            Volatile.Write(ref max, ticks);
+        }
+    }
+
+    private static double ToSeconds(long stopwatchTicks) => stopwatchTicks / (double)Stopwatch.Frequency;
+
+    private readonly record struct Entry(NdiVideoFrame Frame, NDIlib.video_frame_v2_t NdiFrame, long EnqueuedTimestamp);
+}
+
+/// <summary>
+/// A point-in-time copy of an <see cref="NdiSendStage"/>'s counters.
+/// </summary>
+/// <param name="Frames">The frames the sending thread has sent.</param>
+/// <param name="Failures">The sends that threw; their frames were skipped.</param>
+/// <param name="Stalls">The times the paced sender waited because the stage was full.</param>
+/// <param name="InFlight">The frames queued or sending now.</param>
+/// <param name="MaxInFlight">The frames that may be queued or sending at once.</param>
+/// <param name="QueueSeconds">The total time frames waited between hand-over and their send.</param>
+/// <param name="MaxQueueSeconds">The longest a frame waited between hand-over and its send.</param>
+/// <param name="SendSeconds">The total time spent in the blocking send.</param>
+/// <param name="MaxSendSeconds">The longest blocking send.</param>
+internal readonly record struct SendStageMetrics(
+    long Frames,
+    long Failures,
+    long Stalls,
+    int InFlight,
+    int MaxInFlight,
+    double QueueSeconds,
+    double MaxQueueSeconds,
+    double SendSeconds,
+    double MaxSendSeconds);
@@ -1,13 +1,20 @@
 using System;
 using System.Runtime.InteropServices;
+using System.Threading;
+using Tractus.HtmlToNdi.Native;
 
 namespace Tractus.HtmlToNdi.Video;
 
 /// <summary>
-/// Represents a video frame to be sent over NDI.
+/// Represents a video frame to be sent over NDI. While an <see cref="NdiSendStage"/> holds the frame in flight,
+/// disposing it only marks it, and the last send to finish frees the buffer.
 /// </summary>
 internal sealed class NdiVideoFrame : IDisposable
 {
+    private IntPtr buffer;
+    private int sendReferences;
+    private int disposeRequested;
+
     /// <summary>
     /// Initializes a new instance of the <see cref="NdiVideoFrame"/> class.
     /// </summary>
@@ -20,7 +27,7 @@ internal sealed class NdiVideoFrame : IDisposable
         Width = width;
         Height = height;
         Stride = stride;
-        Buffer = buffer;
+        this.buffer = buffer;
     }
 
     /// <summary>
@@ -41,7 +48,7 @@ internal sealed class NdiVideoFrame : IDisposable
     /// <summary>
     /// Gets a pointer to the frame buffer.
     /// </summary>
-    public IntPtr Buffer { get; private set; }
+    public IntPtr Buffer => Volatile.Read(ref buffer);
 
     /// <summary>
     /// Gets or sets the timestamp of the frame.
@@ -54,7 +61,14 @@ internal sealed class NdiVideoFrame : IDisposable
     public long MonotonicTimestamp { get; set; }
 
     /// <summary>
-    /// Creates a new <see cref="NdiVideoFrame"/> by copying data from a <see cref="CapturedFrame"/>.
+    /// Gets or sets the digest of the frame's pixels, or <c>null</c> when the pipeline does not hash frames.
+    /// </summary>
+    public FrameContentHash? ContentHash { get; set; }
+
+    /// <summary>
+    /// Creates a new <see cref="NdiVideoFrame"/> by copying data from a <see cref="CapturedFrame"/>. Buffered frames
+    /// are not read again until the paced sender reaches them, so the copy bypasses the cache where the native
+    /// helper is available.
     /// </summary>
     /// <param name="frame">The captured frame to copy from.</param>
     /// <returns>A new <see cref="NdiVideoFrame"/> instance.</returns>
@@ -67,10 +81,7 @@ internal sealed class NdiVideoFrame : IDisposable
 
         var size = frame.SizeInBytes;
         var buffer = Marshal.AllocHGlobal(size);
-        unsafe
-        {
-            System.Buffer.MemoryCopy((void*)frame.Buffer, (void*)buffer, size, size);
-        }
+        CompositorCaptureBridge.CopyFrame(buffer, frame.Buffer, size);
 
         return new NdiVideoFrame(frame.Width, frame.Height, frame.Stride, buffer)
         {
@@ -80,16 +91,48 @@ internal sealed class NdiVideoFrame : IDisposable
     }
 
     /// <summary>
-    /// Releases the unmanaged resources used by the video frame.
+    /// Gets the sends of this frame queued or in progress on an <see cref="NdiSendStage"/>.
+    /// </summary>
+    internal int SendReferences => Volatile.Read(ref sendReferences);
+
+    /// <summary>
+    /// Keeps the buffer alive for one more queued send. Only a frame that has not been disposed may be queued.
+    /// </summary>
+    internal void AcquireSendReference() => Interlocked.Increment(ref sendReferences);
+
+    /// <summary>
+    /// Ends one queued send, freeing the buffer if the frame was disposed while it was in flight.
+    /// </summary>
+    internal void ReleaseSendReference()
+    {
+        if (Interlocked.Decrement(ref sendReferences) == 0 && Volatile.Read(ref disposeRequested) != 0)
+        {
+            Free();
+        }
+    }
+
+    /// <summary>
+    /// Releases the unmanaged resources used by the video frame, once no send holds it.
     /// </summary>
     public void Dispose()
     {
-        if (Buffer != IntPtr.Zero)
+        // A full fence, so this and a concurrent last release cannot both miss each other.
+        Interlocked.Exchange(ref disposeRequested, 1);
+        if (Volatile.Read(ref sendReferences) == 0)
         {
-            Marshal.FreeHGlobal(Buffer);
-            Buffer = IntPtr.Zero;
+            Free();
         }
 
         GC.SuppressFinalize(this);
     }
+
+    private void Free()
+    {
+        // Dispose and the last release may both get here; only one of them takes the buffer.
+        var owned = Interlocked.Exchange(ref buffer, IntPtr.Zero);
+        if (owned != IntPtr.Zero)
+        {
+            Marshal.FreeHGlobal(owned);
+        }
+    }
 }
@@ -17,6 +17,7 @@ internal sealed class NdiVideoPipeline : IDisposable
 {
     private readonly INdiVideoSender sender;
     private readonly FrameRate configuredFrameRate;
+    private readonly NDIlib.frame_format_type_e frameFormatType;
     private readonly NdiVideoPipelineOptions options;
     private readonly CancellationTokenSource cancellation = new();
     private readonly FrameRingBuffer<NdiVideoFrame>? ringBuffer;
@@ -25,9 +26,23 @@ internal sealed class NdiVideoPipeline : IDisposable
     private static readonly double StopwatchTicksToTimeSpanTicks = TimeSpan.TicksPerSecond / (double)Stopwatch.Frequency;
 
     private const double SmoothnessRecoveryFactor = 0.1;
-    private readonly int targetDepth;
-    private readonly double lowWatermark;
-    private readonly double highWatermark;
+    private int targetDepth;
+    private readonly int requestedDepth;
+    private readonly int depthCeiling;
+    private readonly BufferDepthTuner? depthTuner;
+    private readonly long[]? captureIntervals;
+    private TimeSpan nextDepthEvaluation;
+    private int pendingRingCapacity;
+    private readonly IFrameMemoryBudget? memoryBudget;
+    private readonly IPipelineEventRecorder? eventRecorder;
+    private readonly IPipelineClock clock;
+    private readonly PhaseLockedCadence? phaseLockedCadence;
+    private readonly IReferenceFrameSource? referenceSource;
+    private readonly NdiSendStage? sendStage;
+    private long reservedFrameBytes;
+    private readonly double? watermarkHysteresis;
+    private double lowWatermark;
+    private double highWatermark;
     private readonly bool allowLatencyExpansion;
     private readonly TimeSpan frameInterval;
     private readonly long maxPacingAdjustmentTicks;
@@ -41,7 +56,8 @@ internal sealed class NdiVideoPipeline : IDisposable
     private bool hasPrimedOnce;
     private double latencyError;
     private int consecutiveLowBacklogTicks;
-    private DateTime warmupStarted;
+    private int framesTakenByLastTick;
+    private TimeSpan warmupStarted;
     private long underruns;
     private long warmupCycles;
     private long lastWarmupDurationTicks;
@@ -61,12 +77,19 @@ internal sealed class NdiVideoPipeline : IDisposable
 
     private Task? pacingTask;
     private NdiVideoFrame? lastSentFrame;
-    private CapturedFrame? lastDirectFrame;
-    private long capturedFrames;
-    private long sentFrames;
+    private const int CapturedCounter = 0;
+    private const int CompositorCounter = 1;
+    private const int InvalidationCounter = 2;
+    private const int SentCounter = 0;
+
+    // Frame counters are written once or twice per frame, so each writing role gets its own padded block and avoids a
+    // locked increment on a line shared with the other role. The capture block is written by whichever thread delivers
+    // frames; the output block by the paced sender, or by the capture thread in direct mode.
+    private readonly PaddedCounterBlock captureCounters = new(3);
+    private readonly PaddedCounterBlock outputCounters = new(1);
+    private readonly SendLatencyRecorder sendLatency = new();
     private long repeatedFrames;
-    private DateTime lastTelemetry = DateTime.UtcNow;
-    private DateTime telemetryWarmupDeadline;
+    private long nextTelemetryTimestamp;
     private readonly CadenceTracker captureCadenceTracker;
     private readonly CadenceTracker outputCadenceTracker;
     private readonly bool alignWithCaptureTimestamps;
@@ -76,13 +99,12 @@ internal sealed class NdiVideoPipeline : IDisposable
     private readonly double cadencePercentMinimumDurationTicks;
     private double cadenceAlignmentDeltaFrames;
     private readonly bool pacedInvalidationEnabled;
-    private readonly bool senderRequiresFrameRetention;
+    private readonly AsyncSendRetention? asyncRetention;
+    private readonly DuplicateFrameGate? duplicateGate;
     private readonly bool captureBackpressureEnabled;
     private readonly bool directPacedInvalidationEnabled;
     private readonly bool pumpCadenceAdaptationEnabled;
     private readonly bool compositorCaptureEnabled;
-    private long compositorFrames;
-    private long invalidationFrames;
 
     private IPacedInvalidationScheduler? invalidationScheduler;
     private bool captureGateActive;
@@ -215,14 +237,34 @@ internal sealed class NdiVideoPipeline : IDisposable
     /// <param name="frameRate">The configured frame rate.</param>
     /// <param name="options">The pipeline options.</param>
     /// <param name="logger">The logger instance.</param>
-    public NdiVideoPipeline(INdiVideoSender sender, FrameRate frameRate, NdiVideoPipelineOptions options, ILogger logger)
+    /// <param name="memoryBudget">The frame-memory budget the held frames are charged to, or <c>null</c> for none.</param>
+    /// <param name="eventRecorder">The flight recorder that receives this pipeline's events, or <c>null</c> for none.</param>
+    /// <param name="clock">The clock the paced sender runs on, or <c>null</c> for <see cref="SystemPipelineClock"/>.</param>
+    /// <param name="referenceClock">The timebase a <see cref="NdiVideoPipelineOptions.PacingReference"/> locks to, or
+    /// <c>null</c> for <see cref="SystemReferenceClock"/>.</param>
+    /// <param name="referenceSource">The arrivals a <see cref="NdiVideoPipelineOptions.Genlock"/> follows, or <c>null</c>
+    /// for a <see cref="SyntheticReferenceSource"/> built from the options.</param>
+    public NdiVideoPipeline(INdiVideoSender sender, FrameRate frameRate, NdiVideoPipelineOptions options, ILogger logger, IFrameMemoryBudget? memoryBudget = null, IPipelineEventRecorder? eventRecorder = null, IPipelineClock? clock = null, IReferenceClock? referenceClock = null, IReferenceFrameSource? referenceSource = null)
     {
         this.sender = sender ?? throw new ArgumentNullException(nameof(sender));
         configuredFrameRate = frameRate;
         this.options = options ?? throw new ArgumentNullException(nameof(options));
         this.logger = logger;
-        senderRequiresFrameRetention = sender.RequiresFrameRetention;
-        telemetryWarmupDeadline = DateTime.UtcNow + TelemetryWarmupPeriod;
+        this.clock = clock ?? SystemPipelineClock.Instance;
+        asyncRetention = sender.RequiresFrameRetention ? new AsyncSendRetention(sender) : null;
+        if (this.options.IdleOutput.IsEnabled)
+        {
+            duplicateGate = new DuplicateFrameGate(this.options.IdleOutput, Stopwatch.Frequency);
+            if (this.options.IdleOutput.Interval is { } idleInterval)
+            {
+                logger.Information(
+                    "Idle output: after {After:F1} s without a change the page is sent every {Interval:F0} ms until it changes.",
+                    this.options.IdleOutput.After.TotalSeconds,
+                    idleInterval.TotalMilliseconds);
+            }
+        }
+
+        ScheduleTelemetryAfterWarmup();
 
         if (this.options.PacingMode ==
             Tractus.HtmlToNdi.Launcher.PacingMode.Smoothness)
@@ -236,14 +278,88 @@ internal sealed class NdiVideoPipeline : IDisposable
             };
         }
 
+        var depthTuning = this.options.EnableBuffering && this.options.AutoBufferDepth.IsEnabled
+            ? this.options.AutoBufferDepth
+            : null;
+        if (depthTuning is not null && this.options.PacingMode == Tractus.HtmlToNdi.Launcher.PacingMode.Smoothness)
+        {
+            logger.Warning("Automatic buffer depth is unavailable in smoothness pacing; keeping a depth of {Depth}.", this.options.BufferDepth);
+            depthTuning = null;
+        }
+        else if (depthTuning is not null && !this.options.AllowLatencyExpansion)
+        {
+            // Without latency expansion a dip below the low watermark rewarms whatever the depth, so only an expanding
+            // buffer can spend the frames the tuner adds.
+            logger.Information("Automatic buffer depth enables latency expansion.");
+            this.options = this.options with { AllowLatencyExpansion = true };
+        }
+
+        if (this.options.EnableBuffering && (this.options.PacingReference.IsEnabled || this.options.Genlock.IsEnabled))
+        {
+            if (this.options.PacingMode == Tractus.HtmlToNdi.Launcher.PacingMode.Smoothness)
+            {
+                logger.Warning("Phase-locked pacing is unavailable in smoothness pacing; the paced sender free-runs.");
+            }
+            else if (this.options.Genlock.IsEnabled)
+            {
+                if (this.options.PacingReference.IsEnabled)
+                {
+                    logger.Warning("Genlock takes precedence over the {Reference} pacing reference.", this.options.PacingReference.Clock);
+                }
+
+                this.referenceSource = referenceSource ?? new SyntheticReferenceSource(this.clock, this.options.Genlock, frameRate);
+                var follower = new ReferenceFollower(this.referenceSource.Name, this.referenceSource.FrameRate, this.options.Genlock.MaxSlewPpm);
+                phaseLockedCadence = new PhaseLockedCadence(this.clock, follower, frameRate);
+                logger.Information(
+                    "NDI pacer follows the {Reference} genlock reference at {ReferenceFrameRate} fps: slew limit {MaxSlewPpm} ppm.",
+                    follower.Name,
+                    this.referenceSource.FrameRate,
+                    this.options.Genlock.MaxSlewPpm);
+            }
+            else
+            {
+                phaseLockedCadence = new PhaseLockedCadence(
+                    this.clock,
+                    referenceClock ?? SystemReferenceClock.Instance,
+                    frameRate,
+                    this.options.PacingReference.MaxSlewPpm);
+                logger.Information(
+                    "NDI pacer locks to the {Reference} clock: slew limit {MaxSlewPpm} ppm.",
+                    phaseLockedCadence.ReferenceName,
+                    this.options.PacingReference.MaxSlewPpm);
+            }
+        }
+
         var effectiveOptions = this.options;
 
-        targetDepth = Math.Max(1, effectiveOptions.BufferDepth);
+        this.memoryBudget = memoryBudget;
+        this.eventRecorder = eventRecorder;
+        if (effectiveOptions.EnableBuffering && effectiveOptions.SendThreadDepth > 0)
+        {
+            if (asyncRetention is not null)
+            {
+                logger.Warning("Asynchronous NDI sends already return at once; the paced sender sends on its own thread.");
+            }
+            else
+            {
+                sendStage = new NdiSendStage(sender, effectiveOptions.SendThreadDepth, this.clock, eventRecorder, logger);
+                logger.Information("NDI sends run on a dedicated thread with up to {Depth} frames in flight.", effectiveOptions.SendThreadDepth);
+            }
+        }
+        requestedDepth = Math.Max(1, effectiveOptions.BufferDepth);
 
-        // Use 10% hysteresis for deep buffers, but keep tight bounds for shallow ones
-        var hysteresis = Math.Max(1.5, targetDepth * 0.1);
-        lowWatermark = Math.Max(0, targetDepth - hysteresis);
-        highWatermark = targetDepth + Math.Max(1.0, hysteresis);
+        // A tuned buffer reserves frame memory for the deepest depth it may choose.
+        depthCeiling = ReserveFrameMemory(depthTuning is null ? requestedDepth : Math.Max(depthTuning.MaxDepth, depthTuning.MinDepth));
+        targetDepth = depthCeiling;
+        if (depthTuning is not null)
+        {
+            depthTuner = new BufferDepthTuner(depthTuning, requestedDepth, depthCeiling);
+            captureIntervals = new long[BufferDepthTuner.HistogramBuckets];
+            targetDepth = depthTuner.Depth;
+        }
+
+        watermarkHysteresis = effectiveOptions.WatermarkHysteresis;
+        UpdateWatermarks();
 
         allowLatencyExpansion = effectiveOptions.AllowLatencyExpansion && effectiveOptions.EnableBuffering;
         frameInterval = frameRate.FrameDuration;
@@ -292,13 +408,23 @@ internal sealed class NdiVideoPipeline : IDisposable
             directPacedInvalidationEnabled = false;
             captureBackpressureEnabled = false;
         }
-        captureCadenceTracker = new CadenceTracker(frameInterval);
+
+        // Only the native helper weaves fields, so interleaved signalling follows compositor capture.
+        frameFormatType = compositorCaptureEnabled && effectiveOptions.Interlaced
+            ? NDIlib.frame_format_type_e.frame_format_type_interleaved
+            : NDIlib.frame_format_type_e.frame_format_type_progressive;
+        if (effectiveOptions.Interlaced && !compositorCaptureEnabled)
+        {
+            logger.Warning("Interlaced output requires compositor capture; sending progressive frames.");
+        }
+
+        captureCadenceTracker = new CadenceTracker(frameInterval, trackIntervals: depthTuner is not null);
         outputCadenceTracker = new CadenceTracker(frameInterval);
 
         if (options.EnableBuffering)
         {
             ringBuffer = new FrameRingBuffer<NdiVideoFrame>(targetDepth + 1);
-            warmupStarted = DateTime.UtcNow;
+            warmupStarted = this.clock.Elapsed;
         }
         else
         {
@@ -312,6 +438,37 @@ internal sealed class NdiVideoPipeline : IDisposable
     /// </summary>
     public bool BufferingEnabled => options.EnableBuffering;
 
+    /// <summary>
+    /// Gets the buffer depth in use, which is below <see cref="RequestedBufferDepth"/> when the frame-memory budget
+    /// could not hold the requested frames.
+    /// </summary>
+    public int BufferDepth => Volatile.Read(ref targetDepth);
+
+    /// <summary>
+    /// Gets the buffer depth that was configured.
+    /// </summary>
+    public int RequestedBufferDepth => requestedDepth;
+
+    /// <summary>
+    /// Gets the frames delivered to the pipeline.
+    /// </summary>
+    public long CapturedFrames => captureCounters.Read(CapturedCounter);
+
+    /// <summary>
+    /// Gets the fresh frames sent to NDI.
+    /// </summary>
+    public long SentFrames => outputCounters.Read(SentCounter);
+
+    /// <summary>
+    /// Gets the frames re-sent because no fresh frame was ready.
+    /// </summary>
+    public long RepeatedFrames => Volatile.Read(ref repeatedFrames);
+
+    /// <summary>
+    /// Gets how long sent frames waited between capture and the sender, by send path.
+    /// </summary>
+    public SendLatencyMetrics SendLatency => sendLatency.Snapshot();
+
     /// <summary>
     /// Gets the configured frame rate.
     /// </summary>
@@ -363,8 +520,7 @@ internal sealed class NdiVideoPipeline : IDisposable
     /// </summary>
     internal void SkipTelemetryWarmupForTesting()
     {
-        telemetryWarmupDeadline = DateTime.MinValue;
-        lastTelemetry = DateTime.MinValue;
+        nextTelemetryTimestamp = 0;
     }
 
     /// <summary>
@@ -380,6 +536,12 @@ internal sealed class NdiVideoPipeline : IDisposable
 
         ResetBufferingState();
         Volatile.Write(ref pacingResetRequested, true);
+        sendStage?.Start();
+        if (phaseLockedCadence?.Follower is { } follower)
+        {
+            referenceSource?.Start(follower.Post);
+        }
+
         pacingTask = Task.Factory.StartNew(
                 () => RunPacedLoopAsync(cancellation.Token),
                 CancellationToken.None,
@@ -404,14 +566,16 @@ internal sealed class NdiVideoPipeline : IDisposable
             // ignore
         }
 
+        referenceSource?.Stop();
+        sendStage?.Stop();
+        asyncRetention?.Flush();
+
         pacingTask = null;
         bufferPrimed = false;
         isWarmingUp = true;
         Interlocked.Exchange(ref directInvalidationPending, 0);
         ResetInvalidationTickets();
         Interlocked.Exchange(ref pendingInvalidations, 0);
-        lastDirectFrame?.Dispose();
-        lastDirectFrame = null;
     }
 
     /// <summary>
@@ -434,18 +598,20 @@ internal sealed class NdiVideoPipeline : IDisposable
 
     private void HandleFrameInternal(CapturedFrame frame, bool compositorDriven)
     {
-        Interlocked.Increment(ref capturedFrames);
+        captureCounters.Increment(CapturedCounter);
+        eventRecorder?.Record(PipelineEvent.FrameCaptured, compositorDriven ? 1 : 0);
         captureCadenceTracker.Record(frame.MonotonicTimestamp);
         if (compositorDriven)
         {
-            Interlocked.Increment(ref compositorFrames);
+            captureCounters.Increment(CompositorCounter);
         }
         else
         {
-            Interlocked.Increment(ref invalidationFrames);
+            captureCounters.Increment(InvalidationCounter);
             if (!TryConsumePendingInvalidationTicket())
             {
                 Interlocked.Increment(ref spuriousCaptureCount);
+                eventRecorder?.Record(PipelineEvent.Drop, (long)PipelineDropReason.Spurious);
                 frame.Dispose();
                 return;
             }
@@ -484,13 +650,21 @@ internal sealed class NdiVideoPipeline : IDisposable
             return;
         }
 
+        // Hashed here, where the capture is still in cache, so the sender only compares digests.
+        FrameContentHash? hash = duplicateGate is not null ? FrameContentHash.Compute(frame) : null;
         var copy = NdiVideoFrame.CopyFrom(frame);
+        copy.ContentHash = hash;
         frame.Dispose();
         ringBuffer.Enqueue(copy, out var dropped);
-        dropped?.Dispose();
+        if (dropped is not null)
+        {
+            dropped.Dispose();
+            eventRecorder?.Record(PipelineEvent.Drop, (long)PipelineDropReason.Overflow);
+        }
 
         var backlog = ringBuffer.Count;
-        if (Volatile.Read(ref isWarmingUp) && !Volatile.Read(ref latencyExpansionActive) && backlog >= targetDepth)
+        eventRecorder?.Record(PipelineEvent.FrameEnqueued, backlog);
+        if (Volatile.Read(ref isWarmingUp) && !Volatile.Read(ref latencyExpansionActive) && backlog >= Volatile.Read(ref targetDepth))
         {
             ExitWarmup();
         }
@@ -510,6 +684,7 @@ internal sealed class NdiVideoPipeline : IDisposable
         }
 
         frame.Dispose();
+        eventRecorder?.Record(PipelineEvent.Drop, (long)PipelineDropReason.UnsupportedStorage);
         var dropCount = Interlocked.Increment(ref unsupportedStorageDrops);
         if (dropCount <= 3 || dropCount % 50 == 0)
         {
@@ -530,9 +705,9 @@ internal sealed class NdiVideoPipeline : IDisposable
 
     private Task RunPacedLoopAsync(CancellationToken token)
     {
+        using var threadPolicy = ThreadPolicyScope.Apply(options.ThreadPolicy, "Paced sender", logger);
         using var highResolutionTimer = HighResolutionWaitableTimer.TryCreate(logger);
-        var pacingClock = Stopwatch.StartNew();
-        var pacingOrigin = pacingClock.Elapsed;
+        var pacingOrigin = clock.Elapsed;
         long pacingSequence = 0;
 
         while (!token.IsCancellationRequested)
@@ -541,15 +716,18 @@ internal sealed class NdiVideoPipeline : IDisposable
 
             if (Volatile.Read(ref pacingResetRequested))
             {
-                pacingOrigin = pacingClock.Elapsed;
+                pacingOrigin = clock.Elapsed;
                 pacingSequence = 0;
+                phaseLockedCadence?.Restart();
                 Volatile.Write(ref pacingResetRequested, false);
             }
 
             var nextSequence = pacingSequence + 1;
-            var deadline = CalculateNextDeadline(pacingOrigin, nextSequence);
+            var deadline = phaseLockedCadence is not null
+                ? NextPhaseLockedDeadline(phaseLockedCadence)
+                : CalculateNextDeadline(pacingOrigin, nextSequence);
 
-            TimingHelpers.WaitUntil(pacingClock, deadline, token, highResolutionTimer);
+            clock.WaitUntil(deadline, token, highResolutionTimer);
 
             if (token.IsCancellationRequested)
             {
@@ -557,17 +735,47 @@ internal sealed class NdiVideoPipeline : IDisposable
             }
 
             var sent = TrySendBufferedFrame();
+            framesTakenByLastTick = sent ? 1 : 0;
             if (!sent && lastSentFrame is not null)
             {
                 RepeatLastFrame();
             }
 
+            if (depthTuner is not null)
+            {
+                ShrinkRingTowardTarget();
+                TuneBufferDepth();
+            }
+
             pacingSequence = nextSequence;
         }
 
         return Task.CompletedTask;
     }
 
+    /// <summary>
+    /// Takes the next deadline from the reference grid, logging each change of lock state.
+    /// </summary>
+    private TimeSpan NextPhaseLockedDeadline(PhaseLockedCadence cadence)
+    {
+        var previousState = cadence.Lock.State;
+        var deadline = cadence.NextDeadline();
+        var state = cadence.Lock.State;
+        if (state != previousState)
+        {
+            logger.Information(
+                "NDI pacer reference lock {PreviousState} -> {State}: phaseErrorUs={PhaseErrorUs:F1}, frequencyPpm={FrequencyPpm:F2}, steps={Steps}, frame={Frame}",
+                previousState,
+                state,
+                cadence.Lock.PhaseError.TotalMicroseconds,
+                cadence.Lock.FrequencyPpm,
+                cadence.Lock.Steps,
+                cadence.FrameNumber);
+        }
+
+        return deadline;
+    }
+
     private TimeSpan CalculateNextDeadline(TimeSpan origin, long nextSequence)
     {
         Volatile.Write(ref lastPacingOffsetTicks, 0);
@@ -602,12 +810,15 @@ internal sealed class NdiVideoPipeline : IDisposable
             return baseline;
         }
 
-        var backlogError = targetDepth - backlog;
+        // Count the frame the last tick took back in: straight after a send the ring reads one short, which would
+        // otherwise hold every deadline of a balanced source late.
+        var tickBacklog = backlog + framesTakenByLastTick;
+        var backlogError = targetDepth - tickBacklog;
         var normalized = Math.Clamp(backlogError / (double)targetDepth, -1.5d, 1.5d);
         var integral = Math.Clamp(-Volatile.Read(ref latencyError) / Math.Max(1d, targetDepth), -2d, 2d);
         var adjustmentFactor = normalized + (integral * 0.2d);
         var cadenceAdjustment = CalculateCadenceAlignmentOffset();
-        if (Math.Abs(backlog - targetDepth) >= 1)
+        if (Math.Abs(tickBacklog - targetDepth) >= 1)
         {
             cadenceAdjustment = 0d;
             Interlocked.Exchange(ref cadenceAlignmentDeltaFrames, 0d);
@@ -983,6 +1194,8 @@ internal sealed class NdiVideoPipeline : IDisposable
             {
                 invalidationTickets.Enqueue(newTicket);
             }
+
+            eventRecorder?.Record(PipelineEvent.TicketIssued, pending + 1);
             ScheduleTicketExpiration(newTicket);
             ticket = newTicket;
             return true;
@@ -1179,6 +1392,7 @@ internal sealed class NdiVideoPipeline : IDisposable
         if (outcome == InvalidationTicketOutcome.Expired)
         {
             Interlocked.Increment(ref expiredInvalidationTickets);
+            eventRecorder?.Record(PipelineEvent.TicketExpired, Volatile.Read(ref pendingInvalidations));
             HandleExpiredTicket();
         }
     }
@@ -1496,11 +1710,6 @@ internal sealed class NdiVideoPipeline : IDisposable
             {
                 if (backlog >= targetDepth)
                 {
-                    if (latencyError < 0)
-                    {
-                        latencyError = 0;
-                    }
-
                     ExitWarmup();
                     backlog = ringBuffer.Count;
                     delta = backlog - targetDepth;
@@ -1513,11 +1722,6 @@ internal sealed class NdiVideoPipeline : IDisposable
             }
             else if (backlog >= targetDepth)
             {
-                if (latencyError < 0)
-                {
-                    latencyError = 0;
-                }
-
                 ExitWarmup();
                 backlog = ringBuffer.Count;
                 delta = backlog - targetDepth;
@@ -1592,6 +1796,7 @@ internal sealed class NdiVideoPipeline : IDisposable
                 latencyError -= 1;
                 droppedThisTick++;
                 Interlocked.Increment(ref latencyResyncDrops);
+                eventRecorder?.Record(PipelineEvent.Drop, (long)PipelineDropReason.Resync);
             }
 
             if (droppedThisTick > 0)
@@ -1610,9 +1815,10 @@ internal sealed class NdiVideoPipeline : IDisposable
 
         if (ringBuffer.TryDequeue(out var frame) && frame is not null)
         {
-            SendBufferedFrame(frame);
+            var expanding = latencyExpansionActive || allowSendWhileWarming;
+            SendBufferedFrame(frame, expanding ? FrameSendPath.LatencyExpansion : FrameSendPath.Buffered);
             EnsureCaptureDemand(ringBuffer.Count);
-            if (latencyExpansionActive || allowSendWhileWarming)
+            if (expanding)
             {
                 Interlocked.Increment(ref latencyExpansionFramesServed);
             }
@@ -1631,40 +1837,73 @@ internal sealed class NdiVideoPipeline : IDisposable
             return;
         }
 
+        if (duplicateGate is not null && !duplicateGate.ShouldSend(FrameContentHash.Compute(frame), clock.GetTimestamp(), frame.SizeInBytes))
+        {
+            frame.Dispose();
+            EmitTelemetryIfNeeded();
+            return;
+        }
+
         var timestamp = frame.TimestampUtc != default ? frame.TimestampUtc : DateTime.UtcNow;
         var (numerator, denominator) = ResolveFrameRate(timestamp);
 
-        var ndiFrame = CreateVideoFrame(frame, numerator, denominator);
-        sender.Send(ref ndiFrame);
-        Interlocked.Increment(ref sentFrames);
+        eventRecorder?.Record(PipelineEvent.SendBegin);
+        sendLatency.Record(FrameSendPath.Direct, frame.MonotonicTimestamp, clock.GetTimestamp());
+        if (asyncRetention is not null)
+        {
+            // Chromium's paint buffer and the helper's output buffers are rewritten by the next frame, while NDI reads
+            // an asynchronous send until the next one returns, so the retention holds a copy instead.
+            var copy = NdiVideoFrame.CopyFrom(frame);
+            frame.Dispose();
+            var ndiFrame = CreateVideoFrame(copy, numerator, denominator);
+            try
+            {
+                asyncRetention.Send(copy, ref ndiFrame);
+            }
+            finally
+            {
+                // The retention's send reference keeps the copy alive until NDI is done with it.
+                copy.Dispose();
+            }
+        }
+        else
+        {
+            var ndiFrame = CreateVideoFrame(frame, numerator, denominator);
+            sender.Send(ref ndiFrame);
+            frame.Dispose();
+        }
+        eventRecorder?.Record(PipelineEvent.SendEnd);
+        outputCounters.Increment(SentCounter);
         if (cadenceTrackingEnabled)
         {
-            outputCadenceTracker.Record(Stopwatch.GetTimestamp());
+            outputCadenceTracker.Record(clock.GetTimestamp());
         }
         EmitTelemetryIfNeeded();
+    }
 
-        if (senderRequiresFrameRetention)
+    private void SendBufferedFrame(NdiVideoFrame frame, FrameSendPath path = FrameSendPath.Buffered)
+    {
+        if (!ShouldSendPaced(frame))
         {
-            var frameToDispose = lastDirectFrame;
-            lastDirectFrame = frame;
-            frameToDispose?.Dispose();
+            // A skipped frame is still the picture on the receivers, so it is the one a repeat would send.
+            lastSentFrame?.Dispose();
+            lastSentFrame = frame;
+            EmitTelemetryIfNeeded();
             return;
         }
 
-        frame.Dispose();
-    }
-
-    private void SendBufferedFrame(NdiVideoFrame frame)
-    {
         var (numerator, denominator) = ResolveFrameRate(frame.Timestamp);
 
         var ndiFrame = CreateVideoFrame(frame, numerator, denominator);
-        sender.Send(ref ndiFrame);
-
-        Interlocked.Increment(ref sentFrames);
-        if (cadenceTrackingEnabled)
+        var handedOver = clock.GetTimestamp();
+        if (SendPaced(frame, ref ndiFrame))
         {
-            outputCadenceTracker.Record(Stopwatch.GetTimestamp());
+            sendLatency.Record(path, frame.MonotonicTimestamp, handedOver);
+            outputCounters.Increment(SentCounter);
+            if (cadenceTrackingEnabled)
+            {
+                outputCadenceTracker.Record(clock.GetTimestamp());
+            }
         }
 
         lastSentFrame?.Dispose();
@@ -1673,6 +1912,43 @@ internal sealed class NdiVideoPipeline : IDisposable
         EmitTelemetryIfNeeded();
     }
 
+    /// <summary>
+    /// Sends a frame from the paced sender: on this thread, or handed to the send thread when there is one. The
+    /// latency recorded by the caller runs to the hand-over; the send thread times its queue and send separately. An
+    /// asynchronous send is retained, so replacing or disposing the frame afterwards leaves its buffer to NDI.
+    /// </summary>
+    /// <returns>
+    /// <c>true</c> when the frame was sent or handed over; <c>false</c> when the pipeline stopped while waiting for a
+    /// send-thread slot, in which case the caller must not count it.
+    /// </returns>
+    private bool SendPaced(NdiVideoFrame frame, ref NDIlib.video_frame_v2_t ndiFrame)
+    {
+        if (sendStage is not null)
+        {
+            return sendStage.Enqueue(frame, ndiFrame, cancellation.Token);
+        }
+
+        eventRecorder?.Record(PipelineEvent.SendBegin);
+        if (asyncRetention is not null)
+        {
+            asyncRetention.Send(frame, ref ndiFrame);
+        }
+        else
+        {
+            sender.Send(ref ndiFrame);
+        }
+        eventRecorder?.Record(PipelineEvent.SendEnd);
+        return true;
+    }
+
+    /// <summary>
+    /// Asks the duplicate gate whether a paced frame goes out. Without idle output every frame does.
+    /// </summary>
+    private bool ShouldSendPaced(NdiVideoFrame frame)
+    {
+        return duplicateGate is null || duplicateGate.ShouldSend(frame.ContentHash, clock.GetTimestamp(), (long)frame.Stride * frame.Height);
+    }
+
     private void RepeatLastFrame()
     {
         if (lastSentFrame is null)
@@ -1685,12 +1961,26 @@ internal sealed class NdiVideoPipeline : IDisposable
             Interlocked.Increment(ref currentWarmupRepeatTicks);
         }
 
+        if (!ShouldSendPaced(lastSentFrame))
+        {
+            EmitTelemetryIfNeeded();
+            return;
+        }
+
         var ndiFrame = CreateVideoFrame(lastSentFrame, configuredFrameRate.Numerator, configuredFrameRate.Denominator);
-        sender.Send(ref ndiFrame);
-        Interlocked.Increment(ref repeatedFrames);
+        eventRecorder?.Record(PipelineEvent.Repeat);
+        var handedOver = clock.GetTimestamp();
+        if (!SendPaced(lastSentFrame, ref ndiFrame))
+        {
+            return;
+        }
+
+        sendLatency.Record(FrameSendPath.Repeated, lastSentFrame.MonotonicTimestamp, handedOver);
+        // Only the paced sender repeats frames.
+        Volatile.Write(ref repeatedFrames, repeatedFrames + 1);
         if (cadenceTrackingEnabled)
         {
-            outputCadenceTracker.Record(Stopwatch.GetTimestamp());
+            outputCadenceTracker.Record(clock.GetTimestamp());
         }
         EmitTelemetryIfNeeded();
     }
@@ -1708,6 +1998,7 @@ internal sealed class NdiVideoPipeline : IDisposable
         if (!isWarmingUp && hasPrimedOnce && lastSentFrame is not null)
         {
             Interlocked.Increment(ref underruns);
+            eventRecorder?.Record(PipelineEvent.Underrun, backlog);
 
             if (preserving)
             {
@@ -1726,9 +2017,14 @@ internal sealed class NdiVideoPipeline : IDisposable
             }
         }
 
+        if (!isWarmingUp)
+        {
+            eventRecorder?.Record(PipelineEvent.WarmupEnter, backlog);
+        }
+
         bufferPrimed = false;
         isWarmingUp = true;
-        warmupStarted = DateTime.UtcNow;
+        warmupStarted = clock.Elapsed;
         consecutiveLowBacklogTicks = 0;
         Interlocked.Exchange(ref currentWarmupRepeatTicks, 0);
 
@@ -1761,10 +2057,19 @@ internal sealed class NdiVideoPipeline : IDisposable
         isWarmingUp = false;
         bufferPrimed = true;
         hasPrimedOnce = true;
+
+        // The warmup debt only measures how long priming took. Clearing it here covers the capture thread's exit as
+        // well as the pacer's, so a ring primed by HandleFrame does not start out skewing the pacing deadlines.
+        if (latencyError < 0)
+        {
+            latencyError = 0;
+        }
+
+        eventRecorder?.Record(PipelineEvent.WarmupExit, ringBuffer?.Count ?? 0);
         consecutiveLowBacklogTicks = 0;
         latencyExpansionActive = false;
 
-        var now = DateTime.UtcNow;
+        var now = clock.Elapsed;
         var duration = now - warmupStarted;
         if (duration < TimeSpan.Zero)
         {
@@ -1792,6 +2097,90 @@ internal sealed class NdiVideoPipeline : IDisposable
         }
     }
 
+    /// <summary>
+    /// Once a second, lets the depth tuner weigh the capture gaps and starved ticks since its last look, and applies
+    /// any depth it picks.
+    /// </summary>
+    private void TuneBufferDepth()
+    {
+        var now = clock.Elapsed;
+        if (now < nextDepthEvaluation || depthTuner is null || captureIntervals is null)
+        {
+            return;
+        }
+
+        nextDepthEvaluation = now + BufferDepthTuner.EvaluationInterval;
+        captureCadenceTracker.DrainIntervalHistogram(captureIntervals);
+        var decision = depthTuner.Evaluate(captureIntervals, Volatile.Read(ref repeatedFrames), SentFrames + RepeatedFrames);
+        if (decision is not { } change)
+        {
+            return;
+        }
+
+        SetBufferDepth(change.Depth);
+        logger.Information(
+            "NDI pacer buffer depth {PreviousDepth} -> {Depth} ({Reason}): requiredDepth={RequiredDepth}, starvedProbability={StarvedProbability:G3}, buffered={Buffered}",
+            change.PreviousDepth,
+            change.Depth,
+            change.Reason,
+            change.RequiredDepth,
+            change.StarvedProbability,
+            ringBuffer?.Count ?? 0);
+    }
+
+    /// <summary>
+    /// Moves the target depth and its watermarks. A deeper ring grows at once; a shallower one keeps its queued frames
+    /// and shrinks only as the pacer drains them, since dropping the oldest would skip the picture. A one-frame step
+    /// stays inside the watermark hysteresis, so the pacer absorbs it through its deadline adjustments instead of
+    /// rewarming or resyncing.
+    /// </summary>
+    private void SetBufferDepth(int depth)
+    {
+        Volatile.Write(ref targetDepth, depth);
+        UpdateWatermarks();
+        if (latencyError < -depth)
+        {
+            latencyError = -depth;
+        }
+
+        if (ringBuffer is null)
+        {
+            return;
+        }
+
+        var capacity = depth + 1;
+        if (capacity >= ringBuffer.Capacity)
+        {
+            pendingRingCapacity = 0;
+            ringBuffer.Resize(capacity);
+            return;
+        }
+
+        pendingRingCapacity = capacity;
+        ShrinkRingTowardTarget();
+    }
+
+    /// <summary>
+    /// Steps the ring's capacity down toward a lowered depth as frames leave it, without dropping any.
+    /// </summary>
+    private void ShrinkRingTowardTarget()
+    {
+        if (pendingRingCapacity > 0 && ringBuffer is not null && ringBuffer.ShrinkToward(pendingRingCapacity) == pendingRingCapacity)
+        {
+            pendingRingCapacity = 0;
+        }
+    }
+
+    private void UpdateWatermarks()
+    {
+        // Use 10% hysteresis for deep buffers, but keep tight bounds for shallow ones
+        var hysteresis = watermarkHysteresis is { } configuredHysteresis
+            ? Math.Max(0d, configuredHysteresis)
+            : Math.Max(1.5, targetDepth * 0.1);
+        lowWatermark = Math.Max(0, targetDepth - hysteresis);
+        highWatermark = targetDepth + Math.Max(1.0, hysteresis);
+    }
+
     private void ResetBufferingState()
     {
         captureCadenceTracker.Reset();
@@ -1804,9 +2193,9 @@ internal sealed class NdiVideoPipeline : IDisposable
         bufferPrimed = false;
         isWarmingUp = true;
         hasPrimedOnce = false;
-        warmupStarted = DateTime.UtcNow;
-        telemetryWarmupDeadline = DateTime.UtcNow + TelemetryWarmupPeriod;
-        lastTelemetry = DateTime.UtcNow;
+        warmupStarted = clock.Elapsed;
+        eventRecorder?.Record(PipelineEvent.WarmupEnter, ringBuffer?.Count ?? 0);
+        ScheduleTelemetryAfterWarmup();
         latencyError = 0;
         consecutiveLowBacklogTicks = 0;
         latencyExpansionActive = false;
@@ -1861,6 +2250,41 @@ internal sealed class NdiVideoPipeline : IDisposable
 
     internal long SpuriousCaptureCount => Interlocked.Read(ref spuriousCaptureCount);
 
+    /// <summary>
+    /// Copies the pipeline's counters and gauges. Safe to call from any thread.
+    /// </summary>
+    /// <returns>The current values.</returns>
+    internal PipelineMetrics GetMetrics()
+    {
+        return new PipelineMetrics(
+            captureCounters.Read(CapturedCounter),
+            outputCounters.Read(SentCounter),
+            Volatile.Read(ref repeatedFrames),
+            Interlocked.Read(ref underruns),
+            Interlocked.Read(ref warmupCycles),
+            ringBuffer?.DroppedFromOverflow ?? 0,
+            ringBuffer?.DroppedAsStale ?? 0,
+            Interlocked.Read(ref latencyResyncDrops),
+            Interlocked.Read(ref spuriousCaptureCount),
+            ringBuffer?.Count ?? 0,
+            targetDepth,
+            BufferPrimed,
+            Volatile.Read(ref latencyError),
+            phaseLockedCadence is null
+                ? null
+                : new ReferenceLockMetrics(
+                    phaseLockedCadence.Lock.State,
+                    phaseLockedCadence.Lock.PhaseError.TotalSeconds,
+                    phaseLockedCadence.Lock.FrequencyPpm,
+                    phaseLockedCadence.Lock.Steps,
+                    phaseLockedCadence.SkippedSlots,
+                    phaseLockedCadence.Follower?.Arrivals,
+                    phaseLockedCadence.Follower?.MissedFrames),
+            sendLatency.Snapshot(),
+            sendStage?.GetMetrics(),
+            duplicateGate?.GetMetrics());
+    }
+
     private (int numerator, int denominator) ResolveFrameRate(DateTime _)
     {
         return (configuredFrameRate.Numerator, configuredFrameRate.Denominator);
@@ -1870,6 +2294,7 @@ internal sealed class NdiVideoPipeline : IDisposable
     {
         private readonly double targetIntervalTicks;
         private readonly object gate = new();
+        private readonly long[]? intervalHistogram;
         private long originTimestamp;
         private bool hasOrigin;
         private long lastTimestamp;
@@ -1879,9 +2304,10 @@ internal sealed class NdiVideoPipeline : IDisposable
         private double maxIntervalErrorTicks;
         private double minIntervalErrorTicks;
 
-        public CadenceTracker(TimeSpan targetInterval)
+        public CadenceTracker(TimeSpan targetInterval, bool trackIntervals = false)
         {
             targetIntervalTicks = Math.Max(1, targetInterval.Ticks);
+            intervalHistogram = trackIntervals ? new long[BufferDepthTuner.HistogramBuckets] : null;
             Reset();
         }
 
@@ -1897,6 +2323,10 @@ internal sealed class NdiVideoPipeline : IDisposable
                 sumSquaredIntervalErrorTicks = 0;
                 maxIntervalErrorTicks = 0;
                 minIntervalErrorTicks = 0;
+                if (intervalHistogram is not null)
+                {
+                    Array.Clear(intervalHistogram);
+                }
             }
         }
 
@@ -1941,11 +2371,35 @@ internal sealed class NdiVideoPipeline : IDisposable
 
                 intervalSamples++;
                 sumSquaredIntervalErrorTicks += intervalError * intervalError;
+                if (intervalHistogram is not null)
+                {
+                    intervalHistogram[BufferDepthTuner.BucketOf(intervalTicks / targetIntervalTicks)]++;
+                }
+
                 lastTimestamp = timestamp;
                 lastRelativeTicks = relativeTicks;
             }
         }
 
+        /// <summary>
+        /// Copies the intervals recorded since the last drain, bucketed for <see cref="BufferDepthTuner"/>, and
+        /// starts counting afresh.
+        /// </summary>
+        public void DrainIntervalHistogram(long[] destination)
+        {
+            lock (gate)
+            {
+                if (intervalHistogram is null)
+                {
+                    Array.Clear(destination);
+                    return;
+                }
+
+                Array.Copy(intervalHistogram, destination, Math.Min(destination.Length, intervalHistogram.Length));
+                Array.Clear(intervalHistogram);
+            }
+        }
+
         public double GetDriftFrames()
         {
             lock (gate)
@@ -2033,14 +2487,14 @@ internal sealed class NdiVideoPipeline : IDisposable
         public double DriftFrames => IntervalSamples == 0 || TargetIntervalTicks == 0 ? 0 : DriftTicks / TargetIntervalTicks;
     }
 
-    private static NDIlib.video_frame_v2_t CreateVideoFrame(NdiVideoFrame frame, int numerator, int denominator)
+    private NDIlib.video_frame_v2_t CreateVideoFrame(NdiVideoFrame frame, int numerator, int denominator)
     {
         return new NDIlib.video_frame_v2_t
         {
             FourCC = NDIlib.FourCC_type_e.FourCC_type_BGRA,
             frame_rate_N = numerator,
             frame_rate_D = denominator,
-            frame_format_type = NDIlib.frame_format_type_e.frame_format_type_progressive,
+            frame_format_type = frameFormatType,
             line_stride_in_bytes = frame.Stride,
             picture_aspect_ratio = frame.Width / (float)frame.Height,
             p_data = frame.Buffer,
@@ -2050,14 +2504,14 @@ internal sealed class NdiVideoPipeline : IDisposable
         };
     }
 
-    private static NDIlib.video_frame_v2_t CreateVideoFrame(CapturedFrame frame, int numerator, int denominator)
+    private NDIlib.video_frame_v2_t CreateVideoFrame(CapturedFrame frame, int numerator, int denominator)
     {
         return new NDIlib.video_frame_v2_t
         {
             FourCC = NDIlib.FourCC_type_e.FourCC_type_BGRA,
             frame_rate_N = numerator,
             frame_rate_D = denominator,
-            frame_format_type = NDIlib.frame_format_type_e.frame_format_type_progressive,
+            frame_format_type = frameFormatType,
             line_stride_in_bytes = frame.Stride,
             picture_aspect_ratio = frame.Width / (float)frame.Height,
             p_data = frame.Buffer,
@@ -2113,15 +2567,22 @@ internal sealed class NdiVideoPipeline : IDisposable
         return true;
     }
 
-    private void EmitTelemetryIfNeeded([CallerMemberName] string? caller = null)
+    /// <summary>
+    /// Holds telemetry back until the warmup period and the first interval have both passed.
+    /// </summary>
+    private void ScheduleTelemetryAfterWarmup()
     {
-        var now = DateTime.UtcNow;
-        if (now < telemetryWarmupDeadline)
-        {
-            return;
-        }
+        var delay = options.TelemetryInterval > TelemetryWarmupPeriod ? options.TelemetryInterval : TelemetryWarmupPeriod;
+        nextTelemetryTimestamp = clock.GetTimestamp() + ToStopwatchTicks(delay);
+    }
 
-        if (now - lastTelemetry < options.TelemetryInterval)
+    private static long ToStopwatchTicks(TimeSpan interval) => (long)(interval.TotalSeconds * Stopwatch.Frequency);
+
+    private void EmitTelemetryIfNeeded([CallerMemberName] string? caller = null)
+    {
+        // Runs for every frame sent, so the common case is a single monotonic counter read and compare.
+        var now = clock.GetTimestamp();
+        if (now < nextTelemetryTimestamp)
         {
             return;
         }
@@ -2132,7 +2593,7 @@ internal sealed class NdiVideoPipeline : IDisposable
             return;
         }
 
-        lastTelemetry = now;
+        nextTelemetryTimestamp = now + ToStopwatchTicks(options.TelemetryInterval);
 
         var bufferStats = BufferingEnabled && ringBuffer is not null
             ? $", primed={bufferPrimed}, buffered={ringBuffer.Count}, droppedOverflow={ringBuffer.DroppedFromOverflow}, droppedStale={ringBuffer.DroppedAsStale}, underruns={Interlocked.Read(ref underruns)}, warmups={Interlocked.Read(ref warmupCycles)}, lastWarmupMs={ComputeLastWarmupMilliseconds():F1}, lastWarmupRepeats={Interlocked.Read(ref lastWarmupRepeatTicks)}, lowWaterHits={Interlocked.Read(ref lowWatermarkHits)}, highWaterHits={Interlocked.Read(ref highWatermarkHits)}, resyncDrops={Interlocked.Read(ref latencyResyncDrops)}, latencyError={Volatile.Read(ref latencyError):F2}"
@@ -2141,6 +2602,42 @@ internal sealed class NdiVideoPipeline : IDisposable
         {
             bufferStats += $", latencyExpansionSessions={Interlocked.Read(ref latencyExpansionSessions)}, latencyExpansionTicks={Interlocked.Read(ref latencyExpansionTicks)}, latencyExpansionFrames={Interlocked.Read(ref latencyExpansionFramesServed)}";
         }
+        if (BufferingEnabled && depthTuner is not null)
+        {
+            bufferStats += $", bufferDepth={targetDepth}, autoBufferDepth={depthTuner.MinDepth}-{depthTuner.MaxDepth}, bufferDepthChanges={depthTuner.Changes}";
+            if (depthCeiling < options.AutoBufferDepth.MaxDepth)
+            {
+                bufferStats += ", bufferDepthLimitedByMemoryBudget=true";
+            }
+        }
+        else if (BufferingEnabled && targetDepth < requestedDepth)
+        {
+            bufferStats += $", bufferDepth={targetDepth}, requestedBufferDepth={requestedDepth}, bufferDepthLimitedByMemoryBudget=true";
+        }
+        if (phaseLockedCadence is not null)
+        {
+            var referenceLock = phaseLockedCadence.Lock;
+            bufferStats += System.FormattableString.Invariant(
+                $", pacingReference={phaseLockedCadence.ReferenceName}, referenceLock={referenceLock.State}, referencePhaseErrorUs={referenceLock.PhaseError.TotalMicroseconds:F1}, referenceFrequencyPpm={referenceLock.FrequencyPpm:F2}, referenceSteps={referenceLock.Steps}, referenceSkippedSlots={phaseLockedCadence.SkippedSlots}, referenceRejectedSamples={referenceLock.RejectedSamples}");
+            if (phaseLockedCadence.Follower is { } follower)
+            {
+                bufferStats += $", referenceArrivals={follower.Arrivals}, referenceMissedFrames={follower.MissedFrames}, referenceDroppedArrivals={follower.DroppedArrivals}";
+            }
+        }
+        if (sendStage is not null)
+        {
+            var stage = sendStage.GetMetrics();
+            var meanQueueMs = stage.Frames == 0 ? 0 : stage.QueueSeconds * 1000d / stage.Frames;
+            var meanSendMs = stage.Frames == 0 ? 0 : stage.SendSeconds * 1000d / stage.Frames;
+            bufferStats += System.FormattableString.Invariant(
+                $", sendThreadInFlight={stage.InFlight}/{stage.MaxInFlight}, sendThreadStalls={stage.Stalls}, sendThreadFailures={stage.Failures}, sendThreadQueueMs={meanQueueMs:F2}, sendThreadQueueMaxMs={stage.MaxQueueSeconds * 1000d:F2}, sendThreadSendMs={meanSendMs:F2}, sendThreadSendMaxMs={stage.MaxSendSeconds * 1000d:F2}");
+        }
+        if (duplicateGate is not null)
+        {
+            var duplicates = duplicateGate.GetMetrics();
+            bufferStats += System.FormattableString.Invariant(
+                $", duplicateFrames={duplicates.DuplicateFrames}, idle={duplicates.Idle}, idleEntries={duplicates.IdleEntries}, idleSuppressedFrames={duplicates.SuppressedFrames}, idleSavedMB={duplicates.SuppressedBytes / 1_000_000d:F1}");
+        }
         if (captureBackpressureEnabled)
         {
             bufferStats += $", captureGateActive={captureGateActive}, captureGatePauses={Interlocked.Read(ref captureGatePauses)}, captureGateResumes={Interlocked.Read(ref captureGateResumes)}";
@@ -2193,21 +2690,29 @@ internal sealed class NdiVideoPipeline : IDisposable
                 $", captureJitterRmsMs={captureSnapshot.IntervalRmsMilliseconds:F4}, captureJitterPkMs={captureSnapshot.PeakIntervalErrorMilliseconds:F4}, captureDriftMs={captureSnapshot.DriftMilliseconds:F4}, captureIntervals={captureSnapshot.IntervalSamples}, outputJitterRmsMs={outputSnapshot.IntervalRmsMilliseconds:F4}, outputJitterPkMs={outputSnapshot.PeakIntervalErrorMilliseconds:F4}, outputDriftMs={outputSnapshot.DriftMilliseconds:F4}, outputIntervals={outputSnapshot.IntervalSamples}, driftDeltaFrames={alignmentDelta:F4}");
         }
 
+        var latencyStats = string.Empty;
+        foreach (var histogram in sendLatency.Snapshot().RecordedPaths())
+        {
+            latencyStats += System.FormattableString.Invariant(
+                $", sendLatency{histogram.Path}P50Ms={histogram.P50Milliseconds:F2}, sendLatency{histogram.Path}P99Ms={histogram.P99Milliseconds:F2}, sendLatency{histogram.Path}MaxMs={histogram.MaxMicroseconds / 1000d:F2}");
+        }
+
         var compositorStats = System.FormattableString.Invariant(
-            $", compositorCapture={compositorCaptureEnabled}, compositorFrames={Interlocked.Read(ref compositorFrames)}, legacyInvalidationFrames={Interlocked.Read(ref invalidationFrames)}");
+            $", compositorCapture={compositorCaptureEnabled}, compositorFrames={captureCounters.Read(CompositorCounter)}, legacyInvalidationFrames={captureCounters.Read(InvalidationCounter)}");
 
         var clockPrecisionNs = 1_000_000_000d / Stopwatch.Frequency;
         var clockStats = System.FormattableString.Invariant(
             $", clockPrecisionNs={clockPrecisionNs:F3}, stopwatchHighResolution={Stopwatch.IsHighResolution}");
 
         logger.Information(
-            "NDI video pipeline stats: captured={Captured}, sent={Sent}, repeated={Repeated}{BufferStats}{PacingStats}{CadenceStats}{CompositorStats}{ClockStats} (caller={Caller})",
-            Interlocked.Read(ref capturedFrames),
-            Interlocked.Read(ref sentFrames),
-            Interlocked.Read(ref repeatedFrames),
+            "NDI video pipeline stats: captured={Captured}, sent={Sent}, repeated={Repeated}{BufferStats}{PacingStats}{CadenceStats}{LatencyStats}{CompositorStats}{ClockStats} (caller={Caller})",
+            captureCounters.Read(CapturedCounter),
+            outputCounters.Read(SentCounter),
+            Volatile.Read(ref repeatedFrames),
             bufferStats,
             pacingStats,
             cadenceStats,
+            latencyStats,
             compositorStats,
             clockStats,
             caller);
@@ -2219,9 +2724,65 @@ internal sealed class NdiVideoPipeline : IDisposable
     public void Dispose()
     {
         Stop();
+        sendStage?.Dispose();
         ringBuffer?.Clear();
         lastSentFrame?.Dispose();
-        lastDirectFrame?.Dispose();
         cancellation.Dispose();
+
+        var reserved = Interlocked.Exchange(ref reservedFrameBytes, 0);
+        if (reserved > 0)
+        {
+            memoryBudget!.Release(reserved);
+        }
+    }
+
+    /// <summary>
+    /// Charges the frames the pipeline holds to the frame-memory budget, shallowing the buffer one frame at a time
+    /// until they fit. A single frame is always charged so the pipeline can run; it then only counts against the
+    /// headroom of later reservations.
+    /// </summary>
+    /// <param name="depth">The configured buffer depth.</param>
+    /// <returns>The buffer depth the budget allows.</returns>
+    private int ReserveFrameMemory(int depth)
+    {
+        var frameBytes = options.FrameBytes;
+        if (memoryBudget is null || frameBytes <= 0)
+        {
+            return depth;
+        }
+
+        if (!options.EnableBuffering)
+        {
+            // Direct sends hold only the last frame for repeats.
+            memoryBudget.Reserve(frameBytes);
+            reservedFrameBytes = frameBytes;
+            return depth;
+        }
+
+        var granted = depth;
+        while (granted > 1 && !memoryBudget.TryReserve(HeldFrames(granted) * frameBytes))
+        {
+            granted--;
+        }
+
+        if (granted == 1)
+        {
+            memoryBudget.Reserve(HeldFrames(1) * frameBytes);
+        }
+
+        reservedFrameBytes = HeldFrames(granted) * frameBytes;
+        if (granted < depth)
+        {
+            logger.Warning(
+                "Frame memory budget cannot hold {Requested} buffered frames of {FrameBytes} bytes; buffer depth reduced to {Depth}",
+                depth,
+                frameBytes,
+                granted);
+        }
+
+        return granted;
+
+        // The ring holds one frame beyond the depth, and the last sent frame is kept for repeats.
+        static long HeldFrames(int bufferDepth) => bufferDepth + 2L;
     }
 }
@@ -15,6 +15,38 @@ internal sealed record NdiVideoPipelineOptions
     /// </summary>
     public int BufferDepth { get; init; } = 3;
 
+    /// <summary>
+    /// Gets or sets how many frames the low watermark sits below <see cref="BufferDepth"/>; the high watermark sits as
+    /// far above it, but at least one frame. <c>null</c> uses 10% of the depth, but at least 1.5 frames.
+    /// </summary>
+    public double? WatermarkHysteresis { get; init; }
+
+    /// <summary>
+    /// Gets or sets the range and underrun target within which the pacer tunes its own depth, starting from
+    /// <see cref="BufferDepth"/>. Tuning implies latency expansion and is ignored in smoothness pacing.
+    /// </summary>
+    public BufferDepthTuning AutoBufferDepth { get; init; } = BufferDepthTuning.Disabled;
+
+    /// <summary>
+    /// Gets or sets the timebase the paced sender locks its ticks to, so machines on the same time source send in
+    /// phase. Locked ticks stay on the reference's frame grid, so the backlog is steered by drops and repeats rather
+    /// than by moving ticks. Ignored in smoothness pacing.
+    /// </summary>
+    public PacingReference PacingReference { get; init; } = PacingReference.Disabled;
+
+    /// <summary>
+    /// Gets or sets the genlock reference whose frame arrivals the paced sender follows, as a hardware output follows
+    /// its genlock input. Takes precedence over <see cref="PacingReference"/>; ignored in smoothness pacing.
+    /// </summary>
+    public GenlockReference Genlock { get; init; } = GenlockReference.Disabled;
+
+    /// <summary>
+    /// Gets or sets how many frames the paced sender may hand to a dedicated NDI send thread before it waits for one
+    /// to finish, so a blocking send no longer eats into the pacing budget. Zero sends on the paced sender's thread.
+    /// Ignored for asynchronous senders, which return at once, and when frames are sent directly.
+    /// </summary>
+    public int SendThreadDepth { get; init; }
+
     /// <summary>
     /// Gets or sets the telemetry interval.
     /// </summary>
@@ -65,6 +97,78 @@ internal sealed record NdiVideoPipelineOptions
     /// </summary>
     public bool EnableCompositorCapture { get; init; }
 
+    /// <summary>
+    /// Gets or sets the compositor capture surface scale relative to the output size (1, 2 or 4).
+    /// Values above 1 render Chromium at a higher device scale factor and downsample natively.
+    /// </summary>
+    public int SupersampleFactor { get; init; } = 1;
+
+    /// <summary>
+    /// Gets or sets the filter used to resolve a supersampled capture surface.
+    /// </summary>
+    public SupersampleFilter SupersampleFilter { get; init; } = SupersampleFilter.Box;
+
+    /// <summary>
+    /// Gets or sets the rate at which the page renders under compositor capture, when it differs from the output rate.
+    /// </summary>
+    public FrameRate? SourceFrameRate { get; init; }
+
+    /// <summary>
+    /// Gets or sets how compositor frames are converted from <see cref="SourceFrameRate"/> to the output rate.
+    /// </summary>
+    public FrameRateConversion FrameRateConversion { get; init; } = FrameRateConversion.DropRepeat;
+
+    /// <summary>
+    /// Gets or sets a value indicating whether frames carry two woven fields and are announced to NDI as interleaved.
+    /// The pipeline frame rate is then the frame rate (25 for 1080i50) and the native helper renders at twice that rate.
+    /// </summary>
+    public bool Interlaced { get; init; }
+
+    /// <summary>
+    /// Gets or sets a value indicating whether the native helper applies a vertical flicker filter while weaving fields.
+    /// </summary>
+    public bool InterlaceFlickerFilter { get; init; }
+
+    /// <summary>
+    /// Gets or sets the pages blended above the main page by the native layer compositor. Requires compositor capture.
+    /// </summary>
+    public CompositorLayerStack Layers { get; init; } = CompositorLayerStack.Empty;
+
+    /// <summary>
+    /// Gets or sets the alpha representation of frames sent to NDI. Straight alpha is produced by the native helper
+    /// and therefore requires compositor capture.
+    /// </summary>
+    public AlphaMode AlphaMode { get; init; } = AlphaMode.Premultiplied;
+
+    /// <summary>
+    /// Gets or sets the priority, CPU pinning and timer slack of the native capture and compositor threads and of the
+    /// paced sender loop.
+    /// </summary>
+    public ThreadPolicy ThreadPolicy { get; init; } = ThreadPolicy.Default;
+
+    /// <summary>
+    /// Gets or sets how the native helper allocates its frame pools.
+    /// </summary>
+    public FrameMemoryOptions FrameMemory { get; init; } = FrameMemoryOptions.None;
+
+    /// <summary>
+    /// Gets or sets the faults the native fallback capture loop injects into its cadence. Meant for exercising the
+    /// paced buffer's recovery; <see cref="CaptureFaultProfile.None"/> injects nothing.
+    /// </summary>
+    public CaptureFaultProfile CaptureFaults { get; init; } = CaptureFaultProfile.None;
+
+    /// <summary>
+    /// Gets or sets how repeated frames are detected and how often a static page is sent.
+    /// <see cref="IdleOutput.Disabled"/> sends every frame without hashing it.
+    /// </summary>
+    public IdleOutput IdleOutput { get; init; } = IdleOutput.Disabled;
+
+    /// <summary>
+    /// Gets or sets the size of one frame in bytes, used to charge the frames the pipeline holds to the frame-memory
+    /// budget. Zero leaves them uncharged.
+    /// </summary>
+    public long FrameBytes { get; init; }
+
     /// <summary>
     /// Gets or sets the pacing mode for the video pipeline.
     /// </summary>
@@ -0,0 +1,381 @@
+using System.Globalization;
+using System.Text;
+using Tractus.HtmlToNdi.Models;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Renders pipeline and native helper snapshots in the OpenMetrics text format for Prometheus scrapes. Everything is
+/// formatted at scrape time from counters the frame path only increments.
+/// </summary>
+internal static class OpenMetricsFormatter
+{
+    /// <summary>
+    /// The content type of the OpenMetrics text exposition.
+    /// </summary>
+    public const string ContentType = "application/openmetrics-text; version=1.0.0; charset=utf-8";
+
+    private const string Prefix = "htmltondi_";
+
+    private static readonly (string Name, string Help, Func<PipelineMetrics, long> Read)[] PipelineCounters =
+    {
+        ("frames_captured", "Frames delivered to the pipeline.", m => m.CapturedFrames),
+        ("frames_sent", "Fresh frames sent to NDI.", m => m.SentFrames),
+        ("frames_repeated", "Frames re-sent because no fresh frame was ready.", m => m.RepeatedFrames),
+        ("underruns", "Times the paced buffer ran dry.", m => m.Underruns),
+        ("warmups", "Warmups completed after start or an underrun.", m => m.WarmupCycles),
+        ("spurious_captures", "Paints that arrived without an invalidation ticket.", m => m.SpuriousCaptures),
+    };
+
+    private static readonly (string Reason, Func<PipelineMetrics, long> Read)[] PipelineDrops =
+    {
+        ("overflow", m => m.DroppedOverflow),
+        ("stale", m => m.DroppedStale),
+        ("resync", m => m.ResyncDrops),
+    };
+
+    private static readonly (string Name, string Help, Func<PipelineMetrics, double> Read)[] PipelineGauges =
+    {
+        ("buffered_frames", "Frames queued in the paced buffer.", m => m.BufferedFrames),
+        ("buffer_depth", "Buffer depth in use.", m => m.BufferDepth),
+        ("buffer_primed", "1 when the paced buffer is primed or the pipeline sends directly.", m => m.Primed ? 1 : 0),
+        ("latency_error_frames", "Backlog error of the pacing integrator in frames.", m => m.LatencyErrorFrames),
+    };
+
+    /// <summary>
+    /// Formats one scrape.
+    /// </summary>
+    /// <param name="pipelines">The pipelines to report, labelled by output name.</param>
+    /// <param name="counters">The native helper's counters, or <c>null</c> when the helper is unavailable.</param>
+    /// <param name="memory">The native frame-memory figures, or <c>null</c> when the helper is unavailable.</param>
+    /// <returns>The exposition, terminated by <c># EOF</c>.</returns>
+    public static string Format(IReadOnlyList<(string Output, PipelineMetrics Metrics)> pipelines, CompositorCounters? counters, FrameMemoryStatistics? memory)
+    {
+        var builder = new StringBuilder(4096);
+
+        foreach (var (name, help, read) in PipelineCounters)
+        {
+            WriteFamily(builder, name, "counter", help);
+            foreach (var (output, metrics) in pipelines)
+            {
+                WriteSample(builder, name + "_total", Label("output", output), read(metrics));
+            }
+        }
+
+        WriteFamily(builder, "frames_dropped", "counter", "Frames dropped from the paced buffer.");
+        foreach (var (output, metrics) in pipelines)
+        {
+            foreach (var (reason, read) in PipelineDrops)
+            {
+                WriteSample(builder, "frames_dropped_total", Label("output", output) + "," + Label("reason", reason), read(metrics));
+            }
+        }
+
+        foreach (var (name, help, read) in PipelineGauges)
+        {
+            WriteFamily(builder, name, "gauge", help);
+            foreach (var (output, metrics) in pipelines)
+            {
+                WriteSample(builder, name, Label("output", output), read(metrics));
+            }
+        }
+
+        WriteReferenceLocks(builder, pipelines);
+        WriteSendLatency(builder, pipelines);
+        WriteSendStages(builder, pipelines);
+        WriteDuplicates(builder, pipelines);
+
+        if (counters is not null)
+        {
+            WriteNativeCounters(builder, counters);
+        }
+
+        if (memory is not null)
+        {
+            WriteMemory(builder, memory);
+        }
+
+        builder.Append("# EOF\n");
+        return builder.ToString();
+    }
+
+    private static void WriteReferenceLocks(StringBuilder builder, IReadOnlyList<(string Output, PipelineMetrics Metrics)> pipelines)
+    {
+        var locked = pipelines.Where(p => p.Metrics.ReferenceLock is not null).Select(p => (p.Output, Lock: p.Metrics.ReferenceLock!.Value)).ToList();
+        if (locked.Count == 0)
+        {
+            return;
+        }
+
+        WriteFamily(builder, "reference_lock_state", "gauge", "Lock to the pacing reference: 0 unlocked, 1 acquiring, 2 locked, 3 holdover.");
+        foreach (var (output, referenceLock) in locked)
+        {
+            WriteSample(builder, "reference_lock_state", Label("output", output), (long)referenceLock.State);
+        }
+
+        WriteFamily(builder, "reference_phase_error_seconds", "gauge", "Phase error of the latest usable reference sample.");
+        foreach (var (output, referenceLock) in locked)
+        {
+            WriteSample(builder, "reference_phase_error_seconds", Label("output", output), referenceLock.PhaseErrorSeconds);
+        }
+
+        WriteFamily(builder, "reference_frequency_ppm", "gauge", "How far the reference runs ahead of the local clock, in parts per million.");
+        foreach (var (output, referenceLock) in locked)
+        {
+            WriteSample(builder, "reference_frequency_ppm", Label("output", output), referenceLock.FrequencyPpm);
+        }
+
+        WriteFamily(builder, "reference_steps", "counter", "Times the reference lock stepped instead of slewing.");
+        foreach (var (output, referenceLock) in locked)
+        {
+            WriteSample(builder, "reference_steps_total", Label("output", output), referenceLock.Steps);
+        }
+
+        WriteFamily(builder, "reference_skipped_slots", "counter", "Reference grid slots passed over because a tick ran late.");
+        foreach (var (output, referenceLock) in locked)
+        {
+            WriteSample(builder, "reference_skipped_slots_total", Label("output", output), referenceLock.SkippedSlots);
+        }
+
+        var genlocked = locked.Where(l => l.Lock.Arrivals is not null).ToList();
+        if (genlocked.Count == 0)
+        {
+            return;
+        }
+
+        WriteFamily(builder, "reference_arrivals", "counter", "Genlock reference frames folded into the lock.");
+        foreach (var (output, referenceLock) in genlocked)
+        {
+            WriteSample(builder, "reference_arrivals_total", Label("output", output), referenceLock.Arrivals ?? 0);
+        }
+
+        WriteFamily(builder, "reference_missed_frames", "counter", "Genlock reference frames that never arrived.");
+        foreach (var (output, referenceLock) in genlocked)
+        {
+            WriteSample(builder, "reference_missed_frames_total", Label("output", output), referenceLock.MissedFrames ?? 0);
+        }
+    }
+
+    private static void WriteSendLatency(StringBuilder builder, IReadOnlyList<(string Output, PipelineMetrics Metrics)> pipelines)
+    {
+        if (!pipelines.Any(p => p.Metrics.SendLatency?.RecordedPaths().Count > 0))
+        {
+            return;
+        }
+
+        WriteFamily(builder, "send_latency_seconds", "histogram", "Time from capture to the NDI sender, by send path.");
+        foreach (var (output, metrics) in pipelines)
+        {
+            foreach (var histogram in metrics.SendLatency?.RecordedPaths() ?? Array.Empty<SendLatencyHistogram>())
+            {
+                WriteHistogram(builder, "send_latency_seconds", Label("output", output) + "," + Label("path", PathLabel(histogram.Path)), histogram);
+            }
+        }
+    }
+
+    private static void WriteSendStages(StringBuilder builder, IReadOnlyList<(string Output, PipelineMetrics Metrics)> pipelines)
+    {
+        var staged = pipelines.Where(p => p.Metrics.SendStage is not null).Select(p => (p.Output, Stage: p.Metrics.SendStage!.Value)).ToList();
+        if (staged.Count == 0)
+        {
+            return;
+        }
+
+        WriteFamily(builder, "send_thread_in_flight", "gauge", "Frames queued or sending on the NDI send thread.");
+        foreach (var (output, stage) in staged)
+        {
+            WriteSample(builder, "send_thread_in_flight", Label("output", output), stage.InFlight);
+        }
+
+        WriteFamily(builder, "send_thread_stalls", "counter", "Times the paced sender waited because the send thread was full.");
+        foreach (var (output, stage) in staged)
+        {
+            WriteSample(builder, "send_thread_stalls_total", Label("output", output), stage.Stalls);
+        }
+
+        WriteFamily(builder, "send_thread_failures", "counter", "NDI sends that threw on the send thread; their frames were skipped.");
+        foreach (var (output, stage) in staged)
+        {
+            WriteSample(builder, "send_thread_failures_total", Label("output", output), stage.Failures);
+        }
+
+        WriteFamily(builder, "send_thread_queue_seconds", "summary", "Time frames waited for the NDI send thread.");
+        foreach (var (output, stage) in staged)
+        {
+            WriteSample(builder, "send_thread_queue_seconds_count", Label("output", output), stage.Frames);
+            WriteSample(builder, "send_thread_queue_seconds_sum", Label("output", output), stage.QueueSeconds);
+        }
+
+        WriteFamily(builder, "send_thread_send_seconds", "summary", "Time spent in blocking NDI sends on the send thread.");
+        foreach (var (output, stage) in staged)
+        {
+            WriteSample(builder, "send_thread_send_seconds_count", Label("output", output), stage.Frames);
+            WriteSample(builder, "send_thread_send_seconds_sum", Label("output", output), stage.SendSeconds);
+        }
+    }
+
+    private static void WriteDuplicates(StringBuilder builder, IReadOnlyList<(string Output, PipelineMetrics Metrics)> pipelines)
+    {
+        var hashed = pipelines.Where(p => p.Metrics.Duplicates is not null).Select(p => (p.Output, Duplicates: p.Metrics.Duplicates!.Value)).ToList();
+        if (hashed.Count == 0)
+        {
+            return;
+        }
+
+        WriteFamily(builder, "duplicate_frames", "counter", "Frames whose pixels repeated the frame before them.");
+        foreach (var (output, duplicates) in hashed)
+        {
+            WriteSample(builder, "duplicate_frames_total", Label("output", output), duplicates.DuplicateFrames);
+        }
+
+        WriteFamily(builder, "idle", "gauge", "1 while the page is static and sent at the idle rate.");
+        foreach (var (output, duplicates) in hashed)
+        {
+            WriteSample(builder, "idle", Label("output", output), duplicates.Idle ? 1 : 0);
+        }
+
+        WriteFamily(builder, "idle_suppressed_frames", "counter", "Repeated frames not sent while the page was idle.");
+        foreach (var (output, duplicates) in hashed)
+        {
+            WriteSample(builder, "idle_suppressed_frames_total", Label("output", output), duplicates.SuppressedFrames);
+        }
+
+        WriteFamily(builder, "idle_suppressed_bytes", "counter", "Uncompressed bytes of the frames not sent while the page was idle.");
+        foreach (var (output, duplicates) in hashed)
+        {
+            WriteSample(builder, "idle_suppressed_bytes_total", Label("output", output), duplicates.SuppressedBytes);
+        }
+    }
+
+    private static string PathLabel(FrameSendPath path) => path switch
+    {
+        FrameSendPath.Direct => "direct",
+        FrameSendPath.Buffered => "buffered",
+        FrameSendPath.Repeated => "repeated",
+        FrameSendPath.LatencyExpansion => "latency_expansion",
+        _ => path.ToString(),
+    };
+
+    private static void WriteNativeCounters(StringBuilder builder, CompositorCounters counters)
+    {
+        WriteFamily(builder, "native_frames", "counter", "Frames handled by the native helper, by stage.");
+        WriteSample(builder, "native_frames_total", Label("stage", "captured"), counters.FramesCaptured);
+        WriteSample(builder, "native_frames_total", Label("stage", "delivered"), counters.FramesDelivered);
+        WriteSample(builder, "native_frames_total", Label("stage", "layer_submitted"), counters.LayerFramesSubmitted);
+        WriteSample(builder, "native_frames_total", Label("stage", "rendition"), counters.RenditionFramesDelivered);
+        WriteSample(builder, "native_frames_total", Label("stage", "overlay"), counters.OverlayFrames);
+        WriteSample(builder, "native_frames_total", Label("stage", "composite"), counters.CompositesDelivered);
+
+        WriteFamily(builder, "native_tiles", "counter", "Layer tiles blended or skipped as unchanged.");
+        WriteSample(builder, "native_tiles_total", Label("result", "composed"), counters.TilesComposed);
+        WriteSample(builder, "native_tiles_total", Label("result", "skipped"), counters.TilesSkipped);
+
+        WriteFamily(builder, "native_conversion_seconds", "histogram", "Time the native helper spends producing a frame, by stage.");
+        WriteHistogram(builder, "native_conversion_seconds", Label("stage", "frame"), counters.FrameConversion);
+        WriteHistogram(builder, "native_conversion_seconds", Label("stage", "rendition"), counters.RenditionConversion);
+        WriteHistogram(builder, "native_conversion_seconds", Label("stage", "composite"), counters.Composite);
+    }
+
+    private static void WriteMemory(StringBuilder builder, FrameMemoryStatistics memory)
+    {
+        var pools = new (string Pool, FrameMemoryPoolStatistics Statistics)[]
+        {
+            ("capture", memory.Capture),
+            ("renditions", memory.Renditions),
+            ("layers", memory.Layers),
+            ("pipeline", memory.Pipeline),
+        };
+
+        WriteFamily(builder, "frame_memory_budget_bytes", "gauge", "Frame-memory budget, or 0 when unlimited.");
+        WriteSample(builder, "frame_memory_budget_bytes", null, memory.BudgetBytes);
+
+        WriteFamily(builder, "frame_memory_in_use_bytes", "gauge", "Frame memory allocated, by pool.");
+        foreach (var (pool, statistics) in pools)
+        {
+            WriteSample(builder, "frame_memory_in_use_bytes", Label("pool", pool), statistics.InUseBytes);
+        }
+
+        WriteFamily(builder, "frame_memory_high_water_bytes", "gauge", "Most frame memory allocated at once, by pool.");
+        foreach (var (pool, statistics) in pools)
+        {
+            WriteSample(builder, "frame_memory_high_water_bytes", Label("pool", pool), statistics.HighWaterBytes);
+        }
+
+        WriteFamily(builder, "frame_memory_refusals", "counter", "Allocations refused because they would have exceeded the budget, by pool.");
+        foreach (var (pool, statistics) in pools)
+        {
+            WriteSample(builder, "frame_memory_refusals_total", Label("pool", pool), statistics.Refusals);
+        }
+
+        WriteFamily(builder, "frame_memory_trimmed_bytes", "counter", "Frame memory freed because sessions stopped.");
+        WriteSample(builder, "frame_memory_trimmed_bytes_total", null, memory.TrimmedBytes);
+    }
+
+    private static void WriteHistogram(StringBuilder builder, string name, string labels, CompositorHistogram histogram)
+    {
+        // Prometheus buckets are cumulative; the helper's are not.
+        long cumulative = 0;
+        for (var i = 0; i < histogram.Buckets.Count; i++)
+        {
+            cumulative += histogram.Buckets[i];
+            var bound = CompositorHistogram.UpperBoundNanoseconds(i);
+            var le = bound == long.MaxValue ? "+Inf" : (bound / 1e9).ToString(CultureInfo.InvariantCulture);
+            WriteSample(builder, name + "_bucket", labels + "," + Label("le", le), cumulative);
+        }
+
+        WriteSample(builder, name + "_count", labels, histogram.Count);
+        WriteSample(builder, name + "_sum", labels, histogram.SumNanoseconds / 1e9);
+    }
+
+    private static void WriteHistogram(StringBuilder builder, string name, string labels, SendLatencyHistogram histogram)
+    {
+        long cumulative = 0;
+        for (var i = 0; i < histogram.Buckets.Count; i++)
+        {
+            cumulative += histogram.Buckets[i];
+            var bound = SendLatencyHistogram.UpperBoundMicroseconds(i);
+            var le = bound == long.MaxValue ? "+Inf" : (bound / 1e6).ToString(CultureInfo.InvariantCulture);
+            WriteSample(builder, name + "_bucket", labels + "," + Label("le", le), cumulative);
+        }
+
+        WriteSample(builder, name + "_count", labels, histogram.Count);
+        WriteSample(builder, name + "_sum", labels, histogram.SumMicroseconds / 1e6);
+    }
+
+    private static void WriteFamily(StringBuilder builder, string name, string type, string help)
+    {
+        builder.Append("# TYPE ").Append(Prefix).Append(name).Append(' ').Append(type).Append('\n');
+        builder.Append("# HELP ").Append(Prefix).Append(name).Append(' ').Append(help).Append('\n');
+    }
+
+    private static void WriteSample(StringBuilder builder, string name, string? labels, long value)
+    {
+        WriteSampleName(builder, name, labels);
+        builder.Append(value.ToString(CultureInfo.InvariantCulture)).Append('\n');
+    }
+
+    private static void WriteSample(StringBuilder builder, string name, string? labels, double value)
+    {
+        WriteSampleName(builder, name, labels);
+        builder.Append(value.ToString(CultureInfo.InvariantCulture)).Append('\n');
+    }
+
+    private static void WriteSampleName(StringBuilder builder, string name, string? labels)
+    {
+        builder.Append(Prefix).Append(name);
+        if (!string.IsNullOrEmpty(labels))
+        {
+            builder.Append('{').Append(labels).Append('}');
+        }
+
+        builder.Append(' ');
+    }
+
+    private static string Label(string name, string value)
+    {
+        var escaped = value.Replace("\\", "\\\\", StringComparison.Ordinal)
+            .Replace("\"", "\\\"", StringComparison.Ordinal)
+            .Replace("\n", "\\n", StringComparison.Ordinal);
+        return $"{name}=\"{escaped}\"";
+    }
+}
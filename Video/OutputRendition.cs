@@ -0,0 +1,137 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Identifies the resampling filter used by the native helper when deriving a rendition.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorScaleFilter</c> in the native helper.</remarks>
+public enum RenditionScaleFilter
+{
+    /// <summary>
+    /// Two-tap triangle filter; cheapest option for confidence monitoring.
+    /// </summary>
+    Bilinear = 0,
+
+    /// <summary>
+    /// Six-tap windowed sinc; keeps small text legible at a higher CPU cost.
+    /// </summary>
+    Lanczos3 = 1,
+}
+
+/// <summary>
+/// Describes an additional, scaled NDI output produced from the primary captured frame.
+/// </summary>
+/// <param name="Width">The rendition width in pixels.</param>
+/// <param name="Height">The rendition height in pixels.</param>
+/// <param name="FrameRateDivider">Publishes every Nth captured frame (1 keeps the primary rate).</param>
+/// <param name="Filter">The resampling filter.</param>
+public sealed record OutputRendition(int Width, int Height, int FrameRateDivider, RenditionScaleFilter Filter)
+{
+    /// <summary>
+    /// Parses a single rendition in the form <c>WIDTHxHEIGHT[/DIVIDER][:FILTER]</c>, for example <c>960x540/2</c> or <c>640x360/2:bilinear</c>.
+    /// </summary>
+    /// <param name="text">The text to parse.</param>
+    /// <param name="rendition">When this method returns <c>true</c>, contains the parsed rendition.</param>
+    /// <param name="error">When this method returns <c>false</c>, describes why parsing failed.</param>
+    /// <returns><c>true</c> when the text describes a valid rendition; otherwise <c>false</c>.</returns>
+    public static bool TryParse(string? text, out OutputRendition? rendition, out string? error)
+    {
+        rendition = null;
+        error = null;
+
+        if (string.IsNullOrWhiteSpace(text))
+        {
+            error = "Rendition is empty.";
+            return false;
+        }
+
+        var remaining = text.Trim();
+        var filter = RenditionScaleFilter.Lanczos3;
+        var filterSeparator = remaining.IndexOf(':');
+        if (filterSeparator >= 0)
+        {
+            var filterText = remaining[(filterSeparator + 1)..].Trim();
+            if (!Enum.TryParse(filterText, true, out filter) || !Enum.IsDefined(filter))
+            {
+                error = $"Unknown scale filter '{filterText}' in rendition '{text}'.";
+                return false;
+            }
+
+            remaining = remaining[..filterSeparator];
+        }
+
+        var divider = 1;
+        var dividerSeparator = remaining.IndexOf('/');
+        if (dividerSeparator >= 0)
+        {
+            var dividerText = remaining[(dividerSeparator + 1)..].Trim();
+            if (!int.TryParse(dividerText, NumberStyles.Integer, CultureInfo.InvariantCulture, out divider) || divider <= 0)
+            {
+                error = $"Frame rate divider '{dividerText}' in rendition '{text}' must be a positive integer.";
+                return false;
+            }
+
+            remaining = remaining[..dividerSeparator];
+        }
+
+        var size = remaining.Split('x', 2, StringSplitOptions.TrimEntries);
+        if (size.Length != 2 ||
+            !int.TryParse(size[0], NumberStyles.Integer, CultureInfo.InvariantCulture, out var width) ||
+            !int.TryParse(size[1], NumberStyles.Integer, CultureInfo.InvariantCulture, out var height) ||
+            width <= 0 ||
+            height <= 0)
+        {
+            error = $"Rendition '{text}' must start with a positive WIDTHxHEIGHT size.";
+            return false;
+        }
+
+        rendition = new OutputRendition(width, height, divider, filter);
+        return true;
+    }
+
+    /// <summary>
+    /// Parses a comma-separated list of renditions.
+    /// </summary>
+    /// <param name="text">The list to parse. Null or whitespace yields an empty list.</param>
+    /// <returns>The parsed renditions.</returns>
+    /// <exception cref="FormatException">Thrown when any entry is invalid.</exception>
+    public static IReadOnlyList<OutputRendition> ParseList(string? text)
+    {
+        if (string.IsNullOrWhiteSpace(text))
+        {
+            return Array.Empty<OutputRendition>();
+        }
+
+        var renditions = new List<OutputRendition>();
+        foreach (var entry in text.Split(',', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries))
+        {
+            if (!TryParse(entry, out var rendition, out var error))
+            {
+                throw new FormatException(error);
+            }
+
+            renditions.Add(rendition!);
+        }
+
+        return renditions;
+    }
+
+    /// <summary>
+    /// Computes the output frame rate of this rendition for the supplied capture rate.
+    /// </summary>
+    /// <param name="captureRate">The primary capture frame rate.</param>
+    /// <returns>The reduced rational frame rate after applying <see cref="FrameRateDivider"/>.</returns>
+    public FrameRate ResolveFrameRate(FrameRate captureRate) => captureRate.DivideBy(FrameRateDivider);
+
+    /// <summary>
+    /// Builds the NDI source name advertised for this rendition.
+    /// </summary>
+    /// <param name="baseName">The primary NDI source name.</param>
+    /// <returns>The rendition source name, e.g. <c>HTML5 (960x540)</c>.</returns>
+    public string CreateSourceName(string baseName) => $"{baseName} ({Width}x{Height})";
+
+    /// <inheritdoc />
+    public override string ToString()
+        => string.Create(CultureInfo.InvariantCulture, $"{Width}x{Height}/{FrameRateDivider}:{Filter.ToString().ToLowerInvariant()}");
+}
@@ -0,0 +1,62 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Locks the paced sender's ticks to a reference timebase instead of letting them free-run on the local
+/// <see cref="System.Diagnostics.Stopwatch"/>, so several machines on the same time source send each frame at the
+/// same instant.
+/// </summary>
+/// <param name="Clock">The reference clock's name, or <c>null</c> to free-run.</param>
+/// <param name="MaxSlewPpm">How fast, in parts per million, the lock may pull the output's phase towards the
+/// reference; larger errors are stepped.</param>
+public sealed record PacingReference(string? Clock, double MaxSlewPpm)
+{
+    /// <summary>
+    /// The system time, disciplined by whatever time source the machine follows.
+    /// </summary>
+    public const string SystemClock = "system";
+
+    /// <summary>
+    /// The slew limit used when none is given, matching NTP's.
+    /// </summary>
+    public const double DefaultMaxSlewPpm = 500;
+
+    /// <summary>
+    /// Gets settings that let the paced sender free-run.
+    /// </summary>
+    public static PacingReference Disabled { get; } = new(null, DefaultMaxSlewPpm);
+
+    /// <summary>
+    /// Gets a value indicating whether the paced sender locks to a reference.
+    /// </summary>
+    public bool IsEnabled => Clock is not null;
+
+    /// <summary>
+    /// Parses a reference clock name.
+    /// </summary>
+    /// <param name="clock"><c>system</c>, or null or whitespace for <see cref="Disabled"/>.</param>
+    /// <param name="maxSlewPpm">The slew limit in parts per million.</param>
+    /// <returns>The parsed settings.</returns>
+    /// <exception cref="FormatException">Thrown when the clock is unknown or the slew limit is out of bounds.</exception>
+    public static PacingReference Parse(string? clock, double maxSlewPpm = DefaultMaxSlewPpm)
+    {
+        if (string.IsNullOrWhiteSpace(clock))
+        {
+            return Disabled;
+        }
+
+        var name = clock.Trim().ToLowerInvariant();
+        if (name != SystemClock)
+        {
+            throw new FormatException($"Unknown pacing reference '{clock}' (expected {SystemClock}; Windows has no TAI clock, so TAI sources discipline the system time instead).");
+        }
+
+        if (!(maxSlewPpm > 0 && maxSlewPpm <= 10_000))
+        {
+            throw new FormatException(string.Create(CultureInfo.InvariantCulture, $"The pacing reference slew limit must be above 0 and at most 10000 ppm, not {maxSlewPpm}."));
+        }
+
+        return new PacingReference(name, maxSlewPpm);
+    }
+}
@@ -0,0 +1,52 @@
+using System.Threading;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Event counters written by a single thread, padded so no other object shares their cache lines. The owning thread
+/// increments with a plain store instead of a locked read-modify-write; other threads may read at any time.
+/// </summary>
+internal sealed class PaddedCounterBlock
+{
+    // 128 bytes either side: adjacent-line prefetch moves cache lines in pairs.
+    private const int Padding = 16;
+
+    private readonly long[] slots;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="PaddedCounterBlock"/> class.
+    /// </summary>
+    /// <param name="count">The number of counters in the block.</param>
+    public PaddedCounterBlock(int count)
+    {
+        if (count <= 0)
+        {
+            throw new ArgumentOutOfRangeException(nameof(count));
+        }
+
+        slots = new long[count + (2 * Padding)];
+        Count = count;
+    }
+
+    /// <summary>
+    /// Gets the number of counters in the block.
+    /// </summary>
+    public int Count { get; }
+
+    /// <summary>
+    /// Adds one to a counter. Only the thread that owns the block may call this.
+    /// </summary>
+    /// <param name="counter">The counter index.</param>
+    public void Increment(int counter)
+    {
+        ref var slot = ref slots[Padding + counter];
+        Volatile.Write(ref slot, slot + 1);
+    }
+
+    /// <summary>
+    /// Reads a counter from any thread.
+    /// </summary>
+    /// <param name="counter">The counter index.</param>
+    /// <returns>The count at the time of the read.</returns>
+    public long Read(int counter) => Volatile.Read(ref slots[Padding + counter]);
+}
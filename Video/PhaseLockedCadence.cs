@@ -0,0 +1,152 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Paces the sender on a frame grid laid out on a reference timebase rather than on the local clock: frame <c>N</c>
+/// is due at <c>N</c> frame intervals after the Unix epoch in reference time, so every machine locked to the same
+/// reference sends it at the same instant. A <see cref="ReferencePhaseLock"/> turns each grid instant into a local
+/// deadline. Like <c>FrameCadence</c> in the native helper, a tick that runs late skips the slots it missed instead of
+/// bursting to catch up. The reference is either a clock sampled at every tick or a <see cref="ReferenceFollower"/>
+/// fed by a genlock source's frame arrivals. Called from the paced sender's thread only.
+/// </summary>
+internal sealed class PhaseLockedCadence
+{
+    private readonly IPipelineClock clock;
+    private readonly IReferenceClock? reference;
+    private readonly ReferenceFollower? follower;
+    private readonly long frameNumerator;
+    private readonly long frameDenominatorTicks;
+    private readonly long minimumSpacingTicks;
+    private long? lastDeadlineTicks;
+    private long lastFrame;
+    private long lastAcquisitions;
+    private long skippedSlots;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="PhaseLockedCadence"/> class.
+    /// </summary>
+    /// <param name="clock">The paced sender's clock.</param>
+    /// <param name="reference">The timebase to lock to.</param>
+    /// <param name="frameRate">The output frame rate, which sets the grid exactly, fractional rates included.</param>
+    /// <param name="maxSlewPpm">How fast the lock may pull the output's phase in, in parts per million.</param>
+    public PhaseLockedCadence(IPipelineClock clock, IReferenceClock reference, FrameRate frameRate, double maxSlewPpm)
+        : this(clock, frameRate, new ReferencePhaseLock(maxSlewPpm, StepThreshold(frameRate)))
+    {
+        this.reference = reference ?? throw new ArgumentNullException(nameof(reference));
+    }
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="PhaseLockedCadence"/> class that follows a genlock reference.
+    /// </summary>
+    /// <param name="clock">The paced sender's clock.</param>
+    /// <param name="follower">The follower of the reference's frame arrivals, whose lock the grid is laid on.</param>
+    /// <param name="frameRate">The output frame rate, which may differ from the reference's.</param>
+    public PhaseLockedCadence(IPipelineClock clock, ReferenceFollower follower, FrameRate frameRate)
+        : this(clock, frameRate, (follower ?? throw new ArgumentNullException(nameof(follower))).Lock)
+    {
+        this.follower = follower;
+    }
+
+    private PhaseLockedCadence(IPipelineClock clock, FrameRate frameRate, ReferencePhaseLock phaseLock)
+    {
+        this.clock = clock ?? throw new ArgumentNullException(nameof(clock));
+        frameNumerator = frameRate.Numerator;
+        frameDenominatorTicks = frameRate.Denominator * TimeSpan.TicksPerSecond;
+        minimumSpacingTicks = frameDenominatorTicks / frameNumerator / 2;
+        Lock = phaseLock;
+    }
+
+    /// <summary>
+    /// Gets the loop that maps the local clock onto the reference.
+    /// </summary>
+    public ReferencePhaseLock Lock { get; }
+
+    /// <summary>
+    /// Gets the reference's name.
+    /// </summary>
+    public string ReferenceName => follower?.Name ?? reference!.Name;
+
+    /// <summary>
+    /// Gets the genlock follower the grid is laid on, or <c>null</c> when the reference is a clock.
+    /// </summary>
+    public ReferenceFollower? Follower => follower;
+
+    /// <summary>
+    /// Gets the grid number of the latest deadline: the frame every locked machine sends at that instant.
+    /// </summary>
+    public long FrameNumber => Interlocked.Read(ref lastFrame);
+
+    /// <summary>
+    /// Gets the grid slots passed over because a tick ran late.
+    /// </summary>
+    public long SkippedSlots => Interlocked.Read(ref skippedSlots);
+
+    /// <summary>
+    /// Samples the reference, or folds in the follower's arrivals, and returns the local deadline of the next grid
+    /// slot. Consecutive deadlines are at least half a frame apart, so a step of the reference never fires two ticks
+    /// back to back.
+    /// </summary>
+    /// <returns>The deadline on the <see cref="IPipelineClock.Elapsed"/> timeline.</returns>
+    public TimeSpan NextDeadline()
+    {
+        long now;
+        if (follower is not null)
+        {
+            now = clock.Elapsed.Ticks;
+            follower.Drain(now);
+        }
+        else
+        {
+            var before = clock.Elapsed.Ticks;
+            var referenceTicks = reference!.ReadTicks();
+            now = clock.Elapsed.Ticks;
+            Lock.Update(before, referenceTicks, now);
+        }
+
+        var earliest = lastDeadlineTicks is { } last ? Math.Max(now, last + minimumSpacingTicks) : now;
+        var frame = FrameAt(Lock.ToReference(earliest)) + 1;
+        var reacquired = Lock.Acquisitions != lastAcquisitions;
+        if (lastDeadlineTicks is not null && !reacquired && frame > lastFrame + 1)
+        {
+            Interlocked.Add(ref skippedSlots, frame - lastFrame - 1);
+        }
+
+        lastAcquisitions = Lock.Acquisitions;
+        Interlocked.Exchange(ref lastFrame, frame);
+        var deadline = Math.Max(earliest, Lock.ToLocal(FrameStart(frame)));
+        lastDeadlineTicks = deadline;
+        return TimeSpan.FromTicks(deadline);
+    }
+
+    /// <summary>
+    /// Forgets the previous deadline after the pacer restarts, keeping the lock.
+    /// </summary>
+    public void Restart()
+    {
+        lastDeadlineTicks = null;
+    }
+
+    /// <summary>
+    /// Returns the grid slot a reference instant falls in.
+    /// </summary>
+    /// <param name="referenceTicks">The reference time, in ticks since the Unix epoch.</param>
+    /// <returns>The frame number.</returns>
+    internal long FrameAt(long referenceTicks)
+    {
+        return (long)((Int128)referenceTicks * frameNumerator / frameDenominatorTicks);
+    }
+
+    /// <summary>
+    /// Returns when a grid slot starts, rounded up to the next tick so it falls inside its own slot.
+    /// </summary>
+    /// <param name="frame">The frame number.</param>
+    /// <returns>The reference time, in ticks since the Unix epoch.</returns>
+    internal long FrameStart(long frame)
+    {
+        var scaled = (Int128)frame * frameDenominatorTicks;
+        return (long)((scaled + frameNumerator - 1) / frameNumerator);
+    }
+
+    // Anything within half a frame is slewed; beyond that the grid slot is ambiguous anyway, so it is stepped.
+    private static TimeSpan StepThreshold(FrameRate frameRate) =>
+        TimeSpan.FromTicks(frameRate.Denominator * TimeSpan.TicksPerSecond / frameRate.Numerator / 2);
+}
@@ -0,0 +1,74 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Pipeline events kept by the flight recorder.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorFlightEvent</c> in the native helper.</remarks>
+internal enum PipelineEvent
+{
+    /// <summary>
+    /// A frame reached the pipeline; the value is 1 for compositor frames and 0 for paints.
+    /// </summary>
+    FrameCaptured = 0,
+
+    /// <summary>
+    /// A frame entered the paced buffer; the value is the backlog afterwards.
+    /// </summary>
+    FrameEnqueued = 1,
+    SendBegin = 2,
+    SendEnd = 3,
+
+    /// <summary>
+    /// The previous frame is about to be sent again because no fresh frame was ready.
+    /// </summary>
+    Repeat = 4,
+
+    /// <summary>
+    /// A frame was discarded; the value is a <see cref="PipelineDropReason"/>.
+    /// </summary>
+    Drop = 5,
+
+    /// <summary>
+    /// The paced buffer started refilling; the value is the backlog.
+    /// </summary>
+    WarmupEnter = 6,
+    WarmupExit = 7,
+
+    /// <summary>
+    /// The paced buffer ran dry after it had been primed; the value is the backlog.
+    /// </summary>
+    Underrun = 8,
+
+    /// <summary>
+    /// An invalidation ticket was issued; the value is the number pending afterwards.
+    /// </summary>
+    TicketIssued = 9,
+    TicketExpired = 10,
+}
+
+/// <summary>
+/// Why a <see cref="PipelineEvent.Drop"/> frame was discarded.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorFlightDropReason</c> in the native helper.</remarks>
+internal enum PipelineDropReason
+{
+    /// <summary>
+    /// The paced buffer was full and its oldest frame made room.
+    /// </summary>
+    Overflow = 0,
+
+    /// <summary>
+    /// The pacer trimmed a frame to pull latency back to the target.
+    /// </summary>
+    Resync = 1,
+
+    /// <summary>
+    /// The frame's pixels were not CPU-accessible.
+    /// </summary>
+    UnsupportedStorage = 2,
+
+    /// <summary>
+    /// A paint arrived without an invalidation ticket.
+    /// </summary>
+    Spurious = 3,
+}
@@ -0,0 +1,60 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// A point-in-time copy of a pipeline's counters and gauges, taken for the metrics endpoint so nothing is formatted
+/// on the frame path.
+/// </summary>
+/// <param name="CapturedFrames">The frames delivered to the pipeline.</param>
+/// <param name="SentFrames">The fresh frames sent to NDI.</param>
+/// <param name="RepeatedFrames">The frames re-sent because no fresh frame was ready.</param>
+/// <param name="Underruns">The times the paced buffer ran dry.</param>
+/// <param name="WarmupCycles">The warmups completed after start or an underrun.</param>
+/// <param name="DroppedOverflow">The frames dropped because the buffer was full.</param>
+/// <param name="DroppedStale">The frames dropped as stale.</param>
+/// <param name="ResyncDrops">The frames dropped to pull latency back to the target depth.</param>
+/// <param name="SpuriousCaptures">The paints that arrived without an invalidation ticket.</param>
+/// <param name="BufferedFrames">The frames currently queued in the paced buffer.</param>
+/// <param name="BufferDepth">The buffer depth in use.</param>
+/// <param name="Primed">Whether the paced buffer is primed, or the pipeline sends directly.</param>
+/// <param name="LatencyErrorFrames">The pacing integrator's backlog error in frames.</param>
+/// <param name="ReferenceLock">The reference lock of a phase-locked pacer, or <c>null</c> when it free-runs.</param>
+/// <param name="SendLatency">The capture-to-send latency of each send path.</param>
+/// <param name="SendStage">The send thread's counters, or <c>null</c> when the paced sender sends on its own thread.</param>
+/// <param name="Duplicates">The duplicate and idle counters, or <c>null</c> when frames are not hashed.</param>
+internal readonly record struct PipelineMetrics(
+    long CapturedFrames,
+    long SentFrames,
+    long RepeatedFrames,
+    long Underruns,
+    long WarmupCycles,
+    long DroppedOverflow,
+    long DroppedStale,
+    long ResyncDrops,
+    long SpuriousCaptures,
+    int BufferedFrames,
+    int BufferDepth,
+    bool Primed,
+    double LatencyErrorFrames,
+    ReferenceLockMetrics? ReferenceLock = null,
+    SendLatencyMetrics? SendLatency = null,
+    SendStageMetrics? SendStage = null,
+    DuplicateFrameMetrics? Duplicates = null);
+
+/// <summary>
+/// A point-in-time copy of a phase-locked pacer's lock.
+/// </summary>
+/// <param name="State">How closely the pacer follows its reference.</param>
+/// <param name="PhaseErrorSeconds">The phase error of the latest usable sample.</param>
+/// <param name="FrequencyPpm">How far the reference runs ahead of the local clock, in parts per million.</param>
+/// <param name="Steps">The times the lock stepped instead of slewing.</param>
+/// <param name="SkippedSlots">The grid slots passed over because a tick ran late.</param>
+/// <param name="Arrivals">The genlock reference's frames folded into the lock, or <c>null</c> when the reference is a clock.</param>
+/// <param name="MissedFrames">The genlock reference's frames that never arrived, or <c>null</c> when the reference is a clock.</param>
+internal readonly record struct ReferenceLockMetrics(
+    ReferenceLockState State,
+    double PhaseErrorSeconds,
+    double FrequencyPpm,
+    long Steps,
+    long SkippedSlots,
+    long? Arrivals = null,
+    long? MissedFrames = null);
@@ -0,0 +1,172 @@
+using System.Collections.Concurrent;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Follows a genlock reference through the arrival times of its frames. Frame <c>k</c> of the reference is laid at
+/// <c>k</c> frame intervals on a reference timeline that starts at the first arrival, and arrivals are folded into a
+/// <see cref="ReferencePhaseLock"/> as samples of that timeline, so a <see cref="PhaseLockedCadence"/> can lay the
+/// output's grid on it. An arrival is matched to a grid slot by the loop's prediction, so a frame the reference never
+/// delivered counts as missed rather than pulling the phase a frame off. Delivery only ever delays a frame, so,
+/// like NTP's clock filter, only the least delayed arrival of every <see cref="FilterLength"/> reaches the loop: it is
+/// the one closest to when the reference sent its frame, and the loop sees a fraction of the network's jitter. Arrivals
+/// may be posted from any thread; they are folded in on the paced sender's thread.
+/// </summary>
+internal sealed class ReferenceFollower
+{
+    /// <summary>
+    /// The arrivals each loop sample is the least delayed of.
+    /// </summary>
+    internal const int FilterLength = 8;
+
+    /// <summary>
+    /// The phase gain of the loop, half that of a loop on a clock: the filtered arrivals still jitter more than a clock
+    /// reading, and a slower loop keeps that out of the learned frequency.
+    /// </summary>
+    internal const double PhaseGain = 1d / 32d;
+
+    /// <summary>
+    /// The averaged phase error within which the follower counts as locked.
+    /// </summary>
+    internal static readonly TimeSpan LockThreshold = TimeSpan.FromMicroseconds(250);
+
+    /// <summary>
+    /// Arrivals kept waiting for the paced sender; later ones are dropped until it catches up.
+    /// </summary>
+    internal const int MaxPendingArrivals = 256;
+
+    private readonly ConcurrentQueue<long> pending = new();
+    private readonly long frameNumerator;
+    private readonly long frameDenominatorTicks;
+    private int pendingCount;
+    private long lastFrame = -1;
+    private int filtered;
+    private long bestArrival;
+    private long bestFrame;
+    private long bestDelay;
+    private long arrivals;
+    private long missedFrames;
+    private long droppedArrivals;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="ReferenceFollower"/> class.
+    /// </summary>
+    /// <param name="name">The reference source's name.</param>
+    /// <param name="frameRate">The reference's nominal frame rate.</param>
+    /// <param name="maxSlewPpm">How fast the lock may pull the output's phase in, in parts per million.</param>
+    public ReferenceFollower(string name, FrameRate frameRate, double maxSlewPpm)
+    {
+        Name = name ?? throw new ArgumentNullException(nameof(name));
+        frameNumerator = frameRate.Numerator;
+        frameDenominatorTicks = frameRate.Denominator * TimeSpan.TicksPerSecond;
+
+        // Matching arrivals to the nearest slot keeps every error within half a frame, so the loop never steps.
+        Lock = new ReferencePhaseLock(maxSlewPpm, TimeSpan.FromTicks(frameDenominatorTicks / frameNumerator / 2), PhaseGain, LockThreshold);
+    }
+
+    /// <summary>
+    /// Gets the reference source's name.
+    /// </summary>
+    public string Name { get; }
+
+    /// <summary>
+    /// Gets the loop that maps the local clock onto the reference timeline.
+    /// </summary>
+    public ReferencePhaseLock Lock { get; }
+
+    /// <summary>
+    /// Gets the arrivals folded into the loop.
+    /// </summary>
+    public long Arrivals => Interlocked.Read(ref arrivals);
+
+    /// <summary>
+    /// Gets the reference frames that never arrived, judged by the gaps between the slots of successive arrivals.
+    /// </summary>
+    public long MissedFrames => Interlocked.Read(ref missedFrames);
+
+    /// <summary>
+    /// Gets the arrivals dropped because the paced sender fell more than <see cref="MaxPendingArrivals"/> behind.
+    /// </summary>
+    public long DroppedArrivals => Interlocked.Read(ref droppedArrivals);
+
+    /// <summary>
+    /// Queues an arrival for the next <see cref="Drain"/>. Safe to call from any thread.
+    /// </summary>
+    /// <param name="arrival">When the frame arrived, on the pipeline clock's timeline.</param>
+    public void Post(TimeSpan arrival)
+    {
+        if (Interlocked.Increment(ref pendingCount) > MaxPendingArrivals)
+        {
+            Interlocked.Decrement(ref pendingCount);
+            Interlocked.Increment(ref droppedArrivals);
+            return;
+        }
+
+        pending.Enqueue(arrival.Ticks);
+    }
+
+    /// <summary>
+    /// Folds the queued arrivals into the loop, or reports holdover when a locked reference has stopped arriving.
+    /// </summary>
+    /// <param name="now">The pipeline clock now, in ticks.</param>
+    public void Drain(long now)
+    {
+        var drained = false;
+        while (pending.TryDequeue(out var arrival))
+        {
+            Interlocked.Decrement(ref pendingCount);
+            Fold(arrival);
+            drained = true;
+        }
+
+        if (!drained)
+        {
+            Lock.CheckHoldover(now);
+        }
+    }
+
+    private void Fold(long arrival)
+    {
+        Interlocked.Increment(ref arrivals);
+        if (lastFrame < 0)
+        {
+            lastFrame = 0;
+            Lock.Update(arrival, 0, arrival);
+            return;
+        }
+
+        // Delivery only delays frames, so an arrival up to three quarters of a frame late still matches its own slot.
+        var predicted = (Int128)Lock.ToReference(arrival) * frameNumerator;
+        var frame = (long)((predicted + (frameDenominatorTicks / 4)) / frameDenominatorTicks);
+        if (frame <= lastFrame)
+        {
+            // The reference delivers each frame once, so an early arrival is the next frame, however early.
+            frame = lastFrame + 1;
+        }
+        else if (frame > lastFrame + 1)
+        {
+            Interlocked.Add(ref missedFrames, frame - lastFrame - 1);
+        }
+
+        lastFrame = frame;
+        var delay = arrival - Lock.ToLocal(FrameStart(frame));
+        if (filtered == 0 || delay < bestDelay)
+        {
+            bestArrival = arrival;
+            bestFrame = frame;
+            bestDelay = delay;
+        }
+
+        if (++filtered == FilterLength)
+        {
+            filtered = 0;
+            Lock.Update(bestArrival, FrameStart(bestFrame), bestArrival);
+        }
+    }
+
+    private long FrameStart(long frame)
+    {
+        var scaled = (Int128)frame * frameDenominatorTicks;
+        return (long)((scaled + frameNumerator - 1) / frameNumerator);
+    }
+}
@@ -0,0 +1,292 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// How closely a <see cref="ReferencePhaseLock"/> follows its reference.
+/// </summary>
+internal enum ReferenceLockState
+{
+    /// <summary>
+    /// No sample has been taken yet.
+    /// </summary>
+    Unlocked,
+
+    /// <summary>
+    /// Following the reference, but the phase error is not yet within the lock threshold.
+    /// </summary>
+    Acquiring,
+
+    /// <summary>
+    /// The phase error has stayed within the lock threshold.
+    /// </summary>
+    Locked,
+
+    /// <summary>
+    /// Was locked, but recent samples were unusable; the last frequency estimate carries the output meanwhile.
+    /// </summary>
+    Holdover,
+}
+
+/// <summary>
+/// A phase-locked loop that maps the local pipeline clock onto a reference timebase. Each sample compares the
+/// reference with the mapping's prediction; a proportional term pulls the phase in and an integral term learns the
+/// frequency difference between the two oscillators, so a steady drift leaves no standing error. Phase corrections
+/// are slew-limited, so the output's frame intervals never stretch or shrink by more than the limit, and an error
+/// beyond the step threshold (a reference that was set, or a leap second) is stepped in one go instead of slewed for
+/// minutes. Lock is judged on the phase error averaged over the loop's own time constant, so a jittery reference
+/// such as frame arrivals can lock as well as a clean clock. Updated from the paced sender's thread; the telemetry
+/// properties may be read from any thread.
+/// </summary>
+internal sealed class ReferencePhaseLock
+{
+    /// <summary>
+    /// The averaged phase error within which a loop on a clean clock counts as locked.
+    /// </summary>
+    internal static readonly TimeSpan DefaultLockThreshold = TimeSpan.FromMicroseconds(100);
+
+    /// <summary>
+    /// The phase gain of a loop on a clean clock: the phase settles within about sixteen samples.
+    /// </summary>
+    internal const double DefaultPhaseGain = 1d / 16d;
+
+    /// <summary>
+    /// How long the averaged phase error must stay within the lock threshold before the loop reports a lock.
+    /// </summary>
+    internal static readonly TimeSpan LockTime = TimeSpan.FromSeconds(2);
+
+    /// <summary>
+    /// How long a locked loop goes without a usable sample before it reports holdover.
+    /// </summary>
+    internal static readonly TimeSpan HoldoverTimeout = TimeSpan.FromSeconds(1);
+
+    /// <summary>
+    /// Samples whose two local reads are further apart than this were preempted mid-read and are discarded.
+    /// </summary>
+    internal static readonly TimeSpan MaxSampleSpread = TimeSpan.FromMicroseconds(50);
+
+    /// <summary>
+    /// The largest frequency difference the loop will learn; crystal oscillators are well within it.
+    /// </summary>
+    internal const double MaxFrequencyPpm = 500;
+
+    private readonly double phaseGain;
+    private readonly double frequencyGain;
+    private readonly double lockThresholdTicks;
+    private readonly double unlockThresholdTicks;
+    private readonly double maxSlew;
+    private readonly double stepThresholdTicks;
+    private long baseOffset;
+    private double residual;
+    private double frequency;
+    private long anchorLocal;
+    private long lastAcceptedLocal;
+    private long withinThresholdSince = -1;
+    private int state;
+    private double phaseErrorTicks;
+    private long steps;
+    private long rejectedSamples;
+    private long acquisitions;
+    private double averageErrorTicks;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="ReferencePhaseLock"/> class.
+    /// </summary>
+    /// <param name="maxSlewPpm">How fast the phase may be pulled in, in parts per million.</param>
+    /// <param name="stepThreshold">The phase error beyond which the loop steps instead of slewing.</param>
+    /// <param name="phaseGain">The share of each sample's error corrected at once; smaller gains average more
+    /// samples, for noisier references. Defaults to <see cref="DefaultPhaseGain"/>.</param>
+    /// <param name="lockThreshold">The averaged phase error within which the loop counts as locked; ten times it
+    /// unlocks. Defaults to <see cref="DefaultLockThreshold"/>.</param>
+    public ReferencePhaseLock(double maxSlewPpm, TimeSpan stepThreshold, double phaseGain = DefaultPhaseGain, TimeSpan? lockThreshold = null)
+    {
+        if (!(maxSlewPpm > 0))
+        {
+            throw new ArgumentOutOfRangeException(nameof(maxSlewPpm), maxSlewPpm, "The slew limit must be positive.");
+        }
+
+        if (!(phaseGain > 0 && phaseGain < 1))
+        {
+            throw new ArgumentOutOfRangeException(nameof(phaseGain), phaseGain, "The phase gain must be between 0 and 1, exclusive.");
+        }
+
+        // The frequency gain that makes the alpha-beta pair critically damped.
+        this.phaseGain = phaseGain;
+        frequencyGain = 2d - phaseGain - (2d * Math.Sqrt(1d - phaseGain));
+        lockThresholdTicks = (lockThreshold ?? DefaultLockThreshold).Ticks;
+        unlockThresholdTicks = lockThresholdTicks * 10;
+        maxSlew = maxSlewPpm * 1e-6;
+        stepThresholdTicks = Math.Max(unlockThresholdTicks, stepThreshold.Ticks);
+    }
+
+    /// <summary>
+    /// Gets how closely the loop follows the reference.
+    /// </summary>
+    public ReferenceLockState State => (ReferenceLockState)Volatile.Read(ref state);
+
+    /// <summary>
+    /// Gets the phase error of the latest usable sample: how far the reference was ahead of the mapping's prediction.
+    /// </summary>
+    public TimeSpan PhaseError => TimeSpan.FromTicks((long)Volatile.Read(ref phaseErrorTicks));
+
+    /// <summary>
+    /// Gets how far the reference runs ahead of the local clock, in parts per million.
+    /// </summary>
+    public double FrequencyPpm => Volatile.Read(ref frequency) * 1e6;
+
+    /// <summary>
+    /// Gets the times the loop stepped instead of slewing.
+    /// </summary>
+    public long Steps => Interlocked.Read(ref steps);
+
+    /// <summary>
+    /// Gets the samples discarded because the reading thread was preempted mid-sample.
+    /// </summary>
+    public long RejectedSamples => Interlocked.Read(ref rejectedSamples);
+
+    /// <summary>
+    /// Gets the times the mapping was set outright: the first sample, and every step.
+    /// </summary>
+    public long Acquisitions => Interlocked.Read(ref acquisitions);
+
+    /// <summary>
+    /// Folds in a reading of the reference taken between two readings of the local clock.
+    /// </summary>
+    /// <param name="localBefore">The local clock just before the reference was read, in ticks.</param>
+    /// <param name="reference">The reference reading, in ticks.</param>
+    /// <param name="localAfter">The local clock just after the reference was read, in ticks.</param>
+    /// <returns><c>true</c> when <see cref="State"/> changed.</returns>
+    public bool Update(long localBefore, long reference, long localAfter)
+    {
+        var previous = State;
+        if (localAfter - localBefore > MaxSampleSpread.Ticks)
+        {
+            Interlocked.Increment(ref rejectedSamples);
+            return CheckHoldover(localAfter);
+        }
+
+        var local = localBefore + ((localAfter - localBefore) / 2);
+        if (previous == ReferenceLockState.Unlocked)
+        {
+            Acquire(local, reference);
+            return true;
+        }
+
+        var elapsed = local - anchorLocal;
+        if (elapsed <= 0)
+        {
+            return false;
+        }
+
+        var predicted = residual + (frequency * elapsed);
+        var error = (reference - local - baseOffset) - predicted;
+        Volatile.Write(ref phaseErrorTicks, error);
+        lastAcceptedLocal = local;
+
+        if (Math.Abs(error) > stepThresholdTicks)
+        {
+            Interlocked.Increment(ref steps);
+            Acquire(local, reference);
+            return State != previous;
+        }
+
+        // Only learn frequency while the correction is unclamped, so a long slew does not wind the integrator up.
+        var maxCorrection = maxSlew * elapsed;
+        var correction = phaseGain * error;
+        if (Math.Abs(correction) > maxCorrection)
+        {
+            correction = Math.CopySign(maxCorrection, correction);
+        }
+        else
+        {
+            var learned = Math.Clamp(frequency + (frequencyGain * error / elapsed), -MaxFrequencyPpm * 1e-6, MaxFrequencyPpm * 1e-6);
+            Volatile.Write(ref frequency, learned);
+        }
+
+        // Keep the residual small so the mapping stays exact in doubles however long the loop runs.
+        residual = predicted + correction;
+        var whole = (long)residual;
+        baseOffset += whole;
+        residual -= whole;
+        anchorLocal = local;
+
+        averageErrorTicks += phaseGain * (error - averageErrorTicks);
+        var averageError = Math.Abs(averageErrorTicks);
+        if (averageError <= lockThresholdTicks)
+        {
+            if (withinThresholdSince < 0)
+            {
+                withinThresholdSince = local;
+            }
+
+            if (previous != ReferenceLockState.Locked && local - withinThresholdSince >= LockTime.Ticks)
+            {
+                SetState(ReferenceLockState.Locked);
+            }
+            else if (previous == ReferenceLockState.Holdover)
+            {
+                SetState(ReferenceLockState.Locked);
+            }
+        }
+        else
+        {
+            withinThresholdSince = -1;
+            if (previous == ReferenceLockState.Holdover || averageError > unlockThresholdTicks)
+            {
+                SetState(ReferenceLockState.Acquiring);
+            }
+        }
+
+        return State != previous;
+    }
+
+    /// <summary>
+    /// Reports holdover when a locked loop has gone without a usable sample for <see cref="HoldoverTimeout"/>, as when
+    /// the reference stops delivering.
+    /// </summary>
+    /// <param name="local">The local time now, in ticks.</param>
+    /// <returns><c>true</c> when <see cref="State"/> changed.</returns>
+    public bool CheckHoldover(long local)
+    {
+        if (State == ReferenceLockState.Locked && local - lastAcceptedLocal > HoldoverTimeout.Ticks)
+        {
+            SetState(ReferenceLockState.Holdover);
+            return true;
+        }
+
+        return false;
+    }
+
+    /// <summary>
+    /// Maps a local clock reading onto the reference timebase.
+    /// </summary>
+    /// <param name="local">The local time, in ticks.</param>
+    /// <returns>The reference time, in ticks since the Unix epoch.</returns>
+    public long ToReference(long local)
+    {
+        return local + baseOffset + (long)Math.Round(residual + (frequency * (local - anchorLocal)));
+    }
+
+    /// <summary>
+    /// Maps a reference instant onto the local clock.
+    /// </summary>
+    /// <param name="reference">The reference time, in ticks since the Unix epoch.</param>
+    /// <returns>The local time, in ticks.</returns>
+    public long ToLocal(long reference)
+    {
+        var span = (reference - baseOffset - anchorLocal) - residual;
+        return anchorLocal + (long)Math.Round(span / (1d + frequency));
+    }
+
+    private void Acquire(long local, long reference)
+    {
+        baseOffset = reference - local;
+        residual = 0;
+        anchorLocal = local;
+        lastAcceptedLocal = local;
+        withinThresholdSince = -1;
+        averageErrorTicks = 0;
+        Interlocked.Increment(ref acquisitions);
+        SetState(ReferenceLockState.Acquiring);
+    }
+
+    private void SetState(ReferenceLockState value) => Volatile.Write(ref state, (int)value);
+}
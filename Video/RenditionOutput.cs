@@ -0,0 +1,132 @@
+using System.Runtime.InteropServices;
+using NewTek;
+using NewTek.NDI;
+using Serilog;
+using Tractus.HtmlToNdi.Native;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Owns the NDI sender and paced pipeline that publish one scaled rendition as its own NDI source.
+/// </summary>
+internal sealed class RenditionOutput : IDisposable
+{
+    private readonly ILogger logger;
+    private nint senderPtr;
+    private bool disposed;
+
+    private RenditionOutput(OutputRendition rendition, string sourceName, nint senderPtr, NdiVideoPipeline pipeline, ILogger logger)
+    {
+        Rendition = rendition;
+        SourceName = sourceName;
+        this.senderPtr = senderPtr;
+        Pipeline = pipeline;
+        this.logger = logger;
+    }
+
+    /// <summary>
+    /// Gets the rendition description.
+    /// </summary>
+    public OutputRendition Rendition { get; }
+
+    /// <summary>
+    /// Gets the advertised NDI source name.
+    /// </summary>
+    public string SourceName { get; }
+
+    /// <summary>
+    /// Gets the pipeline that paces and sends this rendition.
+    /// </summary>
+    public NdiVideoPipeline Pipeline { get; }
+
+    /// <summary>
+    /// Creates the NDI sender and pipeline for a rendition.
+    /// </summary>
+    /// <param name="rendition">The rendition to publish.</param>
+    /// <param name="baseName">The primary NDI source name used to derive the rendition name.</param>
+    /// <param name="captureRate">The primary capture frame rate.</param>
+    /// <param name="options">Pipeline options inherited from the primary output.</param>
+    /// <param name="sendAsync">Whether the NDI sender should use asynchronous sends.</param>
+    /// <param name="logger">The logger used for diagnostics.</param>
+    /// <param name="output">When this method returns <c>true</c>, contains the created output.</param>
+    /// <returns><c>true</c> when the NDI sender was created; otherwise <c>false</c>.</returns>
+    public static bool TryCreate(
+        OutputRendition rendition,
+        string baseName,
+        FrameRate captureRate,
+        NdiVideoPipelineOptions options,
+        bool sendAsync,
+        ILogger logger,
+        out RenditionOutput? output)
+    {
+        output = null;
+        var sourceName = rendition.CreateSourceName(baseName);
+        var namePtr = UTF.StringToUtf8(sourceName);
+        nint senderPtr;
+        try
+        {
+            var settings = new NDIlib.send_create_t
+            {
+                p_ndi_name = namePtr
+            };
+
+            senderPtr = NDIlib.send_create(ref settings);
+        }
+        finally
+        {
+            if (namePtr != nint.Zero)
+            {
+                Marshal.FreeHGlobal(namePtr);
+            }
+        }
+
+        if (senderPtr == nint.Zero)
+        {
+            logger.Warning("Failed to create NDI sender for rendition {Rendition}", rendition);
+            return false;
+        }
+
+        // Renditions follow the primary capture, so there is no Chromium invalidation for them to pace.
+        var renditionOptions = options with
+        {
+            EnablePacedInvalidation = false,
+            EnableCaptureBackpressure = false,
+            EnablePumpCadenceAdaptation = false,
+            EnableCompositorCapture = true,
+            Interlaced = false,
+            FrameBytes = (long)rendition.Width * rendition.Height * 4,
+        };
+
+        var frameRate = rendition.ResolveFrameRate(captureRate);
+        var pipeline = new NdiVideoPipeline(new NativeNdiVideoSender(senderPtr, sendAsync), frameRate, renditionOptions, logger, NativeFrameMemoryBudget.Instance, NativeFlightRecorder.TryCreate(sourceName));
+        output = new RenditionOutput(rendition, sourceName, senderPtr, pipeline, logger);
+        logger.Information("Rendition {Rendition} publishing as {SourceName} at {Rate}", rendition, sourceName, frameRate);
+        return true;
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (disposed)
+        {
+            return;
+        }
+
+        disposed = true;
+        Pipeline.Dispose();
+
+        if (senderPtr != nint.Zero)
+        {
+            try
+            {
+                NDIlib.send_destroy(senderPtr);
+            }
+            catch (Exception ex)
+            {
+                logger.Warning(ex, "Failed to destroy NDI sender for {SourceName}", SourceName);
+            }
+
+            senderPtr = nint.Zero;
+        }
+    }
+}
@@ -0,0 +1,111 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// How long the frames sent by one path waited between capture and <see cref="INdiVideoSender.Send"/>, since the
+/// pipeline was created. Bucket <c>i</c> counts the frames whose latency was at most
+/// <see cref="UpperBoundMicroseconds"/> of <c>i</c> and above that of <c>i - 1</c>; the buckets are not cumulative.
+/// </summary>
+/// <param name="Path">The path the frames were sent by.</param>
+/// <param name="Count">The frames recorded.</param>
+/// <param name="SumMicroseconds">The total latency of the frames recorded.</param>
+/// <param name="MaxMicroseconds">The longest latency recorded.</param>
+/// <param name="Buckets">The frames recorded in each bucket.</param>
+public sealed record SendLatencyHistogram(FrameSendPath Path, long Count, long SumMicroseconds, long MaxMicroseconds, IReadOnlyList<long> Buckets)
+{
+    /// <summary>
+    /// The number of buckets, including the unbounded last one.
+    /// </summary>
+    public const int BucketCount = 16;
+
+    /// <summary>
+    /// Gets the mean latency in milliseconds, or zero when nothing was recorded.
+    /// </summary>
+    public double MeanMilliseconds => Count == 0 ? 0 : SumMicroseconds / 1000d / Count;
+
+    /// <summary>
+    /// Gets the median latency in milliseconds, estimated from the buckets.
+    /// </summary>
+    public double P50Milliseconds => PercentileMilliseconds(0.5);
+
+    /// <summary>
+    /// Gets the 99th percentile latency in milliseconds, estimated from the buckets.
+    /// </summary>
+    public double P99Milliseconds => PercentileMilliseconds(0.99);
+
+    /// <summary>
+    /// Gets the inclusive upper bound of a bucket, or <see cref="long.MaxValue"/> for the last one. The bounds double
+    /// from a quarter of a millisecond to a little over four seconds.
+    /// </summary>
+    /// <param name="bucket">The bucket index.</param>
+    /// <returns>The bound in microseconds.</returns>
+    public static long UpperBoundMicroseconds(int bucket) => bucket >= BucketCount - 1 ? long.MaxValue : 250L << bucket;
+
+    /// <summary>
+    /// Estimates a percentile by interpolating within the bucket it falls in, capped at <see cref="MaxMicroseconds"/>.
+    /// </summary>
+    /// <param name="quantile">The quantile, from 0 to 1.</param>
+    /// <returns>The latency in milliseconds, or zero when nothing was recorded.</returns>
+    public double PercentileMilliseconds(double quantile)
+    {
+        if (Count == 0)
+        {
+            return 0;
+        }
+
+        var rank = Math.Clamp(quantile, 0d, 1d) * Count;
+        long below = 0;
+        for (var i = 0; i < Buckets.Count; i++)
+        {
+            var inBucket = Buckets[i];
+            if (inBucket > 0 && below + inBucket >= rank)
+            {
+                var lower = i == 0 ? 0 : UpperBoundMicroseconds(i - 1);
+                var upper = Math.Min(UpperBoundMicroseconds(i), MaxMicroseconds);
+                var estimate = lower + ((upper - lower) * Math.Max(0d, rank - below) / inBucket);
+                return Math.Min(estimate, MaxMicroseconds) / 1000d;
+            }
+
+            below += inBucket;
+        }
+
+        return MaxMicroseconds / 1000d;
+    }
+
+    /// <inheritdoc />
+    public bool Equals(SendLatencyHistogram? other)
+    {
+        // Snapshots are compared by value, so metrics holding them compare equal when the same frames were recorded.
+        return other is not null
+            && Path == other.Path
+            && Count == other.Count
+            && SumMicroseconds == other.SumMicroseconds
+            && MaxMicroseconds == other.MaxMicroseconds
+            && Buckets.SequenceEqual(other.Buckets);
+    }
+
+    /// <inheritdoc />
+    public override int GetHashCode() => HashCode.Combine(Path, Count, SumMicroseconds, MaxMicroseconds);
+}
+
+/// <summary>
+/// The capture-to-send latency of every path a pipeline sends by.
+/// </summary>
+/// <param name="Direct">Frames sent as soon as they were captured.</param>
+/// <param name="Buffered">Frames dequeued from the paced buffer.</param>
+/// <param name="Repeated">Frames sent again because no fresh frame was ready.</param>
+/// <param name="LatencyExpansion">Frames dequeued while latency expansion let the buffer run shallow.</param>
+public sealed record SendLatencyMetrics(
+    SendLatencyHistogram Direct,
+    SendLatencyHistogram Buffered,
+    SendLatencyHistogram Repeated,
+    SendLatencyHistogram LatencyExpansion)
+{
+    /// <summary>
+    /// Lists the paths that have sent a frame.
+    /// </summary>
+    /// <returns>The histograms, in <see cref="FrameSendPath"/> order.</returns>
+    public IReadOnlyList<SendLatencyHistogram> RecordedPaths()
+    {
+        return new[] { Direct, Buffered, Repeated, LatencyExpansion }.Where(h => h.Count > 0).ToArray();
+    }
+}
@@ -0,0 +1,90 @@
+using System.Diagnostics;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Records each frame's capture-to-send latency into a <see cref="SendLatencyHistogram"/> per
+/// <see cref="FrameSendPath"/>. Like <see cref="PaddedCounterBlock"/>, only the thread that sends frames may record,
+/// with plain stores; other threads may take a <see cref="Snapshot"/> at any time.
+/// </summary>
+internal sealed class SendLatencyRecorder
+{
+    private const int PathCount = (int)FrameSendPath.LatencyExpansion + 1;
+
+    // Per path: the buckets, then the count, the sum and the max.
+    private const int CountSlot = SendLatencyHistogram.BucketCount;
+    private const int SumSlot = CountSlot + 1;
+    private const int MaxSlot = SumSlot + 1;
+    private const int Stride = MaxSlot + 1;
+
+    private readonly long[] slots = new long[PathCount * Stride];
+
+    /// <summary>
+    /// Records a frame's latency. Only the sending thread may call this.
+    /// </summary>
+    /// <param name="path">The path the frame was sent by.</param>
+    /// <param name="captureTimestamp">When the frame was captured, in <see cref="Stopwatch"/> ticks; zero if unknown.</param>
+    /// <param name="sendTimestamp">When the frame was handed to the sender, in <see cref="Stopwatch"/> ticks.</param>
+    public void Record(FrameSendPath path, long captureTimestamp, long sendTimestamp)
+    {
+        var elapsed = sendTimestamp - captureTimestamp;
+        if (captureTimestamp == 0 || elapsed < 0)
+        {
+            // Frames without a capture time, or timed on another clock, say nothing about latency.
+            return;
+        }
+
+        var microseconds = (long)(elapsed * 1_000_000d / Stopwatch.Frequency);
+        var bucket = 0;
+        while (microseconds > SendLatencyHistogram.UpperBoundMicroseconds(bucket))
+        {
+            bucket++;
+        }
+
+        var row = (int)path * Stride;
+        Bump(ref slots[row + bucket], 1);
+        Bump(ref slots[row + CountSlot], 1);
+        Bump(ref slots[row + SumSlot], microseconds);
+        if (microseconds > slots[row + MaxSlot])
+        {
+            Volatile.Write(ref slots[row + MaxSlot], microseconds);
+        }
+    }
+
+    /// <summary>
+    /// Copies one path's histogram. Safe to call from any thread; a frame recorded meanwhile may be half counted.
+    /// </summary>
+    /// <param name="path">The path to copy.</param>
+    /// <returns>The histogram.</returns>
+    public SendLatencyHistogram Snapshot(FrameSendPath path)
+    {
+        var row = (int)path * Stride;
+        var buckets = new long[SendLatencyHistogram.BucketCount];
+        for (var i = 0; i < buckets.Length; i++)
+        {
+            buckets[i] = Volatile.Read(ref slots[row + i]);
+        }
+
+        return new SendLatencyHistogram(
+            path,
+            Volatile.Read(ref slots[row + CountSlot]),
+            Volatile.Read(ref slots[row + SumSlot]),
+            Volatile.Read(ref slots[row + MaxSlot]),
+            buckets);
+    }
+
+    /// <summary>
+    /// Copies the histogram of every path.
+    /// </summary>
+    /// <returns>The histograms.</returns>
+    public SendLatencyMetrics Snapshot()
+    {
+        return new SendLatencyMetrics(
+            Snapshot(FrameSendPath.Direct),
+            Snapshot(FrameSendPath.Buffered),
+            Snapshot(FrameSendPath.Repeated),
+            Snapshot(FrameSendPath.LatencyExpansion));
+    }
+
+    private static void Bump(ref long slot, long amount) => Volatile.Write(ref slot, slot + amount);
+}
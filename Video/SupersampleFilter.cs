@@ -0,0 +1,18 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Identifies the filter the native helper uses to resolve a supersampled capture surface to the output size.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorSupersampleFilter</c> in the native helper.</remarks>
+public enum SupersampleFilter
+{
+    /// <summary>
+    /// Averages each factor x factor block; the cheapest resolve and the default.
+    /// </summary>
+    Box = 0,
+
+    /// <summary>
+    /// Resolves through the Lanczos3 scaler for slightly crisper text at a much higher CPU cost.
+    /// </summary>
+    Lanczos3 = 1,
+}
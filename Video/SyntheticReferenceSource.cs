@@ -0,0 +1,122 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// A genlock reference made up locally: frames arrive at the reference rate, off by a frequency error, each delayed
+/// by seeded half-normal jitter as network delivery would, and always in order. It lets the follower be tried and
+/// tested without a reference on the network. Arrivals are reported with the instant they were generated for, so a
+/// reporting thread that wakes late only delays the report, not the timestamp.
+/// </summary>
+internal sealed class SyntheticReferenceSource : IReferenceFrameSource
+{
+    private readonly IPipelineClock clock;
+    private readonly double intervalTicks;
+    private readonly TimeSpan jitter;
+    private readonly ulong seed;
+    private Random random;
+    private TimeSpan origin;
+    private long sequence;
+    private TimeSpan lastArrival;
+    private CancellationTokenSource? cancellation;
+    private Task? reportingTask;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="SyntheticReferenceSource"/> class.
+    /// </summary>
+    /// <param name="clock">The pipeline's clock, which arrivals are timed on.</param>
+    /// <param name="reference">The synthetic reference's settings.</param>
+    /// <param name="outputFrameRate">The frame rate used when <paramref name="reference"/> gives none.</param>
+    public SyntheticReferenceSource(IPipelineClock clock, GenlockReference reference, FrameRate outputFrameRate)
+    {
+        this.clock = clock ?? throw new ArgumentNullException(nameof(clock));
+        ArgumentNullException.ThrowIfNull(reference);
+        FrameRate = reference.FrameRate ?? outputFrameRate;
+        intervalTicks = FrameRate.Denominator * (double)TimeSpan.TicksPerSecond / FrameRate.Numerator / (1d + (reference.DriftPpm * 1e-6));
+        jitter = reference.Jitter;
+        seed = reference.Seed;
+        random = new Random(unchecked((int)seed));
+    }
+
+    /// <inheritdoc />
+    public string Name => GenlockReference.SyntheticSource;
+
+    /// <inheritdoc />
+    public FrameRate FrameRate { get; }
+
+    /// <inheritdoc />
+    public void Start(Action<TimeSpan> onFrame)
+    {
+        ArgumentNullException.ThrowIfNull(onFrame);
+        if (reportingTask is not null)
+        {
+            return;
+        }
+
+        Rewind(clock.Elapsed);
+        cancellation = new CancellationTokenSource();
+        var token = cancellation.Token;
+        reportingTask = Task.Factory.StartNew(
+            () => Report(onFrame, token),
+            CancellationToken.None,
+            TaskCreationOptions.LongRunning | TaskCreationOptions.DenyChildAttach,
+            TaskScheduler.Default);
+    }
+
+    /// <inheritdoc />
+    public void Stop()
+    {
+        cancellation?.Cancel();
+        reportingTask?.Wait();
+        cancellation?.Dispose();
+        cancellation = null;
+        reportingTask = null;
+    }
+
+    /// <summary>
+    /// Restarts the arrivals: frame zero arrives at <paramref name="start"/> and the jitter replays from its seed.
+    /// </summary>
+    /// <param name="start">When the first frame arrives, before its jitter.</param>
+    internal void Rewind(TimeSpan start)
+    {
+        origin = start;
+        sequence = 0;
+        lastArrival = TimeSpan.MinValue;
+        random = new Random(unchecked((int)seed));
+    }
+
+    /// <summary>
+    /// Generates the next arrival.
+    /// </summary>
+    /// <returns>When the next frame arrives, on the clock's <see cref="IPipelineClock.Elapsed"/> timeline.</returns>
+    internal TimeSpan NextArrival()
+    {
+        var nominal = origin + TimeSpan.FromTicks((long)Math.Round(intervalTicks * sequence++));
+        var delay = jitter > TimeSpan.Zero ? TimeSpan.FromTicks((long)Math.Abs(NextGaussian() * jitter.Ticks)) : TimeSpan.Zero;
+        var arrival = nominal + delay;
+        lastArrival = arrival > lastArrival ? arrival : lastArrival;
+        return lastArrival;
+    }
+
+    private void Report(Action<TimeSpan> onFrame, CancellationToken token)
+    {
+        while (!token.IsCancellationRequested)
+        {
+            var arrival = NextArrival();
+
+            // A coarse sleep is enough: the timestamp carries the arrival, and the follower only reads it at the next tick.
+            var remaining = arrival - clock.Elapsed;
+            if (remaining > TimeSpan.Zero && token.WaitHandle.WaitOne(remaining))
+            {
+                return;
+            }
+
+            onFrame(arrival);
+        }
+    }
+
+    private double NextGaussian()
+    {
+        var u1 = 1d - random.NextDouble();
+        var u2 = random.NextDouble();
+        return Math.Sqrt(-2d * Math.Log(u1)) * Math.Cos(2d * Math.PI * u2);
+    }
+}
@@ -0,0 +1,30 @@
+using System.Diagnostics;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// The real-time <see cref="IPipelineClock"/>, backed by <see cref="Stopwatch"/>.
+/// </summary>
+internal sealed class SystemPipelineClock : IPipelineClock
+{
+    private SystemPipelineClock()
+    {
+    }
+
+    /// <summary>
+    /// Gets the process-wide instance.
+    /// </summary>
+    public static SystemPipelineClock Instance { get; } = new();
+
+    /// <inheritdoc />
+    public TimeSpan Elapsed => Stopwatch.GetElapsedTime(0);
+
+    /// <inheritdoc />
+    public long GetTimestamp() => Stopwatch.GetTimestamp();
+
+    /// <inheritdoc />
+    public void WaitUntil(TimeSpan deadline, CancellationToken token, HighResolutionWaitableTimer? highResolutionTimer)
+    {
+        TimingHelpers.WaitUntil(this, deadline, token, highResolutionTimer);
+    }
+}
@@ -0,0 +1,24 @@
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// The system time as an <see cref="IReferenceClock"/>. Windows reads it with
+/// <c>GetSystemTimePreciseAsFileTime</c> and W32Time keeps it disciplined to the domain's NTP or PTP source, so
+/// machines on the same time source agree on it to within the source's accuracy.
+/// </summary>
+internal sealed class SystemReferenceClock : IReferenceClock
+{
+    private SystemReferenceClock()
+    {
+    }
+
+    /// <summary>
+    /// Gets the process-wide instance.
+    /// </summary>
+    public static SystemReferenceClock Instance { get; } = new();
+
+    /// <inheritdoc />
+    public string Name => PacingReference.SystemClock;
+
+    /// <inheritdoc />
+    public long ReadTicks() => DateTime.UtcNow.Ticks - DateTime.UnixEpoch.Ticks;
+}
@@ -0,0 +1,118 @@
+using System.Globalization;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Identifies the scheduling class requested for the capture, compositor and paced sender threads.
+/// </summary>
+/// <remarks>Values mirror <c>CompositorThreadPriority</c> in the native helper.</remarks>
+public enum ThreadPriorityClass
+{
+    /// <summary>
+    /// Threads keep the priority they were created with.
+    /// </summary>
+    Normal = 0,
+
+    /// <summary>
+    /// The highest non-realtime priority (<c>THREAD_PRIORITY_HIGHEST</c>).
+    /// </summary>
+    High = 1,
+
+    /// <summary>
+    /// Registers the threads with MMCSS as "Pro Audio" so they preempt Chromium's raster and renderer threads.
+    /// Falls back to <see cref="High"/> when the system refuses.
+    /// </summary>
+    Realtime = 2,
+}
+
+/// <summary>
+/// Priority, CPU pinning and timer slack applied to the threads that pace and deliver frames.
+/// </summary>
+/// <param name="Priority">The scheduling class.</param>
+/// <param name="AffinityMask">The CPUs the threads may run on, bit n for CPU n; zero keeps the inherited affinity.</param>
+/// <param name="TimerSlack">
+/// How late timers may fire so wakeups can be batched. Zero keeps the default. Linux applies it with
+/// <c>PR_SET_TIMERSLACK</c>; Windows has no per-thread slack, so any positive value opts the threads out of EcoQoS
+/// throttling instead.
+/// </param>
+public sealed record ThreadPolicy(ThreadPriorityClass Priority, ulong AffinityMask, TimeSpan TimerSlack)
+{
+    /// <summary>
+    /// Gets a policy that leaves threads as the operating system created them.
+    /// </summary>
+    public static ThreadPolicy Default { get; } = new(ThreadPriorityClass.Normal, 0, TimeSpan.Zero);
+
+    /// <summary>
+    /// Gets a value indicating whether applying the policy changes nothing.
+    /// </summary>
+    public bool IsDefault => Priority == ThreadPriorityClass.Normal && AffinityMask == 0 && TimerSlack <= TimeSpan.Zero;
+
+    /// <summary>
+    /// Parses a CPU list such as <c>2,4-7</c> into an affinity mask.
+    /// </summary>
+    /// <param name="cpus">Comma-separated CPU numbers and inclusive ranges from 0 to 63. Null or whitespace yields zero.</param>
+    /// <returns>The affinity mask, or zero when no CPUs were listed.</returns>
+    /// <exception cref="FormatException">Thrown when an entry is not a CPU number or range between 0 and 63.</exception>
+    public static ulong ParseAffinity(string? cpus)
+    {
+        if (string.IsNullOrWhiteSpace(cpus))
+        {
+            return 0;
+        }
+
+        ulong mask = 0;
+        foreach (var entry in cpus.Split(',', StringSplitOptions.RemoveEmptyEntries | StringSplitOptions.TrimEntries))
+        {
+            var bounds = entry.Split('-', StringSplitOptions.TrimEntries);
+            if (bounds.Length > 2 ||
+                !TryParseCpu(bounds[0], out var first) ||
+                !TryParseCpu(bounds[^1], out var last) ||
+                last < first)
+            {
+                throw new FormatException($"CPU entry '{entry}' must be a CPU number or range between 0 and 63.");
+            }
+
+            for (var cpu = first; cpu <= last; cpu++)
+            {
+                mask |= 1UL << cpu;
+            }
+        }
+
+        return mask;
+    }
+
+    /// <summary>
+    /// Formats an affinity mask as the CPU list <see cref="ParseAffinity"/> accepts.
+    /// </summary>
+    /// <param name="mask">The affinity mask.</param>
+    /// <returns>The CPU list, or an empty string for zero.</returns>
+    public static string FormatAffinity(ulong mask)
+    {
+        var ranges = new List<string>();
+        for (var cpu = 0; cpu < 64; cpu++)
+        {
+            if ((mask & (1UL << cpu)) == 0)
+            {
+                continue;
+            }
+
+            var last = cpu;
+            while (last < 63 && (mask & (1UL << (last + 1))) != 0)
+            {
+                last++;
+            }
+
+            ranges.Add(last == cpu
+                ? cpu.ToString(CultureInfo.InvariantCulture)
+                : string.Create(CultureInfo.InvariantCulture, $"{cpu}-{last}"));
+            cpu = last;
+        }
+
+        return string.Join(',', ranges);
+    }
+
+    private static bool TryParseCpu(string value, out int cpu)
+    {
+        return int.TryParse(value, NumberStyles.None, CultureInfo.InvariantCulture, out cpu) && cpu < 64;
+    }
+}
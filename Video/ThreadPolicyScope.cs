@@ -0,0 +1,164 @@
+using System.Runtime.InteropServices;
+using Serilog;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// Applies a <see cref="ThreadPolicy"/> to the calling managed thread and restores the previous scheduling when
+/// disposed. The managed counterpart of the native helper's <c>ScopedThreadPolicy</c>, used by the paced sender loop.
+/// </summary>
+internal sealed class ThreadPolicyScope : IDisposable
+{
+    private const int AvrtPriorityHigh = 1;
+    private const int ThreadPowerThrottling = 3;
+    private const uint ThreadPowerThrottlingCurrentVersion = 1;
+    private const uint ThreadPowerThrottlingExecutionSpeed = 0x1;
+
+    private readonly IntPtr mmcssHandle;
+    private readonly ThreadPriority? previousPriority;
+    private readonly UIntPtr previousAffinity;
+    private bool disposed;
+
+    private ThreadPolicyScope(ThreadPriorityClass granted, IntPtr mmcssHandle, ThreadPriority? previousPriority, UIntPtr previousAffinity)
+    {
+        Granted = granted;
+        this.mmcssHandle = mmcssHandle;
+        this.previousPriority = previousPriority;
+        this.previousAffinity = previousAffinity;
+    }
+
+    /// <summary>
+    /// Gets the scheduling class that actually took effect.
+    /// </summary>
+    internal ThreadPriorityClass Granted { get; }
+
+    /// <summary>
+    /// Applies <paramref name="policy"/> to the calling thread. Parts the system refuses are logged and skipped.
+    /// </summary>
+    /// <param name="policy">The policy to apply.</param>
+    /// <param name="threadName">The thread's role, used in log messages.</param>
+    /// <param name="logger">The logger that records what was granted.</param>
+    /// <returns>A scope that restores the thread's previous priority and affinity when disposed.</returns>
+    internal static ThreadPolicyScope Apply(ThreadPolicy policy, string threadName, ILogger logger)
+    {
+        if (policy.IsDefault)
+        {
+            return new ThreadPolicyScope(ThreadPriorityClass.Normal, IntPtr.Zero, null, UIntPtr.Zero);
+        }
+
+        var granted = ThreadPriorityClass.Normal;
+        var mmcssHandle = IntPtr.Zero;
+        if (policy.Priority == ThreadPriorityClass.Realtime && OperatingSystem.IsWindows())
+        {
+            uint taskIndex = 0;
+            mmcssHandle = NativeMethods.AvSetMmThreadCharacteristics("Pro Audio", ref taskIndex);
+            if (mmcssHandle != IntPtr.Zero)
+            {
+                NativeMethods.AvSetMmThreadPriority(mmcssHandle, AvrtPriorityHigh);
+                granted = ThreadPriorityClass.Realtime;
+            }
+        }
+
+        ThreadPriority? previousPriority = null;
+        if (policy.Priority != ThreadPriorityClass.Normal && granted == ThreadPriorityClass.Normal)
+        {
+            previousPriority = Thread.CurrentThread.Priority;
+            Thread.CurrentThread.Priority = ThreadPriority.Highest;
+            granted = ThreadPriorityClass.High;
+        }
+
+        var previousAffinity = UIntPtr.Zero;
+        var affinityApplied = false;
+        if (policy.AffinityMask != 0 && OperatingSystem.IsWindows())
+        {
+            previousAffinity = NativeMethods.SetThreadAffinityMask(NativeMethods.GetCurrentThread(), (UIntPtr)policy.AffinityMask);
+            affinityApplied = previousAffinity != UIntPtr.Zero;
+        }
+
+        var timerSlackApplied = false;
+        if (policy.TimerSlack > TimeSpan.Zero && OperatingSystem.IsWindows())
+        {
+            var state = new PowerThrottlingState
+            {
+                Version = ThreadPowerThrottlingCurrentVersion,
+                ControlMask = ThreadPowerThrottlingExecutionSpeed,
+                StateMask = 0,
+            };
+            timerSlackApplied = NativeMethods.SetThreadInformation(NativeMethods.GetCurrentThread(), ThreadPowerThrottling, ref state, (uint)Marshal.SizeOf<PowerThrottlingState>());
+        }
+
+        if (granted != policy.Priority || (policy.AffinityMask != 0 && !affinityApplied) || (policy.TimerSlack > TimeSpan.Zero && !timerSlackApplied))
+        {
+            logger.Warning(
+                "{Thread} thread policy only partly applied: {Granted} priority of {Requested}, affinity {AffinityApplied}, EcoQoS opt-out {TimerSlackApplied}",
+                threadName,
+                granted,
+                policy.Priority,
+                affinityApplied,
+                timerSlackApplied);
+        }
+        else
+        {
+            logger.Information("{Thread} thread running at {Priority} priority on CPUs {Cpus}", threadName, granted, policy.AffinityMask == 0 ? "any" : ThreadPolicy.FormatAffinity(policy.AffinityMask));
+        }
+
+        return new ThreadPolicyScope(granted, mmcssHandle, previousPriority, previousAffinity);
+    }
+
+    /// <inheritdoc />
+    public void Dispose()
+    {
+        if (disposed)
+        {
+            return;
+        }
+
+        disposed = true;
+        if (mmcssHandle != IntPtr.Zero)
+        {
+            NativeMethods.AvRevertMmThreadCharacteristics(mmcssHandle);
+        }
+
+        if (previousPriority is { } priority)
+        {
+            Thread.CurrentThread.Priority = priority;
+        }
+
+        if (previousAffinity != UIntPtr.Zero)
+        {
+            NativeMethods.SetThreadAffinityMask(NativeMethods.GetCurrentThread(), previousAffinity);
+        }
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    private struct PowerThrottlingState
+    {
+        public uint Version;
+        public uint ControlMask;
+        public uint StateMask;
+    }
+
+    private static class NativeMethods
+    {
+        [DllImport("avrt.dll", EntryPoint = "AvSetMmThreadCharacteristicsW", SetLastError = true, CharSet = CharSet.Unicode)]
+        internal static extern IntPtr AvSetMmThreadCharacteristics(string taskName, ref uint taskIndex);
+
+        [DllImport("avrt.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        internal static extern bool AvSetMmThreadPriority(IntPtr avrtHandle, int priority);
+
+        [DllImport("avrt.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        internal static extern bool AvRevertMmThreadCharacteristics(IntPtr avrtHandle);
+
+        [DllImport("kernel32.dll")]
+        internal static extern IntPtr GetCurrentThread();
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        internal static extern UIntPtr SetThreadAffinityMask(IntPtr thread, UIntPtr affinityMask);
+
+        [DllImport("kernel32.dll", SetLastError = true)]
+        [return: MarshalAs(UnmanagedType.Bool)]
+        internal static extern bool SetThreadInformation(IntPtr thread, int informationClass, ref PowerThrottlingState information, uint informationSize);
+    }
+}
@@ -1,5 +1,4 @@
 using System;
-using System.Diagnostics;
 using System.Threading;
 using System.Threading.Tasks;
 
@@ -16,8 +15,13 @@ internal static class TimingHelpers
     // above the Windows timer resolution so short waits cannot overshoot.
     private static readonly TimeSpan SpinFallbackThreshold = TimeSpan.FromMilliseconds(16);
 
+    /// <summary>
+    /// Waits for a real-time clock to reach <paramref name="deadline"/>, sleeping while the deadline is far away and
+    /// spinning through the last half millisecond. Virtual clocks wait through <see cref="IPipelineClock.WaitUntil"/>
+    /// instead, since spinning on them would never end.
+    /// </summary>
     public static void WaitUntil(
-        Stopwatch clock,
+        IPipelineClock clock,
         TimeSpan deadline,
         CancellationToken token,
         HighResolutionWaitableTimer? highResolutionTimer)
@@ -0,0 +1,168 @@
+using System.Diagnostics;
+
+namespace Tractus.HtmlToNdi.Video;
+
+/// <summary>
+/// An <see cref="IPipelineClock"/> that only moves when a driving thread advances it, so a simulation can run the
+/// paced sender through hours of frames in seconds. The one thread that waits on the clock runs in lockstep with the
+/// driver: <see cref="AdvanceTo"/> wakes it at each deadline it passes and returns only once it is waiting again, so
+/// the waiter and the driver never run at the same time and a seeded simulation is repeatable.
+/// </summary>
+internal sealed class VirtualPipelineClock : IPipelineClock
+{
+    private static readonly double StopwatchTicksPerTimeSpanTick = Stopwatch.Frequency / (double)TimeSpan.TicksPerSecond;
+
+    private readonly object gate = new();
+    private readonly TimeSpan handoffTimeout;
+    private long elapsedTicks;
+    private TimeSpan? waiterDeadline;
+    private long wakeGeneration;
+    private bool lockstep;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="VirtualPipelineClock"/> class at time zero.
+    /// </summary>
+    /// <param name="handoffTimeout">How long the driver waits for the waiting thread to come back before it gives up;
+    /// defaults to ten seconds of real time.</param>
+    public VirtualPipelineClock(TimeSpan? handoffTimeout = null)
+    {
+        this.handoffTimeout = handoffTimeout ?? TimeSpan.FromSeconds(10);
+    }
+
+    /// <inheritdoc />
+    public TimeSpan Elapsed => TimeSpan.FromTicks(Volatile.Read(ref elapsedTicks));
+
+    /// <inheritdoc />
+    public long GetTimestamp() => (long)(Volatile.Read(ref elapsedTicks) * StopwatchTicksPerTimeSpanTick);
+
+    /// <inheritdoc />
+    /// <remarks>Only one thread may wait at a time. It waits until the driver advances the clock past
+    /// <paramref name="deadline"/>, and the clock is then exactly at the deadline.</remarks>
+    public void WaitUntil(TimeSpan deadline, CancellationToken token, HighResolutionWaitableTimer? highResolutionTimer)
+    {
+        using var registration = token.Register(() =>
+        {
+            lock (gate)
+            {
+                Monitor.PulseAll(gate);
+            }
+        });
+
+        lock (gate)
+        {
+            if (deadline.Ticks <= elapsedTicks || token.IsCancellationRequested)
+            {
+                return;
+            }
+
+            if (waiterDeadline is not null)
+            {
+                throw new InvalidOperationException("Only one thread can wait on a virtual pipeline clock.");
+            }
+
+            var generation = wakeGeneration;
+            waiterDeadline = deadline;
+            lockstep = true;
+            Monitor.PulseAll(gate);
+            while (wakeGeneration == generation && !token.IsCancellationRequested)
+            {
+                Monitor.Wait(gate);
+            }
+
+            if (wakeGeneration == generation)
+            {
+                // Cancelled: the waiter is leaving for good, so the driver stops waiting for it to come back.
+                waiterDeadline = null;
+                lockstep = false;
+                Monitor.PulseAll(gate);
+            }
+        }
+    }
+
+    /// <summary>
+    /// Blocks until a thread waits on the clock, after which <see cref="AdvanceTo"/> runs in lockstep with it. Call
+    /// it after starting the paced sender so its first deadline is not skipped.
+    /// </summary>
+    /// <exception cref="TimeoutException">No thread waited within the handoff timeout.</exception>
+    public void WaitForWaiter()
+    {
+        lock (gate)
+        {
+            WaitForWaiterLocked(requireWaiter: true);
+        }
+    }
+
+    /// <summary>
+    /// Moves the clock forward to <paramref name="target"/>, waking the waiting thread at each of its deadlines on the
+    /// way and waiting for it to finish its work before moving on. A target in the past leaves the clock unchanged.
+    /// </summary>
+    /// <param name="target">The time to move to.</param>
+    /// <exception cref="TimeoutException">The waiting thread did not wait again within the handoff timeout.</exception>
+    public void AdvanceTo(TimeSpan target)
+    {
+        lock (gate)
+        {
+            while (true)
+            {
+                WaitForWaiterLocked(requireWaiter: false);
+                if (waiterDeadline is not { } deadline || deadline > target)
+                {
+                    break;
+                }
+
+                Volatile.Write(ref elapsedTicks, Math.Max(elapsedTicks, deadline.Ticks));
+                waiterDeadline = null;
+                wakeGeneration++;
+                Monitor.PulseAll(gate);
+            }
+
+            Volatile.Write(ref elapsedTicks, Math.Max(elapsedTicks, target.Ticks));
+        }
+    }
+
+    /// <summary>
+    /// Moves the clock forward by <paramref name="duration"/>; see <see cref="AdvanceTo"/>.
+    /// </summary>
+    /// <param name="duration">How far to move.</param>
+    public void AdvanceBy(TimeSpan duration) => AdvanceTo(Elapsed + duration);
+
+    /// <summary>
+    /// Moves the clock to the waiting thread's deadline, wakes it once, and waits for it to wait again, so a test can
+    /// look at the state between two ticks of a paced sender whose deadlines are not evenly spaced.
+    /// </summary>
+    /// <returns><see langword="false"/> when no thread is waiting, leaving the clock unchanged.</returns>
+    /// <exception cref="TimeoutException">The waiting thread did not wait again within the handoff timeout.</exception>
+    public bool AdvanceToNextDeadline()
+    {
+        lock (gate)
+        {
+            WaitForWaiterLocked(requireWaiter: false);
+            if (waiterDeadline is not { } deadline)
+            {
+                return false;
+            }
+
+            Volatile.Write(ref elapsedTicks, Math.Max(elapsedTicks, deadline.Ticks));
+            waiterDeadline = null;
+            wakeGeneration++;
+            Monitor.PulseAll(gate);
+            WaitForWaiterLocked(requireWaiter: false);
+            return true;
+        }
+    }
+
+    private void WaitForWaiterLocked(bool requireWaiter)
+    {
+        var giveUp = Stopwatch.GetTimestamp() + (long)(handoffTimeout.TotalSeconds * Stopwatch.Frequency);
+        while (waiterDeadline is null && (requireWaiter || lockstep))
+        {
+            var remaining = Stopwatch.GetElapsedTime(Stopwatch.GetTimestamp(), giveUp);
+            if (remaining <= TimeSpan.Zero)
+            {
+                throw new TimeoutException("The thread waiting on the virtual pipeline clock did not come back.");
+            }
+
+            Monitor.Wait(gate, remaining);
+        }
+    }
+}